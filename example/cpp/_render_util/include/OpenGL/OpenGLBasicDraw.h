@@ -21,11 +21,13 @@
 #include "../render/Render_IFont.h"
 #include "../render/Render_IRender.h"
 #include "../render/Render_IDrawLine.h"
+#include "../util/RenderUtil_TextMeshCache.h"
 
 // OpenGL
 
 #include "OpenGL_Matrix_Camera.h"
 #include "OpenGL_SimpleShaderProgram_temp.h"
+#include "OpenGLProfiler.h"
 
 // STL
 
@@ -144,13 +146,18 @@ public:
   virtual void ViewportSize( const TSize &vp_size ) override
   { 
     _vp_size = vp_size;
-    _uniforms._vp_size = { (float)vp_size[0], (float)vp_size[1] };
+    Render::TVec2 size{ (float)vp_size[0], (float)vp_size[1] };
+    if ( _uniforms._vp_size == size )
+      return;
+    _uniforms._vp_size = size;
     InvalidateUniforms();
   }  
 
   //!< set the projection matrix
   virtual void Projection( const Render::TMat44 &proj ) override
   { 
+    if ( _uniforms._projection == proj )
+      return;
     _uniforms._projection = proj;
     InvalidateUniforms();
   }
@@ -158,6 +165,8 @@ public:
   //!< set the view matrix
   virtual void View( const Render::TMat44 &view ) override
   { 
+    if ( _uniforms._view == view )
+      return;
     _uniforms._view = view;
     InvalidateUniforms();
   }          
@@ -165,8 +174,10 @@ public:
   //!< set the model matrix
   virtual void Model( const Render::TMat44 &model ) override
   { 
-    _uniforms._model =
-    model; InvalidateUniforms(); 
+    if ( _uniforms._model == model )
+      return;
+    _uniforms._model = model;
+    InvalidateUniforms(); 
   }        
 
   virtual TVec3 Project( const TVec3 &pt ) const override; //!< project by projection, view and model
@@ -185,6 +196,15 @@ public:
 
   virtual bool DrawText2D( TFontId font_id, const char *text, float height, float width_scale, const Render::TPoint3 &pos, const Render::TColor &color ) override;
 
+  //! set the outline and glow of the text, which is drawn with a distance field font
+  void TextEffect( const Render::TTextEffect &effect ) { _text_effect = effect; }
+
+  Render::TTextMeshHandle TextMesh( TFontId font_id, const char *text, float height, float width_scale ); //!< get the handle of a retained text mesh
+  bool DrawTextMesh( Render::TTextMeshHandle handle, const Render::TPoint3 &pos, const Render::TColor &color ); //!< queue a retained text mesh for drawing
+  bool FlushText( void );                                                                                   //!< draw the queued text meshes, batched by font, atlas page and color
+  const Render::CTextMeshCache * TextMeshCache( void ) const { return _text_meshes.get(); }                  //!< text mesh cache; nullptr if no text mesh was created
+  CGpuProfiler * GpuProfiler( void ) { return _gpu_profiler.get(); }                                        //!< GPU scopes of the passes; nullptr until a frame was drawn with the profiler enabled
+
   bool SetPolygonShader( const Render::TColor &color );
   bool SetLineShader( const Render::TColor &color, Render::t_fp thickness );
 
@@ -197,11 +217,15 @@ private:
   void InvalidateUniforms( void );
 
   bool SpecifyRenderProcess( void );
+  void BeginPassScope( const char *name ); //!< end the profile scopes of the previous pass and begin the scopes of a new pass
   bool UpdateGeneralUniforms( void );
   bool UpdateColorUniforms( const Render::TColor &color );
   bool SetModelUniform( const float *model );
   bool SetModelUniform( const TVec3 &scale, const TVec3 &p0, const TVec3 &px, const TVec3 &xz_plane );
   void DrawScereenspace( void );
+  bool PrepareTextBlending( void );
+  void ResetTextBlending( void );
+  bool SetGlyphUniforms( const Render::IFont &font );
 
   static std::set<std::string> _ogl_extensins;
   static int                   _max_anistropic_texture_filter;
@@ -231,9 +255,15 @@ private:
   TProgram                              _transp_line_prog;
   TProgram                              _mixcol_prog;
   TProgram                              _finish_prog;
+  Render::ITextureLoaderPtr             _font_loader;         //!< texture loader of the glyph atlas pages of the fonts
   TFontMap                              _fonts;
+  Render::TTextEffect                   _text_effect;
+  std::unique_ptr<Render::CTextMeshCache> _text_meshes;       //!< retained text meshes
   unsigned int                          _color_texture  = 0; // TODO $$$ ITexture
   unsigned int                          _uniform_ssbo   = 0; // TODO $$$ IUniform?
+  unsigned int                          _text_offset_ssbo = 0; //!< reference positions of the batched text meshes
+  Render::CProfileScope                 _pass_scope;          //!< CPU scope of the current pass
+  std::unique_ptr<CGpuProfiler>         _gpu_profiler;        //!< GPU scopes of the passes
 
   const size_t c_opaque_pass = 1; //!< pass for opaque drawing
   const size_t c_tranp_pass  = 2; //!< pass for transparent drawing
@@ -28,6 +28,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 
 // class declarations
@@ -55,6 +56,44 @@ using TMVPBufferPtr = std::shared_ptr<CModelAndViewBuffer_std140>;
 * technique.
 * [https://en.wikipedia.org/wiki/Resource_acquisition_is_initialization]
 *
+* By default the buffer contains a single block, which is updated by
+* `glBufferSubData`, every time when the data change. Since the block
+* is read by the preceding draw call, the update is serialized with it.
+*
+* If the buffer is initialized with a ring size, then the buffer is a
+* ring of `ring_size` blocks, each aligned to
+* `GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT`. Each modification of the data
+* is stored to a new block, and the block is selected by
+* `glBindBufferRange`. A block is never overwritten while it may be
+* read.
+*
+*  - `Update` records, uploads and selects the current data at once,
+*    unless a block was selected by the caller and the data were not
+*    modified since.
+*  - `Record` stores the current data to the next block of the ring and
+*    returns its index, `Flush` uploads all recorded blocks by a single
+*    `glBufferSubData` and `Select` binds a block (or a range of blocks,
+*    for instanced drawing, where the shader indexes the blocks by the
+*    instance or draw ID in steps of `BlockStride`).
+*  - `NewFrame` starts a new frame. The blocks of the current frame
+*    stay valid until the end of the frame: if the ring is full within
+*    a frame, then the ring grows; the storage is orphaned only, when
+*    the ring wraps around at the begin of a frame.
+*
+* A frame, which draws many objects, records the data of all objects,
+* flushes them once and selects the block of each object before it is
+* drawn:
+*
+* \code{.cpp}
+* mvp_buffer->NewFrame();
+* for ( auto &object : objects ) { model_view->Model( object._model ); object._block = mvp_buffer->Record(); }
+* mvp_buffer->Flush();
+* for ( auto &object : objects ) { mvp_buffer->Select( object._block ); object.Draw(); }
+* \endcode
+*
+* The counters of the current and the last frame show the number of
+* uploads, which are done in either mode.
+*
 * \author  gernot
 * \date    2018-12-17
 * \version 1.0
@@ -63,6 +102,19 @@ class CModelAndViewBuffer_std140
 {
 public:
 
+  static const size_t c_no_block = (size_t)-1; //!< invalid block index
+
+  //! upload counters of one frame
+  struct TStatistics
+  {
+    size_t _records = 0; //!< number of blocks which were recorded (modifications of the data)
+    size_t _uploads = 0; //!< number of `glBufferSubData` calls
+    size_t _bytes   = 0; //!< number of bytes which were uploaded
+    size_t _binds   = 0; //!< number of buffer range bindings
+    size_t _orphans = 0; //!< number of times, when the ring wrapped around and the storage was orphaned
+    size_t _grows   = 0; //!< number of times, when the ring was full within a frame and grew
+  };
+
   CModelAndViewBuffer_std140( void );
   virtual ~CModelAndViewBuffer_std140();
 
@@ -71,21 +123,50 @@ public:
   CModelAndViewBuffer_std140 & operator = ( const CModelAndViewBuffer_std140 & ) = delete;
 
   size_t BufferBinding( void ) const { return _buffer_binding; }
+  size_t RingSize( void )      const { return _ring_size; }    //!< number of blocks in the ring; 0: single block
+  size_t BlockStride( void )   const { return _block_stride; } //!< distance of the blocks in the buffer in bytes
+
+  const TStatistics & Frame( void )     const { return _frame; }      //!< counters of the current frame
+  const TStatistics & LastFrame( void ) const { return _last_frame; } //!< counters of the last completed frame
 
-  bool Init( size_t binding );                                    //!< initialization of the object
-  bool Init( size_t binding, Render::TModelAndViewPtr data_ptr ); //!< initialization of the object
-  void Destroy( void );                                           //!< destroy the object resources
+  bool Init( size_t binding );                                                      //!< initialization of the object
+  bool Init( size_t binding, Render::TModelAndViewPtr data_ptr );                   //!< initialization of the object
+  bool Init( size_t binding, Render::TModelAndViewPtr data_ptr, size_t ring_size ); //!< initialization of the object with a ring of blocks
+  void Destroy( void );                                                             //!< destroy the object resources
 
   bool Update( void );                                            //!< Update buffer data
 
+  size_t Record( void );                                          //!< store the current data to the next block of the ring
+  bool   Flush( void );                                           //!< upload the recorded blocks
+  bool   Select( size_t block, size_t no_of_blocks = 1 );         //!< bind a range of blocks to the binding point
+  void   NewFrame( void );                                        //!< complete the counters of the current frame
+
 private:
 
+  void Upload( size_t offset, size_t size, const void *data );
+  void Allocate( void );
+  void Grow( void );
+  void Orphan( void );
+
   bool                     _initialized{ false }; //!< initialization state
   Render::TModelAndViewPtr _data;                 //!< data structure 
   size_t                   _buffer_binding{ 0 };  //!< binding point of the buffer
   unsigned int             _buffer_object{ 0 };   //!< named OpenGL buffer object
   unsigned int             _data_stamp{ 0 };      //!< modification and synchronization stamp of the data 
   unsigned int             _model_stamp{ 0 };     //!< modification and synchronization stamp of the model matrix
+
+  size_t                   _ring_size{ 0 };               //!< number of blocks in the ring
+  size_t                   _block_stride{ 0 };            //!< aligned size of a block
+  std::vector<char>        _ring_data;                    //!< CPU copy of the ring
+  size_t                   _next_block{ 0 };              //!< index of the next free block
+  size_t                   _flushed_block{ 0 };           //!< index of the first block, which is not uploaded yet
+  size_t                   _last_block{ c_no_block };     //!< index of the last recorded block
+  size_t                   _selected_block{ c_no_block }; //!< index of the block, which was selected after the last record
+  size_t                   _frame_block{ 0 };             //!< index of the first block of the current frame
+  size_t                   _valid_block{ 0 };             //!< index of the first block, which is valid in the current storage
+  size_t                   _max_frame_blocks{ 0 };        //!< maximum number of blocks, which were recorded in a frame
+  TStatistics              _frame;                        //!< counters of the current frame
+  TStatistics              _last_frame;                   //!< counters of the last frame
 };
 
 
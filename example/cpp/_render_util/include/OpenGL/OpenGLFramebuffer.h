@@ -13,6 +13,7 @@
 // includes
 
 #include "../render/Render_IRenderPass.h"
+#include "../util/RenderUtil_RenderGraph.h"
 
 
 // class definitions
@@ -41,6 +42,14 @@ namespace OpenGL
 *
 *  - [OpenGL Texture 2D](https://www.khronos.org/opengl/wiki/Texture)
 *  - [OpenGL Framebuffer Object](https://www.khronos.org/opengl/wiki/Framebuffer_Object)         
+*
+*  When the process is created, the render graph (`Render::CRenderGraph`)
+*  of the buffers and passes is built. `Discard` invalidates the
+*  attachments, which are dead after a pass, by
+*  `glInvalidateNamedFramebufferData` (or `glInvalidateFramebuffer` on
+*  OpenGL 4.3 and OpenGL ES 3.0). If aliasing is enabled, transient
+*  buffers with disjoint lifetimes share a texture; then the passes have
+*  to be executed in the order of the graph (`Graph().Order()`).
 * 
 * \author  gernot
 * \date    2018-02-11
@@ -58,6 +67,8 @@ public:
   {
     bool operator ==( TTextureObject &B ) const
     {
+      if ( _alias || B._alias )
+        return false;
       if ( B._extern )
         return _extern && _object == B._object;
       return _layers == B._layers && _size == B._size && _format == B._format;
@@ -74,6 +85,7 @@ public:
     bool                        _extern;       //!< extern texture; a texture which is not managed in this class, but was handed over for use
     bool                        _cubemap;      //!< the extern target texture is a side of a cube map
     int                         _cubemap_side; //!< the side index of the cube map side
+    bool                        _alias = false; //!< the texture object is owned by another buffer with a disjoint lifetime
   };
   using TTextureMap = std::map<size_t, TTextureObject>;
 
@@ -108,6 +120,10 @@ public:
 
   const TTextureMap & Textures( void ) const { return _textures; };
 
+  const Render::CRenderGraph & Graph( void ) const { return _graph; }          //!< render graph of the buffers and passes
+  bool                         Aliasing( void ) const { return _aliasing; }    //!< transient buffers with disjoint lifetimes share textures
+  void                         Aliasing( bool aliasing ) { _aliasing = aliasing; Invalidate(); }
+
   virtual const TBufferMap & Buffers( void ) const { return _buffers; };
   virtual const TPassMap   & Passes( void )  const { return _passes; };
 
@@ -136,6 +152,7 @@ public:
   virtual bool SetDrawBuffers(  bool firstColorAttachmentOnly ) override;                       //!< activates the draw buffers
   virtual bool ReleasePass( size_t passID ) override;                                           //!< release the render pass
   virtual bool Release( void ) override;                                                        //!< release the current render pass
+  virtual bool Discard( size_t passID ) override;                                               //!< invalidate the attachments, which are dead after the pass
   virtual bool GetBufferObject( size_t bufferID, unsigned int &obj ) override;                  //!< get the implementation object for a buffer
   virtual bool GetPassObject( size_t passID, unsigned int &obj ) override;                      //!< get the implementation object for a pass
 
@@ -152,6 +169,9 @@ private:
   void DeleteUnnecessaryTextures( void );
   void DeleteUnnecessaryFrambuffers( void );
   void UpdateTexture( size_t bufferID, const Render::TBuffer &specification );
+  void AliasTexture( size_t bufferID, size_t ownerID );
+  bool IsAliased( size_t bufferID ) const { return _aliasing && _graph.Valid() && _graph.Alias( bufferID ) != bufferID; }
+  static unsigned int AttachmentPoint( size_t attachment );
   unsigned int CreateFrambufferRenderBuffer( const TFramebufferObject &fb, const Render::TPass::TTarget &target );
   void AttachFrambufferTextureBuffer( const TFramebufferObject &fb, const Render::TPass::TTarget &target );
   TBufferInfoCache & EvaluateInfoCache( size_t passID, const Render::TPass &pass );
@@ -167,6 +187,8 @@ private:
   TTextureMap      _textures;                //!< texture objects for the pass targets
   TFrambufferMap   _fbs;                     //!< framebuffer objects for the render passes
   TBufferInfoMap   _bufferInfoMap;           //!< cached information for target buffer binding, target buffer clearing and source texture binding
+  Render::CRenderGraph _graph;               //!< render graph of the buffers and passes
+  bool             _aliasing    = false;     //!< transient buffers with disjoint lifetimes share textures
 };
 
 
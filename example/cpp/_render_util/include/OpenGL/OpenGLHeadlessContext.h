@@ -0,0 +1,123 @@
+/******************************************************************//**
+* \brief   Headless OpenGL context (EGL pbuffer), without a window
+*          system.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef OpenGLHeadlessContext_h_INCLUDED
+#define OpenGLHeadlessContext_h_INCLUDED
+
+
+// STL
+
+#include <cstddef>
+#include <string>
+
+
+// class definitions
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+/******************************************************************//**
+* \brief   OpenGL context with an EGL pbuffer surface.
+*
+* The context is created without a window system, e.g. on a server
+* without a display or without a GPU (Mesa llvmpipe). The pbuffer is
+* the default framebuffer of the context, so `CBasicDraw` and
+* `CRenderProcess` render to it like to a window.
+*
+* The EGL display is selected by the platform:
+*
+*  - `device`: the first EGL device (`EGL_EXT_platform_device`)
+*  - `surfaceless`: Mesa surfaceless platform (`EGL_MESA_platform_surfaceless`)
+*  - `default_display`: `eglGetDisplay( EGL_DEFAULT_DISPLAY )`
+*  - `automatic`: the first of the above, which can be initialized.
+*
+* The usual init path follows the activation of the context:
+*
+*     OpenGL::CHeadlessContext context( { 512, 512 } );
+*     context.Activate();
+*     glewExperimental = true;
+*     glewInit(); // GLEW_ERROR_NO_GLX_DISPLAY is expected, if GLEW was built for GLX
+*     OpenGL::CBasicDraw draw( true, 0, 1.0f, false );
+*     draw.Init();
+*
+* The constructor throws `std::runtime_error`, if no context can be
+* created. The destructor terminates the EGL display, so a display
+* can't be shared by 2 objects of this class.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CHeadlessContext
+{
+public:
+
+  enum class TPlatform
+  {
+    automatic,
+    device,
+    surfaceless,
+    default_display
+  };
+
+  struct TConfig
+  {
+    size_t    _width    = 512;   //!< width of the pbuffer
+    size_t    _height   = 512;   //!< height of the pbuffer
+    int       _major    = 4;     //!< minimum major version
+    int       _minor    = 3;     //!< minimum minor version
+    bool      _core     = true;  //!< core profile, else compatibility profile
+    bool      _debug    = false; //!< debug context
+    TPlatform _platform = TPlatform::automatic;
+  };
+
+  CHeadlessContext( const TConfig &config );
+  ~CHeadlessContext();
+
+  CHeadlessContext( const CHeadlessContext & ) = delete;
+  CHeadlessContext & operator =( const CHeadlessContext & ) = delete;
+
+  const TConfig     & Config( void )   const { return _config; }
+  TPlatform           Platform( void ) const { return _platform; } //!< platform of the display
+  const std::string & Vendor( void )   const { return _vendor; }   //!< EGL vendor
+
+  bool IsActive( void ) const;
+  bool Activate( void );
+  bool Release( void );
+
+  bool Resize( size_t width, size_t height ); //!< replace the pbuffer
+
+private:
+
+  void Create( void );
+  void CreateSurface( void );
+  void Destroy( void );
+
+  TConfig     _config;
+  TPlatform   _platform         = TPlatform::automatic;
+  std::string _vendor;
+  void       *_display          = nullptr; //!< `EGLDisplay`
+  void       *_egl_config       = nullptr; //!< `EGLConfig`
+  void       *_context          = nullptr; //!< `EGLContext`
+  void       *_surface          = nullptr; //!< `EGLSurface`
+};
+
+
+} // OpenGL
+
+#endif // OpenGLHeadlessContext_h_INCLUDED
@@ -118,6 +118,9 @@ public:
   virtual bool DrawSequence( size_t coords_size, const float *coords ) override;
   virtual bool DrawSequence( size_t coords_size, const double *coords ) override;
 
+  //! Append elements to an active line sequence, which are written in place by the caller
+  virtual std::span<float> MapSequence( size_t coords_size ) override;
+
 private:
 
   bool                    _successive_draw_started{ false };          //!< successive drawing was started by this renderer
@@ -0,0 +1,112 @@
+/******************************************************************//**
+* \brief Arc length of polyline vertices on the GPU, by a parallel
+* segmented prefix sum of the segment lengths in compute shaders,
+* for OpenGL version 4.3+ and GLSL version 4.30 (`#version 430`).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef OpenGLLine_arclength_h_INCLUDED
+#define OpenGLLine_arclength_h_INCLUDED
+
+// includes
+
+#include "../render/Render_IProgram.h"
+
+
+// STL
+
+#include <array>
+#include <string>
+
+
+// class definitions
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+/******************************************************************//**
+* \brief Namespace for drawing lines with the use of OpenGL.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace Line
+{
+
+
+/******************************************************************//**
+* \brief Arc length of polyline vertices on the GPU.
+*
+* The vertices of all the polylines are stored consecutively in a
+* shader storage buffer of `vec4`. On input `w` marks the first vertex
+* of each polyline (`Render::c_arc_length_polyline_start`), on output
+* `w` is the length along the polyline from its first vertex, in the
+* space of the coordinates. The CPU reference is
+* `Render::ArcLengthPrefixSum`.
+*
+* The prefix sum is computed in 3 passes (reduce-then-scan):
+*
+* 1. Each work group scans a block of 1024 vertices (4 per invocation
+*    and a Hillis-Steele scan of the 256 partial sums in shared memory)
+*    and stores the block sum and the first polyline start in the block.
+* 2. A single work group scans the block sums.
+* 3. The scanned sum of the previous block is added to the vertices of
+*    each block, which precede the first polyline start in the block.
+*
+* The scan operator is segmented: a polyline start resets the sum.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CArcLengthPrefixSum
+{
+public:
+
+  static const size_t c_block_size = 1024; //!< number of vertices, which are scanned by one work group
+
+  CArcLengthPrefixSum( void );
+  virtual ~CArcLengthPrefixSum();
+
+  //! Initialize the compute shader programs
+  bool Init( void );
+
+  //! Compute the arc length of the vertices in place
+  bool Compute( unsigned int vertex_buffer, size_t no_of_vertices );
+
+  //! Trace error message
+  virtual void Error( const std::string &kind, const std::string &message );
+
+private:
+
+  static const std::string _comp_430; //!< compute shader; the pass is selected by the `PASS` definition
+
+  bool                                        _initialized{ false }; //!< initialization state of the object
+  std::array<Render::Program::TProgramPtr, 3> _prog;                 //!< shader programs of the 3 passes
+  std::array<int, 3>                          _no_of_vertices_loc{ -1, -1, -1 }; //!< uniform locations of the number of vertices
+  int                                         _no_of_blocks_loc{ -1 }; //!< uniform location of the number of blocks (pass 2)
+  unsigned int                                _block_buffer{ 0 };    //!< storage buffer of the block sums
+  size_t                                      _block_buffer_size{ 0 }; //!< size of the block buffer in bytes
+};
+
+
+} // Line
+
+
+} // OpenGL
+
+
+#endif // OpenGLLine_arclength_h_INCLUDED
@@ -70,6 +70,9 @@ public:
   const Render::Line::TStyle & LineStyle( void ) const { return _line_style; }
   void LineStyle( const Render::Line::TStyle &style ) { _line_style = style; }
 
+  //! primitive render program; provides the batch statistics (submitted draws and OpenGL draw calls)
+  const TProgramPtr & PrimitiveProgram( void ) const { return _primitive_prog; }
+
   //! Initialize the line renderer
   virtual bool Init( void ) override;
   virtual bool Init( Render::TModelAndViewPtr mvp_data );
@@ -108,6 +111,9 @@ public:
   virtual bool DrawSequence( size_t coords_size, const float *coords ) override;
   virtual bool DrawSequence( size_t coords_size, const double *coords ) override;
 
+  //! Append elements to an active line sequence, which are written in place by the caller
+  virtual std::span<float> MapSequence( size_t coords_size ) override;
+
 private:
 
   bool                    _initialized{ false };                      //!< initialization state of the object               
@@ -1,8 +1,8 @@
 /******************************************************************//**
 * \brief Implementation of OpenGL line renderer,
 * with the use of "modern" OpenGL (4+) and hight quality shaders,
-* for OpenGL version 4+ and GLSL version 4.20 (`#version 420`).
-* 
+* for OpenGL version 4.3+ and GLSL version 4.30 (`#version 430`).
+*
 * \author  gernot
 * \date    2018-08-01
 * \version 1.0
@@ -15,14 +15,25 @@
 
 #include "../render/Render_IDrawType.h"
 #include "../render/Render_IDrawLine.h"
+#include "../render/Render_IProgram.h"
+
+#include "OpenGLDataBuffer_std140.h"
+#include "OpenGLLine_arclength.h"
+
+
+// STL
+
+#include <array>
+#include <cstdint>
+#include <vector>
 
 
 // class definitions
 
 
 /******************************************************************//**
-* \brief General namespace for OpenGL implementation.  
-* 
+* \brief General namespace for OpenGL implementation.
+*
 * \author  gernot
 * \date    2018-09-07
 * \version 1.0
@@ -32,8 +43,8 @@ namespace OpenGL
 
 
 /******************************************************************//**
-* \brief Namespace for drawing lines with the use of OpenGL.  
-* 
+* \brief Namespace for drawing lines with the use of OpenGL.
+*
 * \author  gernot
 * \date    2018-09-07
 * \version 1.0
@@ -45,21 +56,158 @@ namespace Line
 /******************************************************************//**
 * \brief Implementation of OpenGL line renderer,
 * with the use of "modern" OpenGL (4+) and hight quality shaders,
-* for OpenGL version 4+ and GLSL version 4.20 (`#version 420`).
-* 
+* for OpenGL version 4.3+ and GLSL version 4.30 (`#version 430`).
+*
+* Thick lines are generated in the vertex shader, without geometry
+* shader and without `glLineWidth`, which is clamped to 1 by core
+* profiles (vertex pulling, see `opengl_line_thickness/thick_line_strip_ssbo.cpp`).
+* The vertices of all the pending polylines are stored in a shader
+* storage buffer (x, y, z and the arc length from the start of the
+* polyline), the first vertex, number of vertices and kind of each
+* polyline in a second one (offsets buffer). The pending polylines are
+* drawn by a single instanced draw call, with one instance per vertex.
+* Each instance expands the segment to the next vertex to a quad and
+* generates the join with the previous segment (miter, bevel or round)
+* or the cap at an open end (butt, square or round). The width is
+* constant in window space.
+*
+* Stippling is evaluated in the fragment shader, from the arc length
+* of the vertices and the pixel scale of the segment.
+* Limitation: the arc length is accumulated in the space of the
+* coordinates, and each segment scales the arc length of its start
+* vertex by its own ratio of pixel length to coordinate length. With a
+* perspective projection (or a non uniform scale) the ratio differs
+* from segment to segment, so the phase of the stipple pattern jumps
+* at each vertex of the polyline. The pattern is continuous only for
+* orthographic projections with a uniform scale.
+* The arc length is computed by a parallel prefix sum of
+* the segment lengths in a compute shader (`CArcLengthPrefixSum`), so
+* only the coordinates have to be uploaded. Alternatively it is
+* computed on the CPU before the upload (`Render::ArcLengthPrefixSum`).
+*
 * \author  gernot
 * \date    2018-08-01
 * \version 1.0
 **********************************************************************/
 class CLineHighQuality
+  : public Render::Line::IRender
 {
 public:
 
-  CLineHighQuality( void );
+  //! counters of the drawing
+  struct TStatistics
+  {
+    size_t _polylines{ 0 };  //!< submitted polylines
+    size_t _vertices{ 0 };   //!< submitted vertices
+    size_t _draw_calls{ 0 }; //!< OpenGL draw calls (`glDrawArraysInstanced`)
+  };
+
+  CLineHighQuality( size_t min_cache_elems );
   virtual ~CLineHighQuality();
 
-  // TODO : comments
-  // The implementation is based on the ... link to paper
+  const Render::Line::TStyle & LineStyle( void ) const { return _line_style; }
+
+  const TStatistics & Statistics( void ) const { return _statistics; }
+  bool GPUArcLength( void ) const { return _gpu_arc_length; }
+
+  //! compute the arc length on the GPU (default) or on the CPU
+  void GPUArcLength( bool gpu ) { _gpu_arc_length = gpu; }
+  void ResetStatistics( void ) { _statistics = TStatistics(); }
+
+  //! Initialize the line renderer
+  virtual bool Init( void ) override;
+  virtual bool Init( Render::TModelAndViewPtr mvp_data );
+  virtual bool Init( TMVPBufferPtr mvp_buffer );
+
+  //! Notify the render that a sequence of successive lines will follow, that is not interrupted by any other drawing operation.
+  //! The lines are collected and drawn by a single draw call, until the color or style changes or the sequence is finished.
+  virtual bool StartSuccessiveLineDrawings( void ) override;
+
+  //! Notify the renderer that a sequence of lines has been finished, and that the internal states have to be restored.
+  virtual bool FinishSuccessiveLineDrawings( void ) override;
+
+  virtual Render::Line::IRender & SetColor( const Render::TColor & color )  override;
+  virtual Render::Line::IRender & SetColor( const Render::TColor8 & color ) override;
+  virtual Render::Line::IRender & SetStyle( const Render::Line::TStyle & style ) override;
+
+  //! Draw a line sequence
+  virtual bool Draw( Render::TPrimitive primitive_type, unsigned int tuple_size, size_t coords_size, const float *coords ) override;
+  virtual bool Draw( Render::TPrimitive primitive_type, unsigned int tuple_size, size_t coords_size, const double *coords ) override;
+  virtual bool Draw( Render::TPrimitive primitive_type, size_t no_of_coords, const float *x_coords, const float *y_coords ) override;
+  virtual bool Draw( Render::TPrimitive primitive_type, size_t no_of_coords, const double *x_coords, const double *y_coords ) override;
+
+  //! Start a new line sequence
+  virtual bool StartSequence( Render::TPrimitive primitive_type, unsigned int tuple_size ) override;
+
+  //! Complete an active line sequence
+  virtual bool EndSequence( void ) override;
+
+  //! Specify a new vertex coordinate in an active line sequence
+  virtual bool DrawSequence( float x, float y, float z ) override;
+  virtual bool DrawSequence( double x, double y, double z ) override;
+
+  //! Specify a sequence of new vertex coordinates in an active line sequence
+  virtual bool DrawSequence( size_t coords_size, const float *coords ) override;
+  virtual bool DrawSequence( size_t coords_size, const double *coords ) override;
+
+  //! Append elements to an active line sequence, which are written in place by the caller
+  virtual std::span<float> MapSequence( size_t coords_size ) override;
+
+  //! draw the pending polylines
+  bool Flush( void );
+
+  //! Trace error message
+  virtual void Error( const std::string &kind, const std::string &message );
+
+private:
+
+  //! kind of a polyline; stored in the 2 high bits of the number of vertices
+  enum TPolylineKind : std::uint32_t
+  {
+    e_open      = 0,
+    e_closed    = 1, //!< line loop
+    e_adjacency = 2, //!< the first and the last vertex are only neighbours for the joins
+  };
+
+  static const std::string _vert_430;  //!< vertex shader, which expands the segments, joins and caps
+  static const std::string _frag_430;  //!< fragment shader for round joins and caps and stippling
+
+  void InitProgram( void );
+  void InitBuffers( void );
+
+  template <typename T>
+  bool AddLines( Render::TPrimitive primitive_type, unsigned int tuple_size, size_t no_of_vertices, const T *coords, const T *y_coords );
+
+  template <typename T>
+  void AddPolyline( TPolylineKind kind, unsigned int tuple_size, size_t first, size_t no_of_vertices, const T *coords, const T *y_coords );
+
+  bool                         _initialized{ false };                      //!< initialization state of the object
+  bool                         _successive_drawing{ false };               //!< successive drawing is enabled; the polylines are batched
+  bool                         _active_sequence{ false };                  //!< a line sequence was started, but not finished yet
+  bool                         _gpu_arc_length{ true };                    //!< compute the arc length of the vertices on the GPU
+  CArcLengthPrefixSum          _arc_length;                                //!< prefix sum of the segment lengths on the GPU
+  TMVPBufferPtr                _mvp_buffer;                                //!< model, view, projection and viewport data
+  Render::Program::TProgramPtr _prog;                                      //!< shader program
+  int                          _view_data_loc{ -1 };                       //!< uniform block index of the model view projection data
+  int                          _color_loc{ -1 };                           //!< uniform location of the color
+  int                          _depth_attenuation_loc{ -1 };               //!< uniform location of the depth attenuation
+  int                          _width_loc{ -1 };                           //!< uniform location of the line width
+  int                          _join_loc{ -1 };                            //!< uniform location of the join type
+  int                          _cap_loc{ -1 };                             //!< uniform location of the cap type
+  int                          _miter_limit_loc{ -1 };                     //!< uniform location of the miter limit
+  int                          _no_of_polylines_loc{ -1 };                 //!< uniform location of the number of polylines
+  int                          _stipple_pattern_loc{ -1 };                 //!< uniform location of the stipple pattern
+  int                          _stipple_factor_loc{ -1 };                  //!< uniform location of the stipple factor
+  unsigned int                 _vao{ 0 };                                  //!< empty vertex array object; the vertices are read from the storage buffers
+  std::array<unsigned int, 2>  _ssbo{ 0, 0 };                              //!< storage buffers for the vertices and the polylines
+  std::array<size_t, 2>        _ssbo_size{ 0, 0 };                         //!< size of the storage buffers in bytes
+  Render::TColor               _color{ 1.0f };                             //!< line color
+  Render::Line::TStyle         _line_style;                                //!< line style parameters: width, stippling, joins and caps
+  Render::TPrimitive           _squence_type{ Render::TPrimitive::NO_OF }; //!< primitive type of the sequence
+  Render::TVertexCache         _vertex_cache;                              //!< cache for vertex coordinates of a sequence
+  std::vector<float>           _vertices;                                  //!< pending vertices: x, y, z, polyline start marker or arc length
+  std::vector<std::uint32_t>   _polylines;                                 //!< pending polylines: first vertex, number of vertices | kind << 30
+  TStatistics                  _statistics;                                //!< counters of the drawing
 };
 
 
@@ -70,4 +218,3 @@ public:
 
 
 #endif // OpenGLLine_4_h_INCLUDED
-
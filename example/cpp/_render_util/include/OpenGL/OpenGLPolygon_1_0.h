@@ -102,10 +102,16 @@ public:
   virtual bool DrawSequence( size_t coords_size, const float *coords ) override;
   virtual bool DrawSequence( size_t coords_size, const double *coords ) override;
 
+  //! Append elements to an active polygon sequence, which are written in place by the caller
+  virtual std::span<float> MapSequence( size_t coords_size ) override;
+
 private:
 
-  bool         _active_sequence{ false }; //!< true: an draw sequence was started, but not finished yet
-  unsigned int _tuple_size{ 0 };          //!< tuple size (2, 3 or 4) for a sequence
+  void SpecifyMappedVertices( void );
+
+  bool                 _active_sequence{ false }; //!< true: an draw sequence was started, but not finished yet
+  unsigned int         _tuple_size{ 0 };          //!< tuple size (2, 3 or 4) for a sequence
+  Render::TVertexCache _vertex_cache;             //!< vertex coordinates, which are mapped by `MapSequence`, but not specified yet
 };
 
 
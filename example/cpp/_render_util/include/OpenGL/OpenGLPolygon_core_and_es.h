@@ -17,9 +17,14 @@
 #include "../render/Render_IDrawType.h"
 #include "../render/Render_IDrawPolygon.h"
 #include "../render/Render_IBuffer.h"
+#include "../util/RenderUtil_Triangulation.h"
 
 #include "OpenGLDataBuffer_std140.h"
 
+// STL
+
+#include <vector>
+
 
 // class definitions
 
@@ -69,6 +74,9 @@ public:
   const Render::Polygon::TStyle & PoylgonStyle( void ) const { return _polygon_style; }
   void PoylgonStyle( const Render::Polygon::TStyle &style ) { _polygon_style = style; }
 
+  //! primitive render program; provides the batch statistics (submitted draws and OpenGL draw calls)
+  const TProgramPtr & PrimitiveProgram( void ) const { return _primitive_prog; }
+
   //! Initialize the polygon renderer
   virtual bool Init( void ) override;
   virtual bool Init( Render::TModelAndViewPtr mvp_data );
@@ -97,6 +105,16 @@ public:
   virtual bool Draw( Render::TPrimitive primitive_type, size_t no_of_coords, const float *x_coords, const float *y_coords ) override;
   virtual bool Draw( Render::TPrimitive primitive_type, size_t no_of_coords, const double *x_coords, const double *y_coords ) override;
 
+  //! Draw a concave polygon with holes, as an alternative to the stencil buffer technique.
+  //! The polygon is triangulated on the CPU. The triangulation and a draw buffer are cached by the content of the polygon,
+  //! so a static polygon is drawn by a single indexed draw call.
+  //! `contour_sizes` are the number of vertices of the outer contour and the holes; if `no_of_contours == 0`, then all the vertices form one contour.
+  bool DrawPolygon( unsigned int tuple_size, size_t coords_size, const float *coords, size_t no_of_contours = 0, const size_t *contour_sizes = nullptr );
+  bool DrawPolygon( unsigned int tuple_size, size_t coords_size, const double *coords, size_t no_of_contours = 0, const size_t *contour_sizes = nullptr );
+
+  //! cache of the polygon triangulations
+  Render::CTriangulationCache & TriangulationCache( void ) { return _triangulation_cache; }
+
   //! Start a new polygon sequence
   virtual bool StartSequence( Render::TPrimitive primitive_type, unsigned int tuple_size ) override;
   
@@ -111,9 +129,15 @@ public:
   virtual bool DrawSequence( size_t coords_size, const float *coords ) override;
   virtual bool DrawSequence( size_t coords_size, const double *coords ) override;
 
+  //! Append elements to an active polygon sequence, which are written in place by the caller
+  virtual std::span<float> MapSequence( size_t coords_size ) override;
+
 
 private:
 
+  template <typename T>
+  bool DrawPolygonT( unsigned int tuple_size, size_t coords_size, const T *coords, size_t no_of_contours, const size_t *contour_sizes );
+
   bool                    _initialized{ false };                      //!< initialization state of the object               
   bool                    _successive_draw_started{ false };          //!< successive drawing was started by this renderer
   size_t                  _min_buffer_size;                           //!< minimum size of the vertex buffer
@@ -121,6 +145,8 @@ private:
   Render::Polygon::TStyle _polygon_style;                             //!< polygon style parameters                     
   Render::TPrimitive      _squence_type{ Render::TPrimitive::NO_OF }; //!< primitive type pf the sequence
   Render::TVertexCache    _vertex_cache;                              //!< cache for vertex coordinates
+  Render::CTriangulationCache _triangulation_cache;                   //!< cached triangulations and draw buffers of concave polygons
+  std::vector<float>      _polygon_vertices;                          //!< x y z coordinates of a polygon, which is uploaded to its draw buffer
 };
 
 
@@ -22,6 +22,9 @@
 
 // STL
 
+#include <array>
+#include <vector>
+
 
 // class definitions
 
@@ -57,6 +60,14 @@ public:
 
   using TDrawBufferPtr = std::shared_ptr<Render::IDrawBuffer>;
 
+  //! counters of the batched drawing
+  struct TBatchStatistics
+  {
+    size_t _draws{ 0 };      //!< draw operations, which were submitted to the renderer 
+    size_t _draw_calls{ 0 }; //!< OpenGL draw calls (`glDrawArrays`, `glMultiDrawArrays` or `glDrawElements`)
+    size_t _vertices{ 0 };   //!< drawn vertices
+  };
+
   CPrimitiveOpenGL_core_and_es( void );
   virtual ~CPrimitiveOpenGL_core_and_es();
 
@@ -77,7 +88,7 @@ public:
   CPrimitiveOpenGL_core_and_es & SetColor( const Render::TColor8 & color );
 
   //! set depth attenuation
-  CPrimitiveOpenGL_core_and_es SetDeptAttenuation( Render::t_fp depth_attenuation );
+  CPrimitiveOpenGL_core_and_es & SetDeptAttenuation( Render::t_fp depth_attenuation );
 
   //! Notify the render that a sequence of successive primitives will follow, that is not interrupted by any other drawing operation.
   //! This allows the render to do some performance optimizations and to prepare for the primitive rendering.
@@ -102,6 +113,18 @@ public:
   //! set style and color parameter uniforms
   CPrimitiveOpenGL_core_and_es & UpdateParameterUniforms( void );
 
+  //! draw a primitive, or append it to the pending batch, if successive drawing is enabled
+  bool Draw( Render::TPrimitive primitive_type, Render::TVA va_type, size_t no_of_vertices, size_t element_size, const void *data0, const void *data1 = nullptr );
+
+  //! draw the indexed mesh of a retained draw buffer (vertex array type `i0__b0_xyz`); the pending batch is drawn before
+  bool DrawMesh( Render::TPrimitive primitive_type, Render::IDrawBuffer &buffer );
+
+  //! draw the pending batch
+  bool Flush( void );
+
+  const TBatchStatistics & BatchStatistics( void ) const { return _batch_statistics; }
+  void ResetBatchStatistics( void ) { _batch_statistics = TBatchStatistics(); }
+
   //! install the program object as part of current rendering state
   CPrimitiveOpenGL_core_and_es & Use( void );
 
@@ -113,10 +136,12 @@ private:
   void InitMVPBuffer( TMVPBufferPtr mvp_buffer );
   void InitDrawBuffer( size_t min_buffer_size );
   void InitProgram( void );
+  bool DrawBatch( void );
 
   static const size_t          _default_binding;             //!< default binding for model view and projection data buffer
   static const std::string     _vert_430;                    //!< default vertex shader for consecutive vertex attributes
   static const std::string     _frag_430;                    //!< fragment shader for uniform colored primitives 
+  static const size_t          _max_batch_size;              //!< maximum size of the vertex data of a batch in bytes
                                                                            
   TMVPBufferPtr                _mvp_buffer;                  //!< model, view, projection and viewport data
   Render::Program::TProgramPtr _prog;                        //!< shader program for consecutive vertex attributes
@@ -142,6 +167,15 @@ private:
   Render::t_fp                 _depth_attenuation = 0.0f;    //!< attenuation of the primitive color by depth
 
   bool                         _active_sequence{ false };    //!< true: an draw sequence was started, but not finished yet
+
+  Render::TPrimitive              _batch_primitive{ Render::TPrimitive::NO_OF }; //!< primitive type of the pending batch
+  Render::TVA                     _batch_va_type{ Render::unknown };             //!< vertex array object type of the pending batch
+  size_t                          _batch_element_size{ 0 };                      //!< size of the vertex attributes of the pending batch
+  size_t                          _batch_vertices{ 0 };                          //!< number of vertices of the pending batch
+  std::array<std::vector<char>, 2> _batch_data;                                  //!< vertex attributes of the pending batch (one array for each vertex buffer)
+  std::vector<int>                _batch_first;                                  //!< first vertex of each primitive of the pending batch
+  std::vector<int>                _batch_count;                                  //!< number of vertices of each primitive of the pending batch
+  TBatchStatistics                _batch_statistics;                             //!< counters of the batched drawing
 };
 
 
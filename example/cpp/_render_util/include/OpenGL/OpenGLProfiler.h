@@ -0,0 +1,145 @@
+/******************************************************************//**
+* \brief   GPU scopes by timer queries, for the frame profiler.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef OpenGLProfiler_h_INCLUDED
+#define OpenGLProfiler_h_INCLUDED
+
+
+// includes
+
+#include "OpenGL_include.h"
+#include "../util/RenderUtil_Profiler.h"
+
+
+// STL
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// class definitions
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+/******************************************************************//**
+* \brief   Pools of timer queries, which measure GPU scopes.
+*
+* A scope (`Begin`, `End`) is measured by two `GL_TIMESTAMP` queries;
+* scopes may be nested. The frame (`BeginFrame`, `EndFrame`) is
+* measured by a `GL_TIME_ELAPSED` query, so frames must not be nested.
+*
+* Each of the `no_of_frames` frames in flight has a pool of its own.
+* The results of a pool are only read, when they are available, so the
+* profiler never stalls the pipeline; usually they are read
+* `no_of_frames - 1` frames late. If a pool is still busy, when it is
+* needed again, its results are discarded.
+*
+* The scopes are pushed to the track "GPU" of `Render::CProfiler`. The
+* GPU time is mapped to the CPU time of the profiler by `GL_TIMESTAMP`,
+* at the begin of each frame.
+*
+*     OpenGL::CGpuProfiler gpu;
+*     gpu.BeginFrame();
+*     gpu.Begin( "opaque" );
+*     ...
+*     gpu.End();
+*     gpu.EndFrame();
+*
+* Nothing is recorded, while the profiler is disabled, or if timer
+* queries are not supported (OpenGL 3.3 or `ARB_timer_query`).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CGpuProfiler
+{
+public:
+
+  static const size_t c_default_frames = 4;   //!< default number of frames in flight
+  static const size_t c_default_scopes = 64;  //!< default maximum number of scopes per frame
+
+  struct TStatistics
+  {
+    size_t _frames    = 0; //!< number of read frames
+    size_t _scopes    = 0; //!< number of read scopes
+    size_t _discarded = 0; //!< number of frames, whose results were not available in time
+    size_t _overflow  = 0; //!< number of scopes, which exceeded the pool
+  };
+
+  CGpuProfiler( size_t no_of_frames = c_default_frames, size_t max_scopes = c_default_scopes );
+  ~CGpuProfiler();
+
+  CGpuProfiler( const CGpuProfiler & ) = delete;
+  CGpuProfiler & operator =( const CGpuProfiler & ) = delete;
+
+  static bool Supported( void ); //!< timer queries are supported by the current context
+
+  const TStatistics & Statistics( void ) const { return _statistics; }
+
+  void Destroy( void ); //!< delete the query objects; the context has to be current
+
+  void BeginFrame( void );
+  void EndFrame( void );
+
+  void Begin( const char *name ); //!< begin a scope; `name` has to be a string literal
+  void End( void );               //!< end the innermost scope
+
+  void Flush( void ); //!< wait for the pending frames and push their scopes, e.g. before the trace is written
+
+private:
+
+  struct TScope
+  {
+    const char *_name;
+    size_t      _begin; //!< index of the begin query
+    size_t      _end;   //!< index of the end query
+  };
+
+  struct TPool
+  {
+    std::vector<GLuint> _queries;               //!< timestamp queries
+    GLuint              _elapsed = 0;           //!< time elapsed query of the frame
+    std::vector<TScope> _scopes;
+    size_t              _used = 0;              //!< number of used timestamp queries
+    size_t              _frame_begin = 0;       //!< index of the timestamp query of the frame begin
+    std::int64_t        _offset = 0;            //!< CPU time minus GPU time, in nanoseconds
+    bool                _pending = false;       //!< the queries of the frame are issued, but not read
+  };
+
+  bool Active( void );
+  bool Timestamp( TPool &pool, size_t &index );
+  void Collect( bool all );
+  bool Read( TPool &pool );
+
+  std::vector<TPool>    _pools;
+  size_t                _max_scopes;
+  size_t                _current = 0;      //!< pool of the current frame
+  size_t                _oldest  = 0;      //!< oldest pending pool
+  int                   _supported = -1;   //!< -1: unknown
+  bool                  _in_frame = false;
+  std::vector<size_t>   _open;             //!< indices of the open scopes of the current frame
+  Render::CProfileRing *_track = nullptr;
+  TStatistics           _statistics;
+};
+
+
+} // OpenGL
+
+#endif // OpenGLProfiler_h_INCLUDED
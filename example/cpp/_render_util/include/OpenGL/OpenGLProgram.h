@@ -21,6 +21,7 @@
 #include <tuple> 
 #include <string> 
 #include <unordered_map> 
+#include <memory>
 
 
 // class definitions
@@ -79,19 +80,103 @@ public:
   virtual CShaderObject & operator << ( std::string && code ) override;
   virtual CShaderObject & ClearCode( void ) override;
   
+  // source code of the shader
+  const std::deque<std::string> & Code( void ) const { return _code; }
+  
   // Compile the shader stage, the function succeeds, even if the compilation fails, but it fails if the stage was not properly initialized.
+  // If a program binary cache is installed, then the compilation is deferred until a program has to be linked from the source code.
   virtual bool Compile( void ) override;
+
+  // Compile a deferred shader stage.
+  bool CompileDeferred( void );
+
+  // true if the compilation is deferred
+  bool Deferred( void ) const { return _deferred; }
   
   // Verifies the compilation result.
   virtual bool Verify( std::string &message ) override;
 
 private: 
 
+  bool CompileSource( void );
+
   static const std::vector<std::tuple<Render::Program::TShaderType, size_t>> c_type_map;
 
-  std::deque<std::string>      _code;       //!< shader source code
-  Render::Program::TShaderType _type;       //!< type the shader (stage)
-  unsigned int                 _object = 0; //!< named shader object (GPU)
+  std::deque<std::string>      _code;            //!< shader source code
+  Render::Program::TShaderType _type;            //!< type the shader (stage)
+  unsigned int                 _object = 0;      //!< named shader object (GPU)
+  bool                         _deferred = false; //!< compilation is deferred
+};
+
+
+//*********************************************************************
+// CProgramBinaryCache
+//*********************************************************************
+
+/******************************************************************//**
+* rief On disk cache of linked program binaries
+* (`glGetProgramBinary`, `glProgramBinary`, OpenGL 4.1).
+*
+* The key of a program is a hash code of the source code of its shader
+* stages, the additional resource bindings and the vendor, renderer and
+* version strings of the OpenGL driver. Each binary is stored in a file
+* `<key>.glpb` in the cache directory. The file contains the complete
+* identity (description and driver strings) of the program, so a hash
+* collision of the key is detected and the program is compiled.
+*
+* A binary, which is rejected by the driver (e.g. after a driver
+* update), is removed and the program is compiled from its source.
+*
+* The cache is used by `CShaderProgram::Link`, when it is installed
+* by `Install`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CProgramBinaryCache
+{
+public:
+
+  //! statistics of the program cache
+  struct TStatistics
+  {
+    size_t _hits      = 0;    //!< programs loaded from a binary
+    size_t _misses    = 0;    //!< programs compiled and linked from source code
+    size_t _rejected  = 0;    //!< binaries rejected by the driver
+    size_t _stored    = 0;    //!< binaries written to the cache
+    double _hit_ms    = 0.0;  //!< total time of loading binaries in milliseconds
+    double _miss_ms   = 0.0;  //!< total time of compiling and linking in milliseconds
+  };
+
+  CProgramBinaryCache( const std::string &directory );
+  virtual ~CProgramBinaryCache();
+
+  static void Install( std::shared_ptr<CProgramBinaryCache> cache );  //!< install a cache which is used by all programs; `nullptr` uninstalls the cache
+  static CProgramBinaryCache * Installed( void );                      //!< the installed cache
+  static bool Supported( void );                                       //!< true if the current context supports at least one binary format
+
+  const std::string & Directory( void ) const { return _directory; }
+  const TStatistics & Statistics( void ) const { return _statistics; }
+  std::string Report( void ) const;
+
+  std::string Identity( const std::string &program_description ) const;                            //!< program description and driver strings; requires a current context
+  static std::string Key( const std::string &identity );                                           //!< key (file name) of a program identity
+  bool Load( const std::string &key, const std::string &identity, unsigned int &format, std::vector<char> &binary ) const; //!< read a binary
+  bool Store( const std::string &key, const std::string &identity, unsigned int format, const std::vector<char> &binary ); //!< write a binary
+  void Reject( const std::string &key );                                                          //!< remove a binary, which was rejected by the driver
+
+  void Hit( double ms )  { ++ _statistics._hits; _statistics._hit_ms += ms; }
+  void Miss( double ms ) { ++ _statistics._misses; _statistics._miss_ms += ms; }
+
+private:
+
+  std::string Path( const std::string &key ) const;
+
+  static std::shared_ptr<CProgramBinaryCache> _installed; //!< installed cache
+
+  std::string _directory;  //!< cache directory
+  TStatistics _statistics; //!< statistics
 };
 
 
@@ -163,11 +248,16 @@ public:
 
 private:
 
+  bool Description( std::string &description ) const;
+  bool LinkBinary( CProgramBinaryCache &cache, const std::string &key, const std::string &identity );
+  void StoreBinary( CProgramBinaryCache &cache, const std::string &key, const std::string &identity );
+
   TShaderList           _shaders;                                              //!< shader objects linked to a program
   TResourceLinkList     _resource_binding;                                     //!< additional resource bindings for linking the program
   TTranformFeedbackMode _transform_feedback_mode = TTranformFeedbackMode::NON; //!< buffer mode for transform feedback shader (required for linking)
   unsigned int          _object                  = 0;                          //!< named program object (GPU)
   int                   _object_status           = 0;                          //!< status of the verified program object
+  std::string           _compile_messages;                                     //!< messages of the deferred compilation of the shader objects
 };
 
 
@@ -0,0 +1,134 @@
+/******************************************************************//**
+* \brief   Asynchronous read back of the framebuffer by pixel buffer
+*          objects.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef OpenGLReadback_h_INCLUDED
+#define OpenGLReadback_h_INCLUDED
+
+
+// includes
+
+#include "OpenGL_include.h"
+
+
+// STL
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// class definitions
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+/******************************************************************//**
+* \brief   Ring of pixel buffer objects for the asynchronous read
+*          back of RGBA8 frames.
+*
+* `Read` copies a rectangle of the read framebuffer to the next pixel
+* buffer of the ring (`glReadPixels` to `GL_PIXEL_PACK_BUFFER`) and
+* inserts a fence. The call returns, without waiting for the GPU.
+* `Retrieve` maps the oldest buffer, when its fence is signaled, and
+* copies the pixels to a frame, top row first.
+*
+* With 2 buffers, frame `n` is retrieved while frame `n+1` is
+* rendered:
+*
+*     OpenGL::CAsyncReadback readback( 2 );
+*     OpenGL::CAsyncReadback::TFrame frame;
+*     for ( size_t i = 0; i < n; ++ i )
+*     {
+*       ... render frame i ...
+*       if ( readback.Read( 0, 0, width, height, i ) == false )
+*       {
+*         readback.Retrieve( frame, true );  // ring is full
+*         readback.Read( 0, 0, width, height, i );
+*       }
+*       while ( readback.Retrieve( frame, false ) ) // frames which are ready
+*         ... frame._rgba ...
+*     }
+*     while ( readback.Retrieve( frame, true ) )
+*       ... frame._rgba ...
+*
+* A blocking `Retrieve`, which has to wait for the fence, is counted as
+* stall. The pixel pack buffer binding is restored to 0.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CAsyncReadback
+{
+public:
+
+  struct TFrame
+  {
+    std::vector<std::uint8_t> _rgba;       //!< RGBA8 pixels, top row first
+    size_t                    _width  = 0;
+    size_t                    _height = 0;
+    size_t                    _tag    = 0; //!< tag of `Read`
+  };
+
+  struct TStatistics
+  {
+    size_t _reads     = 0; //!< number of read operations
+    size_t _retrieved = 0; //!< number of retrieved frames
+    size_t _stalls    = 0; //!< number of retrievals, which had to wait for the GPU
+  };
+
+  CAsyncReadback( size_t no_of_buffers = 2 );
+  ~CAsyncReadback();
+
+  CAsyncReadback( const CAsyncReadback & ) = delete;
+  CAsyncReadback & operator =( const CAsyncReadback & ) = delete;
+
+  size_t              Size( void )       const { return _buffers.size(); }
+  size_t              Pending( void )    const { return _pending; } //!< number of frames in flight
+  const TStatistics & Statistics( void ) const { return _statistics; }
+
+  void Destroy( void ); //!< delete the GPU objects; the context has to be current
+
+  //! start the read back of a rectangle of the read framebuffer; false, if the ring is full
+  bool Read( int x, int y, size_t width, size_t height, size_t tag = 0 );
+
+  //! retrieve the oldest frame; false, if no frame is pending, or if `wait` is false and the frame is not ready
+  bool Retrieve( TFrame &frame, bool wait );
+
+private:
+
+  struct TBuffer
+  {
+    GLuint _object = 0;
+    size_t _capacity = 0;    //!< size of the buffer store in bytes
+    GLsync _fence = nullptr;
+    size_t _width = 0;
+    size_t _height = 0;
+    size_t _tag = 0;
+  };
+
+  std::vector<TBuffer> _buffers;
+  size_t               _next = 0;    //!< next buffer to read to
+  size_t               _pending = 0; //!< number of pending buffers before `_next`
+  TStatistics          _statistics;
+};
+
+
+} // OpenGL
+
+#endif // OpenGLReadback_h_INCLUDED
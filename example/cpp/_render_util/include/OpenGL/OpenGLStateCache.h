@@ -0,0 +1,433 @@
+/******************************************************************//**
+* \brief Shadow state of the OpenGL context: filter redundant binds of
+* programs, vertex array objects, textures and blend state, and
+* redundant uniform updates.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef OpenGLStateCache_h_INCLUDED
+#define OpenGLStateCache_h_INCLUDED
+
+// includes
+
+#include "OpenGL_include.h"
+#include "../util/RenderUtil_Hash.h"
+#include "../util/RenderUtil_Profiler.h"
+
+
+// STL
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+
+
+// class definitions
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+/******************************************************************//**
+* \brief Name of a uniform with its hash code.
+*
+* The hash code (32 bit FNV-1a) is computed at compile time, if the
+* object is declared `constexpr`:
+*
+*     constexpr TUniformName c_u_color{ "u_color" };
+*     prog.SetUniformF4( c_u_color, color );
+*
+* The program resolves the location of the name once and finds the
+* location of subsequent calls by the hash code.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TUniformName
+{
+  constexpr explicit TUniformName( std::string_view name )
+    : _name( name )
+    , _hash( Hash( name ) )
+  {}
+
+  static constexpr std::uint32_t Hash( std::string_view name ) { return Render::HashFNV1a32( name ); }
+
+  std::string_view _name; //!< name of the uniform in the shader program
+  std::uint32_t    _hash;  //!< FNV-1a hash code of the name
+};
+
+
+/******************************************************************//**
+* \brief Shadow state of the OpenGL context.
+*
+* The bindings of programs, vertex array objects and textures and the
+* blend state are only passed to OpenGL, if they differ from the
+* tracked state. Further the cache counts the issued and the elided
+* state changes and uniform updates of the current and the last frame.
+*
+* The cache is a thread local object, because an OpenGL context is
+* current in one thread only.
+*
+* The filter is disabled by default; then all calls are passed to
+* OpenGL and only counted. While the filter is enabled, the tracked
+* state has to be changed by the cache only, or the cache has to be
+* invalidated (`Invalidate`) after the state was changed by raw OpenGL
+* calls (or after the current context was changed).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CStateCache
+{
+public:
+
+  static const unsigned int c_max_texture_units = 32; //!< number of tracked texture units
+
+  //! number of issued and elided calls
+  struct TCounter
+  {
+    size_t _issued = 0;
+    size_t _elided = 0;
+  };
+
+  //! counters of one frame
+  struct TFrameCounters
+  {
+    TCounter _state;    //!< binding and blend state changes
+    TCounter _uniforms; //!< uniform updates
+  };
+
+  //! state cache of the current thread
+  static CStateCache & Current( void )
+  {
+    thread_local CStateCache cache;
+    return cache;
+  }
+
+  bool Filter( void ) const { return _filter; }                                      //!< true: redundant calls are elided
+  CStateCache & Filter( bool filter ) { _filter = filter; Invalidate(); return *this; } //!< enable or disable the filter
+
+  const TFrameCounters & Frame( void ) const { return _frame; }          //!< counters of the current frame
+  const TFrameCounters & LastFrame( void ) const { return _last_frame; } //!< counters of the last completed frame
+
+  //! complete the counters of the current frame
+  void NewFrame( void )
+  {
+    _last_frame = _frame;
+    _frame      = TFrameCounters();
+  }
+
+  //! forget the tracked state; the next calls are passed to OpenGL
+  void Invalidate( void )
+  {
+    _program      = c_unknown;
+    _vao          = c_unknown;
+    _active_unit  = c_unknown;
+    _blend        = -1;
+    _blend_func   = { c_unknown, c_unknown };
+    for ( auto &unit : _textures )
+      unit = { c_unknown, c_unknown };
+    ++ _generation;
+  }
+
+  //! number of invalidations; uniform shadow values of an older generation are not valid
+  size_t Generation( void ) const { return _generation; }
+
+  //! count a uniform update
+  void CountUniform( bool issued )
+  {
+    ++ ( issued ? _frame._uniforms._issued : _frame._uniforms._elided );
+  }
+
+  //! install a program object
+  void UseProgram( GLuint program )
+  {
+    if ( Elide( _program == program ) )
+      return;
+    glUseProgram( program );
+    _program = program;
+  }
+
+  //! bind a vertex array object
+  void BindVertexArray( GLuint vao )
+  {
+    if ( Elide( _vao == vao ) )
+      return;
+    glBindVertexArray( vao );
+    _vao = vao;
+  }
+
+  //! select the active texture unit
+  void ActiveTexture( unsigned int unit )
+  {
+    if ( Elide( _active_unit == unit ) )
+      return;
+    glActiveTexture( (GLenum)(GL_TEXTURE0 + unit) );
+    _active_unit = unit;
+  }
+
+  //! bind a texture object to a texture unit
+  void BindTexture( unsigned int unit, GLenum target, GLuint texture )
+  {
+    if ( unit >= c_max_texture_units )
+    {
+      Count( true );
+      glActiveTexture( (GLenum)(GL_TEXTURE0 + unit) );
+      glBindTexture( target, texture );
+      _active_unit = unit;
+      return;
+    }
+    auto &binding = _textures[unit];
+    if ( Elide( binding[0] == target && binding[1] == texture ) )
+      return;
+    ActiveTexture( unit );
+    glBindTexture( target, texture );
+    binding = { target, texture };
+  }
+
+  //! bind a texture object to a texture unit by direct state access; the active texture unit is not changed
+  void BindTextureUnit( unsigned int unit, GLenum target, GLuint texture )
+  {
+    if ( unit >= c_max_texture_units )
+    {
+      Count( true );
+      glBindTextureUnit( unit, texture );
+      return;
+    }
+    auto &binding = _textures[unit];
+    if ( Elide( binding[0] == target && binding[1] == texture ) )
+      return;
+    glBindTextureUnit( unit, texture );
+    binding = { target, texture };
+  }
+
+  //! bind a texture object to the active texture unit
+  void BindTexture( GLenum target, GLuint texture )
+  {
+    if ( _active_unit == c_unknown || _active_unit >= c_max_texture_units )
+    {
+      // the binding of an unknown unit is changed
+      Count( true );
+      glBindTexture( target, texture );
+      if ( _active_unit == c_unknown )
+      {
+        for ( auto &unit : _textures )
+          unit = { c_unknown, c_unknown };
+      }
+      return;
+    }
+    BindTexture( _active_unit, target, texture );
+  }
+
+  //! delete texture objects; deleted textures are unbound from all units
+  void DeleteTextures( GLsizei n, const GLuint *textures )
+  {
+    glDeleteTextures( n, textures );
+    for ( GLsizei i = 0; i < n; ++ i )
+    {
+      for ( auto &unit : _textures )
+      {
+        if ( unit[1] == textures[i] )
+          unit[1] = 0;
+      }
+    }
+  }
+
+  //! delete vertex array objects; a deleted bound object reverts the binding to 0
+  void DeleteVertexArrays( GLsizei n, const GLuint *vaos )
+  {
+    glDeleteVertexArrays( n, vaos );
+    for ( GLsizei i = 0; i < n; ++ i )
+    {
+      if ( _vao == vaos[i] )
+        _vao = 0;
+    }
+  }
+
+  //! enable or disable blending
+  void Blend( bool enable )
+  {
+    if ( Elide( _blend == (enable ? 1 : 0) ) )
+      return;
+    if ( enable )
+      glEnable( GL_BLEND );
+    else
+      glDisable( GL_BLEND );
+    _blend = enable ? 1 : 0;
+  }
+
+  //! set the blend function
+  void BlendFunc( GLenum source, GLenum destination )
+  {
+    if ( Elide( _blend_func[0] == source && _blend_func[1] == destination ) )
+      return;
+    glBlendFunc( source, destination );
+    _blend_func = { source, destination };
+  }
+
+private:
+
+  static const unsigned int c_unknown = 0xffffffff;
+
+  CStateCache( void ) = default;
+
+  void Count( bool issued )
+  {
+    ++ ( issued ? _frame._state._issued : _frame._state._elided );
+    if ( issued )
+    {
+      RENDERUTIL_PROFILE_COUNT( state_changes, 1 )
+    }
+  }
+
+  //! evaluate if a state change is redundant
+  bool Elide( bool equal )
+  {
+    bool elide = _filter && equal;
+    Count( elide == false );
+    return elide;
+  }
+
+  bool                                                     _filter{ false };
+  size_t                                                   _generation{ 0 };
+  unsigned int                                             _program{ c_unknown };
+  unsigned int                                             _vao{ c_unknown };
+  unsigned int                                             _active_unit{ c_unknown };
+  int                                                      _blend{ -1 };
+  std::array<unsigned int, 2>                              _blend_func{ c_unknown, c_unknown };
+  std::array<std::array<unsigned int, 2>, c_max_texture_units> _textures{};
+  TFrameCounters                                           _frame;
+  TFrameCounters                                           _last_frame;
+};
+
+
+/******************************************************************//**
+* \brief Uniform locations and shadow copies of the uniform values of
+* one shader program.
+*
+* A uniform is identified by a handle, which is an index in the list
+* of the resolved locations. The handle of an inactive uniform is
+* `c_no_uniform`; updates of it are ignored.
+*
+* `Update` returns false, if the new value is equal to the value which
+* was set last; then the `glUniform*` call can be skipped. Values are
+* compared bitwise.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CUniformCache
+{
+public:
+
+  using TUniformHandle = int;
+
+  static const TUniformHandle c_no_uniform = -1;
+
+  //! location of a uniform
+  GLint Location( TUniformHandle handle ) const
+  {
+    return handle >= 0 && handle < (TUniformHandle)_slots.size() ? _slots[handle]._location : -1;
+  }
+
+  //! get the handle of a uniform location
+  TUniformHandle Handle( GLint location )
+  {
+    if ( location < 0 )
+      return c_no_uniform;
+    auto it = _locations.find( location );
+    if ( it != _locations.end() )
+      return it->second;
+    TSlot slot;
+    slot._location = location;
+    _slots.push_back( slot );
+    TUniformHandle handle = (TUniformHandle)_slots.size() - 1;
+    _locations[location] = handle;
+    return handle;
+  }
+
+  //! get the handle of a uniform name; the location is resolved by `resolve` on the first call only
+  template <class TResolve>
+  TUniformHandle Handle( const TUniformName &name, TResolve resolve )
+  {
+    auto it = _names.find( name._hash );
+    if ( it != _names.end() )
+    {
+      ASSERT( it->second.first == name._name ); // hash collision
+      return it->second.second;
+    }
+    std::string name_str( name._name );
+    TUniformHandle handle = Handle( (GLint)resolve( name_str ) );
+    _names[name._hash] = { std::move( name_str ), handle };
+    return handle;
+  }
+
+  //! update the shadow value; returns true if the uniform has to be set
+  bool Update( TUniformHandle handle, const void *value, size_t size )
+  {
+    if ( handle < 0 || handle >= (TUniformHandle)_slots.size() )
+      return false;
+
+    CStateCache &state = CStateCache::Current();
+    TSlot &slot = _slots[handle];
+    bool equal =
+      state.Filter() &&
+      slot._generation == state.Generation() &&
+      slot._size == size &&
+      std::memcmp( slot._value.data(), value, size ) == 0;
+    state.CountUniform( equal == false );
+    if ( equal )
+      return false;
+
+    slot._size       = size <= sizeof( slot._value ) ? size : 0;
+    slot._generation = state.Generation();
+    if ( slot._size > 0 )
+      std::memcpy( slot._value.data(), value, slot._size );
+    return true;
+  }
+
+  //! forget the shadow values
+  void Invalidate( void )
+  {
+    for ( auto &slot : _slots )
+      slot._size = 0;
+  }
+
+private:
+
+  struct TSlot
+  {
+    GLint                        _location   = -1;
+    size_t                       _size       = 0;  //!< size of the shadow value in bytes; 0: unknown value
+    size_t                       _generation = 0;  //!< generation of the state cache, when the value was set
+    std::array<std::uint32_t, 16> _value{};        //!< shadow value (up to a 4x4 matrix)
+  };
+
+  std::vector<TSlot>                                                          _slots;     //!< resolved uniforms
+  std::unordered_map<GLint, TUniformHandle>                                   _locations; //!< location -> handle
+  std::unordered_map<std::uint32_t, std::pair<std::string, TUniformHandle>>      _names;     //!< name hash -> name (a copy, the name of `TUniformName` may be a temporary) and handle
+};
+
+
+} // OpenGL
+
+
+#endif // OpenGLStateCache_h_INCLUDED
@@ -13,10 +13,13 @@
 // includes
 
 #include "../render/Render_ITexture.h"
+#include "../util/RenderUtil_HeightMap.h"
 
 // STL
 
 #include <array>
+#include <string>
+#include <vector>
 
 
 // class definitions
@@ -54,6 +57,7 @@ class CTextureLoader
 public: 
 
   using Render::ITextureLoader::CreateTexture;
+  using Render::ITextureLoader::LoadToTexture;
 
   CTextureLoader( void );                     //!< default constructor
   CTextureLoader( size_t loader_binding_id ); //!< constructor
@@ -69,14 +73,29 @@ public:
   //! enable anisotropic filter
   void SetMaxAnisotropicSamples( int max_anisotripic_samples ) { _max_anisotripic_samples = max_anisotripic_samples; }
 
+  //! set the parameters of the height map transformations (`to_displacement_map`, `to_normal_and_displacement`)
+  void SetHeightMapParameters( const Render::THeightMapParameters &parameters ) { _height_map_parameters = parameters; }
+
+  //! set the directory of the height map transformation cache files; empty: no cache
+  void SetHeightMapCacheDirectory( const std::string &directory ) { _height_map_cache_directory = directory; }
+
   //! create a new but empty texture
   virtual Render::ITexturePtr CreateTexture(const Render::TTextureSize &size, size_t layers, const Render::TTextureParameters &parameter) override;
 
   //! create a new texture from an image resource
   virtual Render::ITexturePtr CreateTexture(const Render::IImageResource &image, Render::TImageTransformations transform, const Render::TTextureSize &size, size_t layers, const Render::TTextureParameters &parameter) override;
 
-  //! load image data to texture
-  virtual bool LoadToTexture(const Render::IImageResource &image, Render::ITexture &texture, const Render::TTexturePoint &pos, size_t layer) override;
+  //! create a new texture from a complete chain of mipmap levels
+  virtual Render::ITexturePtr CreateTexture(const std::vector<const Render::IImageResource*> &mipmaps, const Render::TTextureParameters &parameter) override;
+
+  //! allocate the mipmap levels 1 to `levels`-1 of a texture
+  virtual bool AllocateLevels(Render::ITexture &texture, const Render::TTextureParameters &parameter, const Render::TTextureSize &size, size_t levels) override;
+
+  //! restrict the accessible mipmap levels of a texture
+  virtual bool SetLevelRange(Render::ITexture &texture, size_t base_level, size_t max_level) override;
+
+  //! load image data to a mipmap level of a texture
+  virtual bool LoadToTexture(const Render::IImageResource &image, Render::ITexture &texture, const Render::TTexturePoint &pos, size_t layer, size_t level) override;
 
 
   //! map texture type to OpenGL target type enumerator constant
@@ -117,6 +136,9 @@ protected:
   //! create a new but empty texture
   Render::ITexturePtr CreateTexture(const Render::TTextureSize &size, size_t layers, const Render::TTextureParameters &parameter, bool set_parameters);
 
+  //! allocate an uninitialized level of a texture
+  static void AllocateLevel( unsigned int target, int level, const Render::TTextureParameters &parameter, size_t cx, size_t cy );
+
 
 private:
 
@@ -142,6 +164,12 @@ private:
   int _max_anisotripic_samples = -1; 
 
   size_t _loader_binding_id = 0;
+
+  //! parameters of the height map transformations
+  Render::THeightMapParameters _height_map_parameters;
+
+  //! directory of the height map transformation cache files
+  std::string _height_map_cache_directory;
 };
 
 } // OpenGL
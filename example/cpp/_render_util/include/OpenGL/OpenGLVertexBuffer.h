@@ -16,6 +16,7 @@
 
 #include "../render/Render_IBuffer.h"
 
+#include <array>
 #include <tuple>
 #include <vector>
 #include <map>
@@ -46,6 +47,18 @@ namespace OpenGL
 * 
 * Uses vertex array buffers.
 *
+* With the usage `TDrawBufferUsage::stream_ring` each buffer is a
+* persistently mapped ring buffer (OpenGL 4.4, `ARB_buffer_storage`),
+* which is split in 3 regions. The updates are appended to the current
+* region. When a region is full, a fence is inserted and the update
+* continues in the next region, after the fence of the next region is
+* signaled. So the buffer is never re-specified while the GPU reads it.
+* The draw operations take the position of the last update into account,
+* either by a base vertex or by re-specifying the attribute offsets of
+* the vertex array object.
+* If persistent mapping is not available (e.g. OpenGL ES), the buffers
+* are orphaned before they are updated.
+*
 * Uses RAII (Resource acquisition is initialization) technique.
 * [https://en.wikipedia.org/wiki/Resource_acquisition_is_initialization]
 * This means that this class is not copyable or copy constructible,
@@ -76,6 +89,21 @@ public: // public types
   constexpr static const int c_count = 2; //!< tuple index for number of elements
   constexpr static const int c_elemS = 3; //!< tuple index for size of one elements
 
+  constexpr static const size_t c_ring_regions = 3; //!< number of regions of a streaming ring buffer
+
+  //! counters of the streaming buffers (`TDrawBufferUsage::stream_ring`)
+  struct TStreamStatistics
+  {
+    size_t _updates{ 0 };           //!< updates of a persistently mapped ring buffer
+    size_t _bytes{ 0 };             //!< bytes written to the ring buffers
+    size_t _wraps{ 0 };             //!< switches to the next region of a ring buffer
+    size_t _stalls{ 0 };            //!< region switches, which had to wait for the GPU 
+    double _stall_time{ 0.0 };      //!< time in seconds, which the CPU waited for fences
+    size_t _grows{ 0 };             //!< ring buffers which were recreated, because the data didn't fit into a region
+    size_t _respecifications{ 0 };  //!< attribute offsets re-specified, because the buffers of a vertex array object had no common base vertex
+    size_t _orphans{ 0 };           //!< updates without persistent mapping, which orphaned the buffer
+  };
+
 public: // public operations
 
   CDrawBuffer( void );
@@ -97,6 +125,7 @@ public: // public operations
   virtual void SpecifyVA( size_t description_size, const char *description ) override;
   virtual bool UpdateVB( size_t id, size_t element_size, size_t no_of_elements, const void *data ) override;
   virtual bool UpdateIB( size_t id, size_t element_size, size_t no_of_elements, const void *data ) override;
+  virtual size_t BaseVertex( size_t id ) const override;
 
   virtual void DrawAllElements( Render::TPrimitive primitive_type, bool bind ) override;
   virtual void DrawElements( Render::TPrimitive primitive_type, size_t start, size_t count, bool bind ) override;
@@ -106,10 +135,29 @@ public: // public operations
   virtual void DrawElementsBase( Render::TPrimitive primitive_type, size_t element_size, size_t no_of_elements, const void *data, size_t base_index, bool bind ) override;
   virtual void DrawRangeElements( Render::TPrimitive primitive_type, unsigned int minInx, unsigned int maxInx, bool bind ) override;
   virtual void DrawArray( Render::TPrimitive primitive_type, size_t start, size_t count, bool bind  ) override;
+  virtual void MultiDrawArray( Render::TPrimitive primitive_type, size_t list_size, const int *first, const int *count, bool bind ) override;
 
   virtual void Prepare( void ) override;
   virtual void Release( void ) override;
 
+  const TStreamStatistics & StreamStatistics( void ) const { return _streamStatistics; }
+  void ResetStreamStatistics( void ) { _streamStatistics = TStreamStatistics(); }
+
+
+protected: // protected types
+
+  //! persistently mapped ring buffer 
+  struct TStreamRing
+  {
+    char                              *_ptr{ nullptr };    //!< persistent mapping of the buffer
+    size_t                             _region_size{ 0 };  //!< size of a region in bytes
+    size_t                             _region{ 0 };       //!< current region
+    size_t                             _head{ 0 };         //!< first free byte in the current region
+    size_t                             _offset{ 0 };       //!< byte offset of the last update
+    size_t                             _stride{ 1 };       //!< vertex (or index) size of the last update
+    std::array<void*, c_ring_regions>  _fences{};          //!< fence (`GLsync`) of each region, which was left
+  };
+  using TStreamRings = std::unordered_map<TGPUObj, TStreamRing>; //!< ring of a buffer object <GPU name>
 
 protected: // protected operations
 
@@ -122,11 +170,22 @@ protected: // protected operations
   unsigned int Usage( void ) const;
   virtual void UnbindVAO( void );
   virtual void BindVAO( void );
-  virtual void DefineAndEnableAttribute( int attr_id, int attr_size, Render::TAttributeType elem_type, int attr_offs, int stride ) const;
+  virtual void DefineAndEnableAttribute( int attr_id, int attr_size, Render::TAttributeType elem_type, int attr_offs, int stride, size_t buffer_offs ) const;
   virtual void DisableAttribute( int attr_id ) const;
-  void         PreprateAttributesAndIndices( const TDescription &key );
+  virtual bool StreamRingSupported( void ) const;
+  bool         StreamRing( void );
+  void         PreprateAttributesAndIndices( const TDescription &key, const size_t *buffer_offsets = nullptr );
   void         CreateMissingBuffers( int i_ibo, size_t no_of_vbo );
-  size_t       UpdateBuffer( int type, TGPUObj bo, size_t curr_size, size_t min_size, size_t data_size, const void *data ) const;
+  size_t       UpdateBuffer( int type, TGPUObj bo, size_t curr_size, size_t min_size, size_t data_size, const void *data );
+  bool         StreamToRing( TGPUObj &bo, size_t &curr_size, size_t stride, size_t data_size, const void *data );
+  bool         CreateRing( TGPUObj &bo, size_t &curr_size, size_t data_size, size_t align );
+  void         DeleteRing( TGPUObj bo );
+  void         RespecifyVertexArrays( void );
+  void         WaitForRegion( TStreamRing &ring, size_t region );
+  size_t       VertexSize( const TDescription &key, size_t buffer_inx ) const;
+  bool         StreamOffsets( const TDescription &key, std::vector<size_t> &offsets, size_t &base_vertex ) const;
+  size_t       StreamBaseVertex( void );
+  size_t       IndexOffset( void ) const { return _currIndexOffs; }
   THashCode    HashDescription( size_t description_size, const char *description ) const;
   bool         FindExistingVAO( THashCode hashCode, size_t description_size, const char *description );
   TVAO *       FindExistingVAO( TGPUObj vao );
@@ -138,10 +197,19 @@ protected: // protected attributes
   TGPUObj                  _currentVAO   = 0;                                     //!< current selected vertex array object <GPU name>
   size_t                   _currNoElems  = 0;                                     //!< number of elements in the currently selected vertex array object
   size_t                   _currElemSize = 0;                                     //!< size of an element in the currently selected vertex array object
+  size_t                   _currIndexOffs = 0;                                    //!< byte offset of the indices in the element array buffer of the currently selected vertex array object
   TVBOs                    _vbos;                                                 //!< map description -> (vertex array object <GPU name>, description)
   TIBOs                    _ibos;                                                 //!< map index -> ( element array buffer <GPU name>, size <count> of element array buffer )
   TVAOs                    _vaos;                                                 //!< list of array buffers ( array buffer <GPU name>, size <count> of array buffer )
   TVAOShortcut             _shortcuts;                                            //!< vertex array object specification shortcuts
+  int                      _streamSupport = -1;                                   //!< persistent mapping is supported: -1 not checked yet, 0 no, 1 yes
+  TStreamRings             _rings;                                                //!< streaming ring buffers
+  std::unordered_map<TGPUObj, std::vector<size_t>> _vaoOffsets;                   //!< attribute buffer offsets, which are specified in a vertex array object
+  std::vector<size_t>      _tempOffsets;                                          //!< buffer offsets of the current vertex array object
+  std::vector<int>         _tempFirst;                                            //!< first vertices for `MultiDrawArray` with a base vertex
+  std::vector<int>         _tempBase;                                             //!< base vertices for `DrawElements` with a list of index arrays
+  std::vector<const void*> _tempIndices;                                          //!< index array offsets in the ring range for `DrawElements` with a list of index arrays
+  TStreamStatistics        _streamStatistics;                                     //!< counters of the streaming buffers
 };
 
 
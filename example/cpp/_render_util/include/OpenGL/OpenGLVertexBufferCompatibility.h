@@ -72,7 +72,7 @@ public: // public operations
 
 protected: // protected operations
 
-  virtual void DefineAndEnableAttribute( int attr_id, int attr_size, Render::TAttributeType elem_type, int attr_offs, int stride ) const override;
+  virtual void DefineAndEnableAttribute( int attr_id, int attr_size, Render::TAttributeType elem_type, int attr_offs, int stride, size_t buffer_offs ) const override;
   virtual void DisableAttribute( int attr_id ) const;
 
   // compatibility buffer specification shortcuts
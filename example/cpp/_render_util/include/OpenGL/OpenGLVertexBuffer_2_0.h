@@ -78,6 +78,9 @@ protected: // protected operations
   virtual void UnbindVAO( void );
   virtual void BindVAO( void );
 
+  //! the attribute arrays are specified at each bind, so the attribute offsets of a ring buffer can't be tracked
+  virtual bool StreamRingSupported( void ) const override { return false; }
+
 private: // private attributes
 
   TGPUObj _lastVaoEmulationId = 0;
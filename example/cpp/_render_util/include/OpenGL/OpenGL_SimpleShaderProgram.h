@@ -5,6 +5,7 @@
 // OpenGL
 
 #include "OpenGL_Matrix_Camera.h"
+#include "OpenGLStateCache.h"
 
 
 // OpenGL wrapper
@@ -47,9 +48,12 @@ private:
   TResourceMap _transformFeedbackVaryings;
   TResourceMap _fragOutputLocation;
   TResourceMap _unifomLocation;
+  mutable CUniformCache _uniform_cache;
   
 public:
 
+  using TUniformHandle = CUniformCache::TUniformHandle;
+
   ShaderProgramSimple( const std::vector< TShaderInfo > & shaderList )
   {
     Create( shaderList, {}, 0 );
@@ -63,57 +67,81 @@ public:
   virtual ~ShaderProgramSimple() { glDeleteProgram( _prog ); }
   
   GLuint Prog( void ) const { return _prog; }
-  void Use( void ) const { glUseProgram( _prog ); }
-  void Release( void ) const { glUseProgram( 0 ); }
-  
-  void SetUniformI1( const std::string &name, int val ) const
-  { 
+  void Use( void ) const { CStateCache::Current().UseProgram( _prog ); }
+  void Release( void ) const { CStateCache::Current().UseProgram( 0 ); }
+
+  GLint FindUniformLocation( const std::string &name ) const
+  {
     auto it = _unifomLocation.find( name );
-    if ( it != _unifomLocation.end() )
-      glUniform1i( it->second, val );
+    return it != _unifomLocation.end() ? it->second : -1;
+  }
+  
+  // get the handle of a uniform; the location and the shadow value are cached by the handle
+  TUniformHandle UniformHandle( const std::string &name ) const
+  {
+    return _uniform_cache.Handle( FindUniformLocation( name ) );
   }
 
-  void SetUniformF1( const std::string &name, float val ) const
-  { 
-    auto it = _unifomLocation.find( name );
-    if ( it != _unifomLocation.end() )
-      glUniform1f( it->second, val );
+  // get the handle of a uniform by its compile time hashed name
+  TUniformHandle UniformHandle( const TUniformName &name ) const
+  {
+    return _uniform_cache.Handle( name, [this]( const std::string &str ) { return FindUniformLocation( str ); } );
   }
 
-  void SetUniformF2( const std::string &name, const TVec2 &vec ) const
-  { 
-    auto it = _unifomLocation.find( name );
-    if ( it != _unifomLocation.end() )
-      glUniform2fv( it->second, 1, vec.data() );
+  void SetUniformI1( TUniformHandle handle, int val ) const
+  {
+    if ( _uniform_cache.Update( handle, &val, sizeof( val ) ) )
+      glUniform1i( _uniform_cache.Location( handle ), val );
   }
 
-  void SetUniformF3( const std::string &name, const TVec3 &vec ) const
-  { 
-    auto it = _unifomLocation.find( name );
-    if ( it != _unifomLocation.end() )
-      glUniform3fv( it->second, 1, vec.data() );
+  void SetUniformF1( TUniformHandle handle, float val ) const
+  {
+    if ( _uniform_cache.Update( handle, &val, sizeof( val ) ) )
+      glUniform1f( _uniform_cache.Location( handle ), val );
   }
 
-  void SetUniformF4( const std::string &name, const TVec4 &vec ) const
-  { 
-    auto it = _unifomLocation.find( name );
-    if ( it != _unifomLocation.end() )
-      glUniform4fv( it->second, 1, vec.data() );
+  void SetUniformF2( TUniformHandle handle, const TVec2 &vec ) const
+  {
+    if ( _uniform_cache.Update( handle, vec.data(), sizeof( vec ) ) )
+      glUniform2fv( _uniform_cache.Location( handle ), 1, vec.data() );
   }
-  
-  void SetUniformM44( const std::string &name, const float * mat ) const
-  { 
-    auto it = _unifomLocation.find( name );
-    if ( it != _unifomLocation.end() )
-      glUniformMatrix4fv( it->second, 1, GL_FALSE, mat );
+
+  void SetUniformF3( TUniformHandle handle, const TVec3 &vec ) const
+  {
+    if ( _uniform_cache.Update( handle, vec.data(), sizeof( vec ) ) )
+      glUniform3fv( _uniform_cache.Location( handle ), 1, vec.data() );
   }
-  void SetUniformM44( const std::string &name, const TMat44 & mat ) const
-  { 
-    auto it = _unifomLocation.find( name );
-    if ( it != _unifomLocation.end() )
-      glUniformMatrix4fv( it->second, 1, GL_FALSE, mat.data()->data() );
+
+  void SetUniformF4( TUniformHandle handle, const TVec4 &vec ) const
+  {
+    if ( _uniform_cache.Update( handle, vec.data(), sizeof( vec ) ) )
+      glUniform4fv( _uniform_cache.Location( handle ), 1, vec.data() );
+  }
+
+  void SetUniformM44( TUniformHandle handle, const float * mat ) const
+  {
+    if ( _uniform_cache.Update( handle, mat, 16 * sizeof( float ) ) )
+      glUniformMatrix4fv( _uniform_cache.Location( handle ), 1, GL_FALSE, mat );
   }
 
+  void SetUniformM44( TUniformHandle handle, const TMat44 & mat ) const { SetUniformM44( handle, mat.data()->data() ); }
+  
+  void SetUniformI1( const TUniformName &name, int val ) const              { SetUniformI1( UniformHandle( name ), val ); }
+  void SetUniformF1( const TUniformName &name, float val ) const            { SetUniformF1( UniformHandle( name ), val ); }
+  void SetUniformF2( const TUniformName &name, const TVec2 &vec ) const     { SetUniformF2( UniformHandle( name ), vec ); }
+  void SetUniformF3( const TUniformName &name, const TVec3 &vec ) const     { SetUniformF3( UniformHandle( name ), vec ); }
+  void SetUniformF4( const TUniformName &name, const TVec4 &vec ) const     { SetUniformF4( UniformHandle( name ), vec ); }
+  void SetUniformM44( const TUniformName &name, const float * mat ) const   { SetUniformM44( UniformHandle( name ), mat ); }
+  void SetUniformM44( const TUniformName &name, const TMat44 & mat ) const  { SetUniformM44( UniformHandle( name ), mat ); }
+
+  void SetUniformI1( const std::string &name, int val ) const              { SetUniformI1( UniformHandle( name ), val ); }
+  void SetUniformF1( const std::string &name, float val ) const            { SetUniformF1( UniformHandle( name ), val ); }
+  void SetUniformF2( const std::string &name, const TVec2 &vec ) const     { SetUniformF2( UniformHandle( name ), vec ); }
+  void SetUniformF3( const std::string &name, const TVec3 &vec ) const     { SetUniformF3( UniformHandle( name ), vec ); }
+  void SetUniformF4( const std::string &name, const TVec4 &vec ) const     { SetUniformF4( UniformHandle( name ), vec ); }
+  void SetUniformM44( const std::string &name, const float * mat ) const   { SetUniformM44( UniformHandle( name ), mat ); }
+  void SetUniformM44( const std::string &name, const TMat44 & mat ) const  { SetUniformM44( UniformHandle( name ), mat ); }
+
 
   // Create program - compile and link
   void Create( 
@@ -6,6 +6,7 @@
 
 #include "OpenGL_Matrix_Camera.h"
 #include "OpenGLProgram.h"
+#include "OpenGLStateCache.h"
 
 
 // OpenGL wrapper
@@ -57,9 +58,12 @@ private:
   TShaderList       _shaders;
   TProgramPtr       _program;
   TIntrospectionPtr _introspection;
+  mutable CUniformCache _uniform_cache;
   
 public:
 
+  using TUniformHandle = CUniformCache::TUniformHandle;
+
   ShaderProgram( const std::vector< TShaderInfo > & shaderList )
   {
     Create( shaderList, {}, 0 );
@@ -74,7 +78,7 @@ public:
   
   GLuint Prog( void ) const { return _program != nullptr ? (GLuint)_program->ObjectHandle() : 0; }
   void Use( void ) const { if ( _program != nullptr ) _program->Use(); }
-  void Release( void ) const { glUseProgram( 0 ); }
+  void Release( void ) const { CStateCache::Current().UseProgram( 0 ); }
 
   int FindUniformLocation( const std::string &name ) const
   {
@@ -91,54 +95,72 @@ public:
     return (int)handle;
   }
   
-  void SetUniformI1( const std::string &name, int val ) const
-  { 
-    int location = FindUniformLocation( name );
-    if ( location >= 0 )
-      glUniform1i( location, val );
+  // get the handle of a uniform; the location and the shadow value are cached by the handle
+  TUniformHandle UniformHandle( const std::string &name ) const
+  {
+    return _uniform_cache.Handle( (GLint)FindUniformLocation( name ) );
   }
 
-  void SetUniformF1( const std::string &name, float val ) const
-  { 
-    int location = FindUniformLocation( name );
-    if ( location >= 0 )
-      glUniform1f( location, val );
+  // get the handle of a uniform by its compile time hashed name
+  TUniformHandle UniformHandle( const TUniformName &name ) const
+  {
+    return _uniform_cache.Handle( name, [this]( const std::string &str ) { return FindUniformLocation( str ); } );
   }
 
-  void SetUniformF2( const std::string &name, const TVec2 &vec ) const
-  { 
-    int location = FindUniformLocation( name );
-    if ( location >= 0 )
-      glUniform2fv( location, 1, vec.data() );
+  void SetUniformI1( TUniformHandle handle, int val ) const
+  {
+    if ( _uniform_cache.Update( handle, &val, sizeof( val ) ) )
+      glUniform1i( _uniform_cache.Location( handle ), val );
   }
 
-  void SetUniformF3( const std::string &name, const TVec3 &vec ) const
-  { 
-    int location = FindUniformLocation( name );
-    if ( location >= 0 )
-      glUniform3fv( location, 1, vec.data() );
+  void SetUniformF1( TUniformHandle handle, float val ) const
+  {
+    if ( _uniform_cache.Update( handle, &val, sizeof( val ) ) )
+      glUniform1f( _uniform_cache.Location( handle ), val );
   }
 
-  void SetUniformF4( const std::string &name, const TVec4 &vec ) const
-  { 
-    int location = FindUniformLocation( name );
-    if ( location >= 0 )
-      glUniform4fv( location, 1, vec.data() );
+  void SetUniformF2( TUniformHandle handle, const TVec2 &vec ) const
+  {
+    if ( _uniform_cache.Update( handle, vec.data(), sizeof( vec ) ) )
+      glUniform2fv( _uniform_cache.Location( handle ), 1, vec.data() );
   }
-  
-  void SetUniformM44( const std::string &name, const float * mat ) const
-  { 
-    int location = FindUniformLocation( name );
-    if ( location >= 0 )
-      glUniformMatrix4fv( location, 1, GL_FALSE, mat );
+
+  void SetUniformF3( TUniformHandle handle, const TVec3 &vec ) const
+  {
+    if ( _uniform_cache.Update( handle, vec.data(), sizeof( vec ) ) )
+      glUniform3fv( _uniform_cache.Location( handle ), 1, vec.data() );
+  }
+
+  void SetUniformF4( TUniformHandle handle, const TVec4 &vec ) const
+  {
+    if ( _uniform_cache.Update( handle, vec.data(), sizeof( vec ) ) )
+      glUniform4fv( _uniform_cache.Location( handle ), 1, vec.data() );
   }
-  void SetUniformM44( const std::string &name, const TMat44 & mat ) const
-  { 
-    int location = FindUniformLocation( name );
-    if ( location >= 0 )
-      glUniformMatrix4fv( location, 1, GL_FALSE, mat.data()->data() );
+
+  void SetUniformM44( TUniformHandle handle, const float * mat ) const
+  {
+    if ( _uniform_cache.Update( handle, mat, 16 * sizeof( float ) ) )
+      glUniformMatrix4fv( _uniform_cache.Location( handle ), 1, GL_FALSE, mat );
   }
 
+  void SetUniformM44( TUniformHandle handle, const TMat44 & mat ) const { SetUniformM44( handle, mat.data()->data() ); }
+  
+  void SetUniformI1( const TUniformName &name, int val ) const              { SetUniformI1( UniformHandle( name ), val ); }
+  void SetUniformF1( const TUniformName &name, float val ) const            { SetUniformF1( UniformHandle( name ), val ); }
+  void SetUniformF2( const TUniformName &name, const TVec2 &vec ) const     { SetUniformF2( UniformHandle( name ), vec ); }
+  void SetUniformF3( const TUniformName &name, const TVec3 &vec ) const     { SetUniformF3( UniformHandle( name ), vec ); }
+  void SetUniformF4( const TUniformName &name, const TVec4 &vec ) const     { SetUniformF4( UniformHandle( name ), vec ); }
+  void SetUniformM44( const TUniformName &name, const float * mat ) const   { SetUniformM44( UniformHandle( name ), mat ); }
+  void SetUniformM44( const TUniformName &name, const TMat44 & mat ) const  { SetUniformM44( UniformHandle( name ), mat ); }
+
+  void SetUniformI1( const std::string &name, int val ) const              { SetUniformI1( UniformHandle( name ), val ); }
+  void SetUniformF1( const std::string &name, float val ) const            { SetUniformF1( UniformHandle( name ), val ); }
+  void SetUniformF2( const std::string &name, const TVec2 &vec ) const     { SetUniformF2( UniformHandle( name ), vec ); }
+  void SetUniformF3( const std::string &name, const TVec3 &vec ) const     { SetUniformF3( UniformHandle( name ), vec ); }
+  void SetUniformF4( const std::string &name, const TVec4 &vec ) const     { SetUniformF4( UniformHandle( name ), vec ); }
+  void SetUniformM44( const std::string &name, const float * mat ) const   { SetUniformM44( UniformHandle( name ), mat ); }
+  void SetUniformM44( const std::string &name, const TMat44 & mat ) const  { SetUniformM44( UniformHandle( name ), mat ); }
+
 
   // Create program - compile and link
   void Create( 
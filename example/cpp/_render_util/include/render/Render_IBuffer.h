@@ -48,6 +48,7 @@ enum class TDrawBufferUsage
   static_draw,  //!< set up data once and draw repeatedly
   dynamic_draw, //!< change the data sometimes
   stream_draw,  //!< set up data and draw once
+  stream_ring,  //!< set up data and draw once; the data is streamed to a persistently mapped ring buffer, the draw operations take the base vertex of the last update into account
 };
 
 
@@ -276,6 +277,7 @@ public:
   virtual void SpecifyVA( size_t description_size, const char *description ) = 0;
   virtual bool UpdateVB( size_t id, size_t element_size, size_t no_of_elements, const void *data ) = 0;
   virtual bool UpdateIB( size_t id, size_t element_size, size_t no_of_elements, const void *data ) = 0;
+  virtual size_t BaseVertex( size_t id ) const = 0;
 
   virtual void DrawAllElements( TPrimitive primitive_type, bool bind ) = 0;
   virtual void DrawElements( TPrimitive primitive_type, size_t start, size_t count, bool bind ) = 0;
@@ -285,6 +287,7 @@ public:
   virtual void DrawElementsBase( TPrimitive primitive_type, size_t element_size, size_t no_of_elements, const void *data, size_t base_index, bool bind ) = 0;
   virtual void DrawRangeElements( TPrimitive primitive_type, unsigned int minInx, unsigned int maxInx, bool bind ) = 0;
   virtual void DrawArray( TPrimitive primitive_type, size_t first, size_t count, bool bind  ) = 0;
+  virtual void MultiDrawArray( TPrimitive primitive_type, size_t list_size, const int *first, const int *count, bool bind ) = 0;
 
   virtual void Prepare( void ) = 0;
   virtual void Release( void ) = 0;
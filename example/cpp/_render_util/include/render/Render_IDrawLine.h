@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <memory>
+#include <span>
 
 
 /******************************************************************//**
@@ -70,6 +71,22 @@ public:
 // Style
 //---------------------------------------------------------------------
 
+//! join of successive segments of a thick line
+enum class TJoin
+{
+  miter, //!< the outer edges are extended to their intersection; beyond the miter limit a bevel join is used
+  bevel, //!< the outer corners are connected by a straight edge
+  round, //!< circular join
+};
+
+//! cap at the ends of an open thick line
+enum class TCap
+{
+  butt,   //!< the line ends at the end point
+  square, //!< the line is extended by half its width
+  round,  //!< half circle around the end point
+};
+
 struct TStyle
 {
   TStyle( void ) = default;
@@ -90,9 +107,12 @@ struct TStyle
     , _depth_attenuation( depth_attenuation )
   {}
 
-  t_fp _width             = 1.0f; //!< line width
-  int  _stipple_type      = 1;    //!< type of line stippling
-  t_fp _depth_attenuation = 0.0f; //!< attenuation of the line color by depth
+  t_fp  _width             = 1.0f;         //!< line width
+  int   _stipple_type      = 1;            //!< type of line stippling
+  t_fp  _depth_attenuation = 0.0f;         //!< attenuation of the line color by depth
+  TJoin _join              = TJoin::miter; //!< join of successive segments (thick lines only)
+  TCap  _cap               = TCap::butt;   //!< cap at the ends of open lines (thick lines only)
+  t_fp  _miter_limit       = 4.0f;         //!< maximum ratio of the miter length and the half line width
 };
 
 enum class TArrowStyleProperty
@@ -195,6 +215,10 @@ public:
   
   //! Specify a sequence of new vertex coordinates in an active line sequence
   virtual bool DrawSequence( size_t coords_size, const double *coords ) = 0;
+
+  //! Append `coords_size` elements to an active line sequence and return them, so that the vertex coordinates can be written in place.
+  //! The elements have to be written before the next call to the renderer. The span is empty if no sequence is active.
+  virtual std::span<float> MapSequence( size_t coords_size ) = 0;
 };
 
 
@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <memory>
+#include <span>
 
 
 /******************************************************************//**
@@ -165,6 +166,10 @@ public:
   
   //! Specify a sequence of new vertex coordinates in an active polygon sequence
   virtual bool DrawSequence( size_t coords_size, const double *coords ) = 0;
+
+  //! Append `coords_size` elements to an active polygon sequence and return them, so that the vertex coordinates can be written in place.
+  //! The elements have to be written before the next call to the renderer. The span is empty if no sequence is active.
+  virtual std::span<float> MapSequence( size_t coords_size ) = 0;
 };
 
 
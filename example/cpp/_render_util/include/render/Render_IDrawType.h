@@ -23,6 +23,21 @@
 #include <algorithm>
 #include <memory>
 #include <cstring>
+#include <span>
+
+
+// SIMD
+
+#if defined(__AVX__)
+#define RENDER_DRAWTYPE_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDER_DRAWTYPE_SSE2
+#endif
+
+#if defined(RENDER_DRAWTYPE_AVX) || defined(RENDER_DRAWTYPE_SSE2)
+#include <immintrin.h>
+#endif
 
 
 //---------------------------------------------------------------------
@@ -516,6 +531,53 @@ inline TBasePrimitive BasePrimitive( TPrimitive primitive )
 }
 
 
+//---------------------------------------------------------------------
+// ConvertToFloat
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Convert double precision coordinates to single precision.
+*
+* 8 (AVX) or 4 (SSE2) coordinates are converted at once. The rounding
+* is the same as of a scalar cast, so the result is bit exact on each
+* instruction set.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+inline void ConvertToFloat(
+  size_t        count,  //!< I - number of values
+  const double *source, //!< I - source values
+  t_fp         *dest )  //!< O - destination values
+{
+  size_t i = 0;
+
+#if defined(RENDER_DRAWTYPE_AVX)
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m128 lo = _mm256_cvtpd_ps( _mm256_loadu_pd( source + i ) );
+    __m128 hi = _mm256_cvtpd_ps( _mm256_loadu_pd( source + i + 4 ) );
+    _mm_storeu_ps( dest + i,     lo );
+    _mm_storeu_ps( dest + i + 4, hi );
+  }
+#endif
+
+#if defined(RENDER_DRAWTYPE_SSE2)
+  for ( ; i + 4 <= count; i += 4 )
+  {
+    __m128 lo = _mm_cvtpd_ps( _mm_loadu_pd( source + i ) );
+    __m128 hi = _mm_cvtpd_ps( _mm_loadu_pd( source + i + 2 ) );
+    _mm_storeu_ps( dest + i, _mm_movelh_ps( lo, hi ) );
+  }
+#endif
+
+  for ( ; i < count; ++ i )
+    dest[i] = (t_fp)source[i];
+}
+
+
 //---------------------------------------------------------------------
 // VertexCache
 //---------------------------------------------------------------------
@@ -523,6 +585,10 @@ inline TBasePrimitive BasePrimitive( TPrimitive primitive )
 
 /******************************************************************//**
 * \brief Simple cache for vertices.  
+*
+* `Map` appends uninitialized elements to the sequence and returns
+* them, so that the caller can write the coordinates in place.
+* The cache grows geometrically. 
 * 
 * \author  gernot
 * \date    2018-12-04
@@ -564,66 +630,54 @@ public:
   unsigned int TupleSize( void )    const { return _tuple_size; }
   size_t       SequenceSize( void ) const { return _sequence_size; }
   const t_fp * VertexData( void )   const { return _cache.data(); }
+
+  //! reserve the cache for at least `elems` elements
+  TVertexCache & Reserve( size_t elems )
+  {
+    if ( _cache.size() < elems )
+      _cache.resize( std::max( { elems, _cache.size() * 2, _min_cache_elems } ) );
+    return *this;
+  }
+
+  //! append `coords_size` elements to the sequence, the elements have to be written by the caller
+  std::span<t_fp> Map( size_t coords_size )
+  {
+    Reserve( _sequence_size + coords_size );
+    std::span<t_fp> elems( _cache.data() + _sequence_size, coords_size );
+    _sequence_size += coords_size;
+    return elems;
+  }
  
   TVertexCache & Add( t_fp x, t_fp y, t_fp z )
   {
-    // reserve the cache
-    if ( _cache.size() < _sequence_size + _tuple_size )
-      _cache.resize( _cache.size() + std::max((size_t)_tuple_size, _min_cache_elems) );
-
     // add the vertex coordinate to the cache
-    _cache.data()[_sequence_size++] = x;
-    _cache.data()[_sequence_size++] = y;
+    t_fp *ptr = Map( _tuple_size ).data();
+    ptr[0] = x;
+    ptr[1] = y;
     if ( _tuple_size >= 3 )
-      _cache.data()[_sequence_size++] = z;
+      ptr[2] = z;
     if ( _tuple_size == 4 )
-      _cache.data()[_sequence_size++] = 1.0f;
+      ptr[3] = 1.0f;
 
     return *this;
   }
   
   TVertexCache & Add( double x, double y, double z )
   {
-    // reserve the cache
-    if ( _cache.size() < _sequence_size + _tuple_size )
-      _cache.resize( _cache.size() + std::max((size_t)_tuple_size, _min_cache_elems) );
-
-    // add the vertex coordinate to the cache
-    _cache.data()[_sequence_size++] = (t_fp)x;
-    _cache.data()[_sequence_size++] = (t_fp)y;
-    if ( _tuple_size >= 3 )
-      _cache.data()[_sequence_size++] = (t_fp)z;
-    if ( _tuple_size == 4 )
-      _cache.data()[_sequence_size++] = 1.0f;
-
-    return *this;
+    return Add( (t_fp)x, (t_fp)y, (t_fp)z );
   }
   
   TVertexCache & Add( size_t coords_size, const t_fp *coords )
   {
-    // reserve the cache
-    if ( _cache.size() < _sequence_size + coords_size )
-      _cache.resize( _cache.size() + std::max(coords_size, _min_cache_elems) );
-
     // add the vertex coordinates to the cache
-    std::memcpy( _cache.data() + _sequence_size, coords, coords_size * sizeof( t_fp ) );
-    _sequence_size += coords_size;
-
+    std::memcpy( Map( coords_size ).data(), coords, coords_size * sizeof( t_fp ) );
     return *this;
   }
 
   TVertexCache & Add( size_t coords_size, const double *coords )
   {
-    // reserve the cache
-    if ( _cache.size() < _sequence_size + coords_size )
-      _cache.resize( _cache.size() + std::max(coords_size, _min_cache_elems) );
-
     // add the vertex coordinate to the cache
-    t_fp *cache_ptr = _cache.data() + _sequence_size;
-    for ( const double *ptr = coords, *end_ptr = coords + coords_size; ptr < end_ptr; ptr ++, cache_ptr ++ )
-      *cache_ptr = (t_fp)(*ptr);
-    _sequence_size += coords_size;
-
+    ConvertToFloat( coords_size, coords, Map( coords_size ).data() );
     return *this;
   }
 
@@ -14,6 +14,11 @@
 
 #include "Render_IDrawType.h"
 
+// STL
+
+#include <cstdint>
+#include <vector>
+
 
 /******************************************************************//**
 * @brief   Namespace for renderer.
@@ -26,10 +31,80 @@ namespace Render
 {
 
 
+class ITexture;
 class ITextureLoader;
 class IDrawBufferProvider;
 
 
+/******************************************************************//**
+* @brief   Kind of the glyph images of a font.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+enum class TGlyphImageType : t_byte
+{
+  bitmap, //!< coverage bitmap (premultiplied alpha); bound to the size of the rasterization
+  sdf,    //!< signed distance field in all channels
+  msdf,   //!< multi-channel signed distance field in the RGB channels and the true signed distance in the alpha channel
+};
+
+
+/******************************************************************//**
+* @brief   Glyph image properties of a font.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+struct TGlyphImage
+{
+  TGlyphImageType _type{ TGlyphImageType::bitmap }; //!< kind of the glyph images
+  float           _distance_range{ 0.0f };         //!< distance in texels, which is encoded from the edge to the minimum and maximum value of a distance field
+};
+
+
+/******************************************************************//**
+* @brief   Effects for text, which is drawn with a distance field font.
+*
+* The widths are relative to the distance range of the glyph images.
+* An outline or glow is evaluated in the shader, so it doesn't need
+* an additional rasterization of the glyphs.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+struct TTextEffect
+{
+  float  _outline_width{ 0.0f };                  //!< width of the outline; 0: no outline
+  TColor _outline_color{ 0.0f, 0.0f, 0.0f, 1.0f }; //!< color of the outline
+  float  _glow_width{ 0.0f };                     //!< width of the glow; 0: no glow
+  TColor _glow_color{ 1.0f, 1.0f, 1.0f, 0.5f };    //!< color of the glow
+};
+
+
+/******************************************************************//**
+* @brief   Glyph quads of a text, relative to the reference position.
+*
+* The quads are triangles with the vertex attributes x, y, z, u, v
+* (`TVA::b0_xyz_uv`) and they are grouped by the textures of the glyph
+* pages.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+struct TTextLayout
+{
+  std::vector<float>      _vertices;   //!< x y z u v
+  std::vector<size_t>     _page_start; //!< first vertex of each page and the total number of vertices at the end
+  std::vector<ITexture*>  _textures;   //!< texture of each page
+  std::uint64_t           _revision{ 0 }; //!< revision of the font glyphs, when the layout was created
+};
+
+
 //---------------------------------------------------------------------
 // IFont
 //---------------------------------------------------------------------
@@ -56,6 +131,15 @@ public:
 
   //! render a texture based text
   virtual bool Draw( IDrawBufferProvider &buffer_provider, size_t textur_binding_id, t_s_param str, float height, float width_scale, const Render::TPoint3 &pos ) = 0; 
+
+  //! kind of the glyph images, which are bound to the texture unit, when the text is drawn
+  virtual TGlyphImage GlyphImage( void ) const { return TGlyphImage(); }
+
+  //! create the glyph quads of a text for retained drawing; false if the font doesn't support layouts
+  virtual bool Layout( t_s_param /*str*/, float /*height*/, float /*width_scale*/, TTextLayout &/*layout*/ ) { return false; }
+
+  //! revision of the glyphs; a layout with a different revision refers to invalid glyph images
+  virtual std::uint64_t LayoutRevision( void ) const { return 0; }
 };
 
 
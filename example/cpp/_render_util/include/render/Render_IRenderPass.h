@@ -160,6 +160,7 @@ struct TBuffer
     e_linear,  //!< linear filter
     e_extern,  //!< extern texture
     e_cubemap, //!< the extern target texture is a cubmap or a side of a cubemap
+    e_keep,    //!< the content of the buffer is required after the frame (the buffer is never aliased or invalidated)
     //...
     e_NO_OF  //!< number of buffer properties
   };
@@ -442,6 +443,7 @@ public:
   virtual bool  SetDrawBuffers( bool firstColorAttachmentOnly ) = 0;       //!< activates the draw buffers
   virtual bool  ReleasePass( size_t passID ) = 0;                          //!< release the render pass
   virtual bool  Release( void ) = 0;                                       //!< release the current render pass
+  virtual bool  Discard( size_t passID ) = 0;                              //!< discard the content of the buffers, which are not required after the pass
   virtual bool  GetBufferObject( size_t bufferID, unsigned int &obj ) = 0; //!< get the implementation object for a buffer
   virtual bool  GetPassObject( size_t passID, unsigned int &obj ) = 0;     //!< get the implementation object for a pass
  
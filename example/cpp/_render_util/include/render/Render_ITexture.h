@@ -15,6 +15,7 @@
 #include "Render_IDrawType.h"
 
 #include <memory>
+#include <vector>
 
 
 /******************************************************************//**
@@ -130,9 +131,91 @@ enum class TImageFormat
   BGR8,    //!< 3 color channels; 1 byte (unsigned)
   RGBA8,   //!< 3 color channels and 1 alpha channel; 1 byte (unsigned) 
   BGRA8,   //!< 3 color channels and 1 alpha channel; 1 byte (unsigned) 
+  BC1_RGB,  //!< compressed 4x4 blocks; 8 bytes per block; 3 color channels (DXT1)
+  BC1_RGBA, //!< compressed 4x4 blocks; 8 bytes per block; 3 color channels and 1 bit alpha (DXT1)
+  BC3,      //!< compressed 4x4 blocks; 16 bytes per block; 3 color channels and 1 alpha channel (DXT5)
+  BC4,      //!< compressed 4x4 blocks; 8 bytes per block; 1 color channel (RGTC1)
+  BC5,      //!< compressed 4x4 blocks; 16 bytes per block; 2 color channels (RGTC2)
+  BC7,      //!< compressed 4x4 blocks; 16 bytes per block; 3 color channels and 1 alpha channel (BPTC)
 };
 
 
+/******************************************************************//**
+* \brief   Number of bytes of a compressed 4x4 block of texels.
+*
+* \return  0 for uncompressed image formats
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+inline size_t CompressedBlockSize( TImageFormat format )
+{
+  switch ( format )
+  {
+    case TImageFormat::BC1_RGB:
+    case TImageFormat::BC1_RGBA:
+    case TImageFormat::BC4: return 8;
+    case TImageFormat::BC3:
+    case TImageFormat::BC5:
+    case TImageFormat::BC7: return 16;
+    default: break;
+  }
+  return 0;
+}
+
+
+/******************************************************************//**
+* \brief   Number of bytes of a compressed image with a size of
+* `cx` x `cy` texels.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+inline size_t CompressedImageSize( TImageFormat format, size_t cx, size_t cy )
+{
+  return ((cx + 3) / 4) * ((cy + 3) / 4) * CompressedBlockSize( format );
+}
+
+
+/******************************************************************//**
+* \brief   Number of bytes of an uncompressed texel.
+*
+* \return  0 for compressed and unknown image formats
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+inline size_t ImageTexelSize( TImageFormat format )
+{
+  switch ( format )
+  {
+    case TImageFormat::GRAY8: return 1;
+    case TImageFormat::RGB8:
+    case TImageFormat::BGR8:  return 3;
+    case TImageFormat::RGBA8:
+    case TImageFormat::BGRA8: return 4;
+    default: break;
+  }
+  return 0;
+}
+
+
+/******************************************************************//**
+* \brief   Number of bytes of a tightly packed 2 dimensional image.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+inline size_t ImageDataSize( TImageFormat format, size_t cx, size_t cy )
+{
+  return CompressedBlockSize( format ) > 0 ? CompressedImageSize( format, cx, cy ) : cx * cy * ImageTexelSize( format );
+}
+
+
 /******************************************************************//**
 * \brief   Standard texture formats
 * 
@@ -148,6 +231,12 @@ enum class TTextureFormat
   RGBA8,       //!< 3 color channels and 1 alpha channel; 1 byte;  [0.0, 1.0] 
   RGB8_SNORM,  //!< 3 color channels; 1 byte  [-0.0, 1.0]
   RGB16_SNORM, //!< 3 color channels; 1 byte  [-0.0, 1.0]
+  BC1_RGB,     //!< compressed; 3 color channels; 4 bits per texel
+  BC1_RGBA,    //!< compressed; 3 color channels and 1 bit alpha; 4 bits per texel
+  BC3_RGBA,    //!< compressed; 3 color channels and 1 alpha channel; 8 bits per texel
+  BC4_R,       //!< compressed; 1 color channel; 4 bits per texel
+  BC5_RG,      //!< compressed; 2 color channels; 8 bits per texel
+  BC7_RGBA,    //!< compressed; 3 color channels and 1 alpha channel; 8 bits per texel
 };
 
 
@@ -291,7 +380,30 @@ struct TTextureParameters
   bool Is2DType( void ) const { return _type == TTextureType::T2D || _type == TTextureType::T2D_ARRAY || _type == TTextureType::TCUBE; }
   bool Is3DType( void ) const { return _type == TTextureType::T3D; }
 
-  bool HasAlphaChannel( void ) const { return _format == TTextureFormat::RGBA8; }
+  bool HasAlphaChannel( void ) const
+  {
+    return _format == TTextureFormat::RGBA8 || _format == TTextureFormat::BC1_RGBA ||
+           _format == TTextureFormat::BC3_RGBA || _format == TTextureFormat::BC7_RGBA;
+  }
+
+  //! the texture is block compressed; the texture image can't be generated by `glGenerateMipmap`
+  bool IsCompressed( void ) const { return CompressedImageFormat() != TImageFormat::UNKNOWN; }
+
+  //! image format of the compressed texture blocks
+  TImageFormat CompressedImageFormat( void ) const
+  {
+    switch ( _format )
+    {
+      case TTextureFormat::BC1_RGB:  return TImageFormat::BC1_RGB;
+      case TTextureFormat::BC1_RGBA: return TImageFormat::BC1_RGBA;
+      case TTextureFormat::BC3_RGBA: return TImageFormat::BC3;
+      case TTextureFormat::BC4_R:    return TImageFormat::BC4;
+      case TTextureFormat::BC5_RG:   return TImageFormat::BC5;
+      case TTextureFormat::BC7_RGBA: return TImageFormat::BC7;
+      default: break;
+    }
+    return TImageFormat::UNKNOWN;
+  }
 };
 
 
@@ -410,8 +522,23 @@ public:
   //! create a new texture from an image resource
   virtual ITexturePtr CreateTexture( const IImageResource &image, TImageTransformations transform, const TTextureSize &size, size_t layers, const TTextureParameters &param ) = 0;
 
+  //! create a new texture from a complete chain of mipmap levels, starting at level 0
+  virtual ITexturePtr CreateTexture( const std::vector<const IImageResource*> &mipmaps, const TTextureParameters &param ) = 0;
+
+  //! allocate the mipmap levels 1 to `levels`-1 of a texture, which has been created with the size of level 0
+  virtual bool AllocateLevels( ITexture &texture, const TTextureParameters &param, const TTextureSize &size, size_t levels ) = 0;
+
+  //! restrict the accessible mipmap levels of a texture (e.g. while the finer levels are streamed)
+  virtual bool SetLevelRange( ITexture &texture, size_t base_level, size_t max_level ) = 0;
+
   //! load image data to texture
-  virtual bool LoadToTexture( const IImageResource &image, ITexture &texture, const TTexturePoint &pos, size_t layer ) = 0;
+  bool LoadToTexture( const IImageResource &image, ITexture &texture, const TTexturePoint &pos, size_t layer )
+  {
+    return LoadToTexture( image, texture, pos, layer, 0 );
+  }
+
+  //! load image data to a mipmap level of a texture
+  virtual bool LoadToTexture( const IImageResource &image, ITexture &texture, const TTexturePoint &pos, size_t layer, size_t level ) = 0;
 
 
   static const TTextureParameters & Parameters( TStandardTextureKind id )
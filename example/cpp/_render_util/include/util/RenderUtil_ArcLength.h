@@ -0,0 +1,51 @@
+/******************************************************************//**
+* \brief   Arc length of the vertices of polylines.
+*
+* The vertices of all the polylines are stored consecutively in one
+* array of (x, y, z, w) tuples. On input `w` marks the first vertex of
+* each polyline (`w == 0`); all the other vertices have `w != 0`.
+* On output `w` is the length along the polyline from its first vertex
+* (prefix sum of the segment lengths, segmented by polylines).
+*
+* This is the CPU reference of the compute shader prefix sum in
+* `OpenGL::Line::CArcLengthPrefixSum`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_ArcLength_h_INCLUDED
+#define RenderUtil_ArcLength_h_INCLUDED
+
+
+// STL
+
+#include <cstddef>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//! marker of the first vertex of a polyline in the `w` component
+constexpr float c_arc_length_polyline_start = 0.0f;
+
+//! marker of the other vertices of a polyline in the `w` component
+constexpr float c_arc_length_polyline_vertex = 1.0f;
+
+
+//! compute the arc length of the vertices in place; the sums are accumulated in double precision
+void ArcLengthPrefixSum( size_t no_of_vertices, float *vertices );
+
+
+} // Render
+
+#endif // RenderUtil_ArcLength_h_INCLUDED
@@ -0,0 +1,150 @@
+/******************************************************************//**
+* \brief   CPU block compression encoder (BC1, BC3, BC4, BC5, BC7).
+*
+* The encoder compresses an 8 bit image resource to 4x4 texel blocks,
+* which can be loaded to a texture with a compressed
+* `Render::TTextureFormat`, without any further processing by the GPU.
+* The blocks of the image are distributed to the worker threads.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_BlockCompression_h_INCLUDED
+#define RenderUtil_BlockCompression_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_ITexture.h"
+
+// STL
+
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//---------------------------------------------------------------------
+// CBlockCompressor
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Quality of the block compression.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+enum class TBlockCompressionQuality : t_byte
+{
+  fast,   //!< end points from the bounding box of the block
+  normal, //!< end points from the principal axis of the block, 1 least squares refinement
+  high,   //!< like `normal`, but with additional refinement iterations and exhaustive mode and p-bit search
+};
+
+
+/******************************************************************//**
+* \brief Parameters of the block compression.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TBlockCompressionParameters
+{
+  TImageFormat             _format{ TImageFormat::BC1_RGB };            //!< compressed target format
+  TBlockCompressionQuality _quality{ TBlockCompressionQuality::normal }; //!< quality of the end point selection
+  size_t                   _threads{ 0 };                                //!< number of worker threads; 0: default concurrency
+};
+
+
+/******************************************************************//**
+* \brief Image resource of compressed 4x4 blocks.
+*
+* A line of the image resource is one row of blocks.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CCompressedImage
+  : public IImageResource
+{
+public:
+
+  CCompressedImage( void ) = default;
+  CCompressedImage( TImageKind kind, TImageFormat format, size_t cx, size_t cy );
+
+  virtual TImageKind   Kind( void )      const override { return _kind; }
+  virtual TTextureType Type( void )      const override { return TTextureType::T2D; }
+  virtual TImageFormat Format( void )    const override { return _format; }
+  virtual TTextureSize Size( void )      const override { return { _cx, _cy, 1 }; }
+  virtual size_t       Layers( void )    const override { return 1; }
+  virtual size_t       BPL( void )       const override { return ((_cx + 3) / 4) * CompressedBlockSize( _format ); }
+  virtual size_t       LineAlign( void ) const override { return 1; }
+  virtual const void * DataPtr( void )   const override { return _data.data(); }
+
+  std::vector<t_byte>       & Data( void )       { return _data; }
+  const std::vector<t_byte> & Data( void ) const { return _data; }
+
+private:
+
+  TImageKind          _kind{ TImageKind::diffuse };
+  TImageFormat        _format{ TImageFormat::BC1_RGB };
+  size_t              _cx{ 0 };
+  size_t              _cy{ 0 };
+  std::vector<t_byte> _data;
+};
+
+
+/******************************************************************//**
+* \brief CPU block compression encoder and reference decoder.
+*
+* The color distance evaluation of the index selection is vectorized
+* with SSE2 (4 texels of a block at once).
+* The BC7 encoder writes mode 6 blocks (single subset, RGBA end points
+* with p-bits, 4 bit indices) and the decoder only supports mode 6.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CBlockCompressor
+{
+public:
+
+  CBlockCompressor( void ) = default;
+  CBlockCompressor( const TBlockCompressionParameters &parameters );
+
+  const TBlockCompressionParameters & Parameters( void ) const { return _parameters; }
+
+  //! compress an 8 bit 2 dimensional image
+  bool Compress( const IImageResource &image, CCompressedImage &compressed ) const;
+
+  //! decompress a compressed image to RGBA8 texels
+  static bool Decompress( const IImageResource &compressed, std::vector<t_byte> &rgba, size_t no_of_threads = 0 );
+
+  //! peak signal to noise ratio of the decompressed RGBA8 texels, for the channels which are stored by the compressed format
+  static double PSNR( const IImageResource &reference, const std::vector<t_byte> &rgba, TImageFormat compressed_format );
+
+private:
+
+  TBlockCompressionParameters _parameters;
+};
+
+
+} // Render
+
+#endif // RenderUtil_BlockCompression_h_INCLUDED
@@ -0,0 +1,209 @@
+/******************************************************************//**
+* \brief   Clustered light assignment.
+*
+* The view frustum is divided into a 3 dimensional grid of clusters
+* (froxels). The influence range of each light source is computed by
+* its attenuation (`Render_ILight.h`) and the lights are binned to the
+* clusters on the CPU. The result is a compact list of light indices
+* per cluster, in a layout which is uploaded to shader storage buffers
+* as it is. No rendering context is required.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_ClusteredLights_h_INCLUDED
+#define RenderUtil_ClusteredLights_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_IDrawType.h"
+#include "../render/Render_ILight.h"
+#include "RenderUtil_SceneBVH.h"
+
+
+// STL
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+/******************************************************************//**
+* \brief   Clustered (froxel) light assignment.
+*
+* The clusters are the tiles of the viewport (`x`, `y`) times slices of
+* the view space depth (`z`). The depth slices are exponential:
+* slice `k` starts at `near * (far/near)^(k/z)`, so the clusters are
+* roughly cubic. The view space bounding box of each cluster is
+* computed from the projection matrix.
+*
+* `Assign` transforms the lights to view space and computes their
+* bounding volumes:
+*
+*  - a point light is bounded by a sphere with its influence radius
+*  - a spot light is bounded by the smallest sphere around its cone,
+*    and the cone is tested against the bounding spheres of the
+*    clusters in addition
+*  - directional lights and lights without a finite influence radius
+*    are global lights, which affect each cluster.
+*
+* The lights are binned to the depth slices; the slices are processed
+* in parallel. A light is only tested against the clusters of its
+* conservative screen rectangle and depth range. The sphere-box test
+* (and the cone test) is done for 8 (AVX2) or 4 (SSE2) clusters of a
+* row at once. The result does not depend on the number of threads;
+* the light indices of a cluster are in ascending order.
+*
+* The output buffers match the `std430` and `std140` layouts of the
+* following GLSL declarations:
+*
+*     layout(std140) uniform TClusterGrid
+*     {
+*       uvec4 u_size;  // number of clusters in x, y, z; number of global lights
+*       vec4  u_depth; // near, far, scale and bias of the depth slices
+*     };
+*     struct TClusterLight { vec4 position; vec4 direction; vec4 color; vec4 attenuation; };
+*     layout(std430) readonly buffer TClusterLights { TClusterLight lights[]; };
+*     layout(std430) readonly buffer TClusters      { uvec2 clusters[]; }; // offset and count
+*     layout(std430) readonly buffer TLightIndices  { uint  light_indices[]; };
+*
+*     uvec3 c = uvec3( uvec2( gl_FragCoord.xy / viewport_size * vec2( u_size.xy ) ),
+*                      uint( clamp( log( -view_pos.z ) * u_depth.z + u_depth.w, 0.0, float( u_size.z - 1u ) ) ) );
+*     uvec2 cluster = clusters[ (c.z * u_size.y + c.y) * u_size.x + c.x ];
+*     for ( uint i = 0; i < u_size.w; ++ i )          // global lights
+*       ... lights[ light_indices[i] ] ...
+*     for ( uint i = 0; i < cluster.y; ++ i )         // lights of the cluster
+*       ... lights[ light_indices[cluster.x + i] ] ...
+*
+* The light indices are the indices in the light table; the lights
+* buffer has an entry for each light of the table.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CClusteredLights
+{
+public:
+
+  static constexpr float c_infinite_radius = 1.0e30f; //!< influence radius of lights without a finite range
+
+  //! light in view space, `std430` (and `std140`) layout
+  struct TLight_std430
+  {
+    TVec4 _position;    //!< view space position and influence radius (0: directional light, `xyz` is the direction to the light)
+    TVec4 _direction;   //!< view space direction of a spot light and cosine of the outer half cone angle (-1: point light)
+    TVec4 _color;       //!< diffuse color multiplied by the brightness, and cosine of the inner half cone angle
+    TVec4 _attenuation; //!< constant, linear and quadratic attenuation and radius cut off weight
+  };
+
+  //! range of the light indices of a cluster, `std430` layout (`uvec2`)
+  struct TCluster_std430
+  {
+    std::uint32_t _offset; //!< index of the first light index
+    std::uint32_t _count;  //!< number of lights
+  };
+
+  //! grid parameters, `std140` layout
+  struct TGrid_std140
+  {
+    std::array<std::uint32_t, 4> _size;  //!< number of clusters in x, y and z; number of global lights
+    TVec4                        _depth; //!< near, far; scale and bias of the slice: `log(depth) * scale + bias`
+  };
+
+  //! counters of the last assignment
+  struct TStatistics
+  {
+    size_t _lights        = 0; //!< number of enabled lights
+    size_t _point_lights  = 0; //!< number of binned point lights
+    size_t _spot_lights   = 0; //!< number of binned spot lights
+    size_t _global_lights = 0; //!< number of global lights
+    size_t _culled        = 0; //!< number of lights outside of the view frustum
+    size_t _tested        = 0; //!< number of cluster tests
+    size_t _indices       = 0; //!< number of light indices in the clusters
+    size_t _max_lights    = 0; //!< maximum number of lights in a cluster
+  };
+
+  //! maximum influence distance of a light; `c_infinite_radius` for directional lights and lights without attenuation
+  static float InfluenceRadius( const TLight &light );
+
+  CClusteredLights( size_t x = 16, size_t y = 9, size_t z = 24, size_t no_of_threads = 0 );
+
+  size_t                               SizeX( void )        const { return _x; }
+  size_t                               SizeY( void )        const { return _y; }
+  size_t                               SizeZ( void )        const { return _z; }
+  const TStatistics                  & Statistics( void )   const { return _statistics; }
+  const TGrid_std140                 & Grid( void )         const { return _grid; }
+  const std::vector<TLight_std430>   & Lights( void )       const { return _lights; }   //!< one entry for each light of the table
+  const std::vector<TCluster_std430> & Clusters( void )     const { return _clusters; } //!< index `(z * y_size + y) * x_size + x`
+  const std::vector<std::uint32_t>   & Indices( void )      const { return _indices; }  //!< global lights, followed by the lights of the clusters
+
+  size_t       Cluster( size_t x, size_t y, size_t z ) const { return (z * _y + y) * _x + x; }
+  TBoundingBox ClusterBounds( size_t x, size_t y, size_t z ) const; //!< view space bounding box of a cluster
+
+  CClusteredLights & Threads( size_t no_of_threads ) { _no_of_threads = no_of_threads; return *this; } //!< 0: default concurrency
+
+  //! assign the lights to the clusters; `max_depth` limits the depth range (0: far plane of the projection)
+  void Assign( const TLightTable &lights, const TMat44 &view, const TMat44 &projection, float max_depth = 0.0f );
+
+private:
+
+  //! view space bounding volume of a light, and its range of clusters
+  struct TBinnedLight
+  {
+    std::uint32_t        _index;     //!< index in the light table
+    std::array<float, 4> _sphere;    //!< bounding sphere: center and radius
+    bool                 _spot;      //!< test the cone
+    std::array<float, 3> _apex;      //!< apex of the cone
+    std::array<float, 3> _axis;      //!< normalized direction of the cone
+    float                _range;     //!< influence radius
+    float                _cos;       //!< cosine of the half cone angle
+    float                _sin;       //!< sine of the half cone angle
+    std::array<std::uint32_t, 6> _clusters; //!< cluster range: x0, x1, y0, y1, z0, z1 (inclusive)
+  };
+
+  void SetupClusters( const TMat44 &projection, float max_depth );
+  void AssignSlice( size_t slice );
+
+  size_t                                  _x;
+  size_t                                  _y;
+  size_t                                  _z;
+  size_t                                  _stride;        //!< number of clusters in a row, rounded up to the SIMD width
+  size_t                                  _no_of_threads;
+  TGrid_std140                            _grid{};
+  TMat44                                  _projection{}; //!< projection of the cluster bounds
+  float                                   _max_depth = -1.0f;
+  std::vector<float>                      _min_x, _min_y, _min_z; //!< cluster bounds, row by row (`_stride` clusters per row)
+  std::vector<float>                      _max_x, _max_y, _max_z;
+  std::vector<float>                      _center_x, _center_y, _center_z, _radius; //!< bounding spheres of the clusters
+  std::vector<TLight_std430>              _lights;
+  std::vector<TCluster_std430>            _clusters;
+  std::vector<std::uint32_t>              _indices;
+  std::vector<TBinnedLight>               _binned;        //!< one entry for each light of the table
+  std::vector<std::uint8_t>               _kind;          //!< kind of each light: disabled, culled, global, point or spot light
+  std::vector<std::vector<std::uint32_t>> _slice_lights;  //!< binned lights of each slice
+  std::vector<std::vector<std::uint32_t>> _slice_indices; //!< light indices of each slice, cluster by cluster
+  std::vector<std::vector<std::uint32_t>> _slice_pairs;   //!< (cluster, light) pairs of each slice
+  std::vector<size_t>                     _slice_tested;
+  TStatistics                             _statistics;
+};
+
+
+} // Render
+
+#endif // RenderUtil_ClusteredLights_h_INCLUDED
@@ -0,0 +1,123 @@
+/******************************************************************//**
+* \brief   CPU cone step map generation from a height map.
+*
+* The cone step map is a `RGBA8` image with the height in the red
+* channel, the cone ratio in the green channel and the slope of the
+* height in x and y in the blue and alpha channel.
+*
+* See [Cone Step Mapping: An Iterative Ray-Heightfield Intersection Algorithm](http://www.lonesock.net/files/ConeStepMapping.pdf)
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_ConeStepMap_h_INCLUDED
+#define RenderUtil_ConeStepMap_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_IDrawType.h"
+
+// STL
+
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//---------------------------------------------------------------------
+// CConeStepMapGenerator
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Search of the cone ratio.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+enum class TConeMapAlgorithm : t_byte
+{
+  circular,     //!< circles of increasing radius, 1 texel apart; green is `sqrt(ratio) * 255`
+  square_rings, //!< square rings of increasing radius (Dummer); green is `sqrt(ratio) * 255 + 0.5`, at least 1
+};
+
+
+/******************************************************************//**
+* \brief Parameters of the cone step map generation.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TConeMapParameters
+{
+  TConeMapAlgorithm _algorithm{ TConeMapAlgorithm::square_rings }; //!< search of the cone ratio
+  bool              _simd{ true };                                 //!< true: scan the rings of 8 texels at once; false: scalar reference loop
+  bool              _pyramid{ false };                             //!< true: skip the rings, which are too low to reduce the ratio, by a max-mip pyramid (only with `_simd`)
+  size_t            _tile_rows{ 1 };                               //!< number of rows of a tile, which is processed by a worker thread
+  size_t            _threads{ 0 };                                 //!< number of worker threads; 0: default concurrency
+};
+
+
+/******************************************************************//**
+* \brief CPU generation of a cone step map from a height map.
+*
+* The height is read from the first channel of the source image. The
+* image is treated as tileable: the rings wrap around at the borders
+* (the rows of the square rings are clamped in x, as in the original
+* algorithm).
+*
+* The rows of the image are distributed to the worker threads. Within
+* a row, the rings are scanned for 8 neighbouring texels at once. The
+* offsets of the circles are computed once per image. The result is
+* identical to the scalar loop, independent of the number of threads
+* and of the instruction set, because the operations of each texel are
+* executed in the same order as by the scalar loop.
+*
+* With `_pyramid`, a max-mip pyramid of the heights is built once. For
+* each texel, the longest run of following rings (1, 2, 4, ... rings),
+* whose bounding box is too low to reduce the ratio, is skipped. The
+* bound is conservative, so the skipped rings would not have changed
+* the ratio and the result is identical, too. The sides of the square
+* rings are tested in blocks of 16 texels against the pyramid cells,
+* too. This pays off on height maps with isolated peaks, where the
+* search radius of the low texels is large.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CConeStepMapGenerator
+{
+public:
+
+  CConeStepMapGenerator( void ) = default;
+  CConeStepMapGenerator( const TConeMapParameters &parameters );
+
+  const TConeMapParameters & Parameters( void ) const { return _parameters; }
+
+  //! generate a `RGBA8` cone step map from the first channel of an 8 bit image
+  bool Generate( size_t cx, size_t cy, size_t channels, size_t bpl, const t_byte *data, std::vector<t_byte> &cone_map ) const;
+
+private:
+
+  TConeMapParameters _parameters;
+};
+
+
+} // Render
+
+#endif // RenderUtil_ConeStepMap_h_INCLUDED
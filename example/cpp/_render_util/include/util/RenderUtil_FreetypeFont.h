@@ -14,6 +14,12 @@
 
 #include "../render/Render_IFont.h"
 #include "../render/Render_ITexture.h"
+#include "RenderUtil_GlyphAtlas.h"
+
+// STL
+
+#include <string>
+#include <vector>
 
 
 /******************************************************************//**
@@ -35,9 +41,34 @@ namespace Render
 struct TFreetypeTFont;
 
 
+/******************************************************************//**
+* @brief   Parameters of a FreeType font.
+*
+* Bitmap glyphs are bound to the pixel height of the rasterization.
+* Distance field glyphs can be drawn at any size, so a smaller pixel
+* height is sufficient and needs less space in the atlas.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+struct TFreetypeFontParameters
+{
+  TGlyphImageType       _glyph_image{ TGlyphImageType::bitmap }; //!< kind of the glyph images
+  size_t                _pixel_height{ 48 };                     //!< pixel height of the rasterization or the distance field generation
+  float                 _distance_range{ 4.0f };                 //!< distance range of the distance fields in pixels
+  size_t                _threads{ 0 };                           //!< number of threads for the distance field generation; 0: hardware concurrency
+  TGlyphAtlasParameters _atlas;                                  //!< parameters of the glyph atlas
+};
+
+
 /******************************************************************//**
 * @brief   Textured text implementation with freetype library.
 *
+* The text is UTF-8 encoded. The glyphs are rasterized on demand and
+* are packed to the pages of a dynamic glyph atlas. The distance fields
+* of the glyphs of a text are generated in parallel.
+*
 * @author  gernot
 * @date    2018-03-18
 * @version 1.0
@@ -50,27 +81,52 @@ public:
   using TTexturePtr = Render::ITexturePtr;
   using TFontPtr = std::unique_ptr<TFreetypeTFont>;
 
-  CFreetypeTexturedFont( const char *font_filename, int min_char );
+  CFreetypeTexturedFont( const char *font_filename, int min_char, const Render::TFreetypeFontParameters &parameters = Render::TFreetypeFontParameters() );
   virtual ~CFreetypeTexturedFont();
 
   virtual void Destroy( void ) override;                        //!< destroy all internal objects and cleanup
   virtual bool Load( Render::ITextureLoader &loader ) override; //!< load the glyphs
 
+  //! glyph atlas of the font; nullptr if the font is not loaded
+  const Render::CGlyphAtlas * Atlas( void ) const;
+
+  //! add the glyphs of a text to the atlas in advance
+  bool LoadGlyphs( t_s_param str );
+
+  //! kind of the glyph images
+  virtual Render::TGlyphImage GlyphImage( void ) const override;
+
   //! calculates box of a string in relation to its height (maximum height of the font from the bottom to the top)
   virtual bool CalculateTextSize( t_s_param str, float height, float &box_x, float &box_btm, float &box_top ) override;
 
+  //! create the glyph quads of a text for retained drawing
+  virtual bool Layout( t_s_param str, float height, float width_scale, Render::TTextLayout &layout ) override;
+
+  //! revision of the glyph atlas
+  virtual std::uint64_t LayoutRevision( void ) const override;
+
   //! render a texture based text
   virtual bool Draw( Render::IDrawBufferProvider &buffer_provider, size_t textur_binding_id, t_s_param str, float height, float width_scale, const Render::TPoint3 &pos ) override;
 
 private:
 
+  //! add the glyphs of the decoded text, which are not in the atlas yet, and mark all glyphs of the text as used
+  void AddGlyphs( void );
+
+  //! rasterize a bitmap glyph and add it to the atlas
+  void AddBitmapGlyph( char32_t codepoint );
+
   void DebugFontTexture( Render::IDrawBufferProvider &buffer_provider, size_t textur_binding_id );
 
-  std::string  _font_filename;
-  int          _min_char      = 32;
-  TFontPtr     _font;
-  bool         _valid         = true;
-  TTexturePtr  _font_texture;
+  std::string                     _font_filename;
+  int                             _min_char      = 32;
+  Render::TFreetypeFontParameters _parameters;
+  TFontPtr                        _font;
+  bool                            _valid         = true;
+  Render::ITextureLoader         *_loader        = nullptr; //!< texture loader of the atlas pages; has to outlive the font
+  std::vector<char32_t>           _codepoints;              //!< decoded text
+  std::vector<char32_t>           _new_codepoints;          //!< glyphs of the text, which are not in the atlas
+  Render::TTextLayout             _layout;                  //!< layout of the immediately drawn text
 };
 
 
@@ -0,0 +1,246 @@
+/******************************************************************//**
+* \brief   Dynamic glyph atlas with skyline packing.
+*
+* The glyphs are packed on demand to the pages of the atlas. The
+* pages are kept on the CPU and the modified region of a page is
+* uploaded to the page texture at once, before the glyphs are drawn.
+* If all pages are full, the least recently used page is evicted.
+*
+* See [Jukka Jylänki, A Thousand Ways to Pack the Bin](https://github.com/juj/RectangleBinPack/blob/master/RectangleBinPack.pdf)
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_GlyphAtlas_h_INCLUDED
+#define RenderUtil_GlyphAtlas_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_ITexture.h"
+
+// STL
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//! decode an UTF-8 string to unicode code points; invalid sequences are replaced by U+FFFD
+void DecodeUTF8( std::string_view str, std::vector<char32_t> &codepoints );
+
+
+//---------------------------------------------------------------------
+// CSkylinePacker
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Skyline bottom-left rectangle packer.
+*
+* The upper contour of the packed rectangles is stored as a list of
+* horizontal segments. A new rectangle is placed at the position, where
+* its top is the lowest; ties are broken by the smaller wasted width.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CSkylinePacker
+{
+public:
+
+  CSkylinePacker( void ) = default;
+  CSkylinePacker( size_t cx, size_t cy ) { Reset( cx, cy ); }
+
+  void Reset( size_t cx, size_t cy );                          //!< remove all rectangles
+  bool Insert( size_t cx, size_t cy, size_t &x, size_t &y );  //!< pack a rectangle; returns false, if it doesn't fit
+
+  size_t Width( void )    const { return _cx; }
+  size_t Height( void )   const { return _cy; }
+  size_t UsedArea( void ) const { return _used_area; }
+
+private:
+
+  //! horizontal segment of the skyline
+  struct TSegment
+  {
+    size_t _x;
+    size_t _y;
+    size_t _cx;
+  };
+
+  //! top of a rectangle, which is placed at the start of a segment
+  bool Fit( size_t index, size_t cx, size_t cy, size_t &y ) const;
+
+  size_t                _cx{ 0 };
+  size_t                _cy{ 0 };
+  size_t                _used_area{ 0 };
+  std::vector<TSegment> _skyline;
+};
+
+
+//---------------------------------------------------------------------
+// CGlyphAtlas
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Parameters of the glyph atlas.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TGlyphAtlasParameters
+{
+  size_t _page_size{ 512 };                             //!< width and height of a page
+  size_t _max_pages{ 4 };                               //!< maximum number of pages; further glyphs evict the least recently used page
+  size_t _padding{ 1 };                                 //!< empty texels between the glyphs
+  TTextureParameters _texture{ ITextureLoader::Parameters( T2D_RGBA_clamped_bilinear ) }; //!< parameters of the page textures
+};
+
+
+/******************************************************************//**
+* \brief Metrics of a glyph in 26.6 fixed point pixels (like
+* `FT_Glyph_Metrics`).
+*
+* The glyph image is placed at the image position (like the bitmap
+* position of a `FT_GlyphSlot`); it may exceed the metrics box, e.g.
+* by the border of a distance field.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TGlyphMetrics
+{
+  std::int32_t _width{ 0 };
+  std::int32_t _height{ 0 };
+  std::int32_t _bearing_x{ 0 };
+  std::int32_t _bearing_y{ 0 };
+  std::int32_t _advance{ 0 };
+  std::int32_t _image_left{ 0 };  //!< left side of the glyph image relative to the origin
+  std::int32_t _image_top{ 0 };   //!< top side of the glyph image relative to the base line
+};
+
+
+/******************************************************************//**
+* \brief Glyph of the atlas.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TAtlasGlyph
+{
+  static constexpr size_t no_page = (size_t)-1;
+
+  TGlyphMetrics _metrics;            //!< glyph metrics
+  size_t        _page{ no_page };    //!< page of the glyph image; `no_page`: the glyph has no image (e.g. space)
+  size_t        _x{ 0 };             //!< glyph image start x
+  size_t        _y{ 0 };             //!< glyph image start y
+  size_t        _cx{ 0 };            //!< glyph image width
+  size_t        _cy{ 0 };            //!< glyph image height
+  std::uint64_t _last_use{ 0 };      //!< generation of the last use
+};
+
+
+/******************************************************************//**
+* \brief Dynamic glyph atlas.
+*
+* The glyph images are RGBA8 (premultiplied alpha). A use generation
+* is started by `BeginUse` (e.g. for each text, which is drawn); pages,
+* which contain glyphs of the current generation, are never evicted.
+* The atlas doesn't depend on the font rasterizer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CGlyphAtlas
+{
+public:
+
+  CGlyphAtlas( void ) = default;
+  CGlyphAtlas( const TGlyphAtlasParameters &parameters );
+  CGlyphAtlas( const CGlyphAtlas & ) = delete;
+  CGlyphAtlas & operator = ( const CGlyphAtlas & ) = delete;
+
+  const TGlyphAtlasParameters & Parameters( void ) const { return _parameters; }
+
+  //! remove all glyphs and pages
+  void Clear( void );
+
+  //! start a new use generation
+  void BeginUse( void ) { ++ _generation; }
+
+  //! find a glyph and mark it as used; nullptr if the glyph is not in the atlas
+  const TAtlasGlyph * Find( char32_t codepoint );
+
+  //! add a glyph image (RGBA8) to the atlas and mark it as used; nullptr if there is no space left
+  const TAtlasGlyph * Insert( char32_t codepoint, const TGlyphMetrics &metrics, size_t cx, size_t cy, const t_byte *rgba, size_t bpl );
+
+  //! create the page textures and upload the modified region of each page
+  bool Upload( ITextureLoader &loader );
+
+  size_t     Pages( void )                 const { return _pages.size(); }
+  size_t     PageSize( void )              const { return _parameters._page_size; }
+  ITexture * PageTexture( size_t page )    const { return page < _pages.size() ? _pages[page]._texture.get() : nullptr; }
+  const std::vector<t_byte> & PageImage( size_t page ) const { return _pages[page]._image; }
+
+  //! ratio of the packed area and the area of all pages
+  double Occupancy( void ) const;
+
+  size_t Glyphs( void )    const { return _glyphs.size(); } //!< number of glyphs in the atlas
+  size_t Evictions( void ) const { return _evictions; }     //!< number of evicted pages
+  size_t Uploads( void )   const { return _uploads; }       //!< number of region uploads
+
+  //! revision of the glyph placement; it changes, when glyphs are removed from the atlas, so retained texture coordinates become invalid
+  std::uint64_t Revision( void ) const { return _revision; }
+
+private:
+
+  //! page of the atlas
+  struct TPage
+  {
+    CSkylinePacker        _packer;
+    std::vector<t_byte>   _image;                //!< RGBA8 texels of the page
+    ITexturePtr           _texture;
+    std::array<size_t, 4> _dirty{ 0, 0, 0, 0 };  //!< modified region; min x, min y, max x, max y (exclusive)
+    std::uint64_t         _last_use{ 0 };        //!< generation of the last use of a glyph of the page
+  };
+
+  bool AddPage( void );
+  void EvictPage( size_t page );
+  bool Allocate( size_t cx, size_t cy, size_t &page, size_t &x, size_t &y );
+  static void AddDirty( TPage &page, size_t x0, size_t y0, size_t x1, size_t y1 );
+
+  TGlyphAtlasParameters                     _parameters;
+  std::unordered_map<char32_t, TAtlasGlyph> _glyphs;
+  std::vector<TPage>                        _pages;
+  std::uint64_t                             _generation{ 1 };
+  size_t                                    _evictions{ 0 };
+  size_t                                    _uploads{ 0 };
+  std::uint64_t                             _revision{ 0 };
+};
+
+
+} // Render
+
+#endif // RenderUtil_GlyphAtlas_h_INCLUDED
@@ -0,0 +1,178 @@
+/******************************************************************//**
+* \brief   Signed distance field and multi-channel signed distance field
+* generation from glyph outlines.
+*
+* The outlines are given by contours of line, quadratic and cubic
+* Bézier segments (e.g. decomposed from a FreeType outline). The curves
+* are flattened and the distance of each texel to the line segments is
+* evaluated with a SIMD kernel (AVX2 or SSE2, with a scalar fallback).
+* The inside of the glyph is evaluated by the non-zero winding rule.
+*
+* For the multi-channel distance field the edges are colored, so that
+* the corners of the outline are preserved
+* (see [Viktor Chlumský, Shape Decomposition for Multi-channel Distance Fields](https://github.com/Chlumsky/msdfgen/files/3050967/thesis.pdf)).
+* The RGB channels contain the pseudo distances of the colored edges
+* and the alpha channel contains the true signed distance. The
+* distances are encoded as `0.5 + distance / (2 * range)`, the inside of
+* the glyph is above 0.5.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_GlyphSDF_h_INCLUDED
+#define RenderUtil_GlyphSDF_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_IFont.h"
+
+// STL
+
+#include <array>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//---------------------------------------------------------------------
+// CGlyphOutline
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Outline of a glyph in pixels, y axis upwards.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CGlyphOutline
+{
+public:
+
+  using TPoint = std::array<float, 2>;
+
+  //! type of an outline edge
+  enum class TEdgeType : t_byte
+  {
+    line,      //!< 2 points
+    quadratic, //!< 3 points
+    cubic,     //!< 4 points
+  };
+
+  //! edge of a contour
+  struct TEdge
+  {
+    TEdgeType             _type;
+    std::array<TPoint, 4> _p;
+  };
+
+  using TContour = std::vector<TEdge>;
+
+  void Clear( void ) { _contours.clear(); }
+
+  void MoveTo( const TPoint &p );                                         //!< start a new contour
+  void LineTo( const TPoint &p );                                         //!< add a line to the current contour
+  void QuadraticTo( const TPoint &c, const TPoint &p );                   //!< add a quadratic Bézier curve to the current contour
+  void CubicTo( const TPoint &c1, const TPoint &c2, const TPoint &p );     //!< add a cubic Bézier curve to the current contour
+  void Close( void );                                                     //!< close the current contour
+
+  bool Empty( void ) const { return _contours.empty(); }
+  const std::vector<TContour> & Contours( void ) const { return _contours; }
+
+  //! bounding box of the control points; false if the outline is empty
+  bool Bounds( TPoint &min_pt, TPoint &max_pt ) const;
+
+private:
+
+  std::vector<TContour> _contours;
+  TPoint                _start{ 0.0f, 0.0f };
+  TPoint                _current{ 0.0f, 0.0f };
+};
+
+
+//---------------------------------------------------------------------
+// CDistanceFieldGenerator
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Parameters of the distance field generation.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TDistanceFieldParameters
+{
+  TGlyphImageType _type{ TGlyphImageType::msdf }; //!< `sdf` or `msdf`
+  float           _range{ 4.0f };                //!< distance in pixels, which is encoded from the edge to the minimum and maximum value
+  float           _tolerance{ 0.05f };           //!< maximum deviation of the flattened curves in pixels
+  float           _corner_angle{ 3.0f };         //!< two edges form a corner, if their directions differ by more than pi minus this angle (radians)
+  size_t          _threads{ 0 };                 //!< number of threads for the generation of multiple glyphs; 0: hardware concurrency
+};
+
+
+/******************************************************************//**
+* \brief Distance field image of a glyph.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TDistanceFieldImage
+{
+  size_t              _cx{ 0 };     //!< width of the image
+  size_t              _cy{ 0 };     //!< height of the image
+  int                 _left{ 0 };   //!< x coordinate of the left side of the image in pixels
+  int                 _top{ 0 };    //!< y coordinate of the top side of the image in pixels
+  std::vector<t_byte> _rgba;        //!< RGBA8 texels, top row first
+};
+
+
+/******************************************************************//**
+* \brief Distance field generator.
+*
+* The image covers the bounding box of the outline, extended by the
+* distance range. The texels are sampled at their centers.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CDistanceFieldGenerator
+{
+public:
+
+  CDistanceFieldGenerator( void ) = default;
+  CDistanceFieldGenerator( const TDistanceFieldParameters &parameters ) : _parameters( parameters ) {}
+
+  const TDistanceFieldParameters & Parameters( void ) const { return _parameters; }
+
+  //! generate the distance field of a glyph; false if the outline is empty
+  bool Generate( const CGlyphOutline &outline, TDistanceFieldImage &image ) const;
+
+  //! generate the distance fields of multiple glyphs in parallel
+  void Generate( const std::vector<CGlyphOutline> &outlines, std::vector<TDistanceFieldImage> &images ) const;
+
+private:
+
+  TDistanceFieldParameters _parameters;
+};
+
+
+} // Render
+
+#endif // RenderUtil_GlyphSDF_h_INCLUDED
@@ -0,0 +1,104 @@
+/******************************************************************//**
+* \brief   FNV-1a hash codes for cache keys and checksums.
+*
+* [Fowler-Noll-Vo hash function](https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function)
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_Hash_h_INCLUDED
+#define RenderUtil_Hash_h_INCLUDED
+
+
+// includes
+
+// STL
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+const std::uint32_t c_fnv1a_32_basis = 2166136261u;              //!< offset basis of the 32 bit FNV-1a hash
+const std::uint32_t c_fnv1a_32_prime = 16777619u;                //!< prime of the 32 bit FNV-1a hash
+const std::uint64_t c_fnv1a_64_basis = 14695981039346656037ull;  //!< offset basis of the 64 bit FNV-1a hash
+const std::uint64_t c_fnv1a_64_prime = 1099511628211ull;         //!< prime of the 64 bit FNV-1a hash
+
+
+/******************************************************************//**
+* \brief 32 bit FNV-1a hash code of a string.
+*
+* The hash can be continued, by passing the hash of the preceding data.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+constexpr std::uint32_t HashFNV1a32(
+  std::string_view text,                      //!< I - text
+  std::uint32_t    hash = c_fnv1a_32_basis )  //!< I - hash of the preceding data
+{
+  for ( char c : text )
+  {
+    hash ^= (std::uint32_t)(unsigned char)c;
+    hash *= c_fnv1a_32_prime;
+  }
+  return hash;
+}
+
+
+/******************************************************************//**
+* \brief 64 bit FNV-1a hash code of a block of bytes.
+*
+* The hash can be continued, by passing the hash of the preceding data.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+inline std::uint64_t HashFNV1a64(
+  const void    *data,                        //!< I - data
+  size_t         size,                        //!< I - size of the data in bytes
+  std::uint64_t  hash = c_fnv1a_64_basis )    //!< I - hash of the preceding data
+{
+  const unsigned char *bytes = static_cast<const unsigned char*>( data );
+  for ( size_t i = 0; i < size; ++ i )
+  {
+    hash ^= bytes[i];
+    hash *= c_fnv1a_64_prime;
+  }
+  return hash;
+}
+
+
+/******************************************************************//**
+* \brief 64 bit FNV-1a hash code of a string.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+inline std::uint64_t HashFNV1a64(
+  std::string_view text,                      //!< I - text
+  std::uint64_t    hash = c_fnv1a_64_basis )  //!< I - hash of the preceding data
+{
+  return HashFNV1a64( text.data(), text.size(), hash );
+}
+
+
+} // Render
+
+#endif // RenderUtil_Hash_h_INCLUDED
@@ -0,0 +1,134 @@
+/******************************************************************//**
+* \brief   CPU height map transformations (displacement map and
+* normal map from a height map).
+*
+* Implements `TImageTransform::to_displacement_map` and
+* `TImageTransform::to_normal_and_displacement` for 8 bit image
+* resources. The normal vectors are computed from the height gradient,
+* with a Sobel or Scharr operator. The result can be stored to and
+* restored from a cache file.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_HeightMap_h_INCLUDED
+#define RenderUtil_HeightMap_h_INCLUDED
+
+
+// includes
+
+#include "RenderUtil_MipmapGenerator.h"
+
+// STL
+
+#include <string>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//---------------------------------------------------------------------
+// CHeightMapTransform
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Gradient operator for the normal map generation.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+enum class THeightMapFilter : t_byte
+{
+  sobel,  //!< 3x3 Sobel operator; weights 1, 2, 1
+  scharr, //!< 3x3 Scharr operator; weights 3, 10, 3; better rotation invariance
+};
+
+
+/******************************************************************//**
+* \brief Parameters of the height map transformation.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct THeightMapParameters
+{
+  THeightMapFilter _filter{ THeightMapFilter::sobel }; //!< gradient operator
+  t_fp             _strength{ 1.0f };                  //!< scale of the height gradient; the height range [0, 1] relative to the size of 1 texel
+  TTextureWrap     _wrap{ TTextureWrap::clamp };       //!< texel look up at the borders of the image (clamp, mirrored or tiled)
+  bool             _invert_y{ false };                 //!< invert the y component of the normal vector (green channel down)
+  size_t           _tile_rows{ 32 };                   //!< number of rows of a tile, which is processed by a worker thread
+  size_t           _threads{ 0 };                      //!< number of worker threads; 0: default concurrency
+};
+
+
+/******************************************************************//**
+* \brief CPU transformation of a height map to a displacement map or
+* a combined normal and displacement map.
+*
+* The height is read from the red channel of a `displacement_map`
+* or `displacement_cone_map`, the alpha channel of a
+* `normal_displacement_map` and the luminance of all other images.
+* The result of `to_displacement_map` is a `GRAY8` image and the
+* result of `to_normal_and_displacement` is a `RGBA8` image with the
+* normal vector in the RGB channels and the height in the alpha channel.
+* The normal vector points up (+y) in the direction of the first line
+* of the image.
+*
+* The image is processed in tiles of rows, which are distributed to the
+* worker threads. The gradient and the normalization is vectorized over
+* 8 (AVX2) or 4 (SSE2) texels.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CHeightMapTransform
+{
+public:
+
+  CHeightMapTransform( void ) = default;
+  CHeightMapTransform( const THeightMapParameters &parameters );
+
+  const THeightMapParameters & Parameters( void ) const { return _parameters; }
+
+  //! true: the transformation contains a height map transformation
+  static bool IsHeightMapTransform( TImageTransformations transform );
+
+  //! apply the height map transformation of `transform` to a 2 dimensional 8 bit image
+  bool Transform( const IImageResource &image, TImageTransformations transform, CMipmapImage &target ) const;
+
+  //! load the transformed image from the cache file, or transform the image and store it to the cache file; `key` is the cache key (`Key`)
+  bool Transform( const IImageResource &image, TImageTransformations transform, CMipmapImage &target, const std::string &cache_filename, CMipmapChain::TKey key ) const;
+
+  //! cache key of an image, which is transformed with the current parameters
+  CMipmapChain::TKey Key( const IImageResource &image, TImageTransformations transform ) const;
+
+  //! name of the cache file for a cache key in a cache directory
+  static std::string CacheFilename( const std::string &cache_directory, CMipmapChain::TKey key );
+
+  //! read the heights of an image to floating point values in range [0, 1]
+  static bool ReadHeights( const IImageResource &image, std::vector<float> &heights, size_t no_of_threads = 0 );
+
+private:
+
+  THeightMapParameters _parameters;
+};
+
+
+} // Render
+
+#endif // RenderUtil_HeightMap_h_INCLUDED
@@ -0,0 +1,192 @@
+/******************************************************************//**
+* \brief   CPU mipmap chain generator for image resources.
+*
+* The mipmap levels are generated from an `IImageResource` with a
+* separable box, Kaiser or Lanczos filter, in linear color space.
+* The levels can be stored to and restored from a cache file, so that
+* the mipmap generation can be skipped completely, when a texture is
+* loaded again.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_MipmapGenerator_h_INCLUDED
+#define RenderUtil_MipmapGenerator_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_ITexture.h"
+
+// STL
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//---------------------------------------------------------------------
+// CMipmapGenerator
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Filter kernel for the generation of the mipmap levels.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+enum class TMipmapFilter : t_byte
+{
+  box,     //!< box filter; 2x2 average for power of 2 textures (like `glGenerateMipmap`)
+  kaiser,  //!< Kaiser windowed sinc filter; radius 3
+  lanczos, //!< Lanczos 3 filter
+};
+
+
+/******************************************************************//**
+* \brief Parameters of the mipmap generation.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TMipmapParameters
+{
+  TMipmapFilter _filter{ TMipmapFilter::box };   //!< filter kernel
+  TTextureWrap  _wrap{ TTextureWrap::clamp };    //!< texel look up at the borders of the image (clamp or tiled)
+  bool          _srgb{ true };                   //!< the color channels are sRGB encoded and are filtered in linear space
+  bool          _normal_map{ false };            //!< the RGB channels are a normal vector, which is renormalized in each level
+  bool          _alpha_coverage{ false };        //!< preserve the alpha test coverage of level 0 (cutout textures)
+  t_fp          _alpha_reference{ 0.5f };        //!< alpha test reference value for the alpha coverage
+  size_t        _max_levels{ 0 };                //!< maximum number of levels including level 0; 0: complete chain
+  size_t        _threads{ 0 };                   //!< number of worker threads; 0: default concurrency
+};
+
+
+/******************************************************************//**
+* \brief Image resource of a single mipmap level, which owns its
+* tightly packed data.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CMipmapImage
+  : public IImageResource
+{
+public:
+
+  CMipmapImage( void ) = default;
+  CMipmapImage( TImageKind kind, TImageFormat format, size_t cx, size_t cy );
+
+  virtual TImageKind   Kind( void )      const override { return _kind; }
+  virtual TTextureType Type( void )      const override { return TTextureType::T2D; }
+  virtual TImageFormat Format( void )    const override { return _format; }
+  virtual TTextureSize Size( void )      const override { return { _cx, _cy, 1 }; }
+  virtual size_t       Layers( void )    const override { return 1; }
+  virtual size_t       BPL( void )       const override { return _cx * _channels; }
+  virtual size_t       LineAlign( void ) const override { return 1; }
+  virtual const void * DataPtr( void )   const override { return _data.data(); }
+
+  size_t                      Channels( void ) const { return _channels; }
+  std::vector<t_byte>       & Data( void )           { return _data; }
+  const std::vector<t_byte> & Data( void )     const { return _data; }
+
+private:
+
+  TImageKind          _kind{ TImageKind::diffuse };
+  TImageFormat        _format{ TImageFormat::RGBA8 };
+  size_t              _cx{ 0 };
+  size_t              _cy{ 0 };
+  size_t              _channels{ 4 };
+  std::vector<t_byte> _data;
+};
+
+
+/******************************************************************//**
+* \brief Complete chain of mipmap levels, starting at level 0.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CMipmapChain
+{
+public:
+
+  using TKey = std::uint64_t;
+
+  size_t                Levels( void )          const { return _levels.size(); }
+  const CMipmapImage  & Level( size_t level )   const { return _levels[level]; }
+  std::vector<CMipmapImage> & LevelList( void )       { return _levels; }
+
+  //! list of image resources, which can be passed to `ITextureLoader::CreateTexture`
+  std::vector<const IImageResource*> Images( void ) const;
+
+  bool Save( const std::string &filename, TKey key ) const; //!< write the chain to a cache file
+  bool Load( const std::string &filename, TKey key );       //!< read the chain from a cache file, if the key matches
+
+private:
+
+  std::vector<CMipmapImage> _levels;
+};
+
+
+/******************************************************************//**
+* \brief CPU mipmap generator.
+*
+* The filtering is done separable, first vertical then horizontal, on
+* 4 channel floating point texels. The vertical pass is vectorized
+* over the rows (AVX2 or SSE2) and the horizontal pass over the 4
+* channels of a texel (SSE2). The rows of a level are distributed to
+* the worker threads.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CMipmapGenerator
+{
+public:
+
+  CMipmapGenerator( void ) = default;
+  CMipmapGenerator( const TMipmapParameters &parameters );
+
+  const TMipmapParameters & Parameters( void ) const { return _parameters; }
+
+  //! generate the complete mipmap chain of a 2 dimensional image
+  bool Generate( const IImageResource &image, CMipmapChain &chain ) const;
+
+  //! load the mipmap chain from the cache file, or generate it and store it to the cache file
+  bool Generate( const IImageResource &image, CMipmapChain &chain, const std::string &cache_filename ) const;
+
+  //! cache key of an image, which is generated with the current parameters
+  CMipmapChain::TKey Key( const IImageResource &image ) const;
+
+  //! number of the levels of the chain
+  static size_t NumberOfLevels( size_t cx, size_t cy, size_t max_levels );
+
+private:
+
+  TMipmapParameters _parameters;
+};
+
+
+} // Render
+
+#endif // RenderUtil_MipmapGenerator_h_INCLUDED
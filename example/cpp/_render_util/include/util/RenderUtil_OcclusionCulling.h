@@ -0,0 +1,209 @@
+/******************************************************************//**
+* \brief   Occlusion culling by a software depth buffer.
+*
+* Simplified occluder meshes are rasterized on the CPU to a low
+* resolution depth buffer; the bounding boxes of the objects are tested
+* against the depth buffer. No rendering context is required.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_OcclusionCulling_h_INCLUDED
+#define RenderUtil_OcclusionCulling_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_IDrawType.h"
+#include "../render/Render_IMesh.h"
+#include "RenderUtil_SceneBVH.h"
+
+
+// STL
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+/******************************************************************//**
+* \brief   Occlusion culling by a software depth buffer.
+*
+* The depth buffer is organized in tiles of 8x8 pixels. The occluder
+* triangles are transformed and clipped at the near plane (`Render`) and
+* binned to the rows of tiles. `Rasterize` rasterizes the rows of tiles
+* in parallel: each row of a tile is covered by 8 edge function values
+* at once (AVX2: 8 lanes, SSE2: 2x4 lanes) and the coverage mask selects
+* the pixels whose depth is updated. The maximum depth of each tile is
+* the coarse level of the hierarchical depth buffer.
+*
+* A box is occluded, if the depth of its nearest corner is behind the
+* depth buffer in each pixel of its screen rectangle. Tiles whose
+* maximum depth is in front of the box are accepted without a test of
+* their pixels. The triangles cover the pixels whose centers they
+* contain, as in OpenGL; an object which is only visible through a gap
+* narrower than a pixel, that contains no pixel center, may be culled.
+*
+* The depth is the window space depth in [0, 1] (OpenGL clip space);
+* the buffer is cleared to 1.
+*
+* Usage per frame:
+*
+*     culler.Begin( view_projection );
+*     for ( auto &occluder : occluders )
+*       culler.Render( occluder, model );
+*     culler.Rasterize();
+*     culler.Cull( scene, visible );
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class COcclusionCuller
+{
+public:
+
+  static constexpr size_t c_tile_size = 8; //!< width and height of a tile in pixels
+
+  //! occluder mesh: vertex coordinates and triangle indices
+  struct TOccluder
+  {
+    std::vector<TVec3>         _vertices;
+    std::vector<std::uint32_t> _indices;
+  };
+
+  //! counters of the current frame
+  struct TStatistics
+  {
+    size_t _occluder_triangles = 0; //!< number of triangles passed to `Render`
+    size_t _triangles          = 0; //!< number of triangles after culling and clipping
+    size_t _tested             = 0; //!< number of tested boxes
+    size_t _occluded           = 0; //!< number of occluded boxes
+
+    double Culled( void ) const { return _tested > 0 ? 100.0 * (double)_occluded / (double)_tested : 0.0; } //!< percentage of the occluded boxes
+  };
+
+  //! occluder of a triangle or polygon mesh; polygons with a constant face size are triangulated as fans
+  template<typename T_INDEX>
+  static TOccluder Occluder( const IMeshData<float, T_INDEX> &mesh );
+
+  COcclusionCuller( size_t width = 320, size_t height = 192, size_t no_of_threads = 0 );
+
+  size_t                     Width( void )      const { return _width; }
+  size_t                     Height( void )     const { return _height; }
+  const TStatistics        & Statistics( void ) const { return _statistics; }
+  const std::vector<float> & TileDepth( void )  const { return _tile_depth; } //!< maximum depth of each tile
+
+  COcclusionCuller & BackFaceCulling( bool cull ) { _back_face_culling = cull; return *this; } //!< skip triangles which face away (closed occluders)
+  COcclusionCuller & Threads( size_t no_of_threads ) { _no_of_threads = no_of_threads; return *this; } //!< 0: default concurrency
+
+  void  Begin( const TMat44 &view_projection );                             //!< clear the depth buffer and the triangles
+  void  Render( const TOccluder &occluder, const TMat44 &model = c_m44_ident ); //!< transform, clip and set up the triangles of an occluder
+  void  Rasterize( void );                                                  //!< rasterize the triangles to the depth buffer
+  float Depth( size_t x, size_t y ) const;                                  //!< depth of a pixel
+
+  bool Visible( const TBoundingBox &box ) const; //!< test a world space box against the depth buffer
+
+  //! test boxes in parallel; `visible[i]` is set to 1, if `boxes[i]` is visible
+  void Test( const std::vector<TBoundingBox> &boxes, std::vector<std::uint8_t> &visible );
+
+  //! remove the occluded objects from a visible list of a scene; the order of the list is kept
+  size_t Cull( const CSceneBVH &scene, CSceneBVH::TVisibleList &visible );
+
+private:
+
+  //! triangle in screen space: edge functions and depth plane
+  struct TTriangle
+  {
+    std::array<float, 3> _a;  //!< x coefficients of the edge functions
+    std::array<float, 3> _b;  //!< y coefficients of the edge functions
+    std::array<float, 3> _c;  //!< constants of the edge functions
+    float                _za; //!< x coefficient of the depth plane
+    float                _zb; //!< y coefficient of the depth plane
+    float                _zc; //!< constant of the depth plane
+    int                  _x0, _y0, _x1, _y1; //!< pixel bounds (inclusive)
+  };
+
+  void SetupTriangle( const TVec4 &v0, const TVec4 &v1, const TVec4 &v2 );
+  void RasterizeRow( size_t tile_row );
+
+  size_t                             _width;
+  size_t                             _height;
+  size_t                             _tiles_x;
+  size_t                             _tiles_y;
+  size_t                             _no_of_threads;
+  bool                               _back_face_culling = false;
+  TMat44                             _view_projection = c_m44_ident;
+  std::vector<float>                 _depth;      //!< depth of the pixels, tile by tile
+  std::vector<float>                 _tile_depth; //!< maximum depth of each tile
+  std::vector<TTriangle>             _triangles;
+  std::vector<std::vector<std::uint32_t>> _bins; //!< triangles of each row of tiles
+  TStatistics                        _statistics;
+};
+
+
+/******************************************************************//**
+* \brief   Occluder of a triangle or polygon mesh.
+*
+* Meshes of other primitives result in an empty occluder.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template<typename T_INDEX>
+COcclusionCuller::TOccluder COcclusionCuller::Occluder(
+  const IMeshData<float, T_INDEX> &mesh ) //!< I - mesh
+{
+  TOccluder occluder;
+  TMeshFaceType type = mesh.FaceType();
+  bool polygons = type == TMeshFaceType::triangles || type == TMeshFaceType::quads || type == TMeshFaceType::polygons;
+  if ( polygons == false || mesh.FaceSizeKind() != TMeshFaceSizeKind::constant || mesh.FaceSize() < 3 )
+    return occluder;
+
+  const auto &vertices = mesh.Vertices();
+  size_t no_of_vertices = vertices.NoOfAttributes();
+  occluder._vertices.reserve( no_of_vertices );
+  for ( size_t i = 0; i < no_of_vertices; ++ i )
+  {
+    const float *v = vertices.data() + vertices.offset() + i * vertices.stride();
+    occluder._vertices.push_back( TVec3{ v[0], v[1], vertices.tuple_size() > 2 ? v[2] : 0.0f } );
+  }
+
+  const auto *indices = mesh.Indices();
+  size_t no_of_indices = indices != nullptr && indices->empty() == false ? indices->size() : no_of_vertices;
+  size_t face_size = (size_t)mesh.FaceSize();
+  auto index = [&]( size_t i ) -> std::uint32_t
+  {
+    return indices != nullptr && indices->empty() == false ? (std::uint32_t)indices->data()[i] : (std::uint32_t)i;
+  };
+  for ( size_t face = 0; face + face_size <= no_of_indices; face += face_size )
+  {
+    for ( size_t i = 1; i + 1 < face_size; ++ i )
+    {
+      occluder._indices.push_back( index( face ) );
+      occluder._indices.push_back( index( face + i ) );
+      occluder._indices.push_back( index( face + i + 1 ) );
+    }
+  }
+  return occluder;
+}
+
+
+} // Render
+
+#endif // RenderUtil_OcclusionCulling_h_INCLUDED
@@ -0,0 +1,115 @@
+/******************************************************************//**
+* \brief   Simple CPU parallelization helpers for the render utilities.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_Parallel_h_INCLUDED
+#define RenderUtil_Parallel_h_INCLUDED
+
+
+// includes
+
+// STL
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+/******************************************************************//**
+* \brief Number of worker threads, which is used by default.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+inline size_t DefaultConcurrency( void )
+{
+  size_t n = (size_t)std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+
+/******************************************************************//**
+* \brief Execute `func(begin, end)` for chunks of the range
+* [`first`, `last`) on `no_of_threads` threads.
+*
+* The chunks are dynamically pulled from a shared atomic counter,
+* so that fast threads take over the work of slow ones.
+* If the range is smaller than a single chunk or `no_of_threads` is 1,
+* then the function is executed on the calling thread.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template <typename T_FUNC>
+void ParallelFor(
+  size_t first,         //!< in: start of the range
+  size_t last,          //!< in: end of the range (exclusive)
+  size_t grain,         //!< in: number of elements of one chunk
+  size_t no_of_threads, //!< in: maximum number of threads (0: default concurrency)
+  T_FUNC func )         //!< in: function `void(size_t begin, size_t end)`
+{
+  if ( last <= first )
+    return;
+
+  grain = std::max( grain, (size_t)1 );
+  size_t no_of_chunks = (last - first + grain - 1) / grain;
+  size_t threads      = std::min( no_of_threads == 0 ? DefaultConcurrency() : no_of_threads, no_of_chunks );
+  if ( threads <= 1 )
+  {
+    func( first, last );
+    return;
+  }
+
+  std::atomic<size_t> next_chunk{ 0 };
+  auto worker = [&]()
+  {
+    for ( size_t chunk = next_chunk++; chunk < no_of_chunks; chunk = next_chunk++ )
+    {
+      size_t begin = first + chunk * grain;
+      func( begin, std::min( begin + grain, last ) );
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve( threads - 1 );
+  for ( size_t i = 1; i < threads; ++ i )
+    pool.emplace_back( worker );
+  worker();
+  for ( auto &thread : pool )
+    thread.join();
+}
+
+
+} // Render
+
+#endif // RenderUtil_Parallel_h_INCLUDED
@@ -0,0 +1,364 @@
+/******************************************************************//**
+* \brief   Frame profiler: CPU scopes, GPU scopes and counters, with
+*          a rolling summary and Chrome trace export.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_Profiler_h_INCLUDED
+#define RenderUtil_Profiler_h_INCLUDED
+
+
+// includes
+
+// STL
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+// preprocessor definitions
+
+//! 0: the profile macros are empty
+#ifndef RENDERUTIL_PROFILER
+#define RENDERUTIL_PROFILER 1
+#endif
+
+#define RENDERUTIL_PROFILE_CONCAT_( a, b ) a ## b
+#define RENDERUTIL_PROFILE_CONCAT( a, b ) RENDERUTIL_PROFILE_CONCAT_( a, b )
+
+#if RENDERUTIL_PROFILER
+
+//! CPU scope till the end of the block; `name` has to be a string literal
+#define RENDERUTIL_PROFILE_SCOPE( name ) \
+  Render::CProfileScope RENDERUTIL_PROFILE_CONCAT( _profile_scope_, __LINE__ )( name );
+
+//! add `value` to a counter (`Render::TProfileCounter`) of the current frame
+#define RENDERUTIL_PROFILE_COUNT( counter, value ) \
+  if ( Render::CProfiler::Enabled() == false ) {} else Render::CProfiler::Count( Render::TProfileCounter::counter, (std::uint64_t)(value) );
+
+#else
+
+#define RENDERUTIL_PROFILE_SCOPE( name )
+#define RENDERUTIL_PROFILE_COUNT( counter, value )
+
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//! counters of a frame
+enum class TProfileCounter
+{
+  draw_calls,     //!< number of draw calls
+  bytes_uploaded, //!< number of bytes, which are uploaded to buffers and textures
+  state_changes,  //!< number of issued state changes (`OpenGL::CStateCache`)
+  NO_OF
+};
+
+using TProfileCounters = std::array<std::uint64_t, (size_t)TProfileCounter::NO_OF>;
+
+
+/******************************************************************//**
+* \brief   Lock-free ring buffer of the scopes of one track.
+*
+* A track is a thread, or a timeline like the GPU. The ring has a
+* single producer, which pushes completed scopes, and a single consumer
+* (`CProfiler::NewFrame`), which drains it. If the producer overruns
+* the consumer, the oldest scopes are lost.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CProfileRing
+{
+public:
+
+  static constexpr size_t c_size = 1 << 14; //!< number of scopes in the ring (power of 2)
+
+  struct TScope
+  {
+    const char    *_name;
+    std::uint64_t  _begin; //!< nanoseconds (`CProfiler::Now`)
+    std::uint64_t  _end;
+  };
+
+  CProfileRing( std::uint32_t id )
+    : _id( id )
+    , _slots( new TSlot[c_size] )
+  {}
+
+  std::uint32_t Id( void ) const { return _id; } //!< id of the track
+
+  //! push a completed scope; producer thread only
+  void Push( const char *name, std::uint64_t begin, std::uint64_t end )
+  {
+    std::uint64_t index = _committed.load( std::memory_order_relaxed );
+    _claimed.store( index + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+    TSlot &slot = _slots[index & (c_size - 1)];
+    slot._name.store( name, std::memory_order_relaxed );
+    slot._begin.store( begin, std::memory_order_relaxed );
+    slot._end.store( end, std::memory_order_relaxed );
+    _committed.store( index + 1, std::memory_order_release );
+  }
+
+  //! append the pushed scopes to `scopes`; consumer thread only; returns the number of lost scopes
+  size_t Drain( std::vector<TScope> &scopes );
+
+private:
+
+  struct TSlot
+  {
+    std::atomic<const char*>   _name{ nullptr };
+    std::atomic<std::uint64_t> _begin{ 0 };
+    std::atomic<std::uint64_t> _end{ 0 };
+  };
+
+  std::uint32_t              _id;
+  std::unique_ptr<TSlot[]>   _slots;
+  std::atomic<std::uint64_t> _claimed{ 0 };   //!< number of started pushes
+  std::atomic<std::uint64_t> _committed{ 0 }; //!< number of completed pushes
+  std::uint64_t              _read = 0;       //!< number of consumed scopes
+};
+
+
+/******************************************************************//**
+* \brief   Frame profiler.
+*
+* CPU scopes (`CProfileScope`, `RENDERUTIL_PROFILE_SCOPE`) record their
+* begin and end time in nanoseconds to a ring buffer of the current
+* thread; no lock is taken, after the ring of the thread was created.
+* Other timelines (`Track`), like GPU timer queries, push their scopes
+* to a ring of their own. Counters (`RENDERUTIL_PROFILE_COUNT`) are
+* atomic sums.
+*
+* `NewFrame` completes a frame: it drains the rings and takes the
+* counters. The scopes and counters of the last `c_summary_frames`
+* frames are summarized by `Summary`. While `Capture` is on, the scopes
+* and the counters are kept for `WriteChromeTrace`, which writes the
+* JSON format of `chrome://tracing` and Perfetto.
+*
+* The profiler is disabled by default. While it is disabled, a scope
+* or a counter costs a relaxed atomic load. If `RENDERUTIL_PROFILER` is
+* defined 0, the macros are empty.
+*
+*     Render::CProfiler::Instance().Enable( true ).Capture( true );
+*     while ( ... )
+*     {
+*       {
+*         RENDERUTIL_PROFILE_SCOPE( "update" )
+*         ...
+*       }
+*       Render::CProfiler::Instance().NewFrame();
+*     }
+*     Render::CProfiler::Instance().WriteChromeTrace( "frames.json" );
+*
+* `NewFrame`, `Summary`, `WriteChromeTrace` and `Clear` have to be
+* called by one thread.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CProfiler
+{
+public:
+
+  static constexpr size_t c_summary_frames = 120;     //!< number of frames of the rolling summary
+  static constexpr size_t c_max_captured   = 1 << 22; //!< maximum number of captured scopes
+
+  //! scope of a track
+  struct TEvent
+  {
+    const char    *_name;
+    std::uint64_t  _begin; //!< nanoseconds (`Now`)
+    std::uint64_t  _end;
+    std::uint32_t  _track; //!< id of the track
+  };
+
+  //! summary of the scopes of a name in a track
+  struct TSummaryEntry
+  {
+    std::string _track;
+    std::string _name;
+    double      _calls;      //!< average number of scopes per frame
+    double      _average_ms; //!< average time per frame
+    double      _max_ms;     //!< maximum time of a frame
+  };
+
+  struct TSummary
+  {
+    size_t                     _frames = 0;    //!< number of summarized frames
+    double                     _frame_ms = 0;  //!< average time between `NewFrame` calls
+    std::array<double, (size_t)TProfileCounter::NO_OF> _counters{}; //!< average counters per frame
+    std::vector<TSummaryEntry> _entries;       //!< sorted by track and name
+  };
+
+  struct TStatistics
+  {
+    size_t _frames   = 0; //!< number of completed frames
+    size_t _scopes   = 0; //!< number of drained scopes
+    size_t _lost     = 0; //!< number of scopes, which were overwritten in the rings
+    size_t _captured = 0; //!< number of captured scopes
+    size_t _dropped  = 0; //!< number of scopes, which were not captured, because of `c_max_captured`
+  };
+
+  static CProfiler & Instance( void );
+
+#if RENDERUTIL_PROFILER
+  static bool Enabled( void ) { return _enabled.load( std::memory_order_relaxed ); }
+#else
+  static constexpr bool Enabled( void ) { return false; }
+#endif
+
+  //! nanoseconds since the start of the profiler
+  static std::uint64_t Now( void )
+  {
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _epoch ).count();
+  }
+
+  static void Count( TProfileCounter counter, std::uint64_t value )
+  {
+    _counters[(size_t)counter].fetch_add( value, std::memory_order_relaxed );
+  }
+
+  //! ring of the current thread
+  static CProfileRing & ThreadRing( void )
+  {
+    thread_local CProfileRing *ring = nullptr;
+    if ( ring == nullptr )
+      ring = &Instance().CreateRing( std::string() );
+    return *ring;
+  }
+
+  CProfiler & Enable( bool enable );
+  CProfiler & Capture( bool capture );
+
+  bool IsCapturing( void ) const { return _capture; }
+
+  CProfileRing & Track( const std::string &name ); //!< create a track for scopes of a timeline, which is not a thread
+  CProfiler & ThreadName( const std::string &name ); //!< name of the track of the current thread
+
+  void NewFrame( void ); //!< complete the current frame
+  void Clear( void );    //!< discard the captured scopes and the summary
+
+  const TStatistics           & Statistics( void ) const { return _statistics; }
+  const std::vector<TEvent>   & Captured( void )   const { return _captured; }
+  const TProfileCounters      & LastCounters( void ) const { return _last_counters; } //!< counters of the last completed frame
+
+  TSummary    Summary( void ) const;
+  std::string SummaryText( void ) const; //!< table of the summary
+
+  bool WriteChromeTrace( std::ostream &stream ) const;
+  bool WriteChromeTrace( const std::string &filename ) const;
+
+private:
+
+  struct TFrameRecord
+  {
+    std::uint64_t       _begin = 0;
+    std::uint64_t       _end = 0;
+    TProfileCounters    _counters{};
+    std::vector<TEvent> _events;
+  };
+
+  struct TCounterSample
+  {
+    std::uint64_t    _time;
+    TProfileCounters _counters;
+  };
+
+  CProfiler( void ) = default;
+
+  CProfileRing & CreateRing( const std::string &name );
+
+  static inline std::atomic<bool>                                              _enabled{ false };
+  static inline std::array<std::atomic<std::uint64_t>, (size_t)TProfileCounter::NO_OF> _counters{};
+  static inline const std::chrono::steady_clock::time_point                    _epoch = std::chrono::steady_clock::now();
+
+  mutable std::mutex                         _rings_mutex; //!< guards the rings and the track names
+  std::vector<std::unique_ptr<CProfileRing>> _rings;
+  std::vector<std::string>                   _track_names;
+  bool                                       _capture = false;
+  std::uint64_t                              _frame_begin = 0;
+  std::vector<CProfileRing::TScope>          _drained;
+  std::vector<TFrameRecord>                  _frames;       //!< ring of the last `c_summary_frames` frames
+  size_t                                     _next_frame = 0;
+  TProfileCounters                           _last_counters{};
+  std::vector<TEvent>                        _captured;
+  std::vector<TCounterSample>                _captured_counters;
+  TStatistics                                _statistics;
+};
+
+
+/******************************************************************//**
+* \brief   CPU scope of the current thread.
+*
+* The scope is recorded, when it is stopped or destroyed. `Start` and
+* `Stop` allow spans which do not match a block, e.g. a render pass
+* from its activation to the activation of the next pass.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CProfileScope
+{
+public:
+
+  CProfileScope( void ) = default;
+  explicit CProfileScope( const char *name ) { Start( name ); }
+  ~CProfileScope() { Stop(); }
+
+  CProfileScope( const CProfileScope & ) = delete;
+  CProfileScope & operator =( const CProfileScope & ) = delete;
+
+  //! stop the running scope and start a new one; `name` has to be a string literal
+  void Start( const char *name )
+  {
+    Stop();
+    if ( CProfiler::Enabled() == false )
+      return;
+    _name = name;
+    _begin = CProfiler::Now();
+  }
+
+  void Stop( void )
+  {
+    if ( _name == nullptr )
+      return;
+    CProfiler::ThreadRing().Push( _name, _begin, CProfiler::Now() );
+    _name = nullptr;
+  }
+
+private:
+
+  const char    *_name = nullptr;
+  std::uint64_t  _begin = 0;
+};
+
+
+} // Render
+
+#endif // RenderUtil_Profiler_h_INCLUDED
@@ -0,0 +1,144 @@
+/******************************************************************//**
+* \brief   Render graph of a render process: dependencies and order of
+* the render passes, lifetimes of the buffers and aliasing of transient
+* buffers.
+*
+* The graph is independent of the graphics API, it does not require
+* a rendering context.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_RenderGraph_h_INCLUDED
+#define RenderUtil_RenderGraph_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_IRenderPass.h"
+
+
+// STL
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+/******************************************************************//**
+* \brief   Render graph of the buffers and passes of a render process.
+*
+* The dependencies of the passes are derived from the `_sources` (read
+* access) and the `_targets` (write access) of the passes. The
+* declaration order of the passes (the order of the pass IDs) defines
+* the order of conflicting accesses to a buffer:
+*
+*  - a pass which reads a buffer depends on the last preceding writer
+*  - a pass which writes a buffer depends on the last preceding writer
+*    and on all the readers since then
+*
+* Passes without targets write to the default framebuffer; they keep
+* their declaration order.
+*
+* The passes are topologically sorted. Of the passes, which are ready,
+* the one which allocates the fewest bytes for new buffers (less the
+* bytes of the buffers which it releases) is scheduled first, so the
+* lifetimes of the buffers get short.
+*
+* A buffer is transient, if its content is not required outside of the
+* frame: it is not extern, it is not marked `TBuffer::e_keep` and its
+* first access is a write access, which clears the buffer. A transient
+* buffer is dead after the last pass (in the order of the graph), which
+* accesses it. Transient buffers with equal specifications and disjoint
+* lifetimes are aliased onto the same texture.
+*
+* Note, aliasing is only valid, if the passes are executed in the
+* order of the graph (`Order`).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CRenderGraph
+{
+public:
+
+  using TBufferMap  = IRenderProcess::TBufferMap;
+  using TPassMap    = IRenderProcess::TPassMap;
+  using TSize       = IRenderProcess::TSize;
+  using TDependency = std::pair<size_t, size_t>; //!< pass ID of the prerequisite pass and of the dependent pass
+
+  static const size_t c_no_pass = (size_t)-1;
+
+  //! lifetime of a buffer
+  struct TLifetime
+  {
+    size_t _first     = c_no_pass; //!< index of the first pass in the order, which accesses the buffer
+    size_t _last      = c_no_pass; //!< index of the last pass in the order, which accesses the buffer
+    bool   _transient = false;     //!< the content of the buffer is not required outside of the frame
+  };
+
+  //! memory requirement of the buffers
+  struct TReport
+  {
+    size_t _buffers          = 0; //!< number of buffers which are accessed by any pass
+    size_t _textures         = 0; //!< number of textures which are required, with aliasing
+    size_t _bytes            = 0; //!< estimated memory of the buffers without aliasing
+    size_t _aliased_bytes    = 0; //!< estimated memory of the textures with aliasing
+
+    size_t Saved( void ) const { return _bytes - _aliased_bytes; }
+  };
+
+  CRenderGraph( void ) = default;
+  CRenderGraph( const CRenderGraph & ) = default;
+  CRenderGraph & operator = ( const CRenderGraph & ) = default;
+
+  //! build the graph for the buffer and pass specifications and the viewport size
+  bool Build( const TBufferMap &buffers, const TPassMap &passes, TSize size );
+
+  bool                             Valid( void )        const { return _valid; }
+  const std::vector<size_t>      & Order( void )        const { return _order; }        //!< pass IDs in topological order
+  const std::vector<TDependency> & Dependencies( void ) const { return _dependencies; } //!< edges of the graph
+  const TReport                  & Report( void )       const { return _report; }
+
+  const TLifetime & Lifetime( size_t bufferID ) const;    //!< lifetime of a buffer
+  size_t            Alias( size_t bufferID ) const;       //!< ID of the buffer whose texture is shared by the buffer; the buffer itself, if it is not aliased
+  const std::vector<size_t> & Dead( size_t passID ) const; //!< IDs of the transient buffers, which are dead after the pass
+
+  std::string ReportText( void ) const; //!< human readable report
+
+  static size_t TexelSize( const TBuffer &buffer );              //!< estimated size of a texel in bytes
+  static size_t BufferSize( const TBuffer &buffer, TSize size ); //!< estimated memory of a buffer in bytes
+
+private:
+
+  static bool Compatible( const TBuffer &a, const TBuffer &b );
+
+  bool                                  _valid = false;
+  std::vector<size_t>                   _order;        //!< pass IDs in topological order
+  std::vector<TDependency>              _dependencies; //!< dependencies of the passes
+  std::map<size_t, TLifetime>           _lifetimes;    //!< lifetimes of the buffers
+  std::map<size_t, size_t>              _aliases;      //!< buffer ID -> ID of the buffer which owns the texture
+  std::map<size_t, std::vector<size_t>> _dead;         //!< pass ID -> buffers which are dead after the pass
+  TReport                               _report;
+};
+
+
+} // Render
+
+#endif // RenderUtil_RenderGraph_h_INCLUDED
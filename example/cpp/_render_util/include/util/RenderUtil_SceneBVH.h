@@ -0,0 +1,221 @@
+/******************************************************************//**
+* \brief   Bounding volume hierarchy of the objects of a scene, with
+* frustum and distance culling.
+*
+* The culling does not require a rendering context. The result is a
+* compact list of the visible objects, sorted by a state key, which is
+* drawn by the draw layer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_SceneBVH_h_INCLUDED
+#define RenderUtil_SceneBVH_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_IDrawType.h"
+
+
+// STL
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+/******************************************************************//**
+* \brief   Axis aligned bounding box.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TBoundingBox
+{
+  TVec3 _min{ 0.0f, 0.0f, 0.0f }; //!< minimum corner
+  TVec3 _max{ 0.0f, 0.0f, 0.0f }; //!< maximum corner
+};
+
+
+/******************************************************************//**
+* \brief   View frustum, by 6 planes.
+*
+* The normal vectors of the planes point to the inside of the frustum.
+* A point `p` is inside of a plane `(a, b, c, d)`, if
+* `a*p.x + b*p.y + c*p.z + d >= 0`. The planes need not be normalized.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TFrustum
+{
+  //! frustum of a view projection matrix (OpenGL clip space, column major: `m[column][row]`)
+  static TFrustum FromMatrix( const TMat44 &view_projection );
+
+  std::array<TVec4, 6> _planes; //!< left, right, bottom, top, near, far
+};
+
+
+/******************************************************************//**
+* \brief   Dynamic bounding volume hierarchy of the objects of a scene.
+*
+* The bounding boxes of the objects are stored as structure of arrays
+* in the order of the leaves of the tree. Each node of the binary tree
+* covers a contiguous range of the objects; a leaf contains up to
+* `c_leaf_size` objects. The tree is built by a binned surface area
+* heuristic.
+*
+* `Update` brings the tree up to date:
+*
+*  - the nodes above moved or removed objects are refit
+*  - a subtree, whose surface area grew by more than `c_rebuild_ratio`
+*    by refitting, is rebuilt
+*  - added objects are kept in a pending range, which is tested
+*    without the tree; the whole tree is rebuilt, if the pending range
+*    or the number of removed objects gets large.
+*
+* `Cull` traverses the tree. A node, which is entirely inside of a
+* plane, is not tested against the plane again in its subtree; all the
+* objects of a node, which is entirely inside, are visible without a
+* test. The objects of the leaves are tested in groups of 8 (AVX) or 4
+* (SSE2) against the planes. The visible objects are sorted by their
+* state key (stable LSD radix sort), so that the draw layer can batch
+* draw calls with the same state.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CSceneBVH
+{
+public:
+
+  using TObject   = std::uint32_t; //!< object handle
+  using TStateKey = std::uint64_t; //!< state key (e.g. program, material, mesh)
+
+  static constexpr TObject c_no_object = 0xffffffff;
+  static constexpr size_t c_leaf_size = 8;    //!< maximum number of objects in a leaf
+  static constexpr float c_rebuild_ratio = 2.0f; //!< a subtree is rebuilt, if its surface area grows by this factor
+
+  //! visible object
+  struct TDrawItem
+  {
+    TStateKey _key;    //!< state key of the object
+    TObject   _object; //!< object handle
+  };
+  using TVisibleList = std::vector<TDrawItem>;
+
+  //! counters of a culling operation
+  struct TCullStatistics
+  {
+    size_t _nodes    = 0; //!< number of visited nodes
+    size_t _tested   = 0; //!< number of objects, which were tested against the planes
+    size_t _accepted = 0; //!< number of objects, which were accepted without a test (entirely inside nodes)
+    size_t _visible  = 0; //!< number of visible objects
+  };
+
+  //! counters of the tree updates
+  struct TUpdateStatistics
+  {
+    size_t _rebuilds         = 0; //!< number of rebuilds of the whole tree
+    size_t _subtree_rebuilds = 0; //!< number of rebuilt subtrees
+    size_t _refit_nodes      = 0; //!< number of refit nodes
+  };
+
+  CSceneBVH( void ) = default;
+  CSceneBVH( const CSceneBVH & ) = default;
+  CSceneBVH & operator = ( const CSceneBVH & ) = default;
+
+  size_t                    Size( void )       const { return _no_of_objects; } //!< number of objects
+  size_t                    Pending( void )    const { return _size - _built; } //!< number of objects, which are not in the tree yet
+  const TUpdateStatistics & Statistics( void ) const { return _statistics; }
+
+  TObject      Add( const TBoundingBox &box, TStateKey key ); //!< add an object
+  void         Remove( TObject object );                      //!< remove an object
+  void         Move( TObject object, const TBoundingBox &box ); //!< set the world bounding box of an object
+  void         SetKey( TObject object, TStateKey key );       //!< set the state key of an object
+  TBoundingBox Bounds( TObject object ) const;                //!< world bounding box of an object
+  TStateKey    Key( TObject object ) const;                   //!< state key of an object
+
+  void Update( void );  //!< refit and partially rebuild the tree
+  void Rebuild( void ); //!< rebuild the whole tree
+
+  //! collect the objects inside the frustum, sorted by state key
+  TCullStatistics Cull( const TFrustum &frustum, TVisibleList &visible ) const;
+
+  //! collect the objects inside the frustum and closer to `eye` than `max_distance`, sorted by state key
+  TCullStatistics Cull( const TFrustum &frustum, const TVec3 &eye, float max_distance, TVisibleList &visible ) const;
+
+  //! stable sort of the visible objects by state key
+  static void SortByKey( TVisibleList &visible );
+
+private:
+
+  static constexpr std::uint32_t c_no_node = 0xffffffff;
+
+  struct TNode
+  {
+    std::array<float, 3> _min;
+    std::array<float, 3> _max;
+    std::uint32_t        _first;      //!< first object of the range (position in the order of the tree)
+    std::uint32_t        _count;      //!< number of objects in the range
+    std::uint32_t        _left;       //!< left child; `c_no_node` for a leaf
+    std::uint32_t        _right;      //!< right child
+    std::uint32_t        _parent;     //!< parent node
+    float                _build_area; //!< surface area, when the subtree was built
+    bool                 _dirty;      //!< the leaf has to be refit
+  };
+
+  struct TCullParameters;
+
+  void          Reserve( size_t size );
+  void          SetBox( size_t position, const TBoundingBox &box );
+  void          MarkDirty( size_t position );
+  void          Build( std::uint32_t node, std::uint32_t first, std::uint32_t count, std::uint32_t parent );
+  std::uint32_t NewNode( void );
+  void          RebuildSubtree( std::uint32_t node );
+  size_t        SubtreeSize( std::uint32_t node ) const;
+  bool          Refit( std::uint32_t node );
+
+  TCullStatistics Cull( const TCullParameters &parameters, TVisibleList &visible ) const;
+
+  // objects in the order of the tree (structure of arrays); padded by `c_leaf_size` empty boxes
+  std::vector<float>         _min_x, _min_y, _min_z;
+  std::vector<float>         _max_x, _max_y, _max_z;
+  std::vector<TObject>       _objects;  //!< object handle at a position; `c_no_object` for a removed object
+  std::vector<TStateKey>     _keys;     //!< state key at a position
+  std::vector<std::uint32_t> _leaves;   //!< leaf node at a position
+  std::vector<std::uint32_t> _position; //!< position of an object handle
+  std::vector<TObject>       _free;     //!< free object handles
+
+  std::vector<TNode>         _nodes;            //!< nodes of the tree; the root is node 0
+  std::vector<std::uint32_t> _dirty_leaves;     //!< leaves which have to be refit
+  size_t                     _size          = 0; //!< number of used positions
+  size_t                     _built         = 0; //!< number of positions, which are covered by the tree
+  size_t                     _no_of_objects = 0; //!< number of objects
+  size_t                     _removed       = 0; //!< number of removed objects in the used positions
+  size_t                     _garbage       = 0; //!< number of nodes, which are not used anymore after subtree rebuilds
+  TUpdateStatistics          _statistics;
+};
+
+
+} // Render
+
+#endif // RenderUtil_SceneBVH_h_INCLUDED
@@ -0,0 +1,246 @@
+/******************************************************************//**
+* \brief   Retained text meshes.
+*
+* The glyph quads of texts, which are drawn repeatedly with the same
+* font, height and width scale (labels, HUD, annotations), are laid out
+* once and kept in a region of a shared vertex buffer. A text is
+* identified by a handle; drawing a handle only queues the reference
+* position and the color. When the queue is flushed, the labels are
+* grouped by font, atlas page and color, so that each group can be
+* drawn by a single multi draw call, with the reference position of
+* each label looked up by the draw index in the shader.
+*
+* The buffer is managed by a first fit free list. If it is full, then
+* the least recently used texts are evicted (texts, which are used in
+* the current frame, are never evicted) and the buffer is compacted.
+* If the glyph atlas of a font evicts glyphs, the texts of the font
+* are laid out again, when they are drawn the next time.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_TextMeshCache_h_INCLUDED
+#define RenderUtil_TextMeshCache_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_IFont.h"
+#include "../render/Render_IBuffer.h"
+
+// STL
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//---------------------------------------------------------------------
+// CTextMeshCache
+//---------------------------------------------------------------------
+
+
+using TTextMeshHandle = std::uint64_t;
+const TTextMeshHandle no_text_mesh = 0; //!< invalid handle; the text couldn't be cached
+
+
+/******************************************************************//**
+* \brief Parameters of the text mesh cache.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TTextMeshCacheParameters
+{
+  size_t _capacity{ 65536 };   //!< number of vertices of the shared buffer (6 vertices per glyph)
+  size_t _max_entries{ 4096 }; //!< maximum number of retained texts
+};
+
+
+/******************************************************************//**
+* \brief Labels, which can be drawn by a single multi draw call.
+*
+* All labels of the batch use the same font, atlas page texture and
+* color. Draw `i` renders `_count[i]` vertices starting at `_first[i]`
+* of the shared buffer (`TVA::b0_xyz_uv`), translated by
+* `_offsets[4*i] .. _offsets[4*i+2]` (the 4th component is padding).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TTextMeshBatch
+{
+  IFont       *_font{ nullptr };
+  ITexture    *_texture{ nullptr };
+  TColor       _color{ 0.0f, 0.0f, 0.0f, 0.0f };
+  size_t       _draws{ 0 };
+  const int   *_first{ nullptr };
+  const int   *_count{ nullptr };
+  const float *_offsets{ nullptr };
+};
+
+
+/******************************************************************//**
+* \brief Statistics of the text mesh cache.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TTextMeshStatistics
+{
+  size_t _hits{ 0 };        //!< `Acquire` found a retained text
+  size_t _misses{ 0 };      //!< `Acquire` had to lay out a text
+  size_t _relayouts{ 0 };   //!< texts laid out again, because the glyph atlas changed
+  size_t _skipped{ 0 };     //!< labels not drawn, because the glyph atlas changed again while laying out the texts
+  size_t _evictions{ 0 };   //!< evicted texts
+  size_t _compactions{ 0 }; //!< compactions of the shared buffer
+  size_t _uploads{ 0 };     //!< uploads of the shared buffer
+  size_t _labels{ 0 };      //!< drawn labels
+  size_t _draw_calls{ 0 };  //!< batches passed to the draw callback
+};
+
+
+/******************************************************************//**
+* \brief Cache of text meshes in a shared vertex buffer.
+*
+* The cache refers to the fonts by pointer, so it has to be cleared
+* before a font is destroyed.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CTextMeshCache
+{
+public:
+
+  using TDrawBatch = std::function<void( IDrawBuffer &buffer, const TTextMeshBatch &batch )>;
+
+  CTextMeshCache( IDrawBufferProvider &buffer_provider, const TTextMeshCacheParameters &parameters = TTextMeshCacheParameters() );
+  CTextMeshCache( const CTextMeshCache & ) = delete;
+  CTextMeshCache & operator = ( const CTextMeshCache & ) = delete;
+
+  const TTextMeshCacheParameters & Parameters( void ) const { return _parameters; }
+  const TTextMeshStatistics & Statistics( void ) const { return _statistics; }
+  void ResetStatistics( void ) { _statistics = TTextMeshStatistics(); }
+
+  //! get the handle of a retained text; the text is laid out, if it isn't cached; `no_text_mesh` if the font doesn't support layouts or the buffer is full
+  TTextMeshHandle Acquire( IFont &font, t_s_param str, float height, float width_scale );
+
+  //! queue a retained text for drawing; false if the handle is invalid or the text was evicted
+  bool Draw( TTextMeshHandle handle, const TPoint3 &pos, const TColor &color );
+
+  //! number of queued labels
+  size_t Queued( void ) const { return _queue.size(); }
+
+  //! upload the modified vertices and draw the queued labels, batched by font, page and color; ends the frame
+  void Flush( const TDrawBatch &draw_batch );
+
+  //! remove all texts
+  void Clear( void );
+
+  size_t Entries( void ) const { return _entries.size(); } //!< number of retained texts
+  size_t UsedVertices( void ) const { return _used; }       //!< number of vertices in use
+
+private:
+
+  //! identity of a text
+  struct TKey
+  {
+    IFont       *_font;
+    std::string  _text;
+    float        _height;
+    float        _width_scale;
+
+    bool operator < ( const TKey &other ) const
+    {
+      return std::tie( _font, _height, _width_scale, _text ) < std::tie( other._font, other._height, other._width_scale, other._text );
+    }
+  };
+
+  //! retained text
+  struct TEntry
+  {
+    TKey                                 _key;
+    size_t                               _offset{ 0 };   //!< first vertex in the shared buffer
+    size_t                               _size{ 0 };     //!< number of vertices
+    std::vector<size_t>                  _page_start;    //!< first vertex of each page, relative to `_offset`, and the number of vertices at the end
+    std::vector<ITexture*>               _textures;      //!< texture of each page
+    std::uint64_t                        _revision{ 0 }; //!< revision of the font glyphs
+    std::uint64_t                        _last_use{ 0 }; //!< frame of the last use
+    std::list<TTextMeshHandle>::iterator _lru;
+  };
+
+  //! queued label
+  struct TQueued
+  {
+    TTextMeshHandle _handle;
+    TPoint3         _pos;
+    TColor          _color;
+  };
+
+  //! draw of a page of a queued label
+  struct TPageDraw
+  {
+    IFont    *_font;
+    ITexture *_texture;
+    TColor    _color;
+    int       _first;
+    int       _count;
+    TPoint3   _pos;
+  };
+
+  bool Store( TEntry &entry, const TTextLayout &layout );
+  bool Allocate( size_t size, size_t &offset );
+  void Free( size_t offset, size_t size );
+  bool EvictLeastRecentlyUsed( void );
+  void Erase( TTextMeshHandle handle );
+  void Compact( void );
+  void Touch( TEntry &entry );
+
+  IDrawBufferProvider                          &_buffer_provider;
+  TTextMeshCacheParameters                      _parameters;
+  TTextMeshStatistics                           _statistics;
+  IDrawBufferPtr                                _buffer;
+  std::vector<float>                            _vertices;        //!< CPU copy of the shared buffer; x y z u v
+  std::map<size_t, size_t>                      _free;            //!< free ranges of the shared buffer; first vertex -> number of vertices
+  size_t                                        _used{ 0 };
+  bool                                          _dirty{ false };
+  std::unordered_map<TTextMeshHandle, TEntry>   _entries;
+  std::map<TKey, TTextMeshHandle>               _handles;
+  std::list<TTextMeshHandle>                    _lru;             //!< most recently used first
+  std::vector<TQueued>                          _queue;
+  std::vector<TPageDraw>                        _page_draws;      //!< draws of the flushed labels
+  std::vector<int>                              _first;           //!< first vertices of the batches
+  std::vector<int>                              _count;           //!< number of vertices of the batches
+  std::vector<float>                            _offsets;         //!< reference positions of the batches; x y z 0
+  TTextLayout                                   _layout;          //!< layout of a new text
+  TTextMeshHandle                               _next_handle{ 1 };
+  std::uint64_t                                 _frame{ 1 };
+};
+
+
+} // Render
+
+#endif // RenderUtil_TextMeshCache_h_INCLUDED
@@ -0,0 +1,261 @@
+/******************************************************************//**
+* \brief   KTX2 and DDS texture container reader and writer.
+*
+* The container file is memory mapped and each mipmap level and layer
+* is exposed as an `IImageResource`, which directly refers to the
+* mapped file data (zero-copy), including the compressed formats.
+* The levels can be loaded to a texture individually, e.g. the coarse
+* levels first and the finer levels later (`CTextureStreamer`).
+*
+* See [KTX File Format Specification 2.0](https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html)
+* and [DDS - Programming Guide for DDS](https://learn.microsoft.com/en-us/windows/win32/direct3ddds/dx-graphics-dds-pguide)
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_TextureContainer_h_INCLUDED
+#define RenderUtil_TextureContainer_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_ITexture.h"
+
+// STL
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//---------------------------------------------------------------------
+// CMappedFile
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Read only memory mapped file.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CMappedFile
+{
+public:
+
+  CMappedFile( void ) = default;
+  CMappedFile( const CMappedFile & ) = delete;
+  CMappedFile & operator = ( const CMappedFile & ) = delete;
+  ~CMappedFile();
+
+  bool Open( const std::string &filename ); //!< map the complete file
+  void Close( void );                        //!< unmap the file
+
+  bool           IsOpen( void ) const { return _data != nullptr; }
+  const t_byte * Data( void )   const { return _data; }
+  size_t         Size( void )   const { return _size; }
+
+private:
+
+  const t_byte *_data{ nullptr };
+  size_t        _size{ 0 };
+  void         *_file_handle{ nullptr };    //!< file handle (Windows)
+  void         *_mapping_handle{ nullptr }; //!< file mapping handle (Windows)
+};
+
+
+//---------------------------------------------------------------------
+// CTextureContainer
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Type of the texture container file.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+enum class TTextureContainerType : t_byte
+{
+  NON,
+  KTX2,
+  DDS
+};
+
+
+/******************************************************************//**
+* \brief Image resource view of a single level and layer of a texture
+* container. The view doesn't own the data.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CTextureContainerImage
+  : public IImageResource
+{
+public:
+
+  CTextureContainerImage( void ) = default;
+  CTextureContainerImage( TImageKind kind, TImageFormat format, size_t cx, size_t cy, const t_byte *data )
+    : _kind( kind )
+    , _format( format )
+    , _cx( cx )
+    , _cy( cy )
+    , _data( data )
+  {}
+
+  virtual TImageKind   Kind( void )      const override { return _kind; }
+  virtual TTextureType Type( void )      const override { return TTextureType::T2D; }
+  virtual TImageFormat Format( void )    const override { return _format; }
+  virtual TTextureSize Size( void )      const override { return { _cx, _cy, 1 }; }
+  virtual size_t       Layers( void )    const override { return 1; }
+  virtual size_t       BPL( void )       const override { return CompressedBlockSize( _format ) > 0 ? ((_cx + 3) / 4) * CompressedBlockSize( _format ) : _cx * ImageTexelSize( _format ); }
+  virtual size_t       LineAlign( void ) const override { return 1; }
+  virtual const void * DataPtr( void )   const override { return _data; }
+
+  size_t DataSize( void ) const { return ImageDataSize( _format, _cx, _cy ); }
+
+private:
+
+  TImageKind    _kind{ TImageKind::diffuse };
+  TImageFormat  _format{ TImageFormat::UNKNOWN };
+  size_t        _cx{ 0 };
+  size_t        _cy{ 0 };
+  const t_byte *_data{ nullptr };
+};
+
+
+/******************************************************************//**
+* \brief Memory mapped KTX2 or DDS texture container.
+*
+* Supported are 2 dimensional textures, texture arrays and cube maps
+* with 8 bit uncompressed or BC1, BC3, BC4, BC5, BC7 compressed
+* formats, without supercompression.
+* The faces of a cube map are handled like layers
+* (layer index = array layer * faces + face).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CTextureContainer
+{
+public:
+
+  //! images of the levels of all layers; [layer][level]
+  using TLayerImages = std::vector<std::vector<const IImageResource*>>;
+
+  CTextureContainer( void ) = default;
+  CTextureContainer( const CTextureContainer & ) = delete;
+  CTextureContainer & operator = ( const CTextureContainer & ) = delete;
+
+  //! map the file and read the level index
+  bool Open( const std::string &filename, TImageKind kind = TImageKind::diffuse );
+  void Close( void );
+
+  TTextureContainerType ContainerType( void ) const { return _type; }
+  TImageFormat          Format( void )        const { return _format; }
+  TTextureSize          Size( void )          const { return { _cx, _cy, 1 }; }
+  size_t                Levels( void )        const { return _levels; }
+  size_t                Layers( void )        const { return _layers; }
+  size_t                Faces( void )         const { return _faces; }
+  bool                  IsSRGB( void )        const { return _srgb; }
+
+  //! zero-copy view of a level of a layer
+  const CTextureContainerImage & Image( size_t level, size_t layer = 0 ) const { return _images[layer * _levels + level]; }
+
+  //! zero-copy views of all levels of a layer, starting at level 0
+  std::vector<const IImageResource*> MipChain( size_t layer = 0 ) const;
+
+  //! write a KTX2 file
+  static bool WriteKTX2( const std::string &filename, const TLayerImages &images, bool srgb = false, size_t faces = 1 );
+
+  //! write a DDS file
+  static bool WriteDDS( const std::string &filename, const TLayerImages &images, bool srgb = false, size_t faces = 1 );
+
+private:
+
+  bool ReadKTX2( TImageKind kind );
+  bool ReadDDS( TImageKind kind );
+
+  CMappedFile                         _file;
+  TTextureContainerType               _type{ TTextureContainerType::NON };
+  TImageFormat                        _format{ TImageFormat::UNKNOWN };
+  bool                                _srgb{ false };
+  size_t                              _cx{ 0 };
+  size_t                              _cy{ 0 };
+  size_t                              _levels{ 0 };
+  size_t                              _layers{ 0 };
+  size_t                              _faces{ 1 };
+  std::vector<CTextureContainerImage> _images; //!< [layer * levels + level]
+};
+
+
+//---------------------------------------------------------------------
+// CTextureStreamer
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Load the levels of a texture container to a texture,
+* starting with the coarsest levels.
+*
+* The texture is created with all levels allocated. The base level
+* of the texture is lowered, each time a finer level has been loaded.
+* The container has to outlive the streamer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CTextureStreamer
+{
+public:
+
+  CTextureStreamer( ITextureLoader &loader, const CTextureContainer &container, size_t layer = 0 )
+    : _loader( loader )
+    , _container( container )
+    , _layer( layer )
+  {}
+
+  //! create the texture and load the `coarse_levels` coarsest levels; the texture format has to match the container format
+  ITexturePtr Create( const TTextureParameters &parameter, size_t coarse_levels );
+
+  //! load the next finer level; returns false, if all levels have been loaded
+  bool StreamNext( ITexture &texture );
+
+  //! true: all levels have been loaded
+  bool Complete( void ) const { return _base_level == 0; }
+
+  //! finest level, which has been loaded
+  size_t BaseLevel( void ) const { return _base_level; }
+
+private:
+
+  ITextureLoader          &_loader;
+  const CTextureContainer &_container;
+  size_t                   _layer{ 0 };
+  size_t                   _levels{ 0 };
+  size_t                   _base_level{ 0 }; //!< finest level, which has been loaded
+};
+
+
+} // Render
+
+#endif // RenderUtil_TextureContainer_h_INCLUDED
@@ -0,0 +1,251 @@
+/******************************************************************//**
+* \brief   Triangulation of polygons with holes.
+*
+* The polygons are triangulated on the CPU by ear clipping, so that
+* concave polygons can be drawn as a single indexed triangle mesh,
+* without the stencil buffer technique.
+* The contours are doubly linked lists. An ear is cut if no reflex
+* vertex is inside of it. For polygons with more than 80 vertices the
+* vertices are additionally linked in z-order (Morton code of the
+* 16 bit quantized coordinates), so that only the vertices in the bounding box of an ear
+* have to be tested. The holes are merged into the outer contour by
+* bridges. If no ear can be found, then the collinear and duplicate
+* vertices are filtered, local self intersections are cured and finally
+* the polygon is split by a valid diagonal, so that self-touching and
+* degenerated contours are triangulated, too.
+* (The algorithm follows "earcut" by Mapbox, ISC license.)
+*
+* Triangulations are cached by a hash of the polygon content, so that
+* a static polygon is triangulated only once.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+#pragma once
+#ifndef RenderUtil_Triangulation_h_INCLUDED
+#define RenderUtil_Triangulation_h_INCLUDED
+
+
+// includes
+
+#include "../render/Render_IBuffer.h"
+
+// STL
+
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+//---------------------------------------------------------------------
+// CPolygonTriangulator
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Ear clipping triangulation of polygons with holes.
+*
+* The coordinates are tuples of 2, 3 or 4 components. The polygon is
+* triangulated in the xy plane. The first contour is the outer contour,
+* the following contours are holes. The orientation of the contours
+* doesn't matter.
+*
+* The object keeps its node storage for the next triangulation, so it
+* is not thread safe, but can be used by one thread per object.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CPolygonTriangulator
+{
+public:
+
+  //! triangulate a polygon; `contour_sizes` are the number of vertices of each contour, if `no_of_contours == 0` then all the vertices form one contour; returns the number of triangles
+  size_t Triangulate( unsigned int tuple_size, size_t coords_size, const float *coords, size_t no_of_contours, const size_t *contour_sizes, std::vector<std::uint32_t> &indices );
+  size_t Triangulate( unsigned int tuple_size, size_t coords_size, const double *coords, size_t no_of_contours, const size_t *contour_sizes, std::vector<std::uint32_t> &indices );
+
+private:
+
+  //! vertex of a contour
+  struct TNode
+  {
+    std::uint32_t _i;                 //!< index of the vertex
+    double        _x;
+    double        _y;
+    TNode        *_prev{ nullptr };   //!< previous vertex of the contour
+    TNode        *_next{ nullptr };   //!< next vertex of the contour
+    std::uint32_t _z{ 0 };            //!< z-order of the vertex
+    TNode        *_prev_z{ nullptr }; //!< previous vertex in z-order
+    TNode        *_next_z{ nullptr }; //!< next vertex in z-order
+    bool          _steiner{ false };  //!< the vertex is a hole with a single vertex
+  };
+
+  template <typename T>
+  size_t TriangulateT( unsigned int tuple_size, size_t coords_size, const T *coords, size_t no_of_contours, const size_t *contour_sizes, std::vector<std::uint32_t> &indices );
+
+  template <typename T>
+  TNode * LinkedList( unsigned int tuple_size, const T *coords, size_t start, size_t end, bool clockwise );
+
+  TNode * InsertNode( std::uint32_t i, double x, double y, TNode *last );
+  TNode * FilterPoints( TNode *start, TNode *end = nullptr );
+  void    EarcutLinked( TNode *ear, int pass );
+  bool    IsEar( const TNode *ear ) const;
+  bool    IsEarHashed( const TNode *ear ) const;
+  TNode * CureLocalIntersections( TNode *start );
+  void    SplitEarcut( TNode *start );
+  TNode * EliminateHole( TNode *hole, TNode *outer_node );
+  TNode * FindHoleBridge( TNode *hole, TNode *outer_node ) const;
+  void    IndexCurve( TNode *start );
+  void    SortLinked( TNode *list );
+  std::uint32_t ZOrder( double x, double y ) const;
+  bool    IsValidDiagonal( const TNode *a, const TNode *b ) const;
+  bool    IntersectsPolygon( const TNode *a, const TNode *b ) const;
+  bool    MiddleInside( const TNode *a, const TNode *b ) const;
+  TNode * SplitPolygon( TNode *a, TNode *b );
+  void    RemoveNode( TNode *p ) const;
+  void    AddTriangle( const TNode *a, const TNode *b, const TNode *c );
+
+  std::deque<TNode>                             _nodes;              //!< node storage; a deque keeps the addresses stable
+  std::vector<TNode*>                           _holes;              //!< leftmost vertices of the holes
+  std::vector<std::pair<std::uint32_t, TNode*>> _z_order;            //!< z-order values and vertices, for sorting
+  std::vector<std::uint32_t>                   *_indices{ nullptr }; //!< output of the current triangulation
+  double                                        _min_x{ 0.0 };       //!< origin of the z-order
+  double                                        _min_y{ 0.0 };
+  double                                        _inv_size{ 0.0 };    //!< scale of the z-order; 0 means no z-order hashing
+};
+
+
+//---------------------------------------------------------------------
+// CTriangulationCache
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Cached triangulation of a polygon.
+*
+* `_buffer` is free for the renderer, to retain a draw buffer with the
+* vertices and indices of the polygon; it is released together with
+* the cache entry.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TTriangulation
+{
+  std::uint64_t              _hash{ 0 };          //!< content hash of the polygon
+  size_t                     _vertices{ 0 };      //!< number of vertices of the polygon
+  unsigned int               _tuple_size{ 0 };    //!< kind of the coordinates
+  size_t                     _coord_size{ 0 };    //!< size of a coordinate (`float` or `double`)
+  std::vector<char>          _coords;             //!< copy of the coordinates, which verifies a cache hit
+  std::vector<size_t>        _contour_sizes;      //!< number of vertices of each contour
+  std::vector<std::uint32_t> _indices;            //!< 3 indices per triangle
+  IDrawBufferPtr             _buffer;             //!< retained draw buffer of the renderer
+};
+using TTriangulationPtr = std::shared_ptr<TTriangulation>;
+
+
+/******************************************************************//**
+* \brief Parameters of the triangulation cache.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TTriangulationCacheParameters
+{
+  size_t _max_entries{ 256 };      //!< maximum number of cached polygons
+  size_t _max_indices{ 1 << 24 };  //!< maximum number of cached indices of all the polygons
+};
+
+
+/******************************************************************//**
+* \brief Statistics of the triangulation cache.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct TTriangulationStatistics
+{
+  size_t _hits{ 0 };           //!< polygons found in the cache
+  size_t _misses{ 0 };         //!< polygons, which had to be triangulated
+  size_t _evictions{ 0 };      //!< evicted polygons
+  size_t _triangles{ 0 };      //!< triangles generated by triangulations
+};
+
+
+/******************************************************************//**
+* \brief Cache of polygon triangulations, keyed by a hash of the
+* polygon content (coordinates and contour sizes).
+*
+* The least recently used polygons are evicted, when the number of
+* polygons or indices exceeds the limits.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CTriangulationCache
+{
+public:
+
+  CTriangulationCache( const TTriangulationCacheParameters &parameters = TTriangulationCacheParameters() );
+  CTriangulationCache( const CTriangulationCache & ) = delete;
+  CTriangulationCache & operator = ( const CTriangulationCache & ) = delete;
+
+  const TTriangulationCacheParameters & Parameters( void ) const { return _parameters; }
+  const TTriangulationStatistics & Statistics( void ) const { return _statistics; }
+  void ResetStatistics( void ) { _statistics = TTriangulationStatistics(); }
+
+  //! content hash of a polygon
+  static std::uint64_t Hash( unsigned int tuple_size, size_t coords_size, const float *coords, size_t no_of_contours, const size_t *contour_sizes );
+  static std::uint64_t Hash( unsigned int tuple_size, size_t coords_size, const double *coords, size_t no_of_contours, const size_t *contour_sizes );
+
+  //! get the triangulation of a polygon; the polygon is triangulated if it isn't cached
+  TTriangulationPtr Get( unsigned int tuple_size, size_t coords_size, const float *coords, size_t no_of_contours = 0, const size_t *contour_sizes = nullptr );
+  TTriangulationPtr Get( unsigned int tuple_size, size_t coords_size, const double *coords, size_t no_of_contours = 0, const size_t *contour_sizes = nullptr );
+
+  //! remove all the triangulations
+  void Clear( void );
+
+  size_t Entries( void ) const { return _entries.size(); } //!< number of cached polygons
+  size_t Indices( void ) const { return _indices; }        //!< number of cached indices
+
+private:
+
+  template <typename T>
+  TTriangulationPtr GetT( unsigned int tuple_size, size_t coords_size, const T *coords, size_t no_of_contours, const size_t *contour_sizes );
+
+  using TLRU = std::list<std::uint64_t>;
+  using TEntry = std::pair<TTriangulationPtr, TLRU::iterator>;
+
+  TTriangulationCacheParameters                _parameters;
+  TTriangulationStatistics                     _statistics;
+  CPolygonTriangulator                         _triangulator;
+  std::unordered_map<std::uint64_t, TEntry>    _entries;
+  TLRU                                         _lru;           //!< most recently used first
+  size_t                                       _indices{ 0 };
+};
+
+
+} // Render
+
+#endif // RenderUtil_Triangulation_h_INCLUDED
@@ -15,8 +15,9 @@
 
 #include "../../include/OpenGL/OpenGLBasicDraw.h"
 #include "../../include/OpenGL/OpenGLVertexBuffer.h"
-#include "../../include/OpenGL/OpenGLFrameBuffer.h"
+#include "../../include/OpenGL/OpenGLFramebuffer.h"
 #include "../../include/OpenGL/OpenGLTextureLoader.h"
+#include "../../include/OpenGL/OpenGLStateCache.h"
 
 
 // OpenGL wrapper
@@ -27,6 +28,7 @@
 // utility 
 
 #include "../../include/util/RenderUtil_FreetypeFont.h"
+#include "../../include/util/RenderUtil_TextMeshCache.h"
 
 
 // STL
@@ -48,6 +50,26 @@ std::set<std::string> CBasicDraw::_ogl_extensins;
 int                   CBasicDraw::_max_anistropic_texture_filter = 0;
 
 
+namespace
+{
+
+
+// uniform names; the hash codes are computed at compile time
+
+constexpr TUniformName c_u_color{ "u_color" };
+constexpr TUniformName c_u_no_of_samples{ "u_no_of_samples" };
+constexpr TUniformName c_u_perspective_thickness{ "u_perspective_thickness" };
+constexpr TUniformName c_u_thickness{ "u_thickness" };
+constexpr TUniformName c_u_glyph_type{ "u_glyph_type" };
+constexpr TUniformName c_u_text_effect{ "u_text_effect" };
+constexpr TUniformName c_u_outline_color{ "u_outline_color" };
+constexpr TUniformName c_u_glow_color{ "u_glow_color" };
+constexpr TUniformName c_u_text_batch{ "u_text_batch" };
+
+
+} // anonymous namespace
+
+
 /******************************************************************//**
 * \class OpenGL::CBasicDraw  
 *
@@ -87,9 +109,20 @@ layout(std430, binding = 1) buffer TUniform
     vec2 u_vp_size;
 };
 
+layout(std430, binding = 2) buffer TTextOffsets
+{
+    vec4 u_text_offset[];
+};
+
+uniform int u_text_batch;
+
 void main()
 {
-    vec4 view_pos = u_view * u_model * in_pos; 
+    vec4 pos = in_pos;
+    if ( u_text_batch != 0 )
+        pos.xyz += u_text_offset[gl_DrawID].xyz;
+
+    vec4 view_pos = u_view * u_model * pos; 
     out_data.pos  = view_pos.xyz / view_pos.w;
     out_data.tex  = in_tex;
     gl_Position   = u_proj * view_pos;
@@ -220,12 +253,55 @@ out vec4 frag_color;
 
 uniform vec4 u_color;
 
+// text glyphs; x: distance range of the glyph images in texels, y: outline width, z: glow width
+uniform int  u_glyph_type; // 0: color texture, 1: signed distance field, 2: multi-channel signed distance field
+uniform vec4 u_text_effect;
+uniform vec4 u_outline_color;
+uniform vec4 u_glow_color;
+
 layout (binding = 0) uniform sampler2D u_sampler_texture;
 
+float Median(vec3 c)
+{
+    return max(min(c.r, c.g), min(max(c.r, c.g), c.b));
+}
+
+vec4 Premultiplied(vec4 c)
+{
+    return vec4(c.rgb * c.a, c.a);
+}
+
+vec4 TextureColor(vec2 uv)
+{
+    vec4 col_texture = texture(u_sampler_texture, uv); 
+    if (u_glyph_type == 0)
+        return u_color * col_texture;
+
+    // Multi-channel signed distance field generator [https://github.com/Chlumsky/msdfgen]
+    vec2  unit_range = vec2(u_text_effect.x) / vec2(textureSize(u_sampler_texture, 0));
+    vec2  screen_tex = vec2(1.0) / fwidth(uv);
+    float px_range   = max(0.5 * dot(unit_range, screen_tex), 1.0);
+    float dist       = u_glyph_type == 2 ? Median(col_texture.rgb) : col_texture.a;
+    float fill       = clamp(px_range * (dist - 0.5) + 0.5, 0.0, 1.0);
+    vec4  color      = u_color * fill;
+
+    // the outline and the glow are composited behind the fill, with premultiplied alpha
+    if (u_text_effect.y > 0.0)
+    {
+        float outline = clamp(px_range * (col_texture.a - 0.5 + 0.5 * u_text_effect.y) + 0.5, 0.0, 1.0);
+        color += Premultiplied(u_outline_color) * outline * (1.0 - color.a);
+    }
+    if (u_text_effect.z > 0.0)
+    {
+        float glow = smoothstep(0.5 - 0.5 * u_text_effect.z, 0.5, col_texture.a);
+        color += Premultiplied(u_glow_color) * glow * (1.0 - color.a);
+    }
+    return color;
+}
+
 void main()
 {
-    vec4 col_texture  = texture(u_sampler_texture, in_data.tex.st); 
-    vec4 col_modulate = u_color * col_texture;
+    vec4 col_modulate = TextureColor(in_data.tex.st);
     frag_color        = col_modulate;
 }
 )";
@@ -245,12 +321,55 @@ layout (location = 1) out vec4 transp_attrib;
 
 uniform vec4 u_color;
 
+// text glyphs; x: distance range of the glyph images in texels, y: outline width, z: glow width
+uniform int  u_glyph_type; // 0: color texture, 1: signed distance field, 2: multi-channel signed distance field
+uniform vec4 u_text_effect;
+uniform vec4 u_outline_color;
+uniform vec4 u_glow_color;
+
 layout (binding = 0) uniform sampler2D u_sampler_texture;
 
+float Median(vec3 c)
+{
+    return max(min(c.r, c.g), min(max(c.r, c.g), c.b));
+}
+
+vec4 Premultiplied(vec4 c)
+{
+    return vec4(c.rgb * c.a, c.a);
+}
+
+vec4 TextureColor(vec2 uv)
+{
+    vec4 col_texture = texture(u_sampler_texture, uv); 
+    if (u_glyph_type == 0)
+        return u_color * col_texture;
+
+    // Multi-channel signed distance field generator [https://github.com/Chlumsky/msdfgen]
+    vec2  unit_range = vec2(u_text_effect.x) / vec2(textureSize(u_sampler_texture, 0));
+    vec2  screen_tex = vec2(1.0) / fwidth(uv);
+    float px_range   = max(0.5 * dot(unit_range, screen_tex), 1.0);
+    float dist       = u_glyph_type == 2 ? Median(col_texture.rgb) : col_texture.a;
+    float fill       = clamp(px_range * (dist - 0.5) + 0.5, 0.0, 1.0);
+    vec4  color      = u_color * fill;
+
+    // the outline and the glow are composited behind the fill, with premultiplied alpha
+    if (u_text_effect.y > 0.0)
+    {
+        float outline = clamp(px_range * (col_texture.a - 0.5 + 0.5 * u_text_effect.y) + 0.5, 0.0, 1.0);
+        color += Premultiplied(u_outline_color) * outline * (1.0 - color.a);
+    }
+    if (u_text_effect.z > 0.0)
+    {
+        float glow = smoothstep(0.5 - 0.5 * u_text_effect.z, 0.5, col_texture.a);
+        color += Premultiplied(u_glow_color) * glow * (1.0 - color.a);
+    }
+    return color;
+}
+
 void main()
 {                      
-    vec4 col_texture  = texture(u_sampler_texture, in_data.tex.st); 
-    vec4 col_modulate = u_color * col_texture;
+    vec4 col_modulate = TextureColor(in_data.tex.st);
 
     float weight      = col_modulate.a * (1.0 - gl_FragCoord.z);
     transp_color      = vec4(col_modulate.rgb * weight, weight);
@@ -731,6 +850,7 @@ public:
   virtual bool DrawSequence( double x, double y, double z ) override { assert(false); return false; }
   virtual bool DrawSequence( size_t coords_size, const float *coords ) override { assert(false); return false; }
   virtual bool DrawSequence( size_t coords_size, const double *coords ) override { assert(false); return false; }
+  virtual std::span<float> MapSequence( size_t coords_size ) override { assert(false); return {}; }
 
 private:
 
@@ -1121,6 +1241,7 @@ void CBasicDraw::Destroy( void )
   _opaque_prog.reset( nullptr );
   _transp_prog.reset( nullptr );
   _mixcol_prog.reset( nullptr );
+  _gpu_profiler.reset( nullptr );
 
   for ( auto & buffer : _draw_buffers )
     buffer.reset( nullptr );
@@ -1131,7 +1252,7 @@ void CBasicDraw::Destroy( void )
 
   if ( _color_texture != 0 )
   {
-    glDeleteTextures( 1, &_color_texture );
+    CStateCache::Current().DeleteTextures( 1, &_color_texture );
     OPENGL_CHECK_GL_ERROR
     _color_texture = 0;
   }
@@ -1143,7 +1264,17 @@ void CBasicDraw::Destroy( void )
     _uniform_ssbo = 0;
   }
 
+  if ( _text_offset_ssbo != 0 )
+  {
+    glDeleteBuffers( 1, &_text_offset_ssbo );
+    OPENGL_CHECK_GL_ERROR
+    _text_offset_ssbo = 0;
+  }
+
+  // the text meshes refer to the fonts
+  _text_meshes.reset( nullptr );
   _fonts.clear();
+  _font_loader.reset( nullptr );
 }
 
 
@@ -1195,9 +1326,18 @@ bool CBasicDraw::LoadFont(
   Render::IFont *newFont = nullptr;
   try
   {
-    newFont = new Render::CFreetypeTexturedFont( font_finename.c_str(), min_char );
-    auto loader = NewTextureLoader();
-    newFont->Load( *loader.get() );
+    // the glyphs are loaded on demand, so the fonts keep the texture loader
+    if ( _font_loader == nullptr )
+      _font_loader = NewTextureLoader();
+    // the outline fonts use multi-channel distance fields, so that a single atlas serves all text sizes
+    Render::TFreetypeFontParameters parameters;
+    if ( font_id != font_pixslim_2 )
+    {
+      parameters._glyph_image  = Render::TGlyphImageType::msdf;
+      parameters._pixel_height = 32;
+    }
+    newFont = new Render::CFreetypeTexturedFont( font_finename.c_str(), min_char, parameters );
+    newFont->Load( *_font_loader.get() );
     _fonts[font_id].reset( newFont );
   }
   catch (...)
@@ -1322,9 +1462,8 @@ bool CBasicDraw::Init( void )
   {}
 
   // setup color texture
-  glActiveTexture( GL_TEXTURE0 );
   glGenTextures( 1, &_color_texture );
-  glBindTexture( GL_TEXTURE_2D, _color_texture );      
+  CStateCache::Current().BindTexture( 0, GL_TEXTURE_2D, _color_texture );
   glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
   glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
   glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
@@ -1333,7 +1472,7 @@ bool CBasicDraw::Init( void )
   unsigned char white[]{ 255, 255, 255, 255 };
   glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white );
 
-  glBindTexture( GL_TEXTURE_2D, 0 );  
+  CStateCache::Current().BindTexture( 0, GL_TEXTURE_2D, 0 );
   OPENGL_CHECK_GL_ERROR
 
   // setup shader storage buffer
@@ -1343,6 +1482,14 @@ bool CBasicDraw::Init( void )
   glBindBufferBase( GL_SHADER_STORAGE_BUFFER, 1, _uniform_ssbo );
   glBindBuffer( GL_SHADER_STORAGE_BUFFER, 0 );
 
+  // setup shader storage buffer for the reference positions of the batched text meshes
+  std::array<float, 4> no_offset{ 0.0f };
+  glGenBuffers( 1, &_text_offset_ssbo );
+  glBindBuffer( GL_SHADER_STORAGE_BUFFER, _text_offset_ssbo );
+  glBufferData( GL_SHADER_STORAGE_BUFFER, sizeof(no_offset), no_offset.data(), GL_STREAM_DRAW );
+  glBindBufferBase( GL_SHADER_STORAGE_BUFFER, 2, _text_offset_ssbo );
+  glBindBuffer( GL_SHADER_STORAGE_BUFFER, 0 );
+
   // TODO $$$ uniform block model, view, projection
   
   _initialized = true;
@@ -1479,7 +1626,7 @@ bool CBasicDraw::UpdateColorUniforms(
   if ( _current_prog == nullptr )
     return false;
  
-  _current_prog->SetUniformF4( "u_color", color );
+  _current_prog->SetUniformF4( c_u_color, color );
   return true;
 }
 
@@ -1603,6 +1750,17 @@ bool CBasicDraw::Begin( void )
     return false;
   }
 
+  // the OpenGL state may have been changed outside of the frame
+  CStateCache::Current().NewFrame();
+  CStateCache::Current().Invalidate();
+
+  // profile the passes; the GPU queries are created once the profiler is enabled
+  if ( _gpu_profiler == nullptr && Render::CProfiler::Enabled() )
+    _gpu_profiler = std::make_unique<CGpuProfiler>();
+  if ( _gpu_profiler != nullptr )
+    _gpu_profiler->BeginFrame();
+  BeginPassScope( "CBasicDraw::Begin" );
+
   // specify render process
   SpecifyRenderProcess();
   _process->PrepareClear( c_opaque_pass );
@@ -1638,6 +1796,11 @@ bool CBasicDraw::ActivateBackground( void )
     return false;
   }
 
+  // draw the queued text meshes of the previous pass
+  FlushText();
+
+  BeginPassScope( "CBasicDraw::ActivateBackground" );
+
   // activate pass
   _current_pass = c_back_pass;
   _process->PrepareNoClear( _current_pass );
@@ -1646,8 +1809,7 @@ bool CBasicDraw::ActivateBackground( void )
   _current_prog = _opaque_prog.get();
   _current_prog->Use();
   
-  // set uniforms
-  _unifroms_valid = false;
+  // set uniforms; the storage buffer is shared by all the programs, it is only updated if the uniforms have changed
   UpdateGeneralUniforms();
 
   // disable multisampling
@@ -1672,6 +1834,11 @@ bool CBasicDraw::ActivateOpaque( void )
     return false;
   }
 
+  // draw the queued text meshes of the previous pass
+  FlushText();
+
+  BeginPassScope( "CBasicDraw::ActivateOpaque" );
+
   // activate pass
   _current_pass = c_opaque_pass;
   _process->PrepareNoClear( _current_pass );
@@ -1680,10 +1847,8 @@ bool CBasicDraw::ActivateOpaque( void )
   // activate shader
   _current_prog = _opaque_prog.get();
   _current_prog->Use();
-  _unifroms_valid = false;
 
-  // set uniforms
-  _unifroms_valid = false;
+  // set uniforms; the storage buffer is shared by all the programs, it is only updated if the uniforms have changed
   UpdateGeneralUniforms();
 
   // enable multisampling
@@ -1708,6 +1873,11 @@ bool CBasicDraw::ActivateTransparent( void )
     return false;
   }
 
+  // draw the queued text meshes of the previous pass
+  FlushText();
+
+  BeginPassScope( "CBasicDraw::ActivateTransparent" );
+
   // activate pass
   _current_pass = c_tranp_pass;
   _process->PrepareNoClear( _current_pass );
@@ -1715,10 +1885,8 @@ bool CBasicDraw::ActivateTransparent( void )
   // activate shader
   _current_prog = _transp_prog.get();
   _current_prog->Use();
-  _unifroms_valid = false;
 
-  // set uniforms
-  _unifroms_valid = false;
+  // set uniforms; the storage buffer is shared by all the programs, it is only updated if the uniforms have changed
   UpdateGeneralUniforms();
 
   // enable multisampling
@@ -1745,31 +1913,67 @@ bool CBasicDraw::Finish( void )
     return false;
   }
 
+  // draw the queued text meshes of the last pass
+  FlushText();
+
   // disable multisampling
   EnableMultisample( false );
 
   // mix opaque and transparent color
+  BeginPassScope( "CBasicDraw::Finish mix" );
   _process->PrepareNoClear( c_mixcol_pass );
   _mixcol_prog->Use();
   if ( Multisample() )
-    _mixcol_prog->SetUniformI1( "u_no_of_samples", _samples );
+    _mixcol_prog->SetUniformI1( c_u_no_of_samples, _samples );
   DrawScereenspace();
-  glUseProgram( 0 );
+  CStateCache::Current().UseProgram( 0 );
   OPENGL_CHECK_GL_ERROR
 
+  // the depth buffer, the opaque and the transparent color buffers are not required anymore
+  _process->Discard( c_tranp_pass );
+  _process->Discard( c_mixcol_pass );
+
   // finish pass (FXAA)
+  BeginPassScope( "CBasicDraw::Finish FXAA" );
   _process->PrepareNoClear( c_finish_pass );
   _finish_prog->Use();
   DrawScereenspace();
-  glUseProgram( 0 );
+  CStateCache::Current().UseProgram( 0 );
   OPENGL_CHECK_GL_ERROR
 
+  // the mixed color buffer is not required anymore
+  _process->Discard( c_finish_pass );
+
+  _pass_scope.Stop();
+  if ( _gpu_profiler != nullptr )
+    _gpu_profiler->EndFrame();
+
   _current_pass = 0;
   _drawing      = false;
   return true;
 }
 
 
+/******************************************************************//**
+* \brief   End the CPU and GPU scopes of the previous pass and begin
+* the scopes of a new pass.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CBasicDraw::BeginPassScope(
+  const char *name ) //!< in: name of the pass (string literal)
+{
+  _pass_scope.Start( name );
+  if ( _gpu_profiler != nullptr )
+  {
+    _gpu_profiler->End();
+    _gpu_profiler->Begin( name );
+  }
+}
+
+
 /******************************************************************//**
 * \brief   Interim clear of the depth buffer.
 * 
@@ -1857,12 +2061,11 @@ bool CBasicDraw::SetLineShader(
   // set uniforms
   UpdateGeneralUniforms();
   UpdateColorUniforms( color );
-  _current_prog->SetUniformI1( "u_perspective_thickness", _draw_properties[(int)TDrawProperty::perspective_line] ? 1 : 0 );
-  _current_prog->SetUniformF1( "u_thickness", thickness * _fb_scale );
+  _current_prog->SetUniformI1( c_u_perspective_thickness, _draw_properties[(int)TDrawProperty::perspective_line] ? 1 : 0 );
+  _current_prog->SetUniformF1( c_u_thickness, thickness * _fb_scale );
 
   // bind "white" color texture
-  glActiveTexture( GL_TEXTURE0 );
-  glBindTexture( GL_TEXTURE_2D, _color_texture ); 
+  CStateCache::Current().BindTexture( 0, GL_TEXTURE_2D, _color_texture );
   OPENGL_CHECK_GL_ERROR
 
   return true;
@@ -1959,8 +2162,7 @@ bool CBasicDraw::Draw(
   UpdateColorUniforms( color );
 
   // bind "white" color texture
-  glActiveTexture( GL_TEXTURE0 );
-  glBindTexture( GL_TEXTURE_2D, _color_texture ); 
+  CStateCache::Current().BindTexture( 0, GL_TEXTURE_2D, _color_texture );
   OPENGL_CHECK_GL_ERROR
 
   // draw_buffer
@@ -2011,46 +2213,196 @@ bool CBasicDraw::DrawText2D(
   UpdateColorUniforms( color );
 
   // bind "white" color texture
-  glActiveTexture( GL_TEXTURE0 );
-  glBindTexture( GL_TEXTURE_2D, _color_texture );
+  CStateCache::Current().BindTexture( 0, GL_TEXTURE_2D, _color_texture );
   OPENGL_CHECK_GL_ERROR
 
-  // set blending
-  bool set_depth_and_belnding = _current_pass == c_opaque_pass || _current_pass == c_back_pass || _current_pass == 0;
-  if ( set_depth_and_belnding )
-  {
-    glEnable( GL_DEPTH_TEST );
-    glDepthFunc( GL_LEQUAL );
-    glDepthMask( GL_TRUE );
-
-    glEnable( GL_BLEND );
-    glBlendFunc( GL_ONE, GL_ONE_MINUS_SRC_ALPHA ); // premultiplied alpha
-    //glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA ); // D * (1-alpha) + S * alpha
-    OPENGL_CHECK_GL_ERROR
-  }
+  // set blending and the distance field parameters
+  bool set_depth_and_belnding = PrepareTextBlending();
+  bool distance_field = SetGlyphUniforms( *font );
 
   // draw the text
   bool ret = font->Draw( *this, 0, text, height, width_scale, pos );
 
+  if ( distance_field )
+    _current_prog->SetUniformI1( c_u_glyph_type, 0 );
+
   // reset blending
   if ( set_depth_and_belnding )
+    ResetTextBlending();
+
+  return ret;
+}
+
+
+/******************************************************************//**
+* \brief   Set the depth test and premultiplied alpha blending for
+* drawing text in the opaque or background pass.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CBasicDraw::PrepareTextBlending( void )
+{
+  bool set_depth_and_belnding = _current_pass == c_opaque_pass || _current_pass == c_back_pass || _current_pass == 0;
+  if ( set_depth_and_belnding == false )
+    return false;
+
+  glEnable( GL_DEPTH_TEST );
+  glDepthFunc( GL_LEQUAL );
+  glDepthMask( GL_TRUE );
+
+  CStateCache::Current().Blend( true );
+  CStateCache::Current().BlendFunc( GL_ONE, GL_ONE_MINUS_SRC_ALPHA ); // premultiplied alpha
+  //glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA ); // D * (1-alpha) + S * alpha
+  OPENGL_CHECK_GL_ERROR
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Restore the depth test and the blending of the current pass.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CBasicDraw::ResetTextBlending( void )
+{
+  if ( _process != nullptr && _current_pass != 0 )
   {
-    if ( _process != nullptr && _current_pass != 0 )
-    {
-      _process->PrepareMode( _current_pass );
-    }
-    else
-    {
-      glEnable( GL_DEPTH_TEST );
-      glDepthFunc( GL_LESS );
-      glDepthMask( GL_TRUE );
-      glDisable( GL_BLEND );
-      OPENGL_CHECK_GL_ERROR
-    }
+    _process->PrepareMode( _current_pass );
+    return;
   }
 
-  return ret;
+  glEnable( GL_DEPTH_TEST );
+  glDepthFunc( GL_LESS );
+  glDepthMask( GL_TRUE );
+  CStateCache::Current().Blend( false );
+  OPENGL_CHECK_GL_ERROR
+}
+
+
+/******************************************************************//**
+* \brief   Set the distance field parameters and the text effects of
+* a font; returns false if the font has bitmap glyphs.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CBasicDraw::SetGlyphUniforms( 
+  const Render::IFont &font ) //!< in: font of the text
+{
+  Render::TGlyphImage glyph_image = font.GlyphImage();
+  if ( glyph_image._type == Render::TGlyphImageType::bitmap )
+    return false;
+
+  _current_prog->SetUniformI1( c_u_glyph_type, glyph_image._type == Render::TGlyphImageType::msdf ? 2 : 1 );
+  _current_prog->SetUniformF4( c_u_text_effect, { 2.0f * glyph_image._distance_range, _text_effect._outline_width, _text_effect._glow_width, 0.0f } );
+  _current_prog->SetUniformF4( c_u_outline_color, _text_effect._outline_color );
+  _current_prog->SetUniformF4( c_u_glow_color, _text_effect._glow_color );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Get the handle of a retained text mesh.
+*
+* The text is laid out once and kept in the shared vertex buffer of
+* the text mesh cache. Returns `Render::no_text_mesh`, if the font
+* can't be loaded or the cache is full; then the text has to be drawn
+* by `DrawText2D`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+Render::TTextMeshHandle CBasicDraw::TextMesh( 
+  TFontId      font_id,     //!< in: id of the font
+  const char  *text,        //!< in: the text
+  float        height,      //!< in: the height of the text
+  float        width_scale ) //!< in: scale of the text in the y direction
+{
+  Render::IFont *font = nullptr;
+  if ( LoadFont( font_id, font ) == false )
+    return Render::no_text_mesh;
+
+  if ( _text_meshes == nullptr )
+    _text_meshes = std::make_unique<Render::CTextMeshCache>( *this );
+  return _text_meshes->Acquire( *font, text, height, width_scale );
+}
+
+
+/******************************************************************//**
+* \brief   Queue a retained text mesh for drawing.
+*
+* The queued texts are drawn when the pass changes, or explicitly by
+* `FlushText`. All texts with the same font, atlas page and color are
+* drawn by a single `glMultiDrawArrays`; the vertex shader reads the
+* reference position of each text by `gl_DrawID`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CBasicDraw::DrawTextMesh( 
+  Render::TTextMeshHandle  handle, //!< in: handle of the text mesh
+  const Render::TPoint3   &pos,    //!< in: reference position
+  const Render::TColor    &color ) //!< in: color of the text
+{
+  if ( _drawing == false || _text_meshes == nullptr )
+  {
+    assert( false );
+    return false;
+  }
+  return _text_meshes->Draw( handle, pos, color );
+}
+
+
+/******************************************************************//**
+* \brief   Draw the queued text meshes.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CBasicDraw::FlushText( void )
+{
+  if ( _text_meshes == nullptr || _text_meshes->Queued() == 0 )
+    return true;
+
+  // activate the polygon shader of the pass (a line shader may be active)
+  bool transparent_pass = _current_pass == c_tranp_pass;
+  _current_prog = transparent_pass ? _transp_prog.get() : _opaque_prog.get();
+  _current_prog->Use();
+
+  UpdateGeneralUniforms();
+  bool set_depth_and_belnding = PrepareTextBlending();
+  _current_prog->SetUniformI1( c_u_text_batch, 1 );
+
+  _text_meshes->Flush( [&]( Render::IDrawBuffer &buffer, const Render::TTextMeshBatch &batch )
+  {
+    UpdateColorUniforms( batch._color );
+    bool distance_field = SetGlyphUniforms( *batch._font );
+
+    // reference positions of the texts, indexed by `gl_DrawID`
+    glNamedBufferData( _text_offset_ssbo, batch._draws * 4 * sizeof(float), batch._offsets, GL_STREAM_DRAW );
+    OPENGL_CHECK_GL_ERROR
+
+    batch._texture->Bind( 0 );
+    buffer.MultiDrawArray( Render::TPrimitive::triangles, batch._draws, batch._first, batch._count, true );
+    batch._texture->Release( 0 );
+
+    if ( distance_field )
+      _current_prog->SetUniformI1( c_u_glyph_type, 0 );
+  } );
+
+  _current_prog->SetUniformI1( c_u_text_batch, 0 );
+  if ( set_depth_and_belnding )
+    ResetTextBlending();
+  return true;
 }
 
 
-} // OpenGL
\ No newline at end of file
+} // OpenGL
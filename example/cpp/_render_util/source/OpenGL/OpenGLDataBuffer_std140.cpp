@@ -47,6 +47,13 @@
 #include "../../include/OpenGL/OpenGL_enumconst.h"
 
 
+// STL
+
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
+
 /******************************************************************//**
 * \brief General namespace for OpenGL implementation.  
 * 
@@ -135,6 +142,54 @@ bool CModelAndViewBuffer_std140::Init(
 }
 
 
+/******************************************************************//**
+* \brief Initialization of the object with a ring of blocks.
+*
+* If `ring_size` is 0, then the buffer contains a single block. 
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CModelAndViewBuffer_std140::Init( 
+  size_t                   binding,    //!< I - binding point
+  Render::TModelAndViewPtr data_ptr,   //!< I - data resource pointer 
+  size_t                   ring_size ) //!< I - number of blocks in the ring
+{
+  if ( ring_size == 0 )
+    return Init( binding, data_ptr );
+  if ( _initialized || data_ptr == nullptr )
+    return false;
+
+  _data           = data_ptr;
+  _buffer_binding = binding;
+
+  // the offset of a buffer range binding has to be a multiple of the alignment
+  GLint alignment = 0;
+  glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment );
+  size_t align   = alignment > 0 ? (size_t)alignment : 256;
+  _block_stride  = (sizeof(Render::TModelAndView) + align - 1) / align * align;
+  _ring_size     = ring_size;
+  _ring_data.assign( _ring_size * _block_stride, 0 );
+  _next_block       = 0;
+  _flushed_block    = 0;
+  _last_block       = c_no_block;
+  _selected_block   = c_no_block;
+  _frame_block      = 0;
+  _valid_block      = 0;
+  _max_frame_blocks = 0;
+
+  // create buffer
+  glGenBuffers( 1, &_buffer_object );
+  Allocate();
+
+  _initialized = true;
+
+  // upload and bind the first block
+  return Update();
+}
+
+
 /******************************************************************//**
 * \brief Destroy the object resources.  
 * 
@@ -150,12 +205,22 @@ void CModelAndViewBuffer_std140::Destroy( void )
   // destroy buffer
   glDeleteBuffers( 1, &_buffer_object );
   _buffer_object = 0;
+
+  _ring_size    = 0;
+  _block_stride = 0;
+  _ring_data.clear();
+  _initialized  = false;
 }
 
 
 /******************************************************************//**
 * \brief Update buffer data.  
 * 
+* In ring mode the current data are recorded to a new block, if they
+* were modified, uploaded and the block is bound to the binding point.
+* If the caller has selected a block after the data were recorded
+* and the data were not modified since, then the selection is kept.
+*
 * \author  gernot
 * \date    2018-12-17
 * \version 1.0
@@ -165,20 +230,30 @@ bool CModelAndViewBuffer_std140::Update( void )
   if ( _initialized == false )
     return false;
 
+  if ( _ring_size > 0 )
+  {
+    if ( _selected_block != c_no_block && _selected_block >= _frame_block &&
+         _data_stamp == _data->DataModifier() &&
+         _model_stamp == _data->ModelModifier() )
+      return true;
+
+    size_t block = Record();
+    Flush();
+    return Select( block );
+  }
+
   const Render::TModelAndView *data = _data->Data();
 
   // update date
   if ( _data_stamp != _data->DataModifier() )
   {
-    glBindBuffer( GL_UNIFORM_BUFFER, _buffer_object );
-    glBufferSubData( GL_UNIFORM_BUFFER, 0, sizeof(*data), data );
-    glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+    ++ _frame._records;
+    Upload( 0, sizeof(*data), data );
   }
   else if ( _model_stamp != _data->ModelModifier() )
   {
-    glBindBuffer( GL_UNIFORM_BUFFER, _buffer_object );
-    glBufferSubData( GL_UNIFORM_BUFFER, offsetof(Render::TModelAndView, _model), sizeof(data->_model), &data->_model );
-    glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+    ++ _frame._records;
+    Upload( offsetof(Render::TModelAndView, _model), sizeof(data->_model), &data->_model );
   }
 
   // synchronice modification stamps
@@ -189,4 +264,213 @@ bool CModelAndViewBuffer_std140::Update( void )
 }
 
 
+/******************************************************************//**
+* \brief Store the current data to the next block of the ring.
+*
+* If the data were not modified since the last block was recorded
+* in the current frame, then the index of the last block is returned.
+* A block of a former frame is not reused, because it gets invalid,
+* if the ring grows within the current frame. The block has to be
+* uploaded by `Flush`, before it is selected.
+*
+* The blocks, which are recorded after `NewFrame`, stay valid until the
+* next call of `NewFrame`. If the ring is full within a frame, then it
+* grows. If it wraps around at the begin of a frame, then the buffer
+* storage is orphaned and the blocks of the former frames get invalid.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CModelAndViewBuffer_std140::Record( void )
+{
+  if ( _initialized == false || _ring_size == 0 )
+    return c_no_block;
+
+  if ( _last_block != c_no_block && _last_block >= _frame_block &&
+       _data_stamp == _data->DataModifier() &&
+       _model_stamp == _data->ModelModifier() )
+    return _last_block;
+
+  if ( _next_block == _ring_size )
+  {
+    if ( _next_block > _frame_block )
+      Grow();
+    else
+      Orphan();
+  }
+
+  std::memcpy( _ring_data.data() + _next_block * _block_stride, _data->Data(), sizeof(Render::TModelAndView) );
+  ++ _frame._records;
+
+  _selected_block = c_no_block;
+  _last_block     = _next_block ++;
+  _data_stamp     = _data->DataModifier();
+  _model_stamp    = _data->ModelModifier();
+  return _last_block;
+}
+
+
+/******************************************************************//**
+* \brief Upload the recorded blocks by a single `glBufferSubData`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CModelAndViewBuffer_std140::Flush( void )
+{
+  if ( _initialized == false || _ring_size == 0 )
+    return false;
+  if ( _flushed_block == _next_block )
+    return true;
+
+  // the padding after the last block is not uploaded
+  size_t offset = _flushed_block * _block_stride;
+  size_t size   = (_next_block - _flushed_block - 1) * _block_stride + sizeof(Render::TModelAndView);
+  Upload( offset, size, _ring_data.data() + offset );
+
+  _flushed_block = _next_block;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Bind a range of blocks to the binding point.
+*
+* If more than 1 block is selected, then the range contains
+* `no_of_blocks` consecutive blocks, in steps of `BlockStride`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CModelAndViewBuffer_std140::Select( 
+  size_t block,        //!< I - index of the first block
+  size_t no_of_blocks ) //!< I - number of blocks
+{
+  if ( _initialized == false || _ring_size == 0 || no_of_blocks == 0 )
+    return false;
+  if ( block < _valid_block || block >= _flushed_block || block + no_of_blocks > _flushed_block )
+  {
+    ASSERT( false ); // the blocks have to be recorded to the current storage and uploaded
+    return false;
+  }
+  GLintptr   offset = (GLintptr)(block * _block_stride);
+  GLsizeiptr size   = (GLsizeiptr)((no_of_blocks - 1) * _block_stride + sizeof(Render::TModelAndView));
+  glBindBufferRange( GL_UNIFORM_BUFFER, (GLuint)_buffer_binding, _buffer_object, offset, size );
+  ++ _frame._binds;
+  _selected_block = block;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Complete the counters of the current frame and start a new
+* frame.
+*
+* The blocks, which are recorded after this call, stay valid until
+* the next call. If the maximum number of blocks of the former frames
+* would not fit into the rest of the ring, then the ring wraps around
+* now, so that it only has to grow, when the maximum number of blocks
+* per frame increases.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CModelAndViewBuffer_std140::NewFrame( void )
+{
+  _last_frame = _frame;
+  _frame      = TStatistics();
+
+  _max_frame_blocks = std::max( _max_frame_blocks, _next_block - _frame_block );
+  if ( _ring_size > 0 && _next_block + _max_frame_blocks > _ring_size )
+    Orphan();
+  _frame_block = _next_block;
+}
+
+
+/******************************************************************//**
+* \brief (Re)allocate the buffer storage for the complete ring.
+*
+* Pending draw calls keep reading the former storage.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CModelAndViewBuffer_std140::Allocate( void )
+{
+  glBindBuffer( GL_UNIFORM_BUFFER, _buffer_object );
+  glBufferData( GL_UNIFORM_BUFFER, (GLsizeiptr)_ring_data.size(), nullptr, GL_STREAM_DRAW );
+  glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+}
+
+
+/******************************************************************//**
+* \brief Double the size of the ring, when it is full within a frame.
+*
+* The indices of the blocks of the current frame stay valid. The
+* blocks are uploaded again to the new storage, by the next `Flush`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CModelAndViewBuffer_std140::Grow( void )
+{
+  _ring_size *= 2;
+  _ring_data.resize( _ring_size * _block_stride, 0 );
+  Allocate();
+  ++ _frame._grows;
+
+  _valid_block   = _frame_block;
+  _flushed_block = _frame_block;
+}
+
+
+/******************************************************************//**
+* \brief Orphan the buffer storage and restart the ring, at the begin
+* of a frame.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CModelAndViewBuffer_std140::Orphan( void )
+{
+  Allocate();
+  ++ _frame._orphans;
+
+  _next_block     = 0;
+  _flushed_block  = 0;
+  _frame_block    = 0;
+  _valid_block    = 0;
+  _last_block     = c_no_block;
+  _selected_block = c_no_block;
+}
+
+
+/******************************************************************//**
+* \brief Upload data to the buffer and count the upload.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CModelAndViewBuffer_std140::Upload( 
+  size_t      offset, //!< I - offset in the buffer
+  size_t      size,   //!< I - size of the data in bytes
+  const void *data )  //!< I - source data
+{
+  glBindBuffer( GL_UNIFORM_BUFFER, _buffer_object );
+  glBufferSubData( GL_UNIFORM_BUFFER, (GLintptr)offset, (GLsizeiptr)size, data );
+  glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+
+  ++ _frame._uploads;
+  _frame._bytes += size;
+}
+
+
 } // OpenGL
\ No newline at end of file
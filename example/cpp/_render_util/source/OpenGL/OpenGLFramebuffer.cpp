@@ -14,6 +14,8 @@
 // OpenGL
 
 #include "../../include/OpenGL/OpenGLFramebuffer.h"
+#include "../../include/OpenGL/OpenGLStateCache.h"
+#include "../../include/util/RenderUtil_Profiler.h"
 
 
 // OpenGL wrapper
@@ -119,10 +121,10 @@ void CRenderProcess::Destruct( void )
   std::vector<unsigned int> delTex;
   for ( auto & tex : _textures )
   {
-    if ( tex.second._object != 0 &&  tex.second._extern == false )
+    if ( tex.second._object != 0 &&  tex.second._extern == false && tex.second._alias == false )
       delTex.push_back( tex.second._object );
   }
-  glDeleteTextures( (GLsizei)delTex.size(), delTex.data() );
+  CStateCache::Current().DeleteTextures( (GLsizei)delTex.size(), delTex.data() );
   OPENGL_CHECK_GL_ERROR
 
   Invalidate();
@@ -167,7 +169,7 @@ void CRenderProcess::DeleteUnnecessaryTextures( void )
       continue;
 
     // note this textures which have to be deleted (GPU)
-    if ( tex.second._extern == false)
+    if ( tex.second._extern == false && tex.second._alias == false )
       texDelObjects.emplace_back(tex.second._object);
 
     // note the texture to be removed from the target textures
@@ -181,7 +183,7 @@ void CRenderProcess::DeleteUnnecessaryTextures( void )
   // delete texture GPU objects
   if ( texDelObjects.empty() == false )
   {
-    glDeleteTextures( (GLsizei)texDelObjects.size(), texDelObjects.data() );
+    CStateCache::Current().DeleteTextures( (GLsizei)texDelObjects.size(), texDelObjects.data() );
     OPENGL_CHECK_GL_ERROR
   }
 }
@@ -715,9 +717,9 @@ void CRenderProcess::UpdateTexture(
   if ( newTexture._extern )
   {
     // delete the "old" texture if it was not an external texture
-    if ( texIt != _textures.end() && texIt->second._extern == false )
+    if ( texIt != _textures.end() && texIt->second._extern == false && texIt->second._alias == false )
     {
-      glDeleteTextures( 1, &texIt->second._object );
+      CStateCache::Current().DeleteTextures( 1, &texIt->second._object );
       OPENGL_CHECK_GL_ERROR
     }
     
@@ -736,10 +738,10 @@ void CRenderProcess::UpdateTexture(
     if ( texIt->second == newTexture )
       return;   
     
-    // Delete the "old" texture object, of course if it is not extern.
-    if ( texIt->second._extern == false )
+    // Delete the "old" texture object, of course if it is not extern or owned by another buffer.
+    if ( texIt->second._extern == false && texIt->second._alias == false )
     {
-      glDeleteTextures( 1, &texIt->second._object );
+      CStateCache::Current().DeleteTextures( 1, &texIt->second._object );
       OPENGL_CHECK_GL_ERROR
     }
   }
@@ -755,7 +757,7 @@ void CRenderProcess::UpdateTexture(
   if ( is_layered )
   {
     target_texture = GL_TEXTURE_2D_ARRAY;
-    glBindTexture( target_texture, newTexture._object ); OPENGL_CHECK_GL_ERROR
+    CStateCache::Current().BindTexture( target_texture, newTexture._object ); OPENGL_CHECK_GL_ERROR
     glTexImage3D( target_texture, 0, (GLint)newTexture._format[0],
       (GLsizei)newTexture._size[0], (GLsizei)newTexture._size[1], (GLsizei)newTexture._layers,
       0, (GLenum)newTexture._format[1], (GLenum)newTexture._format[2], nullptr ); OPENGL_CHECK_GL_ERROR
@@ -763,7 +765,7 @@ void CRenderProcess::UpdateTexture(
   else if ( is_multisampled )
   {
     target_texture = GL_TEXTURE_2D_MULTISAMPLE;
-    glBindTexture( target_texture, newTexture._object ); OPENGL_CHECK_GL_ERROR
+    CStateCache::Current().BindTexture( target_texture, newTexture._object ); OPENGL_CHECK_GL_ERROR
     glTexImage2DMultisample( target_texture, newTexture._multisamples, (GLint)newTexture._format[0],
       (GLsizei)newTexture._size[0], (GLsizei)newTexture._size[1], GL_FALSE ); OPENGL_CHECK_GL_ERROR
   }
@@ -772,7 +774,7 @@ void CRenderProcess::UpdateTexture(
     if ( newTexture._cubemap_side >= 0 )
       DebugWarning << "a single cube map side can't be created" << (int)newTexture._cubemap_side;
     target_texture = GL_TEXTURE_CUBE_MAP;
-    glBindTexture( target_texture, newTexture._object ); OPENGL_CHECK_GL_ERROR
+    CStateCache::Current().BindTexture( target_texture, newTexture._object ); OPENGL_CHECK_GL_ERROR
 
     for ( int sideInx = 0; sideInx < 6; sideInx ++ )
     {
@@ -785,7 +787,7 @@ void CRenderProcess::UpdateTexture(
   else 
   {
     target_texture = GL_TEXTURE_2D;
-    glBindTexture( target_texture, newTexture._object ); OPENGL_CHECK_GL_ERROR
+    CStateCache::Current().BindTexture( target_texture, newTexture._object ); OPENGL_CHECK_GL_ERROR
     glTexImage2D( target_texture, 0, (GLint)newTexture._format[0],
       (GLsizei)newTexture._size[0], (GLsizei)newTexture._size[1],
       0, (GLenum)newTexture._format[1], (GLenum)newTexture._format[2], nullptr ); OPENGL_CHECK_GL_ERROR
@@ -818,6 +820,53 @@ void CRenderProcess::UpdateTexture(
 }
 
 
+/******************************************************************//**
+* \brief   Let a buffer share the texture of the buffer, which owns it.
+*
+* The lifetimes of the buffers are disjoint (see `Render::CRenderGraph`).
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CRenderProcess::AliasTexture( 
+  size_t bufferID, //!< in: the name of the buffer
+  size_t ownerID ) //!< in: the name of the buffer which owns the texture
+{
+  auto texIt = _textures.find( bufferID );
+  if ( texIt != _textures.end() && texIt->second._extern == false && texIt->second._alias == false )
+  {
+    CStateCache::Current().DeleteTextures( 1, &texIt->second._object );
+    OPENGL_CHECK_GL_ERROR
+  }
+
+  TTextureObject texture = _textures[ownerID];
+  texture._alias = true;
+  _textures[bufferID] = texture;
+}
+
+
+/******************************************************************//**
+* \brief   Get the framebuffer attachment point of a target attachment.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+unsigned int CRenderProcess::AttachmentPoint( 
+  size_t attachment ) //!< in: attachment of the target specification
+{
+  switch ( attachment )
+  {
+    case Render::TPass::TTarget::depth:         return GL_DEPTH_ATTACHMENT;
+    case Render::TPass::TTarget::stencil:       return GL_STENCIL_ATTACHMENT;
+    case Render::TPass::TTarget::depth_stencil: return GL_DEPTH_STENCIL_ATTACHMENT;
+    default:                                    break;
+  }
+  return (GLenum)(GL_COLOR_ATTACHMENT0 + attachment);
+}
+
+
 /******************************************************************//**
 * \brief   Create a render buffer according to the target specification
 * and attach the render buffer to the framebuffer attachment point,
@@ -914,15 +963,7 @@ void CRenderProcess::AttachFrambufferTextureBuffer(
     return;
   }
 
-  GLenum attachType = 0;
-  switch ( target._attachment )
-  {
-    case Render::TPass::TTarget::depth:         attachType = GL_DEPTH_ATTACHMENT; break;
-    case Render::TPass::TTarget::stencil:       attachType = GL_STENCIL_ATTACHMENT; break;
-    case Render::TPass::TTarget::depth_stencil: attachType = GL_DEPTH_STENCIL_ATTACHMENT; break;
-    default:                                    attachType = (GLenum)(GL_COLOR_ATTACHMENT0 + target._attachment); break;
-
-  }
+  GLenum attachType = AttachmentPoint( target._attachment );
 
   
   // add texture attachment
@@ -984,6 +1025,10 @@ bool CRenderProcess::Create(
   _complete = true;
   _bufferInfoMap.clear();
 
+  // build the render graph: order of the passes, lifetimes and aliasing of the buffers
+  if ( _graph.Build( _buffers, _passes, _size ) == false )
+    DebugWarning << "cyclic render pass dependencies";
+
   // delete all framebuffer objects which are not required anymore
   DeleteUnnecessaryTextures();
 
@@ -993,16 +1038,26 @@ bool CRenderProcess::Create(
   // for each buffer
   if ( _buffers.empty() == false )
   {
-    glActiveTexture( GL_TEXTURE0 );
+    CStateCache::Current().ActiveTexture( 0 );
     OPENGL_CHECK_GL_ERROR
   }
   for ( auto & buffer : _buffers )
-    UpdateTexture( buffer.first, buffer.second );
+  {
+    if ( IsAliased( buffer.first ) == false )
+      UpdateTexture( buffer.first, buffer.second );
+  }
+
+  // aliased buffers share the texture of the buffer, which owns it
+  for ( auto & buffer : _buffers )
+  {
+    if ( IsAliased( buffer.first ) )
+      AliasTexture( buffer.first, _graph.Alias( buffer.first ) );
+  }
 
   // unbind any textures
   if ( _buffers.empty() == false )
   {
-    glBindTexture( GL_TEXTURE_2D, 0 );
+    CStateCache::Current().BindTexture( GL_TEXTURE_2D, 0 );
     OPENGL_CHECK_GL_ERROR
   }
 
@@ -1262,6 +1317,8 @@ bool CRenderProcess::Prepare(
   size_t             passID, //!< in: the name of the render pass
   TPrepareProperties props ) //!< in: conditions
 {
+  RENDERUTIL_PROFILE_SCOPE( "CRenderProcess::Prepare" )
+
   if ( IsValid() == false || _complete == false )
     return false;
 
@@ -1329,10 +1386,9 @@ bool CRenderProcess::Prepare(
   {
     for ( auto source : bufferInfo._sourceTextures )
     {
-      glActiveTexture( std::get<0>(source) ); OPENGL_CHECK_GL_ERROR
-      glBindTexture( std::get<1>(source), std::get<2>(source) ); OPENGL_CHECK_GL_ERROR
+      CStateCache::Current().BindTexture( std::get<0>(source) - GL_TEXTURE0, std::get<1>(source), std::get<2>(source) ); OPENGL_CHECK_GL_ERROR
     }
-    glActiveTexture( GL_TEXTURE0 );
+    CStateCache::Current().ActiveTexture( 0 );
   }
   
   return true;
@@ -1404,10 +1460,9 @@ bool CRenderProcess::ReleasePass(
   {
     for ( auto source : it->second._sourceTextures )
     {
-      glActiveTexture( std::get<0>(source) ); OPENGL_CHECK_GL_ERROR
-      glBindTexture( std::get<1>(source), 0 ); OPENGL_CHECK_GL_ERROR
+      CStateCache::Current().BindTexture( std::get<0>(source) - GL_TEXTURE0, std::get<1>(source), 0 ); OPENGL_CHECK_GL_ERROR
     }
-    glActiveTexture( GL_TEXTURE0 );
+    CStateCache::Current().ActiveTexture( 0 );
   }
 
   // restore the viewport size
@@ -1439,6 +1494,80 @@ bool CRenderProcess::Release( void )
 }
 
 
+/******************************************************************//**
+* \brief   Invalidate the attachments, which are dead after a pass.
+*
+* The content of the transient buffers, whose last access (in the order
+* of the render graph) is the pass, is invalidated by
+* `glInvalidateNamedFramebufferData` (OpenGL 4.5), in the framebuffer
+* of the last pass, which writes the buffer. If direct state access is
+* not available (OpenGL 4.3, OpenGL ES 3.0), the framebuffer is bound
+* to `GL_DRAW_FRAMEBUFFER` and invalidated by `glInvalidateFramebuffer`.
+* The framebuffer binding is restored. Without either function the
+* invalidation is skipped, since it is a hint only.
+*
+* This has to be called after the last drawing to the pass in the frame.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CRenderProcess::Discard( 
+  size_t passID ) //!< in: the name of the render pass
+{
+  if ( IsValid() == false || _complete == false || _graph.Valid() == false )
+    return false;
+
+  const std::vector<size_t> &dead = _graph.Dead( passID );
+  if ( dead.empty() )
+    return true;
+
+  // collect the attachments of the dead buffers in the framebuffers of the passes, which write the buffers last
+  std::map<unsigned int, std::vector<GLenum>> attachments;
+  const std::vector<size_t> &order = _graph.Order();
+  for ( auto bufferID : dead )
+  {
+    for ( auto passIt = order.rbegin(); passIt != order.rend(); ++ passIt )
+    {
+      auto fbIt = _fbs.find( *passIt );
+      if ( fbIt == _fbs.end() )
+        continue;
+      const Render::TPass &pass = _passes[*passIt];
+      auto targetIt = std::find_if( pass._targets.begin(), pass._targets.end(), [bufferID]( const auto & target ) -> bool {
+        return target._bufferID == bufferID;
+      } );
+      if ( targetIt == pass._targets.end() )
+        continue;
+      attachments[fbIt->second._object].push_back( AttachmentPoint( targetIt->_attachment ) );
+      break;
+    }
+  }
+
+  if ( glInvalidateNamedFramebufferData != nullptr )
+  {
+    for ( auto & fb : attachments )
+    {
+      glInvalidateNamedFramebufferData( fb.first, (GLsizei)fb.second.size(), fb.second.data() );
+      OPENGL_CHECK_GL_ERROR
+    }
+  }
+  else if ( glInvalidateFramebuffer != nullptr )
+  {
+    GLint draw_fb = 0;
+    glGetIntegerv( GL_DRAW_FRAMEBUFFER_BINDING, &draw_fb );
+    for ( auto & fb : attachments )
+    {
+      glBindFramebuffer( GL_DRAW_FRAMEBUFFER, fb.first );
+      glInvalidateFramebuffer( GL_DRAW_FRAMEBUFFER, (GLsizei)fb.second.size(), fb.second.data() );
+      OPENGL_CHECK_GL_ERROR
+    }
+    glBindFramebuffer( GL_DRAW_FRAMEBUFFER, (GLuint)draw_fb );
+  }
+
+  return true;
+}
+
+
 /******************************************************************//**
 * @brief   Get the implementation object for a buffer.
 *
@@ -1503,6 +1632,8 @@ bool CRenderProcess::Bind(
   bool   read,   //!< in: bind for reading
   bool   draw )  //!< in: bind for drawing
 {
+  RENDERUTIL_PROFILE_SCOPE( "CRenderProcess::Bind" )
+
   if ( IsValid() == false || _complete == false )
     return false;
 
@@ -1595,27 +1726,27 @@ bool CRenderProcess::SetupBlending(
   {
     default:
     case Render::TPassBlending::OFF:
-      glDisable( GL_BLEND );
+      CStateCache::Current().Blend( false );
       break;
 
     case Render::TPassBlending::OVERWRITE:
-      glEnable( GL_BLEND );
-      glBlendFunc( GL_ONE, GL_ZERO );
+      CStateCache::Current().Blend( true );
+      CStateCache::Current().BlendFunc( GL_ONE, GL_ZERO );
       break;
 
     case Render::TPassBlending::MIX:
-      glEnable( GL_BLEND );
-      glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+      CStateCache::Current().Blend( true );
+      CStateCache::Current().BlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
       break;
 
     case Render::TPassBlending::MIX_PREMULTIPLIED_ALPHA:
-      glEnable( GL_BLEND );
-      glBlendFunc( GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
+      CStateCache::Current().Blend( true );
+      CStateCache::Current().BlendFunc( GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
       break;
 
     case Render::TPassBlending::ADD:
-      glEnable( GL_BLEND );
-      glBlendFunc( GL_ONE, GL_ONE );
+      CStateCache::Current().Blend( true );
+      CStateCache::Current().BlendFunc( GL_ONE, GL_ONE );
       break;
   }
 
@@ -0,0 +1,342 @@
+/******************************************************************//**
+* \brief   Headless OpenGL context (EGL pbuffer), without a window
+*          system.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+// includes
+
+#include <stdafx.h>
+
+// OpenGL
+
+#include "../../include/OpenGL/OpenGLHeadlessContext.h"
+
+
+// EGL
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+
+// STL
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// class implementations
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+namespace
+{
+
+
+//! true, if the space separated list of extensions contains `name`
+bool HasExtension( const char *extensions, const char *name )
+{
+  if ( extensions == nullptr )
+    return false;
+  size_t length = std::strlen( name );
+  for ( const char *p = std::strstr( extensions, name ); p != nullptr; p = std::strstr( p + length, name ) )
+  {
+    bool begin = p == extensions || p[-1] == ' ';
+    bool end = p[length] == ' ' || p[length] == '\0';
+    if ( begin && end )
+      return true;
+  }
+  return false;
+}
+
+
+std::string EGLError( const char *what )
+{
+  char code[16];
+  std::snprintf( code, sizeof( code ), "0x%04x", (unsigned int)eglGetError() );
+  return std::string( what ) + " failed (EGL error " + code + ")";
+}
+
+
+//! initialize the EGL display of a platform
+EGLDisplay InitializeDisplay(
+  CHeadlessContext::TPlatform  platform,
+  CHeadlessContext::TPlatform &used )
+{
+  using TPlatform = CHeadlessContext::TPlatform;
+
+  const char *client_extensions = eglQueryString( EGL_NO_DISPLAY, EGL_EXTENSIONS );
+  auto get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress( "eglGetPlatformDisplayEXT" );
+  auto initialize = [&]( EGLDisplay display, TPlatform display_platform ) -> EGLDisplay
+  {
+    EGLint major = 0, minor = 0;
+    if ( display == EGL_NO_DISPLAY || eglInitialize( display, &major, &minor ) == EGL_FALSE )
+      return EGL_NO_DISPLAY;
+    used = display_platform;
+    return display;
+  };
+
+  if ( (platform == TPlatform::automatic || platform == TPlatform::device) && get_platform_display != nullptr &&
+       HasExtension( client_extensions, "EGL_EXT_platform_device" ) )
+  {
+    auto query_devices = (PFNEGLQUERYDEVICESEXTPROC)eglGetProcAddress( "eglQueryDevicesEXT" );
+    std::vector<EGLDeviceEXT> devices( 16 );
+    EGLint no_of_devices = 0;
+    if ( query_devices != nullptr && query_devices( (EGLint)devices.size(), devices.data(), &no_of_devices ) == EGL_TRUE )
+    {
+      for ( EGLint i = 0; i < no_of_devices; ++ i )
+      {
+        EGLDisplay display = initialize( get_platform_display( EGL_PLATFORM_DEVICE_EXT, devices[i], nullptr ), TPlatform::device );
+        if ( display != EGL_NO_DISPLAY )
+          return display;
+      }
+    }
+  }
+
+  if ( (platform == TPlatform::automatic || platform == TPlatform::surfaceless) && get_platform_display != nullptr &&
+       HasExtension( client_extensions, "EGL_MESA_platform_surfaceless" ) )
+  {
+    EGLDisplay display = initialize( get_platform_display( EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr ), TPlatform::surfaceless );
+    if ( display != EGL_NO_DISPLAY )
+      return display;
+  }
+
+  if ( platform == TPlatform::automatic || platform == TPlatform::default_display )
+    return initialize( eglGetDisplay( EGL_DEFAULT_DISPLAY ), TPlatform::default_display );
+
+  return EGL_NO_DISPLAY;
+}
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   ctor: initialize the display, create the context and the
+*          pbuffer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CHeadlessContext::CHeadlessContext(
+  const TConfig &config ) //!< I - size, version and platform
+  : _config( config )
+{
+  try
+  {
+    Create();
+  }
+  catch ( ... )
+  {
+    Destroy();
+    throw;
+  }
+}
+
+
+/******************************************************************//**
+* \brief   dtor.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CHeadlessContext::~CHeadlessContext()
+{
+  Destroy();
+}
+
+
+/******************************************************************//**
+* \brief   Initialize the display, create the context and the pbuffer.
+*
+* Throws `std::runtime_error`, if one of the steps fails. The objects
+* created up to then are stored in the members, so `Destroy` can
+* release them.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CHeadlessContext::Create( void )
+{
+  EGLDisplay display = InitializeDisplay( _config._platform, _platform );
+  if ( display == EGL_NO_DISPLAY )
+    throw std::runtime_error( EGLError( "EGL display initialization" ) );
+  _display = display;
+  const char *vendor = eglQueryString( display, EGL_VENDOR );
+  _vendor = vendor != nullptr ? vendor : "";
+
+  if ( eglBindAPI( EGL_OPENGL_API ) == EGL_FALSE )
+    throw std::runtime_error( EGLError( "eglBindAPI(EGL_OPENGL_API)" ) );
+
+  // RGBA8 color buffer; depth and stencil buffer, if available
+  EGLConfig egl_config = nullptr;
+  EGLint no_of_configs = 0;
+  for ( EGLint depth_size : { 24, 0 } )
+  {
+    const EGLint config_attributes[] = {
+      EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+      EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+      EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+      EGL_DEPTH_SIZE, depth_size,
+      EGL_NONE };
+    if ( eglChooseConfig( display, config_attributes, &egl_config, 1, &no_of_configs ) == EGL_TRUE && no_of_configs > 0 )
+      break;
+  }
+  if ( no_of_configs == 0 )
+    throw std::runtime_error( EGLError( "eglChooseConfig (pbuffer, OpenGL, RGBA8)" ) );
+  _egl_config = egl_config;
+
+  const EGLint context_attributes[] = {
+    EGL_CONTEXT_MAJOR_VERSION, _config._major,
+    EGL_CONTEXT_MINOR_VERSION, _config._minor,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, _config._core ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+    EGL_CONTEXT_OPENGL_DEBUG, _config._debug ? EGL_TRUE : EGL_FALSE,
+    EGL_NONE };
+  EGLContext context = eglCreateContext( display, egl_config, EGL_NO_CONTEXT, context_attributes );
+  if ( context == EGL_NO_CONTEXT )
+    throw std::runtime_error( EGLError( "eglCreateContext" ) );
+  _context = context;
+
+  CreateSurface();
+}
+
+
+/******************************************************************//**
+* \brief   Destroy the pbuffer and the context and terminate the
+*          display.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CHeadlessContext::Destroy( void )
+{
+  if ( _display == nullptr )
+    return;
+  if ( IsActive() )
+    Release();
+  if ( _surface != nullptr )
+    eglDestroySurface( (EGLDisplay)_display, (EGLSurface)_surface );
+  if ( _context != nullptr )
+    eglDestroyContext( (EGLDisplay)_display, (EGLContext)_context );
+  eglTerminate( (EGLDisplay)_display );
+  _surface = nullptr;
+  _context = nullptr;
+  _display = nullptr;
+}
+
+
+/******************************************************************//**
+* \brief   Create the pbuffer of the configured size.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CHeadlessContext::CreateSurface( void )
+{
+  const EGLint surface_attributes[] = {
+    EGL_WIDTH, (EGLint)_config._width,
+    EGL_HEIGHT, (EGLint)_config._height,
+    EGL_NONE };
+  EGLSurface surface = eglCreatePbufferSurface( (EGLDisplay)_display, (EGLConfig)_egl_config, surface_attributes );
+  if ( surface == EGL_NO_SURFACE )
+    throw std::runtime_error( EGLError( "eglCreatePbufferSurface" ) );
+  _surface = surface;
+}
+
+
+/******************************************************************//**
+* \brief   Check if the context is current in this thread.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CHeadlessContext::IsActive( void ) const
+{
+  return _context != nullptr && eglGetCurrentContext() == (EGLContext)_context;
+}
+
+
+/******************************************************************//**
+* \brief   Make the context and the pbuffer current in this thread.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CHeadlessContext::Activate( void )
+{
+  return eglMakeCurrent( (EGLDisplay)_display, (EGLSurface)_surface, (EGLSurface)_surface, (EGLContext)_context ) == EGL_TRUE;
+}
+
+
+/******************************************************************//**
+* \brief   Release the current context of this thread.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CHeadlessContext::Release( void )
+{
+  return eglMakeCurrent( (EGLDisplay)_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT ) == EGL_TRUE;
+}
+
+
+/******************************************************************//**
+* \brief   Replace the pbuffer by a pbuffer of a new size.
+*
+* If the context was active, the new pbuffer is made current.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CHeadlessContext::Resize(
+  size_t width,  //!< I - new width
+  size_t height ) //!< I - new height
+{
+  if ( width == _config._width && height == _config._height )
+    return true;
+
+  bool active = IsActive();
+  if ( active )
+    Release();
+  eglDestroySurface( (EGLDisplay)_display, (EGLSurface)_surface );
+  _surface = nullptr;
+  _config._width = width;
+  _config._height = height;
+  try
+  {
+    CreateSurface();
+  }
+  catch ( const std::runtime_error & )
+  {
+    return false;
+  }
+  return active ? Activate() : true;
+}
+
+
+} // OpenGL
@@ -0,0 +1,358 @@
+/******************************************************************//**
+* \brief Arc length of polyline vertices on the GPU, by a parallel
+* segmented prefix sum of the segment lengths in compute shaders,
+* for OpenGL version 4.3+ and GLSL version 4.30 (`#version 430`).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/OpenGL/OpenGLLine_arclength.h"
+#include "../../include/OpenGL/OpenGLProgram.h"
+
+
+// OpenGL wrapper
+
+#include "../../include/OpenGL/OpenGL_include.h"
+#include "../../include/OpenGL/OpenGL_enumconst.h"
+
+
+// STL
+
+#include <iostream>
+
+
+// class definitions
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+/******************************************************************//**
+* \brief Namespace for drawing lines with the use of OpenGL.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace Line
+{
+
+
+/*!
+
+Segmented scan operator, `(a, fa) + (b, fb) = (fb ? b : a + b, fa | fb)`, where `f` is set if the polyline starts in the range.
+The operator is associative, so the scan can be computed in parallel.
+
+The `#version` and the `PASS` definition are prepended to the source.
+
+*/
+
+const std::string CArcLengthPrefixSum::_comp_430 = R"(
+layout (local_size_x = 256) in;
+
+layout (std430, binding = 0) buffer TVertices
+{
+    vec4 vertex[]; // x, y, z, w; w == 0: first vertex of a polyline
+};
+
+struct TBlock
+{
+    float sum;         // segmented sum of the block
+    uint  first_start; // index of the first polyline start in the block; 1024: no start
+    float prefix;      // inclusive segmented sum of all the blocks up to the block
+    uint  pad;
+};
+
+layout (std430, binding = 1) buffer TBlocks
+{
+    TBlock block[];
+};
+
+uniform uint u_no_of_vertices;
+uniform uint u_no_of_blocks;
+
+shared float s_sum[256];
+shared uint  s_flag[256];
+shared uint  s_first;
+shared float s_carry;
+
+// inclusive segmented Hillis-Steele scan of `s_sum` and `s_flag`
+void ScanShared(uint t)
+{
+    for (uint offset = 1u; offset < 256u; offset <<= 1)
+    {
+        float a  = 0.0;
+        uint  fa = 0u;
+        if (t >= offset)
+        {
+            a  = s_sum[t-offset];
+            fa = s_flag[t-offset];
+        }
+        barrier();
+        if (t >= offset)
+        {
+            if (s_flag[t] == 0u)
+                s_sum[t] += a;
+            s_flag[t] |= fa;
+        }
+        barrier();
+    }
+}
+
+void main()
+{
+    uint t = gl_LocalInvocationID.x;
+    uint g = gl_WorkGroupID.x;
+
+#if PASS == 1
+
+    if (t == 0u)
+        s_first = 1024u;
+    barrier();
+
+    // sequential scan of 4 vertices per invocation
+    float sums[4];
+    uint  flags[4];
+    float sum  = 0.0;
+    uint  flag = 0u;
+    for (uint j = 0u; j < 4u; ++ j)
+    {
+        uint  local = t * 4u + j;
+        uint  i     = g * 1024u + local;
+        float len   = 0.0;
+        uint  start = 0u;
+        if (i < u_no_of_vertices)
+        {
+            vec4 v = vertex[i];
+            start  = i == 0u || v.w == 0.0 ? 1u : 0u;
+            len    = start == 1u ? 0.0 : distance(v.xyz, vertex[i-1u].xyz);
+            if (start == 1u)
+                atomicMin(s_first, local);
+        }
+        sum      = start == 1u ? len : sum + len;
+        flag    |= start;
+        sums[j]  = sum;
+        flags[j] = flag;
+    }
+    s_sum[t]  = sum;
+    s_flag[t] = flag;
+    barrier();
+
+    ScanShared(t);
+
+    // add the sum of the preceding invocations
+    float carry = t > 0u ? s_sum[t-1u] : 0.0;
+    for (uint j = 0u; j < 4u; ++ j)
+    {
+        uint i = g * 1024u + t * 4u + j;
+        if (i < u_no_of_vertices)
+            vertex[i].w = flags[j] != 0u ? sums[j] : carry + sums[j];
+    }
+
+    if (t == 255u)
+    {
+        block[g].sum         = s_sum[255];
+        block[g].first_start = s_first;
+    }
+
+#elif PASS == 2
+
+    if (t == 0u)
+        s_carry = 0.0;
+    barrier();
+
+    // scan the block sums in chunks of 256 blocks
+    for (uint chunk = 0u; chunk < u_no_of_blocks; chunk += 256u)
+    {
+        uint b = chunk + t;
+        s_sum[t]  = b < u_no_of_blocks ? block[b].sum : 0.0;
+        s_flag[t] = b < u_no_of_blocks && block[b].first_start < 1024u ? 1u : 0u;
+        barrier();
+
+        ScanShared(t);
+
+        if (b < u_no_of_blocks)
+            block[b].prefix = s_flag[t] != 0u ? s_sum[t] : s_carry + s_sum[t];
+        barrier();
+        if (t == 255u)
+            s_carry = s_flag[255] != 0u ? s_sum[255] : s_carry + s_sum[255];
+        barrier();
+    }
+
+#else
+
+    // add the sum of the preceding blocks to the vertices before the first polyline start
+    if (g == 0u)
+        return;
+    float carry = block[g-1u].prefix;
+    uint  first = block[g].first_start;
+    for (uint j = 0u; j < 4u; ++ j)
+    {
+        uint local = t * 4u + j;
+        uint i     = g * 1024u + local;
+        if (i < u_no_of_vertices && local < first)
+            vertex[i].w += carry;
+    }
+
+#endif
+}
+)";
+
+
+/******************************************************************//**
+* \brief ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CArcLengthPrefixSum::CArcLengthPrefixSum( void )
+{}
+
+
+/******************************************************************//**
+* \brief dtor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CArcLengthPrefixSum::~CArcLengthPrefixSum()
+{
+  if ( _block_buffer != 0 )
+    glDeleteBuffers( 1, &_block_buffer );
+}
+
+
+/******************************************************************//**
+* \brief Trace error message.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CArcLengthPrefixSum::Error(
+  const std::string &kind,     //!< in: message kind
+  const std::string &message ) //!< in: error message
+{
+  std::cout << kind << ": " << message;
+}
+
+
+/******************************************************************//**
+* \brief Initialize the compute shader programs of the 3 passes.
+*
+* For the initialization a current and valid OpenGL context is required.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CArcLengthPrefixSum::Init( void )
+{
+  if ( _initialized )
+    return true;
+  _initialized = true;
+
+  bool valid = true;
+  for ( size_t pass = 0; pass < _prog.size(); ++ pass )
+  {
+    std::string msg;
+
+    auto comp_shader = std::make_shared<CShaderObject>( Render::Program::TShaderType::compute );
+    *comp_shader << "#version 430\n#define PASS " + std::to_string( pass + 1 ) + "\n" + _comp_430;
+    comp_shader->Compile();
+    if ( comp_shader->Verify( msg ) == false )
+    {
+      Error( "compile error", msg );
+      valid = false;
+    }
+
+    _prog[pass] = std::make_shared<CShaderProgram>();
+    *_prog[pass] << comp_shader;
+    _prog[pass]->Link();
+    if ( _prog[pass]->Verify( msg ) == false )
+    {
+      Error( "link error", msg );
+      valid = false;
+    }
+
+    GLuint program_obj = (GLuint)_prog[pass]->ObjectHandle();
+    _no_of_vertices_loc[pass] = glGetUniformLocation( program_obj, "u_no_of_vertices" );
+    if ( pass == 1 )
+      _no_of_blocks_loc = glGetUniformLocation( program_obj, "u_no_of_blocks" );
+  }
+
+  glGenBuffers( 1, &_block_buffer );
+  return valid;
+}
+
+
+/******************************************************************//**
+* \brief Compute the arc length of the vertices in place.
+*
+* The result is visible to shader storage buffer reads of subsequent
+* draw calls.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CArcLengthPrefixSum::Compute(
+  unsigned int vertex_buffer,  //!< in: shader storage buffer with the vertices (`vec4`)
+  size_t       no_of_vertices ) //!< in: number of vertices
+{
+  if ( _initialized == false )
+  {
+    ASSERT( false );
+    return false;
+  }
+  if ( no_of_vertices == 0 )
+    return true;
+
+  // 4 values (16 bytes) per block
+  GLuint no_of_blocks = (GLuint)((no_of_vertices + c_block_size - 1) / c_block_size);
+  size_t block_buffer_size = no_of_blocks * 4 * sizeof(GLuint);
+  if ( block_buffer_size > _block_buffer_size )
+  {
+    _block_buffer_size = block_buffer_size;
+    glBindBuffer( GL_SHADER_STORAGE_BUFFER, _block_buffer );
+    glBufferData( GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)_block_buffer_size, nullptr, GL_DYNAMIC_COPY );
+    glBindBuffer( GL_SHADER_STORAGE_BUFFER, 0 );
+  }
+  glBindBufferBase( GL_SHADER_STORAGE_BUFFER, 0, vertex_buffer );
+  glBindBufferBase( GL_SHADER_STORAGE_BUFFER, 1, _block_buffer );
+
+  std::array<GLuint, 3> groups{ no_of_blocks, 1, no_of_blocks };
+  for ( size_t pass = 0; pass < _prog.size(); ++ pass )
+  {
+    _prog[pass]->Use();
+    glUniform1ui( _no_of_vertices_loc[pass], (GLuint)no_of_vertices );
+    if ( pass == 1 )
+      glUniform1ui( _no_of_blocks_loc, no_of_blocks );
+    glDispatchCompute( groups[pass], 1, 1 );
+    glMemoryBarrier( GL_SHADER_STORAGE_BARRIER_BIT );
+  }
+
+  return true;
+}
+
+
+} // Line
+
+
+} // OpenGL
@@ -285,7 +285,9 @@ Render::Line::IRender & CLineOpenGL_base_OpenGL4_OpenGLES3::SetStyle(
     assert( false );
     return *this;
   }
-  _primitive_prog->SetDeptAttenuation( _line_style._depth_attenuation );
+  // the pending lines are drawn with the current line width and stipple pattern
+  _primitive_prog->Flush();
+  _primitive_prog->SetDeptAttenuation( style._depth_attenuation );
 
   _line_style = style;
 
@@ -336,20 +338,9 @@ bool CLineOpenGL_base_OpenGL4_OpenGLES3::Draw(
   ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
   auto &prog = *_primitive_prog;
 
-  // activate program, update uniforms and enable vertex attributes
+  // draw the line, or append it to the pending batch, if successive drawing is enabled
   Render::TVA va_type = tuple_size == 4 ? Render::b0_xyzw : (tuple_size == 2 ? Render::b0_xy : Render::b0_xyz);
-  prog.ActivateProgram( va_type );
-
-  // set vertex attribute pointer and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-    buffer->UpdateVB( 0, tuple_size*sizeof(float), coords_size, coords );
-  
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( primitive_type ), 0, (GLsizei)(coords_size / tuple_size) );
-  
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  prog.Draw( primitive_type, va_type, coords_size / tuple_size, tuple_size*sizeof(float), coords );
 
   return true;
 }
@@ -377,20 +368,9 @@ bool CLineOpenGL_base_OpenGL4_OpenGLES3::Draw(
   ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
   auto &prog = *_primitive_prog;
 
-  // activate program, update uniforms and enable vertex attributes
+  // draw the line, or append it to the pending batch, if successive drawing is enabled
   Render::TVA va_type = tuple_size == 4 ? Render::d__b0_xyzw : (tuple_size == 2 ? Render::d__b0_xy : Render::d__b0_xyz);
-  prog.ActivateProgram( va_type );
-
-  // set vertex attribute pointer and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-    buffer->UpdateVB( 0, 3, coords_size*sizeof(double), coords );
-
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( primitive_type ), 0, (GLsizei)(coords_size / tuple_size) );
- 
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  prog.Draw( primitive_type, va_type, coords_size / tuple_size, tuple_size*sizeof(double), coords );
 
   return true;
 }
@@ -418,22 +398,8 @@ bool CLineOpenGL_base_OpenGL4_OpenGLES3::Draw(
   ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
   auto &prog = *_primitive_prog;
 
-  // activate program, update uniforms and enable vertex attributes
-  prog.ActivateProgram( Render::b0_x__b1_y );
-
-  // set vertex attribute pointers and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-  {
-    buffer->UpdateVB( 0, sizeof(float), no_of_coords, x_coords );
-    buffer->UpdateVB( 1, sizeof(float), no_of_coords, y_coords );
-  }
-
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( primitive_type ), 0, (GLsizei)no_of_coords );
-   
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  // draw the line, or append it to the pending batch, if successive drawing is enabled
+  prog.Draw( primitive_type, Render::b0_x__b1_y, no_of_coords, sizeof(float), x_coords, y_coords );
 
   return true;
 }
@@ -461,22 +427,8 @@ bool CLineOpenGL_base_OpenGL4_OpenGLES3::Draw(
   ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
   auto &prog = *_primitive_prog;
 
-  // activate program, update uniforms and enable vertex attributes
-  prog.ActivateProgram( Render::d__b0_x__b1_y );
-
-  // set vertex attribute pointers and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-  {
-    buffer->UpdateVB( 0, sizeof(double), no_of_coords, x_coords );
-    buffer->UpdateVB( 1, sizeof(double), no_of_coords, y_coords );
-  }
-
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( primitive_type ), 0, (GLsizei)no_of_coords );
-
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  // draw the line, or append it to the pending batch, if successive drawing is enabled
+  prog.Draw( primitive_type, Render::d__b0_x__b1_y, no_of_coords, sizeof(double), x_coords, y_coords );
 
   return true;
 }
@@ -527,23 +479,10 @@ bool CLineOpenGL_base_OpenGL4_OpenGLES3::EndSequence( void )
   }
   auto &prog = *_primitive_prog;
 
-  // draw the line
-
-  // activate program, update uniforms and enable vertex attributes
-  GLsizei tuple_size = (GLsizei)_vertex_cache.TupleSize();
+  // draw the line, or append it to the pending batch, if successive drawing is enabled
+  size_t tuple_size = _vertex_cache.TupleSize();
   Render::TVA va_type = tuple_size == 4 ? Render::b0_xyzw : (tuple_size == 2 ? Render::b0_xy : Render::b0_xyz);
-  prog.ActivateProgram( va_type );
-
-  //  set vertex attribute pointer and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-    buffer->UpdateVB( 0, tuple_size*sizeof(float), _vertex_cache.SequenceSize(),_vertex_cache.VertexData() );
-
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( _squence_type ), 0, (GLsizei)(_vertex_cache.SequenceSize() / tuple_size) );
-  
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  prog.Draw( _squence_type, va_type, _vertex_cache.SequenceSize() / tuple_size, tuple_size*sizeof(float), _vertex_cache.VertexData() );
   _vertex_cache.Reset();
   
   return true;
@@ -648,6 +587,29 @@ bool CLineOpenGL_base_OpenGL4_OpenGLES3::DrawSequence(
 }
 
 
+/******************************************************************//**
+* \brief Append elements to an active line sequence and return them,
+* so that the vertex coordinates can be written in place.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::span<float> CLineOpenGL_base_OpenGL4_OpenGLES3::MapSequence( 
+  size_t coords_size ) //!< in: number of elements - `coords_size` = `tuple_size` * "number of coordinates"
+{
+  // A sequence has to be active, to specify new vertex coordinates
+  if ( _primitive_prog == nullptr || _primitive_prog->ActiveSequence() == false )
+  {
+    ASSERT( false );
+    return std::span<float>();
+  }
+
+  // the coordinates are written directly to the cache
+  return _vertex_cache.Map( coords_size );
+}
+
+
 } // Line
 
 
@@ -1,8 +1,8 @@
 /******************************************************************//**
 * \brief Implementation of OpenGL line renderer,
 * with the use of "modern" OpenGL (4+) and hight quality shaders,
-* for OpenGL version 4+ and GLSL version 4.20 (`#version 420`).
-* 
+* for OpenGL version 4.3+ and GLSL version 4.30 (`#version 430`).
+*
 * \author  gernot
 * \date    2018-08-01
 * \version 1.0
@@ -13,19 +13,30 @@
 // includes
 
 #include "../../include/OpenGL/OpenGLLine_highquality.h"
+#include "../../include/OpenGL/OpenGLProgram.h"
+#include "../../include/OpenGL/OpenGLStateCache.h"
+#include "../../include/util/RenderUtil_ArcLength.h"
 
 
 // OpenGL wrapper
 
 #include "../../include/OpenGL/OpenGL_include.h"
+#include "../../include/OpenGL/OpenGL_enumconst.h"
+
+
+// STL
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
 
 
 // class definitions
 
 
 /******************************************************************//**
-* \brief General namespace for OpenGL implementation.  
-* 
+* \brief General namespace for OpenGL implementation.
+*
 * \author  gernot
 * \date    2018-09-07
 * \version 1.0
@@ -35,8 +46,8 @@ namespace OpenGL
 
 
 /******************************************************************//**
-* \brief Namespace for drawing lines with the use of OpenGL.  
-* 
+* \brief Namespace for drawing lines with the use of OpenGL.
+*
 * \author  gernot
 * \date    2018-09-07
 * \version 1.0
@@ -45,30 +56,1023 @@ namespace Line
 {
 
 
+/*!
+
+Each instance of the draw call generates the geometry of one vertex `k` of a polyline (12 vertices, 4 triangles):
+
+- vertex 0 - 5: quad of the segment from vertex `k` to vertex `k+1`,
+  the ends are mitered if the join is a miter and the miter length is within the limit,
+  else they are perpendicular to the segment
+
+- vertex 6 - 11: join of the segments at vertex `k` (bevel triangle or a square, which is clipped to a circle by the fragment shader)
+  or the cap at an open end (square, which is clipped to a half circle for round caps)
+
+Unused triangles are collapsed to a point.
+The polyline of an instance is found by a binary search in the offsets buffer.
+The corners are computed in window space (pixel), so the width of the line is independent of the projection.
+
+The arc length of the vertices is the length along the polyline in the space of the coordinates.
+It is scaled by the ratio of the pixel length and the length of each segment, so the stipple pattern is evaluated in pixel.
+The ratio is per segment, so under a perspective projection the pattern is not continuous at the vertices
+(see the limitation in `OpenGLLine_highquality.h`).
+
+*/
+
+const std::string CLineHighQuality::_vert_430 = R"(
+#version 430
+
+layout (std140, binding = 1) uniform UB_ViewData
+{
+    mat4  _model;      // model matrix
+    mat4  _view;       // view matrix
+    mat4  _projection; // projection matrix
+    vec4  _vp_rect;    // viewport rectangle
+    float _near;       // near plane
+    float _far;        // far plane
+
+} view_data;
+
+layout (std430, binding = 2) buffer TVertices
+{
+    vec4 vertex[];    // x, y, z, arc length
+};
+
+layout (std430, binding = 3) buffer TPolylines
+{
+    uvec2 polyline[]; // first vertex, number of vertices | kind << 30
+};
+
+uniform vec4  u_color;
+uniform float u_depth_att;
+uniform float u_width;
+uniform int   u_join;             // 0: miter, 1: bevel, 2: round
+uniform int   u_cap;              // 0: butt, 1: square, 2: round
+uniform float u_miter_limit;
+uniform int   u_no_of_polylines;
+
+out vec4 v_color;
+noperspective out vec2  v_round;        // position relative to the center of a round join or cap in pixel
+flat          out float v_round_radius; // radius of a round join or cap in pixel; 0.0: no round join or cap
+noperspective out float v_arc;          // arc length in pixel
+
+int  g_first;
+int  g_count;
+bool g_closed;
+bool g_adjacency;
+
+const int c_quad[6] = int[6](0, 1, 2, 0, 2, 3);
+
+int Index(int k)
+{
+    return g_first + (g_closed ? (k + g_count) % g_count : clamp(k, 0, g_count-1));
+}
+
+vec4 ClipPos(int k)
+{
+    return view_data._projection * view_data._view * view_data._model * vec4(vertex[Index(k)].xyz, 1.0);
+}
+
+vec2 WindowPos(vec4 clip)
+{
+    return (clip.xy / clip.w * 0.5 + 0.5) * view_data._vp_rect.zw;
+}
+
+vec4 ClipFromWindow(vec2 win, vec4 clip)
+{
+    return vec4((win / view_data._vp_rect.zw * 2.0 - 1.0) * clip.w, clip.zw);
+}
+
+bool HasSegment(int k)
+{
+    if (g_closed)
+        return g_count > 1;
+    if (g_adjacency)
+        return k >= 1 && k <= g_count-3;
+    return k < g_count-1;
+}
+
+bool HasJoin(int k)
+{
+    if (g_closed)
+        return g_count > 2;
+    if (g_adjacency)
+        return k >= 1 && k <= g_count-2;
+    return k > 0 && k < g_count-1;
+}
+
+vec2 Direction(vec2 a, vec2 b)
+{
+    vec2  d   = b - a;
+    float len = length(d);
+    return len > 1.0e-6 ? d / len : vec2(0.0);
+}
+
+vec2 Normal(vec2 d)
+{
+    return vec2(-d.y, d.x);
+}
+
+// pixel per unit of the arc length along the segment from k to k+1
+float ArcScale(int k, vec2 win_a, vec2 win_b)
+{
+    float len = distance(vertex[Index(k)].xyz, vertex[Index(k+1)].xyz);
+    return len > 0.0 ? distance(win_a, win_b) / len : 0.0;
+}
+
+// offset of the left side of the miter at a join
+bool MiterOffset(vec2 d0, vec2 d1, float h, out vec2 offset)
+{
+    vec2  n1    = Normal(d1);
+    vec2  m     = Normal(d0) + n1;
+    float m_len = length(m);
+    offset      = n1 * h;
+    if (d0 == vec2(0.0) || d1 == vec2(0.0) || m_len < 1.0e-6)
+        return false;
+    m /= m_len;
+    float c = dot(m, n1);
+    if (c <= 0.0 || 1.0 / c > u_miter_limit)
+        return false;
+    offset = m * h / c;
+    return true;
+}
+
+void main()
+{
+    // find the polyline of the instance
+    int lo = 0;
+    int hi = u_no_of_polylines - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) / 2;
+        if (int(polyline[mid].x) <= gl_InstanceID)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    uint kind   = polyline[lo].y >> 30;
+    g_first     = int(polyline[lo].x);
+    g_count     = int(polyline[lo].y & 0x3FFFFFFFu);
+    g_closed    = (kind & 1u) != 0u;
+    g_adjacency = (kind & 2u) != 0u;
+    int k       = gl_InstanceID - g_first;
+
+    float h          = max(u_width, 1.0) * 0.5;
+    vec4  clip_k     = ClipPos(k);
+    vec2  win_k      = WindowPos(clip_k);
+    vec4  clip       = clip_k;
+    vec2  win        = win_k;
+    float arc        = vertex[Index(k)].w;
+    vec2  round_pos  = vec2(0.0);
+    float round_rad  = 0.0;
+    bool  valid      = false;
+
+    if (gl_VertexID < 6)
+    {
+        // quad of the segment from k to k+1
+        int   corner = c_quad[gl_VertexID];
+        bool  at_end = corner == 1 || corner == 2;
+        float side   = corner < 2 ? -1.0 : 1.0;
+        valid = HasSegment(k);
+        if (valid)
+        {
+            vec4 clip_n = ClipPos(k+1);
+            vec2 win_n  = WindowPos(clip_n);
+            vec2 d      = Direction(win_k, win_n);
+            vec2 offset = Normal(d) * h;
+            if (u_join == 0 && HasJoin(at_end ? k+1 : k))
+            {
+                vec2 miter;
+                bool is_miter = at_end
+                    ? MiterOffset(d, Direction(win_n, WindowPos(ClipPos(k+2))), h, miter)
+                    : MiterOffset(Direction(WindowPos(ClipPos(k-1)), win_k), d, h, miter);
+                if (is_miter)
+                    offset = miter;
+            }
+            clip = at_end ? clip_n : clip_k;
+            win  = (at_end ? win_n : win_k) + side * offset;
+            arc  = arc * ArcScale(k, win_k, win_n) + dot(win - win_k, d);
+        }
+    }
+    else if (HasJoin(k))
+    {
+        // join of the segments at k
+        vec2 win_p = WindowPos(ClipPos(k-1));
+        vec2 win_n = WindowPos(ClipPos(k+1));
+        vec2 d0    = Direction(win_p, win_k);
+        vec2 d1    = Direction(win_k, win_n);
+        float scale = ArcScale(k, win_k, win_n);
+        arc *= scale > 0.0 ? scale : ArcScale(k-1, win_p, win_k);
+        vec2 miter;
+        if (u_join == 2)
+        {
+            int corner = c_quad[gl_VertexID-6];
+            round_pos  = vec2(corner == 1 || corner == 2 ? h : -h, corner < 2 ? -h : h);
+            round_rad  = h;
+            win        = win_k + round_pos;
+            valid      = true;
+        }
+        else if (u_join == 1 || MiterOffset(d0, d1, h, miter) == false)
+        {
+            // bevel triangle on the outer side of the turn
+            int   corner = gl_VertexID-6;
+            float outer  = d0.x*d1.y - d0.y*d1.x > 0.0 ? -1.0 : 1.0;
+            win   = win_k + (corner == 1 ? outer * h * Normal(d0) : (corner == 2 ? outer * h * Normal(d1) : vec2(0.0)));
+            valid = corner < 3;
+        }
+    }
+    else if (u_cap != 0 && g_closed == false && g_adjacency == false && g_count > 1 && (k == 0 || k == g_count-1))
+    {
+        // cap at an open end; `e` points outwards
+        bool  at_start = k == 0;
+        vec2  win_o    = WindowPos(ClipPos(at_start ? 1 : k-1));
+        vec2  e        = Direction(win_o, win_k);
+        int   corner   = c_quad[gl_VertexID-6];
+        float side     = corner < 2 ? -1.0 : 1.0;
+        arc *= at_start ? ArcScale(0, win_k, win_o) : ArcScale(k-1, win_o, win_k);
+        win        = win_k + side * h * Normal(e) + (corner == 1 || corner == 2 ? h * e : vec2(0.0));
+        round_pos  = win - win_k;
+        round_rad  = u_cap == 2 ? h : 0.0;
+        valid      = e != vec2(0.0);
+    }
+
+    gl_Position    = valid ? ClipFromWindow(win, clip) : vec4(0.0, 0.0, 0.0, 1.0);
+    v_round        = round_pos;
+    v_round_radius = round_rad;
+    v_arc          = arc;
+
+    float depth = 0.5 + 0.5 * clip.z / clip.w;
+    v_color     = vec4( mix(u_color.rgb, vec3(0.0), depth * u_depth_att), u_color.a );
+}
+)";
+
+
+const std::string CLineHighQuality::_frag_430 = R"(
+#version 430
+
+in vec4 v_color;
+noperspective in vec2  v_round;
+flat          in float v_round_radius;
+noperspective in float v_arc;
+
+uniform uint  u_stipple_pattern;
+uniform float u_stipple_factor;
+
+out vec4 frag_color;
+
+void main()
+{
+    if (v_round_radius > 0.0 && dot(v_round, v_round) > v_round_radius * v_round_radius)
+        discard;
+
+    uint bit = uint(floor(max(v_arc, 0.0) / u_stipple_factor)) & 15u;
+    if ((u_stipple_pattern & (1u << bit)) == 0u)
+        discard;
+
+    frag_color = v_color;
+}
+)";
+
+
 /******************************************************************//**
-* \brief ctor  
-* 
+* \brief ctor
+*
 * \author  gernot
 * \date    2018-09-07
 * \version 1.0
 **********************************************************************/
-CLineHighQuality::CLineHighQuality( void )
-{}
+CLineHighQuality::CLineHighQuality(
+  size_t min_cache_elems ) //!< I - size of the element cache
+  : _vertex_cache( min_cache_elems )
+{
+  _vertices.reserve( min_cache_elems * 4 / 3 );
+}
 
 
 /******************************************************************//**
-* \brief ctor  
-* 
+* \brief dtor
+*
 * \author  gernot
 * \date    2018-09-07
 * \version 1.0
 **********************************************************************/
 CLineHighQuality::~CLineHighQuality()
-{}
+{
+  if ( _ssbo[0] != 0 )
+    glDeleteBuffers( (GLsizei)_ssbo.size(), _ssbo.data() );
+  if ( _vao != 0 )
+    CStateCache::Current().DeleteVertexArrays( 1, &_vao );
+}
+
+
+/******************************************************************//**
+* \brief Trace error message.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CLineHighQuality::Error(
+  const std::string &kind,     //!< in: message kind
+  const std::string &message ) //!< in: error message
+{
+  std::cout << kind << ": " << message;
+}
+
+
+/******************************************************************//**
+* \brief Initialize the line renderer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::Init( void )
+{
+  if ( _initialized )
+    return true;
+
+  TMVPBufferPtr mvp_buffer;
+  return Init( mvp_buffer );
+}
+
+
+/******************************************************************//**
+* \brief Initialize the line renderer.
+*
+* For the initialization a current and valid OpenGL context is required.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::Init(
+  Render::TModelAndViewPtr mvp_data ) //!< I - model, view, projection and window data buffer
+{
+  if ( _initialized )
+    return true;
+
+  TMVPBufferPtr mvp_buffer;
+  if ( mvp_data != nullptr )
+  {
+    static const size_t c_default_binding = 1;
+    mvp_buffer = std::make_unique<CModelAndViewBuffer_std140>();
+    mvp_buffer->Init( c_default_binding, mvp_data );
+  }
+
+  return Init( mvp_buffer );
+}
+
+
+/******************************************************************//**
+* \brief Initialize the line renderer.
+*
+* For the initialization a current and valid OpenGL context is required.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::Init(
+  TMVPBufferPtr mvp_buffer ) //!< I - model, view, projection and window data buffer
+{
+  if ( _initialized )
+    return true;
+  _initialized = true;
+
+  static const size_t c_default_binding = 1;
+  _mvp_buffer = mvp_buffer != nullptr ? mvp_buffer : std::make_unique<CModelAndViewBuffer_std140>();
+  _mvp_buffer->Init( c_default_binding ); // `c_default_binding` is applied only, if the buffer was not initialized yet
+
+  InitProgram();
+  InitBuffers();
+
+  // fall back to the CPU, if the compute shaders can't be used
+  if ( _arc_length.Init() == false )
+    _gpu_arc_length = false;
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Initialize shader program.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CLineHighQuality::InitProgram( void )
+{
+  if ( _prog != nullptr )
+    return;
+
+  std::string msg;
+
+  // compile shader objects
+
+  auto vert_shader = std::make_shared<CShaderObject>( Render::Program::TShaderType::vertex );
+  *vert_shader << _vert_430;
+  vert_shader->Compile();
+  if ( vert_shader->Verify( msg ) == false )
+    Error( "compile error", msg );
+
+  auto frag_shader = std::make_shared<CShaderObject>( Render::Program::TShaderType::fragment );
+  *frag_shader << _frag_430;
+  frag_shader->Compile();
+  if ( frag_shader->Verify( msg ) == false )
+    Error( "compile error", msg );
+
+
+  // link shader programs
+
+  _prog = std::make_shared<CShaderProgram>();
+  *_prog << vert_shader << frag_shader;
+  _prog->Link();
+  if ( _prog->Verify( msg ) == false )
+    Error( "link error", msg );
+
+  GLuint program_obj = (GLuint)_prog->ObjectHandle();
+  _view_data_loc         = glGetUniformBlockIndex( program_obj, "UB_ViewData" );
+  _color_loc             = glGetUniformLocation(   program_obj, "u_color" );
+  _depth_attenuation_loc = glGetUniformLocation(   program_obj, "u_depth_att" );
+  _width_loc             = glGetUniformLocation(   program_obj, "u_width" );
+  _join_loc              = glGetUniformLocation(   program_obj, "u_join" );
+  _cap_loc               = glGetUniformLocation(   program_obj, "u_cap" );
+  _miter_limit_loc       = glGetUniformLocation(   program_obj, "u_miter_limit" );
+  _no_of_polylines_loc   = glGetUniformLocation(   program_obj, "u_no_of_polylines" );
+  _stipple_pattern_loc   = glGetUniformLocation(   program_obj, "u_stipple_pattern" );
+  _stipple_factor_loc    = glGetUniformLocation(   program_obj, "u_stipple_factor" );
+
+  if ( _mvp_buffer != nullptr && (GLuint)_view_data_loc != GL_INVALID_INDEX )
+    glUniformBlockBinding( program_obj, (GLuint)_view_data_loc, (GLuint)_mvp_buffer->BufferBinding() );
+}
+
+
+/******************************************************************//**
+* \brief Initialize the vertex array object and the shader storage
+* buffers.
+*
+* The vertex array object has no attributes, the vertices are read
+* from the storage buffers.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CLineHighQuality::InitBuffers( void )
+{
+  if ( _vao != 0 )
+    return;
+
+  glGenVertexArrays( 1, &_vao );
+  glGenBuffers( (GLsizei)_ssbo.size(), _ssbo.data() );
+}
+
+
+/******************************************************************//**
+* \brief Notify the render that a sequence of successive lines will
+* follow, that is not interrupted by any other drawing operation.
+*
+* The lines are collected and drawn by a single draw call, when the
+* color or the style changes or the sequence is finished.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::StartSuccessiveLineDrawings( void )
+{
+  if ( _initialized == false || _active_sequence )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  if ( _successive_drawing )
+    return false;
+  _successive_drawing = true;
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Notify the renderer that a sequence of lines has been
+* finished, and that the internal states have to be restored.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::FinishSuccessiveLineDrawings( void )
+{
+  if ( _initialized == false || _active_sequence )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  Flush();
+  _successive_drawing = false;
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Set the stroke color of the line.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+Render::Line::IRender & CLineHighQuality::SetColor(
+  const Render::TColor & color ) //!< in: new color
+{
+  // the pending lines are drawn with the current color
+  if ( color != _color )
+    Flush();
+
+  _color = color;
+  return *this;
+}
+
+
+/******************************************************************//**
+* \brief Set the stroke color of the line.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+Render::Line::IRender & CLineHighQuality::SetColor(
+  const Render::TColor8 & color ) //!< in: new color
+{
+  return SetColor( Render::toColor( color ) );
+}
+
+
+/******************************************************************//**
+* \brief Change the current line style, for the pending line drawing
+* instructions.
+*
+* The line style can't be changed within a drawing sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+Render::Line::IRender & CLineHighQuality::SetStyle(
+  const Render::Line::TStyle & style ) //!< in: new line style
+{
+  if ( _active_sequence )
+  {
+    ASSERT( false );
+    return *this;
+  }
+
+  // the pending lines are drawn with the current line style
+  Flush();
+  _line_style = style;
+
+  return *this;
+}
+
+
+/******************************************************************//**
+* \brief Draw a single line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::Draw(
+  Render::TPrimitive primitive_type, //!< in: primitive type of the coordinates - lines, line strip, line loop, lines adjacency or line strip adjacency
+  unsigned int       tuple_size,     //!< in: kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)
+  size_t             coords_size,    //!< in: number of elements (size) of the coordinate array - `coords_size` = `tuple_size` * "number of coordinates"
+  const float       *coords )        //!< in: pointer to an array of the vertex coordinates
+{
+  return AddLines<float>( primitive_type, tuple_size, coords_size / tuple_size, coords, nullptr );
+}
+
+
+/******************************************************************//**
+* \brief Draw a single line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::Draw(
+  Render::TPrimitive primitive_type, //!< in: primitive type of the coordinates - lines, line strip, line loop, lines adjacency or line strip adjacency
+  unsigned int       tuple_size,     //!< in: kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)
+  size_t             coords_size,    //!< in: number of elements (size) of the coordinate array - `coords_size` = `tuple_size` * "number of coordinates"
+  const double      *coords )        //!< in: pointer to an array of the vertex coordinates
+{
+  return AddLines<double>( primitive_type, tuple_size, coords_size / tuple_size, coords, nullptr );
+}
+
+
+/******************************************************************//**
+* \brief Draw a single line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::Draw(
+  Render::TPrimitive primitive_type, //!< in: primitive type of the coordinates - lines, line strip, line loop, lines adjacency or line strip adjacency
+  size_t             no_of_coords,   //!< in: number of coordinates and number of elements (size) of the coordinate array
+  const float       *x_coords,       //!< in: pointer to an array of the x coordinates
+  const float       *y_coords )      //!< in: pointer to an array of the y coordinates
+{
+  return AddLines<float>( primitive_type, 2, no_of_coords, x_coords, y_coords );
+}
+
+
+/******************************************************************//**
+* \brief Draw a single line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::Draw(
+  Render::TPrimitive primitive_type, //!< in: primitive type of the coordinates - lines, line strip, line loop, lines adjacency or line strip adjacency
+  size_t             no_of_coords,   //!< in: number of coordinates and number of elements (size) of the coordinate array
+  const double      *x_coords,       //!< in: pointer to an array of the x coordinates
+  const double      *y_coords )      //!< in: pointer to an array of the y coordinates
+{
+  return AddLines<double>( primitive_type, 2, no_of_coords, x_coords, y_coords );
+}
+
+
+/******************************************************************//**
+* \brief Start a new line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::StartSequence(
+  Render::TPrimitive primitive_type, //!< in: primitive type of the coordinates - lines, line strip, line loop, lines adjacency or line strip adjacency
+  unsigned int       tuple_size )    //!< in: kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)
+{
+  // A new sequence can't be started within an active sequence
+  if ( _initialized == false || _active_sequence )
+  {
+    ASSERT( false );
+    return false;
+  }
+  ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
+
+  _active_sequence = true;
+  _vertex_cache.TupleSize( tuple_size );
+  _squence_type = primitive_type;
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Complete an active line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::EndSequence( void )
+{
+  // A sequence can't be completed if there is no active sequence
+  if ( _active_sequence == false )
+  {
+    ASSERT( false );
+    return false;
+  }
+  _active_sequence = false;
+
+  // draw the line, or append it to the pending polylines, if successive drawing is enabled
+  unsigned int tuple_size = (unsigned int)_vertex_cache.TupleSize();
+  bool ret = AddLines<float>( _squence_type, tuple_size, _vertex_cache.SequenceSize() / tuple_size, _vertex_cache.VertexData(), nullptr );
+  _vertex_cache.Reset();
+
+  return ret;
+}
+
+
+/******************************************************************//**
+* \brief Specify a new vertex coordinate in an active line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::DrawSequence(
+  float x,  //!< in: x coordinate
+  float y,  //!< in: y coordinate
+  float z ) //!< in: z coordinate
+{
+  // A sequence has to be active, to specify a new vertex coordinate
+  if ( _active_sequence == false )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  // add vertex coordinate to cache
+  _vertex_cache.Add( x, y, z );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Specify a new vertex coordinate in an active line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::DrawSequence(
+  double x,  //!< in: x coordinate
+  double y,  //!< in: y coordinate
+  double z ) //!< in: z coordinate
+{
+  // A sequence has to be active, to specify a new vertex coordinate
+  if ( _active_sequence == false )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  // add vertex coordinate to cache
+  _vertex_cache.Add( x, y, z );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Specify a sequence of new vertex coordinates in an active line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::DrawSequence(
+  size_t       coords_size, //!< in: number of elements (size) of the coordinate array - `coords_size` = `tuple_size` * "number of coordinates"
+  const float *coords )     //!< in: pointer to an array of the vertex coordinates
+{
+  // A sequence has to be active, to specify new vertex coordinates
+  if ( _active_sequence == false )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  // add the vertex coordinates to the cache
+  _vertex_cache.Add( coords_size, coords );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Specify a sequence of new vertex coordinates in an active line sequence.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::DrawSequence(
+  size_t        coords_size, //!< in: number of elements (size) of the coordinate array - `coords_size` = `tuple_size` * "number of coordinates"
+  const double *coords )     //!< in: pointer to an array of the vertex coordinates
+{
+  // A sequence has to be active, to specify new vertex coordinates
+  if ( _active_sequence == false )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  // add the vertex coordinates to the cache
+  _vertex_cache.Add( coords_size, coords );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Split the vertices of a primitive into polylines and append
+* them to the pending polylines.
+*
+* If successive drawing is not enabled, then the lines are drawn
+* immediately.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template <typename T>
+bool CLineHighQuality::AddLines(
+  Render::TPrimitive primitive_type, //!< in: primitive type of the coordinates
+  unsigned int       tuple_size,     //!< in: kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)
+  size_t             no_of_vertices, //!< in: number of vertices
+  const T           *coords,         //!< in: vertex coordinates, or x coordinates if `y_coords` is not `nullptr`
+  const T           *y_coords )      //!< in: y coordinates or `nullptr`
+{
+  // A new sequence can't be started within an active sequence
+  if ( _initialized == false || _active_sequence || tuple_size < 2 || tuple_size > 4 )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  switch ( primitive_type )
+  {
+    default:
+      ASSERT( false );
+      return false;
+
+    case Render::TPrimitive::lines:
+      for ( size_t i = 0; i + 1 < no_of_vertices; i += 2 )
+        AddPolyline( e_open, tuple_size, i, 2, coords, y_coords );
+      break;
+
+    case Render::TPrimitive::linestrip:
+      AddPolyline( e_open, tuple_size, 0, no_of_vertices, coords, y_coords );
+      break;
+
+    case Render::TPrimitive::lineloop:
+      AddPolyline( e_closed, tuple_size, 0, no_of_vertices, coords, y_coords );
+      break;
+
+    case Render::TPrimitive::lines_adjacency:
+      for ( size_t i = 0; i + 3 < no_of_vertices; i += 4 )
+        AddPolyline( e_adjacency, tuple_size, i, 4, coords, y_coords );
+      break;
+
+    case Render::TPrimitive::linestrip_adjacency:
+      AddPolyline( e_adjacency, tuple_size, 0, no_of_vertices, coords, y_coords );
+      break;
+  }
+
+  if ( _successive_drawing == false )
+    return Flush();
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Append a polyline to the pending polylines.
+*
+* Homogeneous coordinates are divided by `w`. The 4th component marks
+* the first vertex of the polyline; it is replaced by the arc length
+* when the polylines are drawn.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template <typename T>
+void CLineHighQuality::AddPolyline(
+  TPolylineKind kind,           //!< in: kind of the polyline
+  unsigned int  tuple_size,     //!< in: kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)
+  size_t        first,          //!< in: index of the first vertex in the coordinate arrays
+  size_t        no_of_vertices, //!< in: number of vertices of the polyline
+  const T      *coords,         //!< in: vertex coordinates, or x coordinates if `y_coords` is not `nullptr`
+  const T      *y_coords )      //!< in: y coordinates or `nullptr`
+{
+  static const size_t c_max_vertices = 0x3FFFFFFF;
+  if ( no_of_vertices < 2 || no_of_vertices > c_max_vertices )
+    return;
+
+  size_t first_vertex = _vertices.size() / 4;
+
+  for ( size_t i = first; i < first + no_of_vertices; ++ i )
+  {
+    float marker = i == first ? Render::c_arc_length_polyline_start : Render::c_arc_length_polyline_vertex;
+    if ( y_coords != nullptr )
+    {
+      _vertices.insert( _vertices.end(), { (float)coords[i], (float)y_coords[i], 0.0f, marker } );
+      continue;
+    }
+
+    const T *v = coords + i * tuple_size;
+    double w = tuple_size == 4 && v[3] != 0 ? (double)v[3] : 1.0;
+    float  z = tuple_size >= 3 ? (float)(v[2] / w) : 0.0f;
+    _vertices.insert( _vertices.end(), { (float)(v[0] / w), (float)(v[1] / w), z, marker } );
+  }
+
+  _polylines.push_back( (std::uint32_t)first_vertex );
+  _polylines.push_back( (std::uint32_t)no_of_vertices | ((std::uint32_t)kind << 30) );
+
+  ++ _statistics._polylines;
+  _statistics._vertices += no_of_vertices;
+}
+
+
+/******************************************************************//**
+* \brief Draw the pending polylines by a single instanced draw call.
+*
+* The storage buffers are orphaned and respecified, so the driver
+* doesn't have to wait for the previous draw call. The arc length of
+* the vertices is computed in the vertex buffer by a compute shader,
+* or on the CPU before the upload.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CLineHighQuality::Flush( void )
+{
+  if ( _polylines.empty() )
+    return true;
+  if ( _initialized == false )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  size_t no_of_vertices = _vertices.size() / 4;
+  if ( _gpu_arc_length == false )
+    Render::ArcLengthPrefixSum( no_of_vertices, _vertices.data() );
+
+  // upload the vertices and the polylines
+  std::array<const void*, 2> data{ _vertices.data(), _polylines.data() };
+  std::array<size_t, 2>      size{ _vertices.size() * sizeof(float), _polylines.size() * sizeof(std::uint32_t) };
+  for ( size_t i = 0; i < _ssbo.size(); ++ i )
+  {
+    glBindBuffer( GL_SHADER_STORAGE_BUFFER, _ssbo[i] );
+    if ( size[i] > _ssbo_size[i] )
+    {
+      _ssbo_size[i] = size[i];
+      glBufferData( GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)size[i], data[i], GL_STREAM_DRAW );
+    }
+    else
+    {
+      glBufferData( GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)_ssbo_size[i], nullptr, GL_STREAM_DRAW );
+      glBufferSubData( GL_SHADER_STORAGE_BUFFER, 0, (GLsizeiptr)size[i], data[i] );
+    }
+    glBindBufferBase( GL_SHADER_STORAGE_BUFFER, (GLuint)(2 + i), _ssbo[i] );
+  }
+  glBindBuffer( GL_SHADER_STORAGE_BUFFER, 0 );
+
+  if ( _gpu_arc_length )
+    _arc_length.Compute( _ssbo[0], no_of_vertices );
+
+  // stipple pattern; the factor is the line width, as with `glLineStipple`
+  static const std::array<GLuint, 8> patterns
+  {
+    0x0000, 0xFFFF, 0x5555, 0x3333, 0x0F0F, 0x00FF, 0x7D7D, 0x7FFD
+  };
+  int stipple_type = _line_style._stipple_type;
+  GLuint pattern = stipple_type >= 0 && stipple_type < (int)patterns.size() ? patterns[stipple_type] : 0xFFFF;
+
+  _prog->Use();
+  glUniform4fv( _color_loc, 1, _color.data() );
+  glUniform1f( _depth_attenuation_loc, _line_style._depth_attenuation );
+  glUniform1f( _width_loc, _line_style._width );
+  glUniform1i( _join_loc, (GLint)_line_style._join );
+  glUniform1i( _cap_loc, (GLint)_line_style._cap );
+  glUniform1f( _miter_limit_loc, _line_style._miter_limit );
+  glUniform1i( _no_of_polylines_loc, (GLint)(_polylines.size() / 2) );
+  glUniform1ui( _stipple_pattern_loc, pattern );
+  glUniform1f( _stipple_factor_loc, std::max( 1.0f, std::round( _line_style._width ) ) );
+  _mvp_buffer->Update();
+
+  // one instance per vertex, 12 vertices per instance: segment quad and join or cap
+  CStateCache::Current().BindVertexArray( _vao );
+  glDrawArraysInstanced( GL_TRIANGLES, 0, 12, (GLsizei)no_of_vertices );
+  CStateCache::Current().BindVertexArray( 0 );
+  ++ _statistics._draw_calls;
+
+  _vertices.clear();
+  _polylines.clear();
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Append elements to an active line sequence and return them,
+* so that the vertex coordinates can be written in place.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::span<float> CLineHighQuality::MapSequence( 
+  size_t coords_size ) //!< in: number of elements - `coords_size` = `tuple_size` * "number of coordinates"
+{
+  // A sequence has to be active, to specify new vertex coordinates
+  if ( _active_sequence == false )
+  {
+    ASSERT( false );
+    return std::span<float>();
+  }
 
+  // the coordinates are written directly to the cache
+  return _vertex_cache.Map( coords_size );
+}
 
 
 } // Line
 
 
-} // OpenGL
\ No newline at end of file
+} // OpenGL
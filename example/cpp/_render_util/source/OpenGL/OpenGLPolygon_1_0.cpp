@@ -361,6 +361,9 @@ bool CPolygonOpenGL_1_00::EndSequence( void )
     return false;
   }
  
+  // specify the pending mapped coordinates
+  SpecifyMappedVertices();
+
   _active_sequence = false;
   _tuple_size      = 0;
 
@@ -391,6 +394,7 @@ bool CPolygonOpenGL_1_00::DrawSequence(
   }
 
   // specify the vertex coordinate
+  SpecifyMappedVertices();
   glVertex3f( x, y, z );
 
   return true;
@@ -417,6 +421,7 @@ bool CPolygonOpenGL_1_00::DrawSequence(
   }
 
   // specify the vertex coordinate
+  SpecifyMappedVertices();
   glVertex3d( x, y, z );
 
   return true;
@@ -443,6 +448,7 @@ bool CPolygonOpenGL_1_00::DrawSequence(
   }
 
   // draw the polygon sequence
+  SpecifyMappedVertices();
   if ( _tuple_size == 2 )
   {
     for ( const float *ptr = coords, *end_ptr = coords + coords_size; ptr < end_ptr; ptr += 2 )
@@ -483,6 +489,7 @@ bool CPolygonOpenGL_1_00::DrawSequence(
   }
 
   // draw the polygon sequence
+  SpecifyMappedVertices();
   if ( _tuple_size == 2 )
   {
     for ( const double *ptr = coords, *end_ptr = coords + coords_size; ptr < end_ptr; ptr += 2 )
@@ -503,6 +510,50 @@ bool CPolygonOpenGL_1_00::DrawSequence(
 }
 
 
+/******************************************************************//**
+* \brief Append elements to an active polygon sequence and return them,
+* so that the vertex coordinates can be written in place.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::span<float> CPolygonOpenGL_1_00::MapSequence( 
+  size_t coords_size ) //!< in: number of elements - `coords_size` = `tuple_size` * "number of coordinates"
+{
+  // A sequence has to be active, to specify new vertex coordinates
+  if ( _active_sequence == false )
+  {
+    ASSERT( false );
+    return std::span<float>();
+  }
+
+  // the mapped coordinates are specified by the next call
+  _vertex_cache.TupleSize( _tuple_size );
+  return _vertex_cache.Map( coords_size );
+}
+
+
+/******************************************************************//**
+* \brief Specify the vertex coordinates, which have been written to the
+* elements returned by `MapSequence`.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CPolygonOpenGL_1_00::SpecifyMappedVertices( void )
+{
+  size_t coords_size = _vertex_cache.SequenceSize();
+  if ( coords_size == 0 )
+    return;
+
+  // the data of the cache stays valid until the next `Map`
+  _vertex_cache.Reset();
+  DrawSequence( coords_size, _vertex_cache.VertexData() );
+}
+
+
 } // Polygon
 
 
@@ -556,6 +556,29 @@ bool CPolygonOpenGL_2_00::DrawSequence(
 }
 
 
+/******************************************************************//**
+* \brief Append elements to an active polygon sequence and return them,
+* so that the vertex coordinates can be written in place.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::span<float> CPolygonOpenGL_2_00::MapSequence( 
+  size_t coords_size ) //!< in: number of elements - `coords_size` = `tuple_size` * "number of coordinates"
+{
+  // A sequence has to be active, to specify new vertex coordinates
+  if ( _primitive_prog == nullptr || _primitive_prog->ActiveSequence() == false )
+  {
+    ASSERT( false );
+    return std::span<float>();
+  }
+
+  // the coordinates are written directly to the cache
+  return _vertex_cache.Map( coords_size );
+}
+
+
 } // Polygon
 
 
@@ -15,6 +15,7 @@
 
 #include "../../include/OpenGL/OpenGLPolygon_core_and_es.h"
 #include "../../include/OpenGL/OpenGLPrimitive_core_and_es.h"
+#include "../../include/OpenGL/OpenGLVertexBuffer.h"
 
 
 // OpenGL wrapper
@@ -281,7 +282,7 @@ Render::Polygon::IRender & CPolygon_base_OpenGL4_OpenGLES3::SetStyle(
     assert( false );
     return *this;
   }
-  _primitive_prog->SetDeptAttenuation( _polygon_style._depth_attenuation );
+  _primitive_prog->SetDeptAttenuation( style._depth_attenuation );
 
   _polygon_style = style;
 
@@ -313,20 +314,9 @@ bool CPolygon_base_OpenGL4_OpenGLES3::Draw(
   ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
   auto &prog = *_primitive_prog;
 
-  // activate program, update uniforms and enable vertex attributes
+  // draw the polygon, or append it to the pending batch, if successive drawing is enabled
   Render::TVA va_type = tuple_size == 4 ? Render::b0_xyzw : (tuple_size == 2 ? Render::b0_xy : Render::b0_xyz);
-  prog.ActivateProgram( va_type );
-
-  // set vertex attribute pointer and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-    buffer->UpdateVB( 0, tuple_size*sizeof(float), coords_size, coords );
-  
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( primitive_type ), 0, (GLsizei)(coords_size / tuple_size) );
-  
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  prog.Draw( primitive_type, va_type, coords_size / tuple_size, tuple_size*sizeof(float), coords );
 
   return true;
 }
@@ -354,20 +344,9 @@ bool CPolygon_base_OpenGL4_OpenGLES3::Draw(
   ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
   auto &prog = *_primitive_prog;
 
-  // activate program, update uniforms and enable vertex attributes
+  // draw the polygon, or append it to the pending batch, if successive drawing is enabled
   Render::TVA va_type = tuple_size == 4 ? Render::d__b0_xyzw : (tuple_size == 2 ? Render::d__b0_xy : Render::d__b0_xyz);
-  prog.ActivateProgram( va_type );
-
-  // set vertex attribute pointer and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-    buffer->UpdateVB( 0, 3, coords_size*sizeof(double), coords );
-
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( primitive_type ), 0, (GLsizei)(coords_size / tuple_size) );
- 
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  prog.Draw( primitive_type, va_type, coords_size / tuple_size, tuple_size*sizeof(double), coords );
 
   return true;
 }
@@ -395,22 +374,8 @@ bool CPolygon_base_OpenGL4_OpenGLES3::Draw(
   ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
   auto &prog = *_primitive_prog;
 
-  // activate program, update uniforms and enable vertex attributes
-  prog.ActivateProgram( Render::b0_x__b1_y );
-
-  // set vertex attribute pointers and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-  {
-    buffer->UpdateVB( 0, sizeof(float), no_of_coords, x_coords );
-    buffer->UpdateVB( 1, sizeof(float), no_of_coords, y_coords );
-  }
-
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( primitive_type ), 0, (GLsizei)no_of_coords );
-   
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  // draw the polygon, or append it to the pending batch, if successive drawing is enabled
+  prog.Draw( primitive_type, Render::b0_x__b1_y, no_of_coords, sizeof(float), x_coords, y_coords );
 
   return true;
 }
@@ -438,24 +403,105 @@ bool CPolygon_base_OpenGL4_OpenGLES3::Draw(
   ASSERT( Render::BasePrimitive(primitive_type) == Render::TBasePrimitive::polygon );
   auto &prog = *_primitive_prog;
 
-  // activate program, update uniforms and enable vertex attributes
-  prog.ActivateProgram( Render::d__b0_x__b1_y );
+  // draw the polygon, or append it to the pending batch, if successive drawing is enabled
+  prog.Draw( primitive_type, Render::d__b0_x__b1_y, no_of_coords, sizeof(double), x_coords, y_coords );
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Draw a concave polygon with holes.  
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPolygon_base_OpenGL4_OpenGLES3::DrawPolygon( 
+  unsigned int       tuple_size,     //!< in: kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)   
+  size_t             coords_size,    //!< in: number of elements (size) of the coordinate array - `coords_size` = `tuple_size` * "number of coordinates" 
+  const float       *coords,         //!< in: pointer to an array of the vertex coordinates
+  size_t             no_of_contours, //!< in: number of contours; 0: all the vertices form one contour
+  const size_t      *contour_sizes ) //!< in: number of vertices of each contour; the first contour is the outer contour, the others are holes
+{
+  return DrawPolygonT( tuple_size, coords_size, coords, no_of_contours, contour_sizes );
+}
+
+
+/******************************************************************//**
+* \brief Draw a concave polygon with holes.  
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPolygon_base_OpenGL4_OpenGLES3::DrawPolygon( 
+  unsigned int       tuple_size,     //!< in: kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)   
+  size_t             coords_size,    //!< in: number of elements (size) of the coordinate array - `coords_size` = `tuple_size` * "number of coordinates" 
+  const double      *coords,         //!< in: pointer to an array of the vertex coordinates
+  size_t             no_of_contours, //!< in: number of contours; 0: all the vertices form one contour
+  const size_t      *contour_sizes ) //!< in: number of vertices of each contour; the first contour is the outer contour, the others are holes
+{
+  return DrawPolygonT( tuple_size, coords_size, coords, no_of_contours, contour_sizes );
+}
+
 
-  // set vertex attribute pointers and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
+/******************************************************************//**
+* \brief Draw a concave polygon with holes.
+*
+* The triangulation of the polygon is looked up in the cache by the
+* content hash of the polygon. When a polygon is drawn the first time,
+* it is triangulated and a static draw buffer with its vertices and
+* indices is created and retained by the cache entry. 
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template <typename T>
+bool CPolygon_base_OpenGL4_OpenGLES3::DrawPolygonT( 
+  unsigned int       tuple_size,
+  size_t             coords_size,
+  const T           *coords,
+  size_t             no_of_contours,
+  const size_t      *contour_sizes )
+{
+  // A new sequence can't be started within an active sequence
+  if ( _primitive_prog == nullptr || _primitive_prog->ActiveSequence() )
   {
-    buffer->UpdateVB( 0, sizeof(double), no_of_coords, x_coords );
-    buffer->UpdateVB( 1, sizeof(double), no_of_coords, y_coords );
+    ASSERT( false );
+    return false;
   }
+  auto &prog = *_primitive_prog;
 
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( primitive_type ), 0, (GLsizei)no_of_coords );
+  auto triangulation = _triangulation_cache.Get( tuple_size, coords_size, coords, no_of_contours, contour_sizes );
+  if ( triangulation->_indices.empty() )
+    return true;
 
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  // create the draw buffer of the polygon
+  if ( triangulation->_buffer == nullptr )
+  {
+    size_t no_of_vertices = coords_size / tuple_size;
+    _polygon_vertices.resize( no_of_vertices * 3 );
+    for ( size_t i = 0; i < no_of_vertices; ++ i )
+    {
+      const T *vertex = coords + i * tuple_size;
+      T w = tuple_size == 4 && vertex[3] != 0 ? vertex[3] : 1;
+      _polygon_vertices[i*3]   = static_cast<float>( vertex[0] / w );
+      _polygon_vertices[i*3+1] = static_cast<float>( vertex[1] / w );
+      _polygon_vertices[i*3+2] = tuple_size > 2 ? static_cast<float>( vertex[2] / w ) : 0.0f;
+    }
+
+    Render::IDrawBufferPtr buffer = std::make_unique<OpenGL::CDrawBuffer>( Render::TDrawBufferUsage::static_draw, 0 );
+    buffer->SpecifyVA( Render::i0__b0_xyz );
+    buffer->UpdateVB( 0, sizeof(float), _polygon_vertices.size(), _polygon_vertices.data() );
+    buffer->UpdateIB( 0, sizeof(std::uint32_t), triangulation->_indices.size(), triangulation->_indices.data() );
+    buffer->Release();
+    triangulation->_buffer = std::move( buffer );
+  }
 
-  return true;
+  // draw the triangles by a single indexed draw call
+  return prog.DrawMesh( Render::TPrimitive::triangles, *triangulation->_buffer );
 }
 
 
@@ -504,23 +550,10 @@ bool CPolygon_base_OpenGL4_OpenGLES3::EndSequence( void )
   }
   auto &prog = *_primitive_prog;
 
-  // draw the line
-
-  // activate program, update uniforms and enable vertex attributes
-  GLsizei tuple_size = (GLsizei)_vertex_cache.TupleSize();
+  // draw the polygon, or append it to the pending batch, if successive drawing is enabled
+  size_t tuple_size = _vertex_cache.TupleSize();
   Render::TVA va_type = tuple_size == 4 ? Render::b0_xyzw : (tuple_size == 2 ? Render::b0_xy : Render::b0_xyz);
-  prog.ActivateProgram( va_type );
-
-  //  set vertex attribute pointer and draw the line
-  if ( auto *buffer = prog.DrawBuffer() )
-    buffer->UpdateVB( 0, tuple_size*sizeof(float), _vertex_cache.SequenceSize(),_vertex_cache.VertexData() );
-
-  // TODO $$$ append to cache and delays the drawing until it is absolutely necessary.
-  //          dependent on VAO specification and `_successive_draw_started`
-  glDrawArrays( OpenGL::Primitive( _squence_type ), 0, (GLsizei)(_vertex_cache.SequenceSize() / tuple_size) );
-  
-  // disable vertex attributes and activate program 0
-  prog.DeactivateProgram();
+  prog.Draw( _squence_type, va_type, _vertex_cache.SequenceSize() / tuple_size, tuple_size*sizeof(float), _vertex_cache.VertexData() );
   _vertex_cache.Reset();
   
   return true;
@@ -627,6 +660,29 @@ bool CPolygon_base_OpenGL4_OpenGLES3::DrawSequence(
 }
 
 
+/******************************************************************//**
+* \brief Append elements to an active polygon sequence and return them,
+* so that the vertex coordinates can be written in place.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::span<float> CPolygon_base_OpenGL4_OpenGLES3::MapSequence( 
+  size_t coords_size ) //!< in: number of elements - `coords_size` = `tuple_size` * "number of coordinates"
+{
+  // A sequence has to be active, to specify new vertex coordinates
+  if ( _primitive_prog == nullptr || _primitive_prog->ActiveSequence() == false )
+  {
+    ASSERT( false );
+    return std::span<float>();
+  }
+
+  // the coordinates are written directly to the cache
+  return _vertex_cache.Map( coords_size );
+}
+
+
 } // Polygon
 
 } // OpenGL
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 #include "../../include/OpenGL/OpenGLPrimitive_2_0.h"
 #include "../../include/OpenGL/OpenGLProgram.h"
+#include "../../include/OpenGL/OpenGLStateCache.h"
 
 
 // OpenGL wrapper
@@ -311,7 +312,7 @@ bool CPrimitiveOpenGL_2_00::FinishSuccessivePrimitiveDrawings( void )
   glDisableVertexAttribArray( _attrib_y_inx );
 
   // activate the shader program 0
-  glUseProgram( 0 );
+  CStateCache::Current().UseProgram( 0 );
 
   _attribute_case     = 0;
   _successive_drawing = false;
@@ -425,7 +426,7 @@ bool CPrimitiveOpenGL_2_00::DeactivateProgram( void )
   glDisableVertexAttribArray( _attrib_xyzw_inx );
   if ( _attribute_case == 1 )
     glDisableVertexAttribArray( _attrib_y_inx );
-  glUseProgram( 0 );
+  CStateCache::Current().UseProgram( 0 );
   
   return true;
 }
@@ -15,6 +15,7 @@
 
 #include "../../include/OpenGL/OpenGLPrimitive_core_and_es.h"
 #include "../../include/OpenGL/OpenGLProgram.h"
+#include "../../include/OpenGL/OpenGLStateCache.h"
 #include "../../include/OpenGL/OpenGLVertexBuffer.h"
 
 
@@ -55,6 +56,7 @@ namespace OpenGL
 {
 
 const size_t CPrimitiveOpenGL_core_and_es::_default_binding = 1;
+const size_t CPrimitiveOpenGL_core_and_es::_max_batch_size  = 4 * 1024 * 1024;
 
 
 /*!
@@ -245,7 +247,7 @@ void CPrimitiveOpenGL_core_and_es::InitDrawBuffer(
   if ( _mesh_buffer != nullptr )
     return;
 
-  _mesh_buffer = std::make_unique<OpenGL::CDrawBuffer>( Render::TDrawBufferUsage::stream_draw, min_buffer_size );
+  _mesh_buffer = std::make_unique<OpenGL::CDrawBuffer>( Render::TDrawBufferUsage::stream_ring, min_buffer_size );
 
   bool ret_xyz = _mesh_buffer->SpecifyVA( Render::b0_xyz );
   ASSERT( ret_xyz );
@@ -318,6 +320,10 @@ void CPrimitiveOpenGL_core_and_es::InitProgram( void ) // shader program
 CPrimitiveOpenGL_core_and_es & CPrimitiveOpenGL_core_and_es::SetColor( 
   const Render::TColor & color ) //!< in: new color
 { 
+  // the pending primitives are drawn with the current color
+  if ( _successive_drawing && color != _color )
+    Flush();
+
   _color = color; 
 
   if ( _successive_drawing )
@@ -337,7 +343,12 @@ CPrimitiveOpenGL_core_and_es & CPrimitiveOpenGL_core_and_es::SetColor(
 CPrimitiveOpenGL_core_and_es & CPrimitiveOpenGL_core_and_es::SetColor( 
   const Render::TColor8 & color ) //!< in: new color
 { 
-  _color = Render::toColor( color );
+  // the pending primitives are drawn with the current color
+  Render::TColor new_color = Render::toColor( color );
+  if ( _successive_drawing && new_color != _color )
+    Flush();
+
+  _color = new_color;
 
   if ( _successive_drawing )
     glUniform4fv( _color_loc, 1, _color.data() );
@@ -353,9 +364,13 @@ CPrimitiveOpenGL_core_and_es & CPrimitiveOpenGL_core_and_es::SetColor(
 * \date    2018-12-03
 * \version 1.0
 **********************************************************************/
-CPrimitiveOpenGL_core_and_es CPrimitiveOpenGL_core_and_es::SetDeptAttenuation( 
+CPrimitiveOpenGL_core_and_es & CPrimitiveOpenGL_core_and_es::SetDeptAttenuation( 
   Render::t_fp depth_attenuation ) //!< depth attenuation
 {
+  // the pending primitives are drawn with the current depth attenuation
+  if ( _successive_drawing && depth_attenuation != _depth_attenuation )
+    Flush();
+
   _depth_attenuation = depth_attenuation;
 
   if ( _successive_drawing )
@@ -418,11 +433,14 @@ bool CPrimitiveOpenGL_core_and_es::FinishSuccessivePrimitiveDrawings( void )
   if ( _successive_drawing == false )
     return true;
 
+  // draw the pending primitives
+  Flush();
+
   // disable vertex attributes
   _mesh_buffer->Release();
 
   // activate the shader program 0
-  glUseProgram( 0 );
+  CStateCache::Current().UseProgram( 0 );
 
   _attribute_case     = 0;
   _successive_drawing = false;
@@ -487,8 +505,8 @@ bool CPrimitiveOpenGL_core_and_es::ActivateProgram(
     return false;
   }
 
-  // activate program  
-  bool set_case = false;
+  // activate program; if successive drawing is not enabled, then the uniforms may have changed since the last draw
+  bool update_uniforms = _successive_drawing == false;
   if ( _successive_drawing == false )
     _prog->Use();
 
@@ -496,7 +514,7 @@ bool CPrimitiveOpenGL_core_and_es::ActivateProgram(
   int case_val = requested_va_type == Render::b0_x__b1_y || requested_va_type == Render::d__b0_x__b1_y ? 1 : 0;
   
   // update uniforms
-  if ( _attribute_case != case_val )
+  if ( update_uniforms || _attribute_case != case_val )
   {
     UpdateParameterUniforms();
     glUniform1i( _case_loc,  case_val );
@@ -530,7 +548,7 @@ bool CPrimitiveOpenGL_core_and_es::DeactivateProgram( void )
  
   // disable vertex attributes and activate program 0
   _mesh_buffer->Release();
-  glUseProgram( 0 );
+  CStateCache::Current().UseProgram( 0 );
   
   return true;
 }
@@ -571,4 +589,203 @@ CPrimitiveOpenGL_core_and_es & CPrimitiveOpenGL_core_and_es::UpdateParameterUnif
 }
 
 
-} // OpenGL
\ No newline at end of file
+/******************************************************************//**
+* \brief Draw a primitive.
+*
+* If successive drawing is enabled, then the vertex attributes are
+* appended to the pending batch and the drawing is delayed, until the
+* state changes (vertex array type, primitive type, uniforms) or the
+* successive drawing is finished. The primitives of a batch are drawn
+* by a single `glMultiDrawArrays`. Consecutive independent primitives
+* (points, lines, triangles) are merged to a single range, as long as
+* the vertex count of the range is a multiple of the vertex count of a
+* primitive.
+*
+* If successive drawing is not enabled, then the primitive is drawn
+* immediately.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPrimitiveOpenGL_core_and_es::Draw( 
+  Render::TPrimitive  primitive_type, //!< I - primitive type
+  Render::TVA         va_type,        //!< I - vertex array object specification
+  size_t              no_of_vertices, //!< I - number of vertices
+  size_t              element_size,   //!< I - size of the attributes of a vertex in each of the vertex buffers
+  const void         *data0,          //!< I - attributes for the 1st vertex buffer
+  const void         *data1 )         //!< I - attributes for the 2nd vertex buffer (`b0_x__b1_y`, `d__b0_x__b1_y`)
+{
+  if ( _initilized == false || _active_sequence )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  ++ _batch_statistics._draws;
+  if ( no_of_vertices == 0 )
+    return true;
+
+  // draw the pending batch, if the primitive can't be appended
+  size_t data_size = no_of_vertices * element_size;
+  if ( _batch_vertices > 0 )
+  {
+    bool compatible =
+      _batch_va_type == va_type && _batch_primitive == primitive_type &&
+      _batch_data[0].size() + data_size <= _max_batch_size;
+    if ( compatible == false )
+      Flush();
+  }
+  if ( _batch_vertices == 0 )
+  {
+    _batch_va_type      = va_type;
+    _batch_primitive    = primitive_type;
+    _batch_element_size = element_size;
+  }
+
+  // append the vertex attributes
+  const char *attributes0 = static_cast<const char*>( data0 );
+  _batch_data[0].insert( _batch_data[0].end(), attributes0, attributes0 + data_size );
+  if ( data1 != nullptr )
+  {
+    const char *attributes1 = static_cast<const char*>( data1 );
+    _batch_data[1].insert( _batch_data[1].end(), attributes1, attributes1 + data_size );
+  }
+
+  // append the range of the primitive; independent primitives are merged,
+  // if the previous range ends with a complete primitive, else the vertex grouping of the appended range would be shifted
+  int verts_per_prim = 0;
+  switch ( primitive_type )
+  {
+    default: break;
+    case Render::TPrimitive::points:             verts_per_prim = 1; break;
+    case Render::TPrimitive::lines:              verts_per_prim = 2; break;
+    case Render::TPrimitive::triangles:          verts_per_prim = 3; break;
+    case Render::TPrimitive::lines_adjacency:    verts_per_prim = 4; break;
+    case Render::TPrimitive::triangle_adjacency: verts_per_prim = 6; break;
+  }
+  if ( verts_per_prim > 0 && _batch_count.empty() == false && _batch_count.back() % verts_per_prim == 0 )
+  {
+    _batch_count.back() += static_cast<int>( no_of_vertices );
+  }
+  else
+  {
+    _batch_first.push_back( static_cast<int>( _batch_vertices ) );
+    _batch_count.push_back( static_cast<int>( no_of_vertices ) );
+  }
+  _batch_vertices += no_of_vertices;
+
+  // without successive drawing the states are restored after each primitive
+  if ( _successive_drawing == false )
+    return Flush();
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Draw the indexed mesh of a retained draw buffer.
+*
+* The buffer is specified by the caller (vertex array type
+* `i0__b0_xyz`) and keeps its vertices and indices, so a static mesh is
+* drawn by a single `glDrawElements`, without any upload.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPrimitiveOpenGL_core_and_es::DrawMesh( 
+  Render::TPrimitive   primitive_type, //!< I - primitive type
+  Render::IDrawBuffer &buffer )        //!< I - retained draw buffer with vertex and index buffer
+{
+  if ( _initilized == false || _active_sequence )
+  {
+    ASSERT( false );
+    return false;
+  }
+
+  ++ _batch_statistics._draws;
+
+  // keep the order of the primitives
+  Flush();
+
+  // activate program and update uniforms
+  ActivateProgram( Render::b0_xyz );
+
+  buffer.DrawAllElements( primitive_type, true );
+  buffer.Release();
+  ++ _batch_statistics._draw_calls;
+
+  // the vertex array object of the mesh buffer has to be bound again by the next draw
+  _va_type = Render::unknown;
+
+  // activate program 0 (if successive drawing is not enabled)
+  DeactivateProgram();
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Draw the pending batch.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPrimitiveOpenGL_core_and_es::Flush( void )
+{
+  if ( _batch_vertices == 0 )
+    return true;
+
+  bool ret = DrawBatch();
+
+  // keep the capacity of the arrays for the next batch
+  for ( auto &data : _batch_data )
+    data.clear();
+  _batch_first.clear();
+  _batch_count.clear();
+  _batch_vertices = 0;
+
+  return ret;
+}
+
+
+/******************************************************************//**
+* \brief Upload the vertex attributes of the pending batch and draw
+* all its primitives by a single draw call.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPrimitiveOpenGL_core_and_es::DrawBatch( void )
+{
+  auto *buffer = _mesh_buffer.get();
+  if ( buffer == nullptr )
+    return false;
+
+  // activate program, update uniforms and enable vertex attributes
+  ActivateProgram( _batch_va_type );
+
+  // set vertex attribute pointers
+  buffer->UpdateVB( 0, _batch_element_size, _batch_vertices, _batch_data[0].data() );
+  if ( _batch_data[1].empty() == false )
+    buffer->UpdateVB( 1, _batch_element_size, _batch_vertices, _batch_data[1].data() );
+
+  // draw the primitives
+  if ( _batch_first.size() == 1 )
+    buffer->DrawArray( _batch_primitive, _batch_first[0], _batch_count[0], true );
+  else
+    buffer->MultiDrawArray( _batch_primitive, _batch_first.size(), _batch_first.data(), _batch_count.data(), true );
+
+  ++ _batch_statistics._draw_calls;
+  _batch_statistics._vertices += _batch_vertices;
+
+  // disable vertex attributes and activate program 0 (if successive drawing is not enabled)
+  DeactivateProgram();
+
+  return true;
+}
+
+
+} // OpenGL
@@ -0,0 +1,379 @@
+/******************************************************************//**
+* \brief   GPU scopes by timer queries, for the frame profiler.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+// includes
+
+#include <stdafx.h>
+
+// OpenGL
+
+#include "../../include/OpenGL/OpenGLProfiler.h"
+
+
+// STL
+
+#include <algorithm>
+
+
+// class implementations
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+namespace
+{
+
+
+const size_t c_no_query = (size_t)-1;
+
+
+//! convert a GPU time to the time of the CPU profiler
+std::uint64_t ToProfilerTime( GLuint64 gpu_time, std::int64_t offset )
+{
+  std::int64_t time = (std::int64_t)gpu_time + offset;
+  return time > 0 ? (std::uint64_t)time : 0;
+}
+
+
+} // namespace
+
+
+/******************************************************************//**
+* \brief   ctor.
+*
+* The query objects are created by the first frame.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CGpuProfiler::CGpuProfiler(
+  size_t no_of_frames, //!< I - number of frames in flight
+  size_t max_scopes )  //!< I - maximum number of scopes per frame
+  : _pools( std::max( no_of_frames, (size_t)2 ) )
+  , _max_scopes( std::max( max_scopes, (size_t)1 ) )
+{}
+
+
+/******************************************************************//**
+* \brief   dtor.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CGpuProfiler::~CGpuProfiler()
+{
+  Destroy();
+}
+
+
+/******************************************************************//**
+* \brief   Check if timer queries are supported by the current context.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CGpuProfiler::Supported( void )
+{
+  return glQueryCounter != nullptr && glGetInteger64v != nullptr && glGetQueryObjectui64v != nullptr;
+}
+
+
+/******************************************************************//**
+* \brief   Delete the query objects.
+*
+* Pending results are discarded.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGpuProfiler::Destroy( void )
+{
+  if ( _in_frame )
+    glEndQuery( GL_TIME_ELAPSED );
+  for ( auto &pool : _pools )
+  {
+    if ( pool._queries.empty() == false )
+      glDeleteQueries( (GLsizei)pool._queries.size(), pool._queries.data() );
+    if ( pool._elapsed != 0 )
+      glDeleteQueries( 1, &pool._elapsed );
+    pool = TPool();
+  }
+  _current  = 0;
+  _oldest   = 0;
+  _in_frame = false;
+  _open.clear();
+}
+
+
+/******************************************************************//**
+* \brief   Check if the scopes are recorded.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CGpuProfiler::Active( void )
+{
+  if ( Render::CProfiler::Enabled() == false )
+    return false;
+  if ( _supported < 0 )
+    _supported = Supported() ? 1 : 0;
+  if ( _supported == 0 )
+    return false;
+  if ( _track == nullptr )
+    _track = &Render::CProfiler::Instance().Track( "GPU" );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Begin a frame.
+*
+* The results of the previous frames are read, as far as they are
+* available.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGpuProfiler::BeginFrame( void )
+{
+  if ( _in_frame )
+    EndFrame();
+
+  if ( Active() == false )
+  {
+    // results of frames, which were issued while the profiler was enabled
+    Collect( false );
+    return;
+  }
+
+  Collect( false );
+
+  // the pool is still busy, after all the other frames were issued
+  TPool &pool = _pools[_current];
+  if ( pool._pending )
+  {
+    pool._pending = false;
+    _oldest = (_oldest + 1) % _pools.size();
+    _statistics._discarded ++;
+  }
+
+  if ( pool._queries.empty() )
+  {
+    pool._queries.resize( 2 * _max_scopes + 1 );
+    glGenQueries( (GLsizei)pool._queries.size(), pool._queries.data() );
+    glGenQueries( 1, &pool._elapsed );
+  }
+  pool._used = 0;
+  pool._scopes.clear();
+
+  // map the GPU time to the CPU time
+  GLint64 gpu_time = 0;
+  glGetInteger64v( GL_TIMESTAMP, &gpu_time );
+  pool._offset = (std::int64_t)Render::CProfiler::Now() - (std::int64_t)gpu_time;
+
+  Timestamp( pool, pool._frame_begin );
+  glBeginQuery( GL_TIME_ELAPSED, pool._elapsed );
+  OPENGL_CHECK_GL_ERROR
+
+  _in_frame = true;
+}
+
+
+/******************************************************************//**
+* \brief   End a frame.
+*
+* Open scopes are ended.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGpuProfiler::EndFrame( void )
+{
+  if ( _in_frame == false )
+    return;
+
+  while ( _open.empty() == false )
+    End();
+
+  TPool &pool = _pools[_current];
+  glEndQuery( GL_TIME_ELAPSED );
+  OPENGL_CHECK_GL_ERROR
+
+  pool._pending = true;
+  _current  = (_current + 1) % _pools.size();
+  _in_frame = false;
+}
+
+
+/******************************************************************//**
+* \brief   Begin a scope.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGpuProfiler::Begin(
+  const char *name ) //!< I - name of the scope (string literal)
+{
+  if ( _in_frame == false )
+    return;
+
+  TPool &pool  = _pools[_current];
+  size_t index = c_no_query;
+  if ( Timestamp( pool, index ) == false )
+  {
+    _open.push_back( c_no_query );
+    return;
+  }
+  pool._scopes.push_back( { name, index, c_no_query } );
+  _open.push_back( pool._scopes.size() - 1 );
+}
+
+
+/******************************************************************//**
+* \brief   End the innermost scope.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGpuProfiler::End( void )
+{
+  if ( _in_frame == false || _open.empty() )
+    return;
+
+  size_t scope = _open.back();
+  _open.pop_back();
+  if ( scope == c_no_query )
+    return;
+
+  TPool &pool = _pools[_current];
+  Timestamp( pool, pool._scopes[scope]._end );
+}
+
+
+/******************************************************************//**
+* \brief   Wait for the pending frames and push their scopes.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGpuProfiler::Flush( void )
+{
+  if ( _in_frame )
+    EndFrame();
+  Collect( true );
+}
+
+
+/******************************************************************//**
+* \brief   Issue a timestamp query of the pool.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CGpuProfiler::Timestamp(
+  TPool  &pool,  //!< I/O - pool of the current frame
+  size_t &index ) //!< O - index of the query
+{
+  if ( pool._used >= pool._queries.size() )
+  {
+    _statistics._overflow ++;
+    index = c_no_query;
+    return false;
+  }
+  index = pool._used ++;
+  glQueryCounter( pool._queries[index], GL_TIMESTAMP );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Read the pending pools in the order of their frames.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGpuProfiler::Collect(
+  bool all ) //!< I - true: wait for all the pending pools
+{
+  while ( _pools[_oldest]._pending )
+  {
+    TPool &pool = _pools[_oldest];
+    if ( all == false )
+    {
+      GLuint available = GL_FALSE;
+      glGetQueryObjectuiv( pool._elapsed, GL_QUERY_RESULT_AVAILABLE, &available );
+      if ( available == GL_FALSE )
+        break;
+    }
+    Read( pool );
+    _oldest = (_oldest + 1) % _pools.size();
+  }
+}
+
+
+/******************************************************************//**
+* \brief   Read the results of a pool and push the scopes to the
+* track.
+*
+* The time elapsed query ends after all the timestamp queries of the
+* frame, so all the results are available, when it is available.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CGpuProfiler::Read(
+  TPool &pool ) //!< I/O - pending pool
+{
+  pool._pending = false;
+  if ( _track == nullptr || pool._used == 0 )
+    return false;
+
+  std::vector<GLuint64> times( pool._used, 0 );
+  for ( size_t i = 0; i < pool._used; ++ i )
+    glGetQueryObjectui64v( pool._queries[i], GL_QUERY_RESULT, &times[i] );
+  GLuint64 elapsed = 0;
+  glGetQueryObjectui64v( pool._elapsed, GL_QUERY_RESULT, &elapsed );
+  OPENGL_CHECK_GL_ERROR
+
+  std::uint64_t frame_begin = ToProfilerTime( times[pool._frame_begin], pool._offset );
+  _track->Push( "GPU frame", frame_begin, frame_begin + elapsed );
+  for ( auto &scope : pool._scopes )
+  {
+    if ( scope._end == c_no_query )
+      continue;
+    _track->Push( scope._name, ToProfilerTime( times[scope._begin], pool._offset ), ToProfilerTime( times[scope._end], pool._offset ) );
+    _statistics._scopes ++;
+  }
+  _statistics._frames ++;
+  return true;
+}
+
+
+} // OpenGL
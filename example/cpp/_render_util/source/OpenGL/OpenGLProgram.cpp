@@ -12,6 +12,8 @@
 // includes
 
 #include "../../include/OpenGL/OpenGLProgram.h"
+#include "../../include/OpenGL/OpenGLStateCache.h"
+#include "../../include/util/RenderUtil_Hash.h"
 
 
 // OpenGL wrapper
@@ -26,6 +28,12 @@
 #include <cassert>
 #include <sstream>
 #include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <random>
 
 
 // preprocessor definitions
@@ -112,10 +120,12 @@ CShaderObject::~CShaderObject()
 CShaderObject & CShaderObject::operator =( 
   CShaderObject && source_objet ) //!< source object
 {
-  _type   = source_objet._type;
-  _code   = std::move( source_objet._code );
-  _object = source_objet._object;
-  source_objet._object = 0;
+  _type     = source_objet._type;
+  _code     = std::move( source_objet._code );
+  _object   = source_objet._object;
+  _deferred = source_objet._deferred;
+  source_objet._object   = 0;
+  source_objet._deferred = false;
 
   return *this;
 }
@@ -233,12 +243,54 @@ const char *CShaderObject:: ShaderTypeName(
 * \brief Compile the shader stage, the function succeeds, even
 * if the compilation fails, but it fails if the stage was not properly
 * initialized.
+*
+* If a program binary cache is installed, then the compilation is
+* deferred. The shader stage is compiled by `CShaderProgram::Link`,
+* if the program can't be loaded from the cache.
 * 
 * \author  gernot
 * \date    2018-08-02
 * \version 1.0
 **********************************************************************/
 bool CShaderObject::Compile( void )
+{
+  if ( CProgramBinaryCache::Installed() != nullptr )
+  {
+    if ( _object != 0 )
+      glDeleteShader( (GLuint)_object );
+    _object   = 0;
+    _deferred = true;
+    return true;
+  }
+
+  return CompileSource();
+}
+
+
+/******************************************************************//**
+* \brief Compile a deferred shader stage.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CShaderObject::CompileDeferred( void )
+{
+  if ( _deferred == false )
+    return true;
+  _deferred = false;
+  return CompileSource();
+}
+
+
+/******************************************************************//**
+* \brief Compile the source code of the shader stage.
+* 
+* \author  gernot
+* \date    2018-08-02
+* \version 1.0
+**********************************************************************/
+bool CShaderObject::CompileSource( void )
 {
   if ( _object != 0 )
     glDeleteShader( (GLuint)_object );
@@ -270,6 +322,8 @@ bool CShaderObject::Verify(
   std::string &message ) //! O - error messages
 {
   message.clear();
+  if ( _deferred )
+    return true;
   if ( _object == 0 )
     return false;
 
@@ -350,8 +404,9 @@ CShaderProgram::~CShaderProgram()
 CShaderProgram & CShaderProgram::operator =( 
   CShaderProgram && source_objet ) //!< source object
 {
-  _shaders = std::move( source_objet._shaders );
-  _object  = source_objet._object;
+  _shaders          = std::move( source_objet._shaders );
+  _object           = source_objet._object;
+  _compile_messages = std::move( source_objet._compile_messages );
   source_objet._object = 0;
 
   return *this;
@@ -362,6 +417,11 @@ CShaderProgram & CShaderProgram::operator =(
 * \brief Link the program, the function succeeds, even
 * if the linking fails, but it fails if the program was not 
 * properly initialized.  
+*
+* If a program binary cache is installed, then the program is loaded
+* from the cache. If there is no valid binary in the cache, then the
+* deferred shader objects are compiled, the program is linked and
+* the binary is written to the cache.
 * 
 * \author  gernot
 * \date    2018-08-03
@@ -371,10 +431,48 @@ bool CShaderProgram::Link( void )
 {
   if ( _object != 0 )
     glDeleteProgram( (GLuint)_object );
+  _object = 0;
+  _compile_messages.clear();
+
+  auto start_time = std::chrono::high_resolution_clock::now();
+  auto elapsed_ms = [&]() -> double
+  {
+    return std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start_time ).count();
+  };
+
+  // try to load the program from the binary cache
+  CProgramBinaryCache *cache = CProgramBinaryCache::Installed();
+  std::string key;
+  std::string identity;
+  std::string description;
+  if ( cache != nullptr && CProgramBinaryCache::Supported() && Description( description ) )
+  {
+    identity = cache->Identity( description );
+    key      = CProgramBinaryCache::Key( identity );
+    if ( LinkBinary( *cache, key, identity ) )
+    {
+      cache->Hit( elapsed_ms() );
+      return true;
+    }
+  }
+
+  // compile the deferred shader objects
+  for ( auto shader : _shaders )
+  {
+    CShaderObject *shader_object = dynamic_cast<CShaderObject*>( shader.get() );
+    if ( shader_object == nullptr || shader_object->Deferred() == false )
+      continue;
+    shader_object->CompileDeferred();
+    std::string message;
+    if ( shader_object->Verify( message ) == false )
+      _compile_messages += message;
+  }
 
   // create the program object
   _object = glCreateProgram();
   GLuint obj = (GLuint)_object;
+  if ( key.empty() == false )
+    glProgramParameteri( obj, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
   
   // attach shader objects 
   for ( auto shader : _shaders )
@@ -410,8 +508,112 @@ bool CShaderProgram::Link( void )
 
   // link the program
   glLinkProgram( obj );
+
+  // write the binary to the cache
+  if ( key.empty() == false )
+  {
+    StoreBinary( *cache, key, identity );
+    cache->Miss( elapsed_ms() );
+  }
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Get the description of the program, which identifies the
+* binary in the program cache.
+*
+* Returns false if the source code of a shader stage is unknown.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CShaderProgram::Description( 
+  std::string &description ) const //!< O - description of the sources, the bindings and the transform feedback mode
+{
+  std::stringstream str_stream;
+  for ( auto shader : _shaders )
+  {
+    CShaderObject *shader_object = dynamic_cast<CShaderObject*>( shader.get() );
+    if ( shader_object == nullptr )
+      return false;
+    str_stream << "stage " << CShaderObject::ShaderEnum( shader_object->Type() ) << '\0';
+    for ( auto &code : shader_object->Code() )
+      str_stream << code << '\0';
+  }
+  for ( auto & resource : _resource_binding )
+    str_stream << "binding " << std::get<0>( resource ) << ' ' << (int)std::get<1>( resource ) << ' ' << std::get<2>( resource ) << '\0';
+  str_stream << "transform feedback " << (int)_transform_feedback_mode;
+  description = str_stream.str();
   return true;
 }
+
+
+/******************************************************************//**
+* \brief Load the program from a binary of the program cache.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CShaderProgram::LinkBinary( 
+  CProgramBinaryCache &cache,     //!< I - program cache
+  const std::string   &key,       //!< I - key of the program
+  const std::string   &identity ) //!< I - identity of the program
+{
+  unsigned int      format = 0;
+  std::vector<char> binary;
+  if ( cache.Load( key, identity, format, binary ) == false )
+    return false;
+
+  GLuint obj = glCreateProgram();
+  glProgramBinary( obj, (GLenum)format, binary.data(), (GLsizei)binary.size() );
+  GLint status = GL_FALSE;
+  glGetProgramiv( obj, GL_LINK_STATUS, &status );
+  if ( status == GL_FALSE )
+  {
+    glDeleteProgram( obj );
+    cache.Reject( key );
+    return false;
+  }
+
+  _object = obj;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Write the binary of a successfully linked program to the
+* program cache.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CShaderProgram::StoreBinary( 
+  CProgramBinaryCache &cache,     //!< I - program cache
+  const std::string   &key,       //!< I - key of the program
+  const std::string   &identity ) //!< I - identity of the program
+{
+  GLint status = GL_FALSE;
+  glGetProgramiv( (GLuint)_object, GL_LINK_STATUS, &status );
+  if ( status == GL_FALSE )
+    return;
+
+  GLint length = 0;
+  glGetProgramiv( (GLuint)_object, GL_PROGRAM_BINARY_LENGTH, &length );
+  if ( length <= 0 )
+    return;
+
+  std::vector<char> binary( length );
+  GLenum  format  = 0;
+  GLsizei written = 0;
+  glGetProgramBinary( (GLuint)_object, length, &written, &format, binary.data() );
+  binary.resize( written );
+  if ( written > 0 )
+    cache.Store( key, identity, format, binary );
+}
   
 
 /******************************************************************//**
@@ -440,7 +642,7 @@ bool CShaderProgram::CShaderProgram::Verify(
 	glGetProgramInfoLog( _object, maxLen, &len, log.data() );
   
   std::stringstream str_stream;
-  str_stream << "link error:" << std::endl << log.data() << std::endl;
+  str_stream << _compile_messages << "link error:" << std::endl << log.data() << std::endl;
   message = str_stream.str();
 
   assert( false );
@@ -459,7 +661,7 @@ bool CShaderProgram::Use( void )
 {
   if ( _object == 0 )
     return false;
-  glUseProgram( _object );
+  CStateCache::Current().UseProgram( _object );
   return true;
 }
 
@@ -918,5 +1120,314 @@ void CIntrospection::GetSubroutines( void )
   */
 }
 
+
+//*********************************************************************
+// CProgramBinaryCache
+//*********************************************************************
+
+
+namespace
+{
+
+
+const std::uint32_t c_binary_file_magic   = 0x42504c47; //!< "GLPB"
+const std::uint32_t c_binary_file_version = 2;
+
+
+//! header of a binary file; followed by the identity of the program and the binary
+struct TBinaryFileHeader
+{
+  std::uint32_t _magic;         //!< file identifier
+  std::uint32_t _version;       //!< file version
+  std::uint32_t _format;        //!< binary format of `glProgramBinary`
+  std::uint32_t _size;          //!< size of the binary in bytes
+  std::uint32_t _identity_size; //!< size of the identity in bytes, to detect hash collisions of the key
+  std::uint32_t _reserved;
+};
+
+
+} // anonymous namespace
+
+
+std::shared_ptr<CProgramBinaryCache> CProgramBinaryCache::_installed;
+
+
+/******************************************************************//**
+* \brief ctor
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProgramBinaryCache::CProgramBinaryCache( 
+  const std::string &directory ) //!< I - cache directory
+  : _directory( directory )
+{
+  std::error_code error;
+  std::filesystem::create_directories( _directory, error );
+}
+
+
+/******************************************************************//**
+* \brief dtor
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProgramBinaryCache::~CProgramBinaryCache()
+{}
+
+
+/******************************************************************//**
+* \brief Install a cache, which is used by all the programs, which
+* are linked after. `nullptr` uninstalls the cache.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CProgramBinaryCache::Install( 
+  std::shared_ptr<CProgramBinaryCache> cache ) //!< I - program cache
+{
+  _installed = cache;
+}
+
+
+/******************************************************************//**
+* \brief Get the installed cache.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProgramBinaryCache * CProgramBinaryCache::Installed( void )
+{
+  return _installed.get();
+}
+
+
+/******************************************************************//**
+* \brief Evaluate if the current context supports program binaries.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CProgramBinaryCache::Supported( void )
+{
+  if ( glProgramBinary == nullptr || glGetProgramBinary == nullptr )
+    return false;
+  GLint no_of_formats = 0;
+  glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &no_of_formats );
+  return no_of_formats > 0;
+}
+
+
+/******************************************************************//**
+* \brief Get the identity of a program.
+*
+* The identity is made up of the vendor, renderer and version strings
+* of the current context and the program description.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::string CProgramBinaryCache::Identity( 
+  const std::string &program_description ) const //!< I - sources and bindings of the program
+{
+  std::string identity;
+  for ( GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION } )
+  {
+    const GLubyte *str = glGetString( name );
+    identity += str != nullptr ? (const char*)str : "";
+    identity += '\0';
+  }
+  identity += program_description;
+  return identity;
+}
+
+
+/******************************************************************//**
+* \brief Get the key of a program.
+*
+* The key is the hash code of the identity of the program.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::string CProgramBinaryCache::Key( 
+  const std::string &identity ) //!< I - identity of the program
+{
+  std::stringstream str_stream;
+  str_stream << std::hex;
+  str_stream.width( 16 );
+  str_stream.fill( '0' );
+  str_stream << Render::HashFNV1a64( identity );
+  return str_stream.str();
+}
+
+
+/******************************************************************//**
+* \brief Path of the binary file of a program.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::string CProgramBinaryCache::Path( 
+  const std::string &key ) const //!< I - key of the program
+{
+  return ( std::filesystem::path( _directory ) / ( key + ".glpb" ) ).string();
+}
+
+
+/******************************************************************//**
+* \brief Read the binary of a program.
+*
+* The binary is only read, if the identity, which is stored in the
+* file, is equal to the identity of the program. The sizes in the
+* header are checked against the size of the file, before anything is
+* allocated.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CProgramBinaryCache::Load( 
+  const std::string &key,      //!< I - key of the program
+  const std::string &identity, //!< I - identity of the program
+  unsigned int      &format,   //!< O - binary format
+  std::vector<char> &binary    //!< O - program binary
+  ) const
+{
+  std::string path = Path( key );
+  std::error_code error;
+  std::uintmax_t file_size = std::filesystem::file_size( path, error );
+  if ( error )
+    return false;
+
+  std::ifstream file( path, std::ios::binary );
+  if ( file.is_open() == false )
+    return false;
+
+  TBinaryFileHeader header{};
+  file.read( (char*)&header, sizeof( header ) );
+  if ( file.good() == false ||
+       header._magic != c_binary_file_magic || 
+       header._version != c_binary_file_version ||
+       header._identity_size != identity.size() ||
+       header._size == 0 ||
+       file_size != (std::uintmax_t)sizeof( header ) + header._identity_size + header._size )
+    return false;
+
+  std::string file_identity( header._identity_size, '\0' );
+  file.read( file_identity.data(), header._identity_size );
+  if ( (size_t)file.gcount() != header._identity_size || file_identity != identity )
+    return false;
+
+  binary.resize( header._size );
+  file.read( binary.data(), header._size );
+  if ( (size_t)file.gcount() != header._size )
+    return false;
+  format = header._format;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Write the binary of a program.
+*
+* The binary is written to a temporary file, which is renamed, so that
+* concurrent processes never read an incomplete file. The name of the
+* temporary file is unique for each process and each write (random
+* suffix and write counter), so concurrent writers of the same program
+* never write to the same file. If the write fails, the temporary file
+* is removed.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CProgramBinaryCache::Store( 
+  const std::string       &key,      //!< I - key of the program
+  const std::string       &identity, //!< I - identity of the program
+  unsigned int             format,   //!< I - binary format
+  const std::vector<char> &binary    //!< I - program binary
+  )
+{
+  static std::atomic<std::uint64_t> write_count{ 0 };
+  static const std::uint64_t        process_tag = ( (std::uint64_t)std::random_device()() << 32 ) ^ std::random_device()();
+
+  std::stringstream temp_suffix;
+  temp_suffix << "." << std::hex << process_tag << "_" << ++ write_count << ".tmp";
+  std::string path      = Path( key );
+  std::string temp_path = path + temp_suffix.str();
+
+  std::error_code error;
+  {
+    std::ofstream file( temp_path, std::ios::binary | std::ios::trunc );
+    if ( file.is_open() == false )
+      return false;
+
+    TBinaryFileHeader header{ c_binary_file_magic, c_binary_file_version, format, (std::uint32_t)binary.size(), (std::uint32_t)identity.size(), 0 };
+    file.write( (const char*)&header, sizeof( header ) );
+    file.write( identity.data(), identity.size() );
+    file.write( binary.data(), binary.size() );
+    file.close();
+    if ( file.fail() )
+    {
+      std::filesystem::remove( temp_path, error );
+      return false;
+    }
+  }
+
+  std::filesystem::rename( temp_path, path, error );
+  if ( error )
+  {
+    std::filesystem::remove( temp_path, error );
+    return false;
+  }
+  ++ _statistics._stored;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Remove a binary, which was rejected by the driver.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CProgramBinaryCache::Reject( 
+  const std::string &key ) //!< I - key of the program
+{
+  ++ _statistics._rejected;
+  std::error_code error;
+  std::filesystem::remove( Path( key ), error );
+}
+
+
+/******************************************************************//**
+* \brief Report of the statistics.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::string CProgramBinaryCache::Report( void ) const
+{
+  std::stringstream str_stream;
+  str_stream << "program cache " << _directory << ": "
+    << _statistics._hits << " loaded in " << _statistics._hit_ms << " ms, "
+    << _statistics._misses << " compiled in " << _statistics._miss_ms << " ms, "
+    << _statistics._stored << " stored, " << _statistics._rejected << " rejected";
+  return str_stream.str();
+}
+
+
 } // OpenGL
 
@@ -0,0 +1,201 @@
+/******************************************************************//**
+* \brief   Asynchronous read back of the framebuffer by pixel buffer
+*          objects.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+// includes
+
+#include <stdafx.h>
+
+// OpenGL
+
+#include "../../include/OpenGL/OpenGLReadback.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cstring>
+
+
+// class implementations
+
+
+/******************************************************************//**
+* \brief General namespace for OpenGL implementation.
+*
+* \author  gernot
+* \date    2018-09-07
+* \version 1.0
+**********************************************************************/
+namespace OpenGL
+{
+
+
+/******************************************************************//**
+* \brief   ctor.
+*
+* The GPU objects are created by the first `Read`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CAsyncReadback::CAsyncReadback(
+  size_t no_of_buffers ) //!< I - number of buffers in the ring
+  : _buffers( std::max( no_of_buffers, (size_t)1 ) )
+{}
+
+
+/******************************************************************//**
+* \brief   dtor.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CAsyncReadback::~CAsyncReadback()
+{
+  Destroy();
+}
+
+
+/******************************************************************//**
+* \brief   Delete the buffers and the fences; pending frames are
+*          dropped.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CAsyncReadback::Destroy( void )
+{
+  for ( auto &buffer : _buffers )
+  {
+    if ( buffer._fence != nullptr )
+      glDeleteSync( buffer._fence );
+    if ( buffer._object != 0 )
+      glDeleteBuffers( 1, &buffer._object );
+    buffer = TBuffer{};
+  }
+  _next = 0;
+  _pending = 0;
+}
+
+
+/******************************************************************//**
+* \brief   Start the read back of a rectangle of the read framebuffer.
+*
+* The pixels are copied to the next buffer of the ring, and a fence is
+* inserted. If the ring is full, nothing is done and the function
+* returns false.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CAsyncReadback::Read(
+  int    x,      //!< I - left
+  int    y,      //!< I - bottom
+  size_t width,  //!< I - width
+  size_t height, //!< I - height
+  size_t tag )   //!< I - user value, which is returned with the frame
+{
+  if ( _pending == _buffers.size() )
+    return false;
+
+  TBuffer &buffer = _buffers[_next];
+  size_t size = width * height * 4;
+  if ( buffer._object == 0 )
+    glGenBuffers( 1, &buffer._object );
+  glBindBuffer( GL_PIXEL_PACK_BUFFER, buffer._object );
+  if ( buffer._capacity != size )
+  {
+    glBufferData( GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ );
+    buffer._capacity = size;
+  }
+
+  glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+  glReadPixels( x, y, (GLsizei)width, (GLsizei)height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
+  glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+  OPENGL_CHECK_GL_ERROR
+
+  // the flush ensures, that the fence is signaled without a further command
+  buffer._fence = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+  glFlush();
+
+  buffer._width = width;
+  buffer._height = height;
+  buffer._tag = tag;
+  _next = (_next + 1) % _buffers.size();
+  ++ _pending;
+  ++ _statistics._reads;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Retrieve the oldest pending frame.
+*
+* If `wait` is false, the function returns false, when the fence of
+* the frame is not signaled yet.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CAsyncReadback::Retrieve(
+  TFrame &frame, //!< O - RGBA8 frame, top row first
+  bool    wait ) //!< I - wait for the GPU
+{
+  if ( _pending == 0 )
+    return false;
+
+  TBuffer &buffer = _buffers[(_next + _buffers.size() - _pending) % _buffers.size()];
+  GLenum status = glClientWaitSync( buffer._fence, 0, 0 );
+  if ( status == GL_TIMEOUT_EXPIRED )
+  {
+    if ( wait == false )
+      return false;
+    ++ _statistics._stalls;
+    do
+    {
+      status = glClientWaitSync( buffer._fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000 );
+    }
+    while ( status == GL_TIMEOUT_EXPIRED );
+  }
+  glDeleteSync( buffer._fence );
+  buffer._fence = nullptr;
+  -- _pending;
+  if ( status == GL_WAIT_FAILED )
+    return false;
+
+  size_t row = buffer._width * 4;
+  frame._width = buffer._width;
+  frame._height = buffer._height;
+  frame._tag = buffer._tag;
+  frame._rgba.resize( row * buffer._height );
+
+  glBindBuffer( GL_PIXEL_PACK_BUFFER, buffer._object );
+  const auto *pixels = (const std::uint8_t*)glMapBufferRange( GL_PIXEL_PACK_BUFFER, 0, row * buffer._height, GL_MAP_READ_BIT );
+  if ( pixels != nullptr )
+  {
+    for ( size_t y = 0; y < buffer._height; ++ y )
+      std::memcpy( frame._rgba.data() + y * row, pixels + (buffer._height - 1 - y) * row, row );
+    glUnmapBuffer( GL_PIXEL_PACK_BUFFER );
+  }
+  glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+  OPENGL_CHECK_GL_ERROR
+
+  if ( pixels == nullptr )
+    return false;
+  ++ _statistics._retrieved;
+  return true;
+}
+
+
+} // OpenGL
@@ -14,6 +14,8 @@
 // OpenGL
 
 #include "../../include/OpenGL/OpenGLTextureLoader.h"
+#include "../../include/OpenGL/OpenGLStateCache.h"
+#include "../../include/util/RenderUtil_Profiler.h"
 
 // OpenGL wrapper
 
@@ -84,12 +86,12 @@ public:
   virtual ~CTextureInternal()
   {
     if ( _texture_obj != 0 )
-      glDeleteTextures( 1, &_texture_obj );
+      CStateCache::Current().DeleteTextures( 1, &_texture_obj );
   }
 
   virtual size_t ObjectHandle( void ) const override { return _texture_obj; }
   virtual size_t DetachHandle( void )       override { unsigned int hdl = _texture_obj; _texture_obj = 0; return hdl; }
-  virtual void   AttachHandle( size_t hdl ) override { glDeleteTextures( 1, &_texture_obj ); _texture_obj = (unsigned int)hdl; }
+  virtual void   AttachHandle( size_t hdl ) override { CStateCache::Current().DeleteTextures( 1, &_texture_obj ); _texture_obj = (unsigned int)hdl; }
 
   virtual Render::TTextureType Type( void ) const override { return _type; }
 
@@ -203,20 +205,19 @@ bool CTextureLoader::BindTexture(
 {
   if ( _dsa )
   {
-    glBindTextureUnit((GLuint)binding_id, texture_object);
+    CStateCache::Current().BindTextureUnit( (GLuint)binding_id, target, texture_object );
   }
   else if ( glActiveTexture != nullptr )
   {
     // Bind the default texture to the texture unit.
     // In common there should be no necessity of this and there should not be any reason to do this.
-    glActiveTexture( (GLenum)(GL_TEXTURE0 + binding_id) );
-    glBindTexture( target, texture_object );
+    CStateCache::Current().BindTexture( (unsigned int)binding_id, target, texture_object );
     if ( binding_id != 0 && texture_object == 0 )
-      glActiveTexture( GL_TEXTURE0 );
+      CStateCache::Current().ActiveTexture( 0 );
   }
   else
   {
-    glBindTexture( target, texture_object );
+    CStateCache::Current().BindTexture( target, texture_object );
   }
   return true;
 }
@@ -289,7 +290,15 @@ unsigned int CTextureLoader::ImageFormat(
     { Render::TImageFormat::RGB8,  GL_RGB  },
     { Render::TImageFormat::BGR8,  GL_BGR  }, 
     { Render::TImageFormat::RGBA8, GL_RGBA },
-    { Render::TImageFormat::BGRA8, GL_BGRA }
+    { Render::TImageFormat::BGRA8, GL_BGRA },
+
+    // compressed image formats are passed to `glCompressedTexSubImage2D` 
+    { Render::TImageFormat::BC1_RGB,  GL_COMPRESSED_RGB_S3TC_DXT1_EXT  },
+    { Render::TImageFormat::BC1_RGBA, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT },
+    { Render::TImageFormat::BC3,      GL_COMPRESSED_RGBA_S3TC_DXT5_EXT },
+    { Render::TImageFormat::BC4,      GL_COMPRESSED_RED_RGTC1          },
+    { Render::TImageFormat::BC5,      GL_COMPRESSED_RG_RGTC2           },
+    { Render::TImageFormat::BC7,      GL_COMPRESSED_RGBA_BPTC_UNORM    }
   };
 
   auto it = image_foramt_map.find(format);
@@ -315,7 +324,13 @@ unsigned int CTextureLoader::ImageDataType(
     { Render::TImageFormat::RGB8,  GL_UNSIGNED_BYTE },
     { Render::TImageFormat::BGR8,  GL_UNSIGNED_BYTE }, 
     { Render::TImageFormat::RGBA8, GL_UNSIGNED_BYTE },
-    { Render::TImageFormat::BGRA8, GL_UNSIGNED_BYTE }
+    { Render::TImageFormat::BGRA8, GL_UNSIGNED_BYTE },
+    { Render::TImageFormat::BC1_RGB,  GL_UNSIGNED_BYTE },
+    { Render::TImageFormat::BC1_RGBA, GL_UNSIGNED_BYTE },
+    { Render::TImageFormat::BC3,      GL_UNSIGNED_BYTE },
+    { Render::TImageFormat::BC4,      GL_UNSIGNED_BYTE },
+    { Render::TImageFormat::BC5,      GL_UNSIGNED_BYTE },
+    { Render::TImageFormat::BC7,      GL_UNSIGNED_BYTE }
   };
 
   auto it = image_datatype_map.find(format);
@@ -342,7 +357,13 @@ unsigned int CTextureLoader::InternalFormat(
     { Render::TTextureFormat::RGB8,        GL_RGB8        }, 
     { Render::TTextureFormat::RGBA8,       GL_RGBA8       },
     { Render::TTextureFormat::RGB8_SNORM,  GL_RGB8_SNORM  },
-    { Render::TTextureFormat::RGB16_SNORM, GL_RGBA8_SNORM } 
+    { Render::TTextureFormat::RGB16_SNORM, GL_RGBA8_SNORM },
+    { Render::TTextureFormat::BC1_RGB,     GL_COMPRESSED_RGB_S3TC_DXT1_EXT  },
+    { Render::TTextureFormat::BC1_RGBA,    GL_COMPRESSED_RGBA_S3TC_DXT1_EXT },
+    { Render::TTextureFormat::BC3_RGBA,    GL_COMPRESSED_RGBA_S3TC_DXT5_EXT },
+    { Render::TTextureFormat::BC4_R,       GL_COMPRESSED_RED_RGTC1          },
+    { Render::TTextureFormat::BC5_RG,      GL_COMPRESSED_RG_RGTC2           },
+    { Render::TTextureFormat::BC7_RGBA,    GL_COMPRESSED_RGBA_BPTC_UNORM    }
   };
 
   auto it = internal_foramt_map.find(format);
@@ -536,6 +557,11 @@ bool CTextureLoader::GenerateMipmaps(
   if ( parameter._max_mipmap <= 1 )
     return false;
 
+  // `glGenerateMipmap` doesn't support compressed textures;
+  // the mipmap levels have to be loaded by `CreateTexture( mipmaps, parameter )`
+  if ( parameter.IsCompressed() )
+    return false;
+
   //! [`glGenerateMipmap`](https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glGenerateMipmap.xhtml)
 
   if ( _dsa )
@@ -551,6 +577,108 @@ bool CTextureLoader::GenerateMipmaps(
 }
 
 
+/******************************************************************//**
+* \brief   Allocate an uninitialized level of a texture.
+*
+* The texture has to be bound to the target.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTextureLoader::AllocateLevel(
+  unsigned int                      target,    //!< in: texture target
+  int                               level,     //!< in: mipmap level
+  const Render::TTextureParameters &parameter, //!< in: texture properties
+  size_t                            cx,        //!< in: width of the level
+  size_t                            cy )       //!< in: height of the level
+{
+  GLenum internal_format = InternalFormat( parameter._format );
+  if ( parameter.IsCompressed() )
+  {
+    size_t size = Render::CompressedImageSize( parameter.CompressedImageFormat(), cx, cy );
+    glCompressedTexImage2D( target, level, internal_format, (GLsizei)cx, (GLsizei)cy, 0, (GLsizei)size, nullptr );
+    return;
+  }
+
+  static const std::unordered_map< Render::TTextureFormat, std::tuple<GLenum, GLenum> > compatible_foramt_map
+  {
+    { Render::TTextureFormat::R8,          { GL_RED,  GL_BYTE  } },
+    { Render::TTextureFormat::RG8,         { GL_RG,   GL_BYTE  } },
+    { Render::TTextureFormat::RGB8,        { GL_RGB,  GL_BYTE  } }, 
+    { Render::TTextureFormat::RGBA8,       { GL_RGBA, GL_BYTE  } },
+    { Render::TTextureFormat::RGB8_SNORM,  { GL_RGB,  GL_FLOAT } },
+    { Render::TTextureFormat::RGB16_SNORM, { GL_RGBA, GL_FLOAT } } 
+  };
+
+  auto it = compatible_foramt_map.find(parameter._format);
+  ASSERT( it != compatible_foramt_map.end() );
+  GLenum format = it != compatible_foramt_map.end() ? std::get<0>( it->second ) : GL_RGBA;
+  GLenum type   = it != compatible_foramt_map.end() ? std::get<1>( it->second ) : GL_BYTE;
+  glTexImage2D( target, level, internal_format, (GLsizei)cx, (GLsizei)cy, 0, format, type, nullptr );
+}
+
+
+/******************************************************************//**
+* \brief   Allocate the mipmap levels 1 to `levels`-1 of a texture.
+*
+* Level 0 is allocated by `CreateTexture`. The size of the levels is
+* halved successively, like by `glGenerateMipmap`.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextureLoader::AllocateLevels(
+  Render::ITexture                 &texture,   //!< in: target texture
+  const Render::TTextureParameters &parameter, //!< in: texture properties
+  const Render::TTextureSize       &size,      //!< in: size of level 0
+  size_t                            levels )   //!< in: total number of levels
+{
+  GLenum target = TargetType( texture.Type() );
+  if ( target != GL_TEXTURE_2D )
+  {
+    DebugWarning << "allocating texture levels with target " << target << "is not yet implemented";
+    return false;
+  }
+
+  if ( _dsa )
+    CStateCache::Current().BindTexture( target, (GLuint)texture.ObjectHandle() );
+  else
+    texture.Bind( _loader_binding_id );
+  for ( size_t level = 1; level < levels; ++ level )
+    AllocateLevel( target, (GLint)level, parameter, std::max( size[0] >> level, (size_t)1 ), std::max( size[1] >> level, (size_t)1 ) );
+  if ( _dsa )
+    CStateCache::Current().BindTexture( target, 0 );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Restrict the accessible mipmap levels of a texture.
+*
+* While the finer levels of a texture are streamed, the base level is
+* set to the finest level which has been loaded, so the texture stays
+* complete.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextureLoader::SetLevelRange(
+  Render::ITexture &texture,    //!< in: target texture
+  size_t            base_level, //!< in: finest accessible level
+  size_t            max_level ) //!< in: coarsest accessible level
+{
+  GLenum target = TargetType( texture.Type() );
+  if ( _dsa == false )
+    texture.Bind( _loader_binding_id );
+  SetTextureParameterI( target, (GLuint)texture.ObjectHandle(), GL_TEXTURE_BASE_LEVEL, (GLint)base_level );
+  SetTextureParameterI( target, (GLuint)texture.ObjectHandle(), GL_TEXTURE_MAX_LEVEL, (GLint)max_level );
+  return true;
+}
+
+
 /******************************************************************//**
 * \brief   Create a new but empty texture.
 * 
@@ -602,7 +730,6 @@ Render::ITexturePtr CTextureLoader::CreateTexture(
   }
 
   // load texture image
-  GLenum internal_format = InternalFormat( parameter._format );
   if ( _dsa )
   {
     // [What's the DSA version of glTexImage2D?](https://gamedev.stackexchange.com/questions/134177/whats-the-dsa-version-of-glteximage2d)
@@ -612,23 +739,9 @@ Render::ITexturePtr CTextureLoader::CreateTexture(
     texture->AttachHandle( tbo );
     //glTextureStorage2D( (GLuint)texture->ObjectHandle(), 1, internal_format, (GLsizei)size[0], (GLsizei)size[1] );
 
-    static const std::unordered_map< Render::TTextureFormat, std::tuple<GLenum, GLenum> > compatible_foramt_map
-    {
-      { Render::TTextureFormat::R8,          { GL_RED,  GL_BYTE  } },
-      { Render::TTextureFormat::RG8,         { GL_RG,   GL_BYTE  } },
-      { Render::TTextureFormat::RGB8,        { GL_RGB,  GL_BYTE  } }, 
-      { Render::TTextureFormat::RGBA8,       { GL_RGBA, GL_BYTE  } },
-      { Render::TTextureFormat::RGB8_SNORM,  { GL_RGB,  GL_FLOAT } },
-      { Render::TTextureFormat::RGB16_SNORM, { GL_RGBA, GL_FLOAT } } 
-    };
-
-    auto it = compatible_foramt_map.find(parameter._format);
-    ASSERT( it != compatible_foramt_map.end() );
-    GLenum format = it != compatible_foramt_map.end() ? std::get<0>( it->second ) : GL_RGBA;
-    GLenum type   = it != compatible_foramt_map.end() ? std::get<1>( it->second ) : GL_BYTE;
-    glBindTexture( target, tbo );
-    glTexImage2D( target, 0, internal_format, (GLsizei)size[0], (GLsizei)size[1], 0, format, type, nullptr );
-    glBindTexture( target, 0 );
+    CStateCache::Current().BindTexture( target, tbo );
+    AllocateLevel( target, 0, parameter, size[0], size[1] );
+    CStateCache::Current().BindTexture( target, 0 );
   }
   /*
   else if ( glTexStorage2D != nullptr )
@@ -640,21 +753,7 @@ Render::ITexturePtr CTextureLoader::CreateTexture(
   */
   else
   {
-    static const std::unordered_map< Render::TTextureFormat, std::tuple<GLenum, GLenum> > compatible_foramt_map
-    {
-      { Render::TTextureFormat::R8,          { GL_RED,  GL_BYTE  } },
-      { Render::TTextureFormat::RG8,         { GL_RG,   GL_BYTE  } },
-      { Render::TTextureFormat::RGB8,        { GL_RGB,  GL_BYTE  } }, 
-      { Render::TTextureFormat::RGBA8,       { GL_RGBA, GL_BYTE  } },
-      { Render::TTextureFormat::RGB8_SNORM,  { GL_RGB,  GL_FLOAT } },
-      { Render::TTextureFormat::RGB16_SNORM, { GL_RGBA, GL_FLOAT } } 
-    };
-
-    auto it = compatible_foramt_map.find(parameter._format);
-    ASSERT( it != compatible_foramt_map.end() );
-    GLenum format = it != compatible_foramt_map.end() ? std::get<0>( it->second ) : GL_RGBA;
-    GLenum type   = it != compatible_foramt_map.end() ? std::get<1>( it->second ) : GL_BYTE;
-    glTexImage2D( target, 0, internal_format, (GLsizei)size[0], (GLsizei)size[1], 0, format, type, nullptr );
+    AllocateLevel( target, 0, parameter, size[0], size[1] );
   }
 
   // set the texture parameters
@@ -667,6 +766,10 @@ Render::ITexturePtr CTextureLoader::CreateTexture(
 
 /******************************************************************//**
 * \brief   Create a new texture from an image resource.
+*
+* The height map transformations are applied on the CPU by
+* `Render::CHeightMapTransform` and are cached, if a cache directory
+* is set.
 * 
 * \author  gernot
 * \date    2018-06-09
@@ -692,15 +795,46 @@ Render::ITexturePtr CTextureLoader::CreateTexture(
     transform_compatible.reset( (int)Render::TImageTransform::to_displacement_map );
   if ( transform_compatible.test( (int)Render::TImageTransform::to_normal_and_displacement ) && image.Kind() == Render::TImageKind::normal_displacement_map)
     transform_compatible.reset( (int)Render::TImageTransform::to_normal_and_displacement );
+
+  // height map transformations
+  Render::CMipmapImage transformed_image;
+  if ( Render::CHeightMapTransform::IsHeightMapTransform( transform_compatible ) )
+  {
+    Render::CHeightMapTransform height_map_transform( _height_map_parameters );
+    bool transformed = false;
+    if ( _height_map_cache_directory.empty() )
+    {
+      transformed = height_map_transform.Transform( image, transform_compatible, transformed_image );
+    }
+    else
+    {
+      Render::CMipmapChain::TKey key = height_map_transform.Key( image, transform_compatible );
+      std::string cache_filename = Render::CHeightMapTransform::CacheFilename( _height_map_cache_directory, key );
+      transformed = height_map_transform.Transform( image, transform_compatible, transformed_image, cache_filename, key );
+    }
+    if ( transformed == false )
+      return nullptr;
+
+    transform_compatible.reset( (int)Render::TImageTransform::to_displacement_map );
+    transform_compatible.reset( (int)Render::TImageTransform::to_normal_and_displacement );
+  }
+  const Render::IImageResource &source = transformed_image.Data().empty() ? image : transformed_image;
  
-  if ( image.Size() == size && transform_compatible.none() )
+  if ( source.Size() == size && transform_compatible.none() )
   {                                                        
     Render::TTextureParameters create_parameter = TextureParamterLeve0( parameter );
     auto texture = CreateTexture( size, layers, create_parameter, false );
 
-    if ( LoadToTexture( image, *texture.get(), { 0, 0, 0 }, 0 ) == false )
+    if ( LoadToTexture( source, *texture.get(), { 0, 0, 0 }, 0 ) == false )
       return nullptr;
 
+    // compressed textures can't generate mipmaps
+    if ( parameter.IsCompressed() )
+    {
+      SetTextureParameter( (GLuint)texture->ObjectHandle(), create_parameter, MaxAnisotropicSamples() );
+      return texture;
+    }
+
     SetTextureParameter( (GLuint)texture->ObjectHandle(), parameter, MaxAnisotropicSamples() ); 
     GenerateMipmaps( (GLuint)texture->ObjectHandle(), parameter );
     return texture;
@@ -720,7 +854,56 @@ Render::ITexturePtr CTextureLoader::CreateTexture(
 
 
 /******************************************************************//**
-* \brief   Load image data to texture.
+* \brief   Create a new texture from a complete chain of mipmap levels.
+*
+* The mipmap levels are loaded as they are, e.g. generated by
+* `Render::CMipmapGenerator`, so `glGenerateMipmap` is not invoked.
+* The first image of the list is level 0.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+Render::ITexturePtr CTextureLoader::CreateTexture(
+  const std::vector<const Render::IImageResource*> &mipmaps,    //!< in: source image resources of the mipmap levels
+  const Render::TTextureParameters                 &parameter ) //!< in: texture properties
+{
+  GLenum target = TargetType( parameter._type );
+  if ( target != GL_TEXTURE_2D || mipmaps.empty() || mipmaps[0] == nullptr )
+  {
+    DebugWarning << "creating texture with target " << target << "from mipmap levels is not yet implemented";
+    return nullptr;
+  }
+
+  // create level 0
+  const Render::IImageResource &image = *mipmaps[0];
+  Render::TTextureParameters create_parameter = TextureParamterLeve0( parameter );
+  auto texture = CreateTexture( image.Size(), image.Layers(), create_parameter, false );
+  if ( texture == nullptr || LoadToTexture( image, *texture.get(), { 0, 0, 0 }, 0, 0 ) == false )
+    return nullptr;
+
+  // allocate and load the mipmap levels
+  size_t no_of_levels = parameter._max_mipmap > 0 ? std::min( mipmaps.size(), (size_t)parameter._max_mipmap + 1 ) : 1;
+  no_of_levels = (size_t)( std::find( mipmaps.begin(), mipmaps.begin() + no_of_levels, nullptr ) - mipmaps.begin() );
+  AllocateLevels( *texture.get(), parameter, image.Size(), no_of_levels );
+  for ( size_t level = 1; level < no_of_levels; ++ level )
+    LoadToTexture( *mipmaps[level], *texture.get(), { 0, 0, 0 }, 0, level );
+
+  // the number of mipmap levels is limited by the chain
+  Render::TTextureParameters texture_parameter = parameter;
+  texture_parameter._max_mipmap = (int)no_of_levels - 1;
+  if ( texture_parameter._max_mipmap == 0 && texture_parameter._filter == Render::TTextureFilter::trilinear )
+    texture_parameter._filter = Render::TTextureFilter::bilinear;
+  SetTextureParameter( (GLuint)texture->ObjectHandle(), texture_parameter, MaxAnisotropicSamples() ); 
+  if ( no_of_levels > 1 )
+    SetTextureParameterI( target, (GLuint)texture->ObjectHandle(), GL_TEXTURE_MAX_LEVEL, (GLint)no_of_levels - 1 );
+
+  return texture;
+}
+
+
+/******************************************************************//**
+* \brief   Load image data to a mipmap level of a texture.
 * 
 * \author  gernot
 * \date    2018-06-09
@@ -730,7 +913,8 @@ bool CTextureLoader::LoadToTexture(
   const Render::IImageResource &image,   //!< in: source image resource
   Render::ITexture             &texture, //!< in: target texture 
   const Render::TTexturePoint  &pos,     //!< in: target position
-  size_t                        layer )  //!< in: target layer
+  size_t                        layer,   //!< in: target layer
+  size_t                        level )  //!< in: target mipmap level
 {
   GLenum target = TargetType( texture.Type() );
   if ( target != GL_TEXTURE_2D )
@@ -739,17 +923,39 @@ bool CTextureLoader::LoadToTexture(
     return false;
   }
 
+  // load compressed 4x4 blocks
+  // The position and the size have to be aligned to the blocks, except at the right and bottom border of the texture.
+  size_t compressed_block_size = Render::CompressedBlockSize( image.Format() );
+  if ( compressed_block_size > 0 )
+  {
+    GLenum format = ImageFormat( image.Format() );
+    size_t size   = Render::CompressedImageSize( image.Format(), image.Size()[0], image.Size()[1] );
+    glCompressedTexSubImage2D( GL_TEXTURE_2D, (GLint)level, (GLint)pos[0], (GLint)pos[1], (GLsizei)image.Size()[0], (GLsizei)image.Size()[1], format, (GLsizei)size, image.DataPtr() );
+    RENDERUTIL_PROFILE_COUNT( bytes_uploaded, size )
+    return true;
+  }
+
   // set the alignment of the start of a line of the image resource
   size_t alignment = image.LineAlign();
   glPixelStorei( GL_UNPACK_ALIGNMENT, (GLint)alignment );
 
+  // set the length of a line, if the image resource is a region of a larger image
+  size_t texel_size = Render::ImageTexelSize( image.Format() );
+  size_t packed_bpl = ( ( image.Size()[0] * texel_size + alignment - 1 ) / alignment ) * alignment;
+  bool   sub_region = texel_size > 0 && image.BPL() > packed_bpl;
+  if ( sub_region )
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, (GLint)( image.BPL() / texel_size ) );
+
   // load the color plane of the image resource to the texture 
   GLenum format = ImageFormat( image.Format() );
   GLenum type   = ImageDataType( image.Format() );
-  glTexSubImage2D(GL_TEXTURE_2D, 0, (GLsizei)pos[0], (GLsizei)pos[1], (GLsizei)image.Size()[0], (GLsizei)image.Size()[1], format, type, image.DataPtr() );
+  glTexSubImage2D(GL_TEXTURE_2D, (GLint)level, (GLsizei)pos[0], (GLsizei)pos[1], (GLsizei)image.Size()[0], (GLsizei)image.Size()[1], format, type, image.DataPtr() );
+  RENDERUTIL_PROFILE_COUNT( bytes_uploaded, image.Size()[1] * image.BPL() )
 
-  // set the default alignment
+  // set the default alignment and line length
   glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+  if ( sub_region )
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
 
   return true;
 }
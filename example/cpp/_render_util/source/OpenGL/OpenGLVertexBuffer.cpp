@@ -13,6 +13,8 @@
 #include <stdafx.h>
 
 #include "../../include/OpenGL/OpenGLVertexBuffer.h"
+#include "../../include/OpenGL/OpenGLStateCache.h"
+#include "../../include/util/RenderUtil_Profiler.h"
 
 
 // OpenGL wrapper
@@ -24,6 +26,9 @@
 
 #include <array>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <numeric>
 #include <assert.h>
 
 
@@ -37,6 +42,28 @@ namespace OpenGL
 {
 
 
+namespace
+{
+
+
+//! size of an attribute element in bytes
+size_t AttributeTypeSize( Render::TAttributeType elem_type )
+{
+  switch ( elem_type )
+  {
+    case Render::eFloat32:      return 4;
+    case Render::eFloat64:      return 8;
+    case Render::eAttribUInt8:  return 1;
+    case Render::eAttribUInt16: return 2;
+    case Render::eAttribUInt32: return 4;
+  }
+  return 4;
+}
+
+
+} // anonymous namespace
+
+
 /******************************************************************//**
 * \brief   default ctor
 * 
@@ -78,10 +105,15 @@ CDrawBuffer::CDrawBuffer(
   _currentVAO   = src._currentVAO,   src._currentVAO = 0;
   _currNoElems  = src._currNoElems,  src._currNoElems = 0;
   _currElemSize = src._currElemSize, src._currElemSize = 0;
+  _currIndexOffs = src._currIndexOffs, src._currIndexOffs = 0;
+  _streamSupport = src._streamSupport, src._streamSupport = -1;
   _vbos         = std::move( src._vbos );
   _ibos         = std::move( src._ibos );
   _vaos         = std::move( src._vaos );
   _shortcuts    = std::move( src._shortcuts );
+  _rings        = std::move( src._rings );
+  _vaoOffsets   = std::move( src._vaoOffsets );
+  _streamStatistics = src._streamStatistics;
 }
 
 
@@ -100,10 +132,15 @@ CDrawBuffer & CDrawBuffer::operator = (
   _currentVAO   = src._currentVAO,   src._currentVAO = 0;
   _currNoElems  = src._currNoElems,  src._currNoElems = 0;
   _currElemSize = src._currElemSize, src._currElemSize = 0;
+  _currIndexOffs = src._currIndexOffs, src._currIndexOffs = 0;
+  _streamSupport = src._streamSupport, src._streamSupport = -1;
   _vbos         = std::move( src._vbos );
   _ibos         = std::move( src._ibos );
   _vaos         = std::move( src._vaos );
   _shortcuts    = std::move( src._shortcuts );
+  _rings        = std::move( src._rings );
+  _vaoOffsets   = std::move( src._vaoOffsets );
+  _streamStatistics = src._streamStatistics;
 
   return * this;
 }
@@ -122,6 +159,16 @@ CDrawBuffer::~CDrawBuffer()
   UnbindAnyVertexArrayObject();
   OPENGL_CHECK_GL_ERROR
 
+  // delete the fences of the ring buffers; the mappings are released with the buffers
+  for ( auto &ring : _rings )
+  {
+    for ( auto fence : ring.second._fences )
+    {
+      if ( fence != nullptr )
+        glDeleteSync( static_cast<GLsync>( fence ) );
+    }
+  }
+
   // delete array buffers
   std::vector<TGPUObj> vbos( _vbos.size() );
   std::transform( _vbos.begin(), _vbos.end(), vbos.begin(), [](auto &vbo) -> TGPUObj { return std::get<c_obj>( vbo ); } );
@@ -145,7 +192,7 @@ CDrawBuffer::~CDrawBuffer()
   std::transform( _vaos.begin(), _vaos.end(), vaos.begin(), [](auto &vao) -> TGPUObj { return std::get<c_obj>( vao.second ); } );
   if ( vaos.empty() == false )
   {
-    glDeleteVertexArrays( static_cast<GLsizei>(vaos.size()), vaos.data() );
+    CStateCache::Current().DeleteVertexArrays( static_cast<GLsizei>(vaos.size()), vaos.data() );
     OPENGL_CHECK_GL_ERROR
   }
 }
@@ -161,7 +208,7 @@ CDrawBuffer::~CDrawBuffer()
 void CDrawBuffer::BindVertexArrayObject( 
   unsigned int currentVAO ) //!< I - vertex array object
 {
-  glBindVertexArray( currentVAO );
+  CStateCache::Current().BindVertexArray( currentVAO );
 }
 
 
@@ -174,7 +221,7 @@ void CDrawBuffer::BindVertexArrayObject(
 **********************************************************************/
 void CDrawBuffer::UnbindAnyVertexArrayObject( void )
 {
-  glBindVertexArray( 0 );
+  CStateCache::Current().BindVertexArray( 0 );
 }
 
 
@@ -261,7 +308,7 @@ unsigned int CDrawBuffer::IndexType(
 **********************************************************************/
 unsigned int CDrawBuffer::Usage( void ) const
 {
-  const static std::array<GLenum, 3> usage{ GL_STATIC_DRAW, GL_DYNAMIC_DRAW, GL_STREAM_DRAW };
+  const static std::array<GLenum, 4> usage{ GL_STATIC_DRAW, GL_DYNAMIC_DRAW, GL_STREAM_DRAW, GL_STREAM_DRAW };
   return usage[(int)_usage];
 }
 
@@ -306,15 +353,16 @@ void CDrawBuffer::DefineAndEnableAttribute(
   int                    attr_id,   //!< I - attribute index
   int                    attr_size, //!< I - size of attribute: 1, 2, 3 or 4
   Render::TAttributeType elem_type, //!< I - type id of an element
-  int                    attr_offs, //!< I - offset of the attribute in the attribute record set
-  int                    stride     //!< I - stride between two attribute record sets 
+  int                    attr_offs,  //!< I - offset of the attribute in the attribute record set
+  int                    stride,     //!< I - stride between two attribute record sets 
+  size_t                 buffer_offs //!< I - offset of the first attribute record set in the buffer
   ) const
 {
   assert( attr_id >= 0 );
   if ( attr_id < 0 )
     return;
   
-  glVertexAttribPointer( attr_id, attr_size, DataType(elem_type), GL_FALSE, stride, (void*)(stride == 0 ? 0 : (size_t)attr_offs) );
+  glVertexAttribPointer( attr_id, attr_size, DataType(elem_type), GL_FALSE, stride, (void*)((stride == 0 ? 0 : (size_t)attr_offs) + buffer_offs) );
   glEnableVertexAttribArray( attr_id );
   OPENGL_CHECK_GL_ERROR
 }
@@ -348,7 +396,8 @@ void CDrawBuffer::DisableAttribute(
 * \version 1.0
 **********************************************************************/
 void CDrawBuffer::PreprateAttributesAndIndices( 
-  const TDescription &key ) //!< I - description - specification of vertices and indices
+  const TDescription &key,            //!< I - description - specification of vertices and indices
+  const size_t       *buffer_offsets ) //!< I - optional byte offset of the attributes in each array buffer of the description 
 {
   int i_ibo        = key[eHeadOffset_ibo];       // index buffer id (< 0 means no index buffer)
   size_t no_of_vbo = key[eHeadOffset_no_of_vbo]; // number of array buffers
@@ -369,7 +418,7 @@ void CDrawBuffer::PreprateAttributesAndIndices(
       int attr_type = key[i_key + eAtrributeOffset_type];   // type id of the attribute
       int attr_offs = key[i_key + eAtrributeOffset_offset]; // (offset / 4) of the attribute in the attribute set
       i_key += eAttributeSize;
-      this->DefineAndEnableAttribute( attr_id, attr_size, static_cast<Render::TAttributeType>(attr_type), attr_offs*4, stride*4 );
+      this->DefineAndEnableAttribute( attr_id, attr_size, static_cast<Render::TAttributeType>(attr_type), attr_offs*4, stride*4, buffer_offsets != nullptr ? buffer_offsets[i_vbo] : 0 );
     }
   }
   glBindBuffer( GL_ARRAY_BUFFER, 0 );
@@ -417,6 +466,10 @@ void CDrawBuffer::CreateMissingBuffers(
 
 /******************************************************************//**
 * \brief   Set data to buffer
+*
+* If the buffer is a streaming buffer, but persistent mapping is not
+* supported, then the buffer is orphaned before it is updated, so that
+* the update doesn't have to wait for pending draw calls.
 * 
 * \author  gernot
 * \date    2017-11-27
@@ -429,7 +482,7 @@ size_t CDrawBuffer::UpdateBuffer(
   size_t      min_size,  //!< I - minimum size for the buffer
   size_t      data_size, //!< I - new buffer size
   const void *data       //!< I - pointer to the data
-  ) const
+  )
 {
   glBindBuffer( type, bo );
   OPENGL_CHECK_GL_ERROR
@@ -453,6 +506,11 @@ size_t CDrawBuffer::UpdateBuffer(
     }
   }
   
+  if ( _usage == Render::TDrawBufferUsage::stream_ring )
+  {
+    glBufferData( type, static_cast<GLsizei>(curr_size), nullptr, Usage() );
+    ++ _streamStatistics._orphans;
+  }
   glBufferSubData( type, 0, static_cast<GLsizei>(data_size), data );
   glBindBuffer( type, 0 );
   OPENGL_CHECK_GL_ERROR
@@ -460,6 +518,372 @@ size_t CDrawBuffer::UpdateBuffer(
 }
 
 
+/******************************************************************//**
+* \brief   Check if persistently mapped ring buffers are supported by
+* the current context (OpenGL 4.4 or `ARB_buffer_storage`).
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CDrawBuffer::StreamRingSupported( void ) const
+{
+  return glBufferStorage != nullptr && glMapBufferRange != nullptr && glFenceSync != nullptr && glClientWaitSync != nullptr;
+}
+
+
+/******************************************************************//**
+* \brief   Check if the updates are streamed to ring buffers.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CDrawBuffer::StreamRing( void )
+{
+  if ( _usage != Render::TDrawBufferUsage::stream_ring )
+    return false;
+  if ( _streamSupport < 0 )
+    _streamSupport = StreamRingSupported() ? 1 : 0;
+  return _streamSupport == 1;
+}
+
+
+/******************************************************************//**
+* \brief   Create the persistently mapped storage of a ring buffer.
+*
+* The storage of a buffer is immutable. If the buffer has a storage
+* already, then it is replaced by a new buffer object and the vertex
+* array objects are specified again.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CDrawBuffer::CreateRing( 
+  TGPUObj &bo,        //!< IO - buffer object <GPU name>
+  size_t  &curr_size, //!< IO - size of the buffer
+  size_t   data_size, //!< I  - size of the data, which has to fit into a region
+  size_t   align )    //!< I  - alignment of the data
+{
+  bool replace = curr_size != 0;
+  if ( replace )
+  {
+    if ( _rings.find( bo ) != _rings.end() )
+      ++ _streamStatistics._grows;
+    DeleteRing( bo );
+    glDeleteBuffers( 1, &bo );
+    glGenBuffers( 1, &bo );
+    curr_size = 0;
+  }
+
+  size_t region_size = std::max( _minVboSize, (size_t)4096 );
+  while ( region_size < data_size + align )
+    region_size *= 2;
+  size_t buffer_size = c_ring_regions * region_size;
+
+  // `GL_COPY_WRITE_BUFFER` doesn't change the element array buffer binding of a bound vertex array object
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  glBindBuffer( GL_COPY_WRITE_BUFFER, bo );
+  glBufferStorage( GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(buffer_size), nullptr, flags );
+  void *ptr = glMapBufferRange( GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(buffer_size), flags );
+  glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+  OPENGL_CHECK_GL_ERROR
+
+  if ( ptr == nullptr )
+  {
+    // the immutable storage can't be used for orphaning; fall back to a new buffer object
+    assert( false );
+    _streamSupport = 0;
+    glDeleteBuffers( 1, &bo );
+    glGenBuffers( 1, &bo );
+    RespecifyVertexArrays();
+    return false;
+  }
+
+  TStreamRing ring;
+  ring._ptr         = static_cast<char*>( ptr );
+  ring._region_size = region_size;
+  _rings[bo] = ring;
+  curr_size = buffer_size;
+
+  if ( replace )
+    RespecifyVertexArrays();
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Delete the fences of a ring buffer and forget the ring.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CDrawBuffer::DeleteRing( 
+  TGPUObj bo ) //!< I - buffer object <GPU name>
+{
+  auto ringIt = _rings.find( bo );
+  if ( ringIt == _rings.end() )
+    return;
+  for ( auto fence : ringIt->second._fences )
+  {
+    if ( fence != nullptr )
+      glDeleteSync( static_cast<GLsync>( fence ) );
+  }
+  _rings.erase( ringIt );
+}
+
+
+/******************************************************************//**
+* \brief   Specify all the vertex array objects again, after a buffer 
+* object was replaced.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CDrawBuffer::RespecifyVertexArrays( void )
+{
+  for ( auto &vao : _vaos )
+  {
+    BindVertexArrayObject( std::get<c_obj>( vao.second ) );
+    PreprateAttributesAndIndices( std::get<c_descr>( vao.second ) );
+  }
+  UnbindAnyVertexArrayObject();
+  glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+  OPENGL_CHECK_GL_ERROR
+  _vaoOffsets.clear();
+}
+
+
+/******************************************************************//**
+* \brief   Wait until the GPU has finished reading a region of a ring
+* buffer.
+*
+* If the fence is not signaled yet, then the wait is counted as stall.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CDrawBuffer::WaitForRegion( 
+  TStreamRing &ring,   //!< I - ring buffer
+  size_t       region ) //!< I - region of the ring buffer
+{
+  GLsync fence = static_cast<GLsync>( ring._fences[region] );
+  if ( fence == nullptr )
+    return;
+
+  GLenum status = glClientWaitSync( fence, 0, 0 );
+  if ( status == GL_TIMEOUT_EXPIRED )
+  {
+    ++ _streamStatistics._stalls;
+    auto start = std::chrono::steady_clock::now();
+    do
+    {
+      status = glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000 ); // 1 second
+    }
+    while ( status == GL_TIMEOUT_EXPIRED );
+    std::chrono::duration<double> wait_time = std::chrono::steady_clock::now() - start;
+    _streamStatistics._stall_time += wait_time.count();
+  }
+  assert( status != GL_WAIT_FAILED );
+
+  glDeleteSync( fence );
+  ring._fences[region] = nullptr;
+}
+
+
+/******************************************************************//**
+* \brief   Append data to the current region of a ring buffer.
+*
+* The data is aligned to `stride`, so that its position in the buffer
+* can be expressed as a base vertex (or first index).
+* If the data doesn't fit into the current region, then a fence is 
+* inserted for the region and the data is written to the next region.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CDrawBuffer::StreamToRing( 
+  TGPUObj    &bo,        //!< IO - buffer object <GPU name>
+  size_t     &curr_size, //!< IO - size of the buffer
+  size_t      stride,    //!< I  - size of one vertex or index
+  size_t      data_size, //!< I  - size of the data
+  const void *data )     //!< I  - pointer to the data
+{
+  size_t align = std::lcm( std::max( stride, (size_t)1 ), (size_t)4 );
+  
+  auto ringIt = _rings.find( bo );
+  if ( ringIt == _rings.end() || data_size + align > ringIt->second._region_size )
+  {
+    if ( CreateRing( bo, curr_size, data_size, align ) == false )
+      return false;
+    ringIt = _rings.find( bo );
+  }
+  TStreamRing &ring = ringIt->second;
+
+  size_t region_begin = ring._region * ring._region_size;
+  size_t offset       = (region_begin + ring._head + align - 1) / align * align;
+  if ( offset + data_size > region_begin + ring._region_size )
+  {
+    // The draw calls, which read the current region, are already submitted.
+    ring._fences[ring._region] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+    ring._region = (ring._region + 1) % c_ring_regions;
+    ring._head   = 0;
+    ++ _streamStatistics._wraps;
+    WaitForRegion( ring, ring._region );
+
+    region_begin = ring._region * ring._region_size;
+    offset       = (region_begin + align - 1) / align * align;
+  }
+
+  std::memcpy( ring._ptr + offset, data, data_size );
+  ring._head   = offset + data_size - region_begin;
+  ring._offset = offset;
+  ring._stride = std::max( stride, (size_t)1 );
+
+  ++ _streamStatistics._updates;
+  _streamStatistics._bytes += data_size;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Size of a vertex in an array buffer of a vertex array
+* description.
+*
+* Returns 0 if the array buffer is not part of the description.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CDrawBuffer::VertexSize( 
+  const TDescription &key,        //!< I - description - specification of vertices and indices
+  size_t              buffer_inx  //!< I - internal index of the array buffer
+  ) const
+{
+  size_t no_of_vbo = key[eHeadOffset_no_of_vbo];
+  int i_key = eHeadSize;
+  for ( size_t i_vbo=0; i_vbo<no_of_vbo; ++ i_vbo )
+  {
+    size_t inx     = (size_t)key[i_key + eVboOffset_index];
+    int stride     = key[i_key + eVboOffset_stride];
+    int no_of_attr = key[i_key + eVboOffset_no_of_attributes];
+    i_key += eVboSize;
+    if ( inx != buffer_inx )
+    {
+      i_key += no_of_attr * eAttributeSize;
+      continue;
+    }
+    if ( stride != 0 )
+      return stride * 4;
+
+    // tightly packed attributes
+    size_t vertex_size = 0;
+    for ( int i_attr=0; i_attr<no_of_attr; ++ i_attr, i_key += eAttributeSize )
+      vertex_size += key[i_key + eAtrributeOffset_size] * AttributeTypeSize( static_cast<Render::TAttributeType>(key[i_key + eAtrributeOffset_type]) );
+    return vertex_size;
+  }
+  return 0;
+}
+
+
+/******************************************************************//**
+* \brief   Compute how the positions of the last updates of the array 
+* buffers of a vertex array description are applied.
+*
+* If all the array buffers start at the same vertex, then this vertex
+* is used as base vertex and the attribute offsets are 0. Else the 
+* byte offsets of the buffers have to be specified as attribute offsets.
+*
+* Returns true if the buffers have a common base vertex.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CDrawBuffer::StreamOffsets( 
+  const TDescription  &key,         //!< I - description - specification of vertices and indices
+  std::vector<size_t> &offsets,     //!< O - attribute offset of each array buffer of the description
+  size_t              &base_vertex  //!< O - base vertex
+  ) const
+{
+  size_t no_of_vbo = key[eHeadOffset_no_of_vbo];
+  offsets.assign( no_of_vbo, 0 );
+  base_vertex = 0;
+
+  bool common = true;
+  int i_key = eHeadSize;
+  for ( size_t i_vbo=0; i_vbo<no_of_vbo; ++ i_vbo )
+  {
+    size_t buffer_inx = (size_t)key[i_key + eVboOffset_index];
+    int    no_of_attr = key[i_key + eVboOffset_no_of_attributes];
+    i_key += eVboSize + no_of_attr * eAttributeSize;
+
+    auto ringIt = buffer_inx < _vbos.size() ? _rings.find( std::get<c_obj>( _vbos[buffer_inx] ) ) : _rings.end();
+    size_t offset      = ringIt != _rings.end() ? ringIt->second._offset : 0;
+    size_t vertex_size = VertexSize( key, buffer_inx );
+    offsets[i_vbo] = offset;
+    if ( vertex_size == 0 || offset % vertex_size != 0 )
+    {
+      common = false;
+      continue;
+    }
+    if ( i_vbo == 0 )
+      base_vertex = offset / vertex_size;
+    else if ( offset / vertex_size != base_vertex )
+      common = false;
+  }
+
+  if ( common )
+  {
+    std::fill( offsets.begin(), offsets.end(), 0 );
+    return true;
+  }
+  base_vertex = 0;
+  return false;
+}
+
+
+/******************************************************************//**
+* \brief   Get the base vertex of the current vertex array object and 
+* re-specify its attribute offsets if necessary.
+*
+* The vertex array object has to be bound.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CDrawBuffer::StreamBaseVertex( void )
+{
+  if ( _rings.empty() )
+    return 0;
+  TVAO *vao_ptr = FindExistingVAO( _currentVAO );
+  if ( vao_ptr == nullptr )
+    return 0;
+
+  const TDescription &key = std::get<c_descr>( *vao_ptr );
+  size_t base_vertex = 0;
+  StreamOffsets( key, _tempOffsets, base_vertex );
+
+  auto &specified = _vaoOffsets[_currentVAO];
+  if ( specified.empty() )
+    specified.assign( _tempOffsets.size(), 0 );
+  if ( specified != _tempOffsets )
+  {
+    PreprateAttributesAndIndices( key, _tempOffsets.data() );
+    specified = _tempOffsets;
+    ++ _streamStatistics._respecifications;
+  }
+  return base_vertex;
+}
+
+
 /******************************************************************//**
 * \brief Add a shortcut to a vertex array object specification.  
 * 
@@ -586,6 +1010,10 @@ void CDrawBuffer::SpecifyVA(
 * but if the current buffer is to small it is recreated.
 * Reusing is much faster (`glBufferSubData`) than recreating
 * (`glBufferData`)
+*
+* A streaming buffer appends the data to its ring buffer. The data
+* is aligned to the vertex size of the current vertex array object,
+* so that it starts at a base vertex.
 * 
 * \author  gernot
 * \date    2017-11-27
@@ -603,10 +1031,23 @@ bool CDrawBuffer::UpdateVB(
     return false;
   }
 
-  TGPUObj vbo        = std::get<c_obj>(   _vbos[id] );
-  size_t &curr_size  = std::get<c_size>(  _vbos[id] );
-  size_t &curr_elems = std::get<c_count>( _vbos[id] );
-  size_t vbo_size    = no_of_elements * element_size;
+  TGPUObj &vbo        = std::get<c_obj>(   _vbos[id] );
+  size_t  &curr_size  = std::get<c_size>(  _vbos[id] );
+  size_t  &curr_elems = std::get<c_count>( _vbos[id] );
+  size_t  vbo_size    = no_of_elements * element_size;
+  RENDERUTIL_PROFILE_COUNT( bytes_uploaded, vbo_size )
+
+  if ( StreamRing() )
+  {
+    TVAO   *vao_ptr     = FindExistingVAO( _currentVAO );
+    size_t  vertex_size = vao_ptr != nullptr ? VertexSize( std::get<c_descr>( *vao_ptr ), id ) : 0;
+    if ( StreamToRing( vbo, curr_size, vertex_size != 0 ? vertex_size : element_size, vbo_size, data ) )
+    {
+      curr_elems = no_of_elements;
+      return true;
+    }
+  }
+
   curr_size  = this->UpdateBuffer( GL_ARRAY_BUFFER, vbo, curr_size, _minVboSize, vbo_size, data );
   curr_elems = no_of_elements;
   return true;
@@ -640,12 +1081,14 @@ bool CDrawBuffer::UpdateIB(
     return false;
   }
 
-  TGPUObj ibo            = std::get<c_obj>(   ibIt->second );
-  size_t &curr_size      = std::get<c_size>(  ibIt->second );
-  size_t &curr_noOfElems = std::get<c_count>( ibIt->second );
-  size_t &curr_elemSize  = std::get<c_elemS>( ibIt->second );
-  size_t data_size       = no_of_elements * element_size;
-  curr_size      = this->UpdateBuffer( GL_ELEMENT_ARRAY_BUFFER, ibo, curr_size, data_size, data_size, data );
+  TGPUObj &ibo            = std::get<c_obj>(   ibIt->second );
+  size_t  &curr_size      = std::get<c_size>(  ibIt->second );
+  size_t  &curr_noOfElems = std::get<c_count>( ibIt->second );
+  size_t  &curr_elemSize  = std::get<c_elemS>( ibIt->second );
+  size_t  data_size       = no_of_elements * element_size;
+  RENDERUTIL_PROFILE_COUNT( bytes_uploaded, data_size )
+  if ( StreamRing() == false || StreamToRing( ibo, curr_size, element_size, data_size, data ) == false )
+    curr_size    = this->UpdateBuffer( GL_ELEMENT_ARRAY_BUFFER, ibo, curr_size, data_size, data_size, data );
   curr_noOfElems = no_of_elements;
   curr_elemSize  = element_size;
 
@@ -653,14 +1096,40 @@ bool CDrawBuffer::UpdateIB(
   CDrawBuffer::TVAO *vao_ptr = CDrawBuffer::FindExistingVAO( this->_currentVAO );
   if ( vao_ptr != nullptr && std::get<c_descr>( *vao_ptr )[0] == id )
   {
-    _currNoElems  = no_of_elements;  
-    _currElemSize = element_size;
+    _currNoElems   = no_of_elements;  
+    _currElemSize  = element_size;
+    auto ringIt    = _rings.find( ibo );
+    _currIndexOffs = ringIt != _rings.end() ? ringIt->second._offset : 0;
   }
 
   return true;
 }
 
 
+/******************************************************************//**
+* \brief   Get the first vertex of the data of the last update of an
+* array buffer.
+*
+* Only a streaming buffer (`TDrawBufferUsage::stream_ring`) places the
+* data at a vertex other than 0. The draw operations of this object
+* take the base vertex into account, but it is required by callers,
+* which draw the buffer by their own.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CDrawBuffer::BaseVertex( 
+  size_t id     //!< I - internal index of the array buffer 
+  ) const
+{
+  if ( id >= _vbos.size() )
+    return 0;
+  auto ringIt = _rings.find( std::get<c_obj>( _vbos[id] ) );
+  return ringIt != _rings.end() ? ringIt->second._offset / ringIt->second._stride : 0;
+}
+
+
 /******************************************************************//**
 * \brief   Draw the indices of the current index buffer.
 * 
@@ -676,7 +1145,12 @@ void CDrawBuffer::DrawAllElements(
     return;
   if ( bind )
     this->BindVAO();
-  glDrawElements( PrimitiveType( primitive_type ), static_cast<GLsizei>( _currNoElems ), IndexType( _currElemSize ), nullptr );
+  size_t base_vertex = StreamBaseVertex();
+  if ( base_vertex != 0 )
+    glDrawElementsBaseVertex( PrimitiveType( primitive_type ), static_cast<GLsizei>( _currNoElems ), IndexType( _currElemSize ), (void*)_currIndexOffs, static_cast<GLint>( base_vertex ) );
+  else
+    glDrawElements( PrimitiveType( primitive_type ), static_cast<GLsizei>( _currNoElems ), IndexType( _currElemSize ), (void*)_currIndexOffs );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
   OPENGL_CHECK_GL_ERROR
 }
 
@@ -702,7 +1176,12 @@ void CDrawBuffer::DrawElements(
   if ( bind )
     this->BindVAO();
   size_t noOfElements = (count == 0 || start + count > _currNoElems) ? _currNoElems - start : count;
-  glDrawElements( PrimitiveType( primitive_type ), static_cast<GLsizei>( noOfElements ), IndexType( _currElemSize ), (void*)(_currElemSize * start) );
+  size_t base_vertex  = StreamBaseVertex();
+  if ( base_vertex != 0 )
+    glDrawElementsBaseVertex( PrimitiveType( primitive_type ), static_cast<GLsizei>( noOfElements ), IndexType( _currElemSize ), (void*)(_currIndexOffs + _currElemSize * start), static_cast<GLint>( base_vertex ) );
+  else
+    glDrawElements( PrimitiveType( primitive_type ), static_cast<GLsizei>( noOfElements ), IndexType( _currElemSize ), (void*)(_currIndexOffs + _currElemSize * start) );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
   OPENGL_CHECK_GL_ERROR
 }
 
@@ -710,6 +1189,11 @@ void CDrawBuffer::DrawElements(
 
 /******************************************************************//**
 * \brief   Draw the indices which are given by the index array.
+*
+* `data` is a byte offset in the element array buffer of the current
+* vertex array object. With a streaming buffer
+* (`TDrawBufferUsage::stream_ring`) it is relative to the indices of the
+* last update, so the offset of the ring range is added.
 * 
 * \author  gernot
 * \date    2017-11-27
@@ -724,13 +1208,24 @@ void CDrawBuffer::DrawElements(
 {
   if ( bind )
     this->BindVAO();
-  glDrawElements( PrimitiveType( primitive_type ), static_cast<GLsizei>( no_of_elements ), IndexType( element_size ), data );
+  size_t base_vertex = StreamBaseVertex();
+  void  *indices     = const_cast<char*>( static_cast<const char*>( data ) ) + _currIndexOffs;
+  if ( base_vertex != 0 )
+    glDrawElementsBaseVertex( PrimitiveType( primitive_type ), static_cast<GLsizei>( no_of_elements ), IndexType( element_size ), indices, static_cast<GLint>( base_vertex ) );
+  else
+    glDrawElements( PrimitiveType( primitive_type ), static_cast<GLsizei>( no_of_elements ), IndexType( element_size ), indices );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
   OPENGL_CHECK_GL_ERROR
 }
 
 
 /******************************************************************//**
-* \brief   
+* \brief   Draw a list of index arrays.
+*
+* The entries of `data` are byte offsets in the element array buffer of
+* the current vertex array object. With a streaming buffer
+* (`TDrawBufferUsage::stream_ring`) they are relative to the indices of
+* the last update, so the offset of the ring range is added.
 * 
 * \author  gernot
 * \date    2017-11-26
@@ -746,7 +1241,22 @@ void CDrawBuffer::DrawElements(
 {
   if ( bind )
     this->BindVAO();
-  glMultiDrawElements( PrimitiveType( primitive_type ), no_of_elements, IndexType( element_size ), data, static_cast<GLsizei>( list_size ) );
+  size_t base_vertex = StreamBaseVertex();
+  if ( _currIndexOffs != 0 )
+  {
+    _tempIndices.resize( list_size );
+    for ( size_t i = 0; i < list_size; ++ i )
+      _tempIndices[i] = static_cast<const char*>( data[i] ) + _currIndexOffs;
+    data = _tempIndices.data();
+  }
+  if ( base_vertex != 0 )
+  {
+    _tempBase.assign( list_size, static_cast<int>( base_vertex ) );
+    glMultiDrawElementsBaseVertex( PrimitiveType( primitive_type ), no_of_elements, IndexType( element_size ), data, static_cast<GLsizei>( list_size ), _tempBase.data() );
+  }
+  else
+    glMultiDrawElements( PrimitiveType( primitive_type ), no_of_elements, IndexType( element_size ), data, static_cast<GLsizei>( list_size ) );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
   OPENGL_CHECK_GL_ERROR
 }
 
@@ -773,7 +1283,9 @@ void CDrawBuffer::DrawElementsBase(
   if ( bind )
     this->BindVAO();
   size_t noOfElements = (count == 0 || start + count > _currNoElems) ? _currNoElems - start : count;
-  glDrawElementsBaseVertex( PrimitiveType( primitive_type ), static_cast<GLsizei>( noOfElements ), IndexType( _currElemSize ), (void*)(_currElemSize * start), static_cast<GLint>( base_index ) );
+  size_t base_vertex  = StreamBaseVertex();
+  glDrawElementsBaseVertex( PrimitiveType( primitive_type ), static_cast<GLsizei>( noOfElements ), IndexType( _currElemSize ), (void*)(_currIndexOffs + _currElemSize * start), static_cast<GLint>( base_index + base_vertex ) );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
   OPENGL_CHECK_GL_ERROR
 }
 
@@ -781,6 +1293,9 @@ void CDrawBuffer::DrawElementsBase(
 
 /******************************************************************//**
 * \brief   Draw the indices which are given by the index array.
+*
+* `data` is a byte offset in the element array buffer, see
+* `DrawElements`.
 * 
 * \author  gernot
 * \date    2017-11-27
@@ -796,7 +1311,10 @@ void CDrawBuffer::DrawElementsBase(
 {
   if ( bind )
     this->BindVAO();
-  glDrawElementsBaseVertex( PrimitiveType( primitive_type ), static_cast<GLsizei>( no_of_elements ), IndexType( element_size ), const_cast<void*>(data), static_cast<GLint>( base_index ) );
+  size_t base_vertex = StreamBaseVertex();
+  void  *indices     = const_cast<char*>( static_cast<const char*>( data ) ) + _currIndexOffs;
+  glDrawElementsBaseVertex( PrimitiveType( primitive_type ), static_cast<GLsizei>( no_of_elements ), IndexType( element_size ), indices, static_cast<GLint>( base_index + base_vertex ) );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
   OPENGL_CHECK_GL_ERROR
 }
 
@@ -819,7 +1337,12 @@ void CDrawBuffer::DrawRangeElements(
     return;
   if ( bind )
     this->BindVAO();
-  glDrawRangeElements( PrimitiveType( primitive_type ), minInx, maxInx, static_cast<GLsizei>( _currNoElems ), IndexType( _currElemSize ), nullptr );
+  size_t base_vertex = StreamBaseVertex();
+  if ( base_vertex != 0 )
+    glDrawRangeElementsBaseVertex( PrimitiveType( primitive_type ), minInx, maxInx, static_cast<GLsizei>( _currNoElems ), IndexType( _currElemSize ), (void*)_currIndexOffs, static_cast<GLint>( base_vertex ) );
+  else
+    glDrawRangeElements( PrimitiveType( primitive_type ), minInx, maxInx, static_cast<GLsizei>( _currNoElems ), IndexType( _currElemSize ), (void*)_currIndexOffs );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
   OPENGL_CHECK_GL_ERROR
 }
 
@@ -839,7 +1362,42 @@ void CDrawBuffer::DrawArray(
 {
   if ( bind )
     this->BindVAO();
-  glDrawArrays( PrimitiveType( primitive_type ), static_cast<GLsizei>( first ), static_cast<GLsizei>( count ) );
+  size_t base_vertex = StreamBaseVertex();
+  glDrawArrays( PrimitiveType( primitive_type ), static_cast<GLsizei>( base_vertex + first ), static_cast<GLsizei>( count ) );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
+  OPENGL_CHECK_GL_ERROR
+}
+
+
+/******************************************************************//**
+* \brief   Draw multiple ranges of the current vertices with a single
+* draw call.
+*
+* The index of the range is `gl_DrawID` in the vertex shader
+* (OpenGL 4.6, `ARB_shader_draw_parameters`).
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CDrawBuffer::MultiDrawArray( 
+  Render::TPrimitive primitive_type, //!< I - OpenGL primitive type
+  size_t             list_size,      //!< I - number of ranges
+  const int         *first,          //!< I - first vertex of each range
+  const int         *count,          //!< I - number of vertices of each range
+  bool               bind )          //!< I - true : vertex array object  will be bound; false: vertex array object is already bound
+{
+  if ( bind )
+    this->BindVAO();
+  size_t base_vertex = StreamBaseVertex();
+  if ( base_vertex != 0 )
+  {
+    _tempFirst.resize( list_size );
+    std::transform( first, first + list_size, _tempFirst.begin(), [base_vertex]( int f ) -> int { return f + static_cast<int>( base_vertex ); } );
+    first = _tempFirst.data();
+  }
+  glMultiDrawArrays( PrimitiveType( primitive_type ), first, count, static_cast<GLsizei>( list_size ) );
+  RENDERUTIL_PROFILE_COUNT( draw_calls, 1 )
   OPENGL_CHECK_GL_ERROR
 }
 
@@ -909,6 +1467,8 @@ bool CDrawBuffer::FindExistingVAO(
   auto iboIt = _ibos.find( i_ibo );
   _currNoElems  = iboIt != _ibos.end() ? std::get<c_count>( iboIt->second ) : 0;
   _currElemSize = iboIt != _ibos.end() ? std::get<c_elemS>( iboIt->second ) : 0;
+  auto ringIt    = iboIt != _ibos.end() ? _rings.find( std::get<c_obj>( iboIt->second ) ) : _rings.end();
+  _currIndexOffs = ringIt != _rings.end() ? ringIt->second._offset : 0;
  
   // Check if a proper vertex array object already exists
   auto vaoIt = _vaos.find( hashC );
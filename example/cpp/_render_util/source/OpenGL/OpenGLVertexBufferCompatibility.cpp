@@ -124,18 +124,19 @@ void CDrawBuffer::DefineAndEnableAttribute(
   int                    attr_id,   //!< I - attribute index
   int                    attr_size, //!< I - size of attribute: 1, 2, 3 or 4
   Render::TAttributeType elem_type, //!< I - type id of an element
-  int                    attr_offs, //!< I - offset of the attribute in the attribute record set
-  int                    stride     //!< I - stride between two attribute record sets 
+  int                    attr_offs,  //!< I - offset of the attribute in the attribute record set
+  int                    stride,     //!< I - stride between two attribute record sets 
+  size_t                 buffer_offs //!< I - offset of the first attribute record set in the buffer
   ) const
 {
   if ( attr_id >= 0 )
   {
-    OpenGL::CDrawBuffer::DefineAndEnableAttribute(attr_id, attr_size, elem_type, attr_offs, stride);
+    OpenGL::CDrawBuffer::DefineAndEnableAttribute(attr_id, attr_size, elem_type, attr_offs, stride, buffer_offs);
     return;
   }
   
   unsigned int  opebgl_type       = DataType( elem_type );
-  void         *opengl_offset_ptr = (void*)( stride == 0 ? 0 : (size_t)attr_offs );
+  void         *opengl_offset_ptr = (void*)( (stride == 0 ? 0 : (size_t)attr_offs) + buffer_offs );
 
   switch ( attr_id )
   {
@@ -0,0 +1,67 @@
+/******************************************************************//**
+* \brief   Arc length of the vertices of polylines.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_ArcLength.h"
+
+
+// STL
+
+#include <cmath>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+/******************************************************************//**
+* \brief Compute the arc length of the vertices of polylines in place.
+*
+* The `w` component of the first vertex of each polyline has to be
+* `c_arc_length_polyline_start`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void ArcLengthPrefixSum(
+  size_t  no_of_vertices, //!< I   - number of vertices
+  float  *vertices )      //!< I/O - x, y, z, w tuples
+{
+  double arc = 0.0;
+  for ( size_t i = 0; i < no_of_vertices; ++ i )
+  {
+    float *v = vertices + i * 4;
+    if ( i == 0 || v[3] == c_arc_length_polyline_start )
+    {
+      arc = 0.0;
+    }
+    else
+    {
+      const float *p = v - 4;
+      double dx = (double)v[0] - p[0];
+      double dy = (double)v[1] - p[1];
+      double dz = (double)v[2] - p[2];
+      arc += std::sqrt( dx*dx + dy*dy + dz*dz );
+    }
+    v[3] = (float)arc;
+  }
+}
+
+
+} // Render
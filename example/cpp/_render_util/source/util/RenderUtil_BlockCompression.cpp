@@ -0,0 +1,1185 @@
+/******************************************************************//**
+* \brief   CPU block compression encoder (BC1, BC3, BC4, BC5, BC7).
+*
+* See [Khronos Data Format Specification - S3TC, RGTC and BPTC](https://registry.khronos.org/DataFormat/specs/1.3/dataformat.1.3.html)
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_BlockCompression.h"
+#include "../../include/util/RenderUtil_Parallel.h"
+
+
+// STL
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+
+// SIMD
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERUTIL_BLOCK_SSE2
+#include <emmintrin.h>
+#endif
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+//! 4x4 block of RGBA texels; structure of arrays, one array per channel
+struct TBlock
+{
+  alignas(16) float _channel[4][16];
+};
+
+
+//! end points of a block in up to 4 channels
+struct TEndPoints
+{
+  float _e0[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+  float _e1[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+};
+
+
+//! interpolation weights of the BC7 4 bit indices
+const int c_bc7_weights4[16]{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+
+//! number of bytes of an uncompressed texel
+size_t TexelSize( TImageFormat format )
+{
+  switch ( format )
+  {
+    case TImageFormat::GRAY8: return 1;
+    case TImageFormat::RGB8:
+    case TImageFormat::BGR8:  return 3;
+    case TImageFormat::RGBA8:
+    case TImageFormat::BGRA8: return 4;
+    default: break;
+  }
+  return 0;
+}
+
+
+//! read one RGBA texel of an uncompressed image
+void ReadTexel( TImageFormat format, const t_byte *texel, t_byte rgba[4] )
+{
+  switch ( format )
+  {
+    default:
+    case TImageFormat::GRAY8: rgba[0] = rgba[1] = rgba[2] = texel[0]; rgba[3] = 255; break;
+    case TImageFormat::RGB8:  rgba[0] = texel[0]; rgba[1] = texel[1]; rgba[2] = texel[2]; rgba[3] = 255; break;
+    case TImageFormat::BGR8:  rgba[0] = texel[2]; rgba[1] = texel[1]; rgba[2] = texel[0]; rgba[3] = 255; break;
+    case TImageFormat::RGBA8: rgba[0] = texel[0]; rgba[1] = texel[1]; rgba[2] = texel[2]; rgba[3] = texel[3]; break;
+    case TImageFormat::BGRA8: rgba[0] = texel[2]; rgba[1] = texel[1]; rgba[2] = texel[0]; rgba[3] = texel[3]; break;
+  }
+}
+
+
+//! read a 4x4 block; the texels at the right and bottom border are replicated
+void ReadBlock( const IImageResource &image, size_t bx, size_t by, TBlock &block )
+{
+  TTextureSize  size  = image.Size();
+  TImageFormat  format = image.Format();
+  size_t        texel_size = TexelSize( format );
+  const t_byte *data  = static_cast<const t_byte*>( image.DataPtr() );
+  for ( size_t j = 0; j < 4; ++ j )
+  {
+    size_t y = std::min( by * 4 + j, size[1] - 1 );
+    const t_byte *row = data + y * image.BPL();
+    for ( size_t i = 0; i < 4; ++ i )
+    {
+      size_t x = std::min( bx * 4 + i, size[0] - 1 );
+      t_byte rgba[4];
+      ReadTexel( format, row + x * texel_size, rgba );
+      for ( size_t c = 0; c < 4; ++ c )
+        block._channel[c][j*4 + i] = (float)rgba[c];
+    }
+  }
+}
+
+
+/******************************************************************//**
+* \brief Select the nearest palette entry for each texel of the block.
+*
+* The squared distance in the channels [`first`, `first`+`n`) is
+* evaluated for 4 texels at once.
+*
+* \return sum of the squared distances
+**********************************************************************/
+float SelectIndices(
+  const TBlock &block,
+  size_t        first,
+  size_t        n,
+  const float   palette[][4],
+  size_t        palette_size,
+  t_byte        indices[16] )
+{
+  float error = 0.0f;
+#if defined(RENDERUTIL_BLOCK_SSE2)
+  for ( size_t i = 0; i < 16; i += 4 )
+  {
+    __m128 texel[4];
+    for ( size_t c = 0; c < n; ++ c )
+      texel[c] = _mm_load_ps( block._channel[first + c] + i );
+
+    __m128  best       = _mm_set1_ps( FLT_MAX );
+    __m128i best_index = _mm_setzero_si128();
+    for ( size_t p = 0; p < palette_size; ++ p )
+    {
+      __m128 dist = _mm_setzero_ps();
+      for ( size_t c = 0; c < n; ++ c )
+      {
+        __m128 d = _mm_sub_ps( texel[c], _mm_set1_ps( palette[p][c] ) );
+        dist = _mm_add_ps( dist, _mm_mul_ps( d, d ) );
+      }
+      __m128i less = _mm_castps_si128( _mm_cmplt_ps( dist, best ) );
+      best       = _mm_min_ps( dist, best );
+      best_index = _mm_or_si128( _mm_and_si128( less, _mm_set1_epi32( (int)p ) ), _mm_andnot_si128( less, best_index ) );
+    }
+
+    alignas(16) float   best_dist[4];
+    alignas(16) int32_t best_i[4];
+    _mm_store_ps( best_dist, best );
+    _mm_store_si128( reinterpret_cast<__m128i*>( best_i ), best_index );
+    for ( size_t k = 0; k < 4; ++ k )
+    {
+      indices[i + k] = (t_byte)best_i[k];
+      error += best_dist[k];
+    }
+  }
+#else
+  for ( size_t i = 0; i < 16; ++ i )
+  {
+    float best = FLT_MAX;
+    for ( size_t p = 0; p < palette_size; ++ p )
+    {
+      float dist = 0.0f;
+      for ( size_t c = 0; c < n; ++ c )
+      {
+        float d = block._channel[first + c][i] - palette[p][c];
+        dist += d * d;
+      }
+      if ( dist < best )
+      {
+        best = dist;
+        indices[i] = (t_byte)p;
+      }
+    }
+    error += best;
+  }
+#endif
+  return error;
+}
+
+
+//! end points from the bounding box of the texels with `mask` bit set
+void EndPointsBoundingBox( const TBlock &block, size_t first, size_t n, unsigned int mask, TEndPoints &ep )
+{
+  for ( size_t c = 0; c < n; ++ c )
+  {
+    float min_v = 255.0f, max_v = 0.0f;
+    for ( size_t i = 0; i < 16; ++ i )
+    {
+      if ( (mask & (1u << i)) == 0 )
+        continue;
+      min_v = std::min( min_v, block._channel[first + c][i] );
+      max_v = std::max( max_v, block._channel[first + c][i] );
+    }
+    if ( min_v > max_v )
+      min_v = max_v = 0.0f;
+
+    // inset the bounding box, because the end points are rarely hit
+    float inset = (max_v - min_v) / 16.0f;
+    ep._e0[c] = max_v - inset;
+    ep._e1[c] = min_v + inset;
+  }
+}
+
+
+//! end points from the principal axis of the texels with `mask` bit set
+void EndPointsPrincipalAxis( const TBlock &block, size_t first, size_t n, unsigned int mask, TEndPoints &ep )
+{
+  float mean[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+  float count = 0.0f;
+  for ( size_t i = 0; i < 16; ++ i )
+  {
+    if ( (mask & (1u << i)) == 0 )
+      continue;
+    for ( size_t c = 0; c < n; ++ c )
+      mean[c] += block._channel[first + c][i];
+    count += 1.0f;
+  }
+  if ( count == 0.0f )
+  {
+    ep = TEndPoints();
+    return;
+  }
+  for ( size_t c = 0; c < n; ++ c )
+    mean[c] /= count;
+
+  float cov[4][4]{};
+  for ( size_t i = 0; i < 16; ++ i )
+  {
+    if ( (mask & (1u << i)) == 0 )
+      continue;
+    float d[4];
+    for ( size_t c = 0; c < n; ++ c )
+      d[c] = block._channel[first + c][i] - mean[c];
+    for ( size_t r = 0; r < n; ++ r )
+      for ( size_t c = 0; c < n; ++ c )
+        cov[r][c] += d[r] * d[c];
+  }
+
+  // power iteration, started at the diagonal of the bounding box
+  TEndPoints box;
+  EndPointsBoundingBox( block, first, n, mask, box );
+  float axis[4];
+  for ( size_t c = 0; c < n; ++ c )
+    axis[c] = box._e0[c] - box._e1[c] + 1e-3f;
+  for ( int iteration = 0; iteration < 8; ++ iteration )
+  {
+    float next[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+    float len = 0.0f;
+    for ( size_t r = 0; r < n; ++ r )
+    {
+      for ( size_t c = 0; c < n; ++ c )
+        next[r] += cov[r][c] * axis[c];
+      len = std::max( len, std::fabs( next[r] ) );
+    }
+    if ( len < 1e-6f )
+      break;
+    for ( size_t c = 0; c < n; ++ c )
+      axis[c] = next[c] / len;
+  }
+  float len = 0.0f;
+  for ( size_t c = 0; c < n; ++ c )
+    len += axis[c] * axis[c];
+  if ( len < 1e-12f )
+  {
+    ep = box;
+    return;
+  }
+  len = std::sqrt( len );
+  for ( size_t c = 0; c < n; ++ c )
+    axis[c] /= len;
+
+  // project the texels onto the axis
+  float min_t = FLT_MAX, max_t = -FLT_MAX;
+  for ( size_t i = 0; i < 16; ++ i )
+  {
+    if ( (mask & (1u << i)) == 0 )
+      continue;
+    float t = 0.0f;
+    for ( size_t c = 0; c < n; ++ c )
+      t += (block._channel[first + c][i] - mean[c]) * axis[c];
+    min_t = std::min( min_t, t );
+    max_t = std::max( max_t, t );
+  }
+  for ( size_t c = 0; c < n; ++ c )
+  {
+    ep._e0[c] = std::min( 255.0f, std::max( 0.0f, mean[c] + axis[c] * max_t ) );
+    ep._e1[c] = std::min( 255.0f, std::max( 0.0f, mean[c] + axis[c] * min_t ) );
+  }
+}
+
+
+/******************************************************************//**
+* \brief Least squares fit of the end points for the given indices.
+*
+* `weight[index]` is the interpolation weight of end point 1 of a
+* palette index.
+**********************************************************************/
+bool RefineEndPoints(
+  const TBlock  &block,
+  size_t         first,
+  size_t         n,
+  unsigned int   mask,
+  const t_byte   indices[16],
+  const float   *weight,
+  TEndPoints    &ep )
+{
+  float a = 0.0f, b = 0.0f, c = 0.0f;
+  float x0[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+  float x1[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+  for ( size_t i = 0; i < 16; ++ i )
+  {
+    if ( (mask & (1u << i)) == 0 )
+      continue;
+    float t = weight[indices[i]];
+    float s = 1.0f - t;
+    a += s * s;
+    b += s * t;
+    c += t * t;
+    for ( size_t k = 0; k < n; ++ k )
+    {
+      x0[k] += s * block._channel[first + k][i];
+      x1[k] += t * block._channel[first + k][i];
+    }
+  }
+  float det = a * c - b * b;
+  if ( std::fabs( det ) < 1e-6f )
+    return false;
+  for ( size_t k = 0; k < n; ++ k )
+  {
+    ep._e0[k] = std::min( 255.0f, std::max( 0.0f, (c * x0[k] - b * x1[k]) / det ) );
+    ep._e1[k] = std::min( 255.0f, std::max( 0.0f, (a * x1[k] - b * x0[k]) / det ) );
+  }
+  return true;
+}
+
+
+//! initial end points according to the quality
+void InitialEndPoints( TBlockCompressionQuality quality, const TBlock &block, size_t first, size_t n, unsigned int mask, TEndPoints &ep )
+{
+  if ( quality == TBlockCompressionQuality::fast )
+    EndPointsBoundingBox( block, first, n, mask, ep );
+  else
+    EndPointsPrincipalAxis( block, first, n, mask, ep );
+}
+
+
+//! number of least squares refinement iterations according to the quality
+int RefinementIterations( TBlockCompressionQuality quality )
+{
+  switch ( quality )
+  {
+    default:
+    case TBlockCompressionQuality::fast:   return 0;
+    case TBlockCompressionQuality::normal: return 1;
+    case TBlockCompressionQuality::high:   return 3;
+  }
+}
+
+
+void WriteU16( t_byte *target, unsigned int value )
+{
+  target[0] = (t_byte)(value & 0xff);
+  target[1] = (t_byte)((value >> 8) & 0xff);
+}
+
+
+unsigned int ReadU16( const t_byte *source )
+{
+  return (unsigned int)source[0] | ((unsigned int)source[1] << 8);
+}
+
+
+//---------------------------------------------------------------------
+// BC1 color block
+//---------------------------------------------------------------------
+
+
+unsigned int PackRGB565( const float rgb[3] )
+{
+  unsigned int r = (unsigned int)std::lround( std::min( 255.0f, std::max( 0.0f, rgb[0] ) ) * 31.0f / 255.0f );
+  unsigned int g = (unsigned int)std::lround( std::min( 255.0f, std::max( 0.0f, rgb[1] ) ) * 63.0f / 255.0f );
+  unsigned int b = (unsigned int)std::lround( std::min( 255.0f, std::max( 0.0f, rgb[2] ) ) * 31.0f / 255.0f );
+  return (r << 11) | (g << 5) | b;
+}
+
+
+void UnpackRGB565( unsigned int c, int rgb[3] )
+{
+  int r = (int)((c >> 11) & 31);
+  int g = (int)((c >> 5) & 63);
+  int b = (int)(c & 31);
+  rgb[0] = (r << 3) | (r >> 2);
+  rgb[1] = (g << 2) | (g >> 4);
+  rgb[2] = (b << 3) | (b >> 2);
+}
+
+
+//! palette of a BC1 color block; 3 color mode if `c0 <= c1` and `four_color` is false
+void ColorPalette( unsigned int c0, unsigned int c1, bool four_color, int palette[4][4] )
+{
+  UnpackRGB565( c0, palette[0] );
+  UnpackRGB565( c1, palette[1] );
+  palette[0][3] = palette[1][3] = 255;
+  if ( four_color || c0 > c1 )
+  {
+    for ( int c = 0; c < 3; ++ c )
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+    palette[2][3] = palette[3][3] = 255;
+  }
+  else
+  {
+    for ( int c = 0; c < 3; ++ c )
+    {
+      palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+      palette[3][c] = 0;
+    }
+    palette[2][3] = 255;
+    palette[3][3] = 0;
+  }
+}
+
+
+/******************************************************************//**
+* \brief Encode the color part of a BC1 block.
+*
+* \return squared error of the texels with `mask` bit set
+**********************************************************************/
+float EncodeColorBlock(
+  const TBlock             &block,
+  unsigned int              mask,        //!< texels, which are encoded; the others are transparent (index 3)
+  bool                      three_color, //!< use 3 color mode (c0 <= c1)
+  TBlockCompressionQuality  quality,
+  t_byte                    target[8] )
+{
+  static const float weight4[4]{ 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+  static const float weight3[4]{ 0.0f, 1.0f, 0.5f, 0.0f };
+
+  if ( mask == 0 )
+  {
+    WriteU16( target, 0 );
+    WriteU16( target + 2, 0 );
+    target[4] = target[5] = target[6] = target[7] = 0xff;
+    return 0.0f;
+  }
+
+  TEndPoints ep;
+  InitialEndPoints( quality, block, 0, 3, mask, ep );
+
+  float  best_error = FLT_MAX;
+  t_byte best_indices[16]{};
+  unsigned int best_c0 = 0, best_c1 = 0;
+  for ( int iteration = 0; iteration <= RefinementIterations( quality ); ++ iteration )
+  {
+    unsigned int c0 = PackRGB565( ep._e0 );
+    unsigned int c1 = PackRGB565( ep._e1 );
+    bool swapped = three_color ? c0 > c1 : c0 < c1;
+    if ( swapped )
+      std::swap( c0, c1 );
+
+    int   palette_i[4][4];
+    float palette[4][4];
+    ColorPalette( c0, c1, three_color == false, palette_i );
+    for ( int p = 0; p < 4; ++ p )
+      for ( int c = 0; c < 4; ++ c )
+        palette[p][c] = (float)palette_i[p][c];
+
+    // in 4 color mode with equal end points all texels are index 0
+    size_t palette_size = three_color ? 3 : (c0 == c1 ? 1 : 4);
+    t_byte indices[16];
+    float error = SelectIndices( block, 0, 3, palette, palette_size, indices );
+    if ( mask != 0xffff )
+    {
+      error = 0.0f;
+      for ( size_t i = 0; i < 16; ++ i )
+      {
+        if ( (mask & (1u << i)) == 0 )
+        {
+          indices[i] = 3;
+          continue;
+        }
+        for ( int c = 0; c < 3; ++ c )
+        {
+          float d = block._channel[c][i] - palette[indices[i]][c];
+          error += d * d;
+        }
+      }
+    }
+
+    if ( error < best_error )
+    {
+      best_error = error;
+      best_c0 = c0;
+      best_c1 = c1;
+      std::memcpy( best_indices, indices, sizeof( indices ) );
+    }
+
+    // refine the end points; the end points have to be in the order of the indices
+    TEndPoints refined;
+    if ( RefineEndPoints( block, 0, 3, mask, indices, three_color ? weight3 : weight4, refined ) == false )
+      break;
+    if ( swapped )
+      std::swap( refined._e0, refined._e1 );
+    ep = refined;
+  }
+
+  WriteU16( target, best_c0 );
+  WriteU16( target + 2, best_c1 );
+  for ( size_t row = 0; row < 4; ++ row )
+  {
+    t_byte bits = 0;
+    for ( size_t i = 0; i < 4; ++ i )
+      bits |= (t_byte)( best_indices[row*4 + i] << (i * 2) );
+    target[4 + row] = bits;
+  }
+  return best_error;
+}
+
+
+void EncodeBC1( const TBlock &block, bool alpha, TBlockCompressionQuality quality, t_byte target[8] )
+{
+  unsigned int mask = 0xffff;
+  if ( alpha )
+  {
+    mask = 0;
+    for ( size_t i = 0; i < 16; ++ i )
+      mask |= block._channel[3][i] >= 128.0f ? (1u << i) : 0u;
+  }
+
+  if ( mask != 0xffff )
+  {
+    EncodeColorBlock( block, mask, true, quality, target );
+    return;
+  }
+
+  float error = EncodeColorBlock( block, mask, false, quality, target );
+  if ( quality == TBlockCompressionQuality::high && alpha == false )
+  {
+    // the 3 color mode can be better for some blocks (e.g. 2 colors and their average)
+    t_byte three_color[8];
+    if ( EncodeColorBlock( block, mask, true, quality, three_color ) < error )
+      std::memcpy( target, three_color, sizeof( three_color ) );
+  }
+}
+
+
+//---------------------------------------------------------------------
+// BC4 single channel block
+//---------------------------------------------------------------------
+
+
+//! palette of a BC4 block; 8 value mode if `a0 > a1`, else 6 value mode
+void SingleChannelPalette( int a0, int a1, int palette[8] )
+{
+  palette[0] = a0;
+  palette[1] = a1;
+  if ( a0 > a1 )
+  {
+    for ( int i = 2; i < 8; ++ i )
+      palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+  }
+  else
+  {
+    for ( int i = 2; i < 6; ++ i )
+      palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+}
+
+
+//! encode a BC4 block with the given mode; `a0` > `a1`: 8 value mode
+float EncodeSingleChannelMode( const TBlock &block, size_t channel, int a0, int a1, t_byte target[8] )
+{
+  int   palette_i[8];
+  float palette[8][4];
+  SingleChannelPalette( a0, a1, palette_i );
+  for ( int i = 0; i < 8; ++ i )
+    palette[i][0] = (float)palette_i[i];
+
+  t_byte indices[16];
+  float error = SelectIndices( block, channel, 1, palette, 8, indices );
+
+  target[0] = (t_byte)a0;
+  target[1] = (t_byte)a1;
+  std::uint64_t bits = 0;
+  for ( size_t i = 0; i < 16; ++ i )
+    bits |= (std::uint64_t)indices[i] << (i * 3);
+  for ( size_t i = 0; i < 6; ++ i )
+    target[2 + i] = (t_byte)((bits >> (i * 8)) & 0xff);
+  return error;
+}
+
+
+void EncodeBC4( const TBlock &block, size_t channel, TBlockCompressionQuality quality, t_byte target[8] )
+{
+  static const float weight8[8]{ 0.0f, 1.0f, 1.0f/7.0f, 2.0f/7.0f, 3.0f/7.0f, 4.0f/7.0f, 5.0f/7.0f, 6.0f/7.0f };
+
+  const float *values = block._channel[channel];
+  float min_v = *std::min_element( values, values + 16 );
+  float max_v = *std::max_element( values, values + 16 );
+  if ( min_v == max_v )
+  {
+    EncodeSingleChannelMode( block, channel, (int)min_v, (int)min_v, target );
+    return;
+  }
+
+  // 8 value mode
+  TEndPoints ep;
+  ep._e0[0] = max_v;
+  ep._e1[0] = min_v;
+  float best_error = FLT_MAX;
+  for ( int iteration = 0; iteration <= RefinementIterations( quality ); ++ iteration )
+  {
+    int a0 = (int)std::lround( ep._e0[0] );
+    int a1 = (int)std::lround( ep._e1[0] );
+    if ( a0 == a1 )
+      a0 < 255 ? ++ a0 : -- a1;
+    if ( a0 < a1 )
+      std::swap( a0, a1 );
+
+    t_byte candidate[8];
+    float error = EncodeSingleChannelMode( block, channel, a0, a1, candidate );
+    if ( error < best_error )
+    {
+      best_error = error;
+      std::memcpy( target, candidate, sizeof( candidate ) );
+    }
+    if ( error == 0.0f )
+      return;
+
+    t_byte indices[16];
+    std::uint64_t bits = 0;
+    for ( size_t i = 0; i < 6; ++ i )
+      bits |= (std::uint64_t)candidate[2 + i] << (i * 8);
+    for ( size_t i = 0; i < 16; ++ i )
+      indices[i] = (t_byte)((bits >> (i * 3)) & 7);
+    if ( RefineEndPoints( block, channel, 1, 0xffff, indices, weight8, ep ) == false )
+      break;
+  }
+
+  // 6 value mode with the extremes 0 and 255, for blocks which contain 0 or 255
+  if ( quality == TBlockCompressionQuality::high && (min_v == 0.0f || max_v == 255.0f) )
+  {
+    float inner_min = 255.0f, inner_max = 0.0f;
+    for ( size_t i = 0; i < 16; ++ i )
+    {
+      if ( values[i] == 0.0f || values[i] == 255.0f )
+        continue;
+      inner_min = std::min( inner_min, values[i] );
+      inner_max = std::max( inner_max, values[i] );
+    }
+    int a0 = inner_min <= inner_max ? (int)inner_min : 0;
+    int a1 = inner_min <= inner_max ? (int)inner_max : 255;
+    t_byte candidate[8];
+    if ( EncodeSingleChannelMode( block, channel, a0, a1, candidate ) < best_error )
+      std::memcpy( target, candidate, sizeof( candidate ) );
+  }
+}
+
+
+//---------------------------------------------------------------------
+// BC7 mode 6 block
+//---------------------------------------------------------------------
+
+
+//! writes bits to a 128 bit block, starting at the least significant bit of byte 0
+class CBitWriter
+{
+public:
+
+  CBitWriter( t_byte *target ) : _target( target ) { std::memset( _target, 0, 16 ); }
+
+  void Write( unsigned int value, size_t bits )
+  {
+    for ( size_t i = 0; i < bits; ++ i, ++ _pos )
+      _target[_pos / 8] |= (t_byte)( ((value >> i) & 1u) << (_pos % 8) );
+  }
+
+private:
+
+  t_byte *_target;
+  size_t  _pos{ 0 };
+};
+
+
+//! reads bits from a 128 bit block
+class CBitReader
+{
+public:
+
+  CBitReader( const t_byte *source ) : _source( source ) {}
+
+  unsigned int Read( size_t bits )
+  {
+    unsigned int value = 0;
+    for ( size_t i = 0; i < bits; ++ i, ++ _pos )
+      value |= (unsigned int)((_source[_pos / 8] >> (_pos % 8)) & 1u) << i;
+    return value;
+  }
+
+private:
+
+  const t_byte *_source;
+  size_t        _pos{ 0 };
+};
+
+
+//! quantize an end point to 7 bits per channel plus a shared p-bit
+void QuantizeMode6( const float e[4], unsigned int pbit, int q[4] )
+{
+  for ( int c = 0; c < 4; ++ c )
+  {
+    int v = (int)std::lround( (e[c] - (float)pbit) / 2.0f );
+    q[c] = std::min( 127, std::max( 0, v ) );
+  }
+}
+
+
+//! p-bit of an end point with the minimum quantization error
+unsigned int BestPBit( const float e[4] )
+{
+  float error[2]{ 0.0f, 0.0f };
+  for ( unsigned int p = 0; p < 2; ++ p )
+  {
+    int q[4];
+    QuantizeMode6( e, p, q );
+    for ( int c = 0; c < 4; ++ c )
+    {
+      float d = e[c] - (float)(q[c] * 2 + (int)p);
+      error[p] += d * d;
+    }
+  }
+  return error[1] < error[0] ? 1 : 0;
+}
+
+
+void Mode6Palette( const int q0[4], unsigned int p0, const int q1[4], unsigned int p1, float palette[16][4] )
+{
+  for ( int c = 0; c < 4; ++ c )
+  {
+    int e0 = q0[c] * 2 + (int)p0;
+    int e1 = q1[c] * 2 + (int)p1;
+    for ( int i = 0; i < 16; ++ i )
+      palette[i][c] = (float)( ((64 - c_bc7_weights4[i]) * e0 + c_bc7_weights4[i] * e1 + 32) >> 6 );
+  }
+}
+
+
+void WriteMode6( const int q0[4], unsigned int p0, const int q1[4], unsigned int p1, const t_byte indices[16], t_byte target[16] )
+{
+  CBitWriter writer( target );
+  writer.Write( 1u << 6, 7 );
+  for ( int c = 0; c < 4; ++ c )
+  {
+    writer.Write( (unsigned int)q0[c], 7 );
+    writer.Write( (unsigned int)q1[c], 7 );
+  }
+  writer.Write( p0, 1 );
+  writer.Write( p1, 1 );
+  writer.Write( indices[0], 3 );
+  for ( size_t i = 1; i < 16; ++ i )
+    writer.Write( indices[i], 4 );
+}
+
+
+void EncodeBC7( const TBlock &block, TBlockCompressionQuality quality, t_byte target[16] )
+{
+  static const float weight16[16]{
+    0.0f/64.0f, 4.0f/64.0f, 9.0f/64.0f, 13.0f/64.0f, 17.0f/64.0f, 21.0f/64.0f, 26.0f/64.0f, 30.0f/64.0f,
+    34.0f/64.0f, 38.0f/64.0f, 43.0f/64.0f, 47.0f/64.0f, 51.0f/64.0f, 55.0f/64.0f, 60.0f/64.0f, 64.0f/64.0f };
+
+  TEndPoints ep;
+  InitialEndPoints( quality, block, 0, 4, 0xffff, ep );
+
+  float  best_error = FLT_MAX;
+  int    best_q0[4]{}, best_q1[4]{};
+  unsigned int best_p0 = 0, best_p1 = 0;
+  t_byte best_indices[16]{};
+  for ( int iteration = 0; iteration <= RefinementIterations( quality ); ++ iteration )
+  {
+    // p-bit candidates: best p-bit per end point, or all combinations
+    std::array<std::array<unsigned int, 2>, 4> pbits{ { { BestPBit( ep._e0 ), BestPBit( ep._e1 ) } } };
+    size_t no_of_pbits = 1;
+    if ( quality == TBlockCompressionQuality::high )
+    {
+      pbits = { { { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 } } };
+      no_of_pbits = 4;
+    }
+
+    t_byte iteration_indices[16]{};
+    float  iteration_error = FLT_MAX;
+    for ( size_t k = 0; k < no_of_pbits; ++ k )
+    {
+      int q0[4], q1[4];
+      QuantizeMode6( ep._e0, pbits[k][0], q0 );
+      QuantizeMode6( ep._e1, pbits[k][1], q1 );
+
+      float palette[16][4];
+      Mode6Palette( q0, pbits[k][0], q1, pbits[k][1], palette );
+      t_byte indices[16];
+      float error = SelectIndices( block, 0, 4, palette, 16, indices );
+      if ( error < iteration_error )
+      {
+        iteration_error = error;
+        std::memcpy( iteration_indices, indices, sizeof( indices ) );
+      }
+      if ( error < best_error )
+      {
+        best_error = error;
+        std::copy( q0, q0 + 4, best_q0 );
+        std::copy( q1, q1 + 4, best_q1 );
+        best_p0 = pbits[k][0];
+        best_p1 = pbits[k][1];
+        std::memcpy( best_indices, indices, sizeof( indices ) );
+      }
+    }
+
+    if ( best_error == 0.0f || RefineEndPoints( block, 0, 4, 0xffff, iteration_indices, weight16, ep ) == false )
+      break;
+  }
+
+  // the most significant bit of the anchor index is implicitly 0
+  if ( best_indices[0] & 8 )
+  {
+    std::swap( best_q0, best_q1 );
+    std::swap( best_p0, best_p1 );
+    for ( auto &index : best_indices )
+      index = (t_byte)(15 - index);
+  }
+  WriteMode6( best_q0, best_p0, best_q1, best_p1, best_indices, target );
+}
+
+
+//---------------------------------------------------------------------
+// decoder
+//---------------------------------------------------------------------
+
+
+void DecodeColorBlock( const t_byte *source, bool four_color, t_byte rgba[16][4] )
+{
+  int palette[4][4];
+  ColorPalette( ReadU16( source ), ReadU16( source + 2 ), four_color, palette );
+  for ( size_t i = 0; i < 16; ++ i )
+  {
+    int index = (source[4 + i / 4] >> ((i % 4) * 2)) & 3;
+    for ( int c = 0; c < 4; ++ c )
+      rgba[i][c] = (t_byte)palette[index][c];
+  }
+}
+
+
+void DecodeSingleChannelBlock( const t_byte *source, size_t channel, t_byte rgba[16][4] )
+{
+  int palette[8];
+  SingleChannelPalette( source[0], source[1], palette );
+  std::uint64_t bits = 0;
+  for ( size_t i = 0; i < 6; ++ i )
+    bits |= (std::uint64_t)source[2 + i] << (i * 8);
+  for ( size_t i = 0; i < 16; ++ i )
+    rgba[i][channel] = (t_byte)palette[(bits >> (i * 3)) & 7];
+}
+
+
+void DecodeBC7Block( const t_byte *source, t_byte rgba[16][4] )
+{
+  // only mode 6 is supported; other modes are decoded to transparent black
+  if ( (source[0] & 0x7f) != 0x40 )
+  {
+    std::memset( rgba, 0, 16 * 4 );
+    return;
+  }
+
+  CBitReader reader( source );
+  reader.Read( 7 );
+  int q0[4], q1[4];
+  for ( int c = 0; c < 4; ++ c )
+  {
+    q0[c] = (int)reader.Read( 7 );
+    q1[c] = (int)reader.Read( 7 );
+  }
+  unsigned int p0 = reader.Read( 1 );
+  unsigned int p1 = reader.Read( 1 );
+
+  float palette[16][4];
+  Mode6Palette( q0, p0, q1, p1, palette );
+  for ( size_t i = 0; i < 16; ++ i )
+  {
+    unsigned int index = reader.Read( i == 0 ? 3 : 4 );
+    for ( int c = 0; c < 4; ++ c )
+      rgba[i][c] = (t_byte)palette[index][c];
+  }
+}
+
+
+void DecodeBlock( TImageFormat format, const t_byte *source, t_byte rgba[16][4] )
+{
+  switch ( format )
+  {
+    default: break;
+
+    case TImageFormat::BC1_RGB:
+    case TImageFormat::BC1_RGBA:
+      DecodeColorBlock( source, false, rgba );
+      if ( format == TImageFormat::BC1_RGB )
+      {
+        for ( size_t i = 0; i < 16; ++ i )
+          rgba[i][3] = 255;
+      }
+      break;
+
+    case TImageFormat::BC3:
+      DecodeColorBlock( source + 8, true, rgba );
+      DecodeSingleChannelBlock( source, 3, rgba );
+      break;
+
+    case TImageFormat::BC4:
+    case TImageFormat::BC5:
+      for ( size_t i = 0; i < 16; ++ i )
+      {
+        rgba[i][1] = rgba[i][2] = 0;
+        rgba[i][3] = 255;
+      }
+      DecodeSingleChannelBlock( source, 0, rgba );
+      if ( format == TImageFormat::BC5 )
+        DecodeSingleChannelBlock( source + 8, 1, rgba );
+      break;
+
+    case TImageFormat::BC7:
+      DecodeBC7Block( source, rgba );
+      break;
+  }
+}
+
+
+//! number of channels, which are stored by a compressed format
+size_t CompressedChannels( TImageFormat format )
+{
+  switch ( format )
+  {
+    case TImageFormat::BC4:     return 1;
+    case TImageFormat::BC5:     return 2;
+    case TImageFormat::BC1_RGB: return 3;
+    default: break;
+  }
+  return 4;
+}
+
+
+} // anonymous namespace
+
+
+//---------------------------------------------------------------------
+// CCompressedImage
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CCompressedImage::CCompressedImage(
+  TImageKind   kind,   //!< in: kind of the image content
+  TImageFormat format, //!< in: compressed format
+  size_t       cx,     //!< in: width in texels
+  size_t       cy )    //!< in: height in texels
+  : _kind( kind )
+  , _format( format )
+  , _cx( cx )
+  , _cy( cy )
+  , _data( CompressedImageSize( format, cx, cy ), 0 )
+{}
+
+
+//---------------------------------------------------------------------
+// CBlockCompressor
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CBlockCompressor::CBlockCompressor(
+  const TBlockCompressionParameters &parameters ) //!< in: compression parameters
+  : _parameters( parameters )
+{}
+
+
+/******************************************************************//**
+* \brief   Compress an 8 bit 2 dimensional image.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CBlockCompressor::Compress(
+  const IImageResource &image,        //!< in: source image
+  CCompressedImage     &compressed )  //!< out: compressed image
+  const
+{
+  TTextureSize size = image.Size();
+  if ( TexelSize( image.Format() ) == 0 || image.Type() != TTextureType::T2D || size[0] == 0 || size[1] == 0 || image.DataPtr() == nullptr )
+  {
+    std::cout << "error: block compression requires a 2 dimensional 8 bit image" << std::endl;
+    return false;
+  }
+  size_t block_size = CompressedBlockSize( _parameters._format );
+  if ( block_size == 0 )
+  {
+    std::cout << "error: block compression requires a compressed target format" << std::endl;
+    return false;
+  }
+
+  compressed = CCompressedImage( image.Kind(), _parameters._format, size[0], size[1] );
+  size_t blocks_x = (size[0] + 3) / 4;
+  size_t blocks_y = (size[1] + 3) / 4;
+  t_byte *target  = compressed.Data().data();
+  TImageFormat format = _parameters._format;
+  TBlockCompressionQuality quality = _parameters._quality;
+
+  ParallelFor( 0, blocks_y, 1, _parameters._threads, [&]( size_t begin, size_t end )
+  {
+    TBlock block;
+    for ( size_t by = begin; by < end; ++ by )
+    {
+      for ( size_t bx = 0; bx < blocks_x; ++ bx )
+      {
+        ReadBlock( image, bx, by, block );
+        t_byte *block_target = target + (by * blocks_x + bx) * block_size;
+        switch ( format )
+        {
+          default: break;
+          case TImageFormat::BC1_RGB:  EncodeBC1( block, false, quality, block_target ); break;
+          case TImageFormat::BC1_RGBA: EncodeBC1( block, true, quality, block_target ); break;
+          case TImageFormat::BC3:
+            EncodeBC4( block, 3, quality, block_target );
+            EncodeColorBlock( block, 0xffff, false, quality, block_target + 8 );
+            break;
+          case TImageFormat::BC4: EncodeBC4( block, 0, quality, block_target ); break;
+          case TImageFormat::BC5:
+            EncodeBC4( block, 0, quality, block_target );
+            EncodeBC4( block, 1, quality, block_target + 8 );
+            break;
+          case TImageFormat::BC7: EncodeBC7( block, quality, block_target ); break;
+        }
+      }
+    }
+  } );
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Decompress a compressed image to RGBA8 texels.
+*
+* Single and 2 channel formats are decoded like an OpenGL texture
+* lookup (R, G, 0, 1).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CBlockCompressor::Decompress(
+  const IImageResource &compressed,     //!< in: compressed image
+  std::vector<t_byte>  &rgba,           //!< out: RGBA8 texels
+  size_t                no_of_threads ) //!< in: number of worker threads; 0: default concurrency
+{
+  TImageFormat format     = compressed.Format();
+  size_t       block_size = CompressedBlockSize( format );
+  TTextureSize size       = compressed.Size();
+  if ( block_size == 0 || compressed.DataPtr() == nullptr )
+    return false;
+
+  size_t cx = size[0];
+  size_t cy = size[1];
+  size_t blocks_x = (cx + 3) / 4;
+  size_t blocks_y = (cy + 3) / 4;
+  const t_byte *source = static_cast<const t_byte*>( compressed.DataPtr() );
+  rgba.resize( cx * cy * 4 );
+
+  ParallelFor( 0, blocks_y, 4, no_of_threads, [&]( size_t begin, size_t end )
+  {
+    t_byte texels[16][4];
+    for ( size_t by = begin; by < end; ++ by )
+    {
+      for ( size_t bx = 0; bx < blocks_x; ++ bx )
+      {
+        DecodeBlock( format, source + (by * blocks_x + bx) * block_size, texels );
+        for ( size_t j = 0; j < 4 && by * 4 + j < cy; ++ j )
+        {
+          for ( size_t i = 0; i < 4 && bx * 4 + i < cx; ++ i )
+            std::memcpy( rgba.data() + ((by * 4 + j) * cx + bx * 4 + i) * 4, texels[j*4 + i], 4 );
+        }
+      }
+    }
+  } );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Peak signal to noise ratio of decompressed RGBA8 texels.
+*
+* Only the channels, which are stored by the compressed format, are
+* evaluated.
+*
+* \return  PSNR in dB; infinity for identical images
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+double CBlockCompressor::PSNR(
+  const IImageResource      &reference,          //!< in: uncompressed source image
+  const std::vector<t_byte> &rgba,               //!< in: decompressed RGBA8 texels
+  TImageFormat               compressed_format ) //!< in: compressed format
+{
+  TTextureSize size       = reference.Size();
+  size_t       texel_size = TexelSize( reference.Format() );
+  size_t       channels   = CompressedChannels( compressed_format );
+  if ( texel_size == 0 || rgba.size() < size[0] * size[1] * 4 )
+    return 0.0;
+
+  const t_byte *data = static_cast<const t_byte*>( reference.DataPtr() );
+  double sum = 0.0;
+  for ( size_t y = 0; y < size[1]; ++ y )
+  {
+    for ( size_t x = 0; x < size[0]; ++ x )
+    {
+      t_byte texel[4];
+      ReadTexel( reference.Format(), data + y * reference.BPL() + x * texel_size, texel );
+      const t_byte *decoded = rgba.data() + (y * size[0] + x) * 4;
+      for ( size_t c = 0; c < channels; ++ c )
+      {
+        double d = (double)texel[c] - (double)decoded[c];
+        sum += d * d;
+      }
+    }
+  }
+  double mse = sum / (double)(size[0] * size[1] * channels);
+  return mse > 0.0 ? 10.0 * std::log10( 255.0 * 255.0 / mse ) : std::numeric_limits<double>::infinity();
+}
+
+
+} // Render
@@ -0,0 +1,727 @@
+/******************************************************************//**
+* \brief   Clustered light assignment.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_ClusteredLights.h"
+#include "../../include/util/RenderUtil_Parallel.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+// SIMD
+
+#if defined(__AVX2__)
+#define RENDERUTIL_CLUSTEREDLIGHTS_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERUTIL_CLUSTEREDLIGHTS_SSE2
+#endif
+
+#if defined(RENDERUTIL_CLUSTEREDLIGHTS_AVX2) || defined(RENDERUTIL_CLUSTEREDLIGHTS_SSE2)
+#include <immintrin.h>
+#endif
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+const float   c_empty      = 1.0e30f; //!< bounds of the padding clusters: minimum `c_empty`, maximum `-c_empty`
+const float   c_epsilon    = 1.0e-4f; //!< relative enlargement of the cluster bounds, against rounding in the shader
+const float   c_pi         = 3.14159265358979f;
+const size_t  c_row_align  = 8;       //!< rows of clusters are padded to a multiple of the widest SIMD register
+const std::uint8_t c_disabled = 0;
+const std::uint8_t c_culled   = 1;
+const std::uint8_t c_global   = 2;
+const std::uint8_t c_point    = 3;
+const std::uint8_t c_spot     = 4;
+
+
+//! coefficients of a projection matrix (OpenGL clip space, column major: `m[column][row]`)
+struct TProjection
+{
+  TProjection( const TMat44 &m )
+    : _sx( m[0][0] ), _sy( m[1][1] ), _zx( m[2][0] ), _zy( m[2][1] ), _ox( m[3][0] ), _oy( m[3][1] )
+    , _zz( m[2][2] ), _oz( m[3][2] ), _zw( m[2][3] ), _ow( m[3][3] )
+  {}
+
+  //! clip space w at the view space depth `d` (`z = -d`)
+  float W( float d ) const { return -_zw * d + _ow; }
+
+  //! view space x of the normalized device x `n` at the depth `d`
+  float X( float n, float d ) const { return (n * W( d ) + _zx * d - _ox) / _sx; }
+  float Y( float n, float d ) const { return (n * W( d ) + _zy * d - _oy) / _sy; }
+
+  //! normalized device x of the view space x at the depth `d`
+  float NX( float x, float d ) const { return (_sx * x - _zx * d + _ox) / W( d ); }
+  float NY( float y, float d ) const { return (_sy * y - _zy * d + _oy) / W( d ); }
+
+  //! view space depth of the normalized device z `s` (-1: near plane, 1: far plane)
+  float Depth( float s ) const
+  {
+    float denominator = _zz - s * _zw;
+    return std::fabs( denominator ) < 1.0e-12f ? c_infinite : (_oz - s * _ow) / denominator;
+  }
+
+  static constexpr float c_infinite = 1.0e30f;
+
+  float _sx, _sy, _zx, _zy, _ox, _oy, _zz, _oz, _zw, _ow;
+};
+
+
+//! brightness of a light color; the brightness is encoded to the alpha channel
+inline float Brightness( const TColor8 &color )
+{
+  return (float)color[3] / 255.0f * (float)std::max( { color[0], color[1], color[2] } ) / 255.0f;
+}
+
+
+//! transform a homogeneous coordinate by a column major matrix
+inline TVec4 Transform( const TMat44 &m, const TVec4 &v )
+{
+  TVec4 r;
+  for ( int i = 0; i < 4; ++ i )
+    r[i] = m[0][i] * v[0] + m[1][i] * v[1] + m[2][i] * v[2] + m[3][i] * v[3];
+  return r;
+}
+
+
+//! normalized vector; the zero vector is kept
+inline std::array<float, 3> Normalize( float x, float y, float z )
+{
+  float length = std::sqrt( x * x + y * y + z * z );
+  if ( length <= 0.0f )
+    return { 0.0f, 0.0f, 0.0f };
+  return { x / length, y / length, z / length };
+}
+
+
+//! pointers to a row of clusters
+struct TClusterRow
+{
+  const float *_min_x, *_min_y, *_min_z;
+  const float *_max_x, *_max_y, *_max_z;
+  const float *_center_x, *_center_y, *_center_z, *_radius;
+};
+
+
+#if defined(RENDERUTIL_CLUSTEREDLIGHTS_AVX2)
+
+//! 8 float lanes
+struct TLanesAVX2
+{
+  using T = __m256;
+  static const size_t c_width = 8;
+
+  static T   Set( float v )            { return _mm256_set1_ps( v ); }
+  static T   Load( const float *p )    { return _mm256_loadu_ps( p ); }
+  static T   Add( T a, T b )           { return _mm256_add_ps( a, b ); }
+  static T   Sub( T a, T b )           { return _mm256_sub_ps( a, b ); }
+  static T   Mul( T a, T b )           { return _mm256_mul_ps( a, b ); }
+  static T   Max( T a, T b )           { return _mm256_max_ps( a, b ); }
+  static T   Sqrt( T a )               { return _mm256_sqrt_ps( a ); }
+  static T   Ge( T a, T b )            { return _mm256_cmp_ps( a, b, _CMP_GE_OQ ); }
+  static T   Le( T a, T b )            { return _mm256_cmp_ps( a, b, _CMP_LE_OQ ); }
+  static T   And( T a, T b )           { return _mm256_and_ps( a, b ); }
+  static int Bits( T a )               { return _mm256_movemask_ps( a ); }
+};
+
+#endif
+
+#if defined(RENDERUTIL_CLUSTEREDLIGHTS_SSE2)
+
+//! 4 float lanes
+struct TLanesSSE2
+{
+  using T = __m128;
+  static const size_t c_width = 4;
+
+  static T   Set( float v )            { return _mm_set1_ps( v ); }
+  static T   Load( const float *p )    { return _mm_loadu_ps( p ); }
+  static T   Add( T a, T b )           { return _mm_add_ps( a, b ); }
+  static T   Sub( T a, T b )           { return _mm_sub_ps( a, b ); }
+  static T   Mul( T a, T b )           { return _mm_mul_ps( a, b ); }
+  static T   Max( T a, T b )           { return _mm_max_ps( a, b ); }
+  static T   Sqrt( T a )               { return _mm_sqrt_ps( a ); }
+  static T   Ge( T a, T b )            { return _mm_cmpge_ps( a, b ); }
+  static T   Le( T a, T b )            { return _mm_cmple_ps( a, b ); }
+  static T   And( T a, T b )           { return _mm_and_ps( a, b ); }
+  static int Bits( T a )               { return _mm_movemask_ps( a ); }
+};
+
+#endif
+
+
+#if defined(RENDERUTIL_CLUSTEREDLIGHTS_AVX2) || defined(RENDERUTIL_CLUSTEREDLIGHTS_SSE2)
+
+//! test the clusters `[x0, x1]` of a row against the sphere (and the cone) of a light, `TLanes::c_width` clusters at once
+template <class TLanes, class TEmit>
+void TestRow(
+  const TClusterRow &row,
+  size_t             x0,
+  size_t             x1,
+  const std::array<float, 4> &sphere,
+  const std::array<float, 3> &apex,
+  const std::array<float, 3> &axis,
+  float              range,
+  float              cos_angle,
+  float              sin_angle,
+  bool               spot,
+  TEmit              emit )
+{
+  using T = typename TLanes::T;
+  const size_t W = TLanes::c_width;
+
+  const T zero = TLanes::Set( 0.0f );
+  const T sx = TLanes::Set( sphere[0] ), sy = TLanes::Set( sphere[1] ), sz = TLanes::Set( sphere[2] );
+  const T r2 = TLanes::Set( sphere[3] * sphere[3] );
+  const T ax = TLanes::Set( apex[0] ), ay = TLanes::Set( apex[1] ), az = TLanes::Set( apex[2] );
+  const T dx = TLanes::Set( axis[0] ), dy = TLanes::Set( axis[1] ), dz = TLanes::Set( axis[2] );
+  const T cone_range = TLanes::Set( range ), cone_cos = TLanes::Set( cos_angle ), cone_sin = TLanes::Set( sin_angle );
+
+  for ( size_t p = x0 - x0 % W; p <= x1; p += W )
+  {
+    // squared distance from the center of the sphere to the box
+    T ex = TLanes::Max( TLanes::Max( TLanes::Sub( TLanes::Load( row._min_x + p ), sx ), TLanes::Sub( sx, TLanes::Load( row._max_x + p ) ) ), zero );
+    T ey = TLanes::Max( TLanes::Max( TLanes::Sub( TLanes::Load( row._min_y + p ), sy ), TLanes::Sub( sy, TLanes::Load( row._max_y + p ) ) ), zero );
+    T ez = TLanes::Max( TLanes::Max( TLanes::Sub( TLanes::Load( row._min_z + p ), sz ), TLanes::Sub( sz, TLanes::Load( row._max_z + p ) ) ), zero );
+    T d2 = TLanes::Add( TLanes::Add( TLanes::Mul( ex, ex ), TLanes::Mul( ey, ey ) ), TLanes::Mul( ez, ez ) );
+    T mask = TLanes::Le( d2, r2 );
+    if ( spot && TLanes::Bits( mask ) != 0 )
+    {
+      // cone against the bounding sphere of the cluster
+      T vx = TLanes::Sub( TLanes::Load( row._center_x + p ), ax );
+      T vy = TLanes::Sub( TLanes::Load( row._center_y + p ), ay );
+      T vz = TLanes::Sub( TLanes::Load( row._center_z + p ), az );
+      T rs = TLanes::Load( row._radius + p );
+      T len2 = TLanes::Add( TLanes::Add( TLanes::Mul( vx, vx ), TLanes::Mul( vy, vy ) ), TLanes::Mul( vz, vz ) );
+      T v1 = TLanes::Add( TLanes::Add( TLanes::Mul( vx, dx ), TLanes::Mul( vy, dy ) ), TLanes::Mul( vz, dz ) );
+      T distance = TLanes::Sub(
+        TLanes::Mul( cone_cos, TLanes::Sqrt( TLanes::Max( TLanes::Sub( len2, TLanes::Mul( v1, v1 ) ), zero ) ) ),
+        TLanes::Mul( v1, cone_sin ) );
+      mask = TLanes::And( mask, TLanes::Le( distance, rs ) );
+      mask = TLanes::And( mask, TLanes::Le( v1, TLanes::Add( rs, cone_range ) ) );
+      mask = TLanes::And( mask, TLanes::Ge( v1, TLanes::Sub( zero, rs ) ) );
+    }
+
+    unsigned int bits = (unsigned int)TLanes::Bits( mask );
+    for ( size_t i = 0; bits != 0; ++ i, bits >>= 1 )
+    {
+      size_t x = p + i;
+      if ( (bits & 1) != 0 && x >= x0 && x <= x1 )
+        emit( x );
+    }
+  }
+}
+
+#else
+
+//! test the clusters `[x0, x1]` of a row against the sphere (and the cone) of a light
+template <class TLanes, class TEmit>
+void TestRow(
+  const TClusterRow &row,
+  size_t             x0,
+  size_t             x1,
+  const std::array<float, 4> &sphere,
+  const std::array<float, 3> &apex,
+  const std::array<float, 3> &axis,
+  float              range,
+  float              cos_angle,
+  float              sin_angle,
+  bool               spot,
+  TEmit              emit )
+{
+  for ( size_t x = x0; x <= x1; ++ x )
+  {
+    float ex = std::max( std::max( row._min_x[x] - sphere[0], sphere[0] - row._max_x[x] ), 0.0f );
+    float ey = std::max( std::max( row._min_y[x] - sphere[1], sphere[1] - row._max_y[x] ), 0.0f );
+    float ez = std::max( std::max( row._min_z[x] - sphere[2], sphere[2] - row._max_z[x] ), 0.0f );
+    bool inside = ex * ex + ey * ey + ez * ez <= sphere[3] * sphere[3];
+    if ( spot && inside )
+    {
+      float vx = row._center_x[x] - apex[0], vy = row._center_y[x] - apex[1], vz = row._center_z[x] - apex[2];
+      float rs = row._radius[x];
+      float len2 = vx * vx + vy * vy + vz * vz;
+      float v1 = vx * axis[0] + vy * axis[1] + vz * axis[2];
+      float distance = cos_angle * std::sqrt( std::max( len2 - v1 * v1, 0.0f ) ) - v1 * sin_angle;
+      inside = distance <= rs && v1 <= rs + range && v1 >= 0.0f - rs;
+    }
+    if ( inside )
+      emit( x );
+  }
+}
+
+#endif
+
+
+#if defined(RENDERUTIL_CLUSTEREDLIGHTS_AVX2)
+using TLanes = TLanesAVX2;
+#elif defined(RENDERUTIL_CLUSTEREDLIGHTS_SSE2)
+using TLanes = TLanesSSE2;
+#else
+struct TLanes {};
+#endif
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   Maximum influence distance of a light source.
+*
+* The distance, where the light falls below `LigthMinThreshold`, by
+* the brightness and the attenuation of the light. If the attenuation
+* is derived from the maximum radius (`auto_attenuation_by_radius`),
+* then the distance is the maximum radius. A radius cut off limits the
+* distance to the maximum radius, except the cut off is calculated
+* automatically (`auto_radius`).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+float CClusteredLights::InfluenceRadius(
+  const TLight &light ) //!< I - light source
+{
+  if ( light._position[3] == 0.0f )
+    return c_infinite_radius;
+
+  float brightness = std::max( Brightness( light._diffuse ), Brightness( light._specular ) );
+  if ( brightness <= 0.0f )
+    return 0.0f;
+
+  float radius = c_infinite_radius;
+  if ( light._properties.test( (size_t)TLightProperty::auto_attenuation_by_radius ) )
+  {
+    radius = light._maximum_radius;
+  }
+  else
+  {
+    const TVec3 &attenuation = light._attenuation;
+    if ( attenuation[0] >= brightness / LigthMinThreshold() && attenuation[1] >= 0.0f && attenuation[2] >= 0.0f )
+      return 0.0f; // below the threshold at each distance
+    float distance = LightMaxDistance( brightness, attenuation[0], attenuation[1], attenuation[2] );
+    if ( std::isnan( distance ) == false )
+      radius = std::min( distance, c_infinite_radius );
+  }
+
+  if ( light._properties.test( (size_t)TLightProperty::radius_cutoff ) && light._properties.test( (size_t)TLightProperty::auto_radius ) == false )
+    radius = std::min( radius, light._maximum_radius );
+  return std::max( radius, 0.0f );
+}
+
+
+/******************************************************************//**
+* \brief   ctor.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CClusteredLights::CClusteredLights(
+  size_t x,             //!< I - number of clusters in x (tiles of the viewport)
+  size_t y,             //!< I - number of clusters in y
+  size_t z,             //!< I - number of depth slices
+  size_t no_of_threads ) //!< I - number of threads (0: default concurrency)
+  : _x( std::max( x, (size_t)1 ) )
+  , _y( std::max( y, (size_t)1 ) )
+  , _z( std::max( z, (size_t)1 ) )
+  , _no_of_threads( no_of_threads )
+{
+  _stride = (_x + c_row_align - 1) / c_row_align * c_row_align;
+  size_t padded = _stride * _y * _z;
+  for ( auto *bounds : { &_min_x, &_min_y, &_min_z } )
+    bounds->assign( padded, c_empty );
+  for ( auto *bounds : { &_max_x, &_max_y, &_max_z } )
+    bounds->assign( padded, -c_empty );
+  for ( auto *center : { &_center_x, &_center_y, &_center_z } )
+    center->assign( padded, 0.0f );
+  _radius.assign( padded, -1.0f );
+
+  _clusters.assign( _x * _y * _z, TCluster_std430{ 0, 0 } );
+  _slice_lights.resize( _z );
+  _slice_indices.resize( _z );
+  _slice_pairs.resize( _z );
+  _slice_tested.assign( _z, 0 );
+  _grid._size = { (std::uint32_t)_x, (std::uint32_t)_y, (std::uint32_t)_z, 0 };
+}
+
+
+/******************************************************************//**
+* \brief   View space bounding box of a cluster.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+TBoundingBox CClusteredLights::ClusterBounds(
+  size_t x,        //!< I - tile in x
+  size_t y,        //!< I - tile in y
+  size_t z )       //!< I - depth slice
+  const
+{
+  size_t i = (z * _y + y) * _stride + x;
+  return TBoundingBox{ { _min_x[i], _min_y[i], _min_z[i] }, { _max_x[i], _max_y[i], _max_z[i] } };
+}
+
+
+/******************************************************************//**
+* \brief   Compute the depth slices and the bounds of the clusters.
+*
+* The bounds only depend on the projection; they are recomputed, when
+* the projection changes.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CClusteredLights::SetupClusters(
+  const TMat44 &projection, //!< I - projection matrix
+  float         max_depth ) //!< I - maximum depth (0: far plane)
+{
+  if ( projection == _projection && max_depth == _max_depth )
+    return;
+  _projection = projection;
+  _max_depth = max_depth;
+
+  TProjection p( projection );
+  float near_depth = p.Depth( -1.0f );
+  float far_depth = p.Depth( 1.0f );
+  if ( far_depth <= near_depth || far_depth >= TProjection::c_infinite )
+    far_depth = max_depth > 0.0f ? max_depth : std::max( near_depth, 1.0e-3f ) * 1.0e4f;
+  else if ( max_depth > 0.0f )
+    far_depth = std::min( far_depth, max_depth );
+  near_depth = std::max( near_depth, far_depth * 1.0e-6f );
+
+  float scale = (float)_z / std::log( far_depth / near_depth );
+  float bias = -std::log( near_depth ) * scale;
+  _grid._depth = { near_depth, far_depth, scale, bias };
+
+  for ( size_t z = 0; z < _z; ++ z )
+  {
+    float d0 = z == 0 ? near_depth : near_depth * std::pow( far_depth / near_depth, (float)z / (float)_z );
+    float d1 = z + 1 == _z ? far_depth : near_depth * std::pow( far_depth / near_depth, (float)(z + 1) / (float)_z );
+    float e = d1 * c_epsilon;
+    for ( size_t y = 0; y < _y; ++ y )
+    {
+      float ny0 = -1.0f + 2.0f * (float)y / (float)_y;
+      float ny1 = -1.0f + 2.0f * (float)(y + 1) / (float)_y;
+      size_t row = (z * _y + y) * _stride;
+      for ( size_t x = 0; x < _x; ++ x )
+      {
+        float nx0 = -1.0f + 2.0f * (float)x / (float)_x;
+        float nx1 = -1.0f + 2.0f * (float)(x + 1) / (float)_x;
+        float min_x = std::min( { p.X( nx0, d0 ), p.X( nx1, d0 ), p.X( nx0, d1 ), p.X( nx1, d1 ) } ) - e;
+        float max_x = std::max( { p.X( nx0, d0 ), p.X( nx1, d0 ), p.X( nx0, d1 ), p.X( nx1, d1 ) } ) + e;
+        float min_y = std::min( { p.Y( ny0, d0 ), p.Y( ny1, d0 ), p.Y( ny0, d1 ), p.Y( ny1, d1 ) } ) - e;
+        float max_y = std::max( { p.Y( ny0, d0 ), p.Y( ny1, d0 ), p.Y( ny0, d1 ), p.Y( ny1, d1 ) } ) + e;
+        float min_z = -d1 - e;
+        float max_z = -d0 + e;
+
+        size_t i = row + x;
+        _min_x[i] = min_x; _min_y[i] = min_y; _min_z[i] = min_z;
+        _max_x[i] = max_x; _max_y[i] = max_y; _max_z[i] = max_z;
+        _center_x[i] = (min_x + max_x) * 0.5f;
+        _center_y[i] = (min_y + max_y) * 0.5f;
+        _center_z[i] = (min_z + max_z) * 0.5f;
+        float hx = max_x - _center_x[i], hy = max_y - _center_y[i], hz = max_z - _center_z[i];
+        _radius[i] = std::sqrt( hx * hx + hy * hy + hz * hz );
+      }
+    }
+  }
+}
+
+
+/******************************************************************//**
+* \brief   Assign the lights to the clusters.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CClusteredLights::Assign(
+  const TLightTable &lights,     //!< I - light table
+  const TMat44      &view,       //!< I - view matrix
+  const TMat44      &projection, //!< I - projection matrix
+  float              max_depth ) //!< I - maximum depth (0: far plane of the projection)
+{
+  SetupClusters( projection, max_depth );
+
+  const TProjection p( projection );
+  const float near_depth = _grid._depth[0], far_depth = _grid._depth[1];
+  const float scale = _grid._depth[2], bias = _grid._depth[3];
+  auto slice = [&]( float d ) -> std::uint32_t
+  {
+    float k = std::floor( std::log( d ) * scale + bias );
+    return (std::uint32_t)std::clamp( k, 0.0f, (float)(_z - 1) );
+  };
+  auto tile = [&]( float n, size_t size ) -> std::uint32_t
+  {
+    float t = std::floor( (n + 1.0f) * 0.5f * (float)size );
+    return (std::uint32_t)std::clamp( t, 0.0f, (float)(size - 1) );
+  };
+
+  // transform the lights and compute their bounding volumes
+
+  size_t no_of_lights = lights.size();
+  _lights.resize( no_of_lights );
+  _binned.resize( no_of_lights );
+  _kind.resize( no_of_lights );
+  ParallelFor( 0, no_of_lights, 256, _no_of_threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t i = begin; i < end; ++ i )
+    {
+      const TLight &light = lights[i];
+      TLight_std430 &data = _lights[i];
+      TBinnedLight &binned = _binned[i];
+      data = TLight_std430{};
+      binned._index = (std::uint32_t)i;
+      _kind[i] = c_disabled;
+
+      float radius = light._properties.test( (size_t)TLightProperty::enabled ) ? InfluenceRadius( light ) : 0.0f;
+      if ( radius <= 0.0f )
+        continue;
+
+      bool camera_relative = light._properties.test( (size_t)TLightProperty::camera_relative );
+      TVec4 position = camera_relative ? light._position : Transform( view, light._position );
+      float brightness = (float)light._diffuse[3] / 255.0f;
+      data._color = { light._diffuse[0] / 255.0f * brightness, light._diffuse[1] / 255.0f * brightness, light._diffuse[2] / 255.0f * brightness, -1.0f };
+      data._attenuation = { light._attenuation[0], light._attenuation[1], light._attenuation[2], light._cut_off_weight };
+      data._direction = { 0.0f, 0.0f, 0.0f, -1.0f };
+
+      if ( light._position[3] == 0.0f )
+      {
+        auto direction = Normalize( position[0], position[1], position[2] );
+        data._position = { direction[0], direction[1], direction[2], 0.0f };
+        _kind[i] = c_global;
+        continue;
+      }
+
+      float center[3]{ position[0] / position[3], position[1] / position[3], position[2] / position[3] };
+      data._position = { center[0], center[1], center[2], radius };
+      binned._sphere = { center[0], center[1], center[2], radius };
+      binned._apex = { center[0], center[1], center[2] };
+      binned._range = radius;
+      binned._spot = false;
+
+      bool spot = light._light_cone > 0.0f && light._light_cone < c_pi;
+      if ( spot )
+      {
+        TVec4 direction4{ light._direction[0], light._direction[1], light._direction[2], 0.0f };
+        TVec4 direction = camera_relative ? direction4 : Transform( view, direction4 );
+        binned._axis = Normalize( direction[0], direction[1], direction[2] );
+        float outer = std::min( light.OuterConeAngle() * 0.5f, c_pi * 0.5f );
+        float inner = std::min( light.InnerConeAngle() * 0.5f, outer );
+        data._direction = { binned._axis[0], binned._axis[1], binned._axis[2], std::cos( outer ) };
+        data._color[3] = std::cos( inner );
+
+        // smallest sphere around the cone (spherical sector)
+        binned._spot = true;
+        binned._cos = std::cos( outer );
+        binned._sin = std::sin( outer );
+        float t = outer <= c_pi * 0.25f ? radius / (2.0f * binned._cos) : radius * binned._cos;
+        float r = outer <= c_pi * 0.25f ? t : radius * binned._sin;
+        binned._sphere = { center[0] + binned._axis[0] * t, center[1] + binned._axis[1] * t, center[2] + binned._axis[2] * t, r };
+      }
+
+      if ( radius >= c_infinite_radius )
+      {
+        _kind[i] = c_global;
+        continue;
+      }
+
+      // depth range and screen rectangle of the bounding box of the sphere
+      const auto &sphere = binned._sphere;
+      float d0 = std::max( -sphere[2] - sphere[3], near_depth );
+      float d1 = std::min( -sphere[2] + sphere[3], far_depth );
+      if ( d0 > d1 )
+      {
+        _kind[i] = c_culled;
+        continue;
+      }
+      float nx0 = 1.0e30f, nx1 = -1.0e30f, ny0 = 1.0e30f, ny1 = -1.0e30f;
+      for ( float d : { d0, d1 } )
+      {
+        for ( float s : { -sphere[3], sphere[3] } )
+        {
+          float nx = p.NX( sphere[0] + s, d ), ny = p.NY( sphere[1] + s, d );
+          nx0 = std::min( nx0, nx ); nx1 = std::max( nx1, nx );
+          ny0 = std::min( ny0, ny ); ny1 = std::max( ny1, ny );
+        }
+      }
+      if ( nx1 < -1.0f || nx0 > 1.0f || ny1 < -1.0f || ny0 > 1.0f )
+      {
+        _kind[i] = c_culled;
+        continue;
+      }
+      binned._clusters = {
+        tile( nx0 - c_epsilon, _x ), tile( nx1 + c_epsilon, _x ),
+        tile( ny0 - c_epsilon, _y ), tile( ny1 + c_epsilon, _y ),
+        slice( d0 * (1.0f - c_epsilon) ), slice( d1 * (1.0f + c_epsilon) ) };
+      _kind[i] = spot ? c_spot : c_point;
+    }
+  } );
+
+  // bin the lights to the depth slices
+
+  _statistics = TStatistics{};
+  for ( auto &slice_lights : _slice_lights )
+    slice_lights.clear();
+  _indices.clear();
+  for ( size_t i = 0; i < no_of_lights; ++ i )
+  {
+    switch ( _kind[i] )
+    {
+      case c_disabled: continue;
+      case c_culled: ++ _statistics._culled; break;
+      case c_global: ++ _statistics._global_lights; _indices.push_back( (std::uint32_t)i ); break;
+      case c_point: ++ _statistics._point_lights; break;
+      case c_spot: ++ _statistics._spot_lights; break;
+    }
+    ++ _statistics._lights;
+    if ( _kind[i] == c_point || _kind[i] == c_spot )
+    {
+      for ( std::uint32_t z = _binned[i]._clusters[4]; z <= _binned[i]._clusters[5]; ++ z )
+        _slice_lights[z].push_back( (std::uint32_t)i );
+    }
+  }
+  size_t no_of_global = _indices.size();
+  _grid._size[3] = (std::uint32_t)no_of_global;
+
+  // assign the lights of the slices to the clusters
+
+  ParallelFor( 0, _z, 1, _no_of_threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t z = begin; z < end; ++ z )
+      AssignSlice( z );
+  } );
+
+  // concatenate the light indices of the slices
+
+  std::vector<size_t> slice_offsets( _z );
+  size_t offset = no_of_global;
+  size_t slice_size = _x * _y;
+  for ( size_t z = 0; z < _z; ++ z )
+  {
+    slice_offsets[z] = offset;
+    for ( size_t c = z * slice_size; c < (z + 1) * slice_size; ++ c )
+    {
+      _clusters[c]._offset += (std::uint32_t)offset;
+      _statistics._max_lights = std::max( _statistics._max_lights, (size_t)_clusters[c]._count );
+    }
+    offset += _slice_indices[z].size();
+    _statistics._tested += _slice_tested[z];
+  }
+  _statistics._indices = offset - no_of_global;
+  _indices.resize( offset );
+  ParallelFor( 0, _z, 1, _no_of_threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t z = begin; z < end; ++ z )
+    {
+      if ( _slice_indices[z].empty() == false )
+        std::memcpy( _indices.data() + slice_offsets[z], _slice_indices[z].data(), _slice_indices[z].size() * sizeof( std::uint32_t ) );
+    }
+  } );
+}
+
+
+/******************************************************************//**
+* \brief   Assign the lights of a depth slice to its clusters.
+*
+* The (cluster, light) pairs are collected in the order of the lights
+* and sorted by the clusters by a counting sort, so the lights of a
+* cluster stay in ascending order. The offsets of the clusters are
+* relative to the slice.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CClusteredLights::AssignSlice(
+  size_t z ) //!< I - depth slice
+{
+  auto &pairs = _slice_pairs[z];
+  pairs.clear();
+  size_t tested = 0;
+
+  for ( std::uint32_t i : _slice_lights[z] )
+  {
+    const TBinnedLight &light = _binned[i];
+    size_t x0 = light._clusters[0], x1 = light._clusters[1];
+    for ( size_t y = light._clusters[2]; y <= light._clusters[3]; ++ y )
+    {
+      size_t row = (z * _y + y) * _stride;
+      TClusterRow cluster_row{
+        _min_x.data() + row, _min_y.data() + row, _min_z.data() + row,
+        _max_x.data() + row, _max_y.data() + row, _max_z.data() + row,
+        _center_x.data() + row, _center_y.data() + row, _center_z.data() + row, _radius.data() + row };
+      size_t cluster = y * _x;
+      TestRow<TLanes>( cluster_row, x0, x1, light._sphere, light._apex, light._axis, light._range, light._cos, light._sin, light._spot,
+        [&]( size_t x )
+      {
+        pairs.push_back( (std::uint32_t)(cluster + x) );
+        pairs.push_back( i );
+      } );
+      tested += x1 - x0 + 1;
+    }
+  }
+  _slice_tested[z] = tested;
+
+  // counting sort by the clusters
+  size_t slice_size = _x * _y;
+  TCluster_std430 *clusters = _clusters.data() + z * slice_size;
+  for ( size_t c = 0; c < slice_size; ++ c )
+    clusters[c] = TCluster_std430{ 0, 0 };
+  for ( size_t k = 0; k < pairs.size(); k += 2 )
+    ++ clusters[pairs[k]]._count;
+  std::uint32_t offset = 0;
+  for ( size_t c = 0; c < slice_size; ++ c )
+  {
+    clusters[c]._offset = offset;
+    offset += clusters[c]._count;
+  }
+  auto &indices = _slice_indices[z];
+  indices.resize( offset );
+  for ( size_t k = 0; k < pairs.size(); k += 2 )
+    indices[clusters[pairs[k]]._offset ++] = pairs[k + 1];
+  for ( size_t c = 0; c < slice_size; ++ c )
+    clusters[c]._offset -= clusters[c]._count;
+}
+
+
+} // Render
@@ -0,0 +1,1021 @@
+/******************************************************************//**
+* \brief   CPU cone step map generation from a height map.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_ConeStepMap.h"
+#include "../../include/util/RenderUtil_Parallel.h"
+
+
+// STL
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+
+// SIMD
+
+#if defined(__AVX2__)
+#define RENDERUTIL_CONESTEPMAP_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERUTIL_CONESTEPMAP_SSE2
+#endif
+
+#if defined(RENDERUTIL_CONESTEPMAP_AVX2) || defined(RENDERUTIL_CONESTEPMAP_SSE2)
+#include <immintrin.h>
+#endif
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+const int   c_lanes      = 8;    //!< number of texels, which are scanned at once
+const float c_max_cone_c = 1.0f; //!< maximum cone ratio of the circular search
+const float c_max_ratio  = 1.0f; //!< maximum cone ratio of the square ring search
+const long  c_ring_block = 16;    //!< number of samples of a side of a square ring, which are tested against the pyramid at once
+
+
+std::ptrdiff_t Wrap( std::ptrdiff_t i, std::ptrdiff_t n )
+{
+  return (i % n + n) % n;
+}
+
+
+//! heights with a tiled border in x, so that a ring can be read for 8 texels without wrap around
+struct THeightPlane
+{
+  THeightPlane( const std::vector<t_byte> &heights, long cx, long cy, long margin, size_t tile_rows, size_t no_of_threads )
+    : _cy( cy )
+    , _margin( margin )
+    , _stride( cx + 2 * margin )
+  {
+    _data.resize( (size_t)_stride * cy );
+    ParallelFor( 0, (size_t)cy, tile_rows, no_of_threads, [&]( size_t begin, size_t end )
+    {
+      for ( size_t y = begin; y < end; ++ y )
+      {
+        const t_byte *source = heights.data() + y * cx;
+        t_byte       *target = _data.data() + y * _stride;
+        for ( long x = 0; x < _stride; ++ x )
+          target[x] = source[Wrap( x - margin, cx )];
+      }
+    } );
+  }
+
+  //! column 0 of a row; the row wraps around
+  const t_byte * Row( std::ptrdiff_t y ) const
+  {
+    return _data.data() + Wrap( y, _cy ) * _stride + _margin;
+  }
+
+  //! column 0 of a row in [0, cy-1]
+  const t_byte * ImageRow( std::ptrdiff_t y ) const
+  {
+    return _data.data() + y * _stride + _margin;
+  }
+
+  std::vector<t_byte> _data;
+  long                _cy;
+  long                _margin;
+  long                _stride;
+};
+
+
+//! offsets of the texels of the circles of the circular search; the offsets are mirrored in x and y
+struct TCircles
+{
+  struct TCircle
+  {
+    float        _dist;     //!< radius in texture space
+    size_t       _first;    //!< first offset
+    size_t       _count;    //!< number of offsets
+    std::int32_t _extent_x; //!< maximum offset in x of this and all the inner circles
+    std::int32_t _extent_y; //!< maximum absolute offset in y of this and all the inner circles
+  };
+
+  std::vector<TCircle>                     _circles;
+  std::vector<std::array<std::int32_t, 2>> _offsets;
+  std::int32_t                             _min_dy = 0; //!< minimum offset in y
+  std::int32_t                             _max_dy = 0; //!< maximum offset in y
+};
+
+
+//! compute the offsets of the circles by the walk of the scalar loop
+TCircles CircleOffsets( long cx, long cy )
+{
+  TCircles     circles;
+  std::int32_t extent_x = 0, extent_y = 0;
+
+  float step_x = 1.0f / (float)cx;
+  float step_y = 1.0f / (float)cy;
+  float step = std::max(step_x, step_y);
+
+  // the search radius is at most 1 (`max_dist`)
+  for ( float dist = step; dist <= 1.0f; dist += step )
+  {
+    size_t first = circles._offsets.size();
+    int    d2    = (int)(0.5f + (dist * dist) / (step * step));
+    int    dy    = (int)(0.5f + dist / step_y);
+    for ( int dx = 0; (float)dx / (float)cx <= dist; ++ dx )
+    {
+      if ((dx * dx + dy * dy) < d2 && dy < cy - 1)
+        dy++;
+      do
+      {
+        circles._offsets.push_back( { dx, dy } );
+        circles._min_dy = std::min( circles._min_dy, dy );
+        circles._max_dy = std::max( circles._max_dy, dy );
+        extent_x = std::max( extent_x, dx );
+        extent_y = std::max( extent_y, std::abs( dy ) );
+        dy--;
+      } while (dy > 0 && (dx * dx + dy * dy) >= d2);
+    }
+
+    // the maximum does not depend on the order of the texels
+    auto begin = circles._offsets.begin() + first;
+    std::sort( begin, circles._offsets.end() );
+    circles._offsets.erase( std::unique( begin, circles._offsets.end() ), circles._offsets.end() );
+    circles._circles.push_back( { dist, first, circles._offsets.size() - first, extent_x, extent_y } );
+  }
+  return circles;
+}
+
+
+//! slope of the height in x (blue) and y (alpha), and the height (red) of one row
+void DerivativesRow( const t_byte *H, long width, long height, long y, t_byte *target )
+{
+  for (long x = 0; x < width; ++x)
+  {
+    int der;
+    // Blue is the slope in x
+    if (x == 0)
+      der = (H[y * width + (x + 1)] - H[y * width + (x)]) / 2;
+    else if (x == width - 1)
+      der = (H[y * width + (x)] - H[y * width + (x - 1)]) / 2;
+    else
+      der = H[y * width + (x + 1)] - H[y * width + (x - 1)];
+    target[x * 4 + 2] = (t_byte)(127 + der / 2);
+    // Alpha is the slope in y
+    if (y == 0)
+      der = (H[(y + 1) * width + x] - H[(y) * width + x]) / 2;
+    else if (y == height - 1)
+      der = (H[(y) * width + x] - H[(y - 1) * width + x]) / 2;
+    else
+      der = (H[(y + 1) * width + x] - H[(y - 1) * width + x]);
+    // And the sign of Y will be reversed in OpenGL
+    target[x * 4 + 3] = (t_byte)(127 - der / 2);
+    target[x * 4 + 0] = H[y * width + x];
+  }
+}
+
+
+//---------------------------------------------------------------------
+// max pyramid
+//---------------------------------------------------------------------
+
+
+//! max-mip pyramid of the heights; a texel of level `l` is the maximum of 2x2 texels of level `l-1`
+struct TMaxPyramid
+{
+  TMaxPyramid( const std::vector<t_byte> &heights, long cx, long cy )
+  {
+    _levels.push_back( { cx, cy, heights } );
+    while ( _levels.back()._cx > 1 || _levels.back()._cy > 1 )
+    {
+      const TLevel &source = _levels.back();
+      TLevel level{ (source._cx + 1) / 2, (source._cy + 1) / 2, {} };
+      level._data.resize( (size_t)level._cx * level._cy );
+      for ( long y = 0; y < level._cy; ++ y )
+      {
+        long y0 = 2 * y, y1 = std::min( 2 * y + 1, source._cy - 1 );
+        for ( long x = 0; x < level._cx; ++ x )
+        {
+          long x0 = 2 * x, x1 = std::min( 2 * x + 1, source._cx - 1 );
+          level._data[y * level._cx + x] = std::max(
+            std::max( source.At( x0, y0 ), source.At( x1, y0 ) ),
+            std::max( source.At( x0, y1 ), source.At( x1, y1 ) ) );
+        }
+      }
+      _levels.push_back( std::move( level ) );
+    }
+  }
+
+  //! upper bound of the heights in the rectangle [x0, x1] x [y0, y1]; the rectangle wraps around at the borders
+  t_byte Max( long x0, long x1, long y0, long y1 ) const
+  {
+    long cx = _levels[0]._cx, cy = _levels[0]._cy;
+    if ( x0 >= 0 && x1 < cx && y0 >= 0 && y1 < cy )
+    {
+      const long x_range[2]{ x0, x1 }, y_range[2]{ y0, y1 };
+      return Max( x_range, y_range );
+    }
+
+    long x_ranges[2][2], y_ranges[2][2];
+    int  no_x = Ranges( x0, x1, cx, x_ranges );
+    int  no_y = Ranges( y0, y1, cy, y_ranges );
+    t_byte maximum = 0;
+    for ( int j = 0; j < no_y; ++ j )
+    {
+      for ( int i = 0; i < no_x; ++ i )
+        maximum = std::max( maximum, Max( x_ranges[i], y_ranges[j] ) );
+    }
+    return maximum;
+  }
+
+private:
+
+  struct TLevel
+  {
+    long                _cx;
+    long                _cy;
+    std::vector<t_byte> _data;
+
+    t_byte At( long x, long y ) const { return _data[y * _cx + x]; }
+  };
+
+  //! split a range, which wraps around, into ranges in [0, n-1]
+  static int Ranges( long first, long last, long n, long ranges[2][2] )
+  {
+    if ( last - first + 1 >= n )
+    {
+      ranges[0][0] = 0;
+      ranges[0][1] = n - 1;
+      return 1;
+    }
+    long length = last - first;
+    first = (long)Wrap( first, n );
+    last  = first + length;
+    ranges[0][0] = first;
+    ranges[0][1] = std::min( last, n - 1 );
+    if ( last < n )
+      return 1;
+    ranges[1][0] = 0;
+    ranges[1][1] = last - n;
+    return 2;
+  }
+
+  //! maximum of the at most 3x3 cells of the level, whose cells are at least half as large as the rectangle
+  t_byte Max( const long x_range[2], const long y_range[2] ) const
+  {
+    unsigned long extent = (unsigned long)std::max( x_range[1] - x_range[0], y_range[1] - y_range[0] ) + 1;
+    size_t        l      = std::min( (size_t)std::bit_width( extent ) - 1, _levels.size() - 1 );
+    const TLevel &level  = _levels[l];
+    t_byte maximum = 0;
+    for ( long y = y_range[0] >> l; y <= y_range[1] >> l; ++ y )
+    {
+      for ( long x = x_range[0] >> l; x <= x_range[1] >> l; ++ x )
+        maximum = std::max( maximum, level.At( x, y ) );
+    }
+    return maximum;
+  }
+
+  std::vector<TLevel> _levels;
+};
+
+
+//---------------------------------------------------------------------
+// scalar loops
+//---------------------------------------------------------------------
+
+
+//! circular search of one row; scalar reference loop
+void CircularRowScalar( const t_byte *H, long cx, long cy, long y, t_byte *target )
+{
+  float step_x = 1.0f / (float)cx;
+  float step_y = 1.0f / (float)cy;
+  float step = std::max(step_x, step_y);
+  for (long x = 0; x < cx; ++x)
+  {
+    int   act_h = H[y * cx + x];
+    float c = c_max_cone_c;
+    float h = (float)act_h / 255.0f;
+    float max_h = 1.0f - h;
+    float max_dist = std::min(c_max_cone_c * max_h, 1.0f);
+
+    for (float dist = step; dist <= max_dist && c > dist / max_h; dist += step)
+    {
+      int   d2 = (int)(0.5f + (dist * dist) / (step * step));
+      int   dy = (int)(0.5f + dist / step_y);
+      int   sample_h = 0;
+      for (int dx = 0; sample_h < 255 && (float)dx / (float)cx <= dist; ++dx)
+      {
+        if ((dx * dx + dy * dy) < d2 && dy < cy - 1)
+          dy++;
+        do
+        {
+          long sx_n = Wrap(x - dx, cx);
+          long sx_p = Wrap(x + dx, cx);
+          long sy_n = Wrap(y - dy, cy) * cx;
+          long sy_p = Wrap(y + dy, cy) * cx;
+
+          sample_h = std::max(sample_h, (int)H[sy_p + sx_p]);
+          sample_h = std::max(sample_h, (int)H[sy_n + sx_p]);
+          sample_h = std::max(sample_h, (int)H[sy_p + sx_n]);
+          sample_h = std::max(sample_h, (int)H[sy_n + sx_n]);
+
+          dy--;
+        } while (dy > 0 && (dx * dx + dy * dy) >= d2);
+      }
+      if (sample_h > act_h)
+      {
+        float d_h = (float)(sample_h - act_h) / 255.0f;
+        float sample_c = dist / d_h;
+        c = std::min(c, sample_c);
+      }
+    }
+
+    target[x * 4 + 1] = (t_byte)(std::sqrt(c) * 255.0f);
+  }
+}
+
+
+//! square ring search of one row; scalar reference loop (the image is tileable in x and y)
+void SquareRingsRowScalar( const t_byte *H, long width, long height, long y, t_byte *target )
+{
+  float iheight = 1.0f / height;
+  float iwidth = 1.0f / width;
+  for (long x = 0; x < width; ++x)
+  {
+    long x1, x2, y1, y2;
+    float r2, h2;
+    // (note the ratio squared is used throughout, and the sqrt is taken at the end)
+    float min_ratio2 = c_max_ratio * c_max_ratio;
+    float ht = H[y * width + x] / 255.0f;
+    // scan in outwardly expanding blocks (so the scan can stop at the minimum ratio)
+    for (int rad = 1;
+      (rad * rad <= 1.1 * 1.1 * (1.0 - ht) * (1.0 - ht) * min_ratio2 * width * height)
+      && (rad <= 1.1 * (1.0 - ht) * width) && (rad <= 1.1 * (1.0 - ht) * height);
+      ++rad)
+    {
+      // West
+      x1 = Wrap(x - rad, width);
+      {
+        float delx = -rad * iwidth;
+        // (+- 1 because the corners are covered in the X-run)
+        y1 = std::max(y - rad + 1, 0L);
+        y2 = std::min(y + rad - 1, height - 1);
+        for (long dy = y1; dy <= y2; ++dy)
+        {
+          float dely = (dy - y) * iheight;
+          r2 = delx * delx + dely * dely;
+          h2 = (0.5f + H[dy * width + x1]) / 255.0f - ht;
+          if ((h2 > 0.0f) && (h2 * h2 * min_ratio2 > r2))
+            min_ratio2 = r2 / (h2 * h2);
+        }
+      }
+      // East
+      x2 = Wrap(x + rad, width);
+      {
+        float delx = rad * iwidth;
+        y1 = std::max(y - rad + 1, 0L);
+        y2 = std::min(y + rad - 1, height - 1);
+        for (long dy = y1; dy <= y2; ++dy)
+        {
+          float dely = (dy - y) * iheight;
+          r2 = delx * delx + dely * dely;
+          h2 = (0.5f + H[dy * width + x2]) / 255.0f - ht;
+          if ((h2 > 0.0f) && (h2 * h2 * min_ratio2 > r2))
+            min_ratio2 = r2 / (h2 * h2);
+        }
+      }
+      // North
+      y1 = Wrap(y - rad, height);
+      {
+        float dely = -rad * iheight;
+        x1 = std::max(x - rad, 0L);
+        x2 = std::min(x + rad, width - 1);
+        for (long dx = x1; dx <= x2; ++dx)
+        {
+          float delx = (dx - x) * iwidth;
+          r2 = delx * delx + dely * dely;
+          h2 = (0.5f + H[y1 * width + dx]) / 255.0f - ht;
+          if ((h2 > 0.0f) && (h2 * h2 * min_ratio2 > r2))
+            min_ratio2 = r2 / (h2 * h2);
+        }
+      }
+      // South
+      y2 = Wrap(y + rad, height);
+      {
+        float dely = rad * iheight;
+        x1 = std::max(x - rad, 0L);
+        x2 = std::min(x + rad, width - 1);
+        for (long dx = x1; dx <= x2; ++dx)
+        {
+          float delx = (dx - x) * iwidth;
+          r2 = delx * delx + dely * dely;
+          h2 = (0.5f + H[y2 * width + dx]) / 255.0f - ht;
+          if ((h2 > 0.0f) && (h2 * h2 * min_ratio2 > r2))
+            min_ratio2 = r2 / (h2 * h2);
+        }
+      }
+    }
+
+    // the data is mostly on the low end; the square root of the ratio spreads it better
+    float actual_ratio = std::sqrt(min_ratio2);
+    actual_ratio /= c_max_ratio;
+    actual_ratio = std::sqrt(actual_ratio);
+    t_byte ratio = static_cast<t_byte>(255.0 * actual_ratio + 0.5);
+    // the ratio has to be > 0, because the shader divides by it
+    target[x * 4 + 1] = std::max(ratio, (t_byte)1);
+  }
+}
+
+
+//---------------------------------------------------------------------
+// 8 texel lanes
+//---------------------------------------------------------------------
+
+
+//! maximum of the texels at `x0 + dx` and `x0 - dx`, in the rows `+dy` and `-dy`, for 8 texels
+void CircleMaximum( const TCircles &circles, const TCircles::TCircle &circle, const t_byte * const *rows, long x0, t_byte *maximum )
+{
+  const auto *offset = circles._offsets.data() + circle._first;
+  const auto *end    = offset + circle._count;
+
+#if defined(RENDERUTIL_CONESTEPMAP_SSE2)
+  __m128i m = _mm_setzero_si128();
+  for ( ; offset != end; ++ offset )
+  {
+    std::int32_t dx = (*offset)[0], dy = (*offset)[1];
+    const t_byte *row_p = rows[dy] + x0;
+    const t_byte *row_n = rows[-dy] + x0;
+    __m128i a = _mm_max_epu8( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( row_p + dx ) ), _mm_loadl_epi64( reinterpret_cast<const __m128i*>( row_n + dx ) ) );
+    __m128i b = _mm_max_epu8( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( row_p - dx ) ), _mm_loadl_epi64( reinterpret_cast<const __m128i*>( row_n - dx ) ) );
+    m = _mm_max_epu8( m, _mm_max_epu8( a, b ) );
+  }
+  _mm_storel_epi64( reinterpret_cast<__m128i*>( maximum ), m );
+#else
+  std::fill( maximum, maximum + c_lanes, (t_byte)0 );
+  for ( ; offset != end; ++ offset )
+  {
+    std::int32_t dx = (*offset)[0], dy = (*offset)[1];
+    const t_byte *row_p = rows[dy] + x0;
+    const t_byte *row_n = rows[-dy] + x0;
+    for ( int i = 0; i < c_lanes; ++ i )
+      maximum[i] = std::max( { maximum[i], row_p[i + dx], row_n[i + dx], row_p[i - dx], row_n[i - dx] } );
+  }
+#endif
+}
+
+
+//! rows `y + dy` and `y - dy` of all the offsets of the circles; the result is indexed by `dy`
+const t_byte * const * CircleRows( const THeightPlane &plane, const TCircles &circles, long y, std::vector<const t_byte*> &row_table )
+{
+  long dy_range = std::max( -circles._min_dy, circles._max_dy );
+  row_table.resize( 2 * dy_range + 1 );
+  for ( long dy = -dy_range; dy <= dy_range; ++ dy )
+    row_table[dy + dy_range] = plane.Row( y + dy );
+  return row_table.data() + dy_range;
+}
+
+
+//! some of the active texels may reduce `c` by a sample of the height `h` on a circle of radius `dist` or more
+bool CircleMayReduce( const bool *active, const int *act_h, const float *c, int h, float dist )
+{
+  for ( int i = 0; i < c_lanes; ++ i )
+  {
+    if ( active[i] && h > act_h[i] && dist / ((float)(h - act_h[i]) / 255.0f) < c[i] )
+      return true;
+  }
+  return false;
+}
+
+
+//! circular search of one row, for 8 texels at once; if there is a pyramid, the circles, which are too low to reduce `c`, are skipped
+void CircularRow( const THeightPlane &plane, const TMaxPyramid *pyramid, const TCircles &circles, long cx, long y, std::vector<const t_byte*> &row_table, t_byte *target )
+{
+  const t_byte * const *rows = CircleRows( plane, circles, y, row_table );
+  const size_t no_of_circles = circles._circles.size();
+
+  for ( long x0 = 0; x0 < cx; x0 += c_lanes )
+  {
+    int   act_h[c_lanes];
+    float c[c_lanes], max_h[c_lanes], max_dist[c_lanes];
+    bool  active[c_lanes];
+    for ( int i = 0; i < c_lanes; ++ i )
+    {
+      active[i] = x0 + i < cx;
+      act_h[i]  = active[i] ? rows[0][x0 + i] : 255;
+      c[i]      = c_max_cone_c;
+      float h   = (float)act_h[i] / 255.0f;
+      max_h[i]    = 1.0f - h;
+      max_dist[i] = std::min(c_max_cone_c * max_h[i], 1.0f);
+    }
+
+    for ( size_t k = 0; k < no_of_circles; ++ k )
+    {
+      // a texel, which stops, does not continue, because `c` decreases and `dist` increases
+      const auto &circle = circles._circles[k];
+      float dist = circle._dist;
+      bool  any  = false;
+      for ( int i = 0; i < c_lanes; ++ i )
+      {
+        active[i] = active[i] && dist <= max_dist[i] && c[i] > dist / max_h[i];
+        any = any || active[i];
+      }
+      if ( any == false )
+        break;
+
+      // Skip the longest run of circles [k, k + 2^n), whose bounding box is too low to reduce `c`.
+      // The ratio of a sample is `dist / d_h`; it increases with the radius and decreases with the height.
+      // `c` does not change, so the texels, which would have stopped within the run, stop after it.
+      if ( pyramid != nullptr )
+      {
+        size_t skip = 0;
+        for ( size_t run = 1; skip < no_of_circles - k; run *= 2 )
+        {
+          size_t last = std::min( k + run, no_of_circles ) - 1;
+          const auto &outer = circles._circles[last];
+          int h = pyramid->Max( x0 - outer._extent_x, x0 + c_lanes - 1 + outer._extent_x, y - outer._extent_y, y + outer._extent_y );
+          if ( CircleMayReduce( active, act_h, c, h, dist ) )
+            break;
+          skip = last + 1 - k;
+        }
+        if ( skip > 0 )
+        {
+          k += skip - 1;
+          continue;
+        }
+      }
+
+      t_byte sample_h[16];
+      CircleMaximum( circles, circle, rows, x0, sample_h );
+      for ( int i = 0; i < c_lanes; ++ i )
+      {
+        if ( active[i] && sample_h[i] > act_h[i] )
+        {
+          float d_h = (float)(sample_h[i] - act_h[i]) / 255.0f;
+          float sample_c = dist / d_h;
+          c[i] = std::min(c[i], sample_c);
+        }
+      }
+    }
+
+    for ( long i = 0; i < c_lanes && x0 + i < cx; ++ i )
+      target[(x0 + i) * 4 + 1] = (t_byte)(std::sqrt(c[i]) * 255.0f);
+  }
+}
+
+
+#if defined(RENDERUTIL_CONESTEPMAP_AVX2)
+
+
+//! float values of 8 texels
+struct TLanes
+{
+  __m256 _v;
+};
+
+inline TLanes LaneLoad( const float *v )
+{
+  return { _mm256_loadu_ps( v ) };
+}
+
+inline void LaneStore( const TLanes &lanes, float *v )
+{
+  _mm256_storeu_ps( v, lanes._v );
+}
+
+//! lanes of `mask`, whose index is in [`lo`, `hi`]
+inline TLanes LaneRange( const TLanes &mask, int lo, int hi )
+{
+  const __m256 index = _mm256_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f );
+  __m256 in_range = _mm256_and_ps( _mm256_cmp_ps( index, _mm256_set1_ps( (float)lo ), _CMP_GE_OQ ), _mm256_cmp_ps( index, _mm256_set1_ps( (float)hi ), _CMP_LE_OQ ) );
+  return { _mm256_and_ps( mask._v, in_range ) };
+}
+
+//! update the squared ratio of the lanes of `mask`, where the sample is higher than the texel and closer than the current ratio
+inline void SampleRing( TLanes &ratio2, const TLanes &ht, const TLanes &mask, const t_byte *texels, float r2 )
+{
+  __m256 sample = _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( texels ) ) ) );
+  __m256 h2     = _mm256_sub_ps( _mm256_div_ps( _mm256_add_ps( _mm256_set1_ps( 0.5f ), sample ), _mm256_set1_ps( 255.0f ) ), ht._v );
+  __m256 hh     = _mm256_mul_ps( h2, h2 );
+  __m256 vr2    = _mm256_set1_ps( r2 );
+  __m256 update = _mm256_and_ps( mask._v, _mm256_and_ps(
+    _mm256_cmp_ps( h2, _mm256_setzero_ps(), _CMP_GT_OQ ),
+    _mm256_cmp_ps( _mm256_mul_ps( hh, ratio2._v ), vr2, _CMP_GT_OQ ) ) );
+  if ( _mm256_movemask_ps( update ) != 0 )
+    ratio2._v = _mm256_blendv_ps( ratio2._v, _mm256_div_ps( vr2, hh ), update );
+}
+
+//! some of the lanes of `mask` may reduce their ratio by a sample of the height `height` in the squared distance `r2` or more
+inline bool RingMayReduce( const TLanes &ratio2, const TLanes &ht, const TLanes &mask, float height, float r2 )
+{
+  __m256 h2 = _mm256_sub_ps( _mm256_set1_ps( height ), ht._v );
+  __m256 reduce = _mm256_and_ps( mask._v, _mm256_and_ps(
+    _mm256_cmp_ps( h2, _mm256_setzero_ps(), _CMP_GT_OQ ),
+    _mm256_cmp_ps( _mm256_mul_ps( _mm256_mul_ps( h2, h2 ), ratio2._v ), _mm256_set1_ps( r2 ), _CMP_GT_OQ ) ) );
+  return _mm256_movemask_ps( reduce ) != 0;
+}
+
+
+#elif defined(RENDERUTIL_CONESTEPMAP_SSE2)
+
+
+//! float values of 8 texels
+struct TLanes
+{
+  __m128 _v[2];
+};
+
+inline TLanes LaneLoad( const float *v )
+{
+  return { { _mm_loadu_ps( v ), _mm_loadu_ps( v + 4 ) } };
+}
+
+inline void LaneStore( const TLanes &lanes, float *v )
+{
+  _mm_storeu_ps( v, lanes._v[0] );
+  _mm_storeu_ps( v + 4, lanes._v[1] );
+}
+
+//! lanes of `mask`, whose index is in [`lo`, `hi`]
+inline TLanes LaneRange( const TLanes &mask, int lo, int hi )
+{
+  const __m128 lo_v = _mm_set1_ps( (float)lo ), hi_v = _mm_set1_ps( (float)hi );
+  TLanes range;
+  for ( int j = 0; j < 2; ++ j )
+  {
+    __m128 index = _mm_add_ps( _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f ), _mm_set1_ps( 4.0f * j ) );
+    range._v[j] = _mm_and_ps( mask._v[j], _mm_and_ps( _mm_cmpge_ps( index, lo_v ), _mm_cmple_ps( index, hi_v ) ) );
+  }
+  return range;
+}
+
+//! update the squared ratio of the lanes of `mask`, where the sample is higher than the texel and closer than the current ratio
+inline void SampleRing( TLanes &ratio2, const TLanes &ht, const TLanes &mask, const t_byte *texels, float r2 )
+{
+  __m128i bytes = _mm_unpacklo_epi8( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( texels ) ), _mm_setzero_si128() );
+  __m128  vr2   = _mm_set1_ps( r2 );
+  for ( int j = 0; j < 2; ++ j )
+  {
+    __m128i words  = j == 0 ? _mm_unpacklo_epi16( bytes, _mm_setzero_si128() ) : _mm_unpackhi_epi16( bytes, _mm_setzero_si128() );
+    __m128  sample = _mm_cvtepi32_ps( words );
+    __m128  h2     = _mm_sub_ps( _mm_div_ps( _mm_add_ps( _mm_set1_ps( 0.5f ), sample ), _mm_set1_ps( 255.0f ) ), ht._v[j] );
+    __m128  hh     = _mm_mul_ps( h2, h2 );
+    __m128  update = _mm_and_ps( mask._v[j], _mm_and_ps( _mm_cmpgt_ps( h2, _mm_setzero_ps() ), _mm_cmpgt_ps( _mm_mul_ps( hh, ratio2._v[j] ), vr2 ) ) );
+    if ( _mm_movemask_ps( update ) != 0 )
+      ratio2._v[j] = _mm_or_ps( _mm_andnot_ps( update, ratio2._v[j] ), _mm_and_ps( update, _mm_div_ps( vr2, hh ) ) );
+  }
+}
+
+//! some of the lanes of `mask` may reduce their ratio by a sample of the height `height` in the squared distance `r2` or more
+inline bool RingMayReduce( const TLanes &ratio2, const TLanes &ht, const TLanes &mask, float height, float r2 )
+{
+  __m128 reduce = _mm_setzero_ps();
+  for ( int j = 0; j < 2; ++ j )
+  {
+    __m128 h2 = _mm_sub_ps( _mm_set1_ps( height ), ht._v[j] );
+    reduce = _mm_or_ps( reduce, _mm_and_ps( mask._v[j], _mm_and_ps( _mm_cmpgt_ps( h2, _mm_setzero_ps() ), _mm_cmpgt_ps( _mm_mul_ps( _mm_mul_ps( h2, h2 ), ratio2._v[j] ), _mm_set1_ps( r2 ) ) ) ) );
+  }
+  return _mm_movemask_ps( reduce ) != 0;
+}
+
+
+#else
+
+
+//! float values of 8 texels
+struct TLanes
+{
+  float _v[c_lanes];
+};
+
+inline TLanes LaneLoad( const float *v )
+{
+  TLanes lanes;
+  std::copy( v, v + c_lanes, lanes._v );
+  return lanes;
+}
+
+inline void LaneStore( const TLanes &lanes, float *v )
+{
+  std::copy( lanes._v, lanes._v + c_lanes, v );
+}
+
+//! lanes of `mask`, whose index is in [`lo`, `hi`]
+inline TLanes LaneRange( const TLanes &mask, int lo, int hi )
+{
+  TLanes range;
+  for ( int i = 0; i < c_lanes; ++ i )
+    range._v[i] = i >= lo && i <= hi ? mask._v[i] : 0.0f;
+  return range;
+}
+
+//! update the squared ratio of the lanes of `mask`, where the sample is higher than the texel and closer than the current ratio
+inline void SampleRing( TLanes &ratio2, const TLanes &ht, const TLanes &mask, const t_byte *texels, float r2 )
+{
+  for ( int i = 0; i < c_lanes; ++ i )
+  {
+    float h2 = (0.5f + texels[i]) / 255.0f - ht._v[i];
+    if ( mask._v[i] != 0.0f && (h2 > 0.0f) && (h2 * h2 * ratio2._v[i] > r2) )
+      ratio2._v[i] = r2 / (h2 * h2);
+  }
+}
+
+//! some of the lanes of `mask` may reduce their ratio by a sample of the height `height` in the squared distance `r2` or more
+inline bool RingMayReduce( const TLanes &ratio2, const TLanes &ht, const TLanes &mask, float height, float r2 )
+{
+  for ( int i = 0; i < c_lanes; ++ i )
+  {
+    float h2 = height - ht._v[i];
+    if ( mask._v[i] != 0.0f && (h2 > 0.0f) && (h2 * h2 * ratio2._v[i] > r2) )
+      return true;
+  }
+  return false;
+}
+
+
+#endif
+
+
+//! mask of the active lanes
+inline TLanes LaneMask( const bool *active )
+{
+  float mask[c_lanes];
+  for ( int i = 0; i < c_lanes; ++ i )
+  {
+    std::uint32_t bits = active[i] ? 0xffffffffu : 0u;
+    std::memcpy( mask + i, &bits, sizeof( float ) );
+  }
+  return LaneLoad( mask );
+}
+
+
+//! height of the texel center of the square ring search
+inline float TexelHeight( int h )
+{
+  return (0.5f + h) / 255.0f;
+}
+
+
+//! square ring search of one row, for 8 texels at once; if there is a pyramid, the rings and the blocks of the rings, which are too low to reduce the ratio, are skipped
+void SquareRingsRow( const THeightPlane &plane, const TMaxPyramid *pyramid, long width, long height, long y, t_byte *target )
+{
+  float iheight = 1.0f / height;
+  float iwidth = 1.0f / width;
+  const t_byte *center = plane.Row( y );
+  const long max_rad = (long)(1.1 * std::max( width, height )) + 1;
+
+  for ( long x0 = 0; x0 < width; x0 += c_lanes )
+  {
+    float ht[c_lanes], min_ratio2[c_lanes];
+    bool  active[c_lanes];
+    for ( int i = 0; i < c_lanes; ++ i )
+    {
+      active[i]     = x0 + i < width;
+      ht[i]         = center[x0 + i] / 255.0f;
+      min_ratio2[i] = c_max_ratio * c_max_ratio;
+    }
+    TLanes ht_lanes    = LaneLoad( ht );
+    TLanes ratio_lanes = LaneLoad( min_ratio2 );
+
+    for ( int rad = 1; ; ++ rad )
+    {
+      // a texel, which stops, does not continue, because the ratio decreases and the radius increases
+      LaneStore( ratio_lanes, min_ratio2 );
+      bool any = false;
+      for ( int i = 0; i < c_lanes; ++ i )
+      {
+        active[i] = active[i]
+          && (rad * rad <= 1.1 * 1.1 * (1.0 - ht[i]) * (1.0 - ht[i]) * min_ratio2[i] * width * height)
+          && (rad <= 1.1 * (1.0 - ht[i]) * width) && (rad <= 1.1 * (1.0 - ht[i]) * height);
+        any = any || active[i];
+      }
+      if ( any == false )
+        break;
+      TLanes mask = LaneMask( active );
+
+      // Skip the longest run of rings [rad, rad + 2^n), whose bounding box is too low to reduce the ratio.
+      // The squared distance of a sample of ring `rad` is at least the squared distance of the ring.
+      // The ratio does not change, so the texels, which would have stopped within the run, stop after it.
+      if ( pyramid != nullptr )
+      {
+        float del_x = rad * iwidth;
+        float del_y = rad * iheight;
+        float ring_r2 = std::min( del_x * del_x, del_y * del_y );
+        long  skip = 0;
+        for ( long run = 1; skip < max_rad; run *= 2 )
+        {
+          long outer = rad + run - 1;
+          int  h = pyramid->Max( x0 - outer, x0 + c_lanes - 1 + outer, y - outer, y + outer );
+          if ( RingMayReduce( ratio_lanes, ht_lanes, mask, TexelHeight( h ), ring_r2 ) )
+            break;
+          skip = run;
+        }
+        if ( skip > 0 )
+        {
+          rad += (int)skip - 1;
+          continue;
+        }
+      }
+
+      // West and East; the corners are covered by North and South.
+      // The blocks of `c_ring_block` rows are tested with the distance of their closest row.
+      long y1 = std::max(y - rad + 1, 0L);
+      long y2 = std::min(y + rad - 1, height - 1);
+      for ( int side = 0; side < 2; ++ side )
+      {
+        long  column = side == 0 ? x0 - rad : x0 + rad;
+        float delx   = side == 0 ? -rad * iwidth : rad * iwidth;
+        for ( long b0 = y1, b1; b0 <= y2; b0 = b1 + 1 )
+        {
+          b1 = std::min( b0 | (c_ring_block - 1), y2 );
+          if ( pyramid != nullptr )
+          {
+            float dely = (y < b0 ? b0 - y : (y > b1 ? y - b1 : 0)) * iheight;
+            if ( RingMayReduce( ratio_lanes, ht_lanes, mask, TexelHeight( pyramid->Max( column, column + c_lanes - 1, b0, b1 ) ), delx * delx + dely * dely ) == false )
+              continue;
+          }
+          for ( long dy = b0; dy <= b1; ++ dy )
+          {
+            float dely = (dy - y) * iheight;
+            SampleRing( ratio_lanes, ht_lanes, mask, plane.ImageRow( dy ) + column, delx * delx + dely * dely );
+          }
+        }
+      }
+
+      // North and South; the rows are clamped to the image in x
+      for ( int side = 0; side < 2; ++ side )
+      {
+        long          row_y = (long)Wrap( side == 0 ? y - rad : y + rad, height );
+        const t_byte *row   = plane.ImageRow( row_y );
+        float dely = side == 0 ? -rad * iheight : rad * iheight;
+        long  d0   = std::max( -(long)rad, -x0 - (c_lanes - 1) );
+        long  d1   = std::min( (long)rad, width - 1 - x0 );
+        for ( long b0 = d0, b1; b0 <= d1; b0 = b1 + 1 )
+        {
+          b1 = std::min( b0 + c_ring_block - 1, d1 );
+          if ( pyramid != nullptr )
+          {
+            float delx = (b0 > 0 ? b0 : (b1 < 0 ? -b1 : 0)) * iwidth;
+            if ( RingMayReduce( ratio_lanes, ht_lanes, mask, TexelHeight( pyramid->Max( x0 + b0, x0 + b1 + c_lanes - 1, row_y, row_y ) ), delx * delx + dely * dely ) == false )
+              continue;
+          }
+          for ( long d = b0; d <= b1; ++ d )
+          {
+            float dx = d * iwidth;
+            SampleRing( ratio_lanes, ht_lanes, LaneRange( mask, (int)(-x0 - d), (int)(width - 1 - x0 - d) ), row + x0 + d, dx * dx + dely * dely );
+          }
+        }
+      }
+    }
+
+    LaneStore( ratio_lanes, min_ratio2 );
+    for ( long i = 0; i < c_lanes && x0 + i < width; ++ i )
+    {
+      float actual_ratio = std::sqrt(min_ratio2[i]);
+      actual_ratio /= c_max_ratio;
+      actual_ratio = std::sqrt(actual_ratio);
+      t_byte ratio = static_cast<t_byte>(255.0 * actual_ratio + 0.5);
+      target[(x0 + i) * 4 + 1] = std::max(ratio, (t_byte)1);
+    }
+  }
+}
+
+
+} // anonymous namespace
+
+
+//---------------------------------------------------------------------
+// CConeStepMapGenerator
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CConeStepMapGenerator::CConeStepMapGenerator(
+  const TConeMapParameters &parameters ) //!< I - generation parameters
+  : _parameters( parameters )
+{}
+
+
+/******************************************************************//**
+* \brief   Generate a `RGBA8` cone step map from the first channel of
+* an 8 bit image.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CConeStepMapGenerator::Generate(
+  size_t               cx,       //!< I - width of the image
+  size_t               cy,       //!< I - height of the image
+  size_t               channels, //!< I - number of channels of a texel (e.g. 3 for RGB)
+  size_t               bpl,      //!< I - bytes per line
+  const t_byte        *data,     //!< I - texels
+  std::vector<t_byte> &cone_map ) //!< O - tightly packed `RGBA8` cone step map
+  const
+{
+  if ( cx < 2 || cy < 2 || channels == 0 || bpl < cx * channels || data == nullptr )
+    return false;
+
+  size_t threads   = _parameters._threads;
+  size_t tile_rows = std::max( _parameters._tile_rows, (size_t)1 );
+  long   width     = (long)cx;
+  long   height    = (long)cy;
+
+  std::vector<t_byte> heights( cx * cy );
+  ParallelFor( 0, cy, 64, threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t y = begin; y < end; ++ y )
+    {
+      for ( size_t x = 0; x < cx; ++ x )
+        heights[y * cx + x] = data[y * bpl + x * channels];
+    }
+  } );
+
+  cone_map.resize( cx * cy * 4 );
+  ParallelFor( 0, cy, 64, threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t y = begin; y < end; ++ y )
+      DerivativesRow( heights.data(), width, height, (long)y, cone_map.data() + y * cx * 4 );
+  } );
+
+  if ( _parameters._simd == false )
+  {
+    ParallelFor( 0, cy, tile_rows, threads, [&]( size_t begin, size_t end )
+    {
+      for ( size_t y = begin; y < end; ++ y )
+      {
+        if ( _parameters._algorithm == TConeMapAlgorithm::circular )
+          CircularRowScalar( heights.data(), width, height, (long)y, cone_map.data() + y * cx * 4 );
+        else
+          SquareRingsRowScalar( heights.data(), width, height, (long)y, cone_map.data() + y * cx * 4 );
+      }
+    } );
+    return true;
+  }
+
+  // the circles reach 1 texture width; the square rings reach 1.1 texture widths
+  long margin = (long)(1.1 * std::max( width, height )) + 2 * c_lanes;
+  THeightPlane plane( heights, width, height, margin, tile_rows, threads );
+
+  std::unique_ptr<TMaxPyramid> pyramid;
+  if ( _parameters._pyramid )
+    pyramid = std::make_unique<TMaxPyramid>( heights, width, height );
+
+  if ( _parameters._algorithm == TConeMapAlgorithm::circular )
+  {
+    TCircles circles = CircleOffsets( width, height );
+    ParallelFor( 0, cy, tile_rows, threads, [&]( size_t begin, size_t end )
+    {
+      std::vector<const t_byte*> row_table;
+      for ( size_t y = begin; y < end; ++ y )
+        CircularRow( plane, pyramid.get(), circles, width, (long)y, row_table, cone_map.data() + y * cx * 4 );
+    } );
+  }
+  else
+  {
+    ParallelFor( 0, cy, tile_rows, threads, [&]( size_t begin, size_t end )
+    {
+      for ( size_t y = begin; y < end; ++ y )
+        SquareRingsRow( plane, pyramid.get(), width, height, (long)y, cone_map.data() + y * cx * 4 );
+    } );
+  }
+  return true;
+}
+
+
+} // Render
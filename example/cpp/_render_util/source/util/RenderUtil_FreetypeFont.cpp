@@ -11,18 +11,21 @@
 // includes
 
 #include "../../include/util/RenderUtil_FreetypeFont.h"
+#include "../../include/util/RenderUtil_GlyphSDF.h"
 #include "../../include/render/Render_IBuffer.h"
 
 
 // FREETYPE
 
 #include <ft2build.h>
-#include <freetype/ftstroke.h>
 #include FT_FREETYPE_H
+#include FT_OUTLINE_H
 
 
 // STL
 
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <iostream>
 
@@ -55,23 +58,6 @@ namespace Render
 //---------------------------------------------------------------------
 
 
-/******************************************************************//**
-* \brief   FreeType glyph metrics
-* 
-* \author  gernot
-* \date    2018-06-08
-* \version 1.0
-**********************************************************************/
-struct TFreetypeGlyph
-{
-  FT_Glyph_Metrics           _metrics { 0 }; //!< glyph metrics
-  unsigned int               _x       = 0;   //!< glyph start x
-  unsigned int               _y       = 0;   //!< glyph start y
-  unsigned int               _cx      = 0;   //!< glyph width
-  unsigned int               _cy      = 0;   //!< glyph height
-  std::vector<unsigned char> _image;         //!< image data
-};
-
 /******************************************************************//**
 * @brief   FreeType font data 
 *
@@ -83,46 +69,73 @@ struct TFreetypeTFont
 {
   FT_Library                  _hdl     = nullptr; //!< library handle
   FT_Face                     _face    = nullptr; //!< font face
-  FT_Stroker                  _stroker = nullptr; //!< Glyph Stroker - [https://www.freetype.org/freetype2/docs/reference/ft2-glyph_stroker.html#FT_Stroker]
-  unsigned int                _width         = 0; //!< total length 
-  unsigned int                _max_height    = 0; //!< maximum height
+  FT_Int32                    _load_flags    = FT_LOAD_DEFAULT; //!< glyph load flags
   int                         _max_glyph_cy  = 0; //!< maximum glyph metrics height 
   int                         _max_glyph_y   = 0; //!< maximum glyph metrics bearing y 
   int                         _min_char      = 0; //!< minimum character
-  int                         _max_char      = 0; //!< maximum character
-  std::vector<TFreetypeGlyph> _glyphs;           //!< glyph information
+  Render::CGlyphAtlas         _atlas;             //!< glyph atlas
+  std::vector<unsigned char>  _image;             //!< image data of the last rasterized glyph
+
+  TFreetypeTFont( const Render::TGlyphAtlasParameters &atlas_parameters )
+    : _atlas( atlas_parameters )
+  {}
+
+  ~TFreetypeTFont()
+  {
+    if ( _face != nullptr )
+      FT_Done_Face( _face );
+    if ( _hdl != nullptr )
+      FT_Done_FreeType( _hdl );
+  }
 };
 
 
-/******************************************************************//**
-* \brief   
-* 
-* \author  gernot
-* \date    2018-06-08
-* \version 1.0
-**********************************************************************/
-class TGlyphImage
-  : public Render::IImageResource
+namespace
 {
-public:
 
-  TGlyphImage( const TFreetypeGlyph &glyph )
-    : _glyph( glyph )
-  {}
 
-  virtual Render::TImageKind   Kind( void )      const override { return Render::TImageKind::diffuse; }
-  virtual Render::TTextureType Type( void )      const override { return Render::TTextureType::T2D; }
-  virtual Render::TImageFormat Format( void )    const override { return Render::TImageFormat::RGBA8; }
-  virtual Render::TTextureSize Size( void )      const override { return {_glyph._cx, _glyph._cy, 0}; }
-  virtual size_t               Layers( void )    const override { return 1; }
-  virtual size_t               BPL( void )       const override { return 4*_glyph._cx; }
-  virtual size_t               LineAlign( void ) const override { return 4; }
-  virtual const void *         DataPtr()         const override { return _glyph._image.data(); }                                 
+int OutlineMoveTo( const FT_Vector *to, void *user )
+{
+  static_cast<CGlyphOutline*>( user )->MoveTo( { to->x / 64.0f, to->y / 64.0f } );
+  return 0;
+}
 
-private:
 
-  const TFreetypeGlyph &_glyph;
-};
+int OutlineLineTo( const FT_Vector *to, void *user )
+{
+  static_cast<CGlyphOutline*>( user )->LineTo( { to->x / 64.0f, to->y / 64.0f } );
+  return 0;
+}
+
+
+int OutlineConicTo( const FT_Vector *control, const FT_Vector *to, void *user )
+{
+  static_cast<CGlyphOutline*>( user )->QuadraticTo( { control->x / 64.0f, control->y / 64.0f }, { to->x / 64.0f, to->y / 64.0f } );
+  return 0;
+}
+
+
+int OutlineCubicTo( const FT_Vector *control1, const FT_Vector *control2, const FT_Vector *to, void *user )
+{
+  static_cast<CGlyphOutline*>( user )->CubicTo( { control1->x / 64.0f, control1->y / 64.0f }, { control2->x / 64.0f, control2->y / 64.0f }, { to->x / 64.0f, to->y / 64.0f } );
+  return 0;
+}
+
+
+//! get the metrics of the current glyph of the face
+TGlyphMetrics GlyphMetrics( FT_GlyphSlot glyph )
+{
+  TGlyphMetrics metrics;
+  metrics._width     = (std::int32_t)glyph->metrics.width;
+  metrics._height    = (std::int32_t)glyph->metrics.height;
+  metrics._bearing_x = (std::int32_t)glyph->metrics.horiBearingX;
+  metrics._bearing_y = (std::int32_t)glyph->metrics.horiBearingY;
+  metrics._advance   = (std::int32_t)glyph->metrics.horiAdvance;
+  return metrics;
+}
+
+
+} // anonymous namespace
 
 
 /******************************************************************//**
@@ -133,10 +146,12 @@ private:
 * @version 1.0
 **********************************************************************/
 CFreetypeTexturedFont::CFreetypeTexturedFont( 
-  const char *font_filename,  //!< in: path of the font file 
-  int         min_char )      //!< in: first representable character in the font
+  const char                            *font_filename, //!< in: path of the font file 
+  int                                    min_char,      //!< in: first representable character in the font
+  const Render::TFreetypeFontParameters &parameters )   //!< in: glyph image and atlas parameters
   : _font_filename( font_filename )
   , _min_char( min_char )
+  , _parameters( parameters )
 {}
 
 
@@ -161,14 +176,47 @@ CFreetypeTexturedFont::~CFreetypeTexturedFont()
 void CFreetypeTexturedFont::Destroy( void )
 {
   _font.reset( nullptr );
-  _font_texture.reset( nullptr );
+  _loader = nullptr;
 
   // ...
 }
 
 
 /******************************************************************//**
-* @brief   Load the glyphs.
+* @brief   Glyph atlas of the font.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+const Render::CGlyphAtlas * CFreetypeTexturedFont::Atlas( void ) const
+{
+  return _font != nullptr ? &_font->_atlas : nullptr;
+}
+
+
+/******************************************************************//**
+* @brief   Kind of the glyph images.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+Render::TGlyphImage CFreetypeTexturedFont::GlyphImage( void ) const
+{
+  Render::TGlyphImage glyph_image;
+  glyph_image._type           = _parameters._glyph_image;
+  glyph_image._distance_range = _parameters._glyph_image == TGlyphImageType::bitmap ? 0.0f : _parameters._distance_range;
+  return glyph_image;
+}
+
+
+/******************************************************************//**
+* @brief   Load the font face.
+*
+* The glyphs are not rasterized, until they are used. The texture
+* loader is used to create and update the pages of the glyph atlas,
+* so it has to outlive the font.
 *
 * @author  gernot
 * @date    2018-03-18
@@ -180,10 +228,9 @@ bool CFreetypeTexturedFont::Load(
   if ( _font != nullptr )
     return _valid;
 
-  static bool create_stroke = false;
-
-  _font = std::make_unique<TFreetypeTFont>();
+  _font = std::make_unique<TFreetypeTFont>( _parameters._atlas );
   TFreetypeTFont &data = *_font.get();
+  _loader = &loader;
 
 
   // initialize FreeType library
@@ -203,184 +250,187 @@ bool CFreetypeTexturedFont::Load(
   }
   FT_Face face = _font->_face;
 
-  // create a stroker
-  if ( create_stroke )
-  {
-    err_code = FT_Stroker_New( _font->_hdl, &_font->_stroker );
-    if ( err_code != 0 )
-    {
-        std::cerr << "Failed to create the stroker (error code: " << err_code << ")" << std::endl;
-        throw std::runtime_error( "initialize FreeType library - stroker" );
-    }
-  }
-  FT_Stroker stroker = _font->_stroker;
-
-  // set font size
-  static FT_UInt pixel_width  = 0;
-  static FT_UInt pixel_height = 48;
+  // set font size; the outlines of distance field glyphs are not hinted, so that they scale linearly
+  FT_UInt pixel_width  = 0;
+  FT_UInt pixel_height = (FT_UInt)std::max( _parameters._pixel_height, (size_t)1 );
   err_code = FT_Set_Pixel_Sizes( face, pixel_width, pixel_height );
   if ( err_code != 0 )
   {          
     std::cout << "error: failed to set font size (error code: " << err_code << ")" << std::endl;
     throw std::runtime_error( "load font file" );
   }
+  if ( _parameters._glyph_image != TGlyphImageType::bitmap )
+    data._load_flags = FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING;
 
-  FT_GlyphSlot glyph = face->glyph;
-
-  // evaluate texture size  and metrics
+  // evaluate the reference metrics from the outlines of the basic latin characters, without rasterizing them
   // FreeType Glyph Conventions [https://www.freetype.org/freetype2/docs/glyphs/glyphs-3.html]
 
-  data._width    = 1;  
   data._min_char = _min_char;
-  data._max_char = 256;
-  data._glyphs  = std::vector<TFreetypeGlyph>( data._max_char - data._min_char );
-  for ( int i = data._min_char; i < data._max_char ; ++ i )
+  for ( int i = data._min_char; i < 128; ++ i )
   {
-    FT_Error err_code_glyph;
-    if ( create_stroke )
-      err_code_glyph = FT_Load_Char( face, i, FT_LOAD_NO_BITMAP | FT_LOAD_TARGET_NORMAL );
-    else
-      err_code_glyph = FT_Load_Char( face, i, FT_LOAD_RENDER ); // used before 
-    if ( err_code_glyph != 0 )
+    if ( FT_Load_Char( face, i, data._load_flags ) != 0 )
       continue;
+    data._max_glyph_cy = std::max( data._max_glyph_cy, (int)face->glyph->metrics.height );
+    data._max_glyph_y  = std::max( data._max_glyph_y,  (int)face->glyph->metrics.horiBearingY );
+  }
+  if ( data._max_glyph_cy == 0 )
+    data._max_glyph_cy = (int)face->size->metrics.height;
 
-    unsigned int cx = glyph->bitmap.width;
-    unsigned int cy = glyph->bitmap.rows;
+  _valid = data._max_glyph_cy > 0;
+  return _valid;
+}
 
-    TFreetypeGlyph &glyph_data = data._glyphs[i-data._min_char];
-    glyph_data._metrics = glyph->metrics;
-    glyph_data._x       = data._width;
-    glyph_data._y       = 1;
-    glyph_data._cx      = cx;
-    glyph_data._cy      = cy;
 
-    FT_Glyph glyphDescStroke;
-    err_code = FT_Get_Glyph( glyph, &glyphDescStroke );
-    if ( err_code != 0 )
-      continue;
+/******************************************************************//**
+* @brief   Add the glyphs of a text to the atlas in advance, e.g. at
+* the startup of an application.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+bool CFreetypeTexturedFont::LoadGlyphs( 
+  t_s_param str ) //!< in: the characters
+{
+  if ( _font == nullptr )
+    return false;
 
-    if ( create_stroke )
-    {
-      static double outlineThickness = 2.0;
-      FT_Stroker_Set( stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0 );
-      err_code = FT_Glyph_Stroke( &glyphDescStroke, stroker, true );
-      if ( err_code != 0 )
-        continue;
-
-      err_code = FT_Glyph_To_Bitmap( &glyphDescStroke, FT_RENDER_MODE_NORMAL, 0, 1);
-      if ( err_code != 0 )
-        continue;
-    }
+  _font->_atlas.BeginUse();
+  DecodeUTF8( str, _codepoints );
+  AddGlyphs();
+  return true;
+}
 
-    //FT_Bitmap     *bitmap = &glyph->bitmap;
-    FT_BitmapGlyph glyph_bitmap = (FT_BitmapGlyph)glyphDescStroke;
-    FT_Bitmap     *bitmap = create_stroke ? &glyph_bitmap->bitmap : &glyph->bitmap;
-                                                                   
-    cx = bitmap->width;
-    cy = bitmap->rows;
-    glyph_data._cx = cx;
-    glyph_data._cy = cy;
-
-    // TODO $$$ use ox and oy instead of `glyph->metrics`?
-    unsigned int ox = glyph_bitmap->left;
-    unsigned int oy = glyph_bitmap->top;
-    unsigned int ax = face->glyph->advance.x;
-      
-    if ( bitmap->buffer == nullptr )
-      continue;
 
-    glyph_data._image = std::vector<unsigned char>( cx * cy * 4, 0 );
-    for ( unsigned int i = 0; i < cx * cy; ++ i)
-    {
-      unsigned char b = bitmap->buffer[i];
-      unsigned char b_2 = (unsigned char)( b / 2 );
-      glyph_data._image[i*4 + 0] = create_stroke ? b_2 : b;
-      glyph_data._image[i*4 + 1] = create_stroke ? b_2 : b;
-      glyph_data._image[i*4 + 2] = create_stroke ? b_2 : b;
-      glyph_data._image[i*4 + 3] = b;
-    }
+/******************************************************************//**
+* @brief   Add the glyphs of the decoded text, which are not in the
+* atlas yet.
+*
+* The FreeType face is not thread safe, so the outlines are loaded
+* one after the other. The distance fields of all the new glyphs are
+* generated in parallel and finally packed to the atlas.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+void CFreetypeTexturedFont::AddGlyphs( void )
+{
+  TFreetypeTFont &data = *_font.get();
+
+  // find the new glyphs; `Find` marks the glyphs, which are in the atlas, as used
+  _new_codepoints.clear();
+  for ( char32_t c : _codepoints )
+  {
+    if ( c >= (char32_t)data._min_char && data._atlas.Find( c ) == nullptr )
+      _new_codepoints.push_back( c );
+  }
+  if ( _new_codepoints.empty() )
+    return;
+  std::sort( _new_codepoints.begin(), _new_codepoints.end() );
+  _new_codepoints.erase( std::unique( _new_codepoints.begin(), _new_codepoints.end() ), _new_codepoints.end() );
 
-    FT_Done_Glyph( glyphDescStroke );
+  if ( _parameters._glyph_image == TGlyphImageType::bitmap )
+  {
+    for ( char32_t c : _new_codepoints )
+      AddBitmapGlyph( c );
+    return;
+  }
 
-    if ( create_stroke )
+  // load the outlines
+  FT_Face      face  = data._face;
+  FT_GlyphSlot glyph = face->glyph;
+  FT_Outline_Funcs funcs{ OutlineMoveTo, OutlineLineTo, OutlineConicTo, OutlineCubicTo, 0, 0 };
+
+  std::vector<Render::TGlyphMetrics> metrics;
+  std::vector<Render::CGlyphOutline> outlines;
+  std::vector<char32_t>              codepoints;
+  metrics.reserve( _new_codepoints.size() );
+  outlines.reserve( _new_codepoints.size() );
+  codepoints.reserve( _new_codepoints.size() );
+  for ( char32_t c : _new_codepoints )
+  {
+    if ( FT_Load_Char( face, c, data._load_flags ) != 0 )
+      continue;
+    codepoints.push_back( c );
+    metrics.push_back( GlyphMetrics( glyph ) );
+    outlines.emplace_back();
+    if ( glyph->format == FT_GLYPH_FORMAT_OUTLINE )
     {
-      FT_Glyph glyphDescFill;
-      err_code = FT_Get_Glyph( glyph, &glyphDescFill );
-      if ( err_code == 0 )
-        err_code = FT_Glyph_To_Bitmap( &glyphDescFill, FT_RENDER_MODE_NORMAL, 0, 1);
-
-      FT_Bitmap *bitmap = nullptr;
-      if ( err_code == 0 )
-      {
-        FT_BitmapGlyph glyph_bitmap = (FT_BitmapGlyph)glyphDescFill;
-        bitmap = &glyph_bitmap->bitmap;
-      }
-
-      if ( err_code == 0 && bitmap )
-      {
-        unsigned int cx_fill = bitmap->width;
-        unsigned int cy_fill = bitmap->rows;
-        unsigned int offset_x = (cx - cx_fill) / 2;
-        unsigned int offset_y = (cy - cy_fill) / 2;
-
-        for ( unsigned int y = 0; y < cy_fill; ++ y )
-        {
-          for ( unsigned int x = 0; x < cx_fill; ++ x )
-          {
-            unsigned int i_source = y * cx_fill + x;
-            unsigned int i_target = (y + offset_y) * cx + x + offset_x;
-            unsigned char b = bitmap->buffer[i_source];
-            unsigned char b_2 = (unsigned char)( b / 2 );
-            
-            glyph_data._image[i_target*4]   = std::max( glyph_data._image[i_target*4], b);
-            glyph_data._image[i_target*4+1] = std::max( glyph_data._image[i_target*4+1], b);
-            glyph_data._image[i_target*4+2] = std::max( glyph_data._image[i_target*4+2], b);
-            glyph_data._image[i_target*4+3] = std::max( glyph_data._image[i_target*4+3], b);         
-          }
-        }
-      }
-
-      FT_Done_Glyph( glyphDescFill );
+      FT_Outline_Decompose( &glyph->outline, &funcs, &outlines.back() );
+      outlines.back().Close();
     }
-    
-    data._width      += cx+1;
-    data._max_height  = std::max( data._max_height, cy );
-
-    data._max_glyph_cy = std::max( data._max_glyph_cy, (int)glyph->metrics.height );
-    data._max_glyph_y  = std::max( data._max_glyph_y,  (int)glyph->metrics.horiBearingY );
   }
-  data._max_height += 2;
 
-  // create texture
+  // generate the distance fields
+  Render::TDistanceFieldParameters sdf_parameters;
+  sdf_parameters._type    = _parameters._glyph_image;
+  sdf_parameters._range   = _parameters._distance_range;
+  sdf_parameters._threads = _parameters._threads;
+  std::vector<Render::TDistanceFieldImage> images;
+  Render::CDistanceFieldGenerator( sdf_parameters ).Generate( outlines, images );
 
-  Render::TTextureSize size{ data._width, data._max_height, 1 };
-  Render::TStandardTextureKind std_kind = Render::T2D_RGBA_clamped_bilinear;
-  //Render::TStandardTextureKind std_kind = Render::T2D_RGBA_clamped_trilinear; // may cause disappearing of text at huge minification
-  _font_texture = loader.CreateTexture(size, 0, std_kind); 
+  // add the glyphs to the atlas
+  for ( size_t i = 0; i < codepoints.size(); ++ i )
+  {
+    const Render::TDistanceFieldImage &image = images[i];
+    metrics[i]._image_left = (std::int32_t)image._left * 64;
+    metrics[i]._image_top  = (std::int32_t)image._top * 64;
+    if ( data._atlas.Insert( codepoints[i], metrics[i], image._cx, image._cy, image._rgba.data(), image._cx * 4 ) == nullptr )
+      std::cout << "warning: glyph atlas is full (code point " << (unsigned int)codepoints[i] << ")" << std::endl;
+  }
+}
 
 
-  // load glyphs and copy glyphs to texture
+/******************************************************************//**
+* @brief   Rasterize a bitmap glyph and add it to the atlas.
+*
+* @author  gernot
+* @date    2026-10-18
+* @version 1.0
+**********************************************************************/
+void CFreetypeTexturedFont::AddBitmapGlyph( 
+  char32_t codepoint ) //!< in: unicode code point
+{
+  TFreetypeTFont &data  = *_font.get();
+  FT_Face         face  = data._face;
+  FT_GlyphSlot    glyph = face->glyph;
 
+  if ( FT_Load_Char( face, codepoint, data._load_flags | FT_LOAD_RENDER ) != 0 )
+    return;
 
-  // $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$
-  // TODO $$$ load fonts in different resolutions to mipmap layers
-  // $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$
+  Render::TGlyphMetrics metrics = GlyphMetrics( glyph );
+  metrics._image_left = (std::int32_t)glyph->bitmap_left * 64;
+  metrics._image_top  = (std::int32_t)glyph->bitmap_top * 64;
 
-  for ( int i = data._min_char; i < data._max_char; ++ i )
+  FT_Bitmap   *bitmap = &glyph->bitmap;
+  unsigned int cx     = bitmap->width;
+  unsigned int cy     = bitmap->rows;
+  if ( bitmap->buffer == nullptr || cx == 0 || cy == 0 )
   {
-    TFreetypeGlyph &glyph_data = data._glyphs[i-data._min_char];
-    if ( glyph_data._cx == 0 || glyph_data._cy == 0 )
-      continue;
-
-    TGlyphImage image( glyph_data );
-    Render::TTexturePoint pos{ glyph_data._x, glyph_data._y, 0 };
-    loader.LoadToTexture( image, *_font_texture, pos, 0 );
+    data._atlas.Insert( codepoint, metrics, 0, 0, nullptr, 0 );
+    return;
   }
 
-  _font_texture->Release( 0 );
+  // premultiplied alpha
+  std::vector<unsigned char> &image = data._image;
+  image.assign( cx * cy * 4, 0 );
+  for ( unsigned int y = 0; y < cy; ++ y )
+  {
+    const unsigned char *source = bitmap->buffer + y * bitmap->pitch;
+    for ( unsigned int x = 0; x < cx; ++ x )
+    {
+      unsigned int  i = y * cx + x;
+      unsigned char b = source[x];
+      image[i*4 + 0] = b;
+      image[i*4 + 1] = b;
+      image[i*4 + 2] = b;
+      image[i*4 + 3] = b;
+    }
+  }
 
-  _valid = true;
-  return _valid;
+  if ( data._atlas.Insert( codepoint, metrics, cx, cy, image.data(), cx * 4 ) == nullptr )
+    std::cout << "warning: glyph atlas is full (code point " << (unsigned int)codepoint << ")" << std::endl;
 }
 
 
@@ -402,24 +452,24 @@ bool CFreetypeTexturedFont::CalculateTextSize(
   if ( _font == nullptr )
     return false;
 
-  int min_c = _font->_min_char;
-  int max_c = _font->_max_char;
-
-  std::string std_str( str );
+  _font->_atlas.BeginUse();
+  DecodeUTF8( str, _codepoints );
+  AddGlyphs();
   FT_Pos metrics_width  = 0;
   FT_Pos metrics_height = 0;
   FT_Pos metrics_top    = 0;
-  for ( char c : std_str )
+  for ( char32_t c : _codepoints )
   {
     // get the glyph data
-    int i_c = *(unsigned char*)(&c);
-    if ( i_c < min_c || i_c > max_c )
+    if ( c < (char32_t)_font->_min_char )
+      continue;
+    const Render::TAtlasGlyph *glyph = _font->_atlas.Find( c );
+    if ( glyph == nullptr )
       continue;
-    TFreetypeGlyph &glyph = _font->_glyphs[i_c-min_c];
     
-    metrics_width += glyph._metrics.horiAdvance;
-    metrics_height = std::max( metrics_height, glyph._metrics.height );
-    metrics_top    = std::max( metrics_top, glyph._metrics.horiBearingY );
+    metrics_width += glyph->_metrics._advance;
+    metrics_height = std::max( metrics_height, (FT_Pos)glyph->_metrics._height );
+    metrics_top    = std::max( metrics_top, (FT_Pos)glyph->_metrics._bearing_y );
   }
 
   float scale = height / (float)_font->_max_glyph_cy;
@@ -433,87 +483,171 @@ bool CFreetypeTexturedFont::CalculateTextSize(
 
 
 /******************************************************************//**
-* \brief   render a text 
+* \brief   Create the glyph quads of a text for retained drawing.
+*
+* The glyphs, which are not yet in the atlas, are rasterized and the
+* modified regions of the atlas pages are uploaded. The quads are
+* relative to the reference position and grouped by the atlas pages.
+* The layout stays valid as long as the revision of the atlas doesn't
+* change (see `LayoutRevision`).
 * 
 * \author  gernot
-* \date    2018-03-18
+* \date    2026-10-18
 * \version 1.0
 **********************************************************************/
-bool CFreetypeTexturedFont::Draw( 
-  Render::IDrawBufferProvider &buffer_provider,   //!< in: draw library
-  size_t                       textur_binding_id, //!< in: texture unit index
-  t_s_param                    str,               //!< in: the text
-  float                        height,            //!< in: the maximum height of the text from the bottom to the top 
-  float                        width_scale,       //!< in: scale of the text in the y direction
-  const Render::TPoint3       &pos )              //!< in: the reference position
+bool CFreetypeTexturedFont::Layout( 
+  t_s_param            str,         //!< in: the text
+  float                height,      //!< in: the maximum height of the text from the bottom to the top 
+  float                width_scale, //!< in: scale of the text in the y direction
+  Render::TTextLayout &layout )     //!< out: glyph quads
 {
-  static bool debug_test = false;
-  if ( debug_test )
-    DebugFontTexture( buffer_provider, textur_binding_id );
-
-  if ( _font == nullptr  || _font_texture == nullptr )
+  layout._vertices.clear();
+  layout._page_start.assign( 1, 0 );
+  layout._textures.clear();
+  if ( _font == nullptr || _loader == nullptr )
     return false;
 
-  int min_c = _font->_min_char;
-  int max_c = _font->_max_char;
+  Render::CGlyphAtlas &atlas = _font->_atlas;
 
   float scale_y = height / (float)_font->_max_glyph_cy;
   float scale_x = scale_y * width_scale;
 
-  // set up vertex coordinate attribute array
+  // get the glyphs; the glyphs of this text are not evicted while the text is laid out
+  atlas.BeginUse();
+  DecodeUTF8( str, _codepoints );
+  AddGlyphs();
+  std::vector<const Render::TAtlasGlyph*> glyphs;
+  glyphs.reserve( _codepoints.size() );
+  for ( char32_t c : _codepoints )
+  {
+    if ( c < (char32_t)_font->_min_char )
+      continue;
+    if ( const Render::TAtlasGlyph *glyph = atlas.Find( c ) )
+      glyphs.push_back( glyph );
+  }
+
+  // upload the new glyphs
+  atlas.Upload( *_loader );
+  layout._revision = atlas.Revision();
 
-  std::string std_str( str );
+  // set up vertex coordinate attribute array, grouped by the atlas pages
+
+  float page_size = (float)atlas.PageSize();
   FT_Pos metrics_width  = 0;
-  std::vector<float> vertex_attributes; // x y z u v
-  vertex_attributes.reserve( 5 * 6 * std_str.length() );
-  for ( char c : std_str )
+  std::vector<std::vector<float>> page_attributes( atlas.Pages() ); // x y z u v
+  for ( const Render::TAtlasGlyph *glyph_ptr : glyphs )
   {
-    // get the glyph data
-    int i_c = *(unsigned char*)(&c);
-    if ( i_c < min_c || i_c > max_c )
-      continue;
-    TFreetypeGlyph &glyph = _font->_glyphs[i_c-min_c];
+    const Render::TAtlasGlyph &glyph = *glyph_ptr;
     
-    // calculate font metrics vertex coordinate box
+    // calculate glyph image vertex coordinate box
     FT_Pos metrics_coord[]{
-      metrics_width + glyph._metrics.horiBearingX,                        // min x
-      glyph._metrics.horiBearingY - glyph._metrics.height,                // min y
-      metrics_width + glyph._metrics.horiBearingX + glyph._metrics.width, // max x
-      glyph._metrics.horiBearingY                                         // max y
+      metrics_width + glyph._metrics._image_left,                         // min x
+      glyph._metrics._image_top - (FT_Pos)glyph._cy * 64,                 // min y
+      metrics_width + glyph._metrics._image_left + (FT_Pos)glyph._cx * 64, // max x
+      glyph._metrics._image_top                                           // max y
     };
 
     // increment width to the start of the next glyph
-    metrics_width += glyph._metrics.horiAdvance;
+    metrics_width += glyph._metrics._advance;
 
-    if ( glyph._metrics.width == 0 || glyph._metrics.height == 0 )
+    if ( glyph._metrics._width == 0 || glyph._metrics._height == 0 || glyph._page == Render::TAtlasGlyph::no_page )
       continue;
 
     // calculate vertex coordinate box
     float glyph_coords[]{
-      pos[0] + scale_x * (float)metrics_coord[0], pos[1] + scale_y * (float)metrics_coord[1],
-      pos[0] + scale_x * (float)metrics_coord[2], pos[1] + scale_y * (float)metrics_coord[3]
+      scale_x * (float)metrics_coord[0], scale_y * (float)metrics_coord[1],
+      scale_x * (float)metrics_coord[2], scale_y * (float)metrics_coord[3]
     };
 
     // calculate texture coordinates box
     float glyph_tex_coords[]{
-      (float)glyph._x / (float)_font->_width,
-      (float)(glyph._y + glyph._cy) / (float)_font->_max_height,
-      (float)(glyph._x + glyph._cx) / (float)_font->_width,
-      (float)glyph._y / (float)_font->_max_height,
+      (float)glyph._x / page_size,
+      (float)(glyph._y + glyph._cy) / page_size,
+      (float)(glyph._x + glyph._cx) / page_size,
+      (float)glyph._y / page_size,
     };
 
     // set up vertex attribute array
     std::array<std::array<float, 5>, 4> quad{
-      std::array<float, 5>{ glyph_coords[0], glyph_coords[1], pos[2], glyph_tex_coords[0], glyph_tex_coords[1] },
-      std::array<float, 5>{ glyph_coords[2], glyph_coords[1], pos[2], glyph_tex_coords[2], glyph_tex_coords[1] },
-      std::array<float, 5>{ glyph_coords[2], glyph_coords[3], pos[2], glyph_tex_coords[2], glyph_tex_coords[3] },
-      std::array<float, 5>{ glyph_coords[0], glyph_coords[3], pos[2], glyph_tex_coords[0], glyph_tex_coords[3] }
+      std::array<float, 5>{ glyph_coords[0], glyph_coords[1], 0.0f, glyph_tex_coords[0], glyph_tex_coords[1] },
+      std::array<float, 5>{ glyph_coords[2], glyph_coords[1], 0.0f, glyph_tex_coords[2], glyph_tex_coords[1] },
+      std::array<float, 5>{ glyph_coords[2], glyph_coords[3], 0.0f, glyph_tex_coords[2], glyph_tex_coords[3] },
+      std::array<float, 5>{ glyph_coords[0], glyph_coords[3], 0.0f, glyph_tex_coords[0], glyph_tex_coords[3] }
     };
     std::array<int, 6> indices{ 0, 1, 2, 0, 2, 3 };
+    std::vector<float> &vertex_attributes = page_attributes[glyph._page];
     for ( auto i : indices )
       vertex_attributes.insert( vertex_attributes.end(), quad[i].begin(), quad[i].end() );
   }
 
+  // concatenate the pages
+  layout._page_start.assign( page_attributes.size() + 1, 0 );
+  layout._textures.resize( page_attributes.size() );
+  for ( size_t page = 0; page < page_attributes.size(); ++ page )
+  {
+    layout._vertices.insert( layout._vertices.end(), page_attributes[page].begin(), page_attributes[page].end() );
+    layout._page_start[page + 1] = layout._vertices.size() / 5; // 5 because of x y z u v
+    layout._textures[page] = atlas.PageTexture( page );
+  }
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Revision of the glyph atlas.
+* 
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::uint64_t CFreetypeTexturedFont::LayoutRevision( void ) const
+{
+  return _font != nullptr ? _font->_atlas.Revision() : 0;
+}
+
+
+/******************************************************************//**
+* \brief   render a text 
+*
+* The glyphs, which are not yet in the atlas, are rasterized and the
+* modified regions of the atlas pages are uploaded, before the text is
+* drawn. Distance field glyphs have to be drawn with a shader, which
+* evaluates the distance (see `GlyphImage`). The glyph quads are grouped by the atlas pages, so there is
+* one draw call for each page.
+*
+* Texts, which are drawn repeatedly, should be retained in a
+* `CTextMeshCache` instead, which skips the layout and the upload.
+* 
+* \author  gernot
+* \date    2018-03-18
+* \version 1.0
+**********************************************************************/
+bool CFreetypeTexturedFont::Draw( 
+  Render::IDrawBufferProvider &buffer_provider,   //!< in: draw library
+  size_t                       textur_binding_id, //!< in: texture unit index
+  t_s_param                    str,               //!< in: the text
+  float                        height,            //!< in: the maximum height of the text from the bottom to the top 
+  float                        width_scale,       //!< in: scale of the text in the y direction
+  const Render::TPoint3       &pos )              //!< in: the reference position
+{
+  static bool debug_test = false;
+  if ( debug_test )
+    DebugFontTexture( buffer_provider, textur_binding_id );
+
+  Render::TTextLayout &layout = _layout;
+  if ( Layout( str, height, width_scale, layout ) == false )
+    return false;
+  if ( layout._vertices.empty() )
+    return true;
+
+  // move the quads to the reference position
+  for ( size_t i = 0; i < layout._vertices.size(); i += 5 )
+  {
+    layout._vertices[i]   += pos[0];
+    layout._vertices[i+1] += pos[1];
+    layout._vertices[i+2] += pos[2];
+  }
+
   // buffer specification
   Render::TVA va_id = Render::TVA::b0_xyz_uv;
   const std::vector<char> bufferdescr = Render::IDrawBuffer::VADescription( va_id );
@@ -521,32 +655,28 @@ bool CFreetypeTexturedFont::Draw(
   // create buffer
   Render::IDrawBuffer &buffer = buffer_provider.DrawBuffer();
   buffer.SpecifyVA( bufferdescr.size(), bufferdescr.data() );
-  buffer.UpdateVB( 0, sizeof(float), vertex_attributes.size(), vertex_attributes.data() );
-  
-  // bind glyph texture 
-  _font_texture->Bind( textur_binding_id );
+  buffer.UpdateVB( 0, sizeof(float), layout._vertices.size(), layout._vertices.data() );
 
+  // draw_buffer, one draw call for each atlas page
+  for ( size_t page = 0; page < layout._textures.size(); ++ page )
+  {
+    size_t no_of_vertices = layout._page_start[page + 1] - layout._page_start[page];
+    if ( no_of_vertices == 0 )
+      continue;
 
-  /*
-  TODO $$$
-
-  font shader
-
-  - SSBO font metrics
-  - SSBO (dynamic array) glyph indices
-  - atomic font position 
-  - instance render quad (number of letter) 
+    // bind glyph texture 
+    Render::ITexture *texture = layout._textures[page];
+    if ( texture == nullptr )
+      continue;
+    texture->Bind( textur_binding_id );
 
-  */
+    buffer.DrawArray( Render::TPrimitive::triangles, layout._page_start[page], no_of_vertices, true ); // TODO Render::TPrimitive::trianglestrip + indices / primitive restart
 
-  // draw_buffer
-  size_t no_of_vertices = vertex_attributes.size() / 5; // 5 because of x y z u v
-  buffer.DrawArray( Render::TPrimitive::triangles, 0, no_of_vertices, true ); // TODO Render::TPrimitive::trianglestrip + indices / primitive restart
+    // unbind glyph texture
+    texture->Release( textur_binding_id );
+  }
   buffer.Release();
 
-  // unbind glyph texture
-  _font_texture->Release( textur_binding_id );
-
   return true;
 }
 
@@ -562,15 +692,13 @@ void CFreetypeTexturedFont::DebugFontTexture(
   Render::IDrawBufferProvider &buffer_provider,     //!< in: draw library
   size_t                       textur_binding_id ) //!< in: texture unit index
 {
-  if ( _font == nullptr || _font_texture == nullptr )
+  Render::ITexture *texture = _font != nullptr ? _font->_atlas.PageTexture( 0 ) : nullptr;
+  if ( texture == nullptr )
     return;
 
-  int min_c = _font->_min_char;
-  int max_c = _font->_max_char;
-
   float t_0 = 0.0;
-  float t_1 = 0.4f;
-  float h = 10.0f * (float)_font->_max_height / (float)_font->_width;
+  float t_1 = 1.0f;
+  float h = 2.0f;
 
   // setup vertex attributes (x y z u v)
   std::vector<float> vertex_attributes{
@@ -593,7 +721,7 @@ void CFreetypeTexturedFont::DebugFontTexture(
   buffer.UpdateVB( 0, sizeof(float), vertex_attributes.size(), vertex_attributes.data() );
   
   // bind glyph texture 
-  _font_texture->Bind( textur_binding_id );
+  texture->Bind( textur_binding_id );
 
   // draw_buffer
   size_t no_of_vertices = vertex_attributes.size() / 5; // 5 because of x y z u v
@@ -601,7 +729,7 @@ void CFreetypeTexturedFont::DebugFontTexture(
   buffer.Release();
 
   // unbind glyph texture
-  _font_texture->Release( textur_binding_id );
+  texture->Release( textur_binding_id );
 }
 
 
@@ -0,0 +1,564 @@
+/******************************************************************//**
+* \brief   Dynamic glyph atlas with skyline packing.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_GlyphAtlas.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cstring>
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+/******************************************************************//**
+* \brief   Image resource view of a region of a RGBA8 atlas page.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+class CPageRegionImage
+  : public IImageResource
+{
+public:
+
+  CPageRegionImage( const t_byte *data, size_t page_cx, size_t cx, size_t cy )
+    : _data( data )
+    , _page_cx( page_cx )
+    , _cx( cx )
+    , _cy( cy )
+  {}
+
+  virtual TImageKind   Kind( void )      const override { return TImageKind::diffuse; }
+  virtual TTextureType Type( void )      const override { return TTextureType::T2D; }
+  virtual TImageFormat Format( void )    const override { return TImageFormat::RGBA8; }
+  virtual TTextureSize Size( void )      const override { return { _cx, _cy, 1 }; }
+  virtual size_t       Layers( void )    const override { return 1; }
+  virtual size_t       BPL( void )       const override { return _page_cx * 4; }
+  virtual size_t       LineAlign( void ) const override { return 4; }
+  virtual const void * DataPtr( void )   const override { return _data; }
+
+private:
+
+  const t_byte *_data;
+  size_t        _page_cx;
+  size_t        _cx;
+  size_t        _cy;
+};
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   Decode an UTF-8 string to unicode code points.
+*
+* Invalid, overlong and truncated sequences are replaced by U+FFFD.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void DecodeUTF8(
+  std::string_view       str,         //!< in: UTF-8 encoded string
+  std::vector<char32_t> &codepoints ) //!< out: unicode code points
+{
+  const char32_t replacement = 0xFFFD;
+  codepoints.clear();
+  codepoints.reserve( str.size() );
+  for ( size_t i = 0; i < str.size(); )
+  {
+    unsigned char c = (unsigned char)str[i];
+    size_t   length = c < 0x80 ? 1 : ( c >> 5 ) == 0x06 ? 2 : ( c >> 4 ) == 0x0E ? 3 : ( c >> 3 ) == 0x1E ? 4 : 0;
+    char32_t cp     = length == 1 ? c : length == 2 ? c & 0x1F : length == 3 ? c & 0x0F : c & 0x07;
+    if ( length == 0 || i + length > str.size() )
+    {
+      codepoints.push_back( replacement );
+      ++ i;
+      continue;
+    }
+
+    bool valid = true;
+    for ( size_t j = 1; j < length && valid; ++ j )
+    {
+      unsigned char cc = (unsigned char)str[i + j];
+      valid = ( cc & 0xC0 ) == 0x80;
+      cp = ( cp << 6 ) | ( cc & 0x3F );
+    }
+    static const char32_t min_cp[]{ 0, 0, 0x80, 0x800, 0x10000 };
+    if ( valid == false || cp < min_cp[length] || cp > 0x10FFFF || ( cp >= 0xD800 && cp <= 0xDFFF ) )
+    {
+      codepoints.push_back( replacement );
+      ++ i;
+      continue;
+    }
+    codepoints.push_back( cp );
+    i += length;
+  }
+}
+
+
+//---------------------------------------------------------------------
+// CSkylinePacker
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   Remove all rectangles.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSkylinePacker::Reset(
+  size_t cx,  //!< in: width of the area
+  size_t cy ) //!< in: height of the area
+{
+  _cx        = cx;
+  _cy        = cy;
+  _used_area = 0;
+  _skyline.assign( 1, TSegment{ 0, 0, cx } );
+}
+
+
+/******************************************************************//**
+* \brief   Top of a rectangle, which is placed at the start of a
+* segment of the skyline.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CSkylinePacker::Fit(
+  size_t  index, //!< in: index of the segment
+  size_t  cx,    //!< in: width of the rectangle
+  size_t  cy,    //!< in: height of the rectangle
+  size_t &y )    //!< out: bottom of the rectangle
+  const
+{
+  size_t x = _skyline[index]._x;
+  if ( x + cx > _cx )
+    return false;
+
+  y = 0;
+  for ( size_t remaining = cx; remaining > 0; ++ index )
+  {
+    y = std::max( y, _skyline[index]._y );
+    if ( y + cy > _cy )
+      return false;
+    remaining -= std::min( remaining, _skyline[index]._cx );
+  }
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Pack a rectangle.
+*
+* \return  false, if the rectangle doesn't fit
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CSkylinePacker::Insert(
+  size_t  cx, //!< in: width of the rectangle
+  size_t  cy, //!< in: height of the rectangle
+  size_t &x,  //!< out: left of the rectangle
+  size_t &y ) //!< out: bottom of the rectangle
+{
+  if ( cx == 0 || cy == 0 || cx > _cx || cy > _cy )
+    return false;
+
+  // find the best position: lowest top, then least width of the segment
+  size_t best_index = _skyline.size();
+  size_t best_top   = (size_t)-1;
+  size_t best_width = (size_t)-1;
+  for ( size_t i = 0; i < _skyline.size(); ++ i )
+  {
+    size_t fit_y;
+    if ( Fit( i, cx, cy, fit_y ) == false )
+      continue;
+    size_t top = fit_y + cy;
+    if ( top < best_top || ( top == best_top && _skyline[i]._cx < best_width ) )
+    {
+      best_index = i;
+      best_top   = top;
+      best_width = _skyline[i]._cx;
+      y          = fit_y;
+    }
+  }
+  if ( best_index == _skyline.size() )
+    return false;
+
+  x = _skyline[best_index]._x;
+
+  // insert the new segment and shrink or remove the covered segments
+  _skyline.insert( _skyline.begin() + best_index, TSegment{ x, best_top, cx } );
+  for ( size_t i = best_index + 1; i < _skyline.size(); )
+  {
+    TSegment &prev    = _skyline[i - 1];
+    TSegment &segment = _skyline[i];
+    size_t    prev_end = prev._x + prev._cx;
+    if ( segment._x >= prev_end )
+      break;
+    size_t shrink = prev_end - segment._x;
+    if ( shrink < segment._cx )
+    {
+      segment._x  += shrink;
+      segment._cx -= shrink;
+      break;
+    }
+    _skyline.erase( _skyline.begin() + i );
+  }
+
+  // merge segments with the same height
+  for ( size_t i = 1; i < _skyline.size(); )
+  {
+    if ( _skyline[i - 1]._y == _skyline[i]._y )
+    {
+      _skyline[i - 1]._cx += _skyline[i]._cx;
+      _skyline.erase( _skyline.begin() + i );
+    }
+    else
+      ++ i;
+  }
+
+  _used_area += cx * cy;
+  return true;
+}
+
+
+//---------------------------------------------------------------------
+// CGlyphAtlas
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CGlyphAtlas::CGlyphAtlas(
+  const TGlyphAtlasParameters &parameters ) //!< in: atlas parameters
+  : _parameters( parameters )
+{}
+
+
+/******************************************************************//**
+* \brief   Remove all glyphs and pages.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGlyphAtlas::Clear( void )
+{
+  _glyphs.clear();
+  _pages.clear();
+  ++ _revision;
+}
+
+
+/******************************************************************//**
+* \brief   Find a glyph and mark it as used.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+const TAtlasGlyph * CGlyphAtlas::Find(
+  char32_t codepoint ) //!< in: unicode code point
+{
+  auto it = _glyphs.find( codepoint );
+  if ( it == _glyphs.end() )
+    return nullptr;
+
+  TAtlasGlyph &glyph = it->second;
+  glyph._last_use = _generation;
+  if ( glyph._page != TAtlasGlyph::no_page )
+    _pages[glyph._page]._last_use = _generation;
+  return &glyph;
+}
+
+
+/******************************************************************//**
+* \brief   Add a glyph image to the atlas and mark it as used.
+*
+* A glyph without an image (`cx` or `cy` is 0) only stores the
+* metrics.
+*
+* \return  nullptr, if there is no space left in the atlas
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+const TAtlasGlyph * CGlyphAtlas::Insert(
+  char32_t             codepoint, //!< in: unicode code point
+  const TGlyphMetrics &metrics,   //!< in: glyph metrics
+  size_t               cx,        //!< in: width of the glyph image
+  size_t               cy,        //!< in: height of the glyph image
+  const t_byte        *rgba,      //!< in: RGBA8 texels of the glyph image
+  size_t               bpl )      //!< in: bytes per line of the glyph image
+{
+  TAtlasGlyph glyph;
+  glyph._metrics  = metrics;
+  glyph._last_use = _generation;
+
+  if ( cx > 0 && cy > 0 && rgba != nullptr )
+  {
+    size_t page, x, y;
+    if ( Allocate( cx, cy, page, x, y ) == false )
+      return nullptr;
+
+    TPage &target    = _pages[page];
+    size_t page_size = _parameters._page_size;
+    for ( size_t row = 0; row < cy; ++ row )
+      std::memcpy( target._image.data() + ( ( y + row ) * page_size + x ) * 4, rgba + row * bpl, cx * 4 );
+    AddDirty( target, x, y, x + cx, y + cy );
+    target._last_use = _generation;
+
+    glyph._page = page;
+    glyph._x    = x;
+    glyph._y    = y;
+    glyph._cx   = cx;
+    glyph._cy   = cy;
+  }
+
+  TAtlasGlyph &stored = _glyphs[codepoint];
+  stored = glyph;
+  return &stored;
+}
+
+
+/******************************************************************//**
+* \brief   Create the page textures and upload the modified region of
+* each page.
+*
+* All the glyphs, which have been added to a page since the last
+* upload, are uploaded with a single sub image upload.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CGlyphAtlas::Upload(
+  ITextureLoader &loader ) //!< in: texture loader
+{
+  size_t page_size = _parameters._page_size;
+  bool   success   = true;
+  for ( auto &page : _pages )
+  {
+    if ( page._texture == nullptr )
+    {
+      page._texture = loader.CreateTexture( { page_size, page_size, 1 }, 0, _parameters._texture );
+      if ( page._texture == nullptr )
+      {
+        success = false;
+        continue;
+      }
+      AddDirty( page, 0, 0, page_size, page_size );
+    }
+
+    auto &dirty = page._dirty;
+    if ( dirty[2] <= dirty[0] || dirty[3] <= dirty[1] )
+      continue;
+
+    CPageRegionImage region( page._image.data() + ( dirty[1] * page_size + dirty[0] ) * 4, page_size, dirty[2] - dirty[0], dirty[3] - dirty[1] );
+    success = loader.LoadToTexture( region, *page._texture, { dirty[0], dirty[1], 0 }, 0 ) && success;
+    page._texture->Release( 0 );
+    dirty = { 0, 0, 0, 0 };
+    ++ _uploads;
+  }
+  return success;
+}
+
+
+/******************************************************************//**
+* \brief   Ratio of the packed area and the area of all pages.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+double CGlyphAtlas::Occupancy( void ) const
+{
+  if ( _pages.empty() )
+    return 0.0;
+  size_t used = 0;
+  for ( auto &page : _pages )
+    used += page._packer.UsedArea();
+  return (double)used / (double)( _pages.size() * _parameters._page_size * _parameters._page_size );
+}
+
+
+/******************************************************************//**
+* \brief   Add an empty page.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CGlyphAtlas::AddPage( void )
+{
+  if ( _pages.size() >= std::max( _parameters._max_pages, (size_t)1 ) )
+    return false;
+
+  size_t page_size = _parameters._page_size;
+  _pages.emplace_back();
+  TPage &page = _pages.back();
+  page._packer.Reset( page_size, page_size );
+  page._image.assign( page_size * page_size * 4, 0 );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Remove all glyphs of a page and clear the page.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGlyphAtlas::EvictPage(
+  size_t page ) //!< in: index of the page
+{
+  for ( auto it = _glyphs.begin(); it != _glyphs.end(); )
+  {
+    if ( it->second._page == page )
+      it = _glyphs.erase( it );
+    else
+      ++ it;
+  }
+
+  size_t page_size = _parameters._page_size;
+  TPage &target = _pages[page];
+  target._packer.Reset( page_size, page_size );
+  std::fill( target._image.begin(), target._image.end(), (t_byte)0 );
+  AddDirty( target, 0, 0, page_size, page_size );
+  ++ _evictions;
+  ++ _revision;
+}
+
+
+/******************************************************************//**
+* \brief   Find space for a glyph image, including the padding.
+*
+* The pages are tried in order. If no page has space left, then a new
+* page is added, or the least recently used page, which isn't used by
+* the current generation, is evicted.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CGlyphAtlas::Allocate(
+  size_t  cx,   //!< in: width of the glyph image
+  size_t  cy,   //!< in: height of the glyph image
+  size_t &page, //!< out: page index
+  size_t &x,    //!< out: start x of the glyph image
+  size_t &y )   //!< out: start y of the glyph image
+{
+  size_t padding = _parameters._padding;
+  size_t pcx = cx + 2 * padding;
+  size_t pcy = cy + 2 * padding;
+  if ( pcx > _parameters._page_size || pcy > _parameters._page_size )
+    return false;
+
+  auto insert = [&]( size_t i ) -> bool
+  {
+    if ( _pages[i]._packer.Insert( pcx, pcy, x, y ) == false )
+      return false;
+    page = i;
+    x += padding;
+    y += padding;
+    return true;
+  };
+
+  for ( size_t i = 0; i < _pages.size(); ++ i )
+  {
+    if ( insert( i ) )
+      return true;
+  }
+
+  if ( AddPage() )
+    return insert( _pages.size() - 1 );
+
+  // evict the least recently used page
+  size_t lru_page = _pages.size();
+  for ( size_t i = 0; i < _pages.size(); ++ i )
+  {
+    if ( _pages[i]._last_use < _generation && ( lru_page == _pages.size() || _pages[i]._last_use < _pages[lru_page]._last_use ) )
+      lru_page = i;
+  }
+  if ( lru_page == _pages.size() )
+    return false;
+
+  EvictPage( lru_page );
+  return insert( lru_page );
+}
+
+
+/******************************************************************//**
+* \brief   Extend the modified region of a page.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGlyphAtlas::AddDirty(
+  TPage &page, //!< in: page
+  size_t x0,   //!< in: min x
+  size_t y0,   //!< in: min y
+  size_t x1,   //!< in: max x (exclusive)
+  size_t y1 )  //!< in: max y (exclusive)
+{
+  auto &dirty = page._dirty;
+  if ( dirty[2] <= dirty[0] || dirty[3] <= dirty[1] )
+  {
+    dirty = { x0, y0, x1, y1 };
+    return;
+  }
+  dirty = { std::min( dirty[0], x0 ), std::min( dirty[1], y0 ), std::max( dirty[2], x1 ), std::max( dirty[3], y1 ) };
+}
+
+
+} // Render
@@ -0,0 +1,813 @@
+/******************************************************************//**
+* \brief   Signed distance field and multi-channel signed distance field
+* generation from glyph outlines.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_GlyphSDF.h"
+#include "../../include/util/RenderUtil_Parallel.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+// SIMD
+
+#if defined(__AVX2__)
+#define RENDERUTIL_GLYPHSDF_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERUTIL_GLYPHSDF_SSE2
+#endif
+
+#if defined(RENDERUTIL_GLYPHSDF_AVX2) || defined(RENDERUTIL_GLYPHSDF_SSE2)
+#include <immintrin.h>
+#endif
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+// edge colors; bit 0: red, bit 1: green, bit 2: blue
+const t_byte c_red     = 1;
+const t_byte c_green   = 2;
+const t_byte c_blue    = 4;
+const t_byte c_white   = c_red | c_green | c_blue;
+const t_byte c_yellow  = c_red | c_green;
+const t_byte c_magenta = c_red | c_blue;
+const t_byte c_cyan    = c_green | c_blue;
+
+const float c_max_distance = std::numeric_limits<float>::max();
+
+
+//! line segment of a flattened outline
+struct TSegment
+{
+  float  _ax, _ay;       //!< start point
+  float  _bx, _by;       //!< end point
+  float  _abx, _aby;     //!< direction
+  float  _inv_len;       //!< 1 / length
+  float  _inv_len2;      //!< 1 / length^2
+  t_byte _color;         //!< channels of the edge
+  bool   _start;         //!< the segment starts an edge; the distance before the start is a pseudo distance
+  bool   _end;           //!< the segment ends an edge; the distance after the end is a pseudo distance
+};
+
+
+//! flattened point of a contour
+struct TContourPoint
+{
+  float  _x, _y;
+  size_t _edge;
+};
+
+
+//! distances of one row of texels
+struct TRowDistances
+{
+  std::vector<float> _d2;         //!< square of the true distance
+  std::vector<float> _channel[3]; //!< signed pseudo distance of the red, green and blue edges
+};
+
+
+CGlyphOutline::TPoint Sub( const CGlyphOutline::TPoint &a, const CGlyphOutline::TPoint &b )
+{
+  return { a[0] - b[0], a[1] - b[1] };
+}
+
+
+float Length( const CGlyphOutline::TPoint &v )
+{
+  return std::sqrt( v[0] * v[0] + v[1] * v[1] );
+}
+
+
+//! number of edge points
+size_t EdgePoints( CGlyphOutline::TEdgeType type )
+{
+  return type == CGlyphOutline::TEdgeType::line ? 2 : (type == CGlyphOutline::TEdgeType::quadratic ? 3 : 4);
+}
+
+
+//! normalized direction at the start or the end of an edge
+CGlyphOutline::TPoint EdgeDirection( const CGlyphOutline::TEdge &edge, bool at_end )
+{
+  size_t n = EdgePoints( edge._type );
+  for ( size_t i = 1; i < n; ++ i )
+  {
+    CGlyphOutline::TPoint d = at_end ? Sub( edge._p[n-1], edge._p[n-1-i] ) : Sub( edge._p[i], edge._p[0] );
+    float len = Length( d );
+    if ( len > 0.0f )
+      return { d[0] / len, d[1] / len };
+  }
+  return { 0.0f, 0.0f };
+}
+
+
+//! flatten the edges of a contour; the points of the edges are appended to `points`, the closing point is not repeated
+void FlattenContour( const CGlyphOutline::TContour &contour, float tolerance, std::vector<TContourPoint> &points )
+{
+  tolerance = std::max( tolerance, 1.0e-4f );
+  for ( size_t e = 0; e < contour.size(); ++ e )
+  {
+    const CGlyphOutline::TEdge &edge = contour[e];
+    const auto &p = edge._p;
+    points.push_back( { p[0][0], p[0][1], e } );
+
+    // number of line segments from the bound of the second derivative
+    size_t n = 1;
+    if ( edge._type == CGlyphOutline::TEdgeType::quadratic )
+    {
+      float dd = Length( { p[0][0] - 2.0f * p[1][0] + p[2][0], p[0][1] - 2.0f * p[1][1] + p[2][1] } );
+      n = (size_t)std::ceil( std::sqrt( dd / (4.0f * tolerance) ) );
+    }
+    else if ( edge._type == CGlyphOutline::TEdgeType::cubic )
+    {
+      float dd = std::max(
+        Length( { p[0][0] - 2.0f * p[1][0] + p[2][0], p[0][1] - 2.0f * p[1][1] + p[2][1] } ),
+        Length( { p[1][0] - 2.0f * p[2][0] + p[3][0], p[1][1] - 2.0f * p[2][1] + p[3][1] } ) );
+      n = (size_t)std::ceil( std::sqrt( 3.0f * dd / (4.0f * tolerance) ) );
+    }
+    n = std::min( std::max( n, (size_t)1 ), (size_t)64 );
+
+    for ( size_t i = 1; i < n; ++ i )
+    {
+      float t = (float)i / (float)n;
+      float s = 1.0f - t;
+      float x, y;
+      if ( edge._type == CGlyphOutline::TEdgeType::quadratic )
+      {
+        x = s * s * p[0][0] + 2.0f * s * t * p[1][0] + t * t * p[2][0];
+        y = s * s * p[0][1] + 2.0f * s * t * p[1][1] + t * t * p[2][1];
+      }
+      else
+      {
+        x = s * s * s * p[0][0] + 3.0f * s * s * t * p[1][0] + 3.0f * s * t * t * p[2][0] + t * t * t * p[3][0];
+        y = s * s * s * p[0][1] + 3.0f * s * s * t * p[1][1] + 3.0f * s * t * t * p[2][1] + t * t * t * p[3][1];
+      }
+      points.push_back( { x, y, e } );
+    }
+  }
+}
+
+
+/******************************************************************//**
+* \brief Flatten the outline and color the edges.
+*
+* Simple edge coloring of msdfgen: a contour without corners is white,
+* a contour with a single corner ("teardrop") is split in three parts
+* and the splines between the corners get alternating colors, so that
+* each two adjacent splines share one channel only.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void Segments(
+  const CGlyphOutline            &outline,    //!< in: glyph outline
+  const TDistanceFieldParameters &parameters, //!< in: generation parameters
+  std::vector<TSegment>          &segments,   //!< out: line segments
+  float                          &area )      //!< out: signed area of the outline
+{
+  segments.clear();
+  area = 0.0f;
+  float cross_threshold = std::sin( parameters._corner_angle );
+
+  std::vector<TContourPoint> points;
+  std::vector<bool>          corners;
+  std::vector<t_byte>        colors;
+  for ( const CGlyphOutline::TContour &contour : outline.Contours() )
+  {
+    if ( contour.empty() )
+      continue;
+
+    // flatten the contour and skip degenerated segments
+    points.clear();
+    FlattenContour( contour, parameters._tolerance, points );
+    size_t no_of_points = 0;
+    for ( size_t i = 0; i < points.size(); ++ i )
+    {
+      if ( no_of_points > 0 && points[no_of_points-1]._x == points[i]._x && points[no_of_points-1]._y == points[i]._y )
+        continue;
+      points[no_of_points ++] = points[i];
+    }
+    points.resize( no_of_points );
+    if ( no_of_points > 1 && points.back()._x == points.front()._x && points.back()._y == points.front()._y )
+      points.pop_back();
+    if ( points.size() < 2 )
+      continue;
+
+    // find the corners at the start of the edges
+    size_t no_of_edges = contour.size();
+    corners.assign( no_of_edges, false );
+    size_t no_of_corners = 0;
+    for ( size_t e = 0; e < no_of_edges; ++ e )
+    {
+      CGlyphOutline::TPoint a = EdgeDirection( contour[(e + no_of_edges - 1) % no_of_edges], true );
+      CGlyphOutline::TPoint b = EdgeDirection( contour[e], false );
+      float dot   = a[0] * b[0] + a[1] * b[1];
+      float cross = a[0] * b[1] - a[1] * b[0];
+      if ( dot <= 0.0f || std::fabs( cross ) > cross_threshold )
+      {
+        corners[e] = true;
+        ++ no_of_corners;
+      }
+    }
+
+    // color the segments
+    size_t n = points.size();
+    colors.assign( n, c_white );
+    if ( no_of_corners == 1 && n >= 3 )
+    {
+      size_t corner_edge = (size_t)(std::find( corners.begin(), corners.end(), true ) - corners.begin());
+      size_t first = 0;
+      while ( first < n && points[first]._edge != corner_edge )
+        ++ first;
+      first = first < n ? first : 0;
+      const t_byte teardrop[]{ c_magenta, c_white, c_yellow };
+      for ( size_t i = 0; i < n; ++ i )
+        colors[(first + i) % n] = teardrop[i * 3 / n];
+    }
+    else if ( no_of_corners > 1 )
+    {
+      const t_byte palette[]{ c_cyan, c_magenta, c_yellow };
+      size_t first = 0;
+      while ( first < n && (corners[points[first]._edge] == false || (first > 0 && points[first-1]._edge == points[first]._edge)) )
+        ++ first;
+      first = first < n ? first : 0;
+      size_t spline = 0;
+      for ( size_t i = 0; i < n; ++ i )
+      {
+        size_t j = (first + i) % n;
+        bool edge_start = points[j]._edge != points[(j + n - 1) % n]._edge;
+        if ( i > 0 && edge_start && corners[points[j]._edge] )
+          ++ spline;
+        t_byte color = palette[spline % 3];
+        if ( spline == no_of_corners - 1 && spline % 3 == 0 )
+          color = palette[1]; // the last spline must not have the color of the first spline
+        colors[j] = color;
+      }
+    }
+
+    // create the line segments
+    for ( size_t i = 0; i < n; ++ i )
+    {
+      const TContourPoint &a    = points[i];
+      const TContourPoint &b    = points[(i + 1) % n];
+      const TContourPoint &prev = points[(i + n - 1) % n];
+
+      TSegment segment;
+      segment._ax       = a._x;
+      segment._ay       = a._y;
+      segment._bx       = b._x;
+      segment._by       = b._y;
+      segment._abx      = b._x - a._x;
+      segment._aby      = b._y - a._y;
+      float len2        = segment._abx * segment._abx + segment._aby * segment._aby;
+      segment._inv_len  = 1.0f / std::sqrt( len2 );
+      segment._inv_len2 = 1.0f / len2;
+      segment._color    = colors[i];
+      segment._start    = prev._edge != a._edge || colors[(i + n - 1) % n] != colors[i];
+      segment._end      = b._edge != a._edge || colors[(i + 1) % n] != colors[i];
+      segments.push_back( segment );
+
+      area += a._x * b._y - b._x * a._y;
+    }
+  }
+  area *= 0.5f;
+}
+
+
+//! sorted x coordinates and directions of the intersections of a horizontal line with the outline
+void RowCrossings( const std::vector<TSegment> &segments, float y, std::vector<std::pair<float, int>> &crossings )
+{
+  crossings.clear();
+  for ( const TSegment &s : segments )
+  {
+    bool up   = s._ay <= y && y < s._by;
+    bool down = s._by <= y && y < s._ay;
+    if ( up == false && down == false )
+      continue;
+    float x = s._ax + (y - s._ay) * s._abx / s._aby;
+    crossings.emplace_back( x, up ? 1 : -1 );
+  }
+  std::sort( crossings.begin(), crossings.end() );
+}
+
+
+#if !defined(RENDERUTIL_GLYPHSDF_AVX2) && !defined(RENDERUTIL_GLYPHSDF_SSE2)
+
+//! distances of a row of texels; scalar implementation
+void DistanceRow( const std::vector<TSegment> &segments, bool multi_channel, float y, float x0, size_t cx, TRowDistances &row )
+{
+  for ( size_t x = 0; x < cx; ++ x )
+  {
+    float px = x0 + (float)x;
+    float best = c_max_distance;
+    float ch_d2[3]{ c_max_distance, c_max_distance, c_max_distance };
+    float ch_ortho[3]{ 1.0f, 1.0f, 1.0f };
+    float ch_value[3]{ -c_max_distance, -c_max_distance, -c_max_distance };
+    for ( const TSegment &s : segments )
+    {
+      float apx = px - s._ax;
+      float apy = y - s._ay;
+      float t   = (apx * s._abx + apy * s._aby) * s._inv_len2;
+      bool before = t <= 0.0f;
+      bool after  = t >= 1.0f;
+      float qx = before ? apx : (after ? px - s._bx : apx - t * s._abx);
+      float qy = before ? apy : (after ? y - s._by : apy - t * s._aby);
+      float d2 = qx * qx + qy * qy;
+      best = std::min( best, d2 );
+      if ( multi_channel == false )
+        continue;
+
+      float perp = (s._abx * apy - s._aby * apx) * s._inv_len;
+      float ortho = (before || after) ? std::fabs( s._abx * qx + s._aby * qy ) * s._inv_len / std::sqrt( std::max( d2, 1.0e-12f ) ) : 0.0f;
+      bool use_perp = (before == false && after == false) || (before && s._start) || (after && s._end);
+      for ( int c = 0; c < 3; ++ c )
+      {
+        if ( (s._color & (1 << c)) == 0 )
+          continue;
+        if ( d2 < ch_d2[c] || (d2 == ch_d2[c] && ortho < ch_ortho[c]) )
+        {
+          ch_d2[c]    = d2;
+          ch_ortho[c] = ortho;
+          ch_value[c] = use_perp ? perp : std::copysign( std::sqrt( d2 ), perp );
+        }
+      }
+    }
+    row._d2[x] = best;
+    if ( multi_channel )
+    {
+      for ( int c = 0; c < 3; ++ c )
+        row._channel[c][x] = ch_value[c];
+    }
+  }
+}
+
+#endif
+
+
+#if defined(RENDERUTIL_GLYPHSDF_AVX2)
+
+//! 8 float lanes
+struct TLanesAVX2
+{
+  using T = __m256;
+  static const size_t c_width = 8;
+
+  static T    Set( float v )                  { return _mm256_set1_ps( v ); }
+  static T    Offsets( void )                 { return _mm256_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f ); }
+  static T    Mask( bool v )                  { return _mm256_castsi256_ps( _mm256_set1_epi32( v ? -1 : 0 ) ); }
+  static void Store( float *p, T v )          { _mm256_storeu_ps( p, v ); }
+  static T    Add( T a, T b )                 { return _mm256_add_ps( a, b ); }
+  static T    Sub( T a, T b )                 { return _mm256_sub_ps( a, b ); }
+  static T    Mul( T a, T b )                 { return _mm256_mul_ps( a, b ); }
+  static T    Min( T a, T b )                 { return _mm256_min_ps( a, b ); }
+  static T    Max( T a, T b )                 { return _mm256_max_ps( a, b ); }
+  static T    Sqrt( T a )                     { return _mm256_sqrt_ps( a ); }
+  static T    RSqrt( T a )                    { return _mm256_rsqrt_ps( a ); }
+  static T    Lt( T a, T b )                  { return _mm256_cmp_ps( a, b, _CMP_LT_OQ ); }
+  static T    Le( T a, T b )                  { return _mm256_cmp_ps( a, b, _CMP_LE_OQ ); }
+  static T    Ge( T a, T b )                  { return _mm256_cmp_ps( a, b, _CMP_GE_OQ ); }
+  static T    Eq( T a, T b )                  { return _mm256_cmp_ps( a, b, _CMP_EQ_OQ ); }
+  static T    And( T a, T b )                 { return _mm256_and_ps( a, b ); }
+  static T    AndNot( T a, T b )              { return _mm256_andnot_ps( a, b ); } // ~a & b
+  static T    Or( T a, T b )                  { return _mm256_or_ps( a, b ); }
+  static T    Select( T mask, T a, T b )      { return _mm256_blendv_ps( b, a, mask ); }
+};
+
+#endif
+
+#if defined(RENDERUTIL_GLYPHSDF_SSE2)
+
+//! 4 float lanes
+struct TLanesSSE2
+{
+  using T = __m128;
+  static const size_t c_width = 4;
+
+  static T    Set( float v )                  { return _mm_set1_ps( v ); }
+  static T    Offsets( void )                 { return _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f ); }
+  static T    Mask( bool v )                  { return _mm_castsi128_ps( _mm_set1_epi32( v ? -1 : 0 ) ); }
+  static void Store( float *p, T v )          { _mm_storeu_ps( p, v ); }
+  static T    Add( T a, T b )                 { return _mm_add_ps( a, b ); }
+  static T    Sub( T a, T b )                 { return _mm_sub_ps( a, b ); }
+  static T    Mul( T a, T b )                 { return _mm_mul_ps( a, b ); }
+  static T    Min( T a, T b )                 { return _mm_min_ps( a, b ); }
+  static T    Max( T a, T b )                 { return _mm_max_ps( a, b ); }
+  static T    Sqrt( T a )                     { return _mm_sqrt_ps( a ); }
+  static T    RSqrt( T a )                    { return _mm_rsqrt_ps( a ); }
+  static T    Lt( T a, T b )                  { return _mm_cmplt_ps( a, b ); }
+  static T    Le( T a, T b )                  { return _mm_cmple_ps( a, b ); }
+  static T    Ge( T a, T b )                  { return _mm_cmpge_ps( a, b ); }
+  static T    Eq( T a, T b )                  { return _mm_cmpeq_ps( a, b ); }
+  static T    And( T a, T b )                 { return _mm_and_ps( a, b ); }
+  static T    AndNot( T a, T b )              { return _mm_andnot_ps( a, b ); } // ~a & b
+  static T    Or( T a, T b )                  { return _mm_or_ps( a, b ); }
+  static T    Select( T mask, T a, T b )      { return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) ); }
+};
+
+#endif
+
+
+#if defined(RENDERUTIL_GLYPHSDF_AVX2) || defined(RENDERUTIL_GLYPHSDF_SSE2)
+
+/******************************************************************//**
+* \brief Distances of a row of texels; SIMD implementation.
+*
+* Evaluates `L::c_width` texels at once. The result is identical to
+* the scalar implementation, except for the orthogonality tie break
+* (approximated reciprocal square root). The size of the row buffers
+* has to be a multiple of `L::c_width`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template <class L>
+void DistanceRowSIMD( const std::vector<TSegment> &segments, bool multi_channel, float y, float x0, size_t cx, TRowDistances &row )
+{
+  using T = typename L::T;
+  const T zero      = L::Set( 0.0f );
+  const T one       = L::Set( 1.0f );
+  const T tiny      = L::Set( 1.0e-12f );
+  const T abs_mask  = L::AndNot( L::Set( -0.0f ), L::Mask( true ) );
+  const T sign_mask = L::Set( -0.0f );
+  const T offsets   = L::Offsets();
+
+  for ( size_t x = 0; x < cx; x += L::c_width )
+  {
+    T px   = L::Add( L::Set( x0 + (float)x ), offsets );
+    T best = L::Set( c_max_distance );
+    T ch_d2[3], ch_ortho[3], ch_perp[3], ch_use_perp[3];
+    for ( int c = 0; c < 3; ++ c )
+    {
+      ch_d2[c]       = L::Set( c_max_distance );
+      ch_ortho[c]    = one;
+      ch_perp[c]     = L::Set( -c_max_distance );
+      ch_use_perp[c] = L::Mask( true );
+    }
+
+    for ( const TSegment &s : segments )
+    {
+      float apy = y - s._ay;
+      float bpy = y - s._by;
+      T abx = L::Set( s._abx );
+      T aby = L::Set( s._aby );
+      T apx = L::Sub( px, L::Set( s._ax ) );
+      T t   = L::Mul( L::Add( L::Mul( apx, abx ), L::Set( apy * s._aby ) ), L::Set( s._inv_len2 ) );
+      T before = L::Le( t, zero );
+      T after  = L::Ge( t, one );
+      T qx = L::Select( before, apx, L::Select( after, L::Sub( px, L::Set( s._bx ) ), L::Sub( apx, L::Mul( t, abx ) ) ) );
+      T qy = L::Select( before, L::Set( apy ), L::Select( after, L::Set( bpy ), L::Sub( L::Set( apy ), L::Mul( t, aby ) ) ) );
+      T d2 = L::Add( L::Mul( qx, qx ), L::Mul( qy, qy ) );
+      best = L::Min( best, d2 );
+      if ( multi_channel == false )
+        continue;
+
+      T inv_len  = L::Set( s._inv_len );
+      T clamped  = L::Or( before, after );
+      T perp     = L::Mul( L::Sub( L::Set( s._abx * apy ), L::Mul( aby, apx ) ), inv_len );
+      T dot      = L::And( L::Add( L::Mul( abx, qx ), L::Mul( aby, qy ) ), abs_mask );
+      T ortho    = L::And( clamped, L::Mul( L::Mul( dot, inv_len ), L::RSqrt( L::Max( d2, tiny ) ) ) );
+      T use_perp = L::Or( L::AndNot( clamped, L::Mask( true ) ), L::Or( L::And( before, L::Mask( s._start ) ), L::And( after, L::Mask( s._end ) ) ) );
+      for ( int c = 0; c < 3; ++ c )
+      {
+        if ( (s._color & (1 << c)) == 0 )
+          continue;
+        T better = L::Or( L::Lt( d2, ch_d2[c] ), L::And( L::Eq( d2, ch_d2[c] ), L::Lt( ortho, ch_ortho[c] ) ) );
+        ch_d2[c]       = L::Select( better, d2, ch_d2[c] );
+        ch_ortho[c]    = L::Select( better, ortho, ch_ortho[c] );
+        ch_perp[c]     = L::Select( better, perp, ch_perp[c] );
+        ch_use_perp[c] = L::Select( better, use_perp, ch_use_perp[c] );
+      }
+    }
+
+    L::Store( row._d2.data() + x, best );
+    if ( multi_channel == false )
+      continue;
+    for ( int c = 0; c < 3; ++ c )
+    {
+      T dist  = L::Or( L::Sqrt( ch_d2[c] ), L::And( ch_perp[c], sign_mask ) );
+      L::Store( row._channel[c].data() + x, L::Select( ch_use_perp[c], ch_perp[c], dist ) );
+    }
+  }
+}
+
+#endif
+
+
+//! encode a signed distance to a byte
+t_byte EncodeDistance( float distance, float inv_range_2 )
+{
+  float v = 0.5f + distance * inv_range_2;
+  return (t_byte)( std::min( std::max( v, 0.0f ), 1.0f ) * 255.0f + 0.5f );
+}
+
+
+float Median( float a, float b, float c )
+{
+  return std::max( std::min( a, b ), std::min( std::max( a, b ), c ) );
+}
+
+
+} // anonymous namespace
+
+
+//---------------------------------------------------------------------
+// CGlyphOutline
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Start a new contour.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGlyphOutline::MoveTo(
+  const TPoint &p ) //!< in: start point of the contour
+{
+  Close();
+  _contours.emplace_back();
+  _start   = p;
+  _current = p;
+}
+
+
+/******************************************************************//**
+* \brief Add a line to the current contour.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGlyphOutline::LineTo(
+  const TPoint &p ) //!< in: end point
+{
+  if ( _contours.empty() )
+    MoveTo( _current );
+  if ( p == _current )
+    return;
+  _contours.back().push_back( { TEdgeType::line, { _current, p, p, p } } );
+  _current = p;
+}
+
+
+/******************************************************************//**
+* \brief Add a quadratic Bézier curve to the current contour.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGlyphOutline::QuadraticTo(
+  const TPoint &c,  //!< in: control point
+  const TPoint &p ) //!< in: end point
+{
+  if ( _contours.empty() )
+    MoveTo( _current );
+  _contours.back().push_back( { TEdgeType::quadratic, { _current, c, p, p } } );
+  _current = p;
+}
+
+
+/******************************************************************//**
+* \brief Add a cubic Bézier curve to the current contour.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGlyphOutline::CubicTo(
+  const TPoint &c1, //!< in: first control point
+  const TPoint &c2, //!< in: second control point
+  const TPoint &p ) //!< in: end point
+{
+  if ( _contours.empty() )
+    MoveTo( _current );
+  _contours.back().push_back( { TEdgeType::cubic, { _current, c1, c2, p } } );
+  _current = p;
+}
+
+
+/******************************************************************//**
+* \brief Close the current contour with a line to its start point.
+*
+* Empty contours are removed.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CGlyphOutline::Close( void )
+{
+  if ( _contours.empty() )
+    return;
+  if ( _current != _start )
+    LineTo( _start );
+  if ( _contours.back().empty() )
+    _contours.pop_back();
+}
+
+
+/******************************************************************//**
+* \brief Bounding box of the control points.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CGlyphOutline::Bounds(
+  TPoint &min_pt,         //!< out: minimum
+  TPoint &max_pt ) const  //!< out: maximum
+{
+  min_pt = { c_max_distance, c_max_distance };
+  max_pt = { -c_max_distance, -c_max_distance };
+  bool valid = false;
+  for ( const TContour &contour : _contours )
+  {
+    for ( const TEdge &edge : contour )
+    {
+      for ( size_t i = 0; i < EdgePoints( edge._type ); ++ i )
+      {
+        min_pt = { std::min( min_pt[0], edge._p[i][0] ), std::min( min_pt[1], edge._p[i][1] ) };
+        max_pt = { std::max( max_pt[0], edge._p[i][0] ), std::max( max_pt[1], edge._p[i][1] ) };
+        valid = true;
+      }
+    }
+  }
+  return valid;
+}
+
+
+//---------------------------------------------------------------------
+// CDistanceFieldGenerator
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief Generate the distance field of a glyph.
+*
+* The distances are evaluated row by row. The sign of the true distance
+* is given by the non-zero winding rule. For the multi-channel distance
+* field, the channels, which contradict the true sign (median), are
+* replaced by the true distance (error correction).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CDistanceFieldGenerator::Generate(
+  const CGlyphOutline &outline,       //!< in: glyph outline in pixels
+  TDistanceFieldImage &image ) const  //!< out: distance field image
+{
+  image = TDistanceFieldImage();
+
+  CGlyphOutline::TPoint min_pt, max_pt;
+  if ( outline.Bounds( min_pt, max_pt ) == false )
+    return false;
+
+  std::vector<TSegment> segments;
+  float area = 0.0f;
+  Segments( outline, _parameters, segments, area );
+  if ( segments.empty() )
+    return false;
+
+  // image placement
+  float range  = std::max( _parameters._range, 0.5f );
+  int   border = (int)std::ceil( range );
+  int   left   = (int)std::floor( min_pt[0] ) - border;
+  int   right  = (int)std::ceil( max_pt[0] ) + border;
+  int   bottom = (int)std::floor( min_pt[1] ) - border;
+  int   top    = (int)std::ceil( max_pt[1] ) + border;
+  image._cx    = (size_t)(right - left);
+  image._cy    = (size_t)(top - bottom);
+  image._left  = left;
+  image._top   = top;
+  image._rgba.resize( image._cx * image._cy * 4 );
+
+  // the pseudo distances are positive on the left side of the segments; flip them for clockwise outlines
+  bool  multi_channel = _parameters._type == TGlyphImageType::msdf;
+  float orientation   = area < 0.0f ? -1.0f : 1.0f;
+  float inv_range_2   = 0.5f / range;
+
+  size_t cx_padded = (image._cx + 7) & ~(size_t)7;
+  TRowDistances row;
+  row._d2.resize( cx_padded );
+  if ( multi_channel )
+  {
+    for ( auto &channel : row._channel )
+      channel.resize( cx_padded );
+  }
+
+  std::vector<std::pair<float, int>> crossings;
+  for ( size_t y = 0; y < image._cy; ++ y )
+  {
+    float py = (float)top - (float)y - 0.5f;
+    float x0 = (float)left + 0.5f;
+
+#if defined(RENDERUTIL_GLYPHSDF_AVX2)
+    DistanceRowSIMD<TLanesAVX2>( segments, multi_channel, py, x0, cx_padded, row );
+#elif defined(RENDERUTIL_GLYPHSDF_SSE2)
+    DistanceRowSIMD<TLanesSSE2>( segments, multi_channel, py, x0, cx_padded, row );
+#else
+    DistanceRow( segments, multi_channel, py, x0, image._cx, row );
+#endif
+
+    RowCrossings( segments, py, crossings );
+    size_t crossing = 0;
+    int    winding  = 0;
+    t_byte *target  = image._rgba.data() + y * image._cx * 4;
+    for ( size_t x = 0; x < image._cx; ++ x, target += 4 )
+    {
+      float px = x0 + (float)x;
+      for ( ; crossing < crossings.size() && crossings[crossing].first < px; ++ crossing )
+        winding += crossings[crossing].second;
+
+      float distance = std::sqrt( row._d2[x] );
+      if ( winding == 0 )
+        distance = -distance;
+      t_byte a = EncodeDistance( distance, inv_range_2 );
+
+      if ( multi_channel == false )
+      {
+        target[0] = target[1] = target[2] = target[3] = a;
+        continue;
+      }
+
+      float r = row._channel[0][x] * orientation;
+      float g = row._channel[1][x] * orientation;
+      float b = row._channel[2][x] * orientation;
+      if ( (Median( r, g, b ) > 0.0f) != (distance > 0.0f) )
+        r = g = b = distance;
+      target[0] = EncodeDistance( r, inv_range_2 );
+      target[1] = EncodeDistance( g, inv_range_2 );
+      target[2] = EncodeDistance( b, inv_range_2 );
+      target[3] = a;
+    }
+  }
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief Generate the distance fields of multiple glyphs in parallel.
+*
+* The glyphs are distributed dynamically to the worker threads.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CDistanceFieldGenerator::Generate(
+  const std::vector<CGlyphOutline> &outlines,     //!< in: glyph outlines in pixels
+  std::vector<TDistanceFieldImage> &images ) const //!< out: distance field images; empty image for an empty outline
+{
+  images.clear();
+  images.resize( outlines.size() );
+  ParallelFor( 0, outlines.size(), 1, _parameters._threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t i = begin; i < end; ++ i )
+      Generate( outlines[i], images[i] );
+  } );
+}
+
+
+} // Render
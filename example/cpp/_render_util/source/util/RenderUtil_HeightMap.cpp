@@ -0,0 +1,468 @@
+/******************************************************************//**
+* \brief   CPU height map transformations (displacement map and
+* normal map from a height map).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_HeightMap.h"
+#include "../../include/util/RenderUtil_Hash.h"
+#include "../../include/util/RenderUtil_Parallel.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+
+// SIMD
+
+#if defined(__AVX2__)
+#define RENDERUTIL_HEIGHTMAP_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERUTIL_HEIGHTMAP_SSE2
+#endif
+
+#if defined(RENDERUTIL_HEIGHTMAP_AVX2) || defined(RENDERUTIL_HEIGHTMAP_SSE2)
+#include <immintrin.h>
+#endif
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+//! weights of the gradient operator
+struct TGradientKernel
+{
+  float _edge;   //!< weight of the diagonal neighbours
+  float _center; //!< weight of the direct neighbours
+  float _norm;   //!< normalization to the height difference per texel
+};
+
+
+TGradientKernel GradientKernel( THeightMapFilter filter )
+{
+  // the central difference spans 2 texels
+  switch ( filter )
+  {
+    default:
+    case THeightMapFilter::sobel:  return { 1.0f, 2.0f, 1.0f / 8.0f };
+    case THeightMapFilter::scharr: return { 3.0f, 10.0f, 1.0f / 32.0f };
+  }
+}
+
+
+//! source index of a texel outside of the image
+size_t WrapIndex( std::ptrdiff_t i, size_t size, TTextureWrap wrap )
+{
+  std::ptrdiff_t n = (std::ptrdiff_t)size;
+  switch ( wrap )
+  {
+    case TTextureWrap::tiled:
+      return (size_t)( ( i % n + n ) % n );
+
+    case TTextureWrap::mirrored:
+    case TTextureWrap::tiled_mirrored:
+    {
+      std::ptrdiff_t period = 2 * n;
+      std::ptrdiff_t m = ( i % period + period ) % period;
+      return (size_t)( m < n ? m : period - 1 - m );
+    }
+
+    default:
+    case TTextureWrap::clamp:
+      return (size_t)std::min( std::max( i, (std::ptrdiff_t)0 ), n - 1 );
+  }
+}
+
+
+//! copy the heights to a plane with a border of 1 texel, so that the gradient kernel needs no border handling
+void PadHeights( const std::vector<float> &heights, size_t cx, size_t cy, TTextureWrap wrap, size_t tile_rows, size_t no_of_threads, std::vector<float> &padded )
+{
+  size_t pcx = cx + 2;
+  padded.resize( pcx * (cy + 2) );
+  ParallelFor( 0, cy + 2, tile_rows, no_of_threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t py = begin; py < end; ++ py )
+    {
+      const float *source = heights.data() + WrapIndex( (std::ptrdiff_t)py - 1, cy, wrap ) * cx;
+      float       *target = padded.data() + py * pcx;
+      std::memcpy( target + 1, source, cx * sizeof( float ) );
+      target[0]      = source[WrapIndex( -1, cx, wrap )];
+      target[cx + 1] = source[WrapIndex( (std::ptrdiff_t)cx, cx, wrap )];
+    }
+  } );
+}
+
+
+//! compute the normal vectors and the heights of one row; `above`, `row` and `below` are padded rows
+void NormalRow(
+  const float *above, const float *row, const float *below, size_t cx,
+  const TGradientKernel &kernel, float scale_x, float scale_y, t_byte *target )
+{
+  size_t x = 0;
+
+#if defined(RENDERUTIL_HEIGHTMAP_AVX2)
+  {
+    const __m256 edge = _mm256_set1_ps( kernel._edge ), center = _mm256_set1_ps( kernel._center );
+    const __m256 sx = _mm256_set1_ps( scale_x ), sy = _mm256_set1_ps( scale_y );
+    const __m256 one = _mm256_set1_ps( 1.0f ), encode_scale = _mm256_set1_ps( 127.5f ), encode_offset = _mm256_set1_ps( 128.0f );
+    const __m256 height_scale = _mm256_set1_ps( 255.0f ), half = _mm256_set1_ps( 0.5f );
+    for ( ; x + 8 <= cx; x += 8 )
+    {
+      __m256 a0 = _mm256_loadu_ps( above + x ), a1 = _mm256_loadu_ps( above + x + 1 ), a2 = _mm256_loadu_ps( above + x + 2 );
+      __m256 r0 = _mm256_loadu_ps( row + x ),   r1 = _mm256_loadu_ps( row + x + 1 ),   r2 = _mm256_loadu_ps( row + x + 2 );
+      __m256 b0 = _mm256_loadu_ps( below + x ), b1 = _mm256_loadu_ps( below + x + 1 ), b2 = _mm256_loadu_ps( below + x + 2 );
+
+      __m256 gx = _mm256_add_ps( _mm256_mul_ps( edge, _mm256_add_ps( _mm256_sub_ps( a2, a0 ), _mm256_sub_ps( b2, b0 ) ) ), _mm256_mul_ps( center, _mm256_sub_ps( r2, r0 ) ) );
+      __m256 gy = _mm256_add_ps( _mm256_mul_ps( edge, _mm256_add_ps( _mm256_sub_ps( b0, a0 ), _mm256_sub_ps( b2, a2 ) ) ), _mm256_mul_ps( center, _mm256_sub_ps( b1, a1 ) ) );
+      __m256 nx = _mm256_mul_ps( gx, sx );
+      __m256 ny = _mm256_mul_ps( gy, sy );
+      __m256 inv = _mm256_div_ps( one, _mm256_sqrt_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( nx, nx ), _mm256_mul_ps( ny, ny ) ), one ) ) );
+
+      __m256i r = _mm256_cvttps_epi32( _mm256_add_ps( _mm256_mul_ps( _mm256_mul_ps( nx, inv ), encode_scale ), encode_offset ) );
+      __m256i g = _mm256_cvttps_epi32( _mm256_add_ps( _mm256_mul_ps( _mm256_mul_ps( ny, inv ), encode_scale ), encode_offset ) );
+      __m256i b = _mm256_cvttps_epi32( _mm256_add_ps( _mm256_mul_ps( inv, encode_scale ), encode_offset ) );
+      __m256i h = _mm256_cvttps_epi32( _mm256_add_ps( _mm256_mul_ps( r1, height_scale ), half ) );
+      __m256i rgba = _mm256_or_si256( _mm256_or_si256( r, _mm256_slli_epi32( g, 8 ) ), _mm256_or_si256( _mm256_slli_epi32( b, 16 ), _mm256_slli_epi32( h, 24 ) ) );
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>( target + x * 4 ), rgba );
+    }
+  }
+#endif
+
+#if defined(RENDERUTIL_HEIGHTMAP_SSE2)
+  {
+    const __m128 edge = _mm_set1_ps( kernel._edge ), center = _mm_set1_ps( kernel._center );
+    const __m128 sx = _mm_set1_ps( scale_x ), sy = _mm_set1_ps( scale_y );
+    const __m128 one = _mm_set1_ps( 1.0f ), encode_scale = _mm_set1_ps( 127.5f ), encode_offset = _mm_set1_ps( 128.0f );
+    const __m128 height_scale = _mm_set1_ps( 255.0f ), half = _mm_set1_ps( 0.5f );
+    for ( ; x + 4 <= cx; x += 4 )
+    {
+      __m128 a0 = _mm_loadu_ps( above + x ), a1 = _mm_loadu_ps( above + x + 1 ), a2 = _mm_loadu_ps( above + x + 2 );
+      __m128 r0 = _mm_loadu_ps( row + x ),   r1 = _mm_loadu_ps( row + x + 1 ),   r2 = _mm_loadu_ps( row + x + 2 );
+      __m128 b0 = _mm_loadu_ps( below + x ), b1 = _mm_loadu_ps( below + x + 1 ), b2 = _mm_loadu_ps( below + x + 2 );
+
+      __m128 gx = _mm_add_ps( _mm_mul_ps( edge, _mm_add_ps( _mm_sub_ps( a2, a0 ), _mm_sub_ps( b2, b0 ) ) ), _mm_mul_ps( center, _mm_sub_ps( r2, r0 ) ) );
+      __m128 gy = _mm_add_ps( _mm_mul_ps( edge, _mm_add_ps( _mm_sub_ps( b0, a0 ), _mm_sub_ps( b2, a2 ) ) ), _mm_mul_ps( center, _mm_sub_ps( b1, a1 ) ) );
+      __m128 nx = _mm_mul_ps( gx, sx );
+      __m128 ny = _mm_mul_ps( gy, sy );
+      __m128 inv = _mm_div_ps( one, _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), one ) ) );
+
+      __m128i r = _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( _mm_mul_ps( nx, inv ), encode_scale ), encode_offset ) );
+      __m128i g = _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( _mm_mul_ps( ny, inv ), encode_scale ), encode_offset ) );
+      __m128i b = _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( inv, encode_scale ), encode_offset ) );
+      __m128i h = _mm_cvttps_epi32( _mm_add_ps( _mm_mul_ps( r1, height_scale ), half ) );
+      __m128i rgba = _mm_or_si128( _mm_or_si128( r, _mm_slli_epi32( g, 8 ) ), _mm_or_si128( _mm_slli_epi32( b, 16 ), _mm_slli_epi32( h, 24 ) ) );
+      _mm_storeu_si128( reinterpret_cast<__m128i*>( target + x * 4 ), rgba );
+    }
+  }
+#endif
+
+  for ( ; x < cx; ++ x )
+  {
+    float gx = kernel._edge * ( ( above[x + 2] - above[x] ) + ( below[x + 2] - below[x] ) ) + kernel._center * ( row[x + 2] - row[x] );
+    float gy = kernel._edge * ( ( below[x] - above[x] ) + ( below[x + 2] - above[x + 2] ) ) + kernel._center * ( below[x + 1] - above[x + 1] );
+    float nx = gx * scale_x;
+    float ny = gy * scale_y;
+    float inv = 1.0f / std::sqrt( nx * nx + ny * ny + 1.0f );
+
+    t_byte *texel = target + x * 4;
+    texel[0] = (t_byte)(int)( nx * inv * 127.5f + 128.0f );
+    texel[1] = (t_byte)(int)( ny * inv * 127.5f + 128.0f );
+    texel[2] = (t_byte)(int)( inv * 127.5f + 128.0f );
+    texel[3] = (t_byte)(int)( row[x + 1] * 255.0f + 0.5f );
+  }
+}
+
+
+} // anonymous namespace
+
+
+//---------------------------------------------------------------------
+// CHeightMapTransform
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CHeightMapTransform::CHeightMapTransform(
+  const THeightMapParameters &parameters ) //!< in: transformation parameters
+  : _parameters( parameters )
+{}
+
+
+/******************************************************************//**
+* \brief   True, if the transformation contains a height map
+* transformation.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CHeightMapTransform::IsHeightMapTransform(
+  TImageTransformations transform ) //!< in: image transformations
+{
+  return transform.test( (int)TImageTransform::to_displacement_map ) || transform.test( (int)TImageTransform::to_normal_and_displacement );
+}
+
+
+/******************************************************************//**
+* \brief   Read the heights of an image to floating point values in
+* range [0, 1].
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CHeightMapTransform::ReadHeights(
+  const IImageResource &image,         //!< in: source image
+  std::vector<float>   &heights,       //!< out: tightly packed heights
+  size_t                no_of_threads ) //!< in: number of worker threads; 0: default concurrency
+{
+  TImageFormat format   = image.Format();
+  size_t       channels = ImageTexelSize( format );
+  TTextureSize size     = image.Size();
+  if ( channels == 0 || image.Type() != TTextureType::T2D || size[0] == 0 || size[1] == 0 || image.DataPtr() == nullptr )
+    return false;
+
+  // channel of the height or luminance
+  int  channel   = -1;
+  bool bgr_order = format == TImageFormat::BGR8 || format == TImageFormat::BGRA8;
+  if ( channels == 1 )
+    channel = 0;
+  else if ( image.Kind() == TImageKind::displacement_map || image.Kind() == TImageKind::displacement_cone_map )
+    channel = bgr_order ? 2 : 0;
+  else if ( image.Kind() == TImageKind::normal_displacement_map && channels == 4 )
+    channel = 3;
+
+  const float red   = (bgr_order ? 0.0722f : 0.2126f) / 255.0f;
+  const float green = 0.7152f / 255.0f;
+  const float blue  = (bgr_order ? 0.2126f : 0.0722f) / 255.0f;
+
+  size_t cx = size[0];
+  const t_byte *source = static_cast<const t_byte*>( image.DataPtr() );
+  heights.resize( cx * size[1] );
+  ParallelFor( 0, size[1], 64, no_of_threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t y = begin; y < end; ++ y )
+    {
+      const t_byte *texel  = source + y * image.BPL();
+      float        *target = heights.data() + y * cx;
+      if ( channel >= 0 )
+      {
+        for ( size_t x = 0; x < cx; ++ x, texel += channels )
+          target[x] = texel[channel] / 255.0f;
+      }
+      else
+      {
+        for ( size_t x = 0; x < cx; ++ x, texel += channels )
+          target[x] = std::min( 1.0f, texel[0] * red + texel[1] * green + texel[2] * blue );
+      }
+    }
+  } );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Apply the height map transformation to a 2 dimensional 8 bit
+* image.
+*
+* If both transformations are set, then `to_normal_and_displacement`
+* is applied.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CHeightMapTransform::Transform(
+  const IImageResource  &image,     //!< in: source image
+  TImageTransformations  transform, //!< in: image transformations
+  CMipmapImage          &target )   //!< out: transformed image
+  const
+{
+  if ( IsHeightMapTransform( transform ) == false )
+    return false;
+
+  const THeightMapParameters &param = _parameters;
+  std::vector<float> heights;
+  if ( ReadHeights( image, heights, param._threads ) == false )
+  {
+    std::cout << "error: height map transformation requires a 2 dimensional 8 bit image" << std::endl;
+    return false;
+  }
+
+  size_t cx        = image.Size()[0];
+  size_t cy        = image.Size()[1];
+  size_t tile_rows = std::max( param._tile_rows, (size_t)1 );
+
+  // displacement map
+  if ( transform.test( (int)TImageTransform::to_normal_and_displacement ) == false )
+  {
+    target = CMipmapImage( TImageKind::displacement_map, TImageFormat::GRAY8, cx, cy );
+    t_byte *data = target.Data().data();
+    ParallelFor( 0, cx * cy, tile_rows * cx, param._threads, [&]( size_t begin, size_t end )
+    {
+      for ( size_t i = begin; i < end; ++ i )
+        data[i] = (t_byte)(int)( heights[i] * 255.0f + 0.5f );
+    } );
+    return true;
+  }
+
+  // normal and displacement map
+  std::vector<float> padded;
+  PadHeights( heights, cx, cy, param._wrap, tile_rows, param._threads, padded );
+
+  TGradientKernel kernel = GradientKernel( param._filter );
+  float scale_x = -kernel._norm * param._strength;
+  float scale_y = ( param._invert_y ? -kernel._norm : kernel._norm ) * param._strength;
+
+  target = CMipmapImage( TImageKind::normal_displacement_map, TImageFormat::RGBA8, cx, cy );
+  t_byte *data = target.Data().data();
+  size_t  pcx  = cx + 2;
+  ParallelFor( 0, cy, tile_rows, param._threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t y = begin; y < end; ++ y )
+    {
+      const float *row = padded.data() + ( y + 1 ) * pcx;
+      NormalRow( row - pcx, row, row + pcx, cx, kernel, scale_x, scale_y, data + y * cx * 4 );
+    }
+  } );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Load the transformed image from the cache file, or
+* transform the image and store it to the cache file.
+*
+* `key` is the cache key of the image (`Key`), which was already
+* computed to name the cache file, so the image is hashed only once.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CHeightMapTransform::Transform(
+  const IImageResource  &image,            //!< in: source image
+  TImageTransformations  transform,        //!< in: image transformations
+  CMipmapImage          &target,           //!< out: transformed image
+  const std::string     &cache_filename,   //!< in: path of the cache file
+  CMipmapChain::TKey     key )             //!< in: cache key of the image and the transformation
+  const
+{
+  // the cache file format of the mipmap chain is reused, with a single level
+  CMipmapChain chain;
+  if ( chain.Load( cache_filename, key ) && chain.Levels() == 1 )
+  {
+    target = chain.Level( 0 );
+    return true;
+  }
+
+  if ( Transform( image, transform, target ) == false )
+    return false;
+
+  chain.LevelList() = { target };
+  if ( chain.Save( cache_filename, key ) == false )
+    std::cout << "warning: failed to write height map cache file " << cache_filename << std::endl;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Cache key of an image, which is transformed with the current
+* parameters.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CMipmapChain::TKey CHeightMapTransform::Key(
+  const IImageResource  &image,     //!< in: source image
+  TImageTransformations  transform ) //!< in: image transformations
+  const
+{
+  CMipmapChain::TKey key = c_fnv1a_64_basis;
+
+  TTextureSize  size     = image.Size();
+  TImageFormat  format   = image.Format();
+  size_t        channels = ImageTexelSize( format );
+  std::uint64_t header[]{ (std::uint64_t)size[0], (std::uint64_t)size[1], (std::uint64_t)format, (std::uint64_t)image.Kind() };
+  key = HashFNV1a64( header, sizeof( header ), key );
+
+  // the tile size and the number of threads don't affect the result
+  bool normal_map = transform.test( (int)TImageTransform::to_normal_and_displacement );
+  std::uint64_t parameters[]{
+    (std::uint64_t)normal_map, (std::uint64_t)_parameters._filter, (std::uint64_t)(std::int64_t)( _parameters._strength * 65536.0f ),
+    (std::uint64_t)_parameters._wrap, (std::uint64_t)_parameters._invert_y
+  };
+  key = HashFNV1a64( parameters, sizeof( parameters ), key );
+
+  const t_byte *data = static_cast<const t_byte*>( image.DataPtr() );
+  for ( size_t y = 0; data != nullptr && y < size[1]; ++ y )
+    key = HashFNV1a64( data + y * image.BPL(), size[0] * channels, key );
+
+  return key;
+}
+
+
+/******************************************************************//**
+* \brief   Name of the cache file for a cache key in a cache directory.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::string CHeightMapTransform::CacheFilename(
+  const std::string  &cache_directory, //!< in: cache directory
+  CMipmapChain::TKey  key )            //!< in: cache key
+{
+  char name[40];
+  std::snprintf( name, sizeof( name ), "heightmap_%016llx.cache", (unsigned long long)key );
+  if ( cache_directory.empty() )
+    return name;
+  char last = cache_directory.back();
+  return cache_directory + ( last == '/' || last == '\\' ? "" : "/" ) + name;
+}
+
+
+} // Render
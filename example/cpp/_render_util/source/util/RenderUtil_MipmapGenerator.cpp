@@ -0,0 +1,784 @@
+/******************************************************************//**
+* \brief   CPU mipmap chain generator for image resources.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_MipmapGenerator.h"
+#include "../../include/util/RenderUtil_Hash.h"
+#include "../../include/util/RenderUtil_Parallel.h"
+
+
+// STL
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+
+// SIMD
+
+#if defined(__AVX2__)
+#define RENDERUTIL_MIPMAP_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERUTIL_MIPMAP_SSE2
+#endif
+
+#if defined(RENDERUTIL_MIPMAP_AVX2) || defined(RENDERUTIL_MIPMAP_SSE2)
+#include <immintrin.h>
+#endif
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+//! magic number and version of the mipmap cache file
+const std::uint32_t c_cache_magic   = 0x434d5552; // "RUMC"
+const std::uint32_t c_cache_version = 1;
+
+//! maximum number of levels in a mipmap cache file (1x1 level of an extent of 2^32-1)
+const std::uint32_t c_cache_max_levels = 32;
+
+
+//! list of taps of the resampling filter for one target texel
+struct TFilterTaps
+{
+  std::vector<size_t> _index;  //!< source texel index
+  std::vector<float>  _weight; //!< normalized weight
+};
+
+
+//! number of color channels of a image format
+size_t FormatChannels( TImageFormat format )
+{
+  switch ( format )
+  {
+    case TImageFormat::GRAY8: return 1;
+    case TImageFormat::RGB8:
+    case TImageFormat::BGR8:  return 3;
+    case TImageFormat::RGBA8:
+    case TImageFormat::BGRA8: return 4;
+    default: break;
+  }
+  return 0;
+}
+
+
+//! look up table for the conversion of sRGB encoded bytes to linear values
+const std::array<float, 256> & SRGBToLinearTable( void )
+{
+  static const std::array<float, 256> table = []()
+  {
+    std::array<float, 256> t;
+    for ( size_t i = 0; i < t.size(); ++ i )
+    {
+      double c = (double)i / 255.0;
+      t[i] = (float)( c <= 0.04045 ? c / 12.92 : std::pow( (c + 0.055) / 1.055, 2.4 ) );
+    }
+    return t;
+  }();
+  return table;
+}
+
+
+//! look up table for the conversion of linear values to sRGB encoded bytes (12 bit precision)
+const std::array<t_byte, 4096> & LinearToSRGBTable( void )
+{
+  static const std::array<t_byte, 4096> table = []()
+  {
+    std::array<t_byte, 4096> t;
+    for ( size_t i = 0; i < t.size(); ++ i )
+    {
+      double l = (double)i / (double)(t.size() - 1);
+      double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow( l, 1.0 / 2.4 ) - 0.055;
+      t[i] = (t_byte)std::min( 255.0, std::max( 0.0, c * 255.0 + 0.5 ) );
+    }
+    return t;
+  }();
+  return table;
+}
+
+
+//! zeroth order modified bessel function of the first kind
+double BesselI0( double x )
+{
+  double sum  = 1.0;
+  double term = 1.0;
+  double y    = x * x / 4.0;
+  for ( int k = 1; k < 32 && term > sum * 1e-12; ++ k )
+  {
+    term *= y / ((double)k * (double)k);
+    sum  += term;
+  }
+  return sum;
+}
+
+
+double Sinc( double x )
+{
+  if ( std::fabs( x ) < 1e-8 )
+    return 1.0;
+  x *= 3.14159265358979323846;
+  return std::sin( x ) / x;
+}
+
+
+//! radius of the filter kernel in target texel units
+double FilterRadius( TMipmapFilter filter )
+{
+  switch ( filter )
+  {
+    default:
+    case TMipmapFilter::box:     return 0.5;
+    case TMipmapFilter::kaiser:  return 3.0;
+    case TMipmapFilter::lanczos: return 3.0;
+  }
+}
+
+
+//! evaluate the filter kernel; `t` is the distance in target texel units
+double FilterKernel( TMipmapFilter filter, double t )
+{
+  t = std::fabs( t );
+  switch ( filter )
+  {
+    default:
+    case TMipmapFilter::box:
+      return t < 0.5 ? 1.0 : (t == 0.5 ? 0.5 : 0.0);
+
+    case TMipmapFilter::kaiser:
+    {
+      static const double alpha = 4.0;
+      static const double i0_alpha = BesselI0( alpha );
+      const double r = 3.0;
+      if ( t >= r )
+        return 0.0;
+      double q = t / r;
+      return Sinc( t ) * BesselI0( alpha * std::sqrt( 1.0 - q*q ) ) / i0_alpha;
+    }
+
+    case TMipmapFilter::lanczos:
+    {
+      const double r = 3.0;
+      return t < r ? Sinc( t ) * Sinc( t / r ) : 0.0;
+    }
+  }
+}
+
+
+//! compute the filter taps for the resampling of one dimension from `source_size` to `target_size`
+std::vector<TFilterTaps> FilterTaps( TMipmapFilter filter, TTextureWrap wrap, size_t source_size, size_t target_size )
+{
+  std::vector<TFilterTaps> taps( target_size );
+  double scale  = (double)source_size / (double)target_size;
+  double radius = FilterRadius( filter ) * std::max( scale, 1.0 );
+  bool   tiled  = wrap == TTextureWrap::tiled || wrap == TTextureWrap::tiled_mirrored;
+
+  for ( size_t i = 0; i < target_size; ++ i )
+  {
+    TFilterTaps &tap = taps[i];
+    double center = ((double)i + 0.5) * scale;
+    long long i0 = (long long)std::floor( center - radius );
+    long long i1 = (long long)std::ceil( center + radius );
+
+    double sum = 0.0;
+    std::vector<double> weights;
+    for ( long long j = i0; j <= i1; ++ j )
+    {
+      double w = FilterKernel( filter, ((double)j + 0.5 - center) / std::max( scale, 1.0 ) );
+      if ( w == 0.0 )
+        continue;
+
+      long long n = (long long)source_size;
+      long long k = tiled ? ((j % n) + n) % n : std::min( std::max( j, 0LL ), n - 1 );
+      auto it = std::find( tap._index.begin(), tap._index.end(), (size_t)k );
+      if ( it != tap._index.end() )
+      {
+        weights[it - tap._index.begin()] += w;
+      }
+      else
+      {
+        tap._index.push_back( (size_t)k );
+        weights.push_back( w );
+      }
+      sum += w;
+    }
+
+    tap._weight.resize( weights.size() );
+    for ( size_t j = 0; j < weights.size(); ++ j )
+      tap._weight[j] = (float)(sum != 0.0 ? weights[j] / sum : 0.0);
+  }
+  return taps;
+}
+
+
+//! `target += weight * source` for `count` floats
+void MultiplyAdd( float *target, const float *source, float weight, size_t count )
+{
+  size_t i = 0;
+#if defined(RENDERUTIL_MIPMAP_AVX2)
+  __m256 w8 = _mm256_set1_ps( weight );
+  for ( ; i + 8 <= count; i += 8 )
+    _mm256_storeu_ps( target + i, _mm256_add_ps( _mm256_loadu_ps( target + i ), _mm256_mul_ps( w8, _mm256_loadu_ps( source + i ) ) ) );
+#endif
+#if defined(RENDERUTIL_MIPMAP_SSE2)
+  __m128 w4 = _mm_set1_ps( weight );
+  for ( ; i + 4 <= count; i += 4 )
+    _mm_storeu_ps( target + i, _mm_add_ps( _mm_loadu_ps( target + i ), _mm_mul_ps( w4, _mm_loadu_ps( source + i ) ) ) );
+#endif
+  for ( ; i < count; ++ i )
+    target[i] += weight * source[i];
+}
+
+
+//! resample a level of 4 channel floating point texels
+void ResampleLevel(
+  const TMipmapParameters  &param,
+  const std::vector<float> &source,
+  size_t                    source_cx,
+  size_t                    source_cy,
+  std::vector<float>       &target,
+  size_t                    target_cx,
+  size_t                    target_cy )
+{
+  auto taps_x = FilterTaps( param._filter, param._wrap, source_cx, target_cx );
+  auto taps_y = FilterTaps( param._filter, param._wrap, source_cy, target_cy );
+
+  std::vector<float> temp( source_cx * target_cy * 4 );
+  target.assign( target_cx * target_cy * 4, 0.0f );
+
+  // vertical pass: each target row is a weighted sum of complete source rows
+  ParallelFor( 0, target_cy, 8, param._threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t y = begin; y < end; ++ y )
+    {
+      float *row = temp.data() + y * source_cx * 4;
+      std::fill( row, row + source_cx * 4, 0.0f );
+      const TFilterTaps &tap = taps_y[y];
+      for ( size_t k = 0; k < tap._index.size(); ++ k )
+        MultiplyAdd( row, source.data() + tap._index[k] * source_cx * 4, tap._weight[k], source_cx * 4 );
+    }
+  } );
+
+  // horizontal pass: each target texel is a weighted sum of 4 channel texels
+  ParallelFor( 0, target_cy, 8, param._threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t y = begin; y < end; ++ y )
+    {
+      const float *row = temp.data() + y * source_cx * 4;
+      float *target_row = target.data() + y * target_cx * 4;
+      for ( size_t x = 0; x < target_cx; ++ x )
+      {
+        const TFilterTaps &tap = taps_x[x];
+#if defined(RENDERUTIL_MIPMAP_SSE2)
+        __m128 sum = _mm_setzero_ps();
+        for ( size_t k = 0; k < tap._index.size(); ++ k )
+          sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( tap._weight[k] ), _mm_loadu_ps( row + tap._index[k] * 4 ) ) );
+        _mm_storeu_ps( target_row + x * 4, sum );
+#else
+        float sum[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+        for ( size_t k = 0; k < tap._index.size(); ++ k )
+        {
+          const float *texel = row + tap._index[k] * 4;
+          for ( int c = 0; c < 4; ++ c )
+            sum[c] += tap._weight[k] * texel[c];
+        }
+        std::memcpy( target_row + x * 4, sum, sizeof( sum ) );
+#endif
+      }
+    }
+  } );
+}
+
+
+//! renormalize the normal vectors of a level
+void NormalizeLevel( const TMipmapParameters &param, std::vector<float> &texels )
+{
+  size_t no_of_texels = texels.size() / 4;
+  ParallelFor( 0, no_of_texels, 4096, param._threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t i = begin; i < end; ++ i )
+    {
+      float *n = texels.data() + i * 4;
+      float len = std::sqrt( n[0]*n[0] + n[1]*n[1] + n[2]*n[2] );
+      if ( len > 1e-6f )
+      {
+        n[0] /= len; n[1] /= len; n[2] /= len;
+      }
+      else
+      {
+        n[0] = 0.0f; n[1] = 0.0f; n[2] = 1.0f;
+      }
+    }
+  } );
+}
+
+
+//! fraction of the texels, which pass the alpha test
+float AlphaCoverage( const std::vector<float> &texels, float reference, float scale )
+{
+  size_t no_of_texels = texels.size() / 4;
+  if ( no_of_texels == 0 )
+    return 0.0f;
+  size_t passed = 0;
+  for ( size_t i = 0; i < no_of_texels; ++ i )
+    passed += texels[i*4 + 3] * scale > reference ? 1 : 0;
+  return (float)passed / (float)no_of_texels;
+}
+
+
+//! find the alpha scale, which preserves the alpha coverage (binary search)
+float AlphaCoverageScale( const std::vector<float> &texels, float reference, float coverage )
+{
+  float min_scale = 0.0f;
+  float max_scale = 4.0f;
+  float scale     = 1.0f;
+  for ( int i = 0; i < 12; ++ i )
+  {
+    float current = AlphaCoverage( texels, reference, scale );
+    if ( current < coverage )
+      min_scale = scale;
+    else if ( current > coverage )
+      max_scale = scale;
+    else
+      break;
+    scale = 0.5f * (min_scale + max_scale);
+  }
+  return scale;
+}
+
+
+//! decode a byte image to 4 channel linear floating point texels
+void DecodeLevel( const TMipmapParameters &param, const IImageResource &image, size_t channels, std::vector<float> &texels )
+{
+  const auto &to_linear = SRGBToLinearTable();
+  TTextureSize size = image.Size();
+  size_t cx = size[0];
+  size_t cy = size[1];
+  const t_byte *data = static_cast<const t_byte*>( image.DataPtr() );
+  size_t bpl = image.BPL();
+
+  texels.resize( cx * cy * 4 );
+  ParallelFor( 0, cy, 16, param._threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t y = begin; y < end; ++ y )
+    {
+      const t_byte *row = data + y * bpl;
+      float *target = texels.data() + y * cx * 4;
+      for ( size_t x = 0; x < cx; ++ x, target += 4 )
+      {
+        const t_byte *texel = row + x * channels;
+        for ( size_t c = 0; c < 3; ++ c )
+        {
+          t_byte b = texel[std::min( c, channels - 1 )];
+          if ( param._normal_map )
+            target[c] = (float)b / 127.5f - 1.0f;
+          else if ( param._srgb )
+            target[c] = to_linear[b];
+          else
+            target[c] = (float)b / 255.0f;
+        }
+        target[3] = channels == 4 ? (float)texel[3] / 255.0f : 1.0f;
+      }
+    }
+  } );
+}
+
+
+//! encode 4 channel linear floating point texels to a byte image
+void EncodeLevel( const TMipmapParameters &param, const std::vector<float> &texels, float alpha_scale, CMipmapImage &image )
+{
+  const auto &to_srgb = LinearToSRGBTable();
+  size_t channels     = image.Channels();
+  size_t no_of_texels = texels.size() / 4;
+  auto  &data         = image.Data();
+
+  ParallelFor( 0, no_of_texels, 4096, param._threads, [&]( size_t begin, size_t end )
+  {
+    for ( size_t i = begin; i < end; ++ i )
+    {
+      const float *texel = texels.data() + i * 4;
+      t_byte *target = data.data() + i * channels;
+      for ( size_t c = 0; c < std::min( channels, (size_t)3 ); ++ c )
+      {
+        float v = texel[c];
+        if ( param._normal_map )
+          target[c] = (t_byte)std::min( 255.0f, std::max( 0.0f, (v * 0.5f + 0.5f) * 255.0f + 0.5f ) );
+        else if ( param._srgb )
+          target[c] = to_srgb[(size_t)( std::min( 1.0f, std::max( 0.0f, v ) ) * (float)(to_srgb.size() - 1) + 0.5f )];
+        else
+          target[c] = (t_byte)std::min( 255.0f, std::max( 0.0f, v * 255.0f + 0.5f ) );
+      }
+      if ( channels == 4 )
+        target[3] = (t_byte)std::min( 255.0f, std::max( 0.0f, texel[3] * alpha_scale * 255.0f + 0.5f ) );
+    }
+  } );
+}
+
+
+} // anonymous namespace
+
+
+//---------------------------------------------------------------------
+// CMipmapImage
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CMipmapImage::CMipmapImage(
+  TImageKind   kind,   //!< in: kind of the image content
+  TImageFormat format, //!< in: texel format
+  size_t       cx,     //!< in: width
+  size_t       cy )    //!< in: height
+  : _kind( kind )
+  , _format( format )
+  , _cx( cx )
+  , _cy( cy )
+  , _channels( FormatChannels( format ) )
+  , _data( cx * cy * FormatChannels( format ), 0 )
+{}
+
+
+//---------------------------------------------------------------------
+// CMipmapChain
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   List of image resources, which can be passed to
+* `ITextureLoader::CreateTexture`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::vector<const IImageResource*> CMipmapChain::Images( void ) const
+{
+  std::vector<const IImageResource*> images;
+  images.reserve( _levels.size() );
+  for ( auto &level : _levels )
+    images.push_back( &level );
+  return images;
+}
+
+
+/******************************************************************//**
+* \brief   Write the chain to a cache file.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CMipmapChain::Save(
+  const std::string &filename, //!< in: path of the cache file
+  TKey               key )     //!< in: cache key of the source image and the generator parameters
+  const
+{
+  std::ofstream stream( filename, std::ios::binary | std::ios::trunc );
+  if ( stream.is_open() == false )
+    return false;
+
+  auto write = [&]( const auto &value ) { stream.write( reinterpret_cast<const char*>( &value ), sizeof( value ) ); };
+
+  write( c_cache_magic );
+  write( c_cache_version );
+  write( key );
+  write( (std::uint32_t)_levels.size() );
+  for ( auto &level : _levels )
+  {
+    TTextureSize size = level.Size();
+    write( (std::uint32_t)level.Kind() );
+    write( (std::uint32_t)level.Format() );
+    write( (std::uint32_t)size[0] );
+    write( (std::uint32_t)size[1] );
+    stream.write( reinterpret_cast<const char*>( level.Data().data() ), level.Data().size() );
+  }
+  return stream.good();
+}
+
+
+/******************************************************************//**
+* \brief   Read the chain from a cache file, if the key matches.
+*
+* The header of the file is validated before anything is allocated:
+* the number of levels is limited, the extents of the levels have to
+* halve successively and the data of each level have to fit into the
+* rest of the file. A file, which does not match, is rejected, so the
+* chain is generated again.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CMipmapChain::Load(
+  const std::string &filename, //!< in: path of the cache file
+  TKey               key )     //!< in: expected cache key
+{
+  std::ifstream stream( filename, std::ios::binary | std::ios::ate );
+  if ( stream.is_open() == false )
+    return false;
+  std::streamoff file_size = stream.tellg();
+  stream.seekg( 0 );
+  if ( file_size < 0 )
+    return false;
+
+  auto read = [&]( auto &value ) { stream.read( reinterpret_cast<char*>( &value ), sizeof( value ) ); return stream.good(); };
+
+  std::uint32_t magic = 0, version = 0, no_of_levels = 0;
+  TKey file_key = 0;
+  if ( read( magic ) == false || magic != c_cache_magic ||
+       read( version ) == false || version != c_cache_version ||
+       read( file_key ) == false || file_key != key ||
+       read( no_of_levels ) == false )
+    return false;
+  if ( no_of_levels == 0 || no_of_levels > c_cache_max_levels )
+    return false;
+
+  std::vector<CMipmapImage> levels;
+  levels.reserve( no_of_levels );
+  size_t expected_cx = 0, expected_cy = 0;
+  for ( std::uint32_t i = 0; i < no_of_levels; ++ i )
+  {
+    std::uint32_t kind = 0, format = 0, cx = 0, cy = 0;
+    if ( read( kind ) == false || read( format ) == false || read( cx ) == false || read( cy ) == false )
+      return false;
+    size_t channels = FormatChannels( (TImageFormat)format );
+    if ( channels == 0 || cx == 0 || cy == 0 )
+      return false;
+
+    // the extents of the levels have to halve successively, like the extents of a generated chain
+    if ( i > 0 && ( cx != expected_cx || cy != expected_cy ) )
+      return false;
+    expected_cx = std::max( (size_t)cx / 2, (size_t)1 );
+    expected_cy = std::max( (size_t)cy / 2, (size_t)1 );
+
+    // the data of the level have to fit into the rest of the file
+    std::streamoff position = stream.tellg();
+    if ( position < 0 || position > file_size )
+      return false;
+    size_t remaining = (size_t)( file_size - position );
+    if ( (size_t)cx > remaining / cy / channels )
+      return false;
+
+    levels.emplace_back( (TImageKind)kind, (TImageFormat)format, cx, cy );
+    auto &data = levels.back().Data();
+    stream.read( reinterpret_cast<char*>( data.data() ), data.size() );
+    if ( stream.good() == false )
+      return false;
+  }
+
+  _levels = std::move( levels );
+  return true;
+}
+
+
+//---------------------------------------------------------------------
+// CMipmapGenerator
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CMipmapGenerator::CMipmapGenerator(
+  const TMipmapParameters &parameters ) //!< in: generator parameters
+  : _parameters( parameters )
+{}
+
+
+/******************************************************************//**
+* \brief   Number of the levels of a mipmap chain.
+*
+* The chain ends with the 1x1 level, like the chain, which is generated
+* by `glGenerateMipmap`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CMipmapGenerator::NumberOfLevels(
+  size_t cx,         //!< in: width of level 0
+  size_t cy,         //!< in: height of level 0
+  size_t max_levels ) //!< in: maximum number of levels; 0: no limit
+{
+  size_t levels = 1;
+  for ( size_t n = std::max( cx, cy ); n > 1; n /= 2 )
+    ++ levels;
+  return max_levels > 0 ? std::min( levels, max_levels ) : levels;
+}
+
+
+/******************************************************************//**
+* \brief   Cache key of an image, which is generated with the current
+* parameters.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CMipmapChain::TKey CMipmapGenerator::Key(
+  const IImageResource &image ) //!< in: source image
+  const
+{
+  CMipmapChain::TKey key = c_fnv1a_64_basis;
+
+  TTextureSize  size     = image.Size();
+  TImageFormat  format   = image.Format();
+  size_t        channels = FormatChannels( format );
+  std::uint64_t header[]{ (std::uint64_t)size[0], (std::uint64_t)size[1], (std::uint64_t)format, (std::uint64_t)image.Kind() };
+  key = HashFNV1a64( header, sizeof( header ), key );
+
+  std::uint64_t parameters[]{
+    (std::uint64_t)_parameters._filter, (std::uint64_t)_parameters._wrap, (std::uint64_t)_parameters._srgb,
+    (std::uint64_t)_parameters._normal_map, (std::uint64_t)_parameters._alpha_coverage, (std::uint64_t)( _parameters._alpha_reference * 65535.0f ),
+    (std::uint64_t)_parameters._max_levels
+  };
+  key = HashFNV1a64( parameters, sizeof( parameters ), key );
+
+  const t_byte *data = static_cast<const t_byte*>( image.DataPtr() );
+  for ( size_t y = 0; data != nullptr && y < size[1]; ++ y )
+    key = HashFNV1a64( data + y * image.BPL(), size[0] * channels, key );
+
+  return key;
+}
+
+
+/******************************************************************//**
+* \brief   Generate the complete mipmap chain of a 2 dimensional image.
+*
+* Each level is generated from the floating point texels of the
+* previous level, so the chain is not degraded by the quantization to
+* bytes. Level 0 is a tightly packed copy of the source image.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CMipmapGenerator::Generate(
+  const IImageResource &image,    //!< in: source image
+  CMipmapChain         &chain )   //!< out: generated mipmap chain
+  const
+{
+  size_t channels = FormatChannels( image.Format() );
+  TTextureSize size = image.Size();
+  if ( channels == 0 || image.Type() != TTextureType::T2D || size[0] == 0 || size[1] == 0 || image.DataPtr() == nullptr )
+  {
+    std::cout << "error: mipmap generation requires a 2 dimensional 8 bit image" << std::endl;
+    return false;
+  }
+
+  const TMipmapParameters &param = _parameters;
+  size_t no_of_levels = NumberOfLevels( size[0], size[1], param._max_levels );
+
+  auto &levels = chain.LevelList();
+  levels.clear();
+  levels.reserve( no_of_levels );
+
+  // level 0: tightly packed copy of the source image
+  levels.emplace_back( image.Kind(), image.Format(), size[0], size[1] );
+  const t_byte *source = static_cast<const t_byte*>( image.DataPtr() );
+  for ( size_t y = 0; y < size[1]; ++ y )
+    std::memcpy( levels[0].Data().data() + y * size[0] * channels, source + y * image.BPL(), size[0] * channels );
+
+  // decode level 0
+  std::vector<float> current, next;
+  DecodeLevel( param, image, channels, current );
+
+  float alpha_reference = param._alpha_reference;
+  float coverage = param._alpha_coverage && channels == 4 ? AlphaCoverage( current, alpha_reference, 1.0f ) : 0.0f;
+
+  size_t cx = size[0];
+  size_t cy = size[1];
+  for ( size_t level = 1; level < no_of_levels; ++ level )
+  {
+    size_t next_cx = std::max( cx / 2, (size_t)1 );
+    size_t next_cy = std::max( cy / 2, (size_t)1 );
+    ResampleLevel( param, current, cx, cy, next, next_cx, next_cy );
+    if ( param._normal_map )
+      NormalizeLevel( param, next );
+
+    float alpha_scale = param._alpha_coverage && channels == 4 ? AlphaCoverageScale( next, alpha_reference, coverage ) : 1.0f;
+
+    levels.emplace_back( image.Kind(), image.Format(), next_cx, next_cy );
+    EncodeLevel( param, next, alpha_scale, levels.back() );
+
+    std::swap( current, next );
+    cx = next_cx;
+    cy = next_cy;
+  }
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Load the mipmap chain from the cache file, or generate it
+* and store it to the cache file.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CMipmapGenerator::Generate(
+  const IImageResource &image,            //!< in: source image
+  CMipmapChain         &chain,            //!< out: generated mipmap chain
+  const std::string    &cache_filename )  //!< in: path of the cache file
+  const
+{
+  CMipmapChain::TKey key = Key( image );
+  if ( chain.Load( cache_filename, key ) )
+    return true;
+
+  if ( Generate( image, chain ) == false )
+    return false;
+
+  if ( chain.Save( cache_filename, key ) == false )
+    std::cout << "warning: failed to write mipmap cache file " << cache_filename << std::endl;
+  return true;
+}
+
+
+} // Render
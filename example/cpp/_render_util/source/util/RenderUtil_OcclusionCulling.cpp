@@ -0,0 +1,629 @@
+/******************************************************************//**
+* \brief   Occlusion culling by a software depth buffer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_OcclusionCulling.h"
+#include "../../include/util/RenderUtil_Parallel.h"
+
+
+// STL
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+
+// SIMD
+
+#if defined(__AVX2__)
+#define RENDERUTIL_OCCLUSION_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERUTIL_OCCLUSION_SSE2
+#endif
+
+#if defined(RENDERUTIL_OCCLUSION_AVX2) || defined(RENDERUTIL_OCCLUSION_SSE2)
+#include <immintrin.h>
+#endif
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+const size_t c_tile_pixels = COcclusionCuller::c_tile_size * COcclusionCuller::c_tile_size;
+
+
+#if defined(RENDERUTIL_OCCLUSION_AVX2)
+
+//! 8 float lanes
+struct TLanesAVX2
+{
+  using T = __m256;
+  static const size_t c_width = 8;
+
+  static T    Set( float v )               { return _mm256_set1_ps( v ); }
+  static T    Offsets( void )              { return _mm256_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f ); }
+  static T    Load( const float *p )       { return _mm256_loadu_ps( p ); }
+  static void Store( float *p, T v )       { _mm256_storeu_ps( p, v ); }
+  static T    Add( T a, T b )              { return _mm256_add_ps( a, b ); }
+  static T    Mul( T a, T b )              { return _mm256_mul_ps( a, b ); }
+  static T    Min( T a, T b )              { return _mm256_min_ps( a, b ); }
+  static T    Ge( T a, T b )               { return _mm256_cmp_ps( a, b, _CMP_GE_OQ ); }
+  static T    Gt( T a, T b )               { return _mm256_cmp_ps( a, b, _CMP_GT_OQ ); }
+  static T    And( T a, T b )              { return _mm256_and_ps( a, b ); }
+  static T    Select( T mask, T a, T b )   { return _mm256_blendv_ps( b, a, mask ); }
+  static int  Bits( T a )                  { return _mm256_movemask_ps( a ); }
+};
+
+#endif
+
+#if defined(RENDERUTIL_OCCLUSION_SSE2)
+
+//! 4 float lanes
+struct TLanesSSE2
+{
+  using T = __m128;
+  static const size_t c_width = 4;
+
+  static T    Set( float v )               { return _mm_set1_ps( v ); }
+  static T    Offsets( void )              { return _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f ); }
+  static T    Load( const float *p )       { return _mm_loadu_ps( p ); }
+  static void Store( float *p, T v )       { _mm_storeu_ps( p, v ); }
+  static T    Add( T a, T b )              { return _mm_add_ps( a, b ); }
+  static T    Mul( T a, T b )              { return _mm_mul_ps( a, b ); }
+  static T    Min( T a, T b )              { return _mm_min_ps( a, b ); }
+  static T    Ge( T a, T b )               { return _mm_cmpge_ps( a, b ); }
+  static T    Gt( T a, T b )               { return _mm_cmpgt_ps( a, b ); }
+  static T    And( T a, T b )              { return _mm_and_ps( a, b ); }
+  static T    Select( T mask, T a, T b )   { return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) ); }
+  static int  Bits( T a )                  { return _mm_movemask_ps( a ); }
+};
+
+#endif
+
+
+#if defined(RENDERUTIL_OCCLUSION_AVX2) || defined(RENDERUTIL_OCCLUSION_SSE2)
+
+//! coverage and depth of one row of a tile; the depth of the covered pixels is the minimum of the old and the new depth
+template <class TLanes>
+void RasterizeTileRow(
+  float                       *depth, //!< IO - depth of the 8 pixels of the row
+  float                        x,     //!< I - x coordinate of the center of the first pixel
+  const std::array<float, 3>  &a,     //!< I - x coefficients of the edge functions
+  const std::array<float, 3>  &t,     //!< I - edge functions at x = 0 (`b * y + c`)
+  float                        za,    //!< I - x coefficient of the depth plane
+  float                        zt )   //!< I - depth plane at x = 0
+{
+  using T = typename TLanes::T;
+  const T zero = TLanes::Set( 0.0f );
+  for ( size_t i = 0; i < COcclusionCuller::c_tile_size; i += TLanes::c_width )
+  {
+    T px = TLanes::Add( TLanes::Set( x + (float)i ), TLanes::Offsets() );
+    T mask = TLanes::Ge( TLanes::Add( TLanes::Mul( TLanes::Set( a[0] ), px ), TLanes::Set( t[0] ) ), zero );
+    mask = TLanes::And( mask, TLanes::Ge( TLanes::Add( TLanes::Mul( TLanes::Set( a[1] ), px ), TLanes::Set( t[1] ) ), zero ) );
+    mask = TLanes::And( mask, TLanes::Ge( TLanes::Add( TLanes::Mul( TLanes::Set( a[2] ), px ), TLanes::Set( t[2] ) ), zero ) );
+    if ( TLanes::Bits( mask ) == 0 )
+      continue;
+    T z = TLanes::Add( TLanes::Mul( TLanes::Set( za ), px ), TLanes::Set( zt ) );
+    T d = TLanes::Load( depth + i );
+    TLanes::Store( depth + i, TLanes::Select( mask, TLanes::Min( d, z ), d ) );
+  }
+}
+
+
+//! true, if a pixel of a row of a tile is behind `z`; `columns` masks the pixels of the row
+template <class TLanes>
+bool AnyBehind( const float *depth, float z, unsigned int columns )
+{
+  const typename TLanes::T tz = TLanes::Set( z );
+  for ( size_t i = 0; i < COcclusionCuller::c_tile_size; i += TLanes::c_width )
+  {
+    unsigned int bits = (unsigned int)TLanes::Bits( TLanes::Gt( TLanes::Load( depth + i ), tz ) );
+    if ( (bits & (columns >> i)) != 0 )
+      return true;
+  }
+  return false;
+}
+
+#else
+
+//! coverage and depth of one row of a tile; the depth of the covered pixels is the minimum of the old and the new depth
+template <class TLanes>
+void RasterizeTileRow(
+  float                       *depth, //!< IO - depth of the 8 pixels of the row
+  float                        x,     //!< I - x coordinate of the center of the first pixel
+  const std::array<float, 3>  &a,     //!< I - x coefficients of the edge functions
+  const std::array<float, 3>  &t,     //!< I - edge functions at x = 0 (`b * y + c`)
+  float                        za,    //!< I - x coefficient of the depth plane
+  float                        zt )   //!< I - depth plane at x = 0
+{
+  for ( size_t i = 0; i < COcclusionCuller::c_tile_size; ++ i )
+  {
+    float px = x + (float)i;
+    if ( a[0] * px + t[0] >= 0.0f && a[1] * px + t[1] >= 0.0f && a[2] * px + t[2] >= 0.0f )
+      depth[i] = std::min( depth[i], za * px + zt );
+  }
+}
+
+
+//! true, if a pixel of a row of a tile is behind `z`; `columns` masks the pixels of the row
+template <class TLanes>
+bool AnyBehind( const float *depth, float z, unsigned int columns )
+{
+  for ( size_t i = 0; i < COcclusionCuller::c_tile_size; ++ i )
+  {
+    if ( (columns & (1u << i)) != 0 && depth[i] > z )
+      return true;
+  }
+  return false;
+}
+
+#endif
+
+
+#if defined(RENDERUTIL_OCCLUSION_AVX2)
+using TLanes = TLanesAVX2;
+#elif defined(RENDERUTIL_OCCLUSION_SSE2)
+using TLanes = TLanesSSE2;
+#else
+struct TLanes {};
+#endif
+
+
+//! product of 2 column major matrices
+TMat44 Multiply( const TMat44 &a, const TMat44 &b )
+{
+  TMat44 m{};
+  for ( int c = 0; c < 4; ++ c )
+  {
+    for ( int r = 0; r < 4; ++ r )
+      m[c][r] = a[0][r] * b[c][0] + a[1][r] * b[c][1] + a[2][r] * b[c][2] + a[3][r] * b[c][3];
+  }
+  return m;
+}
+
+
+//! transform a point to clip space
+TVec4 Transform( const TMat44 &m, float x, float y, float z )
+{
+  TVec4 v;
+  for ( int r = 0; r < 4; ++ r )
+    v[r] = m[0][r] * x + m[1][r] * y + m[2][r] * z + m[3][r];
+  return v;
+}
+
+
+//! distance to the near plane in clip space (`z >= -w`)
+inline float NearDistance( const TVec4 &v )
+{
+  return v[2] + v[3];
+}
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   Constructor; the size is rounded up to whole tiles.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+COcclusionCuller::COcclusionCuller(
+  size_t width,         //!< I - width of the depth buffer
+  size_t height,        //!< I - height of the depth buffer
+  size_t no_of_threads ) //!< I - number of threads of the rasterizer and the tests (0: default concurrency)
+  : _tiles_x( std::max( (width + c_tile_size - 1) / c_tile_size, (size_t)1 ) )
+  , _tiles_y( std::max( (height + c_tile_size - 1) / c_tile_size, (size_t)1 ) )
+  , _no_of_threads( no_of_threads )
+{
+  _width  = _tiles_x * c_tile_size;
+  _height = _tiles_y * c_tile_size;
+  _depth.assign( _width * _height, 1.0f );
+  _tile_depth.assign( _tiles_x * _tiles_y, 1.0f );
+  _bins.resize( _tiles_y );
+}
+
+
+/******************************************************************//**
+* \brief   Start a frame: clear the depth buffer and the triangles.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void COcclusionCuller::Begin(
+  const TMat44 &view_projection ) //!< I - view projection matrix
+{
+  _view_projection = view_projection;
+  std::fill( _depth.begin(), _depth.end(), 1.0f );
+  std::fill( _tile_depth.begin(), _tile_depth.end(), 1.0f );
+  _triangles.clear();
+  _statistics = TStatistics();
+}
+
+
+/******************************************************************//**
+* \brief   Transform, clip and set up the triangles of an occluder.
+*
+* Triangles which are entirely outside of a plane of the frustum are
+* skipped; triangles which intersect the near plane are clipped.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void COcclusionCuller::Render(
+  const TOccluder &occluder, //!< I - occluder mesh
+  const TMat44    &model )   //!< I - model matrix of the occluder
+{
+  TMat44 m = Multiply( _view_projection, model );
+  std::vector<TVec4> clip;
+  clip.reserve( occluder._vertices.size() );
+  for ( auto &v : occluder._vertices )
+    clip.push_back( Transform( m, v[0], v[1], v[2] ) );
+
+  for ( size_t i = 0; i + 2 < occluder._indices.size(); i += 3 )
+  {
+    ++ _statistics._occluder_triangles;
+    const TVec4 *v[3]{ &clip[occluder._indices[i]], &clip[occluder._indices[i + 1]], &clip[occluder._indices[i + 2]] };
+
+    // outside of a plane of the frustum
+    bool outside = false;
+    for ( int k = 0; k < 3 && outside == false; ++ k )
+    {
+      outside =
+        ((*v[0])[k] >  (*v[0])[3] && (*v[1])[k] >  (*v[1])[3] && (*v[2])[k] >  (*v[2])[3]) ||
+        ((*v[0])[k] < -(*v[0])[3] && (*v[1])[k] < -(*v[1])[3] && (*v[2])[k] < -(*v[2])[3]);
+    }
+    if ( outside )
+      continue;
+
+    // clip at the near plane
+    float d[3]{ NearDistance( *v[0] ), NearDistance( *v[1] ), NearDistance( *v[2] ) };
+    if ( d[0] >= 0.0f && d[1] >= 0.0f && d[2] >= 0.0f )
+    {
+      SetupTriangle( *v[0], *v[1], *v[2] );
+      continue;
+    }
+    std::array<TVec4, 4> polygon;
+    size_t n = 0;
+    for ( int j = 0; j < 3; ++ j )
+    {
+      int k = (j + 1) % 3;
+      if ( d[j] >= 0.0f )
+        polygon[n ++] = *v[j];
+      if ( (d[j] >= 0.0f) != (d[k] >= 0.0f) )
+      {
+        float t = d[j] / (d[j] - d[k]);
+        TVec4 p;
+        for ( int c = 0; c < 4; ++ c )
+          p[c] = (*v[j])[c] + t * ((*v[k])[c] - (*v[j])[c]);
+        polygon[n ++] = p;
+      }
+    }
+    for ( size_t j = 1; j + 1 < n; ++ j )
+      SetupTriangle( polygon[0], polygon[j], polygon[j + 1] );
+  }
+}
+
+
+/******************************************************************//**
+* \brief   Rasterize the triangles to the depth buffer.
+*
+* The triangles are binned to the rows of tiles; the rows are
+* rasterized in parallel.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void COcclusionCuller::Rasterize( void )
+{
+  for ( auto &bin : _bins )
+    bin.clear();
+  for ( size_t i = 0; i < _triangles.size(); ++ i )
+  {
+    const TTriangle &triangle = _triangles[i];
+    for ( size_t row = (size_t)triangle._y0 / c_tile_size; row <= (size_t)triangle._y1 / c_tile_size; ++ row )
+      _bins[row].push_back( (std::uint32_t)i );
+  }
+
+  ParallelFor( 0, _tiles_y, 1, _no_of_threads, [this]( size_t begin, size_t end )
+  {
+    for ( size_t row = begin; row < end; ++ row )
+      RasterizeRow( row );
+  } );
+}
+
+
+/******************************************************************//**
+* \brief   Depth of a pixel.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+float COcclusionCuller::Depth(
+  size_t x,  //!< I - column
+  size_t y ) //!< I - row (0 is the bottom row)
+  const
+{
+  size_t tile = (y / c_tile_size) * _tiles_x + x / c_tile_size;
+  return _depth[tile * c_tile_pixels + (y % c_tile_size) * c_tile_size + x % c_tile_size];
+}
+
+
+/******************************************************************//**
+* \brief   Test a world space box against the depth buffer.
+*
+* A box which intersects the near plane is visible. A box which is
+* outside of the viewport or behind the far plane is not visible.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool COcclusionCuller::Visible(
+  const TBoundingBox &box ) //!< I - world space bounding box
+  const
+{
+  float x_min = 1.0f, x_max = -1.0f, y_min = 1.0f, y_max = -1.0f, z_min = 1.0f;
+  for ( int i = 0; i < 8; ++ i )
+  {
+    TVec4 v = Transform( _view_projection, (i & 1) ? box._max[0] : box._min[0], (i & 2) ? box._max[1] : box._min[1], (i & 4) ? box._max[2] : box._min[2] );
+    if ( NearDistance( v ) <= 0.0f )
+      return true;
+    float x = v[0] / v[3], y = v[1] / v[3], z = v[2] / v[3];
+    x_min = std::min( x_min, x );
+    x_max = std::max( x_max, x );
+    y_min = std::min( y_min, y );
+    y_max = std::max( y_max, y );
+    z_min = std::min( z_min, z );
+  }
+  if ( x_max < -1.0f || x_min > 1.0f || y_max < -1.0f || y_min > 1.0f || z_min > 1.0f )
+    return false;
+
+  // pixels which are touched by the screen rectangle
+  float depth = z_min * 0.5f + 0.5f;
+  int px0 = std::max( (int)std::floor( (x_min * 0.5f + 0.5f) * (float)_width ), 0 );
+  int px1 = std::min( (int)std::ceil( (x_max * 0.5f + 0.5f) * (float)_width ) - 1, (int)_width - 1 );
+  int py0 = std::max( (int)std::floor( (y_min * 0.5f + 0.5f) * (float)_height ), 0 );
+  int py1 = std::min( (int)std::ceil( (y_max * 0.5f + 0.5f) * (float)_height ) - 1, (int)_height - 1 );
+  px1 = std::max( px1, px0 );
+  py1 = std::max( py1, py0 );
+
+  const int tile_size = (int)c_tile_size;
+  for ( int ty = py0 / tile_size; ty <= py1 / tile_size; ++ ty )
+  {
+    for ( int tx = px0 / tile_size; tx <= px1 / tile_size; ++ tx )
+    {
+      size_t tile = (size_t)ty * _tiles_x + (size_t)tx;
+      if ( _tile_depth[tile] <= depth )
+        continue;
+
+      int x0 = std::max( px0 - tx * tile_size, 0 ), x1 = std::min( px1 - tx * tile_size, tile_size - 1 );
+      int y0 = std::max( py0 - ty * tile_size, 0 ), y1 = std::min( py1 - ty * tile_size, tile_size - 1 );
+      unsigned int columns = ((1u << (x1 + 1)) - 1) & ~((1u << x0) - 1);
+      const float *pixels = _depth.data() + tile * c_tile_pixels;
+      for ( int y = y0; y <= y1; ++ y )
+      {
+        if ( AnyBehind<TLanes>( pixels + y * c_tile_size, depth, columns ) )
+          return true;
+      }
+    }
+  }
+  return false;
+}
+
+
+/******************************************************************//**
+* \brief   Test boxes in parallel.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void COcclusionCuller::Test(
+  const std::vector<TBoundingBox> &boxes,    //!< I - world space bounding boxes
+  std::vector<std::uint8_t>       &visible ) //!< O - 1 for each visible box, 0 for each occluded box
+{
+  visible.resize( boxes.size() );
+  std::atomic<size_t> occluded{ 0 };
+  ParallelFor( 0, boxes.size(), 1024, _no_of_threads, [&]( size_t begin, size_t end )
+  {
+    size_t count = 0;
+    for ( size_t i = begin; i < end; ++ i )
+    {
+      visible[i] = Visible( boxes[i] ) ? 1 : 0;
+      count += visible[i] == 0 ? 1 : 0;
+    }
+    occluded += count;
+  } );
+  _statistics._tested   += boxes.size();
+  _statistics._occluded += occluded;
+}
+
+
+/******************************************************************//**
+* \brief   Remove the occluded objects from a visible list.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t COcclusionCuller::Cull(
+  const CSceneBVH          &scene,    //!< I - scene of the objects
+  CSceneBVH::TVisibleList  &visible ) //!< IO - visible objects
+{
+  std::vector<TBoundingBox> boxes;
+  boxes.reserve( visible.size() );
+  for ( auto &item : visible )
+    boxes.push_back( scene.Bounds( item._object ) );
+
+  std::vector<std::uint8_t> flags;
+  Test( boxes, flags );
+
+  size_t count = 0;
+  for ( size_t i = 0; i < visible.size(); ++ i )
+  {
+    if ( flags[i] != 0 )
+      visible[count ++] = visible[i];
+  }
+  size_t occluded = visible.size() - count;
+  visible.resize( count );
+  return occluded;
+}
+
+
+/******************************************************************//**
+* \brief   Set up the edge functions and the depth plane of a triangle.
+*
+* The vertices are in clip space, in front of the near plane. The edge
+* functions are positive inside of the triangle.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void COcclusionCuller::SetupTriangle(
+  const TVec4 &v0,  //!< I - first vertex
+  const TVec4 &v1,  //!< I - second vertex
+  const TVec4 &v2 ) //!< I - third vertex
+{
+  std::array<std::array<float, 3>, 3> s;
+  const TVec4 *v[3]{ &v0, &v1, &v2 };
+  for ( int i = 0; i < 3; ++ i )
+  {
+    float w = (*v[i])[3];
+    s[i] = { ((*v[i])[0] / w * 0.5f + 0.5f) * (float)_width, ((*v[i])[1] / w * 0.5f + 0.5f) * (float)_height, (*v[i])[2] / w * 0.5f + 0.5f };
+  }
+
+  float area = (s[1][0] - s[0][0]) * (s[2][1] - s[0][1]) - (s[2][0] - s[0][0]) * (s[1][1] - s[0][1]);
+  if ( area == 0.0f || std::isfinite( area ) == false )
+    return;
+  if ( area < 0.0f )
+  {
+    if ( _back_face_culling )
+      return;
+    std::swap( s[1], s[2] );
+    area = -area;
+  }
+
+  TTriangle triangle;
+  for ( int i = 0; i < 3; ++ i )
+  {
+    // edge opposite to vertex i
+    const auto &p = s[(i + 1) % 3];
+    const auto &q = s[(i + 2) % 3];
+    triangle._a[i] = p[1] - q[1];
+    triangle._b[i] = q[0] - p[0];
+    triangle._c[i] = p[0] * q[1] - p[1] * q[0];
+  }
+  triangle._za = (triangle._a[0] * s[0][2] + triangle._a[1] * s[1][2] + triangle._a[2] * s[2][2]) / area;
+  triangle._zb = (triangle._b[0] * s[0][2] + triangle._b[1] * s[1][2] + triangle._b[2] * s[2][2]) / area;
+  triangle._zc = (triangle._c[0] * s[0][2] + triangle._c[1] * s[1][2] + triangle._c[2] * s[2][2]) / area;
+
+  // pixels whose centers are inside of the bounding rectangle
+  float x_min = std::min( { s[0][0], s[1][0], s[2][0] } ), x_max = std::max( { s[0][0], s[1][0], s[2][0] } );
+  float y_min = std::min( { s[0][1], s[1][1], s[2][1] } ), y_max = std::max( { s[0][1], s[1][1], s[2][1] } );
+  triangle._x0 = (int)std::max( std::ceil( x_min - 0.5f ), 0.0f );
+  triangle._x1 = (int)std::min( std::floor( x_max - 0.5f ), (float)_width - 1.0f );
+  triangle._y0 = (int)std::max( std::ceil( y_min - 0.5f ), 0.0f );
+  triangle._y1 = (int)std::min( std::floor( y_max - 0.5f ), (float)_height - 1.0f );
+  if ( triangle._x0 > triangle._x1 || triangle._y0 > triangle._y1 )
+    return;
+
+  _triangles.push_back( triangle );
+  ++ _statistics._triangles;
+}
+
+
+/******************************************************************//**
+* \brief   Rasterize the triangles of a row of tiles and update the
+* maximum depth of the tiles.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void COcclusionCuller::RasterizeRow(
+  size_t tile_row ) //!< I - row of tiles
+{
+  const int tile_size = (int)c_tile_size;
+  const int py0 = (int)tile_row * tile_size;
+  for ( auto index : _bins[tile_row] )
+  {
+    const TTriangle &triangle = _triangles[index];
+    int y0 = std::max( triangle._y0 - py0, 0 ), y1 = std::min( triangle._y1 - py0, tile_size - 1 );
+    for ( int tx = triangle._x0 / tile_size; tx <= triangle._x1 / tile_size; ++ tx )
+    {
+      // skip the tile, if it is entirely outside of an edge
+      float px0 = (float)(tx * tile_size) + 0.5f, px1 = px0 + (float)(tile_size - 1);
+      float qy0 = (float)py0 + 0.5f, qy1 = qy0 + (float)(tile_size - 1);
+      bool outside = false;
+      for ( int i = 0; i < 3 && outside == false; ++ i )
+      {
+        float x = triangle._a[i] >= 0.0f ? px1 : px0;
+        float y = triangle._b[i] >= 0.0f ? qy1 : qy0;
+        outside = triangle._a[i] * x + triangle._b[i] * y + triangle._c[i] < 0.0f;
+      }
+      if ( outside )
+        continue;
+
+      float *pixels = _depth.data() + (tile_row * _tiles_x + (size_t)tx) * c_tile_pixels;
+      for ( int y = y0; y <= y1; ++ y )
+      {
+        float py = (float)(py0 + y) + 0.5f;
+        std::array<float, 3> t{
+          triangle._b[0] * py + triangle._c[0],
+          triangle._b[1] * py + triangle._c[1],
+          triangle._b[2] * py + triangle._c[2] };
+        RasterizeTileRow<TLanes>( pixels + y * c_tile_size, px0, triangle._a, t, triangle._za, triangle._zb * py + triangle._zc );
+      }
+    }
+  }
+
+  // coarse level: maximum depth of the tiles
+  for ( size_t tx = 0; tx < _tiles_x; ++ tx )
+  {
+    size_t tile = tile_row * _tiles_x + tx;
+    const float *pixels = _depth.data() + tile * c_tile_pixels;
+    _tile_depth[tile] = *std::max_element( pixels, pixels + c_tile_pixels );
+  }
+}
+
+
+} // Render
@@ -0,0 +1,496 @@
+/******************************************************************//**
+* \brief   Frame profiler: CPU scopes, GPU scopes and counters, with
+*          a rolling summary and Chrome trace export.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_Profiler.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+const char *c_counter_names[(size_t)TProfileCounter::NO_OF] =
+{
+  "draw_calls",
+  "bytes_uploaded",
+  "state_changes",
+};
+
+
+//! write a string as JSON string literal
+void WriteJSONString( std::ostream &stream, const std::string &text )
+{
+  stream << '"';
+  for ( char c : text )
+  {
+    switch ( c )
+    {
+      case '"':  stream << "\\\""; break;
+      case '\\': stream << "\\\\"; break;
+      case '\n': stream << "\\n"; break;
+      case '\r': stream << "\\r"; break;
+      case '\t': stream << "\\t"; break;
+      default:
+        if ( (unsigned char)c < 0x20 )
+        {
+          char code[8];
+          std::snprintf( code, sizeof( code ), "\\u%04x", (unsigned int)(unsigned char)c );
+          stream << code;
+        }
+        else
+          stream << c;
+        break;
+    }
+  }
+  stream << '"';
+}
+
+
+//! write nanoseconds as microseconds, which is the time unit of the trace format
+void WriteMicroseconds( std::ostream &stream, std::uint64_t ns )
+{
+  char text[32];
+  std::snprintf( text, sizeof( text ), "%llu.%03u", (unsigned long long)(ns / 1000), (unsigned int)(ns % 1000) );
+  stream << text;
+}
+
+
+} // namespace
+
+
+/******************************************************************//**
+* \brief   Drain the scopes, which were pushed since the last call.
+*
+* The slots are read optimistically. Afterwards the number of started
+* pushes tells which slots may have been overwritten while they were
+* read; these scopes are discarded and counted as lost.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CProfileRing::Drain(
+  std::vector<TScope> &scopes ) //!< I/O - the scopes are appended
+{
+  std::uint64_t committed = _committed.load( std::memory_order_acquire );
+  size_t        lost      = 0;
+  if ( committed - _read > c_size )
+  {
+    lost  = (size_t)(committed - _read - c_size);
+    _read = committed - c_size;
+  }
+
+  size_t first = scopes.size();
+  for ( std::uint64_t i = _read; i < committed; ++ i )
+  {
+    const TSlot &slot = _slots[i & (c_size - 1)];
+    scopes.push_back( {
+      slot._name.load( std::memory_order_relaxed ),
+      slot._begin.load( std::memory_order_relaxed ),
+      slot._end.load( std::memory_order_relaxed ) } );
+  }
+
+  // scopes before `claimed - c_size` may have been overwritten by the producer, while they were read
+  std::atomic_thread_fence( std::memory_order_acquire );
+  std::uint64_t claimed = _claimed.load( std::memory_order_relaxed );
+  if ( claimed > c_size && claimed - c_size > _read )
+  {
+    size_t invalid = (size_t)(std::min( claimed - c_size, committed ) - _read);
+    scopes.erase( scopes.begin() + first, scopes.begin() + first + invalid );
+    lost += invalid;
+  }
+
+  _read = committed;
+  return lost;
+}
+
+
+/******************************************************************//**
+* \brief   The profiler of the process.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProfiler & CProfiler::Instance( void )
+{
+  static CProfiler profiler;
+  return profiler;
+}
+
+
+/******************************************************************//**
+* \brief   Enable or disable the recording of scopes and counters.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProfiler & CProfiler::Enable(
+  bool enable ) //!< I - true: record scopes and counters
+{
+  if ( enable && Enabled() == false )
+  {
+    _frame_begin = Now();
+    for ( auto &counter : _counters )
+      counter.store( 0, std::memory_order_relaxed );
+  }
+  _enabled.store( enable, std::memory_order_relaxed );
+  return *this;
+}
+
+
+/******************************************************************//**
+* \brief   Start or stop capturing the scopes for the trace export.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProfiler & CProfiler::Capture(
+  bool capture ) //!< I - true: keep the scopes of the completed frames
+{
+  _capture = capture;
+  return *this;
+}
+
+
+/******************************************************************//**
+* \brief   Create the ring of a track.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProfileRing & CProfiler::CreateRing(
+  const std::string &name ) //!< I - name of the track; empty: name by id
+{
+  std::lock_guard<std::mutex> lock( _rings_mutex );
+  std::uint32_t id = (std::uint32_t)_rings.size();
+  _rings.push_back( std::make_unique<CProfileRing>( id ) );
+  _track_names.push_back( name.empty() ? "thread " + std::to_string( id ) : name );
+  return *_rings.back();
+}
+
+
+/******************************************************************//**
+* \brief   Create the track of a timeline, which is not a thread.
+*
+* The scopes of the track have to be pushed by one thread.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProfileRing & CProfiler::Track(
+  const std::string &name ) //!< I - name of the track
+{
+  return CreateRing( name );
+}
+
+
+/******************************************************************//**
+* \brief   Name the track of the current thread.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProfiler & CProfiler::ThreadName(
+  const std::string &name ) //!< I - name of the track
+{
+  CProfileRing &ring = ThreadRing();
+  std::lock_guard<std::mutex> lock( _rings_mutex );
+  _track_names[ring.Id()] = name;
+  return *this;
+}
+
+
+/******************************************************************//**
+* \brief   Complete the current frame.
+*
+* Drain the rings of all the tracks and take the counters. Scopes,
+* which were pushed late (e.g. GPU scopes), are attributed to the
+* frame, in which they are drained.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CProfiler::NewFrame( void )
+{
+  std::uint64_t now = Now();
+  if ( Enabled() == false )
+  {
+    _frame_begin = now;
+    return;
+  }
+
+  if ( _frames.size() < c_summary_frames )
+    _frames.resize( c_summary_frames );
+  TFrameRecord &frame = _frames[_next_frame];
+  _next_frame = (_next_frame + 1) % c_summary_frames;
+
+  frame._begin = _frame_begin;
+  frame._end   = now;
+  frame._events.clear();
+  for ( size_t i = 0; i < _counters.size(); ++ i )
+    frame._counters[i] = _counters[i].exchange( 0, std::memory_order_relaxed );
+
+  {
+    std::lock_guard<std::mutex> lock( _rings_mutex );
+    for ( auto &ring : _rings )
+    {
+      _drained.clear();
+      _statistics._lost += ring->Drain( _drained );
+      for ( auto &scope : _drained )
+        frame._events.push_back( { scope._name, scope._begin, scope._end, ring->Id() } );
+    }
+  }
+
+  _statistics._frames ++;
+  _statistics._scopes += frame._events.size();
+  _last_counters = frame._counters;
+
+  if ( _capture )
+  {
+    size_t capacity = c_max_captured - std::min( _captured.size(), c_max_captured );
+    size_t count    = std::min( frame._events.size(), capacity );
+    _captured.insert( _captured.end(), frame._events.begin(), frame._events.begin() + count );
+    _captured_counters.push_back( { now, frame._counters } );
+    _statistics._captured += count;
+    _statistics._dropped  += frame._events.size() - count;
+  }
+
+  _frame_begin = now;
+}
+
+
+/******************************************************************//**
+* \brief   Discard the captured scopes and the summary.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CProfiler::Clear( void )
+{
+  _frames.clear();
+  _next_frame = 0;
+  _captured.clear();
+  _captured_counters.clear();
+  _last_counters = TProfileCounters{};
+  _statistics    = TStatistics();
+}
+
+
+/******************************************************************//**
+* \brief   Summarize the last `c_summary_frames` frames.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CProfiler::TSummary CProfiler::Summary( void ) const
+{
+  TSummary summary;
+
+  // calls, total time and maximum time per frame, by track and name
+  struct TAccumulator
+  {
+    size_t        _calls = 0;
+    std::uint64_t _total = 0;
+    std::uint64_t _max   = 0;
+    std::uint64_t _frame = 0;
+  };
+  std::map<std::tuple<std::uint32_t, std::string>, TAccumulator> accumulators;
+
+  std::uint64_t frame_time = 0;
+  for ( auto &frame : _frames )
+  {
+    if ( frame._end == 0 )
+      continue;
+    summary._frames ++;
+    frame_time += frame._end - frame._begin;
+    for ( size_t i = 0; i < frame._counters.size(); ++ i )
+      summary._counters[i] += (double)frame._counters[i];
+
+    for ( auto &accumulator : accumulators )
+      accumulator.second._frame = 0;
+    for ( auto &event : frame._events )
+    {
+      auto &accumulator = accumulators[{ event._track, event._name != nullptr ? event._name : "" }];
+      std::uint64_t time = event._end > event._begin ? event._end - event._begin : 0;
+      accumulator._calls ++;
+      accumulator._total += time;
+      accumulator._frame += time;
+    }
+    for ( auto &accumulator : accumulators )
+      accumulator.second._max = std::max( accumulator.second._max, accumulator.second._frame );
+  }
+  if ( summary._frames == 0 )
+    return summary;
+
+  double frames = (double)summary._frames;
+  summary._frame_ms = (double)frame_time / frames * 1.0e-6;
+  for ( auto &counter : summary._counters )
+    counter /= frames;
+
+  std::lock_guard<std::mutex> lock( _rings_mutex );
+  for ( auto &accumulator : accumulators )
+  {
+    TSummaryEntry entry;
+    entry._track      = _track_names[std::get<0>( accumulator.first )];
+    entry._name       = std::get<1>( accumulator.first );
+    entry._calls      = (double)accumulator.second._calls / frames;
+    entry._average_ms = (double)accumulator.second._total / frames * 1.0e-6;
+    entry._max_ms     = (double)accumulator.second._max * 1.0e-6;
+    summary._entries.push_back( std::move( entry ) );
+  }
+  return summary;
+}
+
+
+/******************************************************************//**
+* \brief   Table of the summary, e.g. for an overlay or the console.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::string CProfiler::SummaryText( void ) const
+{
+  TSummary summary = Summary();
+
+  std::ostringstream text;
+  char line[256];
+  std::snprintf( line, sizeof( line ), "frames: %zu, frame: %.3f ms\n", summary._frames, summary._frame_ms );
+  text << line;
+  for ( size_t i = 0; i < summary._counters.size(); ++ i )
+  {
+    std::snprintf( line, sizeof( line ), "%s: %.1f/frame\n", c_counter_names[i], summary._counters[i] );
+    text << line;
+  }
+  std::snprintf( line, sizeof( line ), "%-16s %-32s %8s %10s %10s\n", "track", "scope", "calls", "avg ms", "max ms" );
+  text << line;
+  for ( auto &entry : summary._entries )
+  {
+    std::snprintf( line, sizeof( line ), "%-16s %-32s %8.1f %10.3f %10.3f\n",
+      entry._track.c_str(), entry._name.c_str(), entry._calls, entry._average_ms, entry._max_ms );
+    text << line;
+  }
+  return text.str();
+}
+
+
+/******************************************************************//**
+* \brief   Write the captured scopes and counters in the Chrome trace
+* event format (JSON object format).
+*
+* The file can be opened by `chrome://tracing` or by Perfetto. Each
+* track is a thread of one process. The counters are written as
+* counter events at the end of each frame.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CProfiler::WriteChromeTrace(
+  std::ostream &stream ) const //!< O - output stream
+{
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+  bool first = true;
+  auto separator = [&]( void ) -> std::ostream &
+  {
+    if ( first == false )
+      stream << ",\n";
+    first = false;
+    return stream;
+  };
+
+  {
+    std::lock_guard<std::mutex> lock( _rings_mutex );
+    for ( size_t i = 0; i < _track_names.size(); ++ i )
+    {
+      separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":";
+      WriteJSONString( stream, _track_names[i] );
+      stream << "}}";
+    }
+  }
+
+  for ( auto &event : _captured )
+  {
+    separator() << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << event._track << ",\"name\":";
+    WriteJSONString( stream, event._name != nullptr ? event._name : "" );
+    stream << ",\"ts\":";
+    WriteMicroseconds( stream, event._begin );
+    stream << ",\"dur\":";
+    WriteMicroseconds( stream, event._end > event._begin ? event._end - event._begin : 0 );
+    stream << "}";
+  }
+
+  for ( auto &sample : _captured_counters )
+  {
+    separator() << "{\"ph\":\"C\",\"pid\":1,\"name\":\"counters\",\"ts\":";
+    WriteMicroseconds( stream, sample._time );
+    stream << ",\"args\":{";
+    for ( size_t i = 0; i < sample._counters.size(); ++ i )
+      stream << (i > 0 ? "," : "") << "\"" << c_counter_names[i] << "\":" << sample._counters[i];
+    stream << "}}";
+  }
+
+  stream << "\n]}\n";
+  return stream.good();
+}
+
+
+/******************************************************************//**
+* \brief   Write the captured scopes and counters to a Chrome trace
+* file.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CProfiler::WriteChromeTrace(
+  const std::string &filename ) const //!< I - path of the JSON file
+{
+  std::ofstream stream( filename, std::ios::binary );
+  if ( stream.is_open() == false )
+    return false;
+  return WriteChromeTrace( stream );
+}
+
+
+} // Render
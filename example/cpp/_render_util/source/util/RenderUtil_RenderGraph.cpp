@@ -0,0 +1,464 @@
+/******************************************************************//**
+* \brief   Render graph of a render process: dependencies and order of
+* the render passes, lifetimes of the buffers and aliasing of transient
+* buffers.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_RenderGraph.h"
+
+
+// STL
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <iomanip>
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+//! write and read accesses to a buffer, in declaration order of the passes
+struct TAccess
+{
+  size_t              _writer = CRenderGraph::c_no_pass; //!< last pass which wrote the buffer
+  std::vector<size_t> _readers;                          //!< passes which read the buffer since the last write
+};
+
+
+//! IDs of the specified buffers, which are read by a pass
+std::set<size_t> ReadBuffers(
+  const TPass                     &pass,    //!< I - pass specification
+  const CRenderGraph::TBufferMap  &buffers ) //!< I - buffer specifications
+{
+  std::set<size_t> ids;
+  for ( auto &source : pass._sources )
+  {
+    if ( buffers.find( source._bufferID ) != buffers.end() )
+      ids.insert( source._bufferID );
+  }
+  return ids;
+}
+
+
+//! IDs of the specified buffers, which are written by a pass; render buffers (`TTarget::no`) are not shared between passes
+std::set<size_t> WrittenBuffers(
+  const TPass                     &pass,    //!< I - pass specification
+  const CRenderGraph::TBufferMap  &buffers ) //!< I - buffer specifications
+{
+  std::set<size_t> ids;
+  for ( auto &target : pass._targets )
+  {
+    if ( target._bufferID != TPass::TTarget::no && buffers.find( target._bufferID ) != buffers.end() )
+      ids.insert( target._bufferID );
+  }
+  return ids;
+}
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   Build the graph.
+*
+* Returns false, if the dependencies of the passes are cyclic.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CRenderGraph::Build(
+  const TBufferMap &buffers, //!< I - buffer specifications
+  const TPassMap   &passes,  //!< I - pass specifications
+  TSize             size )   //!< I - viewport size
+{
+  _valid = false;
+  _order.clear();
+  _dependencies.clear();
+  _lifetimes.clear();
+  _aliases.clear();
+  _dead.clear();
+  _report = TReport();
+
+  // accessed buffers of the passes
+  std::map<size_t, std::set<size_t>> reads;
+  std::map<size_t, std::set<size_t>> writes;
+  std::map<size_t, std::set<size_t>> accessed;
+  for ( auto &pass : passes )
+  {
+    reads[pass.first]  = ReadBuffers( pass.second, buffers );
+    writes[pass.first] = WrittenBuffers( pass.second, buffers );
+    accessed[pass.first] = reads[pass.first];
+    accessed[pass.first].insert( writes[pass.first].begin(), writes[pass.first].end() );
+  }
+
+  // dependencies in declaration order
+  std::map<size_t, std::set<size_t>> prerequisites;
+  std::map<size_t, TAccess>          access;
+  TAccess                            default_framebuffer;
+  auto depend = [&]( size_t from, size_t to )
+  {
+    if ( from != c_no_pass && from != to )
+      prerequisites[to].insert( from );
+  };
+  auto write = [&]( TAccess &a, size_t passID )
+  {
+    depend( a._writer, passID );
+    for ( auto reader : a._readers )
+      depend( reader, passID );
+    a._writer = passID;
+    a._readers.clear();
+  };
+  for ( auto &pass : passes )
+  {
+    size_t passID = pass.first;
+    prerequisites[passID];
+
+    for ( auto bufferID : reads[passID] )
+    {
+      depend( access[bufferID]._writer, passID );
+      access[bufferID]._readers.push_back( passID );
+    }
+
+    for ( auto bufferID : writes[passID] )
+      write( access[bufferID], passID );
+
+    // passes without targets write to the default framebuffer
+    if ( pass.second._targets.empty() )
+      write( default_framebuffer, passID );
+  }
+  for ( auto &node : prerequisites )
+  {
+    for ( auto from : node.second )
+      _dependencies.emplace_back( from, node.first );
+  }
+
+  // estimated memory and number of accessing passes of the buffers
+  std::map<size_t, size_t> bytes;
+  std::map<size_t, size_t> remaining;
+  for ( auto &pass : accessed )
+  {
+    for ( auto bufferID : pass.second )
+    {
+      bytes[bufferID] = BufferSize( buffers.at( bufferID ), size );
+      ++ remaining[bufferID];
+    }
+  }
+
+  // topological sort (Kahn); of the ready passes, the pass with the smallest growth of the allocated memory is scheduled first
+  std::map<size_t, size_t>              indegree;
+  std::map<size_t, std::vector<size_t>> dependents;
+  for ( auto &node : prerequisites )
+  {
+    indegree[node.first] = node.second.size();
+    for ( auto from : node.second )
+      dependents[from].push_back( node.first );
+  }
+  std::set<size_t> ready;
+  for ( auto &node : indegree )
+  {
+    if ( node.second == 0 )
+      ready.insert( node.first );
+  }
+  std::set<size_t> alive;
+  while ( ready.empty() == false )
+  {
+    size_t    best      = c_no_pass;
+    long long best_cost = 0;
+    for ( auto passID : ready )
+    {
+      long long cost = 0;
+      for ( auto bufferID : accessed[passID] )
+      {
+        if ( alive.find( bufferID ) == alive.end() )
+          cost += (long long)bytes[bufferID];
+        if ( remaining[bufferID] == 1 )
+          cost -= (long long)bytes[bufferID];
+      }
+      if ( best == c_no_pass || cost < best_cost )
+      {
+        best      = passID;
+        best_cost = cost;
+      }
+    }
+
+    ready.erase( best );
+    _order.push_back( best );
+    for ( auto bufferID : accessed[best] )
+    {
+      alive.insert( bufferID );
+      if ( -- remaining[bufferID] == 0 )
+        alive.erase( bufferID );
+    }
+    for ( auto passID : dependents[best] )
+    {
+      if ( -- indegree[passID] == 0 )
+        ready.insert( passID );
+    }
+  }
+  if ( _order.size() != passes.size() )
+  {
+    _order.clear();
+    return false;
+  }
+
+  // lifetimes of the buffers
+  for ( size_t i = 0; i < _order.size(); ++ i )
+  {
+    size_t       passID = _order[i];
+    const TPass &pass   = passes.at( passID );
+    for ( auto bufferID : accessed[passID] )
+    {
+      TLifetime &lifetime = _lifetimes[bufferID];
+      if ( lifetime._first == c_no_pass )
+      {
+        // the first access has to clear the buffer, else the content of the previous frame is required
+        const TBuffer &buffer = buffers.at( bufferID );
+        bool cleared = std::any_of( pass._targets.begin(), pass._targets.end(), [bufferID]( const TPass::TTarget &target ) -> bool {
+          return target._bufferID == bufferID && target.ClearTarget();
+        } );
+        lifetime._first     = i;
+        lifetime._transient =
+          cleared &&
+          reads[passID].find( bufferID ) == reads[passID].end() &&
+          buffer._flag.test( TBuffer::e_extern ) == false &&
+          buffer._flag.test( TBuffer::e_keep ) == false;
+      }
+      lifetime._last = i;
+    }
+  }
+
+  // dead buffers and aliasing of transient buffers with disjoint lifetimes
+  struct TSlot
+  {
+    size_t _owner; //!< buffer which owns the texture
+    size_t _last;  //!< index of the last pass, which accesses the texture
+  };
+  std::vector<std::pair<size_t, size_t>> transient; // first pass index, buffer ID
+  for ( auto &lifetime : _lifetimes )
+  {
+    _aliases[lifetime.first] = lifetime.first;
+    ++ _report._buffers;
+    _report._bytes += bytes[lifetime.first];
+    if ( lifetime.second._transient )
+    {
+      transient.emplace_back( lifetime.second._first, lifetime.first );
+      _dead[_order[lifetime.second._last]].push_back( lifetime.first );
+    }
+    else
+    {
+      ++ _report._textures;
+      _report._aliased_bytes += bytes[lifetime.first];
+    }
+  }
+  std::sort( transient.begin(), transient.end() );
+  std::vector<TSlot> slots;
+  for ( auto &buffer : transient )
+  {
+    size_t           bufferID = buffer.second;
+    const TLifetime &lifetime = _lifetimes[bufferID];
+    auto slotIt = std::find_if( slots.begin(), slots.end(), [&]( const TSlot &slot ) -> bool {
+      return slot._last < lifetime._first && Compatible( buffers.at( slot._owner ), buffers.at( bufferID ) );
+    } );
+    if ( slotIt != slots.end() )
+    {
+      _aliases[bufferID] = slotIt->_owner;
+      slotIt->_last      = lifetime._last;
+      continue;
+    }
+    slots.push_back( { bufferID, lifetime._last } );
+    ++ _report._textures;
+    _report._aliased_bytes += bytes[bufferID];
+  }
+
+  _valid = true;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Get the lifetime of a buffer.
+*
+* The lifetime of a buffer, which is not accessed by any pass, is empty
+* (`_first == c_no_pass`).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+const CRenderGraph::TLifetime & CRenderGraph::Lifetime(
+  size_t bufferID ) const //!< I - buffer ID
+{
+  static const TLifetime no_lifetime;
+  auto it = _lifetimes.find( bufferID );
+  return it != _lifetimes.end() ? it->second : no_lifetime;
+}
+
+
+/******************************************************************//**
+* \brief   Get the ID of the buffer, whose texture is shared by a buffer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CRenderGraph::Alias(
+  size_t bufferID ) const //!< I - buffer ID
+{
+  auto it = _aliases.find( bufferID );
+  return it != _aliases.end() ? it->second : bufferID;
+}
+
+
+/******************************************************************//**
+* \brief   Get the IDs of the transient buffers, which are dead after
+* a pass.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+const std::vector<size_t> & CRenderGraph::Dead(
+  size_t passID ) const //!< I - pass ID
+{
+  static const std::vector<size_t> no_buffers;
+  auto it = _dead.find( passID );
+  return it != _dead.end() ? it->second : no_buffers;
+}
+
+
+/******************************************************************//**
+* \brief   Human readable report of the order of the passes and of the
+* memory, which is saved by aliasing.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::string CRenderGraph::ReportText( void ) const
+{
+  std::stringstream text;
+  text << "render graph: passes";
+  for ( auto passID : _order )
+    text << " " << passID;
+  text << "; " << _report._buffers << " buffers on " << _report._textures << " textures; "
+       << std::fixed << std::setprecision( 2 )
+       << (double)_report._bytes / (1024.0 * 1024.0) << " MiB -> "
+       << (double)_report._aliased_bytes / (1024.0 * 1024.0) << " MiB ("
+       << (double)_report.Saved() / (1024.0 * 1024.0) << " MiB saved)";
+  return text.str();
+}
+
+
+/******************************************************************//**
+* \brief   Estimated size of a texel in bytes.
+*
+* Unsized formats are estimated by the formats, which are commonly
+* chosen by the drivers (8 bit color channels, 32 bit depth).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CRenderGraph::TexelSize(
+  const TBuffer &buffer ) //!< I - buffer specification
+{
+  size_t channels = 1;
+  switch ( buffer._type )
+  {
+    case TBufferType::DEFAULT: channels = 4; break;
+    case TBufferType::COLOR1:  channels = 1; break;
+    case TBufferType::COLOR2:  channels = 2; break;
+    case TBufferType::COLOR3:  channels = 3; break;
+    case TBufferType::COLOR4:  channels = 4; break;
+    default:                   channels = 1; break;
+  }
+
+  size_t channel_size = 1;
+  switch ( buffer._format )
+  {
+    case TBufferDataType::DEFAULT:
+      channel_size = buffer._type == TBufferType::DEPTH || buffer._type == TBufferType::DEPTHSTENCIL ? 4 : 1;
+      break;
+    case TBufferDataType::F_BYTE:              channel_size = 1; break;
+    case TBufferDataType::F_WORD:              channel_size = 2; break;
+    case TBufferDataType::SNORM8:              channel_size = 1; break;
+    case TBufferDataType::SNORM16:             channel_size = 2; break;
+    case TBufferDataType::F16:                 channel_size = 2; break;
+    case TBufferDataType::F32:                 channel_size = 4; break;
+    case TBufferDataType::DEPTH16:             channel_size = 2; break;
+    case TBufferDataType::DEPTH24:             channel_size = 4; break;
+    case TBufferDataType::DEPTH32:             channel_size = 4; break;
+    case TBufferDataType::DEPTH32F:            channel_size = 4; break;
+    case TBufferDataType::STENCIL8:            channel_size = 1; break;
+    case TBufferDataType::DEPTH_STENCIL_24_8:  channel_size = 4; break;
+    case TBufferDataType::DEPTH_STENCIL_32F_8: channel_size = 8; break;
+  }
+
+  return channels * channel_size;
+}
+
+
+/******************************************************************//**
+* \brief   Estimated memory of a buffer in bytes.
+*
+* The size of the buffer is computed in the same way as the size of
+* the texture in `OpenGL::CRenderProcess`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CRenderGraph::BufferSize(
+  const TBuffer &buffer, //!< I - buffer specification
+  TSize          size )  //!< I - viewport size
+{
+  size_t cx      = (size_t)(size[0] * buffer._scale + 0.5f);
+  size_t cy      = (size_t)(size[1] * buffer._scale + 0.5f);
+  size_t layers  = std::max( buffer._layers, 1u );
+  size_t samples = std::max( buffer._multisamples, 1u );
+  if ( buffer._flag.test( TBuffer::e_cubemap ) )
+    layers = 6;
+  return cx * cy * layers * samples * TexelSize( buffer );
+}
+
+
+/******************************************************************//**
+* \brief   Check if 2 buffers can share a texture.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CRenderGraph::Compatible(
+  const TBuffer &a,  //!< I - buffer specification
+  const TBuffer &b ) //!< I - buffer specification
+{
+  if ( a._flag.test( TBuffer::e_extern ) || b._flag.test( TBuffer::e_extern ) )
+    return false;
+  return a == b;
+}
+
+
+} // Render
@@ -0,0 +1,1176 @@
+/******************************************************************//**
+* \brief   Bounding volume hierarchy of the objects of a scene, with
+* frustum and distance culling.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_SceneBVH.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+// SIMD
+
+#if defined(__AVX2__)
+#define RENDERUTIL_SCENEBVH_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERUTIL_SCENEBVH_SSE2
+#endif
+
+#if defined(RENDERUTIL_SCENEBVH_AVX2) || defined(RENDERUTIL_SCENEBVH_SSE2)
+#include <immintrin.h>
+#endif
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+const float         c_empty           = 1.0e30f;    //!< bounds of an empty box: minimum `c_empty`, maximum `-c_empty`
+const std::uint32_t c_no_position     = 0xffffffff; //!< position of a removed object handle
+const size_t        c_bins            = 16;         //!< number of bins of the surface area heuristic
+const unsigned int  c_distance_bit    = 1 << 6;     //!< bit of the distance test in the mask of the active tests
+const unsigned int  c_all_planes      = 0x3f;       //!< bits of the 6 planes in the mask of the active tests
+
+
+//! bounds of a range of boxes
+struct TBounds
+{
+  std::array<float, 3> _min{ c_empty, c_empty, c_empty };
+  std::array<float, 3> _max{ -c_empty, -c_empty, -c_empty };
+
+  void Add( const std::array<float, 3> &min, const std::array<float, 3> &max )
+  {
+    for ( int i = 0; i < 3; ++ i )
+    {
+      _min[i] = std::min( _min[i], min[i] );
+      _max[i] = std::max( _max[i], max[i] );
+    }
+  }
+
+  void Add( const std::array<float, 3> &pt )
+  {
+    Add( pt, pt );
+  }
+
+  float Area( void ) const
+  {
+    if ( _min[0] > _max[0] || _min[1] > _max[1] || _min[2] > _max[2] )
+      return 0.0f;
+    float dx = _max[0] - _min[0], dy = _max[1] - _min[1], dz = _max[2] - _min[2];
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+  }
+};
+
+
+//! bin of the surface area heuristic
+struct TBin
+{
+  TBounds _bounds;
+  size_t  _count = 0;
+};
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   Culling parameters: planes and distance.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+struct CSceneBVH::TCullParameters
+{
+  std::array<TVec4, 6> _planes;
+  TVec3                _eye{ 0.0f, 0.0f, 0.0f };
+  float                _max_distance2 = 0.0f; //!< square of the maximum distance
+  unsigned int         _tests = c_all_planes; //!< mask of the active tests (6 planes and distance)
+};
+
+
+namespace
+{
+
+
+#if defined(RENDERUTIL_SCENEBVH_AVX2)
+
+//! 8 float lanes
+struct TLanesAVX2
+{
+  using T = __m256;
+  static const size_t c_width = 8;
+
+  static T   Set( float v )            { return _mm256_set1_ps( v ); }
+  static T   Load( const float *p )    { return _mm256_loadu_ps( p ); }
+  static T   Add( T a, T b )           { return _mm256_add_ps( a, b ); }
+  static T   Sub( T a, T b )           { return _mm256_sub_ps( a, b ); }
+  static T   Mul( T a, T b )           { return _mm256_mul_ps( a, b ); }
+  static T   Max( T a, T b )           { return _mm256_max_ps( a, b ); }
+  static T   Ge( T a, T b )            { return _mm256_cmp_ps( a, b, _CMP_GE_OQ ); }
+  static T   Le( T a, T b )            { return _mm256_cmp_ps( a, b, _CMP_LE_OQ ); }
+  static T   And( T a, T b )           { return _mm256_and_ps( a, b ); }
+  static T   True( void )              { return _mm256_castsi256_ps( _mm256_set1_epi32( -1 ) ); }
+  static int Bits( T a )               { return _mm256_movemask_ps( a ); }
+};
+
+#endif
+
+#if defined(RENDERUTIL_SCENEBVH_SSE2)
+
+//! 4 float lanes
+struct TLanesSSE2
+{
+  using T = __m128;
+  static const size_t c_width = 4;
+
+  static T   Set( float v )            { return _mm_set1_ps( v ); }
+  static T   Load( const float *p )    { return _mm_loadu_ps( p ); }
+  static T   Add( T a, T b )           { return _mm_add_ps( a, b ); }
+  static T   Sub( T a, T b )           { return _mm_sub_ps( a, b ); }
+  static T   Mul( T a, T b )           { return _mm_mul_ps( a, b ); }
+  static T   Max( T a, T b )           { return _mm_max_ps( a, b ); }
+  static T   Ge( T a, T b )            { return _mm_cmpge_ps( a, b ); }
+  static T   Le( T a, T b )            { return _mm_cmple_ps( a, b ); }
+  static T   And( T a, T b )           { return _mm_and_ps( a, b ); }
+  static T   True( void )              { return _mm_castsi128_ps( _mm_set1_epi32( -1 ) ); }
+  static int Bits( T a )               { return _mm_movemask_ps( a ); }
+};
+
+#endif
+
+
+//! index of the lowest set bit
+inline int LowestBit( unsigned int bits )
+{
+  int i = 0;
+  while ( (bits & 1) == 0 )
+  {
+    bits >>= 1;
+    ++ i;
+  }
+  return i;
+}
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   Extract the frustum planes of a view projection matrix.
+*
+* A point is inside of the clip space, if `-w <= x, y, z <= w`; each
+* inequality is a plane in world space (Gribb & Hartmann).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+TFrustum TFrustum::FromMatrix(
+  const TMat44 &m ) //!< I - view projection matrix
+{
+  auto row = [&m]( int r ) -> TVec4
+  {
+    return TVec4{ m[0][r], m[1][r], m[2][r], m[3][r] };
+  };
+  auto combine = []( const TVec4 &a, const TVec4 &b, t_fp s ) -> TVec4
+  {
+    return TVec4{ a[0] + s * b[0], a[1] + s * b[1], a[2] + s * b[2], a[3] + s * b[3] };
+  };
+
+  TVec4 x = row( 0 ), y = row( 1 ), z = row( 2 ), w = row( 3 );
+  TFrustum frustum;
+  frustum._planes[0] = combine( w, x,  1.0f ); // left
+  frustum._planes[1] = combine( w, x, -1.0f ); // right
+  frustum._planes[2] = combine( w, y,  1.0f ); // bottom
+  frustum._planes[3] = combine( w, y, -1.0f ); // top
+  frustum._planes[4] = combine( w, z,  1.0f ); // near
+  frustum._planes[5] = combine( w, z, -1.0f ); // far
+  return frustum;
+}
+
+
+/******************************************************************//**
+* \brief   Add an object.
+*
+* The object is tested without the tree, until the tree is rebuilt.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CSceneBVH::TObject CSceneBVH::Add(
+  const TBoundingBox &box, //!< I - world bounding box
+  TStateKey           key ) //!< I - state key
+{
+  TObject object;
+  if ( _free.empty() == false )
+  {
+    object = _free.back();
+    _free.pop_back();
+  }
+  else
+  {
+    object = (TObject)_position.size();
+    _position.push_back( c_no_position );
+  }
+
+  size_t position = _size ++;
+  Reserve( _size );
+  SetBox( position, box );
+  _objects[position]  = object;
+  _keys[position]     = key;
+  _leaves[position]   = c_no_node;
+  _position[object]   = (std::uint32_t)position;
+  ++ _no_of_objects;
+  return object;
+}
+
+
+/******************************************************************//**
+* \brief   Remove an object.
+*
+* The position of the object stays empty until the tree is rebuilt.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::Remove(
+  TObject object ) //!< I - object handle
+{
+  if ( object >= _position.size() || _position[object] == c_no_position )
+    return;
+
+  size_t position = _position[object];
+  SetBox( position, TBoundingBox{ { c_empty, c_empty, c_empty }, { -c_empty, -c_empty, -c_empty } } );
+  _objects[position] = c_no_object;
+  MarkDirty( position );
+  _position[object] = c_no_position;
+  _free.push_back( object );
+  ++ _removed;
+  -- _no_of_objects;
+}
+
+
+/******************************************************************//**
+* \brief   Set the world bounding box of an object.
+*
+* The nodes above the object are refit by the next `Update`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::Move(
+  TObject             object, //!< I - object handle
+  const TBoundingBox &box )   //!< I - new world bounding box
+{
+  if ( object >= _position.size() || _position[object] == c_no_position )
+    return;
+
+  size_t position = _position[object];
+  SetBox( position, box );
+  MarkDirty( position );
+}
+
+
+/******************************************************************//**
+* \brief   Set the state key of an object.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::SetKey(
+  TObject   object, //!< I - object handle
+  TStateKey key )   //!< I - new state key
+{
+  if ( object < _position.size() && _position[object] != c_no_position )
+    _keys[_position[object]] = key;
+}
+
+
+/******************************************************************//**
+* \brief   World bounding box of an object.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+TBoundingBox CSceneBVH::Bounds(
+  TObject object ) //!< I - object handle
+  const
+{
+  if ( object >= _position.size() || _position[object] == c_no_position )
+    return TBoundingBox();
+
+  size_t p = _position[object];
+  return TBoundingBox{ { _min_x[p], _min_y[p], _min_z[p] }, { _max_x[p], _max_y[p], _max_z[p] } };
+}
+
+
+/******************************************************************//**
+* \brief   State key of an object.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CSceneBVH::TStateKey CSceneBVH::Key(
+  TObject object ) //!< I - object handle
+  const
+{
+  if ( object >= _position.size() || _position[object] == c_no_position )
+    return 0;
+  return _keys[_position[object]];
+}
+
+
+/******************************************************************//**
+* \brief   Refit the tree and rebuild degraded subtrees.
+*
+* The leaves of moved and removed objects are refit and the changes
+* are propagated to the root. Of each path, the topmost node whose
+* surface area exceeds `c_rebuild_ratio` times the surface area at the
+* time it was built, is rebuilt.
+*
+* The whole tree is rebuilt, if there are many pending or removed
+* objects, or if the rebuilt subtrees left many unused nodes.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::Update( void )
+{
+  bool rebuild =
+    (_nodes.empty() && _size > 0) ||
+    Pending() > _built / 8 + 8 * c_leaf_size ||
+    _removed > _built / 4 ||
+    _garbage > _nodes.size() / 2;
+  if ( rebuild )
+  {
+    Rebuild();
+    return;
+  }
+
+  // refit the paths from the dirty leaves to the root
+  std::vector<std::uint32_t> degraded;
+  for ( auto leaf : _dirty_leaves )
+  {
+    _nodes[leaf]._dirty = false;
+    std::uint32_t topmost = c_no_node;
+    for ( std::uint32_t node = leaf; node != c_no_node; node = _nodes[node]._parent )
+    {
+      bool changed = Refit( node );
+      ++ _statistics._refit_nodes;
+
+      TBounds bounds;
+      bounds.Add( _nodes[node]._min, _nodes[node]._max );
+      if ( bounds.Area() > c_rebuild_ratio * _nodes[node]._build_area )
+        topmost = node;
+      if ( changed == false )
+        break;
+    }
+    if ( topmost != c_no_node )
+      degraded.push_back( topmost );
+  }
+  _dirty_leaves.clear();
+
+  // rebuild the degraded subtrees, which are not contained in another degraded subtree
+  std::sort( degraded.begin(), degraded.end() );
+  degraded.erase( std::unique( degraded.begin(), degraded.end() ), degraded.end() );
+  if ( std::binary_search( degraded.begin(), degraded.end(), 0u ) )
+  {
+    Rebuild();
+    return;
+  }
+  std::vector<std::uint32_t> roots;
+  for ( auto node : degraded )
+  {
+    bool contained = false;
+    for ( std::uint32_t parent = _nodes[node]._parent; parent != c_no_node && contained == false; parent = _nodes[parent]._parent )
+      contained = std::binary_search( degraded.begin(), degraded.end(), parent );
+    if ( contained == false )
+      roots.push_back( node );
+  }
+  for ( auto node : roots )
+    RebuildSubtree( node );
+}
+
+
+/******************************************************************//**
+* \brief   Rebuild the whole tree.
+*
+* The removed objects are dropped and the pending objects are inserted
+* into the tree.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::Rebuild( void )
+{
+  // compact the live objects
+  size_t count = 0;
+  for ( size_t p = 0; p < _size; ++ p )
+  {
+    if ( _objects[p] == c_no_object )
+      continue;
+    _min_x[count]   = _min_x[p];
+    _min_y[count]   = _min_y[p];
+    _min_z[count]   = _min_z[p];
+    _max_x[count]   = _max_x[p];
+    _max_y[count]   = _max_y[p];
+    _max_z[count]   = _max_z[p];
+    _objects[count] = _objects[p];
+    _keys[count]    = _keys[p];
+    _position[_objects[count]] = (std::uint32_t)count;
+    ++ count;
+  }
+  for ( size_t p = count; p < _size; ++ p )
+  {
+    SetBox( p, TBoundingBox{ { c_empty, c_empty, c_empty }, { -c_empty, -c_empty, -c_empty } } );
+    _objects[p] = c_no_object;
+    _leaves[p]  = c_no_node;
+  }
+
+  _size    = count;
+  _built   = count;
+  _removed = 0;
+  _garbage = 0;
+  _nodes.clear();
+  _dirty_leaves.clear();
+  ++ _statistics._rebuilds;
+
+  if ( count > 0 )
+    Build( NewNode(), 0, (std::uint32_t)count, c_no_node );
+}
+
+
+/******************************************************************//**
+* \brief   Collect the objects inside the frustum, sorted by state key.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CSceneBVH::TCullStatistics CSceneBVH::Cull(
+  const TFrustum &frustum,   //!< I - view frustum
+  TVisibleList   &visible )  //!< O - visible objects
+  const
+{
+  TCullParameters parameters;
+  parameters._planes = frustum._planes;
+  return Cull( parameters, visible );
+}
+
+
+/******************************************************************//**
+* \brief   Collect the objects inside the frustum and closer to the eye
+* than a maximum distance, sorted by state key.
+*
+* The distance of an object is the distance of its bounding box to the
+* eye.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CSceneBVH::TCullStatistics CSceneBVH::Cull(
+  const TFrustum &frustum,      //!< I - view frustum
+  const TVec3    &eye,          //!< I - position of the eye
+  float           max_distance, //!< I - maximum distance
+  TVisibleList   &visible )     //!< O - visible objects
+  const
+{
+  TCullParameters parameters;
+  parameters._planes        = frustum._planes;
+  parameters._eye           = eye;
+  parameters._max_distance2 = max_distance * max_distance;
+  parameters._tests         = c_all_planes | c_distance_bit;
+  return Cull( parameters, visible );
+}
+
+
+/******************************************************************//**
+* \brief   Stable sort of the visible objects by state key.
+*
+* LSD radix sort by 8 bit digits; digits, which are equal for all the
+* objects, are skipped.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::SortByKey(
+  TVisibleList &visible ) //!< IO - visible objects
+{
+  const size_t n = visible.size();
+  if ( n < 64 )
+  {
+    std::stable_sort( visible.begin(), visible.end(), []( const TDrawItem &a, const TDrawItem &b ) { return a._key < b._key; } );
+    return;
+  }
+
+  const int c_digits = (int)sizeof( TStateKey );
+  std::vector<std::array<size_t, 256>> histograms( c_digits, std::array<size_t, 256>{} );
+  for ( auto &item : visible )
+  {
+    for ( int d = 0; d < c_digits; ++ d )
+      ++ histograms[d][(item._key >> (8 * d)) & 0xff];
+  }
+
+  TVisibleList temp( n );
+  TVisibleList *source = &visible, *target = &temp;
+  for ( int d = 0; d < c_digits; ++ d )
+  {
+    auto &histogram = histograms[d];
+    if ( histogram[((*source)[0]._key >> (8 * d)) & 0xff] == n )
+      continue;
+
+    size_t offset = 0;
+    for ( auto &count : histogram )
+    {
+      size_t c = count;
+      count = offset;
+      offset += c;
+    }
+    for ( auto &item : *source )
+      (*target)[histogram[(item._key >> (8 * d)) & 0xff] ++] = item;
+    std::swap( source, target );
+  }
+  if ( source != &visible )
+    visible.swap( temp );
+}
+
+
+/******************************************************************//**
+* \brief   Grow the arrays to `size` positions and the padding.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::Reserve(
+  size_t size ) //!< I - number of positions
+{
+  size_t padded = size + c_leaf_size;
+  if ( _objects.size() >= padded )
+    return;
+
+  size_t capacity = std::max( padded, _objects.size() * 3 / 2 );
+  _min_x.resize( capacity, c_empty );
+  _min_y.resize( capacity, c_empty );
+  _min_z.resize( capacity, c_empty );
+  _max_x.resize( capacity, -c_empty );
+  _max_y.resize( capacity, -c_empty );
+  _max_z.resize( capacity, -c_empty );
+  _objects.resize( capacity, c_no_object );
+  _keys.resize( capacity, 0 );
+  _leaves.resize( capacity, c_no_node );
+}
+
+
+/******************************************************************//**
+* \brief   Set the box at a position.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::SetBox(
+  size_t              position, //!< I - position in the order of the tree
+  const TBoundingBox &box )     //!< I - bounding box
+{
+  _min_x[position] = box._min[0];
+  _min_y[position] = box._min[1];
+  _min_z[position] = box._min[2];
+  _max_x[position] = box._max[0];
+  _max_y[position] = box._max[1];
+  _max_z[position] = box._max[2];
+}
+
+
+/******************************************************************//**
+* \brief   Mark the leaf of a position for refitting.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::MarkDirty(
+  size_t position ) //!< I - position in the order of the tree
+{
+  std::uint32_t leaf = _leaves[position];
+  if ( leaf == c_no_node || _nodes[leaf]._dirty )
+    return;
+  _nodes[leaf]._dirty = true;
+  _dirty_leaves.push_back( leaf );
+}
+
+
+/******************************************************************//**
+* \brief   Allocate a node.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::uint32_t CSceneBVH::NewNode( void )
+{
+  TNode node{};
+  node._left   = c_no_node;
+  node._right  = c_no_node;
+  node._parent = c_no_node;
+  _nodes.push_back( node );
+  return (std::uint32_t)_nodes.size() - 1;
+}
+
+
+/******************************************************************//**
+* \brief   Build the subtree of a range of positions.
+*
+* The range is split by a binned surface area heuristic along the
+* longest axis of the bounds of the centers of the boxes. The
+* positions are partitioned in place.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::Build(
+  std::uint32_t node,   //!< I - node index
+  std::uint32_t first,  //!< I - first position of the range
+  std::uint32_t count,  //!< I - number of positions
+  std::uint32_t parent ) //!< I - parent node
+{
+  TBounds bounds, centers;
+  for ( std::uint32_t p = first; p < first + count; ++ p )
+  {
+    std::array<float, 3> min{ _min_x[p], _min_y[p], _min_z[p] };
+    std::array<float, 3> max{ _max_x[p], _max_y[p], _max_z[p] };
+    bounds.Add( min, max );
+    if ( _objects[p] != c_no_object )
+      centers.Add( { (min[0] + max[0]) * 0.5f, (min[1] + max[1]) * 0.5f, (min[2] + max[2]) * 0.5f } );
+  }
+
+  TNode &n = _nodes[node];
+  n._min        = bounds._min;
+  n._max        = bounds._max;
+  n._first      = first;
+  n._count      = count;
+  n._left       = c_no_node;
+  n._right      = c_no_node;
+  n._parent     = parent;
+  n._build_area = bounds.Area();
+  n._dirty      = false;
+
+  if ( count <= c_leaf_size )
+  {
+    for ( std::uint32_t p = first; p < first + count; ++ p )
+      _leaves[p] = node;
+    return;
+  }
+
+  // longest axis of the centers
+  int axis = 0;
+  float extent = -1.0f;
+  for ( int i = 0; i < 3; ++ i )
+  {
+    float e = centers._max[i] - centers._min[i];
+    if ( e > extent )
+    {
+      extent = e;
+      axis = i;
+    }
+  }
+  const std::vector<float> &min_a = axis == 0 ? _min_x : (axis == 1 ? _min_y : _min_z);
+  const std::vector<float> &max_a = axis == 0 ? _max_x : (axis == 1 ? _max_y : _max_z);
+
+  auto swap = [this]( std::uint32_t a, std::uint32_t b )
+  {
+    std::swap( _min_x[a], _min_x[b] );
+    std::swap( _min_y[a], _min_y[b] );
+    std::swap( _min_z[a], _min_z[b] );
+    std::swap( _max_x[a], _max_x[b] );
+    std::swap( _max_y[a], _max_y[b] );
+    std::swap( _max_z[a], _max_z[b] );
+    std::swap( _objects[a], _objects[b] );
+    std::swap( _keys[a], _keys[b] );
+    if ( _objects[a] != c_no_object )
+      _position[_objects[a]] = a;
+    if ( _objects[b] != c_no_object )
+      _position[_objects[b]] = b;
+  };
+
+  std::uint32_t split = count / 2;
+  if ( extent > 0.0f )
+  {
+    // bin the centers; removed objects go to the first bin
+    float scale = (float)c_bins * (1.0f - 1.0e-5f) / extent;
+    auto bin_of = [&]( std::uint32_t p ) -> size_t
+    {
+      if ( _objects[p] == c_no_object )
+        return 0;
+      float c = (min_a[p] + max_a[p]) * 0.5f;
+      return std::min( c_bins - 1, (size_t)std::max( 0.0f, (c - centers._min[axis]) * scale ) );
+    };
+
+    std::array<TBin, c_bins> bins;
+    for ( std::uint32_t p = first; p < first + count; ++ p )
+    {
+      TBin &bin = bins[bin_of( p )];
+      bin._bounds.Add( { _min_x[p], _min_y[p], _min_z[p] }, { _max_x[p], _max_y[p], _max_z[p] } );
+      ++ bin._count;
+    }
+
+    // cost of the splits between the bins
+    std::array<float, c_bins> left_cost{};
+    TBounds left;
+    size_t left_count = 0;
+    for ( size_t i = 0; i + 1 < c_bins; ++ i )
+    {
+      left.Add( bins[i]._bounds._min, bins[i]._bounds._max );
+      left_count += bins[i]._count;
+      left_cost[i] = left.Area() * (float)left_count;
+    }
+    TBounds right;
+    size_t right_count = 0;
+    size_t best = 0;
+    float best_cost = std::numeric_limits<float>::max();
+    for ( size_t i = c_bins - 1; i > 0; -- i )
+    {
+      right.Add( bins[i]._bounds._min, bins[i]._bounds._max );
+      right_count += bins[i]._count;
+      float cost = left_cost[i - 1] + right.Area() * (float)right_count;
+      if ( right_count > 0 && right_count < count && cost < best_cost )
+      {
+        best_cost = cost;
+        best = i;
+      }
+    }
+
+    // partition the positions
+    if ( best > 0 )
+    {
+      std::uint32_t i = first, j = first + count;
+      while ( i < j )
+      {
+        if ( bin_of( i ) < best )
+          ++ i;
+        else
+          swap( i, -- j );
+      }
+      if ( i > first && i < first + count )
+        split = i - first;
+    }
+  }
+
+  std::uint32_t left_node  = NewNode();
+  std::uint32_t right_node = NewNode();
+  _nodes[node]._left  = left_node;
+  _nodes[node]._right = right_node;
+  Build( left_node, first, split, node );
+  Build( right_node, first + split, count - split, node );
+}
+
+
+/******************************************************************//**
+* \brief   Rebuild the subtree of a node in place.
+*
+* The nodes of the old subtree are not reused; they count as garbage.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CSceneBVH::RebuildSubtree(
+  std::uint32_t node ) //!< I - root of the subtree
+{
+  _garbage += SubtreeSize( node ) - 1;
+  ++ _statistics._subtree_rebuilds;
+  TNode n = _nodes[node];
+  Build( node, n._first, n._count, n._parent );
+}
+
+
+/******************************************************************//**
+* \brief   Number of nodes of a subtree.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CSceneBVH::SubtreeSize(
+  std::uint32_t node ) //!< I - root of the subtree
+  const
+{
+  size_t count = 0;
+  std::vector<std::uint32_t> stack{ node };
+  while ( stack.empty() == false )
+  {
+    std::uint32_t i = stack.back();
+    stack.pop_back();
+    ++ count;
+    if ( _nodes[i]._left != c_no_node )
+    {
+      stack.push_back( _nodes[i]._left );
+      stack.push_back( _nodes[i]._right );
+    }
+  }
+  return count;
+}
+
+
+/******************************************************************//**
+* \brief   Refit the bounds of a node to its objects or its children.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CSceneBVH::Refit(
+  std::uint32_t node ) //!< I - node index
+{
+  TNode &n = _nodes[node];
+  TBounds bounds;
+  if ( n._left == c_no_node )
+  {
+    for ( std::uint32_t p = n._first; p < n._first + n._count; ++ p )
+      bounds.Add( { _min_x[p], _min_y[p], _min_z[p] }, { _max_x[p], _max_y[p], _max_z[p] } );
+  }
+  else
+  {
+    bounds.Add( _nodes[n._left]._min, _nodes[n._left]._max );
+    bounds.Add( _nodes[n._right]._min, _nodes[n._right]._max );
+  }
+  bool changed = bounds._min != n._min || bounds._max != n._max;
+  n._min = bounds._min;
+  n._max = bounds._max;
+  return changed;
+}
+
+
+namespace
+{
+
+
+//! arrays of the boxes and the output of a range test
+struct TRangeTest
+{
+  std::array<const float*, 3> _min;
+  std::array<const float*, 3> _max;
+  const std::uint32_t        *_objects;
+  const std::uint64_t        *_keys;
+  CSceneBVH::TVisibleList    *_visible;
+};
+
+
+//! add the objects of a position to the visible list
+inline void Emit( const TRangeTest &range, size_t p )
+{
+  if ( range._objects[p] != CSceneBVH::c_no_object )
+    range._visible->push_back( { range._keys[p], range._objects[p] } );
+}
+
+
+//! distance of the positive vertex of a box to a plane
+inline float PositiveDistance( const TVec4 &plane, const float *min, const float *max )
+{
+  float x = plane[0] >= 0.0f ? max[0] : min[0];
+  float y = plane[1] >= 0.0f ? max[1] : min[1];
+  float z = plane[2] >= 0.0f ? max[2] : min[2];
+  return plane[0] * x + plane[1] * y + plane[2] * z + plane[3];
+}
+
+
+//! distance of the negative vertex of a box to a plane
+inline float NegativeDistance( const TVec4 &plane, const float *min, const float *max )
+{
+  float x = plane[0] >= 0.0f ? min[0] : max[0];
+  float y = plane[1] >= 0.0f ? min[1] : max[1];
+  float z = plane[2] >= 0.0f ? min[2] : max[2];
+  return plane[0] * x + plane[1] * y + plane[2] * z + plane[3];
+}
+
+
+//! square of the distance of the nearest point of a box to a point
+inline float NearDistance2( const TVec3 &eye, const float *min, const float *max )
+{
+  float d2 = 0.0f;
+  for ( int i = 0; i < 3; ++ i )
+  {
+    float d = std::max( std::max( min[i] - eye[i], eye[i] - max[i] ), 0.0f );
+    d2 += d * d;
+  }
+  return d2;
+}
+
+
+//! square of the distance of the farthest point of a box to a point
+inline float FarDistance2( const TVec3 &eye, const float *min, const float *max )
+{
+  float d2 = 0.0f;
+  for ( int i = 0; i < 3; ++ i )
+  {
+    float d = std::max( std::fabs( min[i] - eye[i] ), std::fabs( max[i] - eye[i] ) );
+    d2 += d * d;
+  }
+  return d2;
+}
+
+
+#if defined(RENDERUTIL_SCENEBVH_AVX2) || defined(RENDERUTIL_SCENEBVH_SSE2)
+
+//! test a range of boxes against the active planes and the distance, `TLanes::c_width` boxes at once
+template <class TLanes>
+void TestRange(
+  const TRangeTest                &range,
+  const std::array<TVec4, 6>      &planes,
+  const TVec3                     &eye,
+  float                            max_distance2,
+  unsigned int                     tests,
+  size_t                           first,
+  size_t                           count )
+{
+  using T = typename TLanes::T;
+  const size_t W = TLanes::c_width;
+
+  // per active plane: coefficients and the arrays of the positive vertex
+  struct TPlane
+  {
+    T            _a, _b, _c, _d;
+    const float *_x, *_y, *_z;
+  };
+  std::array<TPlane, 6> active;
+  size_t no_of_active = 0;
+  for ( int k = 0; k < 6; ++ k )
+  {
+    if ( (tests & (1u << k)) == 0 )
+      continue;
+    const TVec4 &p = planes[k];
+    TPlane &plane = active[no_of_active ++];
+    plane._a = TLanes::Set( p[0] );
+    plane._b = TLanes::Set( p[1] );
+    plane._c = TLanes::Set( p[2] );
+    plane._d = TLanes::Set( p[3] );
+    plane._x = p[0] >= 0.0f ? range._max[0] : range._min[0];
+    plane._y = p[1] >= 0.0f ? range._max[1] : range._min[1];
+    plane._z = p[2] >= 0.0f ? range._max[2] : range._min[2];
+  }
+  const bool distance = (tests & c_distance_bit) != 0;
+  const T ex = TLanes::Set( eye[0] ), ey = TLanes::Set( eye[1] ), ez = TLanes::Set( eye[2] );
+  const T r2 = TLanes::Set( max_distance2 ), zero = TLanes::Set( 0.0f );
+
+  for ( size_t p = first; p < first + count; p += W )
+  {
+    T mask = TLanes::True();
+    for ( size_t k = 0; k < no_of_active; ++ k )
+    {
+      const TPlane &plane = active[k];
+      T d = TLanes::Add( TLanes::Add( TLanes::Add(
+        TLanes::Mul( plane._a, TLanes::Load( plane._x + p ) ),
+        TLanes::Mul( plane._b, TLanes::Load( plane._y + p ) ) ),
+        TLanes::Mul( plane._c, TLanes::Load( plane._z + p ) ) ),
+        plane._d );
+      mask = TLanes::And( mask, TLanes::Ge( d, zero ) );
+    }
+    if ( distance && TLanes::Bits( mask ) != 0 )
+    {
+      T dx = TLanes::Max( TLanes::Max( TLanes::Sub( TLanes::Load( range._min[0] + p ), ex ), TLanes::Sub( ex, TLanes::Load( range._max[0] + p ) ) ), zero );
+      T dy = TLanes::Max( TLanes::Max( TLanes::Sub( TLanes::Load( range._min[1] + p ), ey ), TLanes::Sub( ey, TLanes::Load( range._max[1] + p ) ) ), zero );
+      T dz = TLanes::Max( TLanes::Max( TLanes::Sub( TLanes::Load( range._min[2] + p ), ez ), TLanes::Sub( ez, TLanes::Load( range._max[2] + p ) ) ), zero );
+      T d2 = TLanes::Add( TLanes::Add( TLanes::Mul( dx, dx ), TLanes::Mul( dy, dy ) ), TLanes::Mul( dz, dz ) );
+      mask = TLanes::And( mask, TLanes::Le( d2, r2 ) );
+    }
+
+    unsigned int bits = (unsigned int)TLanes::Bits( mask );
+    size_t rest = first + count - p;
+    if ( rest < W )
+      bits &= (1u << rest) - 1;
+    while ( bits != 0 )
+    {
+      Emit( range, p + LowestBit( bits ) );
+      bits &= bits - 1;
+    }
+  }
+}
+
+#else
+
+//! test a range of boxes against the active planes and the distance
+template <class TLanes>
+void TestRange(
+  const TRangeTest                &range,
+  const std::array<TVec4, 6>      &planes,
+  const TVec3                     &eye,
+  float                            max_distance2,
+  unsigned int                     tests,
+  size_t                           first,
+  size_t                           count )
+{
+  for ( size_t p = first; p < first + count; ++ p )
+  {
+    float min[3]{ range._min[0][p], range._min[1][p], range._min[2][p] };
+    float max[3]{ range._max[0][p], range._max[1][p], range._max[2][p] };
+    bool inside = true;
+    for ( int k = 0; k < 6 && inside; ++ k )
+    {
+      if ( tests & (1u << k) )
+        inside = PositiveDistance( planes[k], min, max ) >= 0.0f;
+    }
+    if ( inside && (tests & c_distance_bit) != 0 )
+      inside = NearDistance2( eye, min, max ) <= max_distance2;
+    if ( inside )
+      Emit( range, p );
+  }
+}
+
+#endif
+
+
+#if defined(RENDERUTIL_SCENEBVH_AVX2)
+using TLanes = TLanesAVX2;
+#elif defined(RENDERUTIL_SCENEBVH_SSE2)
+using TLanes = TLanesSSE2;
+#else
+struct TLanes {};
+#endif
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   Traverse the tree and test the pending objects.
+*
+* Each node is classified against the active tests. A test, which the
+* node passes entirely, is dropped for its subtree.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CSceneBVH::TCullStatistics CSceneBVH::Cull(
+  const TCullParameters &parameters, //!< I - planes and distance
+  TVisibleList          &visible )   //!< O - visible objects
+  const
+{
+  TCullStatistics statistics;
+  visible.clear();
+
+  TRangeTest range;
+  range._min     = { _min_x.data(), _min_y.data(), _min_z.data() };
+  range._max     = { _max_x.data(), _max_y.data(), _max_z.data() };
+  range._objects = _objects.data();
+  range._keys    = _keys.data();
+  range._visible = &visible;
+
+  auto test_range = [&]( unsigned int tests, size_t first, size_t count )
+  {
+    TestRange<TLanes>( range, parameters._planes, parameters._eye, parameters._max_distance2, tests, first, count );
+    statistics._tested += count;
+  };
+
+  if ( _built > 0 && _nodes.empty() == false )
+  {
+    std::vector<std::pair<std::uint32_t, unsigned int>> stack;
+    stack.reserve( 64 );
+    stack.emplace_back( 0, parameters._tests );
+    while ( stack.empty() == false )
+    {
+      auto [node_index, tests] = stack.back();
+      stack.pop_back();
+      const TNode &node = _nodes[node_index];
+      ++ statistics._nodes;
+
+      // classify the node
+      const float *min = node._min.data(), *max = node._max.data();
+      bool outside = false;
+      for ( int k = 0; k < 6 && outside == false; ++ k )
+      {
+        if ( (tests & (1u << k)) == 0 )
+          continue;
+        if ( PositiveDistance( parameters._planes[k], min, max ) < 0.0f )
+          outside = true;
+        else if ( NegativeDistance( parameters._planes[k], min, max ) >= 0.0f )
+          tests &= ~(1u << k);
+      }
+      if ( outside == false && (tests & c_distance_bit) != 0 )
+      {
+        if ( NearDistance2( parameters._eye, min, max ) > parameters._max_distance2 )
+          outside = true;
+        else if ( FarDistance2( parameters._eye, min, max ) <= parameters._max_distance2 )
+          tests &= ~c_distance_bit;
+      }
+      if ( outside )
+        continue;
+
+      if ( tests == 0 )
+      {
+        // entirely inside: all the objects are visible
+        for ( size_t p = node._first; p < node._first + node._count; ++ p )
+          Emit( range, p );
+        statistics._accepted += node._count;
+      }
+      else if ( node._left == c_no_node )
+      {
+        test_range( tests, node._first, node._count );
+      }
+      else
+      {
+        stack.emplace_back( node._right, tests );
+        stack.emplace_back( node._left, tests );
+      }
+    }
+  }
+
+  // objects which are not in the tree yet
+  if ( _size > _built )
+    test_range( parameters._tests, _built, _size - _built );
+
+  SortByKey( visible );
+  statistics._visible = visible.size();
+  return statistics;
+}
+
+
+} // Render
@@ -0,0 +1,519 @@
+/******************************************************************//**
+* \brief   Retained text meshes.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_TextMeshCache.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cstring>
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+const size_t c_vertex_floats = 5; //!< x y z u v
+
+
+} // anonymous namespace
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CTextMeshCache::CTextMeshCache(
+  IDrawBufferProvider            &buffer_provider, //!< in: provider of the shared vertex buffer
+  const TTextMeshCacheParameters &parameters )     //!< in: capacity of the cache
+  : _buffer_provider( buffer_provider )
+  , _parameters( parameters )
+{
+  _vertices.resize( _parameters._capacity * c_vertex_floats, 0.0f );
+  if ( _parameters._capacity > 0 )
+    _free[0] = _parameters._capacity;
+}
+
+
+/******************************************************************//**
+* \brief   Remove all texts.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTextMeshCache::Clear( void )
+{
+  _entries.clear();
+  _handles.clear();
+  _lru.clear();
+  _queue.clear();
+  _free.clear();
+  if ( _parameters._capacity > 0 )
+    _free[0] = _parameters._capacity;
+  _used = 0;
+  _dirty = false;
+}
+
+
+/******************************************************************//**
+* \brief   Get the handle of a retained text.
+*
+* If the text isn't cached, then it is laid out and stored in the
+* shared buffer. The handle stays valid, as long as the text isn't
+* evicted. Texts, which are acquired or drawn in the current frame,
+* are not evicted.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+TTextMeshHandle CTextMeshCache::Acquire(
+  IFont     &font,        //!< in: font of the text
+  t_s_param  str,         //!< in: the text
+  float      height,      //!< in: the maximum height of the text from the bottom to the top
+  float      width_scale ) //!< in: scale of the text in the y direction
+{
+  TKey key{ &font, str, height, width_scale };
+  auto it_handle = _handles.find( key );
+  if ( it_handle != _handles.end() )
+  {
+    Touch( _entries[it_handle->second] );
+    ++ _statistics._hits;
+    return it_handle->second;
+  }
+
+  ++ _statistics._misses;
+  if ( font.Layout( str, height, width_scale, _layout ) == false )
+    return no_text_mesh;
+
+  while ( _entries.size() >= _parameters._max_entries )
+  {
+    if ( EvictLeastRecentlyUsed() == false )
+      return no_text_mesh;
+  }
+
+  TEntry entry;
+  entry._key = std::move( key );
+  if ( Store( entry, _layout ) == false )
+    return no_text_mesh;
+
+  TTextMeshHandle handle = _next_handle ++;
+  _lru.push_front( handle );
+  entry._lru = _lru.begin();
+  entry._last_use = _frame;
+  _handles[entry._key] = handle;
+  _entries.emplace( handle, std::move( entry ) );
+  return handle;
+}
+
+
+/******************************************************************//**
+* \brief   Queue a retained text for drawing.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextMeshCache::Draw(
+  TTextMeshHandle  handle, //!< in: handle of the text
+  const TPoint3   &pos,    //!< in: the reference position
+  const TColor    &color ) //!< in: color of the text
+{
+  auto it = _entries.find( handle );
+  if ( it == _entries.end() )
+    return false;
+
+  Touch( it->second );
+  _queue.push_back( { handle, pos, color } );
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Draw the queued labels.
+*
+* Texts, whose glyphs were evicted from the glyph atlas, are laid out
+* again. Laying out a text can evict glyphs of an other text, so this
+* is repeated once. Labels, whose texts are still out of date, are
+* skipped in this frame, because their texture coordinates refer to
+* evicted glyphs. Then the modified range of the shared buffer is
+* uploaded and the page draws of the labels are sorted by font, atlas
+* page and color. Each run of equal draws is passed to the callback,
+* which is expected to draw it by a single multi draw call.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTextMeshCache::Flush(
+  const TDrawBatch &draw_batch ) //!< in: draw a batch of labels
+{
+  if ( _queue.empty() )
+  {
+    ++ _frame;
+    return;
+  }
+
+  // lay out the texts again, which refer to evicted glyphs
+  for ( int pass = 0; pass < 2; ++ pass )
+  {
+    for ( const TQueued &queued : _queue )
+    {
+      TEntry &entry = _entries[queued._handle];
+      IFont  &font  = *entry._key._font;
+      if ( entry._revision == font.LayoutRevision() )
+        continue;
+
+      ++ _statistics._relayouts;
+      if ( font.Layout( entry._key._text, entry._key._height, entry._key._width_scale, _layout ) == false || Store( entry, _layout ) == false )
+      {
+        // the text can't be drawn; keep it empty until the next layout
+        Free( entry._offset, entry._size );
+        entry._size = 0;
+        entry._page_start.assign( 1, 0 );
+        entry._textures.clear();
+        entry._revision = font.LayoutRevision();
+      }
+    }
+  }
+
+  // upload the modified vertices
+  if ( _dirty )
+  {
+    if ( _buffer == nullptr )
+    {
+      _buffer = _buffer_provider.NewDrawBuffer( TDrawBufferUsage::dynamic_draw );
+      const std::vector<char> bufferdescr = IDrawBuffer::VADescription( TVA::b0_xyz_uv );
+      _buffer->SpecifyVA( bufferdescr.size(), bufferdescr.data() );
+    }
+
+    // the used range ends, where the last free range reaches the end of the buffer
+    size_t used_end = _parameters._capacity;
+    if ( _free.empty() == false && _free.rbegin()->first + _free.rbegin()->second == _parameters._capacity )
+      used_end = _free.rbegin()->first;
+    _buffer->UpdateVB( 0, sizeof( float ), std::max( used_end, (size_t)1 ) * c_vertex_floats, _vertices.data() );
+    _dirty = false;
+    ++ _statistics._uploads;
+  }
+
+  // collect the page draws of the labels
+  _page_draws.clear();
+  for ( const TQueued &queued : _queue )
+  {
+    const TEntry &entry = _entries[queued._handle];
+    if ( entry._revision != entry._key._font->LayoutRevision() )
+    {
+      ++ _statistics._skipped;
+      continue;
+    }
+    for ( size_t page = 0; page < entry._textures.size(); ++ page )
+    {
+      size_t count = entry._page_start[page + 1] - entry._page_start[page];
+      if ( count == 0 || entry._textures[page] == nullptr )
+        continue;
+      _page_draws.push_back( { entry._key._font, entry._textures[page], queued._color, (int)( entry._offset + entry._page_start[page] ), (int)count, queued._pos } );
+    }
+  }
+  _statistics._labels += _queue.size();
+  _queue.clear();
+  ++ _frame;
+  if ( _page_draws.empty() || _buffer == nullptr )
+    return;
+
+  std::stable_sort( _page_draws.begin(), _page_draws.end(), []( const TPageDraw &a, const TPageDraw &b ) -> bool
+  {
+    return std::tie( a._font, a._texture, a._color ) < std::tie( b._font, b._texture, b._color );
+  } );
+
+  _first.resize( _page_draws.size() );
+  _count.resize( _page_draws.size() );
+  _offsets.resize( _page_draws.size() * 4 );
+  for ( size_t i = 0; i < _page_draws.size(); ++ i )
+  {
+    const TPageDraw &page_draw = _page_draws[i];
+    _first[i] = page_draw._first;
+    _count[i] = page_draw._count;
+    _offsets[i*4]   = page_draw._pos[0];
+    _offsets[i*4+1] = page_draw._pos[1];
+    _offsets[i*4+2] = page_draw._pos[2];
+    _offsets[i*4+3] = 0.0f;
+  }
+
+  // one batch for each run of draws with the same font, page and color
+  for ( size_t begin = 0; begin < _page_draws.size(); )
+  {
+    const TPageDraw &first = _page_draws[begin];
+    size_t end = begin + 1;
+    while ( end < _page_draws.size() && _page_draws[end]._font == first._font && _page_draws[end]._texture == first._texture && _page_draws[end]._color == first._color )
+      ++ end;
+
+    TTextMeshBatch batch;
+    batch._font    = first._font;
+    batch._texture = first._texture;
+    batch._color   = first._color;
+    batch._draws   = end - begin;
+    batch._first   = _first.data() + begin;
+    batch._count   = _count.data() + begin;
+    batch._offsets = _offsets.data() + begin * 4;
+    draw_batch( *_buffer, batch );
+    ++ _statistics._draw_calls;
+
+    begin = end;
+  }
+}
+
+
+/******************************************************************//**
+* \brief   Store the layout of a text in the shared buffer.
+*
+* If the number of vertices changed, then the range of the text is
+* reallocated. If there is no free range, which is large enough, then
+* the buffer is compacted, or the least recently used texts are
+* evicted.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextMeshCache::Store(
+  TEntry            &entry,   //!< in, out: the text
+  const TTextLayout &layout ) //!< in: glyph quads of the text
+{
+  size_t size = layout._vertices.size() / c_vertex_floats;
+  if ( size != entry._size )
+  {
+    Free( entry._offset, entry._size );
+    entry._offset = 0;
+    entry._size   = 0;
+
+    size_t offset = 0;
+    while ( Allocate( size, offset ) == false )
+    {
+      // the free space is sufficient, but it is fragmented
+      if ( _parameters._capacity - _used >= size && _free.size() > 1 )
+      {
+        Compact();
+        continue;
+      }
+      if ( EvictLeastRecentlyUsed() == false )
+        return false;
+    }
+    entry._offset = offset;
+    entry._size   = size;
+  }
+
+  if ( size > 0 )
+    std::memcpy( _vertices.data() + entry._offset * c_vertex_floats, layout._vertices.data(), size * c_vertex_floats * sizeof( float ) );
+  entry._page_start = layout._page_start;
+  entry._textures   = layout._textures;
+  entry._revision   = layout._revision;
+  _dirty = true;
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Allocate a range of the shared buffer (first fit).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextMeshCache::Allocate(
+  size_t  size,    //!< in: number of vertices
+  size_t &offset ) //!< out: first vertex of the range
+{
+  offset = 0;
+  if ( size == 0 )
+    return true;
+
+  for ( auto it = _free.begin(); it != _free.end(); ++ it )
+  {
+    if ( it->second < size )
+      continue;
+
+    offset = it->first;
+    size_t rest = it->second - size;
+    _free.erase( it );
+    if ( rest > 0 )
+      _free[offset + size] = rest;
+    _used += size;
+    return true;
+  }
+  return false;
+}
+
+
+/******************************************************************//**
+* \brief   Release a range of the shared buffer and merge it with the
+* adjacent free ranges.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTextMeshCache::Free(
+  size_t offset, //!< in: first vertex of the range
+  size_t size )  //!< in: number of vertices
+{
+  if ( size == 0 )
+    return;
+
+  _used -= size;
+  auto it = _free.emplace( offset, size ).first;
+
+  auto next = std::next( it );
+  if ( next != _free.end() && it->first + it->second == next->first )
+  {
+    it->second += next->second;
+    _free.erase( next );
+  }
+
+  if ( it != _free.begin() )
+  {
+    auto prev = std::prev( it );
+    if ( prev->first + prev->second == it->first )
+    {
+      prev->second += it->second;
+      _free.erase( it );
+    }
+  }
+}
+
+
+/******************************************************************//**
+* \brief   Evict the least recently used text, which isn't used in the
+* current frame.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextMeshCache::EvictLeastRecentlyUsed( void )
+{
+  for ( auto it = _lru.rbegin(); it != _lru.rend(); ++ it )
+  {
+    if ( _entries[*it]._last_use == _frame )
+      continue;
+
+    Erase( *it );
+    ++ _statistics._evictions;
+    return true;
+  }
+  return false;
+}
+
+
+/******************************************************************//**
+* \brief   Remove a text.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTextMeshCache::Erase(
+  TTextMeshHandle handle ) //!< in: handle of the text
+{
+  auto it = _entries.find( handle );
+  if ( it == _entries.end() )
+    return;
+
+  TEntry &entry = it->second;
+  Free( entry._offset, entry._size );
+  _handles.erase( entry._key );
+  _lru.erase( entry._lru );
+  _entries.erase( it );
+}
+
+
+/******************************************************************//**
+* \brief   Move all texts to the start of the shared buffer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTextMeshCache::Compact( void )
+{
+  std::vector<TEntry*> entries;
+  entries.reserve( _entries.size() );
+  for ( auto &it : _entries )
+  {
+    if ( it.second._size > 0 )
+      entries.push_back( &it.second );
+  }
+  std::sort( entries.begin(), entries.end(), []( const TEntry *a, const TEntry *b ) -> bool
+  {
+    return a->_offset < b->_offset;
+  } );
+
+  size_t offset = 0;
+  for ( TEntry *entry : entries )
+  {
+    if ( entry->_offset != offset )
+      std::memmove( _vertices.data() + offset * c_vertex_floats, _vertices.data() + entry->_offset * c_vertex_floats, entry->_size * c_vertex_floats * sizeof( float ) );
+    entry->_offset = offset;
+    offset += entry->_size;
+  }
+
+  _free.clear();
+  if ( offset < _parameters._capacity )
+    _free[offset] = _parameters._capacity - offset;
+  _dirty = true;
+  ++ _statistics._compactions;
+}
+
+
+/******************************************************************//**
+* \brief   Mark a text as used in the current frame.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTextMeshCache::Touch(
+  TEntry &entry ) //!< in, out: the text
+{
+  entry._last_use = _frame;
+  if ( entry._lru != _lru.begin() )
+    _lru.splice( _lru.begin(), _lru, entry._lru );
+}
+
+
+} // Render
@@ -0,0 +1,994 @@
+/******************************************************************//**
+* \brief   KTX2 and DDS texture container reader and writer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_TextureContainer.h"
+
+
+// OS
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// STL
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+const t_byte c_ktx2_identifier[12]{ 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+const size_t c_ktx2_header_size = 80; //!< identifier, header and index
+const size_t c_ktx2_level_size  = 24; //!< size of one entry of the level index
+
+
+//! `VkFormat` values of the supported formats
+enum : std::uint32_t
+{
+  VK_R8_UNORM           = 9,
+  VK_R8G8B8_UNORM       = 23,
+  VK_R8G8B8_SRGB        = 29,
+  VK_B8G8R8_UNORM       = 30,
+  VK_B8G8R8_SRGB        = 36,
+  VK_R8G8B8A8_UNORM     = 37,
+  VK_R8G8B8A8_SRGB      = 43,
+  VK_B8G8R8A8_UNORM     = 44,
+  VK_B8G8R8A8_SRGB      = 50,
+  VK_BC1_RGB_UNORM      = 131,
+  VK_BC1_RGB_SRGB       = 132,
+  VK_BC1_RGBA_UNORM     = 133,
+  VK_BC1_RGBA_SRGB      = 134,
+  VK_BC3_UNORM          = 137,
+  VK_BC3_SRGB           = 138,
+  VK_BC4_UNORM          = 139,
+  VK_BC5_UNORM          = 141,
+  VK_BC7_UNORM          = 145,
+  VK_BC7_SRGB           = 146,
+};
+
+
+//! `DXGI_FORMAT` values of the supported formats
+enum : std::uint32_t
+{
+  DXGI_R8G8B8A8_UNORM      = 28,
+  DXGI_R8G8B8A8_UNORM_SRGB = 29,
+  DXGI_R8_UNORM            = 61,
+  DXGI_BC1_UNORM           = 71,
+  DXGI_BC1_UNORM_SRGB      = 72,
+  DXGI_BC3_UNORM           = 77,
+  DXGI_BC3_UNORM_SRGB      = 78,
+  DXGI_BC4_UNORM           = 80,
+  DXGI_BC5_UNORM           = 83,
+  DXGI_B8G8R8A8_UNORM      = 87,
+  DXGI_B8G8R8A8_UNORM_SRGB = 91,
+  DXGI_BC7_UNORM           = 98,
+  DXGI_BC7_UNORM_SRGB      = 99,
+};
+
+
+//! DDS header flags and constants
+enum : std::uint32_t
+{
+  DDS_MAGIC              = 0x20534444, // "DDS "
+  DDS_HEADER_SIZE        = 124,
+  DDS_PIXELFORMAT_SIZE   = 32,
+  DDSD_CAPS              = 0x1,
+  DDSD_HEIGHT            = 0x2,
+  DDSD_WIDTH             = 0x4,
+  DDSD_PITCH             = 0x8,
+  DDSD_PIXELFORMAT       = 0x1000,
+  DDSD_MIPMAPCOUNT       = 0x20000,
+  DDSD_LINEARSIZE        = 0x80000,
+  DDPF_ALPHAPIXELS       = 0x1,
+  DDPF_FOURCC            = 0x4,
+  DDPF_RGB               = 0x40,
+  DDPF_LUMINANCE         = 0x20000,
+  DDSCAPS_COMPLEX        = 0x8,
+  DDSCAPS_TEXTURE        = 0x1000,
+  DDSCAPS_MIPMAP         = 0x400000,
+  DDSCAPS2_CUBEMAP_ALL   = 0xFE00,
+  DDS_DIMENSION_TEXTURE2D = 3,
+  DDS_RESOURCE_MISC_TEXTURECUBE = 0x4,
+  DDS_ALPHA_MODE_MASK    = 0x7,
+  DDS_ALPHA_MODE_OPAQUE  = 0x3,
+};
+
+
+constexpr std::uint32_t FourCC( char a, char b, char c, char d )
+{
+  return (std::uint32_t)(t_byte)a | ((std::uint32_t)(t_byte)b << 8) | ((std::uint32_t)(t_byte)c << 16) | ((std::uint32_t)(t_byte)d << 24);
+}
+
+
+template <typename T>
+T ReadValue( const t_byte *data, size_t offset )
+{
+  T value;
+  std::memcpy( &value, data + offset, sizeof( T ) );
+  return value;
+}
+
+
+template <typename T>
+void WriteValue( std::vector<t_byte> &target, size_t offset, T value )
+{
+  if ( target.size() < offset + sizeof( T ) )
+    target.resize( offset + sizeof( T ), 0 );
+  std::memcpy( target.data() + offset, &value, sizeof( T ) );
+}
+
+
+//! size of a level; the shift is clamped, because the level count is read from the file
+size_t LevelExtent( size_t size, size_t level )
+{
+  return level < (size_t)std::numeric_limits<size_t>::digits ? std::max( size >> level, (size_t)1 ) : 1;
+}
+
+
+//! check the header values against the size of the image data, before the level index is allocated
+bool ValidContainerSize( TImageFormat format, size_t cx, size_t cy, size_t levels, size_t layers, size_t data_size )
+{
+  // a complete mip chain has floor(log2(max(cx, cy))) + 1 levels
+  if ( levels == 0 || layers == 0 || levels > (size_t)std::bit_width( std::max( cx, cy ) ) )
+    return false;
+
+  // each texel needs at least half a byte (BC1, BC4), so the level 0 size can't overflow
+  if ( (std::uint64_t)cx * cy > (std::uint64_t)data_size * 2 )
+    return false;
+
+  // each image needs at least one texel or block
+  size_t min_image_size = ImageDataSize( format, 1, 1 );
+  return min_image_size > 0 && layers <= data_size / min_image_size / levels;
+}
+
+
+//! map a `VkFormat` to the image format
+TImageFormat FromVkFormat( std::uint32_t vk_format, bool &srgb )
+{
+  srgb = false;
+  switch ( vk_format )
+  {
+    case VK_R8_UNORM:        return TImageFormat::GRAY8;
+    case VK_R8G8B8_SRGB:     srgb = true; [[fallthrough]];
+    case VK_R8G8B8_UNORM:    return TImageFormat::RGB8;
+    case VK_B8G8R8_SRGB:     srgb = true; [[fallthrough]];
+    case VK_B8G8R8_UNORM:    return TImageFormat::BGR8;
+    case VK_R8G8B8A8_SRGB:   srgb = true; [[fallthrough]];
+    case VK_R8G8B8A8_UNORM:  return TImageFormat::RGBA8;
+    case VK_B8G8R8A8_SRGB:   srgb = true; [[fallthrough]];
+    case VK_B8G8R8A8_UNORM:  return TImageFormat::BGRA8;
+    case VK_BC1_RGB_SRGB:    srgb = true; [[fallthrough]];
+    case VK_BC1_RGB_UNORM:   return TImageFormat::BC1_RGB;
+    case VK_BC1_RGBA_SRGB:   srgb = true; [[fallthrough]];
+    case VK_BC1_RGBA_UNORM:  return TImageFormat::BC1_RGBA;
+    case VK_BC3_SRGB:        srgb = true; [[fallthrough]];
+    case VK_BC3_UNORM:       return TImageFormat::BC3;
+    case VK_BC4_UNORM:       return TImageFormat::BC4;
+    case VK_BC5_UNORM:       return TImageFormat::BC5;
+    case VK_BC7_SRGB:        srgb = true; [[fallthrough]];
+    case VK_BC7_UNORM:       return TImageFormat::BC7;
+    default: break;
+  }
+  return TImageFormat::UNKNOWN;
+}
+
+
+//! map an image format to a `VkFormat`
+std::uint32_t ToVkFormat( TImageFormat format, bool srgb )
+{
+  switch ( format )
+  {
+    case TImageFormat::GRAY8:    return VK_R8_UNORM;
+    case TImageFormat::RGB8:     return srgb ? VK_R8G8B8_SRGB : VK_R8G8B8_UNORM;
+    case TImageFormat::BGR8:     return srgb ? VK_B8G8R8_SRGB : VK_B8G8R8_UNORM;
+    case TImageFormat::RGBA8:    return srgb ? VK_R8G8B8A8_SRGB : VK_R8G8B8A8_UNORM;
+    case TImageFormat::BGRA8:    return srgb ? VK_B8G8R8A8_SRGB : VK_B8G8R8A8_UNORM;
+    case TImageFormat::BC1_RGB:  return srgb ? VK_BC1_RGB_SRGB : VK_BC1_RGB_UNORM;
+    case TImageFormat::BC1_RGBA: return srgb ? VK_BC1_RGBA_SRGB : VK_BC1_RGBA_UNORM;
+    case TImageFormat::BC3:      return srgb ? VK_BC3_SRGB : VK_BC3_UNORM;
+    case TImageFormat::BC4:      return VK_BC4_UNORM;
+    case TImageFormat::BC5:      return VK_BC5_UNORM;
+    case TImageFormat::BC7:      return srgb ? VK_BC7_SRGB : VK_BC7_UNORM;
+    default: break;
+  }
+  return 0;
+}
+
+
+//! map a `DXGI_FORMAT` to the image format
+TImageFormat FromDXGIFormat( std::uint32_t dxgi_format, bool &srgb )
+{
+  srgb = false;
+  switch ( dxgi_format )
+  {
+    case DXGI_R8_UNORM:            return TImageFormat::GRAY8;
+    case DXGI_R8G8B8A8_UNORM_SRGB: srgb = true; [[fallthrough]];
+    case DXGI_R8G8B8A8_UNORM:      return TImageFormat::RGBA8;
+    case DXGI_B8G8R8A8_UNORM_SRGB: srgb = true; [[fallthrough]];
+    case DXGI_B8G8R8A8_UNORM:      return TImageFormat::BGRA8;
+    case DXGI_BC1_UNORM_SRGB:      srgb = true; [[fallthrough]];
+    case DXGI_BC1_UNORM:           return TImageFormat::BC1_RGBA;
+    case DXGI_BC3_UNORM_SRGB:      srgb = true; [[fallthrough]];
+    case DXGI_BC3_UNORM:           return TImageFormat::BC3;
+    case DXGI_BC4_UNORM:           return TImageFormat::BC4;
+    case DXGI_BC5_UNORM:           return TImageFormat::BC5;
+    case DXGI_BC7_UNORM_SRGB:      srgb = true; [[fallthrough]];
+    case DXGI_BC7_UNORM:           return TImageFormat::BC7;
+    default: break;
+  }
+  return TImageFormat::UNKNOWN;
+}
+
+
+//! map the legacy DDS pixel format to the image format
+TImageFormat FromDDSPixelFormat( const t_byte *pf )
+{
+  std::uint32_t flags     = ReadValue<std::uint32_t>( pf, 4 );
+  std::uint32_t fourcc    = ReadValue<std::uint32_t>( pf, 8 );
+  std::uint32_t bit_count = ReadValue<std::uint32_t>( pf, 12 );
+  std::uint32_t r_mask    = ReadValue<std::uint32_t>( pf, 16 );
+
+  if ( flags & DDPF_FOURCC )
+  {
+    if ( fourcc == FourCC( 'D', 'X', 'T', '1' ) )
+      return (flags & DDPF_ALPHAPIXELS) ? TImageFormat::BC1_RGBA : TImageFormat::BC1_RGB;
+    if ( fourcc == FourCC( 'D', 'X', 'T', '5' ) )
+      return TImageFormat::BC3;
+    if ( fourcc == FourCC( 'A', 'T', 'I', '1' ) || fourcc == FourCC( 'B', 'C', '4', 'U' ) )
+      return TImageFormat::BC4;
+    if ( fourcc == FourCC( 'A', 'T', 'I', '2' ) || fourcc == FourCC( 'B', 'C', '5', 'U' ) )
+      return TImageFormat::BC5;
+    return TImageFormat::UNKNOWN;
+  }
+  if ( (flags & DDPF_LUMINANCE) && bit_count == 8 )
+    return TImageFormat::GRAY8;
+  if ( flags & DDPF_RGB )
+  {
+    if ( bit_count == 32 )
+      return r_mask == 0x000000ff ? TImageFormat::RGBA8 : (r_mask == 0x00ff0000 ? TImageFormat::BGRA8 : TImageFormat::UNKNOWN);
+    if ( bit_count == 24 )
+      return r_mask == 0x000000ff ? TImageFormat::RGB8 : (r_mask == 0x00ff0000 ? TImageFormat::BGR8 : TImageFormat::UNKNOWN);
+  }
+  return TImageFormat::UNKNOWN;
+}
+
+
+//! KTX2 data format descriptor (basic descriptor block) of an image format
+std::vector<t_byte> KTX2DataFormatDescriptor( TImageFormat format, bool srgb )
+{
+  // KHR_DF_MODEL_* and KHR_DF_CHANNEL_*
+  enum : t_byte { model_rgbsda = 1, model_bc1a = 128, model_bc3 = 130, model_bc4 = 131, model_bc5 = 132, model_bc7 = 134 };
+  enum : t_byte { channel_red = 0, channel_green = 1, channel_blue = 2, channel_alpha = 15, channel_bc1_alpha = 1 };
+
+  struct TSample { std::uint16_t _offset; t_byte _bits; t_byte _channel; std::uint32_t _upper; };
+  std::vector<TSample> samples;
+  t_byte model = model_rgbsda;
+  bool   compressed = CompressedBlockSize( format ) > 0;
+  switch ( format )
+  {
+    default: break;
+    case TImageFormat::GRAY8: samples = { { 0, 8, channel_red, 255 } }; break;
+    case TImageFormat::RGB8:  samples = { { 0, 8, channel_red, 255 }, { 8, 8, channel_green, 255 }, { 16, 8, channel_blue, 255 } }; break;
+    case TImageFormat::BGR8:  samples = { { 0, 8, channel_blue, 255 }, { 8, 8, channel_green, 255 }, { 16, 8, channel_red, 255 } }; break;
+    case TImageFormat::RGBA8: samples = { { 0, 8, channel_red, 255 }, { 8, 8, channel_green, 255 }, { 16, 8, channel_blue, 255 }, { 24, 8, channel_alpha, 255 } }; break;
+    case TImageFormat::BGRA8: samples = { { 0, 8, channel_blue, 255 }, { 8, 8, channel_green, 255 }, { 16, 8, channel_red, 255 }, { 24, 8, channel_alpha, 255 } }; break;
+    case TImageFormat::BC1_RGB:  model = model_bc1a; samples = { { 0, 64, channel_red, 0xffffffff } }; break;
+    case TImageFormat::BC1_RGBA: model = model_bc1a; samples = { { 0, 64, channel_bc1_alpha, 0xffffffff } }; break;
+    case TImageFormat::BC3:      model = model_bc3;  samples = { { 0, 64, channel_alpha, 0xffffffff }, { 64, 64, channel_red, 0xffffffff } }; break;
+    case TImageFormat::BC4:      model = model_bc4;  samples = { { 0, 64, channel_red, 0xffffffff } }; break;
+    case TImageFormat::BC5:      model = model_bc5;  samples = { { 0, 64, channel_red, 0xffffffff }, { 64, 64, channel_green, 0xffffffff } }; break;
+    case TImageFormat::BC7:      model = model_bc7;  samples = { { 0, 128, channel_red, 0xffffffff } }; break;
+  }
+
+  size_t block_size = 24 + 16 * samples.size();
+  std::vector<t_byte> dfd( 4 + block_size, 0 );
+  WriteValue<std::uint32_t>( dfd, 0, (std::uint32_t)dfd.size() );
+  WriteValue<std::uint32_t>( dfd, 4, 0 );                          // vendor id and descriptor type
+  WriteValue<std::uint16_t>( dfd, 8, 2 );                          // version number
+  WriteValue<std::uint16_t>( dfd, 10, (std::uint16_t)block_size ); // descriptor block size
+  dfd[12] = model;
+  dfd[13] = 1;                                                     // color primaries BT709
+  dfd[14] = srgb ? 2 : 1;                                          // transfer function sRGB or linear
+  dfd[15] = 0;                                                     // flags: straight alpha
+  dfd[16] = compressed ? 3 : 0;                                    // texel block dimensions - 1
+  dfd[17] = compressed ? 3 : 0;
+  dfd[20] = (t_byte)(compressed ? CompressedBlockSize( format ) : ImageTexelSize( format )); // bytes plane 0
+  for ( size_t i = 0; i < samples.size(); ++ i )
+  {
+    size_t offset = 28 + i * 16;
+    WriteValue<std::uint16_t>( dfd, offset, samples[i]._offset );
+    dfd[offset + 2] = (t_byte)(samples[i]._bits - 1);
+    dfd[offset + 3] = samples[i]._channel;
+    WriteValue<std::uint32_t>( dfd, offset + 8, 0 );
+    WriteValue<std::uint32_t>( dfd, offset + 12, samples[i]._upper );
+  }
+  return dfd;
+}
+
+
+//! validate the images of a container, which is written
+bool ValidateImages( const CTextureContainer::TLayerImages &images, size_t faces, TImageFormat &format, size_t &levels )
+{
+  if ( images.empty() || images[0].empty() || images[0][0] == nullptr || faces == 0 || images.size() % faces != 0 )
+    return false;
+
+  format = images[0][0]->Format();
+  levels = images[0].size();
+  TTextureSize size = images[0][0]->Size();
+  if ( ImageDataSize( format, 1, 1 ) == 0 )
+    return false;
+  for ( auto &layer : images )
+  {
+    if ( layer.size() != levels )
+      return false;
+    for ( size_t level = 0; level < levels; ++ level )
+    {
+      const IImageResource *image = layer[level];
+      if ( image == nullptr || image->Format() != format || image->DataPtr() == nullptr ||
+           image->Size()[0] != LevelExtent( size[0], level ) || image->Size()[1] != LevelExtent( size[1], level ) )
+        return false;
+    }
+  }
+  return true;
+}
+
+
+//! write the tightly packed data of an image
+void WriteImageData( std::ostream &stream, const IImageResource &image )
+{
+  TTextureSize  size = image.Size();
+  const t_byte *data = static_cast<const t_byte*>( image.DataPtr() );
+  size_t rows = CompressedBlockSize( image.Format() ) > 0 ? (size[1] + 3) / 4 : size[1];
+  size_t row_size = ImageDataSize( image.Format(), size[0], CompressedBlockSize( image.Format() ) > 0 ? 4 : 1 );
+  for ( size_t y = 0; y < rows; ++ y )
+    stream.write( reinterpret_cast<const char*>( data + y * image.BPL() ), row_size );
+}
+
+
+} // anonymous namespace
+
+
+//---------------------------------------------------------------------
+// CMappedFile
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   dtor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CMappedFile::~CMappedFile()
+{
+  Close();
+}
+
+
+/******************************************************************//**
+* \brief   Map the complete file read only.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CMappedFile::Open(
+  const std::string &filename ) //!< in: path of the file
+{
+  Close();
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+  if ( file == INVALID_HANDLE_VALUE )
+    return false;
+  LARGE_INTEGER size;
+  if ( GetFileSizeEx( file, &size ) == FALSE || size.QuadPart == 0 )
+  {
+    CloseHandle( file );
+    return false;
+  }
+  HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+  if ( mapping == nullptr )
+  {
+    CloseHandle( file );
+    return false;
+  }
+  void *data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+  if ( data == nullptr )
+  {
+    CloseHandle( mapping );
+    CloseHandle( file );
+    return false;
+  }
+  _file_handle    = file;
+  _mapping_handle = mapping;
+  _data           = static_cast<const t_byte*>( data );
+  _size           = (size_t)size.QuadPart;
+#else
+  int file = open( filename.c_str(), O_RDONLY );
+  if ( file < 0 )
+    return false;
+  struct stat file_stat;
+  if ( fstat( file, &file_stat ) != 0 || file_stat.st_size == 0 )
+  {
+    close( file );
+    return false;
+  }
+  void *data = mmap( nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+  close( file );
+  if ( data == MAP_FAILED )
+    return false;
+  _data = static_cast<const t_byte*>( data );
+  _size = (size_t)file_stat.st_size;
+#endif
+
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Unmap the file.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CMappedFile::Close( void )
+{
+  if ( _data == nullptr )
+    return;
+
+#if defined(_WIN32)
+  UnmapViewOfFile( _data );
+  CloseHandle( (HANDLE)_mapping_handle );
+  CloseHandle( (HANDLE)_file_handle );
+  _mapping_handle = nullptr;
+  _file_handle    = nullptr;
+#else
+  munmap( const_cast<t_byte*>( _data ), _size );
+#endif
+
+  _data = nullptr;
+  _size = 0;
+}
+
+
+//---------------------------------------------------------------------
+// CTextureContainer
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   Map the file and read the level index.
+*
+* The file type is detected by the file identifier.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextureContainer::Open(
+  const std::string &filename, //!< in: path of the KTX2 or DDS file
+  TImageKind         kind )    //!< in: kind of the image content
+{
+  Close();
+  if ( _file.Open( filename ) == false )
+  {
+    std::cout << "error: failed to map texture container " << filename << std::endl;
+    return false;
+  }
+
+  bool success = false;
+  if ( _file.Size() >= sizeof( c_ktx2_identifier ) && std::memcmp( _file.Data(), c_ktx2_identifier, sizeof( c_ktx2_identifier ) ) == 0 )
+    success = ReadKTX2( kind );
+  else if ( _file.Size() >= 4 && ReadValue<std::uint32_t>( _file.Data(), 0 ) == DDS_MAGIC )
+    success = ReadDDS( kind );
+
+  if ( success == false )
+  {
+    std::cout << "error: unsupported texture container " << filename << std::endl;
+    Close();
+  }
+  return success;
+}
+
+
+/******************************************************************//**
+* \brief   Unmap the file; all image views become invalid.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTextureContainer::Close( void )
+{
+  _file.Close();
+  _images.clear();
+  _type   = TTextureContainerType::NON;
+  _format = TImageFormat::UNKNOWN;
+  _srgb   = false;
+  _cx = _cy = _levels = _layers = 0;
+  _faces  = 1;
+}
+
+
+/******************************************************************//**
+* \brief   Zero-copy views of all levels of a layer.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::vector<const IImageResource*> CTextureContainer::MipChain(
+  size_t layer ) //!< in: layer index (array layer * faces + face)
+  const
+{
+  std::vector<const IImageResource*> chain;
+  if ( layer >= _layers )
+    return chain;
+  for ( size_t level = 0; level < _levels; ++ level )
+    chain.push_back( &Image( level, layer ) );
+  return chain;
+}
+
+
+/******************************************************************//**
+* \brief   Read the KTX2 header and level index.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextureContainer::ReadKTX2(
+  TImageKind kind ) //!< in: kind of the image content
+{
+  const t_byte *data = _file.Data();
+  size_t        size = _file.Size();
+  if ( size < c_ktx2_header_size )
+    return false;
+
+  std::uint32_t vk_format      = ReadValue<std::uint32_t>( data, 12 );
+  std::uint32_t width          = ReadValue<std::uint32_t>( data, 20 );
+  std::uint32_t height         = ReadValue<std::uint32_t>( data, 24 );
+  std::uint32_t depth          = ReadValue<std::uint32_t>( data, 28 );
+  std::uint32_t layer_count    = ReadValue<std::uint32_t>( data, 32 );
+  std::uint32_t face_count     = ReadValue<std::uint32_t>( data, 36 );
+  std::uint32_t level_count    = ReadValue<std::uint32_t>( data, 40 );
+  std::uint32_t supercompression = ReadValue<std::uint32_t>( data, 44 );
+
+  _format = FromVkFormat( vk_format, _srgb );
+  if ( _format == TImageFormat::UNKNOWN || supercompression != 0 || depth > 1 || width == 0 || (face_count != 1 && face_count != 6) )
+    return false;
+
+  _type   = TTextureContainerType::KTX2;
+  _cx     = width;
+  _cy     = std::max( height, 1u );
+  _faces  = face_count;
+  _layers = (size_t)std::max( layer_count, 1u ) * _faces;
+  _levels = std::max( level_count, 1u );
+  if ( ValidContainerSize( _format, _cx, _cy, _levels, _layers, size ) == false ||
+       size < c_ktx2_header_size + _levels * c_ktx2_level_size )
+    return false;
+
+  _images.resize( _layers * _levels );
+  for ( size_t level = 0; level < _levels; ++ level )
+  {
+    size_t index_offset = c_ktx2_header_size + level * c_ktx2_level_size;
+    std::uint64_t byte_offset = ReadValue<std::uint64_t>( data, index_offset );
+    std::uint64_t byte_length = ReadValue<std::uint64_t>( data, index_offset + 8 );
+
+    size_t cx = LevelExtent( _cx, level );
+    size_t cy = LevelExtent( _cy, level );
+    size_t image_size = ImageDataSize( _format, cx, cy );
+    if ( byte_offset > size || byte_length > size - byte_offset || byte_length / _layers < image_size )
+      return false;
+
+    // the images of a level are ordered by layer and face
+    for ( size_t layer = 0; layer < _layers; ++ layer )
+      _images[layer * _levels + level] = CTextureContainerImage( kind, _format, cx, cy, data + byte_offset + layer * image_size );
+  }
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Read the DDS header and compute the level offsets.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextureContainer::ReadDDS(
+  TImageKind kind ) //!< in: kind of the image content
+{
+  const t_byte *data = _file.Data();
+  size_t        size = _file.Size();
+  if ( size < 4 + DDS_HEADER_SIZE || ReadValue<std::uint32_t>( data, 4 ) != DDS_HEADER_SIZE )
+    return false;
+
+  const t_byte *header = data + 4;
+  std::uint32_t height       = ReadValue<std::uint32_t>( header, 8 );
+  std::uint32_t width        = ReadValue<std::uint32_t>( header, 12 );
+  std::uint32_t depth        = ReadValue<std::uint32_t>( header, 20 );
+  std::uint32_t mipmap_count = ReadValue<std::uint32_t>( header, 24 );
+  const t_byte *pixel_format = header + 72;
+  std::uint32_t caps2        = ReadValue<std::uint32_t>( header, 108 );
+
+  size_t data_offset = 4 + DDS_HEADER_SIZE;
+  size_t array_size  = 1;
+  _faces = (caps2 & DDSCAPS2_CUBEMAP_ALL) == DDSCAPS2_CUBEMAP_ALL ? 6 : 1;
+  if ( ReadValue<std::uint32_t>( pixel_format, 8 ) == FourCC( 'D', 'X', '1', '0' ) )
+  {
+    if ( size < data_offset + 20 )
+      return false;
+    const t_byte *dx10 = data + data_offset;
+    _format = FromDXGIFormat( ReadValue<std::uint32_t>( dx10, 0 ), _srgb );
+    if ( ReadValue<std::uint32_t>( dx10, 4 ) != DDS_DIMENSION_TEXTURE2D )
+      return false;
+    if ( ReadValue<std::uint32_t>( dx10, 8 ) & DDS_RESOURCE_MISC_TEXTURECUBE )
+      _faces = 6;
+    array_size = std::max( ReadValue<std::uint32_t>( dx10, 12 ), 1u );
+
+    // DXGI has no BC1 format without alpha; the writer marks it by the opaque alpha mode
+    if ( _format == TImageFormat::BC1_RGBA && (ReadValue<std::uint32_t>( dx10, 16 ) & DDS_ALPHA_MODE_MASK) == DDS_ALPHA_MODE_OPAQUE )
+      _format = TImageFormat::BC1_RGB;
+    data_offset += 20;
+  }
+  else
+  {
+    _format = FromDDSPixelFormat( pixel_format );
+  }
+
+  if ( _format == TImageFormat::UNKNOWN || width == 0 || height == 0 || depth > 1 )
+    return false;
+
+  _type   = TTextureContainerType::DDS;
+  _cx     = width;
+  _cy     = height;
+  _levels = std::max( mipmap_count, 1u );
+  _layers = array_size * _faces;
+  if ( size < data_offset || ValidContainerSize( _format, _cx, _cy, _levels, _layers, size - data_offset ) == false )
+    return false;
+
+  // the levels of a layer are stored successively
+  _images.resize( _layers * _levels );
+  size_t offset = data_offset;
+  for ( size_t layer = 0; layer < _layers; ++ layer )
+  {
+    for ( size_t level = 0; level < _levels; ++ level )
+    {
+      size_t cx = LevelExtent( _cx, level );
+      size_t cy = LevelExtent( _cy, level );
+      size_t image_size = ImageDataSize( _format, cx, cy );
+      if ( image_size > size - offset )
+        return false;
+      _images[layer * _levels + level] = CTextureContainerImage( kind, _format, cx, cy, data + offset );
+      offset += image_size;
+    }
+  }
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Write a KTX2 file.
+*
+* The levels are written from the smallest to the largest level, as
+* required by the specification, so that a reader can stream the
+* coarse levels first.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextureContainer::WriteKTX2(
+  const std::string  &filename, //!< in: path of the file
+  const TLayerImages &images,   //!< in: images; [layer][level]; all layers need the complete chain
+  bool                srgb,     //!< in: the color channels are sRGB encoded
+  size_t              faces )   //!< in: 1 or 6 for cube maps; layer index = array layer * faces + face
+{
+  TImageFormat format;
+  size_t levels;
+  if ( ValidateImages( images, faces, format, levels ) == false || (faces != 1 && faces != 6) )
+  {
+    std::cout << "error: invalid images for KTX2 file " << filename << std::endl;
+    return false;
+  }
+
+  TTextureSize size = images[0][0]->Size();
+  size_t layers = images.size();
+  std::vector<t_byte> dfd = KTX2DataFormatDescriptor( format, srgb );
+
+  // header and index
+  std::vector<t_byte> header( c_ktx2_header_size + levels * c_ktx2_level_size, 0 );
+  std::memcpy( header.data(), c_ktx2_identifier, sizeof( c_ktx2_identifier ) );
+  WriteValue<std::uint32_t>( header, 12, ToVkFormat( format, srgb ) );
+  WriteValue<std::uint32_t>( header, 16, 1 );                             // type size
+  WriteValue<std::uint32_t>( header, 20, (std::uint32_t)size[0] );
+  WriteValue<std::uint32_t>( header, 24, (std::uint32_t)size[1] );
+  WriteValue<std::uint32_t>( header, 28, 0 );                             // depth
+  WriteValue<std::uint32_t>( header, 32, layers / faces > 1 ? (std::uint32_t)(layers / faces) : 0 );
+  WriteValue<std::uint32_t>( header, 36, (std::uint32_t)faces );
+  WriteValue<std::uint32_t>( header, 40, (std::uint32_t)levels );
+  WriteValue<std::uint32_t>( header, 44, 0 );                             // no supercompression
+  WriteValue<std::uint32_t>( header, 48, (std::uint32_t)header.size() ); // dfd offset
+  WriteValue<std::uint32_t>( header, 52, (std::uint32_t)dfd.size() );
+
+  // level data is aligned to the least common multiple of the texel block size and 4
+  size_t block_size = CompressedBlockSize( format ) > 0 ? CompressedBlockSize( format ) : ImageTexelSize( format );
+  size_t alignment  = std::lcm( block_size, (size_t)4 );
+  size_t offset     = header.size() + dfd.size();
+  std::vector<std::pair<size_t, size_t>> level_range( levels );
+  for ( size_t level = levels; level-- > 0; )
+  {
+    offset = (offset + alignment - 1) / alignment * alignment;
+    size_t length = ImageDataSize( format, images[0][level]->Size()[0], images[0][level]->Size()[1] ) * layers;
+    level_range[level] = { offset, length };
+    offset += length;
+  }
+  for ( size_t level = 0; level < levels; ++ level )
+  {
+    size_t index_offset = c_ktx2_header_size + level * c_ktx2_level_size;
+    WriteValue<std::uint64_t>( header, index_offset,      level_range[level].first );
+    WriteValue<std::uint64_t>( header, index_offset + 8,  level_range[level].second );
+    WriteValue<std::uint64_t>( header, index_offset + 16, level_range[level].second );
+  }
+
+  std::ofstream stream( filename, std::ios::binary | std::ios::trunc );
+  if ( stream.is_open() == false )
+    return false;
+  stream.write( reinterpret_cast<const char*>( header.data() ), header.size() );
+  stream.write( reinterpret_cast<const char*>( dfd.data() ), dfd.size() );
+  size_t position = header.size() + dfd.size();
+  for ( size_t level = levels; level-- > 0; )
+  {
+    static const char padding[16]{};
+    stream.write( padding, level_range[level].first - position );
+    for ( size_t layer = 0; layer < layers; ++ layer )
+      WriteImageData( stream, *images[layer][level] );
+    position = level_range[level].first + level_range[level].second;
+  }
+  return stream.good();
+}
+
+
+/******************************************************************//**
+* \brief   Write a DDS file.
+*
+* BC7, texture arrays and sRGB encoded images are written with the
+* DX10 header extension, all other images with the legacy pixel
+* format. BC1 without alpha is marked by the opaque alpha mode of the
+* DX10 header.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextureContainer::WriteDDS(
+  const std::string  &filename, //!< in: path of the file
+  const TLayerImages &images,   //!< in: images; [layer][level]; all layers need the complete chain
+  bool                srgb,     //!< in: the color channels are sRGB encoded
+  size_t              faces )   //!< in: 1 or 6 for cube maps; layer index = array layer * faces + face
+{
+  TImageFormat format;
+  size_t levels;
+  if ( ValidateImages( images, faces, format, levels ) == false || (faces != 1 && faces != 6) )
+  {
+    std::cout << "error: invalid images for DDS file " << filename << std::endl;
+    return false;
+  }
+
+  TTextureSize size   = images[0][0]->Size();
+  size_t       layers = images.size();
+  bool         compressed = CompressedBlockSize( format ) > 0;
+
+  std::uint32_t dxgi_format = 0;
+  switch ( format )
+  {
+    default: break;
+    case TImageFormat::GRAY8:    dxgi_format = DXGI_R8_UNORM; break;
+    case TImageFormat::RGBA8:    dxgi_format = srgb ? DXGI_R8G8B8A8_UNORM_SRGB : DXGI_R8G8B8A8_UNORM; break;
+    case TImageFormat::BGRA8:    dxgi_format = srgb ? DXGI_B8G8R8A8_UNORM_SRGB : DXGI_B8G8R8A8_UNORM; break;
+    case TImageFormat::BC1_RGB:
+    case TImageFormat::BC1_RGBA: dxgi_format = srgb ? DXGI_BC1_UNORM_SRGB : DXGI_BC1_UNORM; break;
+    case TImageFormat::BC3:      dxgi_format = srgb ? DXGI_BC3_UNORM_SRGB : DXGI_BC3_UNORM; break;
+    case TImageFormat::BC4:      dxgi_format = DXGI_BC4_UNORM; break;
+    case TImageFormat::BC5:      dxgi_format = DXGI_BC5_UNORM; break;
+    case TImageFormat::BC7:      dxgi_format = srgb ? DXGI_BC7_UNORM_SRGB : DXGI_BC7_UNORM; break;
+  }
+
+  // the legacy pixel format can't express sRGB; RGB8 and BGR8 have no DXGI format, so they lose the sRGB flag
+  bool dx10 = format == TImageFormat::BC7 || layers / faces > 1 || (srgb && dxgi_format != 0);
+
+  std::vector<t_byte> header( 4 + DDS_HEADER_SIZE, 0 );
+  WriteValue<std::uint32_t>( header, 0, DDS_MAGIC );
+  std::uint32_t flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | (levels > 1 ? (std::uint32_t)DDSD_MIPMAPCOUNT : 0u) | (compressed ? DDSD_LINEARSIZE : DDSD_PITCH);
+  WriteValue<std::uint32_t>( header, 4,  DDS_HEADER_SIZE );
+  WriteValue<std::uint32_t>( header, 8,  flags );
+  WriteValue<std::uint32_t>( header, 12, (std::uint32_t)size[1] );
+  WriteValue<std::uint32_t>( header, 16, (std::uint32_t)size[0] );
+  WriteValue<std::uint32_t>( header, 20, (std::uint32_t)(compressed ? ImageDataSize( format, size[0], size[1] ) : size[0] * ImageTexelSize( format )) );
+  WriteValue<std::uint32_t>( header, 28, (std::uint32_t)levels );
+
+  // pixel format
+  size_t pf = 4 + 72;
+  std::uint32_t pf_flags = 0, fourcc = 0, bit_count = 0;
+  std::array<std::uint32_t, 4> masks{ 0, 0, 0, 0 };
+  switch ( format )
+  {
+    default: break;
+    case TImageFormat::GRAY8:    pf_flags = DDPF_LUMINANCE; bit_count = 8; masks = { 0xff, 0, 0, 0 }; break;
+    case TImageFormat::RGB8:     pf_flags = DDPF_RGB; bit_count = 24; masks = { 0x0000ff, 0x00ff00, 0xff0000, 0 }; break;
+    case TImageFormat::BGR8:     pf_flags = DDPF_RGB; bit_count = 24; masks = { 0xff0000, 0x00ff00, 0x0000ff, 0 }; break;
+    case TImageFormat::RGBA8:    pf_flags = DDPF_RGB | DDPF_ALPHAPIXELS; bit_count = 32; masks = { 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000 }; break;
+    case TImageFormat::BGRA8:    pf_flags = DDPF_RGB | DDPF_ALPHAPIXELS; bit_count = 32; masks = { 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000 }; break;
+    case TImageFormat::BC1_RGB:  pf_flags = DDPF_FOURCC; fourcc = FourCC( 'D', 'X', 'T', '1' ); break;
+    case TImageFormat::BC1_RGBA: pf_flags = DDPF_FOURCC | DDPF_ALPHAPIXELS; fourcc = FourCC( 'D', 'X', 'T', '1' ); break;
+    case TImageFormat::BC3:      pf_flags = DDPF_FOURCC; fourcc = FourCC( 'D', 'X', 'T', '5' ); break;
+    case TImageFormat::BC4:      pf_flags = DDPF_FOURCC; fourcc = FourCC( 'A', 'T', 'I', '1' ); break;
+    case TImageFormat::BC5:      pf_flags = DDPF_FOURCC; fourcc = FourCC( 'A', 'T', 'I', '2' ); break;
+  }
+  if ( dx10 )
+  {
+    if ( dxgi_format == 0 )
+    {
+      std::cout << "error: the image format can't be written to a DDS texture array " << filename << std::endl;
+      return false;
+    }
+    pf_flags = DDPF_FOURCC;
+    fourcc   = FourCC( 'D', 'X', '1', '0' );
+    bit_count = 0;
+    masks     = { 0, 0, 0, 0 };
+  }
+  WriteValue<std::uint32_t>( header, pf,      DDS_PIXELFORMAT_SIZE );
+  WriteValue<std::uint32_t>( header, pf + 4,  pf_flags );
+  WriteValue<std::uint32_t>( header, pf + 8,  fourcc );
+  WriteValue<std::uint32_t>( header, pf + 12, bit_count );
+  for ( size_t i = 0; i < 4; ++ i )
+    WriteValue<std::uint32_t>( header, pf + 16 + i * 4, masks[i] );
+
+  // caps
+  std::uint32_t caps = DDSCAPS_TEXTURE | (levels > 1 || faces > 1 ? (std::uint32_t)DDSCAPS_COMPLEX : 0u) | (levels > 1 ? (std::uint32_t)DDSCAPS_MIPMAP : 0u);
+  WriteValue<std::uint32_t>( header, 4 + 104, caps );
+  WriteValue<std::uint32_t>( header, 4 + 108, faces == 6 ? (std::uint32_t)DDSCAPS2_CUBEMAP_ALL : 0u );
+
+  if ( dx10 )
+  {
+    size_t offset = header.size();
+    WriteValue<std::uint32_t>( header, offset,      dxgi_format );
+    WriteValue<std::uint32_t>( header, offset + 4,  DDS_DIMENSION_TEXTURE2D );
+    WriteValue<std::uint32_t>( header, offset + 8,  faces == 6 ? (std::uint32_t)DDS_RESOURCE_MISC_TEXTURECUBE : 0u );
+    WriteValue<std::uint32_t>( header, offset + 12, (std::uint32_t)(layers / faces) );
+    WriteValue<std::uint32_t>( header, offset + 16, format == TImageFormat::BC1_RGB ? (std::uint32_t)DDS_ALPHA_MODE_OPAQUE : 0u );
+  }
+
+  std::ofstream stream( filename, std::ios::binary | std::ios::trunc );
+  if ( stream.is_open() == false )
+    return false;
+  stream.write( reinterpret_cast<const char*>( header.data() ), header.size() );
+  for ( size_t layer = 0; layer < layers; ++ layer )
+  {
+    for ( size_t level = 0; level < levels; ++ level )
+      WriteImageData( stream, *images[layer][level] );
+  }
+  return stream.good();
+}
+
+
+//---------------------------------------------------------------------
+// CTextureStreamer
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   Create the texture and load the coarsest levels.
+*
+* All levels of the texture are allocated, but only the
+* `coarse_levels` coarsest levels are loaded. The finer levels are
+* loaded by `StreamNext`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+ITexturePtr CTextureStreamer::Create(
+  const TTextureParameters &parameter,     //!< in: texture properties; the format has to match the container format
+  size_t                    coarse_levels ) //!< in: number of levels, which are loaded immediately
+{
+  std::vector<const IImageResource*> chain = _container.MipChain( _layer );
+  if ( chain.empty() )
+    return nullptr;
+
+  _levels = parameter._max_mipmap > 0 ? std::min( chain.size(), (size_t)parameter._max_mipmap + 1 ) : 1;
+  coarse_levels = std::min( std::max( coarse_levels, (size_t)1 ), _levels );
+
+  ITexturePtr texture = _loader.CreateTexture( chain[0]->Size(), 1, parameter );
+  if ( texture == nullptr || _loader.AllocateLevels( *texture, parameter, chain[0]->Size(), _levels ) == false )
+    return nullptr;
+
+  _base_level = _levels;
+  while ( _levels - _base_level < coarse_levels )
+  {
+    -- _base_level;
+    if ( _loader.LoadToTexture( *chain[_base_level], *texture, { 0, 0, 0 }, 0, _base_level ) == false )
+      return nullptr;
+  }
+  _loader.SetLevelRange( *texture, _base_level, _levels - 1 );
+  return texture;
+}
+
+
+/******************************************************************//**
+* \brief   Load the next finer level.
+*
+* \return  false, if all levels have been loaded or loading failed
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CTextureStreamer::StreamNext(
+  ITexture &texture ) //!< in: texture, which has been created by `Create`
+{
+  if ( Complete() )
+    return false;
+
+  size_t level = _base_level - 1;
+  if ( _loader.LoadToTexture( _container.Image( level, _layer ), texture, { 0, 0, 0 }, 0, level ) == false )
+    return false;
+
+  _base_level = level;
+  _loader.SetLevelRange( texture, _base_level, _levels - 1 );
+  return true;
+}
+
+
+} // Render
@@ -0,0 +1,1162 @@
+/******************************************************************//**
+* \brief   Triangulation of polygons with holes.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+
+#include <stdafx.h>
+
+// includes
+
+#include "../../include/util/RenderUtil_Triangulation.h"
+
+
+// STL
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+
+// preprocessor definitions
+
+#if defined(max)
+#undef max
+#endif
+
+#if defined(min)
+#undef min
+#endif
+
+
+/******************************************************************//**
+* @brief   Namespace for renderer.
+*
+* @author  gernot
+* @date    2018-03-17
+* @version 1.0
+**********************************************************************/
+namespace Render
+{
+
+
+namespace
+{
+
+
+//! signed area of the triangle p, q, r; negative for a counter clockwise (convex) corner of the contour
+template <typename TNode>
+double Area( const TNode *p, const TNode *q, const TNode *r )
+{
+  return (q->_y - p->_y) * (r->_x - q->_x) - (q->_x - p->_x) * (r->_y - q->_y);
+}
+
+
+//! vertices are at the same position
+template <typename TNode>
+bool Equals( const TNode *p1, const TNode *p2 )
+{
+  return p1->_x == p2->_x && p1->_y == p2->_y;
+}
+
+
+//! point p is inside or on the border of the triangle a, b, c
+bool PointInTriangle( double ax, double ay, double bx, double by, double cx, double cy, double px, double py )
+{
+  return
+    (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+    (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+    (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+
+int Sign( double v )
+{
+  return v > 0.0 ? 1 : (v < 0.0 ? -1 : 0);
+}
+
+
+//! collinear point q is on the segment p, r
+template <typename TNode>
+bool OnSegment( const TNode *p, const TNode *q, const TNode *r )
+{
+  return
+    q->_x <= std::max( p->_x, r->_x ) && q->_x >= std::min( p->_x, r->_x ) &&
+    q->_y <= std::max( p->_y, r->_y ) && q->_y >= std::min( p->_y, r->_y );
+}
+
+
+//! the segments p1, q1 and p2, q2 intersect or touch
+template <typename TNode>
+bool Intersects( const TNode *p1, const TNode *q1, const TNode *p2, const TNode *q2 )
+{
+  int o1 = Sign( Area( p1, q1, p2 ) );
+  int o2 = Sign( Area( p1, q1, q2 ) );
+  int o3 = Sign( Area( p2, q2, p1 ) );
+  int o4 = Sign( Area( p2, q2, q1 ) );
+
+  if ( o1 != o2 && o3 != o4 )
+    return true;
+  if ( o1 == 0 && OnSegment( p1, p2, q1 ) ) return true; // p1, q1 and p2 are collinear and p2 lies on p1, q1
+  if ( o2 == 0 && OnSegment( p1, q2, q1 ) ) return true; // p1, q1 and q2 are collinear and q2 lies on p1, q1
+  if ( o3 == 0 && OnSegment( p2, p1, q2 ) ) return true; // p2, q2 and p1 are collinear and p1 lies on p2, q2
+  if ( o4 == 0 && OnSegment( p2, q1, q2 ) ) return true; // p2, q2 and q1 are collinear and q1 lies on p2, q2
+  return false;
+}
+
+
+//! the diagonal a, b is locally inside the polygon at vertex a
+template <typename TNode>
+bool LocallyInside( const TNode *a, const TNode *b )
+{
+  return Area( a->_prev, a, a->_next ) < 0.0 ?
+    Area( a, b, a->_next ) >= 0.0 && Area( a, a->_prev, b ) >= 0.0 :
+    Area( a, b, a->_prev ) < 0.0 || Area( a, a->_next, b ) < 0.0;
+}
+
+
+//! the sector of vertex m contains the sector of vertex p (vertices at the same position)
+template <typename TNode>
+bool SectorContainsSector( const TNode *m, const TNode *p )
+{
+  return Area( m->_prev, m, p->_prev ) < 0.0 && Area( p->_next, m, m->_next ) < 0.0;
+}
+
+
+//! leftmost vertex of a contour
+template <typename TNode>
+TNode * Leftmost( TNode *start )
+{
+  TNode *p = start, *leftmost = start;
+  do
+  {
+    if ( p->_x < leftmost->_x || (p->_x == leftmost->_x && p->_y < leftmost->_y) )
+      leftmost = p;
+    p = p->_next;
+  }
+  while ( p != start );
+  return leftmost;
+}
+
+
+//! content hash of a polygon; mixes 8 byte words
+template <typename T>
+std::uint64_t HashPolygon(
+  unsigned int  tuple_size,
+  size_t        coords_size,
+  const T      *coords,
+  size_t        no_of_contours,
+  const size_t *contour_sizes )
+{
+  const std::uint64_t prime = 0x9E3779B97F4A7C15ull;
+  auto mix = [prime]( std::uint64_t h, std::uint64_t w ) -> std::uint64_t
+  {
+    h = (h ^ w) * prime;
+    return h ^ (h >> 29);
+  };
+
+  std::uint64_t h = mix( 0xCBF29CE484222325ull, (std::uint64_t)tuple_size | ((std::uint64_t)sizeof(T) << 8) );
+  h = mix( h, coords_size );
+
+  const char *bytes = reinterpret_cast<const char*>( coords );
+  size_t no_of_bytes = coords_size * sizeof(T);
+  size_t i = 0;
+  for ( ; i + 8 <= no_of_bytes; i += 8 )
+  {
+    std::uint64_t w;
+    std::memcpy( &w, bytes + i, 8 );
+    h = mix( h, w );
+  }
+  if ( i < no_of_bytes )
+  {
+    std::uint64_t w = 0;
+    std::memcpy( &w, bytes + i, no_of_bytes - i );
+    h = mix( h, w );
+  }
+
+  h = mix( h, no_of_contours );
+  for ( size_t c = 0; c < no_of_contours; ++ c )
+    h = mix( h, contour_sizes[c] );
+  return h;
+}
+
+
+} // anonymous namespace
+
+
+//---------------------------------------------------------------------
+// CPolygonTriangulator
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   Triangulate a polygon with holes.
+*
+* Returns the number of triangles.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CPolygonTriangulator::Triangulate(
+  unsigned int                tuple_size,     //!< I - kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)
+  size_t                      coords_size,    //!< I - number of elements of the coordinate array
+  const float                *coords,         //!< I - vertex coordinates
+  size_t                      no_of_contours, //!< I - number of contours; 0: all the vertices form one contour
+  const size_t               *contour_sizes,  //!< I - number of vertices of each contour; the first contour is the outer contour
+  std::vector<std::uint32_t> &indices )       //!< O - 3 indices per triangle
+{
+  return TriangulateT( tuple_size, coords_size, coords, no_of_contours, contour_sizes, indices );
+}
+
+
+/******************************************************************//**
+* \brief   Triangulate a polygon with holes.
+*
+* Returns the number of triangles.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+size_t CPolygonTriangulator::Triangulate(
+  unsigned int                tuple_size,     //!< I - kind of the coordinates - 2: 2D (x, y), 3: 3D (x, y, z), 4: homogeneous (x, y, z, w)
+  size_t                      coords_size,    //!< I - number of elements of the coordinate array
+  const double               *coords,         //!< I - vertex coordinates
+  size_t                      no_of_contours, //!< I - number of contours; 0: all the vertices form one contour
+  const size_t               *contour_sizes,  //!< I - number of vertices of each contour; the first contour is the outer contour
+  std::vector<std::uint32_t> &indices )       //!< O - 3 indices per triangle
+{
+  return TriangulateT( tuple_size, coords_size, coords, no_of_contours, contour_sizes, indices );
+}
+
+
+/******************************************************************//**
+* \brief   Triangulate a polygon with holes.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template <typename T>
+size_t CPolygonTriangulator::TriangulateT(
+  unsigned int                tuple_size,
+  size_t                      coords_size,
+  const T                    *coords,
+  size_t                      no_of_contours,
+  const size_t               *contour_sizes,
+  std::vector<std::uint32_t> &indices )
+{
+  indices.clear();
+  _nodes.clear();
+  _holes.clear();
+  _indices  = &indices;
+  _inv_size = 0.0;
+  if ( tuple_size < 2 || coords == nullptr || coords_size < 3 * tuple_size )
+    return 0;
+
+  size_t no_of_vertices = coords_size / tuple_size;
+  if ( no_of_contours > 0 && contour_sizes == nullptr )
+    no_of_contours = 0;
+  size_t outer_end = no_of_contours > 0 ? std::min( contour_sizes[0], no_of_vertices ) : no_of_vertices;
+
+  TNode *outer_node = LinkedList( tuple_size, coords, 0, outer_end, true );
+  if ( outer_node == nullptr || outer_node->_next == outer_node->_prev )
+    return 0;
+
+  // link the holes and merge them into the outer contour, from left to right
+  size_t start = outer_end;
+  for ( size_t c = 1; c < no_of_contours && start < no_of_vertices; ++ c )
+  {
+    size_t end = std::min( start + contour_sizes[c], no_of_vertices );
+    TNode *list = end > start ? LinkedList( tuple_size, coords, start, end, false ) : nullptr;
+    if ( list != nullptr )
+    {
+      if ( list == list->_next )
+        list->_steiner = true;
+      _holes.push_back( Leftmost( list ) );
+    }
+    start = end;
+  }
+  std::sort( _holes.begin(), _holes.end(), []( const TNode *a, const TNode *b ) -> bool
+  {
+    return a->_x < b->_x || (a->_x == b->_x && a->_y < b->_y);
+  } );
+  for ( auto hole : _holes )
+    outer_node = EliminateHole( hole, outer_node );
+
+  // z-order hashing for big polygons
+  if ( no_of_vertices > 80 )
+  {
+    double min_x = std::numeric_limits<double>::max(), min_y = min_x;
+    double max_x = std::numeric_limits<double>::lowest(), max_y = max_x;
+    for ( size_t i = 0; i < outer_end; ++ i )
+    {
+      double x = static_cast<double>( coords[i*tuple_size] );
+      double y = static_cast<double>( coords[i*tuple_size + 1] );
+      min_x = std::min( min_x, x ); max_x = std::max( max_x, x );
+      min_y = std::min( min_y, y ); max_y = std::max( max_y, y );
+    }
+    double size = std::max( max_x - min_x, max_y - min_y );
+    _min_x    = min_x;
+    _min_y    = min_y;
+    _inv_size = size != 0.0 ? 65535.0 / size : 0.0;
+  }
+
+  EarcutLinked( outer_node, 0 );
+
+  _indices = nullptr;
+  return indices.size() / 3;
+}
+
+
+/******************************************************************//**
+* \brief   Create a circular doubly linked list from the vertices of a
+* contour. The outer contour is linked clockwise, holes are linked
+* counter clockwise.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template <typename T>
+CPolygonTriangulator::TNode * CPolygonTriangulator::LinkedList(
+  unsigned int  tuple_size, //!< I - kind of the coordinates
+  const T      *coords,     //!< I - vertex coordinates
+  size_t        start,      //!< I - first vertex of the contour
+  size_t        end,        //!< I - end of the contour
+  bool          clockwise ) //!< I - orientation of the list
+{
+  auto x = [&]( size_t i ) -> double { return static_cast<double>( coords[i*tuple_size] ); };
+  auto y = [&]( size_t i ) -> double { return static_cast<double>( coords[i*tuple_size + 1] ); };
+
+  double sum = 0.0;
+  for ( size_t i = start, j = end - 1; i < end; j = i ++ )
+    sum += (x(j) - x(i)) * (y(i) + y(j));
+
+  TNode *last = nullptr;
+  if ( clockwise == (sum > 0.0) )
+  {
+    for ( size_t i = start; i < end; ++ i )
+      last = InsertNode( static_cast<std::uint32_t>( i ), x(i), y(i), last );
+  }
+  else
+  {
+    for ( size_t i = end; i -- > start; )
+      last = InsertNode( static_cast<std::uint32_t>( i ), x(i), y(i), last );
+  }
+
+  if ( last != nullptr && Equals( last, last->_next ) )
+  {
+    RemoveNode( last );
+    last = last->_next;
+  }
+  return last;
+}
+
+
+/******************************************************************//**
+* \brief   Create a vertex and insert it after `last`.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CPolygonTriangulator::TNode * CPolygonTriangulator::InsertNode(
+  std::uint32_t  i,    //!< I - index of the vertex
+  double         x,    //!< I - x coordinate
+  double         y,    //!< I - y coordinate
+  TNode         *last ) //!< I - predecessor, or nullptr for a new list
+{
+  _nodes.emplace_back();
+  TNode *p = &_nodes.back();
+  p->_i = i;
+  p->_x = x;
+  p->_y = y;
+  if ( last == nullptr )
+  {
+    p->_prev = p;
+    p->_next = p;
+  }
+  else
+  {
+    p->_next = last->_next;
+    p->_prev = last;
+    last->_next->_prev = p;
+    last->_next = p;
+  }
+  return p;
+}
+
+
+/******************************************************************//**
+* \brief   Remove a vertex from the contour and the z-order list.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CPolygonTriangulator::RemoveNode(
+  TNode *p ) const //!< I - vertex
+{
+  p->_next->_prev = p->_prev;
+  p->_prev->_next = p->_next;
+  if ( p->_prev_z != nullptr )
+    p->_prev_z->_next_z = p->_next_z;
+  if ( p->_next_z != nullptr )
+    p->_next_z->_prev_z = p->_prev_z;
+}
+
+
+/******************************************************************//**
+* \brief   Append a triangle to the output.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CPolygonTriangulator::AddTriangle(
+  const TNode *a,   //!< I - 1st vertex
+  const TNode *b,   //!< I - 2nd vertex
+  const TNode *c )  //!< I - 3rd vertex
+{
+  _indices->push_back( a->_i );
+  _indices->push_back( b->_i );
+  _indices->push_back( c->_i );
+}
+
+
+/******************************************************************//**
+* \brief   Remove duplicate and collinear vertices.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CPolygonTriangulator::TNode * CPolygonTriangulator::FilterPoints(
+  TNode *start, //!< I - first vertex
+  TNode *end )  //!< I - last vertex; nullptr: `start`
+{
+  if ( start == nullptr )
+    return start;
+  if ( end == nullptr )
+    end = start;
+
+  TNode *p = start;
+  bool again;
+  do
+  {
+    again = false;
+    if ( p->_steiner == false && (Equals( p, p->_next ) || Area( p->_prev, p, p->_next ) == 0.0) )
+    {
+      RemoveNode( p );
+      p = end = p->_prev;
+      if ( p == p->_next )
+        break;
+      again = true;
+    }
+    else
+    {
+      p = p->_next;
+    }
+  }
+  while ( again || p != end );
+
+  return end;
+}
+
+
+/******************************************************************//**
+* \brief   Cut the ears of a contour.
+*
+* If no more ears can be found, then the contour is processed by the
+* next pass:
+* 1. filter duplicate and collinear vertices
+* 2. cure local self intersections
+* 3. split the contour in two parts
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CPolygonTriangulator::EarcutLinked(
+  TNode *ear,  //!< I - start vertex
+  int    pass ) //!< I - pass 0, 1 or 2
+{
+  if ( ear == nullptr )
+    return;
+
+  if ( pass == 0 && _inv_size != 0.0 )
+    IndexCurve( ear );
+
+  TNode *stop = ear;
+  while ( ear->_prev != ear->_next )
+  {
+    TNode *prev = ear->_prev;
+    TNode *next = ear->_next;
+
+    if ( _inv_size != 0.0 ? IsEarHashed( ear ) : IsEar( ear ) )
+    {
+      AddTriangle( prev, ear, next );
+      RemoveNode( ear );
+
+      // skipping the next vertex leads to less sliver triangles
+      ear  = next->_next;
+      stop = next->_next;
+      continue;
+    }
+
+    ear = next;
+
+    // if the whole contour was looped through without finding an ear, then try the next pass
+    if ( ear == stop )
+    {
+      if ( pass == 0 )
+      {
+        EarcutLinked( FilterPoints( ear ), 1 );
+      }
+      else if ( pass == 1 )
+      {
+        ear = CureLocalIntersections( FilterPoints( ear ) );
+        EarcutLinked( ear, 2 );
+      }
+      else if ( pass == 2 )
+      {
+        SplitEarcut( ear );
+      }
+      break;
+    }
+  }
+}
+
+
+/******************************************************************//**
+* \brief   Check if a vertex is the tip of an ear: the corner is convex
+* and no other vertex is inside of the triangle.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPolygonTriangulator::IsEar(
+  const TNode *ear ) const //!< I - tip of the ear
+{
+  const TNode *a = ear->_prev, *b = ear, *c = ear->_next;
+  if ( Area( a, b, c ) >= 0.0 )
+    return false; // reflex
+
+  double x0 = std::min( { a->_x, b->_x, c->_x } ), x1 = std::max( { a->_x, b->_x, c->_x } );
+  double y0 = std::min( { a->_y, b->_y, c->_y } ), y1 = std::max( { a->_y, b->_y, c->_y } );
+
+  for ( const TNode *p = c->_next; p != a; p = p->_next )
+  {
+    if ( p->_x >= x0 && p->_x <= x1 && p->_y >= y0 && p->_y <= y1 &&
+         PointInTriangle( a->_x, a->_y, b->_x, b->_y, c->_x, c->_y, p->_x, p->_y ) &&
+         Area( p->_prev, p, p->_next ) >= 0.0 )
+      return false;
+  }
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Check if a vertex is the tip of an ear, by testing the
+* vertices in the z-order range of the bounding box of the triangle.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPolygonTriangulator::IsEarHashed(
+  const TNode *ear ) const //!< I - tip of the ear
+{
+  const TNode *a = ear->_prev, *b = ear, *c = ear->_next;
+  if ( Area( a, b, c ) >= 0.0 )
+    return false; // reflex
+
+  double x0 = std::min( { a->_x, b->_x, c->_x } ), x1 = std::max( { a->_x, b->_x, c->_x } );
+  double y0 = std::min( { a->_y, b->_y, c->_y } ), y1 = std::max( { a->_y, b->_y, c->_y } );
+  std::uint32_t min_z = ZOrder( x0, y0 );
+  std::uint32_t max_z = ZOrder( x1, y1 );
+
+  auto inside = [&]( const TNode *p ) -> bool
+  {
+    return
+      p->_x >= x0 && p->_x <= x1 && p->_y >= y0 && p->_y <= y1 && p != a && p != c &&
+      PointInTriangle( a->_x, a->_y, b->_x, b->_y, c->_x, c->_y, p->_x, p->_y ) &&
+      Area( p->_prev, p, p->_next ) >= 0.0;
+  };
+
+  // look for points inside the triangle in both directions
+  const TNode *p = ear->_prev_z;
+  const TNode *n = ear->_next_z;
+  while ( p != nullptr && p->_z >= min_z && n != nullptr && n->_z <= max_z )
+  {
+    if ( inside( p ) )
+      return false;
+    p = p->_prev_z;
+    if ( inside( n ) )
+      return false;
+    n = n->_next_z;
+  }
+  for ( ; p != nullptr && p->_z >= min_z; p = p->_prev_z )
+  {
+    if ( inside( p ) )
+      return false;
+  }
+  for ( ; n != nullptr && n->_z <= max_z; n = n->_next_z )
+  {
+    if ( inside( n ) )
+      return false;
+  }
+  return true;
+}
+
+
+/******************************************************************//**
+* \brief   Cut the triangles of local self intersections
+* (a - p - p.next - b, where the edges a, p and p.next, b intersect).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CPolygonTriangulator::TNode * CPolygonTriangulator::CureLocalIntersections(
+  TNode *start ) //!< I - first vertex
+{
+  TNode *p = start;
+  do
+  {
+    TNode *a = p->_prev;
+    TNode *b = p->_next->_next;
+    if ( Equals( a, b ) == false && Intersects( a, p, p->_next, b ) && LocallyInside( a, b ) && LocallyInside( b, a ) )
+    {
+      AddTriangle( a, p, b );
+      RemoveNode( p );
+      RemoveNode( p->_next );
+      p = start = b;
+    }
+    p = p->_next;
+  }
+  while ( p != start );
+
+  return FilterPoints( p );
+}
+
+
+/******************************************************************//**
+* \brief   Split the contour by a valid diagonal and triangulate both
+* parts.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CPolygonTriangulator::SplitEarcut(
+  TNode *start ) //!< I - first vertex
+{
+  TNode *a = start;
+  do
+  {
+    for ( TNode *b = a->_next->_next; b != a->_prev; b = b->_next )
+    {
+      if ( a->_i != b->_i && IsValidDiagonal( a, b ) )
+      {
+        TNode *c = SplitPolygon( a, b );
+        a = FilterPoints( a, a->_next );
+        c = FilterPoints( c, c->_next );
+        EarcutLinked( a, 0 );
+        EarcutLinked( c, 0 );
+        return;
+      }
+    }
+    a = a->_next;
+  }
+  while ( a != start );
+}
+
+
+/******************************************************************//**
+* \brief   Merge a hole into the outer contour by a bridge.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CPolygonTriangulator::TNode * CPolygonTriangulator::EliminateHole(
+  TNode *hole,        //!< I - leftmost vertex of the hole
+  TNode *outer_node ) //!< I - vertex of the outer contour
+{
+  TNode *bridge = FindHoleBridge( hole, outer_node );
+  if ( bridge == nullptr )
+    return outer_node;
+
+  TNode *bridge_reverse = SplitPolygon( bridge, hole );
+
+  // filter collinear points around the cuts
+  FilterPoints( bridge_reverse, bridge_reverse->_next );
+  return FilterPoints( bridge, bridge->_next );
+}
+
+
+/******************************************************************//**
+* \brief   Find a vertex of the outer contour, which can be connected
+* to the leftmost vertex of a hole (David Eberly's algorithm).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CPolygonTriangulator::TNode * CPolygonTriangulator::FindHoleBridge(
+  TNode *hole,              //!< I - leftmost vertex of the hole
+  TNode *outer_node ) const //!< I - vertex of the outer contour
+{
+  TNode *p = outer_node;
+  double hx = hole->_x;
+  double hy = hole->_y;
+  double qx = -std::numeric_limits<double>::infinity();
+  TNode *m = nullptr;
+
+  // find a segment intersected by a ray from the hole's leftmost point to the left;
+  // the segment's endpoint with lesser x will be a potential connection point
+  do
+  {
+    if ( hy <= p->_y && hy >= p->_next->_y && p->_next->_y != p->_y )
+    {
+      double x = p->_x + (hy - p->_y) * (p->_next->_x - p->_x) / (p->_next->_y - p->_y);
+      if ( x <= hx && x > qx )
+      {
+        qx = x;
+        m  = p->_x < p->_next->_x ? p : p->_next;
+        if ( x == hx )
+          return m; // the hole touches the outer segment
+      }
+    }
+    p = p->_next;
+  }
+  while ( p != outer_node );
+
+  if ( m == nullptr )
+    return nullptr;
+
+  // look for points inside the triangle of hole point, segment intersection and endpoint;
+  // if there are no points found, then the endpoint is a valid connection;
+  // otherwise choose the point of the minimum angle with the ray as connection point
+  TNode *stop = m;
+  double mx = m->_x;
+  double my = m->_y;
+  double tan_min = std::numeric_limits<double>::infinity();
+  p = m;
+  do
+  {
+    if ( hx >= p->_x && p->_x >= mx && hx != p->_x &&
+         PointInTriangle( hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->_x, p->_y ) )
+    {
+      double tan = std::abs( hy - p->_y ) / (hx - p->_x);
+      if ( LocallyInside( p, hole ) &&
+           (tan < tan_min || (tan == tan_min && (p->_x > m->_x || (p->_x == m->_x && SectorContainsSector( m, p ))))) )
+      {
+        m       = p;
+        tan_min = tan;
+      }
+    }
+    p = p->_next;
+  }
+  while ( p != stop );
+
+  return m;
+}
+
+
+/******************************************************************//**
+* \brief   Link the vertices of a contour in z-order.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CPolygonTriangulator::IndexCurve(
+  TNode *start ) //!< I - first vertex
+{
+  TNode *p = start;
+  do
+  {
+    if ( p->_z == 0 )
+      p->_z = ZOrder( p->_x, p->_y );
+    p->_prev_z = p->_prev;
+    p->_next_z = p->_next;
+    p = p->_next;
+  }
+  while ( p != start );
+
+  p->_prev_z->_next_z = nullptr;
+  p->_prev_z = nullptr;
+
+  SortLinked( p );
+}
+
+
+/******************************************************************//**
+* \brief   Sort the z-order list by the z-order values.
+*
+* The vertices are sorted in an array rather than by a linked list
+* merge sort, because the random memory access of the list dominates
+* the time for big polygons.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CPolygonTriangulator::SortLinked(
+  TNode *list ) //!< I - first vertex of the z-order list
+{
+  _z_order.clear();
+  for ( TNode *p = list; p != nullptr; p = p->_next_z )
+    _z_order.emplace_back( p->_z, p );
+  std::stable_sort( _z_order.begin(), _z_order.end(), []( const auto &a, const auto &b ) -> bool
+  {
+    return a.first < b.first;
+  } );
+
+  TNode *prev = nullptr;
+  for ( auto &entry : _z_order )
+  {
+    entry.second->_prev_z = prev;
+    if ( prev != nullptr )
+      prev->_next_z = entry.second;
+    prev = entry.second;
+  }
+  prev->_next_z = nullptr;
+}
+
+
+/******************************************************************//**
+* \brief   z-order of a point (Morton code of the 16 bit coordinates
+* relative to the bounding box).
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::uint32_t CPolygonTriangulator::ZOrder(
+  double x,        //!< I - x coordinate
+  double y ) const //!< I - y coordinate
+{
+  std::uint32_t ix = static_cast<std::uint32_t>( std::clamp( (x - _min_x) * _inv_size, 0.0, 65535.0 ) );
+  std::uint32_t iy = static_cast<std::uint32_t>( std::clamp( (y - _min_y) * _inv_size, 0.0, 65535.0 ) );
+
+  ix = (ix | (ix << 8)) & 0x00FF00FF;
+  ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+  ix = (ix | (ix << 2)) & 0x33333333;
+  ix = (ix | (ix << 1)) & 0x55555555;
+
+  iy = (iy | (iy << 8)) & 0x00FF00FF;
+  iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+  iy = (iy | (iy << 2)) & 0x33333333;
+  iy = (iy | (iy << 1)) & 0x55555555;
+
+  return ix | (iy << 1);
+}
+
+
+/******************************************************************//**
+* \brief   Check if a diagonal between two vertices is valid: it doesn't
+* intersect the contour and it is inside of the polygon.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPolygonTriangulator::IsValidDiagonal(
+  const TNode *a,        //!< I - 1st vertex
+  const TNode *b ) const //!< I - 2nd vertex
+{
+  if ( a->_next->_i == b->_i || a->_prev->_i == b->_i || IntersectsPolygon( a, b ) )
+    return false;
+
+  // locally visible, no opposite-facing sectors
+  if ( LocallyInside( a, b ) && LocallyInside( b, a ) && MiddleInside( a, b ) &&
+       (Area( a->_prev, a, b->_prev ) != 0.0 || Area( a, b->_prev, b ) != 0.0) )
+    return true;
+
+  // special zero-length case
+  return Equals( a, b ) && Area( a->_prev, a, a->_next ) > 0.0 && Area( b->_prev, b, b->_next ) > 0.0;
+}
+
+
+/******************************************************************//**
+* \brief   Check if a diagonal intersects any edge of the contour.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPolygonTriangulator::IntersectsPolygon(
+  const TNode *a,        //!< I - 1st vertex of the diagonal
+  const TNode *b ) const //!< I - 2nd vertex of the diagonal
+{
+  const TNode *p = a;
+  do
+  {
+    if ( p->_i != a->_i && p->_next->_i != a->_i && p->_i != b->_i && p->_next->_i != b->_i &&
+         Intersects( p, p->_next, a, b ) )
+      return true;
+    p = p->_next;
+  }
+  while ( p != a );
+  return false;
+}
+
+
+/******************************************************************//**
+* \brief   Check if the middle point of a diagonal is inside of the
+* polygon.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+bool CPolygonTriangulator::MiddleInside(
+  const TNode *a,        //!< I - 1st vertex of the diagonal
+  const TNode *b ) const //!< I - 2nd vertex of the diagonal
+{
+  const TNode *p = a;
+  bool inside = false;
+  double px = (a->_x + b->_x) / 2.0;
+  double py = (a->_y + b->_y) / 2.0;
+  do
+  {
+    if ( ((p->_y > py) != (p->_next->_y > py)) && p->_next->_y != p->_y &&
+         (px < (p->_next->_x - p->_x) * (py - p->_y) / (p->_next->_y - p->_y) + p->_x) )
+      inside = !inside;
+    p = p->_next;
+  }
+  while ( p != a );
+  return inside;
+}
+
+
+/******************************************************************//**
+* \brief   Split the contour in two by a diagonal; the vertices of the
+* diagonal are duplicated.
+*
+* Returns the copy of `b`, which is a vertex of the 2nd contour.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CPolygonTriangulator::TNode * CPolygonTriangulator::SplitPolygon(
+  TNode *a,  //!< I - 1st vertex of the diagonal
+  TNode *b ) //!< I - 2nd vertex of the diagonal
+{
+  _nodes.emplace_back();
+  TNode *a2 = &_nodes.back();
+  _nodes.emplace_back();
+  TNode *b2 = &_nodes.back();
+  a2->_i = a->_i; a2->_x = a->_x; a2->_y = a->_y;
+  b2->_i = b->_i; b2->_x = b->_x; b2->_y = b->_y;
+
+  TNode *an = a->_next;
+  TNode *bp = b->_prev;
+
+  a->_next  = b;
+  b->_prev  = a;
+
+  a2->_next = an;
+  an->_prev = a2;
+
+  b2->_next = a2;
+  a2->_prev = b2;
+
+  bp->_next = b2;
+  b2->_prev = bp;
+
+  return b2;
+}
+
+
+//---------------------------------------------------------------------
+// CTriangulationCache
+//---------------------------------------------------------------------
+
+
+/******************************************************************//**
+* \brief   ctor
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+CTriangulationCache::CTriangulationCache(
+  const TTriangulationCacheParameters &parameters ) //!< I - cache limits
+  : _parameters( parameters )
+{}
+
+
+/******************************************************************//**
+* \brief   Content hash of a polygon.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::uint64_t CTriangulationCache::Hash(
+  unsigned int  tuple_size,     //!< I - kind of the coordinates
+  size_t        coords_size,    //!< I - number of elements of the coordinate array
+  const float  *coords,         //!< I - vertex coordinates
+  size_t        no_of_contours, //!< I - number of contours
+  const size_t *contour_sizes ) //!< I - number of vertices of each contour
+{
+  return HashPolygon( tuple_size, coords_size, coords, no_of_contours, contour_sizes );
+}
+
+
+/******************************************************************//**
+* \brief   Content hash of a polygon.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+std::uint64_t CTriangulationCache::Hash(
+  unsigned int  tuple_size,     //!< I - kind of the coordinates
+  size_t        coords_size,    //!< I - number of elements of the coordinate array
+  const double *coords,         //!< I - vertex coordinates
+  size_t        no_of_contours, //!< I - number of contours
+  const size_t *contour_sizes ) //!< I - number of vertices of each contour
+{
+  return HashPolygon( tuple_size, coords_size, coords, no_of_contours, contour_sizes );
+}
+
+
+/******************************************************************//**
+* \brief   Get the triangulation of a polygon.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+TTriangulationPtr CTriangulationCache::Get(
+  unsigned int  tuple_size,     //!< I - kind of the coordinates
+  size_t        coords_size,    //!< I - number of elements of the coordinate array
+  const float  *coords,         //!< I - vertex coordinates
+  size_t        no_of_contours, //!< I - number of contours
+  const size_t *contour_sizes ) //!< I - number of vertices of each contour
+{
+  return GetT( tuple_size, coords_size, coords, no_of_contours, contour_sizes );
+}
+
+
+/******************************************************************//**
+* \brief   Get the triangulation of a polygon.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+TTriangulationPtr CTriangulationCache::Get(
+  unsigned int  tuple_size,     //!< I - kind of the coordinates
+  size_t        coords_size,    //!< I - number of elements of the coordinate array
+  const double *coords,         //!< I - vertex coordinates
+  size_t        no_of_contours, //!< I - number of contours
+  const size_t *contour_sizes ) //!< I - number of vertices of each contour
+{
+  return GetT( tuple_size, coords_size, coords, no_of_contours, contour_sizes );
+}
+
+
+/******************************************************************//**
+* \brief   Get the triangulation of a polygon; triangulate the polygon
+* and evict the least recently used polygons, if it isn't cached.
+*
+* The cache is keyed by the content hash. A hit is verified by the
+* coordinates and the contour sizes of the polygon, so a hash
+* collision can't return the triangulation of a different polygon.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+template <typename T>
+TTriangulationPtr CTriangulationCache::GetT(
+  unsigned int  tuple_size,
+  size_t        coords_size,
+  const T      *coords,
+  size_t        no_of_contours,
+  const size_t *contour_sizes )
+{
+  std::uint64_t hash     = Hash( tuple_size, coords_size, coords, no_of_contours, contour_sizes );
+  size_t        vertices = tuple_size > 0 ? coords_size / tuple_size : 0;
+  const char   *bytes    = reinterpret_cast<const char*>( coords );
+  size_t        no_of_bytes = coords_size * sizeof(T);
+
+  auto entryIt = _entries.find( hash );
+  if ( entryIt != _entries.end() )
+  {
+    const TTriangulation &cached = *entryIt->second.first;
+    bool same =
+      cached._vertices == vertices && cached._tuple_size == tuple_size && cached._coord_size == sizeof(T) &&
+      cached._contour_sizes.size() == no_of_contours && cached._coords.size() == no_of_bytes &&
+      (no_of_contours == 0 || std::equal( cached._contour_sizes.begin(), cached._contour_sizes.end(), contour_sizes )) &&
+      (no_of_bytes == 0 || std::memcmp( cached._coords.data(), bytes, no_of_bytes ) == 0);
+    if ( same )
+    {
+      ++ _statistics._hits;
+      _lru.splice( _lru.begin(), _lru, entryIt->second.second );
+      return entryIt->second.first;
+    }
+
+    // hash collision
+    _indices -= entryIt->second.first->_indices.size();
+    _lru.erase( entryIt->second.second );
+    _entries.erase( entryIt );
+  }
+
+  ++ _statistics._misses;
+  auto triangulation = std::make_shared<TTriangulation>();
+  triangulation->_hash       = hash;
+  triangulation->_vertices   = vertices;
+  triangulation->_tuple_size = tuple_size;
+  triangulation->_coord_size = sizeof(T);
+  triangulation->_coords.assign( bytes, bytes + no_of_bytes );
+  if ( no_of_contours > 0 )
+    triangulation->_contour_sizes.assign( contour_sizes, contour_sizes + no_of_contours );
+  _statistics._triangles += _triangulator.Triangulate( tuple_size, coords_size, coords, no_of_contours, contour_sizes, triangulation->_indices );
+
+  _lru.push_front( hash );
+  _entries[hash] = TEntry( triangulation, _lru.begin() );
+  _indices += triangulation->_indices.size();
+
+  // evict the least recently used polygons, but keep the new one
+  while ( _lru.size() > 1 && (_entries.size() > _parameters._max_entries || _indices > _parameters._max_indices) )
+  {
+    auto evictIt = _entries.find( _lru.back() );
+    _indices -= evictIt->second.first->_indices.size();
+    _entries.erase( evictIt );
+    _lru.pop_back();
+    ++ _statistics._evictions;
+  }
+
+  return triangulation;
+}
+
+
+/******************************************************************//**
+* \brief   Remove all the triangulations.
+*
+* \author  gernot
+* \date    2026-10-18
+* \version 1.0
+**********************************************************************/
+void CTriangulationCache::Clear( void )
+{
+  _entries.clear();
+  _lru.clear();
+  _indices = 0;
+}
+
+
+} // Render
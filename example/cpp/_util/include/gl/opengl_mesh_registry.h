@@ -0,0 +1,210 @@
+#ifndef __OPENGL_MESH_REGISTRY__H__
+#define __OPENGL_MESH_REGISTRY__H__
+
+#include <mesh/mesh_data_interface.h>
+#include <gl/opengl_mesh_interface.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace OpenGL::mesh
+{
+    // First fit allocator of ranges in a buffer. Adjacent free ranges are merged.
+    class FreeListAllocator
+    {
+    private:
+
+        size_t _capacity = 0;
+        size_t _used = 0;
+        std::map<size_t, size_t> _free_ranges; // offset -> size
+
+    public:
+
+        FreeListAllocator(size_t capacity = 0)
+        {
+            reset(capacity, 0);
+        }
+
+        size_t capacity(void) const { return _capacity; }
+        size_t used(void) const { return _used; }
+        size_t available(void) const { return _capacity - _used; }
+        size_t no_of_free_ranges(void) const { return _free_ranges.size(); }
+        size_t largest_free_range(void) const;
+
+        std::optional<size_t> allocate(size_t size);
+        void free(size_t offset, size_t size);
+
+        // the range [0, used) is allocated, the rest of the capacity is free
+        void reset(size_t capacity, size_t used);
+    };
+
+    // Layout of `DrawElementsIndirectCommand` (OpenGL 4.3)
+    struct DrawElementsIndirectCommand
+    {
+        std::uint32_t count;
+        std::uint32_t instance_count;
+        std::uint32_t first_index;
+        std::int32_t base_vertex;
+        std::uint32_t base_instance;
+    };
+
+    // Registry of static meshes.
+    //
+    // The meshes of a vertex format share one vertex buffer, one index buffer and one vertex array object.
+    // The ranges of the meshes are suballocated by free lists. If an allocation fails, the buffers are
+    // reallocated and the meshes are copied compactly to the new buffers (defragmentation); the buffers grow,
+    // if the free space is not sufficient. The indices of a mesh are relative to its first vertex
+    // (base vertex), so the indices are not changed, when a mesh is moved.
+    //
+    // `draw` builds a `DrawElementsIndirectCommand` for each visible item and submits one
+    // `glMultiDrawElementsIndirect` per vertex format and material. The object index of an item is passed
+    // as base instance. The shader reads it by `gl_BaseInstance` (`ARB_shader_draw_parameters`), or by the
+    // object attribute: if `object_attribute` is not negative, an integer attribute with divisor 1 is set up,
+    // whose value is the base instance (`layout(location = object_attribute) in uint a_object;`).
+    // `gl_DrawID` is the index of the command in the batch, `DrawBatch::first_command` is the index of the
+    // first command of the batch in the frame.
+    //
+    // On contexts older than OpenGL 4.3, each item is drawn by `glDrawElementsBaseVertex`; then the object
+    // data have to be set by the `BindObject` callback.
+    class MeshRegistry
+    {
+    public:
+
+        using MeshHandle = std::uint32_t;
+        static constexpr MeshHandle no_mesh = 0xffffffff;
+
+        struct DrawItem
+        {
+            MeshHandle mesh;
+            std::uint32_t material;
+            std::uint32_t object;
+        };
+
+        struct DrawBatch
+        {
+            size_t format;
+            std::uint32_t material;
+            size_t first_command;
+            size_t no_of_commands;
+        };
+
+        struct Statistics
+        {
+            size_t batches = 0;          // batches of the last frame
+            size_t commands = 0;         // draw commands of the last frame
+            size_t draw_calls = 0;       // draw calls of the last frame
+            size_t relocations = 0;      // reallocations of the buffers of a format
+            size_t relocated_bytes = 0;  // bytes which were copied by reallocations
+        };
+
+        using BindBatch = std::function<void(const DrawBatch&)>;
+        using BindObject = std::function<void(const DrawItem&, size_t draw_id)>;
+
+        MeshRegistry(int object_attribute = -1);
+        virtual ~MeshRegistry() = default;
+
+        bool multi_draw_indirect(void) const { return _multi_draw_indirect; }
+        void set_multi_draw_indirect(bool multi_draw_indirect) { _multi_draw_indirect = multi_draw_indirect && _multi_draw_indirect_supported; }
+
+        size_t no_of_formats(void) const { return _formats.size(); }
+        size_t format_of(MeshHandle mesh) const { return _meshs[mesh].format; }
+        const FreeListAllocator& vertex_allocator(size_t format) const { return _formats[format].vertices; }
+        const FreeListAllocator& index_allocator(size_t format) const { return _formats[format].indices; }
+        const Statistics& statistics(void) const { return _statistics; }
+
+        MeshHandle add(const ::mesh::MeshDataInterface<float, unsigned int>& definition);
+        void remove(MeshHandle mesh);
+        DrawElementsIndirectCommand command(MeshHandle mesh, std::uint32_t object = 0) const;
+
+        void defragment(void);
+        void destroy(void);
+
+        void draw(MeshHandle mesh) const;
+        void draw(const std::vector<DrawItem>& visible, const BindBatch& bind_batch, const BindObject& bind_object = {});
+
+        std::shared_ptr<MeshInterface> mesh(MeshHandle mesh);
+
+    private:
+
+        struct Format
+        {
+            ::mesh::VertexSpcification specification;
+            size_t attribute_size = 0;
+            unsigned int vertex_array_object = 0;
+            unsigned int vertex_buffer_object = 0;
+            unsigned int index_buffer_object = 0;
+            FreeListAllocator vertices;
+            FreeListAllocator indices;
+        };
+
+        struct Mesh
+        {
+            size_t format = 0;
+            size_t vertex_offset = 0;
+            size_t no_of_vertices = 0;
+            size_t index_offset = 0;
+            size_t no_of_indices = 0;
+            bool live = false;
+        };
+
+        size_t find_format(const ::mesh::VertexSpcification& specification, size_t attribute_size);
+        void relocate(size_t format, size_t vertex_capacity, size_t index_capacity);
+        void setup_vertex_array(Format& format);
+        void reserve_objects(size_t no_of_objects);
+
+        int _object_attribute = -1;
+        bool _multi_draw_indirect_supported = false;
+        bool _multi_draw_indirect = false;
+        std::vector<Format> _formats;
+        std::vector<Mesh> _meshs;
+        std::vector<MeshHandle> _free_handles;
+        unsigned int _indirect_buffer = 0;
+        size_t _indirect_capacity = 0;
+        unsigned int _object_buffer = 0;
+        size_t _object_capacity = 0;
+        std::vector<DrawElementsIndirectCommand> _commands;
+        std::vector<size_t> _order;
+        Statistics _statistics;
+    };
+
+    // A mesh of a registry, which is drawn on its own
+    class RegisteredMesh
+        : public MeshInterface
+    {
+    private:
+
+        MeshRegistry& _registry;
+        MeshRegistry::MeshHandle _mesh;
+
+    public:
+
+        RegisteredMesh(MeshRegistry& registry, MeshRegistry::MeshHandle mesh)
+            : _registry(registry)
+            , _mesh(mesh)
+        {}
+
+        MeshRegistry::MeshHandle handle(void) const
+        {
+            return _mesh;
+        }
+
+        virtual void destroy(void)
+        {
+            if (_mesh != MeshRegistry::no_mesh)
+                _registry.remove(_mesh);
+            _mesh = MeshRegistry::no_mesh;
+        }
+
+        virtual void draw(void) const override
+        {
+            if (_mesh != MeshRegistry::no_mesh)
+                _registry.draw(_mesh);
+        }
+    };
+}
+
+#endif
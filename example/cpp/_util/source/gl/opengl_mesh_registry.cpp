@@ -0,0 +1,404 @@
+#include <pch.h>
+
+#include <gl/opengl_include.h>
+#include <gl/opengl_mesh_registry.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace OpenGL::mesh
+{
+    size_t FreeListAllocator::largest_free_range(void) const
+    {
+        size_t largest = 0;
+        for (const auto& [offset, size] : _free_ranges)
+            largest = std::max(largest, size);
+        return largest;
+    }
+
+    std::optional<size_t> FreeListAllocator::allocate(size_t size)
+    {
+        if (size == 0)
+            return 0;
+        for (auto it = _free_ranges.begin(); it != _free_ranges.end(); ++it)
+        {
+            if (it->second < size)
+                continue;
+            auto [offset, free_size] = *it;
+            _free_ranges.erase(it);
+            if (free_size > size)
+                _free_ranges[offset + size] = free_size - size;
+            _used += size;
+            return offset;
+        }
+        return std::nullopt;
+    }
+
+    void FreeListAllocator::free(size_t offset, size_t size)
+    {
+        if (size == 0)
+            return;
+        _used -= size;
+
+        auto next = _free_ranges.lower_bound(offset);
+        if (next != _free_ranges.end() && offset + size == next->first)
+        {
+            size += next->second;
+            next = _free_ranges.erase(next);
+        }
+        if (next != _free_ranges.begin())
+        {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset)
+            {
+                previous->second += size;
+                return;
+            }
+        }
+        _free_ranges[offset] = size;
+    }
+
+    void FreeListAllocator::reset(size_t capacity, size_t used)
+    {
+        _capacity = capacity;
+        _used = used;
+        _free_ranges.clear();
+        if (capacity > used)
+            _free_ranges[used] = capacity - used;
+    }
+
+    MeshRegistry::MeshRegistry(int object_attribute)
+        : _object_attribute(object_attribute)
+    {
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        _multi_draw_indirect_supported = major > 4 || (major == 4 && minor >= 3);
+        _multi_draw_indirect = _multi_draw_indirect_supported;
+    }
+
+    MeshRegistry::MeshHandle MeshRegistry::add(const ::mesh::MeshDataInterface<float, unsigned int>& definition)
+    {
+        auto [no_of_values, vertex_array] = definition.get_vertex_attributes();
+        auto [no_of_indices, index_array] = definition.get_indices();
+        auto attribute_size = definition.get_attribute_size();
+
+        Mesh mesh;
+        mesh.format = find_format(definition.get_specification(), attribute_size);
+        mesh.no_of_vertices = no_of_values / attribute_size;
+        mesh.no_of_indices = index_array != nullptr ? no_of_indices : mesh.no_of_vertices;
+        mesh.live = true;
+
+        Format& format = _formats[mesh.format];
+        auto vertex_offset = format.vertices.allocate(mesh.no_of_vertices);
+        auto index_offset = format.indices.allocate(mesh.no_of_indices);
+        if (vertex_offset.has_value() == false || index_offset.has_value() == false)
+        {
+            // compact the buffers; grow them, if the free space is not sufficient
+            if (vertex_offset.has_value())
+                format.vertices.free(*vertex_offset, mesh.no_of_vertices);
+            if (index_offset.has_value())
+                format.indices.free(*index_offset, mesh.no_of_indices);
+            auto new_capacity = [](const FreeListAllocator& allocator, size_t size) -> size_t
+            {
+                size_t required = allocator.used() + size;
+                return required <= allocator.capacity() ? allocator.capacity() : std::max(required, allocator.capacity() * 2);
+            };
+            relocate(mesh.format, new_capacity(format.vertices, mesh.no_of_vertices), new_capacity(format.indices, mesh.no_of_indices));
+            vertex_offset = format.vertices.allocate(mesh.no_of_vertices);
+            index_offset = format.indices.allocate(mesh.no_of_indices);
+        }
+        mesh.vertex_offset = *vertex_offset;
+        mesh.index_offset = *index_offset;
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, format.vertex_buffer_object);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, mesh.vertex_offset * attribute_size * sizeof(GLfloat), no_of_values * sizeof(GLfloat), vertex_array);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, format.index_buffer_object);
+        if (index_array != nullptr)
+        {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, mesh.index_offset * sizeof(GLuint), mesh.no_of_indices * sizeof(GLuint), index_array);
+        }
+        else
+        {
+            std::vector<GLuint> indices(mesh.no_of_indices);
+            std::iota(indices.begin(), indices.end(), 0);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, mesh.index_offset * sizeof(GLuint), indices.size() * sizeof(GLuint), indices.data());
+        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        MeshHandle handle;
+        if (_free_handles.empty() == false)
+        {
+            handle = _free_handles.back();
+            _free_handles.pop_back();
+            _meshs[handle] = mesh;
+        }
+        else
+        {
+            handle = static_cast<MeshHandle>(_meshs.size());
+            _meshs.push_back(mesh);
+        }
+        return handle;
+    }
+
+    void MeshRegistry::remove(MeshHandle handle)
+    {
+        if (handle >= _meshs.size() || _meshs[handle].live == false)
+            return;
+        Mesh& mesh = _meshs[handle];
+        _formats[mesh.format].vertices.free(mesh.vertex_offset, mesh.no_of_vertices);
+        _formats[mesh.format].indices.free(mesh.index_offset, mesh.no_of_indices);
+        mesh.live = false;
+        _free_handles.push_back(handle);
+    }
+
+    DrawElementsIndirectCommand MeshRegistry::command(MeshHandle handle, std::uint32_t object) const
+    {
+        const Mesh& mesh = _meshs[handle];
+        return DrawElementsIndirectCommand
+        {
+            static_cast<std::uint32_t>(mesh.no_of_indices),
+            1,
+            static_cast<std::uint32_t>(mesh.index_offset),
+            static_cast<std::int32_t>(mesh.vertex_offset),
+            object
+        };
+    }
+
+    void MeshRegistry::defragment(void)
+    {
+        for (size_t i = 0; i < _formats.size(); ++i)
+        {
+            const Format& format = _formats[i];
+            if (format.vertices.no_of_free_ranges() > 1 || format.indices.no_of_free_ranges() > 1)
+                relocate(i, format.vertices.capacity(), format.indices.capacity());
+        }
+    }
+
+    void MeshRegistry::destroy(void)
+    {
+        for (auto& format : _formats)
+        {
+            GLuint buffers[] = { format.vertex_buffer_object, format.index_buffer_object };
+            glDeleteBuffers(2, buffers);
+            glDeleteVertexArrays(1, &format.vertex_array_object);
+        }
+        GLuint buffers[] = { _indirect_buffer, _object_buffer };
+        glDeleteBuffers(2, buffers);
+        _formats.clear();
+        _meshs.clear();
+        _free_handles.clear();
+        _indirect_buffer = 0;
+        _indirect_capacity = 0;
+        _object_buffer = 0;
+        _object_capacity = 0;
+    }
+
+    void MeshRegistry::draw(MeshHandle handle) const
+    {
+        if (handle >= _meshs.size() || _meshs[handle].live == false)
+            return;
+        const Mesh& mesh = _meshs[handle];
+        glBindVertexArray(_formats[mesh.format].vertex_array_object);
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(mesh.no_of_indices), GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>(mesh.index_offset * sizeof(GLuint)), static_cast<GLint>(mesh.vertex_offset));
+    }
+
+    void MeshRegistry::draw(const std::vector<DrawItem>& visible, const BindBatch& bind_batch, const BindObject& bind_object)
+    {
+        _statistics.batches = 0;
+        _statistics.commands = 0;
+        _statistics.draw_calls = 0;
+
+        // group the items by format and material; the order of the items in a group is kept
+        auto batch_key = [this](const DrawItem& item) -> std::uint64_t
+        {
+            return static_cast<std::uint64_t>(_meshs[item.mesh].format) << 32 | item.material;
+        };
+        _order.resize(visible.size());
+        std::iota(_order.begin(), _order.end(), 0);
+        bool sorted = true;
+        for (size_t i = 1; i < visible.size() && sorted; ++i)
+            sorted = batch_key(visible[i - 1]) <= batch_key(visible[i]);
+        if (sorted == false)
+        {
+            std::stable_sort(_order.begin(), _order.end(), [&](size_t a, size_t b)
+                {
+                    return batch_key(visible[a]) < batch_key(visible[b]);
+                });
+        }
+
+        _commands.clear();
+        std::uint32_t max_object = 0;
+        for (auto i : _order)
+        {
+            const DrawItem& item = visible[i];
+            _commands.push_back(command(item.mesh, item.object));
+            max_object = std::max(max_object, item.object);
+        }
+        if (_commands.empty())
+            return;
+        if (_object_attribute >= 0)
+            reserve_objects(static_cast<size_t>(max_object) + 1);
+
+        if (_multi_draw_indirect)
+        {
+            if (_indirect_buffer == 0)
+                glGenBuffers(1, &_indirect_buffer);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirect_buffer);
+            _indirect_capacity = std::max(_indirect_capacity, _commands.size());
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, _indirect_capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, _commands.size() * sizeof(DrawElementsIndirectCommand), _commands.data());
+        }
+
+        for (size_t first = 0; first < _order.size(); )
+        {
+            const DrawItem& first_item = visible[_order[first]];
+            size_t last = first + 1;
+            while (last < _order.size() && batch_key(visible[_order[last]]) == batch_key(first_item))
+                ++last;
+
+            DrawBatch batch{ _meshs[first_item.mesh].format, first_item.material, first, last - first };
+            glBindVertexArray(_formats[batch.format].vertex_array_object);
+            if (bind_batch)
+                bind_batch(batch);
+
+            if (_multi_draw_indirect)
+            {
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                    reinterpret_cast<const void*>(first * sizeof(DrawElementsIndirectCommand)), static_cast<GLsizei>(batch.no_of_commands), 0);
+                ++_statistics.draw_calls;
+            }
+            else
+            {
+                for (size_t i = first; i < last; ++i)
+                {
+                    const DrawElementsIndirectCommand& command = _commands[i];
+                    if (bind_object)
+                        bind_object(visible[_order[i]], i - first);
+                    glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(command.count), GL_UNSIGNED_INT,
+                        reinterpret_cast<const void*>(command.first_index * sizeof(GLuint)), command.base_vertex);
+                    ++_statistics.draw_calls;
+                }
+            }
+            ++_statistics.batches;
+            first = last;
+        }
+        _statistics.commands = _commands.size();
+    }
+
+    std::shared_ptr<MeshInterface> MeshRegistry::mesh(MeshHandle mesh)
+    {
+        return std::make_shared<RegisteredMesh>(*this, mesh);
+    }
+
+    size_t MeshRegistry::find_format(const ::mesh::VertexSpcification& specification, size_t attribute_size)
+    {
+        for (size_t i = 0; i < _formats.size(); ++i)
+        {
+            if (_formats[i].specification == specification)
+                return i;
+        }
+
+        Format format;
+        format.specification = specification;
+        format.attribute_size = attribute_size;
+        glGenVertexArrays(1, &format.vertex_array_object);
+        _formats.push_back(format);
+        size_t index = _formats.size() - 1;
+        relocate(index, 1 << 16, 1 << 18);
+        return index;
+    }
+
+    // Reallocate the buffers of a format and copy the meshes compactly to the new buffers.
+    void MeshRegistry::relocate(size_t format_index, size_t vertex_capacity, size_t index_capacity)
+    {
+        Format& format = _formats[format_index];
+        const size_t vertex_size = format.attribute_size * sizeof(GLfloat);
+
+        GLuint buffers[2];
+        glGenBuffers(2, buffers);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[0]);
+        glBufferData(GL_COPY_WRITE_BUFFER, vertex_capacity * vertex_size, nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[1]);
+        glBufferData(GL_COPY_WRITE_BUFFER, index_capacity * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
+
+        size_t vertex_offset = 0, index_offset = 0;
+        for (auto& mesh : _meshs)
+        {
+            if (mesh.live == false || mesh.format != format_index)
+                continue;
+
+            glBindBuffer(GL_COPY_READ_BUFFER, format.vertex_buffer_object);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[0]);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                mesh.vertex_offset * vertex_size, vertex_offset * vertex_size, mesh.no_of_vertices * vertex_size);
+            glBindBuffer(GL_COPY_READ_BUFFER, format.index_buffer_object);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[1]);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                mesh.index_offset * sizeof(GLuint), index_offset * sizeof(GLuint), mesh.no_of_indices * sizeof(GLuint));
+            _statistics.relocated_bytes += mesh.no_of_vertices * vertex_size + mesh.no_of_indices * sizeof(GLuint);
+
+            mesh.vertex_offset = vertex_offset;
+            mesh.index_offset = index_offset;
+            vertex_offset += mesh.no_of_vertices;
+            index_offset += mesh.no_of_indices;
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        GLuint old_buffers[] = { format.vertex_buffer_object, format.index_buffer_object };
+        glDeleteBuffers(2, old_buffers);
+        format.vertex_buffer_object = buffers[0];
+        format.index_buffer_object = buffers[1];
+        format.vertices.reset(vertex_capacity, vertex_offset);
+        format.indices.reset(index_capacity, index_offset);
+        setup_vertex_array(format);
+        ++_statistics.relocations;
+    }
+
+    void MeshRegistry::setup_vertex_array(Format& format)
+    {
+        glBindVertexArray(format.vertex_array_object);
+        glBindBuffer(GL_ARRAY_BUFFER, format.vertex_buffer_object);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, format.index_buffer_object);
+
+        size_t offset = 0;
+        for (const auto& [attribute_type, size] : format.specification)
+        {
+            auto attribute_index = static_cast<GLuint>(attribute_type);
+            glEnableVertexAttribArray(attribute_index);
+            glVertexAttribPointer(attribute_index, size, GL_FLOAT, GL_FALSE,
+                static_cast<GLsizei>(format.attribute_size * sizeof(GLfloat)), reinterpret_cast<const void*>(offset * sizeof(GLfloat)));
+            offset += size;
+        }
+
+        if (_object_attribute >= 0 && _object_buffer != 0)
+        {
+            auto attribute_index = static_cast<GLuint>(_object_attribute);
+            glBindBuffer(GL_ARRAY_BUFFER, _object_buffer);
+            glEnableVertexAttribArray(attribute_index);
+            glVertexAttribIPointer(attribute_index, 1, GL_UNSIGNED_INT, 0, nullptr);
+            glVertexAttribDivisor(attribute_index, 1);
+        }
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // The object buffer contains the sequence 0, 1, 2, ..., so the object attribute of an instance is its base instance.
+    void MeshRegistry::reserve_objects(size_t no_of_objects)
+    {
+        if (no_of_objects <= _object_capacity)
+            return;
+        _object_capacity = std::max(no_of_objects, _object_capacity * 2);
+        std::vector<GLuint> objects(_object_capacity);
+        std::iota(objects.begin(), objects.end(), 0);
+        if (_object_buffer == 0)
+            glGenBuffers(1, &_object_buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _object_buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, objects.size() * sizeof(GLuint), objects.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        for (auto& format : _formats)
+            setup_vertex_array(format);
+    }
+}
@@ -0,0 +1,142 @@
+// Headless batch generation of cone step maps.
+//
+// Loads each height map (the first channel of the image), generates the cone step map with
+// `Render::CConeStepMapGenerator` and writes it as RGBA PNG to `<output directory>/<name>_cone.png`.
+// Prints the generation time and the throughput of each image. `-pyramid` skips the rings, which are too low to
+// reduce the cone ratio, by a max-mip pyramid. With `-verify`, the result is compared with the
+// scalar loop on 1 thread.
+// No OpenGL context is required.
+//
+// usage: cone_step_map_batch [-a circular|square] [-t threads] [-rows tile rows] [-scalar] [-pyramid] [-verify] [-o output directory] height map...
+
+#include <stdafx.h>
+
+// stl
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// stb
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define __STDC_LIB_EXT1__
+#include <stb_image.h>
+#include <stb_image_write.h>
+
+// Own
+#include <util/RenderUtil_ConeStepMap.h>
+#include <util/RenderUtil_Parallel.h>
+
+
+// Name of the file without directory and extension
+std::string FileStem(const std::string& path)
+{
+    size_t begin = path.find_last_of("/\\");
+    begin = begin == std::string::npos ? 0 : begin + 1;
+    size_t end = path.find_last_of('.');
+    if (end == std::string::npos || end < begin)
+        end = path.size();
+    return path.substr(begin, end - begin);
+}
+
+
+int main(int argc, char** argv)
+{
+    Render::TConeMapParameters parameters;
+    std::string output_dir = ".";
+    bool verify = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-a" && has_value)
+        {
+            std::string name = argv[++i];
+            parameters._algorithm = name == "circular" ? Render::TConeMapAlgorithm::circular : Render::TConeMapAlgorithm::square_rings;
+        }
+        else if (arg == "-t" && has_value)
+            parameters._threads = (size_t)std::stoul(argv[++i]);
+        else if (arg == "-rows" && has_value)
+            parameters._tile_rows = (size_t)std::stoul(argv[++i]);
+        else if (arg == "-o" && has_value)
+            output_dir = argv[++i];
+        else if (arg == "-scalar")
+            parameters._simd = false;
+        else if (arg == "-pyramid")
+            parameters._pyramid = true;
+        else if (arg == "-verify")
+            verify = true;
+        else
+            files.push_back(arg);
+    }
+    if (files.empty())
+    {
+        std::printf("usage: cone_step_map_batch [-a circular|square] [-t threads] [-rows tile rows] [-scalar] [-pyramid] [-verify] [-o output directory] height map...\n");
+        return 1;
+    }
+
+    Render::CConeStepMapGenerator generator(parameters);
+    size_t threads = parameters._threads != 0 ? parameters._threads : Render::DefaultConcurrency();
+    std::printf("algorithm: %s, %s%s, %zu threads, %zu rows per tile\n",
+        parameters._algorithm == Render::TConeMapAlgorithm::circular ? "circular" : "square rings",
+        parameters._simd ? "SIMD" : "scalar", parameters._simd && parameters._pyramid ? " with pyramid" : "", threads, parameters._tile_rows);
+
+    int failed = 0;
+    double total_seconds = 0.0;
+    size_t total_texels = 0;
+    for (const auto& file : files)
+    {
+        int cx = 0, cy = 0, ch = 0;
+        stbi_uc* image = stbi_load(file.c_str(), &cx, &cy, &ch, 1);
+        if (image == nullptr)
+        {
+            std::printf("%s: failed to load (%s)\n", file.c_str(), stbi_failure_reason());
+            ++failed;
+            continue;
+        }
+
+        std::vector<Render::t_byte> cone_map;
+        auto start = std::chrono::steady_clock::now();
+        bool generated = generator.Generate(cx, cy, 1, cx, image, cone_map);
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        if (generated == false)
+        {
+            std::printf("%s: %d x %d is too small\n", file.c_str(), cx, cy);
+            stbi_image_free(image);
+            ++failed;
+            continue;
+        }
+        total_seconds += seconds.count();
+        total_texels += (size_t)cx * cy;
+
+        const char* check = "";
+        if (verify)
+        {
+            Render::TConeMapParameters reference_parameters = parameters;
+            reference_parameters._simd = false;
+            reference_parameters._threads = 1;
+            std::vector<Render::t_byte> reference;
+            Render::CConeStepMapGenerator(reference_parameters).Generate(cx, cy, 1, cx, image, reference);
+            check = reference == cone_map ? ", identical to scalar" : ", DIFFERENT from scalar";
+            if (reference != cone_map)
+                ++failed;
+        }
+        stbi_image_free(image);
+
+        std::string output = output_dir + "/" + FileStem(file) + "_cone.png";
+        if (stbi_write_png(output.c_str(), cx, cy, 4, cone_map.data(), cx * 4) == 0)
+        {
+            std::printf("%s: failed to write %s\n", file.c_str(), output.c_str());
+            ++failed;
+            continue;
+        }
+        std::printf("%s: %d x %d, %.1f ms, %.3f Mtexel/s -> %s%s\n",
+            file.c_str(), cx, cy, seconds.count() * 1000.0, (double)cx * cy / seconds.count() * 1e-6, output.c_str(), check);
+    }
+    if (total_seconds > 0.0)
+        std::printf("total: %zu texels, %.1f ms, %.3f Mtexel/s\n", total_texels, total_seconds * 1000.0, (double)total_texels / total_seconds * 1e-6);
+    return failed == 0 ? 0 : 1;
+}
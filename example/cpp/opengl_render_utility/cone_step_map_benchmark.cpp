@@ -0,0 +1,169 @@
+// Headless benchmark of the cone step map generation.
+//
+// Computes the cone step maps of the height maps of resource/texture and of procedural height maps (rolling hills
+// with steep bumps, and isolated peaks on a plain) with the circular search and with the square ring search.
+// Reports the throughput in Mtexel/s of the scalar loop on 1 thread, of the 8 texel SIMD scan on 1 thread and on all
+// threads, and of the SIMD scan with max-mip pyramid pruning on 1 thread and on all threads, and the speedup of the
+// pruning. All the results are compared with the scalar result.
+// No OpenGL context is required.
+//
+// usage: cone_step_map_benchmark [texture directory] [procedural size] [file ...]
+
+#include <stdafx.h>
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// stb
+#define STB_IMAGE_IMPLEMENTATION
+#define __STDC_LIB_EXT1__
+#include <stb_image.h>
+
+// Own
+#include <util/RenderUtil_ConeStepMap.h>
+#include <util/RenderUtil_Parallel.h>
+
+
+struct THeightMap
+{
+    std::string _name;
+    size_t _cx;
+    size_t _cy;
+    std::vector<Render::t_byte> _heights;
+};
+
+
+// Random number in [0, 1)
+float Random(std::uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / (float)(1u << 24);
+}
+
+
+// Tileable height map: some steep bumps, optionally on low frequency hills
+THeightMap CreateHeightMap(size_t size, std::uint32_t seed, bool hills)
+{
+    const float pi2 = 6.2831853f;
+    std::vector<float> heights(size * size, 0.0f);
+    for (size_t y = 0; y < size && hills; ++y)
+        for (size_t x = 0; x < size; ++x)
+        {
+            float u = (float)x / (float)size, v = (float)y / (float)size;
+            heights[y * size + x] = 0.3f + 0.15f * std::sin(pi2 * 2.0f * u) * std::cos(pi2 * 3.0f * v) + 0.05f * std::sin(pi2 * 7.0f * (u + v));
+        }
+    for (int i = 0; i < 24; ++i)
+    {
+        float cx = Random(seed) * size, cy = Random(seed) * size;
+        float radius = (0.02f + Random(seed) * 0.06f) * size;
+        float height = 0.2f + Random(seed) * 0.3f;
+        for (size_t y = 0; y < size; ++y)
+            for (size_t x = 0; x < size; ++x)
+            {
+                float dx = std::min(std::fabs(x - cx), size - std::fabs(x - cx));
+                float dy = std::min(std::fabs(y - cy), size - std::fabs(y - cy));
+                float d = std::sqrt(dx * dx + dy * dy) / radius;
+                if (d < 1.0f)
+                    heights[y * size + x] += height * (1.0f - d * d);
+            }
+    }
+    THeightMap map{ (hills ? "hills " : "peaks ") + std::to_string(size), size, size, std::vector<Render::t_byte>(size * size) };
+    for (size_t i = 0; i < heights.size(); ++i)
+        map._heights[i] = (Render::t_byte)(std::min(std::max(heights[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+    return map;
+}
+
+
+// Height map from the first channel of an image file
+bool LoadHeightMap(const std::string& dir, const std::string& file, THeightMap& map)
+{
+    int cx = 0, cy = 0, channels = 0;
+    stbi_uc* data = stbi_load((dir + file).c_str(), &cx, &cy, &channels, 1);
+    if (data == nullptr)
+        return false;
+    map = THeightMap{ file, (size_t)cx, (size_t)cy, std::vector<Render::t_byte>(data, data + (size_t)cx * cy) };
+    stbi_image_free(data);
+    return true;
+}
+
+
+template <class TFunc>
+double Best(int repetitions, TFunc func)
+{
+    double best_seconds = 1e30;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        best_seconds = std::min(best_seconds, seconds.count());
+    }
+    return best_seconds;
+}
+
+
+int main(int argc, char** argv)
+{
+    std::string dir = argc > 1 ? argv[1] : "./resource/texture/";
+    size_t procedural_size = argc > 2 ? (size_t)std::stoul(argv[2]) : 512;
+    std::vector<std::string> files;
+    for (int i = 3; i < argc; ++i)
+        files.push_back(argv[i]);
+    if (files.empty())
+        files = { "example_1_heightmap.bmp", "test1_heightmap.bmp", "GominolasBump.png", "toy_box_disp.png", "perlin1_cp.png", "perlin3_cp.png" };
+    const size_t threads = Render::DefaultConcurrency();
+
+    std::vector<THeightMap> maps;
+    for (auto& file : files)
+    {
+        THeightMap map;
+        if (LoadHeightMap(dir, file, map))
+            maps.push_back(std::move(map));
+        else
+            std::printf("file not found: %s\n", (dir + file).c_str());
+    }
+    maps.push_back(CreateHeightMap(procedural_size, 4711, true));
+    maps.push_back(CreateHeightMap(procedural_size, 4711, false));
+
+    std::printf("%zu threads, throughput in Mtexel/s\n", threads);
+    std::printf("%-24s %-12s %10s %10s %10s %10s %10s %8s %8s\n",
+        "height map", "algorithm", "scalar 1T", "SIMD 1T", "SIMD NT", "pyramid 1T", "pyramid NT", "pyramid", "diff");
+    for (auto& map : maps)
+    {
+        const int repetitions = map._cx * map._cy <= 256 * 256 ? 3 : 1;
+        for (auto algorithm : { Render::TConeMapAlgorithm::circular, Render::TConeMapAlgorithm::square_rings })
+        {
+            auto run = [&](bool simd, bool pyramid, size_t no_of_threads, std::vector<Render::t_byte>& cone_map)
+            {
+                Render::TConeMapParameters parameters;
+                parameters._algorithm = algorithm;
+                parameters._simd = simd;
+                parameters._pyramid = pyramid;
+                parameters._threads = no_of_threads;
+                Render::CConeStepMapGenerator generator(parameters);
+                return Best(repetitions, [&]() { generator.Generate(map._cx, map._cy, 1, map._cx, map._heights.data(), cone_map); });
+            };
+
+            std::vector<Render::t_byte> scalar, simd, simd_threads, pyramid, pyramid_threads;
+            double scalar_seconds = run(false, false, 1, scalar);
+            double simd_seconds = run(true, false, 1, simd);
+            double threads_seconds = run(true, false, threads, simd_threads);
+            double pyramid_seconds = run(true, true, 1, pyramid);
+            double pyramid_threads_seconds = run(true, true, threads, pyramid_threads);
+            bool same = scalar == simd && scalar == simd_threads && scalar == pyramid && scalar == pyramid_threads;
+            double texels = (double)map._cx * map._cy * 1e-6;
+            std::printf("%-24s %-12s %10.3f %10.3f %10.3f %10.3f %10.3f %7.1fx %8s\n",
+                map._name.c_str(), algorithm == Render::TConeMapAlgorithm::circular ? "circular" : "square rings",
+                texels / scalar_seconds, texels / simd_seconds, texels / threads_seconds,
+                texels / pyramid_seconds, texels / pyramid_threads_seconds, simd_seconds / pyramid_seconds,
+                same ? "none" : "DIFFER");
+        }
+    }
+    return 0;
+}
@@ -39,6 +39,7 @@
 #include <OpenGL/OpenGL_Matrix_Camera.h>
 #include <OpenGL/OpenGL_SimpleShaderProgram.h>
 #include <OpenGL/OpenGLError.h>
+#include <util/RenderUtil_ConeStepMap.h>
 
 
 std::string sh_vert = R"(
@@ -518,7 +519,9 @@ void ComputeShader(
 }
 
 
-void CreateConeMap_1(
+// CPU cone step map, see `Render::CConeStepMapGenerator`
+void CreateConeMap(
+    Render::TConeMapAlgorithm   algorithm,  //!< in:  search of the cone ratio
     std::vector<unsigned char>& data_out,   //!< out: conse step map
     long                        cx,         //!< in:  width of the image 
     long                        cy,         //!< in:  height of the image
@@ -533,556 +536,44 @@ void CreateConeMap_1(
         std::cout << "    Image size: " << cx << " x " << cy << std::endl;
 
     }
-    clock_t t_start = std::clock();
-
-    const double max_cone_c = 1.0;
-
-    data_out.reserve(cx * cy * 4);
-    for (int y = 0; y < cy; ++y)
-    {
-        for (int x = 0; x < cx; ++x)
-        {
-            unsigned char c = data_in[y * bpl + x * ch];
-
-            // invert this (used to convert depth-map to height-map)
-            if (false)
-                c = 255 - c;
-
-            unsigned char rgba[]{ c, c, c, c };
-            data_out.insert(data_out.end(), rgba, rgba + 4);
-        }
-    }
-
-    long width = cx;
-    long height = cy;
-    long chans = 4;
-    long ScanWidth = width * chans;
-    long TheSize = ScanWidth * height;
-    unsigned char* Data = data_out.data();
-
-    int   wProgress = width / 50;
-    int   hProgress = height / 50;
-    int   dProgress = width * height / 50;
-
-    // pre-processing: compute derivatives
-    if (log_level > 1)
-        std::cout << "    calcualte derivatives for normal vectors (blue = dx, alpha = dy)" << std::endl << "        [";
-    for (int y = 0; y < height; ++y)
-    {
-        // progress report: works great...if it's square!
-        if (log_level > 1 && (y % wProgress) == 0)
-            std::cout << ".";
-        for (int x = 0; x < width; ++x)
-        {
-            int der;
-            // Blue is the slope in x
-            if (x == 0)
-                der = (Data[y * ScanWidth + chans * (x + 1)] - Data[y * ScanWidth + chans * (x)]) / 2;
-            else if (x == width - 1)
-                der = (Data[y * ScanWidth + chans * (x)] - Data[y * ScanWidth + chans * (x - 1)]) / 2;
-            else
-                der = Data[y * ScanWidth + chans * (x + 1)] - Data[y * ScanWidth + chans * (x - 1)];
-            Data[y * ScanWidth + chans * x + 2] = 127 + der / 2;
-            // Alpha is the slope in y
-            if (y == 0)
-                der = (Data[(y + 1) * ScanWidth + chans * x] - Data[(y)*ScanWidth + chans * x]) / 2;
-            else if (y == height - 1)
-                der = (Data[(y)*ScanWidth + chans * x] - Data[(y - 1) * ScanWidth + chans * x]) / 2;
-            else
-                der = (Data[(y + 1) * ScanWidth + chans * x] - Data[(y - 1) * ScanWidth + chans * x]);
-            // And the sign of Y will be reversed in OpenGL
-            Data[y * ScanWidth + chans * x + 3] = 127 - der / 2;
-        }
-    }
-    if (log_level > 1)
-        std::cout << "]" << std::endl;
-
-    if (log_level > 1)
-        std::cout << "    scan " << height << " lines; red ... height, green ... cone equation (x = y * c) " << std::endl << "        [";
+    auto t_start = std::chrono::steady_clock::now();
 
+    Render::TConeMapParameters parameters;
+    parameters._algorithm = algorithm;
+    Render::CConeStepMapGenerator(parameters).Generate(cx, cy, ch, bpl, data_in, data_out);
 
-    float step_x = 1.0f / (float)cx;
-    float step_y = 1.0f / (float)cy;
-    float step = std::max(step_x, step_y);
-    for (int y = 0; y < height; ++y)
-    {
-        if (log_level > 1 && (y % hProgress) == 0)
-            std::cout << ".";
-        for (int x = 0; x < cx; ++x)
-        {
-            int   act_h = Data[y * ScanWidth + chans * x];
-            float c = max_cone_c;
-            float h = (float)act_h / 255.0f;
-            float max_h = 1.0f - h;
-            float max_dist = std::min((float)max_cone_c * max_h, 1.0f);
-
-            for (float dist = step; dist <= max_dist && c > dist / max_h; dist += step)
-            {
-                int   d2 = (int)(0.5f + (dist * dist) / (step * step));
-                int   dy = (int)(0.5f + dist / step_y);
-                int   sample_h = 0;
-                for (int dx = 0; sample_h < 255 && (float)dx / (float)cx <= dist; ++dx)
-                {
-                    if ((dx * dx + dy * dy) < d2 && dy < cy - 1)
-                        dy++;
-                    do
-                    {
-                        int sx_n = ((cx + x - dx) % cx) * chans;
-                        int sx_p = ((cx + x + dx) % cx) * chans;
-                        int sy_n = ((cy + y - dy) % cy) * ScanWidth;
-                        int sy_p = ((cy + y + dy) % cy) * ScanWidth;
-
-                        sample_h = std::max(sample_h, (int)Data[sy_p + sx_p]);
-                        sample_h = std::max(sample_h, (int)Data[sy_n + sx_p]);
-                        sample_h = std::max(sample_h, (int)Data[sy_p + sx_n]);
-                        sample_h = std::max(sample_h, (int)Data[sy_n + sx_n]);
-
-                        dy--;
-                    } while (dy > 0 && (dx * dx + dy * dy) >= d2);
-                }
-                if (sample_h > act_h)
-                {
-                    float d_h = (float)(sample_h - act_h) / 255.0f;
-                    float sample_c = dist / d_h;
-                    c = std::min(c, sample_c);
-                }
-            }
-
-            Data[y * ScanWidth + chans * x + 1] = (unsigned char)(sqrt(c) * 255.0f);
-        }
-    }
-    if (log_level > 1)
-        std::cout << "]" << std::endl;
-
-    clock_t t_end = std::clock();
-    clock_t dt = t_end - t_start;
+    auto t_end = std::chrono::steady_clock::now();
+    double dt = std::chrono::duration<double, std::milli>(t_end - t_start).count();
     if (log_level)
     {
-        std::cout << "Processed in " << (double)dt * 0.001 << " seconds" << std::endl;
+        std::cout << "Processed in " << dt * 0.001 << " seconds" << std::endl;
 
         mesaure_count++;
-        time_sum += (double)dt;
+        time_sum += dt;
         if (mesaure_count > 1)
-            std::cout << "Average " << (double)time_sum * 0.001 / (double)mesaure_count << " seconds (" << time_sum << ")" << std::endl;
+            std::cout << "Average " << time_sum * 0.001 / (double)mesaure_count << " seconds (" << time_sum << ")" << std::endl;
         std::cout << std::endl;
     }
 }
 
 
-void CreateConeMap_flat(
-    std::vector<unsigned char>& data_out,   //!< out: conse step map
-    long                        cx,         //!< in:  width of the image 
-    long                        cy,         //!< in:  height of the image
-    long                        ch,         //!< in:  color channels (e.g. 3 for RGB, 4 for RGBA)
-    long                        bpl,        //!< in:  bytes per scan line
-    const unsigned char* data_in,    //!< in:  image bits
-    int                         log_level) //!< in:  true: process logging
+void CreateConeMap_1(std::vector<unsigned char>& data_out, long cx, long cy, long ch, long bpl, const unsigned char* data_in, int log_level)
 {
-    if (log_level > 0)
-    {
-        std::cout << "Create cone step map" << std::endl;
-        std::cout << "    Image size: " << cx << " x " << cy << std::endl;
-    }
-    clock_t t_start = std::clock();
-
-    const double max_cone_c = 1.0;
-
-    data_out.reserve(cx * cy * 4);
-    for (int y = 0; y < cy; ++y)
-    {
-        for (int x = 0; x < cx; ++x)
-        {
-            unsigned char c = data_in[y * bpl + x * ch];
-
-            // invert this (used to convert depth-map to height-map)
-            if (false)
-                c = 255 - c;
-
-            unsigned char rgba[]{ c, c, c, c };
-            data_out.insert(data_out.end(), rgba, rgba + 4);
-        }
-    }
-
-    long width = cx;
-    long height = cy;
-    long chans = 4;
-    long ScanWidth = width * chans;
-    long TheSize = ScanWidth * height;
-    unsigned char* Data = data_out.data();
-
-    int   wProgress = width / 50;
-    int   hProgress = height / 50;
-    int   dProgress = width * height / 50;
-
-    // pre-processing: compute derivatives
-    if (log_level > 1)
-        std::cout << "    calcualte derivatives for normal vectors (blue = dx, alpha = dy)" << std::endl << "        [";
-    for (int y = 0; y < height; ++y)
-    {
-        // progress report: works great...if it's square!
-        if (log_level > 1 && (y % wProgress) == 0)
-            std::cout << ".";
-        for (int x = 0; x < width; ++x)
-        {
-            int der;
-            // Blue is the slope in x
-            if (x == 0)
-                der = (Data[y * ScanWidth + chans * (x + 1)] - Data[y * ScanWidth + chans * (x)]) / 2;
-            else if (x == width - 1)
-                der = (Data[y * ScanWidth + chans * (x)] - Data[y * ScanWidth + chans * (x - 1)]) / 2;
-            else
-                der = Data[y * ScanWidth + chans * (x + 1)] - Data[y * ScanWidth + chans * (x - 1)];
-            Data[y * ScanWidth + chans * x + 2] = 127 + der / 2;
-            // Alpha is the slope in y
-            if (y == 0)
-                der = (Data[(y + 1) * ScanWidth + chans * x] - Data[(y)*ScanWidth + chans * x]) / 2;
-            else if (y == height - 1)
-                der = (Data[(y)*ScanWidth + chans * x] - Data[(y - 1) * ScanWidth + chans * x]) / 2;
-            else
-                der = (Data[(y + 1) * ScanWidth + chans * x] - Data[(y - 1) * ScanWidth + chans * x]);
-            // And the sign of Y will be reversed in OpenGL
-            Data[y * ScanWidth + chans * x + 3] = 127 - der / 2;
-        }
-    }
-    if (log_level > 1)
-        std::cout << "]" << std::endl;
-
-    if (log_level > 1)
-        std::cout << "    scan " << height << " lines; red ... height, green ... cone equation (x = y * c) " << std::endl << "        [";
-
-
-    float step_x = 1.0f / (float)cx;
-    float step_y = 1.0f / (float)cy;
-    float step = std::max(step_x, step_y);
-    for (int y = 0; y < height; ++y)
-    {
-        if (log_level > 1 && (y % hProgress) == 0)
-            std::cout << ".";
-        for (int x = 0; x < cx; ++x)
-        {
-            int   act_h = Data[y * ScanWidth + chans * x];
-            float c = max_cone_c;
-            float h = (float)act_h / 255.0f;
-            float max_h = 1.0f - h;
-            float max_dist = std::min((float)max_cone_c * max_h, 1.0f);
-
-            for (float dist = step; dist <= max_dist && c > dist / max_h; dist += step)
-            {
-                int   d2 = (int)(0.5f + (dist * dist) / (step * step));
-                int   dy = (int)(0.5f + dist / step_y);
-                int   sample_h = 0;
-                for (int dx = 0; sample_h < 255 && (float)dx / (float)cx <= dist; ++dx)
-                {
-                    if ((dx * dx + dy * dy) < d2 && dy < cy - 1)
-                        dy++;
-                    do
-                    {
-                        int sx_n = ((cx + x - dx) % cx) * chans;
-                        int sx_p = ((cx + x + dx) % cx) * chans;
-                        int sy_n = ((cy + y - dy) % cy) * ScanWidth;
-                        int sy_p = ((cy + y + dy) % cy) * ScanWidth;
-
-                        sample_h = std::max(sample_h, (int)Data[sy_p + sx_p]);
-                        sample_h = std::max(sample_h, (int)Data[sy_n + sx_p]);
-                        sample_h = std::max(sample_h, (int)Data[sy_p + sx_n]);
-                        sample_h = std::max(sample_h, (int)Data[sy_n + sx_n]);
-
-                        dy--;
-                    } while (dy > 0 && (dx * dx + dy * dy) >= d2);
-                }
-                if (sample_h > act_h)
-                {
-                    float d_h = (float)(sample_h - act_h) / 255.0f;
-                    float sample_c = dist / d_h;
-                    c = std::min(c, sample_c);
-                }
-            }
-
-            Data[y * ScanWidth + chans * x + 1] = (unsigned char)(sqrt(c) * 255.0f);
-        }
-    }
-    if (log_level > 1)
-        std::cout << "]" << std::endl;
-
-    clock_t t_end = std::clock();
-    clock_t dt = t_end - t_start;
-    if (log_level)
-    {
-        std::cout << "Processed in " << (double)dt * 0.001 << " seconds" << std::endl;
-
-        mesaure_count++;
-        time_sum += (double)dt;
-        if (mesaure_count > 1)
-            std::cout << "Average " << (double)time_sum * 0.001 / (double)mesaure_count << " seconds (" << time_sum << ")" << std::endl;
-        std::cout << std::endl;
-    }
+    CreateConeMap(Render::TConeMapAlgorithm::circular, data_out, cx, cy, ch, bpl, data_in, log_level);
 }
 
-/*
-basically, 99% of all pixels will fall in under 2.0
-(most of the time, on the heightmaps I've tested)
-the question:
-Is reduced resolution worth missing
-the speedup of the slow ones?
-*/
-const float max_ratio = 1.0;
 
-// Do I want the textures to be computed as tileable?
-bool x_seamless = true;
-bool y_seamless = true;
+// the flat variant is the same search as `CreateConeMap_1`
+void CreateConeMap_flat(std::vector<unsigned char>& data_out, long cx, long cy, long ch, long bpl, const unsigned char* data_in, int log_level)
+{
+    CreateConeMap(Render::TConeMapAlgorithm::circular, data_out, cx, cy, ch, bpl, data_in, log_level);
+}
 
 
 // Algortihm from http://www.lonesock.net/files/ConeStepMapping.pdf
-void CreateConeMap_from_ConeStepMapping_pdf(
-    std::vector<unsigned char>& data_out,   //!< out: conse step map
-    long                        cx,         //!< in:  width of the image 
-    long                        cy,         //!< in:  height of the image
-    long                        ch,         //!< in:  color channels (e.g. 3 for RGB, 4 for RGBA)
-    long                        bpl,        //!< in:  bytes per scan line
-    const unsigned char* data_in,    //!< in:  image bits
-    int                         log_level) //!< in:  true: process logging
+void CreateConeMap_from_ConeStepMapping_pdf(std::vector<unsigned char>& data_out, long cx, long cy, long ch, long bpl, const unsigned char* data_in, int log_level)
 {
-    if (log_level > 0)
-    {
-        std::cout << "Create cone step map" << std::endl;
-        std::cout << "    Image size: " << cx << " x " << cy << std::endl;
-
-    }
-    clock_t t_start = std::clock();
-
-    float really_max = 1.0;
-
-    data_out.reserve(cx * cy * 4);
-    for (int y = 0; y < cy; ++y)
-    {
-        for (int x = 0; x < cx; ++x)
-        {
-            unsigned char c = data_in[y * bpl + x * ch];
-
-            // invert this (used to convert depth-map to height-map)
-            if (false)
-                c = 255 - c;
-
-            unsigned char rgba[]{ c, c, c, c };
-            data_out.insert(data_out.end(), rgba, rgba + 4);
-        }
-    }
-
-    long width = cx;
-    long height = cy;
-    long chans = 4;
-    long ScanWidth = width * chans;
-    long TheSize = ScanWidth * height;
-    unsigned char* Data = data_out.data();
-
-    float iheight = 1.0f / height;
-    float iwidth = 1.0f / width;
-    int   wProgress = width / 50;
-    int   hProgress = height / 50;
-
-    // pre-processing: compute derivatives
-    if (log_level > 1)
-        std::cout << "    calcualte derivatives for normal vectors (blue = dx, alpha = dy)" << std::endl << "        [";
-    for (int y = 0; y < height; ++y)
-    {
-        // progress report: works great...if it's square!
-        if (log_level > 1 && y % wProgress == 0)
-            std::cout << ".";
-        for (int x = 0; x < width; ++x)
-        {
-            int der;
-            // Blue is the slope in x
-            if (x == 0)
-                der = (Data[y * ScanWidth + chans * (x + 1)] - Data[y * ScanWidth + chans * (x)]) / 2;
-            else if (x == width - 1)
-                der = (Data[y * ScanWidth + chans * (x)] - Data[y * ScanWidth + chans * (x - 1)]) / 2;
-            else
-                der = Data[y * ScanWidth + chans * (x + 1)] - Data[y * ScanWidth + chans * (x - 1)];
-            Data[y * ScanWidth + chans * x + 2] = 127 + der / 2;
-            // Alpha is the slope in y
-            if (y == 0)
-                der = (Data[(y + 1) * ScanWidth + chans * x] - Data[(y)*ScanWidth + chans * x]) / 2;
-            else if (y == height - 1)
-                der = (Data[(y)*ScanWidth + chans * x] - Data[(y - 1) * ScanWidth + chans * x]) / 2;
-            else
-                der = (Data[(y + 1) * ScanWidth + chans * x] - Data[(y - 1) * ScanWidth + chans * x]);
-            // And the sign of Y will be reversed in OpenGL
-            Data[y * ScanWidth + chans * x + 3] = 127 - der / 2;
-        }
-    }
-    if (log_level > 1)
-        std::cout << "]" << std::endl;
-    // OK, do the processing
-    if (log_level > 1)
-        std::cout << "    scan " << height << " lines; red ... height, green ... cone equation (x = y * c) " << std::endl << "        [";
-    for (int y = 0; y < height; ++y)
-    {
-        if (log_level > 1 && (y % hProgress) == 0)
-            std::cout << ".";
-        for (int x = 0; x < width; ++x)
-        {
-            float actual_ratio;
-            int x1, x2, y1, y2;
-            float r2, h2;
-            // set up some initial values
-            // (note I'm using ratio squared throughout,
-            // and taking sqrt at the end...faster)
-            float min_ratio2 = max_ratio * max_ratio;
-            // information about this center point
-            float ht = Data[y * ScanWidth + chans * x] / 255.0f;
-            float dhdx = +(Data[y * ScanWidth + chans * x + 2] / 255.0f - 0.5f) * width;
-            float dhdy = -(Data[y * ScanWidth + chans * x + 3] / 255.0f - 0.5f) * height;
-            // scan in outwardly expanding blocks
-            // (so I can stop if I reach my minimum ratio)
-            for (int rad = 1;
-                (rad * rad <= 1.1 * 1.1 * (1.0 - ht) * (1.0 - ht) * min_ratio2 * width * height)
-                && (rad <= 1.1 * (1.0 - ht) * width) && (rad <= 1.1 * (1.0 - ht) * height);
-                ++rad)
-            {
-                // ok, for each of these lines...
-                // West
-                x1 = x - rad;
-                while (x_seamless && (x1 < 0))
-                    x1 += width;
-                if (x1 >= 0)
-                {
-                    float delx = -rad * iwidth;
-                    // y limits
-                    // (+- 1 because I'll cover the corners in the X-run)
-                    y1 = y - rad + 1;
-                    if (y1 < 0)
-                        y1 = 0;
-                    y2 = y + rad - 1;
-                    if (y2 >= height)
-                        y2 = height - 1;
-                    // and check the line
-                    for (int dy = y1; dy <= y2; ++dy)
-                    {
-                        float dely = (dy - y) * iheight;
-                        r2 = delx * delx + dely * dely;
-                        //h2 = Data[dy*ScanWidth + chans*x1] / 255.0f - ht;
-                        h2 = (0.5f + Data[dy * ScanWidth + chans * x1]) / 255.0f - ht;
-                        if ((h2 > 0.0f) && (h2 * h2 * min_ratio2 > r2))
-                        {
-                            // this is the new (lowest) value
-                            min_ratio2 = r2 / (h2 * h2);
-                        }
-                    }
-                }
-                // East
-                x2 = x + rad;
-                while (x_seamless && (x2 >= width))
-                    x2 -= width;
-                if (x2 < width)
-                {
-                    float delx = rad * iwidth;
-                    // y limits
-                    // (+- 1 because I'll cover the corners in the X-run)
-                    y1 = y - rad + 1;
-                    if (y1 < 0)
-                        y1 = 0;
-                    y2 = y + rad - 1;
-                    if (y2 >= height)
-                        y2 = height - 1;
-                    // and check the line
-                    for (int dy = y1; dy <= y2; ++dy)
-                    {
-                        float dely = (dy - y) * iheight;
-                        r2 = delx * delx + dely * dely;
-                        //h2 = Data[dy*ScanWidth + chans*x2] / 255.0f - ht;
-                        h2 = (0.5f + Data[dy * ScanWidth + chans * x2]) / 255.0f - ht;
-                        if ((h2 > 0.0f) && (h2 * h2 * min_ratio2 > r2))
-                        {
-                            // this is the new (lowest) value
-                            min_ratio2 = r2 / (h2 * h2);
-                        }
-                    }
-                }
-                // North
-                y1 = y - rad;
-                while (y_seamless && (y1 < 0))
-                    y1 += height;
-                if (y1 >= 0)
-                {
-                    float dely = -rad * iheight;
-                    // y limits
-                    // (+- 1 because I'll cover the corners in the X-run)
-                    x1 = x - rad;
-                    if (x1 < 0)
-                        x1 = 0;
-                    x2 = x + rad;
-                    if (x2 >= width)
-                        x2 = width - 1;
-                    // and check the line
-                    for (int dx = x1; dx <= x2; ++dx)
-                    {
-                        float delx = (dx - x) * iwidth;
-                        r2 = delx * delx + dely * dely;
-                        //h2 = Data[y1*ScanWidth + chans*dx] / 255.0f - ht;
-                        h2 = (0.5f + Data[y1 * ScanWidth + chans * dx]) / 255.0f - ht;
-                        if ((h2 > 0.0f) && (h2 * h2 * min_ratio2 > r2))
-                        {
-                            // this is the new (lowest) value
-                            min_ratio2 = r2 / (h2 * h2);
-                        }
-                    }
-                }
-                // South
-                y2 = y + rad;
-                while (y_seamless && (y2 >= height))
-                    y2 -= height;
-                if (y2 < height)
-                {
-                    float dely = rad * iheight;
-                    // y limits
-                    // (+- 1 because I'll cover the corners in the X-run)
-                    x1 = x - rad;
-                    if (x1 < 0)
-                        x1 = 0;
-                    x2 = x + rad;
-                    if (x2 >= width)
-                        x2 = width - 1;
-                    // and check the line
-                    for (int dx = x1; dx <= x2; ++dx)
-                    {
-                        float delx = (dx - x) * iwidth;
-                        r2 = delx * delx + dely * dely;
-                        //h2 = Data[y2*ScanWidth + chans*dx] / 255.0f - ht;
-                        h2 = (0.5f + Data[y2 * ScanWidth + chans * dx]) / 255.0f - ht;
-                        if ((h2 > 0.0f) && (h2 * h2 * min_ratio2 > r2))
-                        {
-                            // this is the new (lowest) value
-                            min_ratio2 = r2 / (h2 * h2);
-                        }
-                    }
-                }
-                // done with the expanding loop
-            }
-            /********** CONE VERSION **********/
-            // actually I have the ratio squared. Sqrt it
-            actual_ratio = sqrt(min_ratio2);
-            // here I need to scale to 1.0
-            actual_ratio /= max_ratio;
-            // most of the data is on the low end...sqrting again spreads it better
-            // (plus multiply is a cheap operation in shaders!)
-            actual_ratio = sqrt(actual_ratio);
-            // Red stays height
-            // Blue remains the slope in x
-            // Alpha remains the slope in y
-            // but Green becomes Step-Cone-Ratio
-            Data[y * ScanWidth + chans * x + 1] = static_cast<unsigned char>(255.0 * actual_ratio + 0.5);
-            // but make sure it is > 0.0, since I divide by it in the shader
-            if (Data[y * ScanWidth + chans * x + 1] < 1)
-                Data[y * ScanWidth + chans * x + 1] = 1;
-        }
-    }
-    if (log_level > 1)
-        std::cout << "]" << std::endl;
-
-    clock_t t_end = std::clock();
-    clock_t dt = t_end - t_start;
-    if (log_level)
-        std::cout << "Processed in " << (double)dt * 0.001 << " seconds" << std::endl << std::endl;
+    CreateConeMap(Render::TConeMapAlgorithm::square_rings, data_out, cx, cy, ch, bpl, data_in, log_level);
 }
 
 void COpenGLContext::Init(COpenGLContext::TDebugLevel debug_level)
@@ -30,6 +30,7 @@
 #include <OpenGL/OpenGL_Matrix_Camera.h>
 #include <OpenGL/OpenGL_SimpleShaderProgram.h>
 #include <OpenGL/OpenGLBasicDraw.h>
+#include <OpenGL/OpenGLProgram.h>
 #include <OpenGL/OpenGLError.h>
 
 
@@ -222,6 +223,10 @@ int main(int argc, char** argv)
     std::cout << glGetString(GL_VERSION) << std::endl;
     std::cout << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
 
+    // optional cache of the program binaries: `draw_library_scenes --program-cache <directory>`
+    if (argc > 2 && std::string(argv[1]) == "--program-cache")
+        OpenGL::CProgramBinaryCache::Install(std::make_shared<OpenGL::CProgramBinaryCache>(argv[2]));
+
     GLint major = 0, minor = 0, contex_mask = 0;
     glGetIntegerv(GL_MAJOR_VERSION, &major);
     glGetIntegerv(GL_MINOR_VERSION, &minor);
@@ -500,7 +505,19 @@ void CWindow_Glfw::InitScene(void)
     //if ( _scene == )
     //_draw->BackgroundColor( Color_white() );
     _draw->BackgroundColor(Color_paper_nature());
+
+    // report the startup time (cold: programs compiled, warm: programs loaded from the binary cache)
+    static bool startup_reported = false;
+    auto start_time = std::chrono::high_resolution_clock::now();
     _draw->Init();
+    if (startup_reported == false)
+    {
+        double init_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+        std::cout << "draw library initialization: " << init_ms << " ms" << std::endl;
+        if (OpenGL::CProgramBinaryCache::Installed() != nullptr)
+            std::cout << OpenGL::CProgramBinaryCache::Installed()->Report() << std::endl;
+        startup_reported = true;
+    }
 }
 
 
@@ -0,0 +1,122 @@
+// Headless benchmark of the glyph atlas startup.
+//
+// Adds the printable Latin-1 and Latin Extended-A characters of a font to the glyph atlas as bitmaps,
+// signed distance fields and multi-channel signed distance fields and reports the startup time,
+// the number of atlas pages and the atlas occupancy.
+// No OpenGL context is required; the atlas pages are not uploaded.
+//
+// usage: font_atlas_benchmark [font file] [threads]
+
+#include <stdafx.h>
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Own
+#include <util/RenderUtil_FreetypeFont.h>
+
+
+// Texture loader without a graphics context; the font keeps the loader, but the benchmark never uploads the atlas.
+class CNullTextureLoader
+    : public Render::ITextureLoader
+{
+public:
+
+    virtual Render::ITexturePtr CreateTexture(const Render::TTextureSize&, size_t, const Render::TTextureParameters&) override { return nullptr; }
+    virtual Render::ITexturePtr CreateTexture(const Render::IImageResource&, Render::TImageTransformations, const Render::TTextureSize&, size_t, const Render::TTextureParameters&) override { return nullptr; }
+    virtual Render::ITexturePtr CreateTexture(const std::vector<const Render::IImageResource*>&, const Render::TTextureParameters&) override { return nullptr; }
+    virtual bool AllocateLevels(Render::ITexture&, const Render::TTextureParameters&, const Render::TTextureSize&, size_t) override { return false; }
+    virtual bool SetLevelRange(Render::ITexture&, size_t, size_t) override { return false; }
+    virtual bool LoadToTexture(const Render::IImageResource&, Render::ITexture&, const Render::TTexturePoint&, size_t, size_t) override { return false; }
+};
+
+
+// UTF-8 encoding of a code point in the range [0, 0x7FF]
+void AppendUTF8(std::string& str, char32_t c)
+{
+    if (c < 0x80)
+    {
+        str.push_back((char)c);
+        return;
+    }
+    str.push_back((char)(0xC0 | (c >> 6)));
+    str.push_back((char)(0x80 | (c & 0x3F)));
+}
+
+
+int main(int argc, char** argv)
+{
+    std::string font_file = argc > 1 ? argv[1] : "./resource/font/FreeSans.ttf";
+    size_t threads = argc > 2 ? (size_t)std::stoul(argv[2]) : 0;
+
+    std::string characters;
+    for (char32_t c = 0x20; c < 0x7F; ++c)
+        AppendUTF8(characters, c);
+    for (char32_t c = 0xA0; c < 0x180; ++c)
+        AppendUTF8(characters, c);
+
+    struct TConfiguration
+    {
+        const char* _name;
+        Render::TGlyphImageType _type;
+        size_t _pixel_height;
+        size_t _threads;
+    };
+    const std::vector<TConfiguration> configurations
+    {
+        { "bitmap 48px",     Render::TGlyphImageType::bitmap, 48, 1 },
+        { "SDF 32px",        Render::TGlyphImageType::sdf,    32, 1 },
+        { "SDF 32px (MT)",   Render::TGlyphImageType::sdf,    32, threads },
+        { "MSDF 32px",       Render::TGlyphImageType::msdf,   32, 1 },
+        { "MSDF 32px (MT)",  Render::TGlyphImageType::msdf,   32, threads },
+        { "MSDF 64px (MT)",  Render::TGlyphImageType::msdf,   64, threads },
+    };
+    const int repetitions = 3;
+
+    CNullTextureLoader loader;
+    std::printf("%-16s %8s %10s %6s %10s %12s\n", "glyphs", "count", "time [ms]", "pages", "occupancy", "atlas [KiB]");
+    for (auto& configuration : configurations)
+    {
+        Render::TFreetypeFontParameters parameters;
+        parameters._glyph_image = configuration._type;
+        parameters._pixel_height = configuration._pixel_height;
+        parameters._threads = configuration._threads;
+        parameters._atlas._max_pages = 16;
+
+        // best of n runs; load the font face and add all the glyphs to the atlas
+        double best_seconds = 1e30;
+        size_t glyphs = 0, pages = 0;
+        double occupancy = 0.0;
+        for (int i = 0; i < repetitions; ++i)
+        {
+            Render::CFreetypeTexturedFont font(font_file.c_str(), 32, parameters);
+            auto start = std::chrono::steady_clock::now();
+            try
+            {
+                font.Load(loader);
+            }
+            catch (...)
+            {
+                std::cout << "font not found: " << font_file << std::endl;
+                return 1;
+            }
+            font.LoadGlyphs(characters);
+            std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+            best_seconds = std::min(best_seconds, seconds.count());
+
+            glyphs = font.Atlas()->Glyphs();
+            pages = font.Atlas()->Pages();
+            occupancy = font.Atlas()->Occupancy();
+        }
+
+        size_t page_size = parameters._atlas._page_size;
+        double atlas_kib = (double)(pages * page_size * page_size * 4) / 1024.0;
+        std::printf("%-16s %8zu %10.2f %6zu %9.1f%% %12.0f\n", configuration._name, glyphs, best_seconds * 1e3, pages, occupancy * 100.0, atlas_kib);
+    }
+    return 0;
+}
@@ -0,0 +1,249 @@
+// Headless batch rendering with `CBasicDraw`.
+//
+// Creates an EGL pbuffer context (no window system; runs on Mesa llvmpipe without a GPU), renders a sequence of
+// procedural scenes (polygons, polylines and arrows) and reads the RGBA8 frames back to the CPU. The frames are read
+// once with a synchronous `glReadPixels` per image and once with the double buffered asynchronous read back
+// (`CAsyncReadback`), where the copy of frame n overlaps the rendering of frame n+1. Reports images/s of both methods
+// and compares the checksums of the frames. If an output directory is given, the frames are written as binary PPM
+// files.
+// The shaders of `CBasicDraw` are GLSL 4.60; for Mesa versions, where llvmpipe reports OpenGL 4.5, the Mesa version
+// override is set, if it is not set in the environment.
+// If a trace file is given, the scenes are rendered once more with the frame profiler enabled; the summary of the
+// CPU and GPU scopes of the passes is printed and the trace is written in the Chrome trace format.
+//
+// usage: headless_batch_render [images] [width] [height] [output directory] [trace file]
+
+#include <stdafx.h>
+
+// OpenGL
+#include <GL/glew.h>
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Own
+#include <OpenGL/OpenGL_Matrix_Camera.h>
+#include <OpenGL/OpenGLBasicDraw.h>
+#include <OpenGL/OpenGLHeadlessContext.h>
+#include <OpenGL/OpenGLReadback.h>
+#include <util/RenderUtil_Hash.h>
+#include <util/RenderUtil_Profiler.h>
+
+
+// FNV-1a hash of a frame
+std::uint64_t Checksum(const std::vector<std::uint8_t>& rgba)
+{
+    return Render::HashFNV1a64(rgba.data(), rgba.size());
+}
+
+
+bool WritePPM(const std::string& path, const std::vector<std::uint8_t>& rgba, size_t width, size_t height)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+    std::fprintf(file, "P6\n%zu %zu\n255\n", width, height);
+    std::vector<std::uint8_t> rgb(width * height * 3);
+    for (size_t i = 0; i < width * height; ++i)
+        std::copy(rgba.begin() + i * 4, rgba.begin() + i * 4 + 3, rgb.begin() + i * 3);
+    bool success = std::fwrite(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    std::fclose(file);
+    return success;
+}
+
+
+// Procedural scene of an index: a rotating fan of polygons, a star polyline and arrows
+void RenderScene(OpenGL::CBasicDraw& draw, size_t index, size_t width, size_t height)
+{
+    const float pi = 3.14159265f;
+    float aspect = (float)width / (float)height;
+    float scale_x = aspect > 1.0f ? aspect : 1.0f;
+    float scale_y = aspect > 1.0f ? 1.0f : 1.0f / aspect;
+    float angle = (float)index * 0.05f;
+    float t = (float)(index % 64) / 63.0f;
+
+    draw.ViewportSize({ width, height });
+    draw.Projection(OpenGL::Camera::Orthopraphic(scale_x, scale_y, { -10.0f, 10.0f }));
+    draw.View(OpenGL::Identity());
+    draw.Model(OpenGL::Identity());
+    draw.BackgroundColor({ 0.9f - 0.3f * t, 0.9f, 0.8f + 0.2f * t, 1.0f });
+    draw.Begin();
+
+    draw.ActivateBackground();
+    draw.DrawRectangle2D({ -0.9f * scale_x, -0.9f * scale_y }, { 0.9f * scale_x, 0.9f * scale_y }, 0.0f, { 0.3f, 0.3f, 0.3f, 1.0f }, 3);
+
+    draw.ActivateOpaque();
+    const int no_of_segments = 6 + (int)(index % 5);
+    for (int i = 0; i < no_of_segments; ++i)
+    {
+        float a0 = angle + 2.0f * pi * (float)i / (float)no_of_segments;
+        float a1 = a0 + pi / (float)no_of_segments;
+        draw.DrawConvexPolygon(2, { 0.0f, 0.0f, 0.7f * std::cos(a0), 0.7f * std::sin(a0), 0.7f * std::cos(a1), 0.7f * std::sin(a1) },
+            { (float)(i % 3 == 0), (float)(i % 3 == 1), (float)(i % 3 == 2), 1.0f });
+    }
+
+    std::vector<float> star;
+    for (int i = 0; i < 10; ++i)
+    {
+        float r = i % 2 == 0 ? 0.85f : 0.4f;
+        float a = -angle + 2.0f * pi * (float)i / 10.0f;
+        star.insert(star.end(), { r * std::cos(a), r * std::sin(a), 0.1f });
+    }
+    draw.DrawPolyline(3, star, { 0.1f, 0.1f, 0.5f, 1.0f }, 3.0f, true);
+    draw.DrawArrow(3, { -0.8f * scale_x, -0.8f * scale_y, 0.2f, (0.8f - 1.6f * t) * scale_x, 0.8f * scale_y, 0.2f },
+        { 0.8f, 0.2f, 0.0f, 1.0f }, 3.0f, { 0.05f, 0.03f }, false, true);
+
+    draw.ActivateTransparent();
+    draw.DrawConvexPolygon(2, { -0.5f, -0.5f, 0.5f - t, -0.5f, 0.0f, 0.6f }, { 1.0f, 1.0f, 0.0f, 0.4f });
+
+    draw.Finish();
+}
+
+
+// Synchronous read back of the default framebuffer, top row first
+void ReadFrame(std::vector<std::uint8_t>& rgba, std::vector<std::uint8_t>& rows, size_t width, size_t height)
+{
+    size_t row = width * 4;
+    rows.resize(row * height);
+    rgba.resize(row * height);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, (GLsizei)width, (GLsizei)height, GL_RGBA, GL_UNSIGNED_BYTE, rows.data());
+    for (size_t y = 0; y < height; ++y)
+        std::copy(rows.begin() + (height - 1 - y) * row, rows.begin() + (height - y) * row, rgba.begin() + y * row);
+}
+
+
+int main(int argc, char** argv)
+{
+    size_t no_of_images = argc > 1 ? (size_t)std::stoul(argv[1]) : 200;
+    size_t width = argc > 2 ? (size_t)std::stoul(argv[2]) : 256;
+    size_t height = argc > 3 ? (size_t)std::stoul(argv[3]) : 256;
+    std::string output = argc > 4 ? argv[4] : "";
+    std::string trace = argc > 5 ? argv[5] : "";
+
+    setenv("MESA_GL_VERSION_OVERRIDE", "4.6", 0);
+    setenv("MESA_GLSL_VERSION_OVERRIDE", "460", 0);
+
+    try
+    {
+        OpenGL::CHeadlessContext::TConfig config;
+        config._width = width;
+        config._height = height;
+        OpenGL::CHeadlessContext context(config);
+        if (context.Activate() == false)
+            throw std::runtime_error("eglMakeCurrent failed");
+
+        // GLEW, which was built for GLX, reports missing GLX display; the GL functions are loaded anyway
+        glewExperimental = true;
+        GLenum glew_status = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        if (glew_status == GLEW_ERROR_NO_GLX_DISPLAY)
+            glew_status = GLEW_OK;
+#endif
+        if (glew_status != GLEW_OK)
+            throw std::runtime_error("GLEW initialization failed");
+
+        const char* platforms[] = { "automatic", "device", "surfaceless", "default display" };
+        std::printf("EGL: %s, %s platform\n", context.Vendor().c_str(), platforms[(int)context.Platform()]);
+        std::printf("OpenGL: %s, %s\n", (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION));
+
+        OpenGL::CBasicDraw draw(true, 0, 1.0f, false);
+        if (draw.Init() == false)
+            throw std::runtime_error("CBasicDraw initialization failed");
+
+        // warm up: shaders and buffers
+        RenderScene(draw, 0, width, height);
+        glFinish();
+
+        std::vector<std::uint64_t> sync_checksums(no_of_images), async_checksums(no_of_images);
+        std::vector<std::uint8_t> rgba, rows;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < no_of_images; ++i)
+        {
+            RenderScene(draw, i, width, height);
+            ReadFrame(rgba, rows, width, height);
+            sync_checksums[i] = Checksum(rgba);
+        }
+        std::chrono::duration<double> sync_seconds = std::chrono::steady_clock::now() - start;
+
+        OpenGL::CAsyncReadback readback(2);
+        OpenGL::CAsyncReadback::TFrame frame;
+        size_t written = 0;
+        auto consume = [&](const OpenGL::CAsyncReadback::TFrame& image)
+        {
+            async_checksums[image._tag] = Checksum(image._rgba);
+            if (output.empty() == false)
+            {
+                char name[32];
+                std::snprintf(name, sizeof(name), "/frame_%05zu.ppm", image._tag);
+                written += WritePPM(output + name, image._rgba, image._width, image._height) ? 1 : 0;
+            }
+        };
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < no_of_images; ++i)
+        {
+            RenderScene(draw, i, width, height);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            if (readback.Read(0, 0, width, height, i) == false)
+            {
+                if (readback.Retrieve(frame, true))
+                    consume(frame);
+                readback.Read(0, 0, width, height, i);
+            }
+            while (readback.Retrieve(frame, false))
+                consume(frame);
+        }
+        while (readback.Retrieve(frame, true))
+            consume(frame);
+        std::chrono::duration<double> async_seconds = std::chrono::steady_clock::now() - start;
+        const auto& statistics = readback.Statistics();
+
+        bool identical = sync_checksums == async_checksums;
+        std::printf("%zu images of %zux%zu\n", no_of_images, width, height);
+        std::printf("%-24s %12s %12s\n", "read back", "time[ms]", "images/s");
+        std::printf("%-24s %12.1f %12.1f\n", "glReadPixels", sync_seconds.count() * 1e3, (double)no_of_images / sync_seconds.count());
+        std::printf("%-24s %12.1f %12.1f\n", "PBO + fence, 2 buffers", async_seconds.count() * 1e3, (double)no_of_images / async_seconds.count());
+        std::printf("retrieved: %zu, stalls: %zu, identical: %s\n", statistics._retrieved, statistics._stalls, identical ? "yes" : "no");
+        if (output.empty() == false)
+            std::printf("written: %zu\n", written);
+
+        if (trace.empty() == false)
+        {
+            auto& profiler = Render::CProfiler::Instance();
+            profiler.ThreadName("render").Enable(true).Capture(true);
+            for (size_t i = 0; i < no_of_images; ++i)
+            {
+                RenderScene(draw, i, width, height);
+                profiler.NewFrame();
+            }
+            if (draw.GpuProfiler() != nullptr)
+                draw.GpuProfiler()->Flush();
+            profiler.NewFrame();
+            profiler.Enable(false);
+
+            std::printf("%s", profiler.SummaryText().c_str());
+            if (profiler.WriteChromeTrace(trace) == false)
+                throw std::runtime_error("writing the trace failed");
+            std::printf("trace: %s (%zu scopes)\n", trace.c_str(), profiler.Statistics()._captured);
+        }
+
+        readback.Destroy();
+        draw.Destroy();
+        return identical ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,238 @@
+// Headless benchmark of the clustered light assignment.
+//
+// Scatters 1024 to 16384 point and spot lights in a city block of 400 m x 400 m and assigns them to a 16x9x24
+// cluster grid. Reports the assignment time on 1 thread and on all threads, the time of a brute force test of each
+// light against each cluster, and the number of light indices. The result of the threads is compared with the
+// single threaded result; points in the influence volumes of the lights are mapped to clusters as the shader does
+// it, and each of them has to find its light in the list of the cluster.
+// No OpenGL context is required.
+//
+// usage: light_clustering_benchmark [max lights]
+
+#include <stdafx.h>
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Own
+#include <util/RenderUtil_ClusteredLights.h>
+#include <util/RenderUtil_Parallel.h>
+
+
+// Random number in [0, 1)
+float Random(std::uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / (float)(1u << 24);
+}
+
+
+// Perspective projection (column major)
+Render::TMat44 Perspective(float fov_y, float aspect, float near_plane, float far_plane)
+{
+    float f = 1.0f / std::tan(fov_y * 0.5f);
+    Render::TMat44 projection{};
+    projection[0][0] = f / aspect;
+    projection[1][1] = f;
+    projection[2][2] = (far_plane + near_plane) / (near_plane - far_plane);
+    projection[2][3] = -1.0f;
+    projection[3][2] = 2.0f * far_plane * near_plane / (near_plane - far_plane);
+    return projection;
+}
+
+
+// View matrix looking from `eye` in direction `dir` (y is up)
+Render::TMat44 LookAt(const Render::TVec3& eye, const Render::TVec3& dir)
+{
+    auto normalize = [](Render::TVec3 v) { float l = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]); return Render::TVec3{ v[0] / l, v[1] / l, v[2] / l }; };
+    auto cross = [](const Render::TVec3& a, const Render::TVec3& b) { return Render::TVec3{ a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] }; };
+    auto dot = [](const Render::TVec3& a, const Render::TVec3& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+    Render::TVec3 z = normalize(Render::TVec3{ -dir[0], -dir[1], -dir[2] });
+    Render::TVec3 x = normalize(cross(Render::TVec3{ 0.0f, 1.0f, 0.0f }, z));
+    Render::TVec3 y = cross(z, x);
+    Render::TMat44 view{};
+    for (int i = 0; i < 3; ++i)
+    {
+        view[i][0] = x[i];
+        view[i][1] = y[i];
+        view[i][2] = z[i];
+    }
+    view[3] = Render::TVec4{ -dot(x, eye), -dot(y, eye), -dot(z, eye), 1.0f };
+    return view;
+}
+
+
+// Light table: point and spot lights with a radius or an attenuation, and a directional light
+Render::TLightTable CreateLights(size_t no_of_lights, std::uint32_t seed)
+{
+    Render::TLightTable lights(no_of_lights + 1, Render::TLight{});
+    for (size_t i = 0; i < no_of_lights; ++i)
+    {
+        Render::TLight& light = lights[i];
+        light._properties.set((size_t)Render::TLightProperty::enabled);
+        light._diffuse = { 255, (Render::t_byte)(128 + Random(seed) * 127), 200, (Render::t_byte)(64 + Random(seed) * 191) };
+        light._position = { -200.0f + Random(seed) * 400.0f, Random(seed) * 20.0f, -400.0f + Random(seed) * 400.0f, 1.0f };
+        if (i % 2 == 0)
+        {
+            light._properties.set((size_t)Render::TLightProperty::auto_attenuation_by_radius);
+            light._maximum_radius = 3.0f + Random(seed) * 12.0f;
+        }
+        else
+        {
+            light._attenuation = { 1.0f, 0.0f, 0.5f + Random(seed) * 2.0f };
+        }
+        if (i % 4 >= 2)
+        {
+            light._light_cone = 0.3f + Random(seed) * 1.6f;
+            light._cone_attenuation = Random(seed) * 100.0f;
+            light._direction = { Random(seed) - 0.5f, -1.0f, Random(seed) - 0.5f };
+        }
+    }
+    Render::TLight& sun = lights.back();
+    sun._properties.set((size_t)Render::TLightProperty::enabled);
+    sun._diffuse = { 255, 255, 255, 255 };
+    sun._position = { 0.3f, 1.0f, 0.2f, 0.0f };
+    return lights;
+}
+
+
+template <class TFunc>
+double Best(int repetitions, TFunc func)
+{
+    double best_seconds = 1e30;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        best_seconds = std::min(best_seconds, seconds.count());
+    }
+    return best_seconds;
+}
+
+
+int main(int argc, char** argv)
+{
+    size_t max_lights = argc > 1 ? (size_t)std::stoul(argv[1]) : 16384;
+    const size_t threads = Render::DefaultConcurrency();
+
+    Render::TMat44 view = LookAt({ 0.0f, 10.0f, 0.0f }, { 0.0f, -0.15f, -1.0f });
+    const float near_plane = 0.1f, far_plane = 500.0f;
+    Render::TMat44 projection = Perspective(1.0f, 16.0f / 9.0f, near_plane, far_plane);
+
+    std::printf("clusters: 16x9x24, %zu threads\n", threads);
+    std::printf("%8s %8s %8s %8s %12s %12s %12s %10s %10s %8s %8s %8s %8s\n",
+        "lights", "points", "spots", "culled", "1 thread[ms]", "N threads[ms]", "brute[ms]", "indices", "brute idx", "avg", "max", "misses", "diff");
+    for (size_t no_of_lights = 1024; no_of_lights <= max_lights; no_of_lights *= 4)
+    {
+        Render::TLightTable lights = CreateLights(no_of_lights, 4711);
+        const int repetitions = 10;
+
+        Render::CClusteredLights single(16, 9, 24, 1);
+        Render::CClusteredLights clustered(16, 9, 24, threads);
+        double single_seconds = Best(repetitions, [&]() { single.Assign(lights, view, projection); });
+        double threads_seconds = Best(repetitions, [&]() { clustered.Assign(lights, view, projection); });
+        const auto& statistics = clustered.Statistics();
+
+        bool differ = single.Indices() != clustered.Indices();
+        for (size_t c = 0; c < clustered.Clusters().size() && differ == false; ++c)
+            differ = single.Clusters()[c]._offset != clustered.Clusters()[c]._offset || single.Clusters()[c]._count != clustered.Clusters()[c]._count;
+
+        // brute force: each light against the bounds of each cluster
+        const auto& data = clustered.Lights();
+        size_t brute_indices = 0;
+        double brute_seconds = Best(1, [&]()
+        {
+            brute_indices = 0;
+            for (size_t z = 0; z < clustered.SizeZ(); ++z)
+                for (size_t y = 0; y < clustered.SizeY(); ++y)
+                    for (size_t x = 0; x < clustered.SizeX(); ++x)
+                    {
+                        Render::TBoundingBox box = clustered.ClusterBounds(x, y, z);
+                        float c[3], rs = 0.0f;
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            c[k] = (box._min[k] + box._max[k]) * 0.5f;
+                            rs += (box._max[k] - c[k]) * (box._max[k] - c[k]);
+                        }
+                        rs = std::sqrt(rs);
+                        for (const auto& light : data)
+                        {
+                            float r = light._position[3];
+                            if (r <= 0.0f || r >= Render::CClusteredLights::c_infinite_radius)
+                                continue;
+                            float d2 = 0.0f;
+                            for (int k = 0; k < 3; ++k)
+                            {
+                                float e = std::max(std::max(box._min[k] - light._position[k], light._position[k] - box._max[k]), 0.0f);
+                                d2 += e * e;
+                            }
+                            if (d2 > r * r)
+                                continue;
+                            float cos_outer = light._direction[3];
+                            if (cos_outer > -1.0f)
+                            {
+                                float v[3]{ c[0] - light._position[0], c[1] - light._position[1], c[2] - light._position[2] };
+                                float len2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+                                float v1 = v[0] * light._direction[0] + v[1] * light._direction[1] + v[2] * light._direction[2];
+                                float sin_outer = std::sqrt(std::max(1.0f - cos_outer * cos_outer, 0.0f));
+                                float distance = cos_outer * std::sqrt(std::max(len2 - v1 * v1, 0.0f)) - v1 * sin_outer;
+                                if (distance > rs || v1 > rs + r || v1 < -rs)
+                                    continue;
+                            }
+                            ++brute_indices;
+                        }
+                    }
+        });
+
+        // points in the influence volumes, mapped to clusters like in the shader
+        const auto& grid = clustered.Grid();
+        const auto& clusters = clustered.Clusters();
+        const auto& indices = clustered.Indices();
+        std::uint32_t seed = 17;
+        size_t misses = 0;
+        for (std::uint32_t i = 0; i < (std::uint32_t)data.size(); ++i)
+        {
+            const auto& light = data[i];
+            float r = light._position[3];
+            if (r <= 0.0f || r >= Render::CClusteredLights::c_infinite_radius)
+                continue;
+            for (int k = 0; k < 32; ++k)
+            {
+                float v[3]{ Random(seed) * 2.0f - 1.0f, Random(seed) * 2.0f - 1.0f, Random(seed) * 2.0f - 1.0f };
+                float len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+                if (len > 1.0f || len <= 0.0f)
+                    continue;
+                if (light._direction[3] > -1.0f && (v[0] * light._direction[0] + v[1] * light._direction[1] + v[2] * light._direction[2]) < len * light._direction[3])
+                    continue;
+                float p[3]{ light._position[0] + v[0] * r, light._position[1] + v[1] * r, light._position[2] + v[2] * r };
+                float depth = -p[2];
+                if (depth < near_plane || depth > far_plane)
+                    continue;
+                float nx = (projection[0][0] * p[0] + projection[2][0] * p[2]) / depth;
+                float ny = (projection[1][1] * p[1] + projection[2][1] * p[2]) / depth;
+                if (std::fabs(nx) > 1.0f || std::fabs(ny) > 1.0f)
+                    continue;
+                size_t cx = std::min((size_t)((nx + 1.0f) * 0.5f * grid._size[0]), (size_t)grid._size[0] - 1);
+                size_t cy = std::min((size_t)((ny + 1.0f) * 0.5f * grid._size[1]), (size_t)grid._size[1] - 1);
+                size_t cz = (size_t)std::clamp(std::log(depth) * grid._depth[2] + grid._depth[3], 0.0f, (float)(grid._size[2] - 1));
+                const auto& cluster = clusters[clustered.Cluster(cx, cy, cz)];
+                auto first = indices.begin() + cluster._offset, last = first + cluster._count;
+                misses += std::binary_search(first, last, i) ? 0 : 1;
+            }
+        }
+
+        size_t non_empty = std::count_if(clusters.begin(), clusters.end(), [](const auto& cluster) { return cluster._count > 0; });
+        std::printf("%8zu %8zu %8zu %8zu %12.3f %12.3f %12.1f %10zu %10zu %8.1f %8zu %8zu %8s\n",
+            no_of_lights, statistics._point_lights, statistics._spot_lights, statistics._culled,
+            single_seconds * 1e3, threads_seconds * 1e3, brute_seconds * 1e3, statistics._indices, brute_indices,
+            non_empty > 0 ? (double)statistics._indices / (double)non_empty : 0.0, statistics._max_lights, misses, differ ? "yes" : "no");
+    }
+    return 0;
+}
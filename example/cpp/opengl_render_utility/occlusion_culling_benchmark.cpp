@@ -0,0 +1,248 @@
+// Headless benchmark of the occlusion culling by a software depth buffer.
+//
+// Builds an interior: a grid of rooms, whose walls have door openings, and scatters 10^4 to 10^6 small objects
+// in the rooms. The objects are frustum culled by the scene bounding volume hierarchy and the remaining objects
+// are tested against the depth buffer of the walls. Reports the rasterization time on 1 thread and on all threads,
+// the test time and the percentage of the occluded objects. The depth buffers of the single and multi threaded
+// rasterization are compared, and a sample of the occluded objects is checked by rays to the eye. Occluded objects
+// which are hit by a ray are only visible through gaps narrower than a pixel (the depth buffer samples pixel centers).
+// No OpenGL context is required.
+//
+// usage: occlusion_culling_benchmark [max objects]
+
+#include <stdafx.h>
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Own
+#include <util/RenderUtil_OcclusionCulling.h>
+#include <util/RenderUtil_Parallel.h>
+
+
+// Random number in [0, 1)
+float Random(std::uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / (float)(1u << 24);
+}
+
+
+// Product of 2 column major matrices
+Render::TMat44 Multiply(const Render::TMat44& a, const Render::TMat44& b)
+{
+    Render::TMat44 m{};
+    for (int c = 0; c < 4; ++c)
+        for (int r = 0; r < 4; ++r)
+            for (int k = 0; k < 4; ++k)
+                m[c][r] += a[k][r] * b[c][k];
+    return m;
+}
+
+
+// Perspective projection and view matrix looking from `eye` in direction `dir` (y is up)
+Render::TMat44 ViewProjection(const Render::TVec3& eye, const Render::TVec3& dir, float fov_y, float aspect, float near_plane, float far_plane)
+{
+    float f = 1.0f / std::tan(fov_y * 0.5f);
+    Render::TMat44 projection{};
+    projection[0][0] = f / aspect;
+    projection[1][1] = f;
+    projection[2][2] = (far_plane + near_plane) / (near_plane - far_plane);
+    projection[2][3] = -1.0f;
+    projection[3][2] = 2.0f * far_plane * near_plane / (near_plane - far_plane);
+
+    auto normalize = [](Render::TVec3 v) { float l = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]); return Render::TVec3{ v[0] / l, v[1] / l, v[2] / l }; };
+    auto cross = [](const Render::TVec3& a, const Render::TVec3& b) { return Render::TVec3{ a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] }; };
+    auto dot = [](const Render::TVec3& a, const Render::TVec3& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+    Render::TVec3 z = normalize(Render::TVec3{ -dir[0], -dir[1], -dir[2] });
+    Render::TVec3 x = normalize(cross(Render::TVec3{ 0.0f, 1.0f, 0.0f }, z));
+    Render::TVec3 y = cross(z, x);
+    Render::TMat44 view{};
+    for (int i = 0; i < 3; ++i)
+    {
+        view[i][0] = x[i];
+        view[i][1] = y[i];
+        view[i][2] = z[i];
+    }
+    view[3] = Render::TVec4{ -dot(x, eye), -dot(y, eye), -dot(z, eye), 1.0f };
+    return Multiply(projection, view);
+}
+
+
+// Closed box mesh (12 triangles, counter clockwise seen from outside)
+Render::COcclusionCuller::TOccluder BoxOccluder(const Render::TBoundingBox& box)
+{
+    Render::COcclusionCuller::TOccluder occluder;
+    for (int i = 0; i < 8; ++i)
+        occluder._vertices.push_back({ (i & 1) ? box._max[0] : box._min[0], (i & 2) ? box._max[1] : box._min[1], (i & 4) ? box._max[2] : box._min[2] });
+    occluder._indices = {
+        0, 2, 3, 0, 3, 1,   4, 5, 7, 4, 7, 6,   // -z, +z
+        0, 4, 6, 0, 6, 2,   1, 3, 7, 1, 7, 5,   // -x, +x
+        0, 1, 5, 0, 5, 4,   2, 6, 7, 2, 7, 3 }; // -y, +y
+    return occluder;
+}
+
+
+// True, if the segment from `a` to `b` intersects the box
+bool SegmentHitsBox(const Render::TVec3& a, const Render::TVec3& b, const Render::TBoundingBox& box)
+{
+    float t0 = 0.0f, t1 = 1.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        float d = b[i] - a[i];
+        if (std::fabs(d) < 1e-12f)
+        {
+            if (a[i] < box._min[i] || a[i] > box._max[i])
+                return false;
+            continue;
+        }
+        float u0 = (box._min[i] - a[i]) / d, u1 = (box._max[i] - a[i]) / d;
+        if (u0 > u1)
+            std::swap(u0, u1);
+        t0 = std::max(t0, u0);
+        t1 = std::min(t1, u1);
+        if (t0 > t1)
+            return false;
+    }
+    return true;
+}
+
+
+// Walls of a grid of rooms; each wall has a door opening in its middle
+std::vector<Render::TBoundingBox> CreateWalls(int rooms, float room_size, float height, float thickness, float door)
+{
+    std::vector<Render::TBoundingBox> walls;
+    for (int i = 0; i <= rooms; ++i)
+    {
+        float c = i * room_size;
+        for (int j = 0; j < rooms; ++j)
+        {
+            float s0 = j * room_size, s1 = s0 + room_size, m = (s0 + s1) * 0.5f;
+            bool outer = i == 0 || i == rooms;
+            float gap = outer ? 0.0f : door * 0.5f;
+            for (auto [a, b] : { std::pair<float, float>{ s0, m - gap }, std::pair<float, float>{ m + gap, s1 } })
+            {
+                walls.push_back({ { c - thickness, 0.0f, a }, { c + thickness, height, b } }); // wall along z
+                walls.push_back({ { a, 0.0f, c - thickness }, { b, height, c + thickness } }); // wall along x
+            }
+        }
+    }
+    return walls;
+}
+
+
+template <class TFunc>
+double Best(int repetitions, TFunc func)
+{
+    double best_seconds = 1e30;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        best_seconds = std::min(best_seconds, seconds.count());
+    }
+    return best_seconds;
+}
+
+
+int main(int argc, char** argv)
+{
+    size_t max_objects = argc > 1 ? (size_t)std::stoul(argv[1]) : 1000000;
+    const size_t threads = Render::DefaultConcurrency();
+
+    const int rooms = 16;
+    const float room_size = 10.0f, height = 3.0f;
+    std::vector<Render::TBoundingBox> walls = CreateWalls(rooms, room_size, height, 0.1f, 1.2f);
+    std::vector<Render::COcclusionCuller::TOccluder> occluders;
+    for (auto& wall : walls)
+        occluders.push_back(BoxOccluder(wall));
+
+    // eye in a room in the middle, looking diagonally through the doors
+    Render::TVec3 eye{ rooms * room_size * 0.5f - room_size * 0.5f, 1.6f, rooms * room_size * 0.5f - room_size * 0.5f };
+    Render::TVec3 dir{ 1.0f, -0.05f, 0.35f };
+    Render::TMat44 view_projection = ViewProjection(eye, dir, 1.0f, 16.0f / 9.0f, 0.1f, rooms * room_size * 1.5f);
+    Render::TFrustum frustum = Render::TFrustum::FromMatrix(view_projection);
+
+    std::printf("walls: %zu, depth buffer 320x192, %zu threads\n", walls.size(), threads);
+    std::printf("%10s %10s %10s %12s %12s %10s %10s %10s %11s\n",
+        "objects", "frustum", "triangles", "raster 1 [ms]", "raster N [ms]", "test [ms]", "culled %", "depth diff", "ray visible");
+    for (size_t no_of_objects = 10000; no_of_objects <= max_objects; no_of_objects *= 10)
+    {
+        Render::CSceneBVH scene;
+        std::uint32_t seed = 4711;
+        for (size_t i = 0; i < no_of_objects; ++i)
+        {
+            float x = Random(seed) * rooms * room_size, z = Random(seed) * rooms * room_size, y = Random(seed) * 2.0f;
+            float s = 0.1f + Random(seed) * 0.2f;
+            scene.Add({ { x - s, y, z - s }, { x + s, y + 2.0f * s, z + s } }, (Render::CSceneBVH::TStateKey)i);
+        }
+        scene.Rebuild();
+
+        Render::CSceneBVH::TVisibleList visible;
+        scene.Cull(frustum, visible);
+        const size_t frustum_visible = visible.size();
+
+        const int repetitions = no_of_objects <= 100000 ? 10 : 3;
+        Render::COcclusionCuller single(320, 192, 1);
+        Render::COcclusionCuller culler(320, 192, threads);
+        auto render = [&](Render::COcclusionCuller& c)
+        {
+            c.Begin(view_projection);
+            for (auto& occluder : occluders)
+                c.Render(occluder);
+            c.Rasterize();
+        };
+        single.BackFaceCulling(true);
+        culler.BackFaceCulling(true);
+        double raster1_seconds = Best(repetitions, [&]() { render(single); });
+        double rasterN_seconds = Best(repetitions, [&]() { render(culler); });
+
+        size_t depth_differences = 0;
+        for (size_t y = 0; y < culler.Height(); ++y)
+            for (size_t x = 0; x < culler.Width(); ++x)
+                depth_differences += single.Depth(x, y) != culler.Depth(x, y) ? 1 : 0;
+
+        Render::CSceneBVH::TVisibleList result;
+        double test_seconds = Best(repetitions, [&]() { result = visible; render(culler); culler.Cull(scene, result); }) - rasterN_seconds;
+
+        // occluded objects, whose corners or center see the eye
+        std::vector<Render::CSceneBVH::TObject> occluded;
+        std::vector<std::uint8_t> is_visible(no_of_objects, 0);
+        for (auto& item : result)
+            is_visible[item._object] = 1;
+        for (auto& item : visible)
+            if (is_visible[item._object] == 0)
+                occluded.push_back(item._object);
+        size_t sample_step = std::max<size_t>(1, occluded.size() / 2000), ray_visible = 0;
+        for (size_t i = 0; i < occluded.size(); i += sample_step)
+        {
+            Render::TBoundingBox box = scene.Bounds(occluded[i]);
+            bool seen = false;
+            for (int k = 0; k < 9 && seen == false; ++k)
+            {
+                Render::TVec3 p = k < 8
+                    ? Render::TVec3{ (k & 1) ? box._max[0] : box._min[0], (k & 2) ? box._max[1] : box._min[1], (k & 4) ? box._max[2] : box._min[2] }
+                    : Render::TVec3{ (box._min[0] + box._max[0]) * 0.5f, (box._min[1] + box._max[1]) * 0.5f, (box._min[2] + box._max[2]) * 0.5f };
+                bool in_frustum = true;
+                for (auto& plane : frustum._planes)
+                    in_frustum = in_frustum && plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2] + plane[3] >= 0.0f;
+                if (in_frustum == false)
+                    continue;
+                seen = std::none_of(walls.begin(), walls.end(), [&](const Render::TBoundingBox& wall) { return SegmentHitsBox(p, eye, wall); });
+            }
+            ray_visible += seen ? 1 : 0;
+        }
+
+        std::printf("%10zu %10zu %10zu %12.3f %12.3f %10.3f %10.1f %10zu %11zu\n",
+            no_of_objects, frustum_visible, culler.Statistics()._triangles, raster1_seconds * 1e3, rasterN_seconds * 1e3,
+            test_seconds * 1e3, culler.Statistics().Culled(), depth_differences, ray_visible);
+    }
+    return 0;
+}
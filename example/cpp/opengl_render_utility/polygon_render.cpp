@@ -30,6 +30,7 @@
 #include <OpenGL/OpenGLPolygon_1_0.h>
 #include <OpenGL/OpenGLPolygon_2_0.h>
 #include <OpenGL/OpenGLPolygon_core_and_es.h>
+#include <OpenGL/OpenGLDataBuffer_std140.h>
 #include <OpenGL/OpenGL_Matrix_Camera.h>
 #include <OpenGL/OpenGL_SimpleShaderProgram.h>
 
@@ -81,9 +82,11 @@ private:
     std::unique_ptr<Render::Polygon::IRender> _polygon_1;
     std::unique_ptr<Render::Polygon::IRender> _polygon_2;
     std::unique_ptr<Render::Polygon::IRender> _polygon_3;
-    std::unique_ptr<Render::Polygon::IRender> _polygon_4;
 
     Render::TModelAndViewPtr _view_data_ptr;
+    OpenGL::TMVPBufferPtr    _mvp_buffer;
+    size_t                   _reported_uploads = 0;
+    size_t                   _reported_binds = 0;
 };
 
 int main(int argc, char** argv)
@@ -296,8 +299,15 @@ void CWindow_Glfw::InitScene(void)
     _polygon_2 = std::make_unique<OpenGL::Polygon::CPolygonOpenGL_2_00>(0);
     _polygon_2->Init();
 
+    // the model matrices of the objects are stored to a ring of uniform blocks, which are selected by `glBindBufferRange`;
+    // the ring grows, if the blocks of a frame exceed the ring size
+    static const size_t c_mvp_binding = 1;
+    static const size_t c_mvp_ring_size = 64;
+    _mvp_buffer = std::make_shared<OpenGL::CModelAndViewBuffer_std140>();
+    _mvp_buffer->Init(c_mvp_binding, _view_data_ptr, c_mvp_ring_size);
+
     auto polygon_core = std::make_unique<OpenGL::Polygon::CPolygonOpenGL_core_4>(0);
-    polygon_core->Init(_view_data_ptr);
+    polygon_core->Init(_mvp_buffer);
     _polygon_3 = std::move(polygon_core);
 }
 
@@ -306,6 +316,9 @@ void CWindow_Glfw::Render(double time_ms)
 {
     // Test lines with and without multisampling!
 
+    if (_mvp_buffer != nullptr)
+        _mvp_buffer->NewFrame();
+
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
 
@@ -342,30 +355,40 @@ void CWindow_Glfw::Render(double time_ms)
         glPopMatrix();
     }
 
-    if (_polygon_3 != nullptr)
+    if (_polygon_3 != nullptr && _mvp_buffer != nullptr)
     {
-        glPushMatrix();
-
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(-0.5f, -0.5f, 0.0f));
-        model = glm::scale(model, glm::vec3(0.5f));
-        SetModel(glm::value_ptr(model));
-
-        RenderTestScene(*_polygon_3.get());
+        // record the model matrices of all the objects, upload them by a single `glBufferSubData`
+        // and select the uniform block of each object, before it is drawn
+        static const std::array<glm::vec3, 2> c_positions{ glm::vec3(-0.5f, -0.5f, 0.0f), glm::vec3(0.5f, -0.5f, 0.0f) };
+        std::array<size_t, c_positions.size()> blocks;
+        for (size_t i = 0; i < c_positions.size(); ++i)
+        {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), c_positions[i]);
+            model = glm::scale(model, glm::vec3(0.5f));
+            _view_data_ptr->Model(glm::value_ptr(model));
+            blocks[i] = _mvp_buffer->Record();
+        }
+        _mvp_buffer->Flush();
 
-        glPopMatrix();
+        for (size_t i = 0; i < c_positions.size(); ++i)
+        {
+            _mvp_buffer->Select(blocks[i]);
+            RenderTestScene(*_polygon_3.get());
+        }
     }
 
-    if (_polygon_4 != nullptr)
+    // report the uniform buffer uploads of the last frame, when they change
+    if (_mvp_buffer != nullptr)
     {
-        glPushMatrix();
-
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, -0.5f, 0.0f));
-        model = glm::scale(model, glm::vec3(0.5f));
-        SetModel(glm::value_ptr(model));
-
-        RenderTestScene(*_polygon_3.get());
-
-        glPopMatrix();
+        const auto &stat = _mvp_buffer->LastFrame();
+        if (stat._uploads != _reported_uploads || stat._binds != _reported_binds)
+        {
+            std::cout << "uniform blocks: " << stat._records << " records, " << stat._uploads << " uploads, "
+                      << stat._bytes << " bytes, " << stat._binds << " binds, " << stat._grows << " grows, "
+                      << stat._orphans << " orphans" << std::endl;
+            _reported_uploads = stat._uploads;
+            _reported_binds = stat._binds;
+        }
     }
 }
 
@@ -0,0 +1,127 @@
+// Headless benchmark of the polygon triangulation.
+//
+// Triangulates wavy polygons with holes and 10^2 to 10^6 vertices and reports the triangulation time,
+// the throughput and the time of a lookup in the triangulation cache, which is the cost of drawing a static
+// polygon again. The area of the triangles is compared to the area of the polygon.
+// No OpenGL context is required.
+//
+// usage: polygon_triangulation_benchmark [max vertices]
+
+#include <stdafx.h>
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Own
+#include <util/RenderUtil_Triangulation.h>
+
+
+// Wavy outer contour with jittered radii (many reflex vertices) and 16 circular holes; x y tuples
+void CreatePolygon(size_t no_of_vertices, std::vector<float>& coords, std::vector<size_t>& contour_sizes)
+{
+    const double pi = 3.14159265358979323846;
+    const size_t no_of_holes = 16;
+    size_t hole_size = std::max<size_t>(3, no_of_vertices / 100 / no_of_holes);
+    size_t outer_size = no_of_vertices - no_of_holes * hole_size;
+
+    coords.clear();
+    contour_sizes.clear();
+    std::uint32_t seed = 12345;
+    for (size_t i = 0; i < outer_size; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        double jitter = (double)(seed >> 8) / (double)(1u << 24) - 0.5;
+        double angle = 2.0 * pi * (double)i / (double)outer_size;
+        double radius = 1.0 + 0.1 * std::sin(angle * 12.0) + 2.0 * jitter / (double)outer_size;
+        coords.push_back((float)(radius * std::cos(angle)));
+        coords.push_back((float)(radius * std::sin(angle)));
+    }
+    contour_sizes.push_back(outer_size);
+    for (size_t h = 0; h < no_of_holes; ++h)
+    {
+        double center_x = -0.45 + 0.3 * (double)(h % 4);
+        double center_y = -0.45 + 0.3 * (double)(h / 4);
+        for (size_t i = 0; i < hole_size; ++i)
+        {
+            double angle = 2.0 * pi * (double)i / (double)hole_size;
+            coords.push_back((float)(center_x + 0.1 * std::cos(angle)));
+            coords.push_back((float)(center_y + 0.1 * std::sin(angle)));
+        }
+        contour_sizes.push_back(hole_size);
+    }
+}
+
+
+// Signed area of a contour of x y tuples
+double ContourArea(const float* coords, size_t size)
+{
+    double sum = 0.0;
+    for (size_t i = 0, j = size - 1; i < size; j = i++)
+        sum += (double)coords[j * 2] * coords[i * 2 + 1] - (double)coords[i * 2] * coords[j * 2 + 1];
+    return sum * 0.5;
+}
+
+
+int main(int argc, char** argv)
+{
+    size_t max_vertices = argc > 1 ? (size_t)std::stoul(argv[1]) : 1000000;
+
+    std::vector<float> coords;
+    std::vector<size_t> contour_sizes;
+    std::vector<std::uint32_t> indices;
+    Render::CPolygonTriangulator triangulator;
+
+    std::printf("%10s %10s %12s %14s %16s %12s\n", "vertices", "triangles", "time [ms]", "Mvertices/s", "cached [us]", "area error");
+    for (size_t no_of_vertices = 100; no_of_vertices <= max_vertices; no_of_vertices *= 10)
+    {
+        CreatePolygon(no_of_vertices, coords, contour_sizes);
+        const int repetitions = no_of_vertices <= 10000 ? 20 : 3;
+
+        // best of n runs
+        double best_seconds = 1e30;
+        size_t triangles = 0;
+        for (int i = 0; i < repetitions; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            triangles = triangulator.Triangulate(2, coords.size(), coords.data(), contour_sizes.size(), contour_sizes.data(), indices);
+            std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+            best_seconds = std::min(best_seconds, seconds.count());
+        }
+
+        // area of the triangles compared to the area of the polygon
+        double polygon_area = 0.0;
+        for (size_t c = 0, start = 0; c < contour_sizes.size(); start += contour_sizes[c++])
+            polygon_area += (c == 0 ? 1.0 : -1.0) * std::abs(ContourArea(coords.data() + start * 2, contour_sizes[c]));
+        double triangle_area = 0.0;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            const float* a = coords.data() + indices[i] * 2;
+            const float* b = coords.data() + indices[i + 1] * 2;
+            const float* c = coords.data() + indices[i + 2] * 2;
+            triangle_area += std::abs(((double)b[0] - a[0]) * ((double)c[1] - a[1]) - ((double)c[0] - a[0]) * ((double)b[1] - a[1])) * 0.5;
+        }
+        double area_error = std::abs(triangle_area - polygon_area) / polygon_area;
+
+        // a cache hit costs the content hash of the polygon
+        Render::CTriangulationCache cache;
+        cache.Get(2, coords.size(), coords.data(), contour_sizes.size(), contour_sizes.data());
+        double best_cached_seconds = 1e30;
+        for (int i = 0; i < repetitions; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto triangulation = cache.Get(2, coords.size(), coords.data(), contour_sizes.size(), contour_sizes.data());
+            std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+            best_cached_seconds = std::min(best_cached_seconds, seconds.count());
+        }
+
+        std::printf("%10zu %10zu %12.3f %14.2f %16.2f %12.2e\n",
+            no_of_vertices, triangles, best_seconds * 1e3, (double)no_of_vertices / best_seconds * 1e-6, best_cached_seconds * 1e6, area_error);
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+// Headless check of the render graph.
+//
+// Builds the graph of a bloom post processing chain (scene, bright pass, horizontal blur, vertical blur,
+// composition), compiles it and checks the order of the passes, the lifetimes and the aliasing of the
+// transient buffers: the 3 half resolution buffers of the chain have to share 2 textures. Buffers which
+// are kept after the frame or have a different format must not be aliased.
+// No OpenGL context is required.
+//
+// usage: render_graph_test [width height]
+
+#include <stdafx.h>
+
+// stl
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Own
+#include <util/RenderUtil_RenderGraph.h>
+
+
+enum TBufferID : size_t
+{
+    b_depth,
+    b_scene,
+    b_bright,
+    b_blur_h,
+    b_blur_v
+};
+
+enum TPassID : size_t
+{
+    p_scene,
+    p_bright,
+    p_blur_h,
+    p_blur_v,
+    p_compose
+};
+
+
+// Buffers and passes of the bloom chain
+void CreateBloomChain(Render::CRenderGraph::TBufferMap& buffers, Render::CRenderGraph::TPassMap& passes)
+{
+    using namespace Render;
+
+    buffers.clear();
+    buffers[b_depth] = TBuffer(TBufferType::DEPTH, TBufferDataType::DEPTH32F);
+    buffers[b_scene] = TBuffer(TBufferType::COLOR4, TBufferDataType::F16);
+    buffers[b_bright] = TBuffer(TBufferType::COLOR4, TBufferDataType::F16, 0, 0.5f);
+    buffers[b_blur_h] = TBuffer(TBufferType::COLOR4, TBufferDataType::F16, 0, 0.5f);
+    buffers[b_blur_v] = TBuffer(TBufferType::COLOR4, TBufferDataType::F16, 0, 0.5f);
+
+    passes.clear();
+    passes[p_scene] = TPass(TPassDepthTest::LESS, TPassBlending::OFF);
+    passes[p_scene]._targets = { TPass::TTarget(b_depth, TPass::TTarget::depth), TPass::TTarget(b_scene, 0) };
+
+    passes[p_bright]._sources = { TPass::TSource(b_scene, 0) };
+    passes[p_bright]._targets = { TPass::TTarget(b_bright, 0) };
+
+    passes[p_blur_h]._sources = { TPass::TSource(b_bright, 0) };
+    passes[p_blur_h]._targets = { TPass::TTarget(b_blur_h, 0) };
+
+    passes[p_blur_v]._sources = { TPass::TSource(b_blur_h, 0) };
+    passes[p_blur_v]._targets = { TPass::TTarget(b_blur_v, 0) };
+
+    // the composition writes to the default framebuffer
+    passes[p_compose]._sources = { TPass::TSource(b_scene, 0), TPass::TSource(b_blur_v, 1) };
+}
+
+
+static int g_failures = 0;
+
+void Check(bool condition, const char* text)
+{
+    std::printf("%-66s %s\n", text, condition ? "ok" : "FAILED");
+    if (condition == false)
+        ++g_failures;
+}
+
+
+int main(int argc, char** argv)
+{
+    Render::CRenderGraph::TSize size{ 1920, 1080 };
+    if (argc > 2)
+        size = { (size_t)std::stoul(argv[1]), (size_t)std::stoul(argv[2]) };
+
+    Render::CRenderGraph::TBufferMap buffers;
+    Render::CRenderGraph::TPassMap passes;
+    CreateBloomChain(buffers, passes);
+
+    // aliasing of the bloom chain
+    Render::CRenderGraph graph;
+    Check(graph.Build(buffers, passes, size), "build the graph of the bloom chain");
+    std::printf("%s\n", graph.ReportText().c_str());
+    Check(graph.Order() == std::vector<size_t>{ p_scene, p_bright, p_blur_h, p_blur_v, p_compose }, "order of the passes");
+    Check(graph.Lifetime(b_bright)._transient && graph.Lifetime(b_blur_h)._transient && graph.Lifetime(b_blur_v)._transient, "the buffers of the chain are transient");
+    Check(graph.Alias(b_bright) == b_bright && graph.Alias(b_blur_h) == b_blur_h, "bright pass and horizontal blur own a texture");
+    Check(graph.Alias(b_blur_v) == b_bright, "vertical blur is aliased onto the bright pass");
+    Check(graph.Alias(b_scene) == b_scene && graph.Alias(b_depth) == b_depth, "the scene buffers are not aliased");
+    Check(graph.Report()._buffers == 5 && graph.Report()._textures == 4, "5 buffers on 4 textures");
+    size_t half_size = Render::CRenderGraph::BufferSize(buffers[b_blur_v], size);
+    Check(graph.Report().Saved() == half_size, "the memory of 1 half resolution buffer is saved");
+    Check(graph.Dead(p_scene) == std::vector<size_t>{ b_depth }, "the depth buffer is dead after the scene");
+    Check(graph.Dead(p_blur_v) == std::vector<size_t>{ b_blur_h }, "the horizontal blur is dead after the vertical blur");
+    Check(graph.Dead(p_compose) == std::vector<size_t>{ b_scene, b_blur_v }, "the scene and the vertical blur are dead after the composition");
+
+    // a buffer, which is kept after the frame, is not aliased
+    Render::CRenderGraph::TBufferMap kept_buffers = buffers;
+    kept_buffers[b_blur_v]._flag.set(Render::TBuffer::e_keep);
+    Check(graph.Build(kept_buffers, passes, size) && graph.Alias(b_blur_v) == b_blur_v && graph.Report()._textures == 5, "a kept buffer is not aliased");
+    Check(graph.Dead(p_compose) == std::vector<size_t>{ b_scene }, "a kept buffer is not invalidated");
+
+    // buffers with different formats are not aliased
+    Render::CRenderGraph::TBufferMap f32_buffers = buffers;
+    f32_buffers[b_blur_v]._format = Render::TBufferDataType::F32;
+    Check(graph.Build(f32_buffers, passes, size) && graph.Alias(b_blur_v) == b_blur_v && graph.Report().Saved() == 0, "buffers with different formats are not aliased");
+
+    // a buffer, which is not cleared by its first access, keeps the content of the former frame
+    Render::CRenderGraph::TPassMap accumulate_passes = passes;
+    accumulate_passes[p_blur_v]._targets = { Render::TPass::TTarget(b_blur_v, 0, false) };
+    Check(graph.Build(buffers, accumulate_passes, size) && graph.Lifetime(b_blur_v)._transient == false && graph.Alias(b_blur_v) == b_blur_v, "a buffer which is not cleared is not aliased");
+
+    std::printf("%s\n", g_failures == 0 ? "all checks passed" : "checks FAILED");
+    return g_failures == 0 ? 0 : 1;
+}
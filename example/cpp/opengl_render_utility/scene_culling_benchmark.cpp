@@ -0,0 +1,202 @@
+// Headless benchmark of the frustum culling by the scene bounding volume hierarchy.
+//
+// Scatters 10^4 to 10^6 boxes in a cube and reports the time to build the tree, to update it after 1% of the
+// objects moved, and to cull the objects against a view frustum (with and without distance culling). The
+// culling by the tree is compared to testing each object, and the visible lists are checked for equality.
+// No OpenGL context is required.
+//
+// usage: scene_culling_benchmark [max objects]
+
+#include <stdafx.h>
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Own
+#include <util/RenderUtil_SceneBVH.h>
+
+
+// Random number in [0, 1)
+float Random(std::uint32_t& seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return (float)(seed >> 8) / (float)(1u << 24);
+}
+
+
+// Product of 2 column major matrices
+Render::TMat44 Multiply(const Render::TMat44& a, const Render::TMat44& b)
+{
+    Render::TMat44 m{};
+    for (int c = 0; c < 4; ++c)
+        for (int r = 0; r < 4; ++r)
+            for (int k = 0; k < 4; ++k)
+                m[c][r] += a[k][r] * b[c][k];
+    return m;
+}
+
+
+// Perspective projection and view matrix looking from `eye` in direction `dir` (y is up)
+Render::TMat44 ViewProjection(const Render::TVec3& eye, const Render::TVec3& dir, float fov_y, float aspect, float near_plane, float far_plane)
+{
+    float f = 1.0f / std::tan(fov_y * 0.5f);
+    Render::TMat44 projection{};
+    projection[0][0] = f / aspect;
+    projection[1][1] = f;
+    projection[2][2] = (far_plane + near_plane) / (near_plane - far_plane);
+    projection[2][3] = -1.0f;
+    projection[3][2] = 2.0f * far_plane * near_plane / (near_plane - far_plane);
+
+    auto normalize = [](Render::TVec3 v) { float l = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]); return Render::TVec3{ v[0] / l, v[1] / l, v[2] / l }; };
+    auto cross = [](const Render::TVec3& a, const Render::TVec3& b) { return Render::TVec3{ a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] }; };
+    auto dot = [](const Render::TVec3& a, const Render::TVec3& b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+    Render::TVec3 z = normalize(Render::TVec3{ -dir[0], -dir[1], -dir[2] });
+    Render::TVec3 x = normalize(cross(Render::TVec3{ 0.0f, 1.0f, 0.0f }, z));
+    Render::TVec3 y = cross(z, x);
+    Render::TMat44 view{};
+    for (int i = 0; i < 3; ++i)
+    {
+        view[i][0] = x[i];
+        view[i][1] = y[i];
+        view[i][2] = z[i];
+    }
+    view[3] = Render::TVec4{ -dot(x, eye), -dot(y, eye), -dot(z, eye), 1.0f };
+    return Multiply(projection, view);
+}
+
+
+// Test each object; the same test as the leaves of the tree
+void CullEachObject(
+    const Render::CSceneBVH& scene, const std::vector<Render::CSceneBVH::TObject>& objects, const Render::TFrustum& frustum,
+    bool distance, const Render::TVec3& eye, float max_distance, Render::CSceneBVH::TVisibleList& visible)
+{
+    visible.clear();
+    for (auto object : objects)
+    {
+        Render::TBoundingBox box = scene.Bounds(object);
+        bool inside = true;
+        for (int k = 0; k < 6 && inside; ++k)
+        {
+            const Render::TVec4& p = frustum._planes[k];
+            float x = p[0] >= 0.0f ? box._max[0] : box._min[0];
+            float y = p[1] >= 0.0f ? box._max[1] : box._min[1];
+            float z = p[2] >= 0.0f ? box._max[2] : box._min[2];
+            inside = p[0] * x + p[1] * y + p[2] * z + p[3] >= 0.0f;
+        }
+        if (inside && distance)
+        {
+            float d2 = 0.0f;
+            for (int i = 0; i < 3; ++i)
+            {
+                float d = std::max(std::max(box._min[i] - eye[i], eye[i] - box._max[i]), 0.0f);
+                d2 += d * d;
+            }
+            inside = d2 <= max_distance * max_distance;
+        }
+        if (inside)
+            visible.push_back({ scene.Key(object), object });
+    }
+    Render::CSceneBVH::SortByKey(visible);
+}
+
+
+// Number of objects, which are in one list only
+size_t Mismatches(Render::CSceneBVH::TVisibleList a, Render::CSceneBVH::TVisibleList b)
+{
+    auto less = [](const Render::CSceneBVH::TDrawItem& x, const Render::CSceneBVH::TDrawItem& y) { return x._object < y._object; };
+    std::sort(a.begin(), a.end(), less);
+    std::sort(b.begin(), b.end(), less);
+    std::vector<Render::CSceneBVH::TDrawItem> difference;
+    std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(difference), less);
+    return difference.size();
+}
+
+
+// Best time of n runs in seconds
+template <class TFunc>
+double Best(int repetitions, TFunc func)
+{
+    double best_seconds = 1e30;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        best_seconds = std::min(best_seconds, seconds.count());
+    }
+    return best_seconds;
+}
+
+
+int main(int argc, char** argv)
+{
+    size_t max_objects = argc > 1 ? (size_t)std::stoul(argv[1]) : 1000000;
+
+    std::printf("%10s %10s %11s %10s %10s %10s %10s %10s %9s %9s\n",
+        "objects", "build [ms]", "update [ms]", "cull [ms]", "each [ms]", "speedup", "dist [ms]", "visible", "nodes", "mismatch");
+    for (size_t no_of_objects = 10000; no_of_objects <= max_objects; no_of_objects *= 10)
+    {
+        // boxes in a cube with a constant density; 64 different states
+        const float extent = 4.0f * std::cbrt((float)no_of_objects);
+        std::uint32_t seed = 4711;
+        auto random_box = [&]() {
+            Render::TVec3 center{ Random(seed) * extent, Random(seed) * extent, Random(seed) * extent };
+            Render::TVec3 size{ 0.2f + Random(seed) * 1.3f, 0.2f + Random(seed) * 1.3f, 0.2f + Random(seed) * 1.3f };
+            return Render::TBoundingBox{
+                { center[0] - size[0], center[1] - size[1], center[2] - size[2] },
+                { center[0] + size[0], center[1] + size[1], center[2] + size[2] } };
+        };
+
+        Render::CSceneBVH scene;
+        std::vector<Render::CSceneBVH::TObject> objects;
+        for (size_t i = 0; i < no_of_objects; ++i)
+            objects.push_back(scene.Add(random_box(), (Render::CSceneBVH::TStateKey)(Random(seed) * 64.0f) << 32 | i));
+        const int repetitions = no_of_objects <= 100000 ? 10 : 3;
+        double build_seconds = Best(repetitions, [&]() { scene.Rebuild(); });
+
+        // move 1% of the objects by a small distance and refit
+        double update_seconds = 1e30;
+        for (int i = 0; i < repetitions; ++i)
+        {
+            for (size_t j = 0; j < no_of_objects / 100; ++j)
+            {
+                auto object = objects[(size_t)(Random(seed) * (float)no_of_objects) % no_of_objects];
+                Render::TBoundingBox box = scene.Bounds(object);
+                float offset = Random(seed) - 0.5f;
+                for (int k = 0; k < 3; ++k)
+                {
+                    box._min[k] += offset;
+                    box._max[k] += offset;
+                }
+                scene.Move(object, box);
+            }
+            update_seconds = std::min(update_seconds, Best(1, [&]() { scene.Update(); }));
+        }
+
+        // view from the center of a face of the cube into the cube
+        Render::TVec3 eye{ extent * 0.5f, extent * 0.5f, -2.0f };
+        Render::TVec3 dir{ 0.2f, -0.1f, 1.0f };
+        Render::TFrustum frustum = Render::TFrustum::FromMatrix(ViewProjection(eye, dir, 1.0f, 16.0f / 9.0f, 0.1f, extent * 2.0f));
+        const float max_distance = extent * 0.5f;
+
+        Render::CSceneBVH::TVisibleList visible, reference, distance_visible, distance_reference;
+        Render::CSceneBVH::TCullStatistics statistics;
+        double cull_seconds = Best(repetitions, [&]() { statistics = scene.Cull(frustum, visible); });
+        double each_seconds = Best(repetitions, [&]() { CullEachObject(scene, objects, frustum, false, eye, 0.0f, reference); });
+        double distance_seconds = Best(repetitions, [&]() { scene.Cull(frustum, eye, max_distance, distance_visible); });
+        CullEachObject(scene, objects, frustum, true, eye, max_distance, distance_reference);
+        size_t mismatches = Mismatches(visible, reference) + Mismatches(distance_visible, distance_reference);
+
+        std::printf("%10zu %10.3f %11.3f %10.3f %10.3f %10.2f %10.3f %10zu %9zu %9zu\n",
+            no_of_objects, build_seconds * 1e3, update_seconds * 1e3, cull_seconds * 1e3, each_seconds * 1e3,
+            each_seconds / cull_seconds, distance_seconds * 1e3, visible.size(), statistics._nodes, mismatches);
+    }
+    return 0;
+}
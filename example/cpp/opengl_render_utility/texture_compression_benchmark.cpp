@@ -0,0 +1,166 @@
+// Headless benchmark of the CPU block compression encoder.
+//
+// Compresses the textures of resource/texture to BC1, BC3, BC4, BC5 and BC7 with all quality levels
+// and reports the throughput (Mtexel/s) and the PSNR of the decompressed image.
+// The compressed images are written to a KTX2 and a DDS file in the temporary directory and read back;
+// the container column reports, if the format, the sRGB flag and the data survive the round trip.
+// No OpenGL context is required.
+//
+// usage: texture_compression_benchmark [texture directory] [threads] [file ...]
+
+#include <stdafx.h>
+
+// stl
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// stb
+#define STB_IMAGE_IMPLEMENTATION
+#define __STDC_LIB_EXT1__
+#include <stb_image.h>
+
+// Own
+#include <util/RenderUtil_BlockCompression.h>
+#include <util/RenderUtil_TextureContainer.h>
+
+
+class CStbImage
+    : public Render::IImageResource
+{
+public:
+
+    CStbImage(const std::string& path)
+    {
+        _data = stbi_load(path.c_str(), &_cx, &_cy, &_channels, 4);
+    }
+
+    virtual ~CStbImage()
+    {
+        if (_data != nullptr)
+            stbi_image_free(_data);
+    }
+
+    bool Valid(void) const { return _data != nullptr; }
+
+    virtual Render::TImageKind   Kind(void)      const override { return Render::TImageKind::diffuse; }
+    virtual Render::TTextureType Type(void)      const override { return Render::TTextureType::T2D; }
+    virtual Render::TImageFormat Format(void)    const override { return Render::TImageFormat::RGBA8; }
+    virtual Render::TTextureSize Size(void)      const override { return { (size_t)_cx, (size_t)_cy, 1 }; }
+    virtual size_t               Layers(void)    const override { return 1; }
+    virtual size_t               BPL(void)       const override { return (size_t)_cx * 4; }
+    virtual size_t               LineAlign(void) const override { return 1; }
+    virtual const void*          DataPtr(void)   const override { return _data; }
+
+private:
+
+    int _cx = 0;
+    int _cy = 0;
+    int _channels = 0;
+    stbi_uc* _data = nullptr;
+};
+
+
+// Write the image to a KTX2 and a DDS file, read it back and compare it
+bool ContainerRoundTrip(const Render::CCompressedImage& image, bool srgb)
+{
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const Render::CTextureContainer::TLayerImages images{ { &image } };
+    bool success = true;
+    for (const char* name : { "texture_compression_benchmark.ktx2", "texture_compression_benchmark.dds" })
+    {
+        std::string path = (dir / name).string();
+        bool ktx2 = std::strstr(name, ".ktx2") != nullptr;
+        bool written = ktx2
+            ? Render::CTextureContainer::WriteKTX2(path, images, srgb)
+            : Render::CTextureContainer::WriteDDS(path, images, srgb);
+        Render::CTextureContainer container;
+        success = success && written && container.Open(path) &&
+            container.Format() == image.Format() && container.IsSRGB() == srgb && container.Levels() == 1 && container.Layers() == 1 &&
+            container.Image(0).DataSize() == image.Data().size() &&
+            std::memcmp(container.Image(0).DataPtr(), image.Data().data(), image.Data().size()) == 0;
+        container.Close();
+        std::filesystem::remove(path);
+    }
+    return success;
+}
+
+
+int main(int argc, char** argv)
+{
+    std::string dir = argc > 1 ? argv[1] : "./resource/texture/";
+    size_t threads = argc > 2 ? (size_t)std::stoul(argv[2]) : 0;
+    std::vector<std::string> files;
+    for (int i = 3; i < argc; ++i)
+        files.push_back(argv[i]);
+    if (files.empty())
+        files = { "woodtiles.jpg", "brickwall.png", "toy_box_normal.png", "ObjectSheet.png", "example_1_texture.png" };
+
+    const std::vector<std::pair<Render::TImageFormat, const char*>> formats
+    {
+        { Render::TImageFormat::BC1_RGB,  "BC1"  },
+        { Render::TImageFormat::BC1_RGBA, "BC1A" },
+        { Render::TImageFormat::BC3,      "BC3"  },
+        { Render::TImageFormat::BC4,      "BC4"  },
+        { Render::TImageFormat::BC5,      "BC5"  },
+        { Render::TImageFormat::BC7,      "BC7"  },
+    };
+    const std::vector<std::pair<Render::TBlockCompressionQuality, const char*>> qualities
+    {
+        { Render::TBlockCompressionQuality::fast,   "fast"   },
+        { Render::TBlockCompressionQuality::normal, "normal" },
+        { Render::TBlockCompressionQuality::high,   "high"   },
+    };
+    const int repetitions = 3;
+
+    std::printf("%-24s %-5s %-7s %10s %10s %10s\n", "image", "fmt", "quality", "Mtexel/s", "PSNR [dB]", "container");
+    for (auto& file : files)
+    {
+        CStbImage image(dir + file);
+        if (image.Valid() == false)
+        {
+            std::cout << "file not found: " << dir + file << std::endl;
+            continue;
+        }
+        double texels = (double)(image.Size()[0] * image.Size()[1]);
+
+        for (auto& format : formats)
+        {
+            for (auto& quality : qualities)
+            {
+                Render::TBlockCompressionParameters parameters;
+                parameters._format = format.first;
+                parameters._quality = quality.first;
+                parameters._threads = threads;
+                Render::CBlockCompressor compressor(parameters);
+
+                // best of n runs
+                Render::CCompressedImage compressed;
+                double best_seconds = 1e30;
+                for (int i = 0; i < repetitions; ++i)
+                {
+                    auto start = std::chrono::steady_clock::now();
+                    compressor.Compress(image, compressed);
+                    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+                    best_seconds = std::min(best_seconds, seconds.count());
+                }
+
+                std::vector<Render::t_byte> decompressed;
+                Render::CBlockCompressor::Decompress(compressed, decompressed, threads);
+                double psnr = Render::CBlockCompressor::PSNR(image, decompressed, format.first);
+
+                // color formats are written as sRGB, the others as linear
+                bool srgb = format.first != Render::TImageFormat::BC4 && format.first != Render::TImageFormat::BC5;
+                bool container = ContainerRoundTrip(compressed, srgb);
+
+                std::printf("%-24s %-5s %-7s %10.2f %10.2f %10s\n", file.c_str(), format.second, quality.second, texels / best_seconds * 1e-6, psnr, container ? "ok" : "FAILED");
+            }
+        }
+    }
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include <gl/opengl_mesh_vector.h>
 #include <gl/opengl_mesh_single.h>
 #include <gl/opengl_mesh_single_separate_attribute.h>
+#include <gl/opengl_mesh_registry.h>
 #include <animation/time_interface.h>
 #include <animation/quadratic_attenuation.h>
 #include <controls/spinning_controls.h>
@@ -61,6 +62,7 @@ private:
     const std::unique_ptr<OpenGL::CContext> _context;
     GLuint _program = 0;
     GLuint _shader_storag_buffer_object = 0;
+    std::unique_ptr<OpenGL::mesh::MeshRegistry> _mesh_registry;
     OpenGL::mesh::MeshVector _meshs;
     GLfloat _angle1 = 0.0f;
     GLfloat _angle2 = 0.0f;
@@ -350,13 +352,14 @@ void MyOpenGLView::init(const view::CanvasInterface& canvas)
     auto octahedron_mesh_data = mesh::MeshDefinitonOctahedron<float, unsigned int>(1.0f).generate_mesh_data();
     auto dodecahedron_mesh_data = mesh::MeshDefinitonDodecahedron<float, unsigned int>(1.0f).generate_mesh_data();
     auto icosahedron_mesh_data = mesh::MeshDefinitonIcosahedron<float, unsigned int>(1.0f).generate_mesh_data();
+    _mesh_registry = std::make_unique<OpenGL::mesh::MeshRegistry>();
     _meshs = OpenGL::mesh::MeshVector(std::vector<std::shared_ptr<OpenGL::mesh::MeshInterface>>
     {
-        std::make_shared<OpenGL::mesh::SingleMeshSeparateAttributeFormat>(*tetrahedron_mesh_data),
-        std::make_shared<OpenGL::mesh::SingleMeshSeparateAttributeFormat>(*hexahedron_mesh_data),
-        std::make_shared<OpenGL::mesh::SingleMeshSeparateAttributeFormat>(*octahedron_mesh_data),
-        std::make_shared<OpenGL::mesh::SingleMeshSeparateAttributeFormat>(*dodecahedron_mesh_data),
-        std::make_shared<OpenGL::mesh::SingleMeshSeparateAttributeFormat>(*icosahedron_mesh_data),
+        _mesh_registry->mesh(_mesh_registry->add(*tetrahedron_mesh_data)),
+        _mesh_registry->mesh(_mesh_registry->add(*hexahedron_mesh_data)),
+        _mesh_registry->mesh(_mesh_registry->add(*octahedron_mesh_data)),
+        _mesh_registry->mesh(_mesh_registry->add(*dodecahedron_mesh_data)),
+        _mesh_registry->mesh(_mesh_registry->add(*icosahedron_mesh_data)),
     });
 
     glGenBuffers(1, &_shader_storag_buffer_object);